@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/batch_gather.dir/main.cpp.o"
+  "CMakeFiles/batch_gather.dir/main.cpp.o.d"
+  "batch_gather"
+  "batch_gather.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/batch_gather.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
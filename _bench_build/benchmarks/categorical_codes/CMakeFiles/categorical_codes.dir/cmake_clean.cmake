@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/categorical_codes.dir/main.cpp.o"
+  "CMakeFiles/categorical_codes.dir/main.cpp.o.d"
+  "categorical_codes"
+  "categorical_codes.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/categorical_codes.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/concurrent_line_search.dir/main.cpp.o"
+  "CMakeFiles/concurrent_line_search.dir/main.cpp.o.d"
+  "concurrent_line_search"
+  "concurrent_line_search.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/concurrent_line_search.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
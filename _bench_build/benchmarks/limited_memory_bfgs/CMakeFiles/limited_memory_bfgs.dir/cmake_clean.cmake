@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/limited_memory_bfgs.dir/main.cpp.o"
+  "CMakeFiles/limited_memory_bfgs.dir/main.cpp.o.d"
+  "limited_memory_bfgs"
+  "limited_memory_bfgs.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/limited_memory_bfgs.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
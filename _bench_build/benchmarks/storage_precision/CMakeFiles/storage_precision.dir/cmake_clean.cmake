@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/storage_precision.dir/main.cpp.o"
+  "CMakeFiles/storage_precision.dir/main.cpp.o.d"
+  "storage_precision"
+  "storage_precision.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/storage_precision.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/streaming_levenberg_marquardt.dir/main.cpp.o"
+  "CMakeFiles/streaming_levenberg_marquardt.dir/main.cpp.o.d"
+  "streaming_levenberg_marquardt"
+  "streaming_levenberg_marquardt.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/streaming_levenberg_marquardt.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/training_allocations.dir/main.cpp.o"
+  "CMakeFiles/training_allocations.dir/main.cpp.o.d"
+  "training_allocations"
+  "training_allocations.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/training_allocations.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
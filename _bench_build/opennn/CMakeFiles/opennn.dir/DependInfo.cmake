@@ -0,0 +1,92 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/opennn/adaptive_moment_estimation.cpp" "opennn/CMakeFiles/opennn.dir/adaptive_moment_estimation.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/adaptive_moment_estimation.cpp.o.d"
+  "/root/repo/opennn/addition_layer.cpp" "opennn/CMakeFiles/opennn.dir/addition_layer.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/addition_layer.cpp.o.d"
+  "/root/repo/opennn/batch_loader.cpp" "opennn/CMakeFiles/opennn.dir/batch_loader.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/batch_loader.cpp.o.d"
+  "/root/repo/opennn/binary_data_file.cpp" "opennn/CMakeFiles/opennn.dir/binary_data_file.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/binary_data_file.cpp.o.d"
+  "/root/repo/opennn/bounding_box_regressor_layer.cpp" "opennn/CMakeFiles/opennn.dir/bounding_box_regressor_layer.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/bounding_box_regressor_layer.cpp.o.d"
+  "/root/repo/opennn/bounding_layer.cpp" "opennn/CMakeFiles/opennn.dir/bounding_layer.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/bounding_layer.cpp.o.d"
+  "/root/repo/opennn/codification.cpp" "opennn/CMakeFiles/opennn.dir/codification.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/codification.cpp.o.d"
+  "/root/repo/opennn/concatenation_layer.cpp" "opennn/CMakeFiles/opennn.dir/concatenation_layer.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/concatenation_layer.cpp.o.d"
+  "/root/repo/opennn/conjugate_gradient.cpp" "opennn/CMakeFiles/opennn.dir/conjugate_gradient.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/conjugate_gradient.cpp.o.d"
+  "/root/repo/opennn/convolution_engine.cpp" "opennn/CMakeFiles/opennn.dir/convolution_engine.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/convolution_engine.cpp.o.d"
+  "/root/repo/opennn/convolutional_layer.cpp" "opennn/CMakeFiles/opennn.dir/convolutional_layer.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/convolutional_layer.cpp.o.d"
+  "/root/repo/opennn/correlations.cpp" "opennn/CMakeFiles/opennn.dir/correlations.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/correlations.cpp.o.d"
+  "/root/repo/opennn/cross_entropy_error.cpp" "opennn/CMakeFiles/opennn.dir/cross_entropy_error.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/cross_entropy_error.cpp.o.d"
+  "/root/repo/opennn/csv_reader.cpp" "opennn/CMakeFiles/opennn.dir/csv_reader.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/csv_reader.cpp.o.d"
+  "/root/repo/opennn/data_parallel.cpp" "opennn/CMakeFiles/opennn.dir/data_parallel.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/data_parallel.cpp.o.d"
+  "/root/repo/opennn/data_set.cpp" "opennn/CMakeFiles/opennn.dir/data_set.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/data_set.cpp.o.d"
+  "/root/repo/opennn/data_shards.cpp" "opennn/CMakeFiles/opennn.dir/data_shards.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/data_shards.cpp.o.d"
+  "/root/repo/opennn/embedding_layer.cpp" "opennn/CMakeFiles/opennn.dir/embedding_layer.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/embedding_layer.cpp.o.d"
+  "/root/repo/opennn/execution_context.cpp" "opennn/CMakeFiles/opennn.dir/execution_context.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/execution_context.cpp.o.d"
+  "/root/repo/opennn/flatten_layer.cpp" "opennn/CMakeFiles/opennn.dir/flatten_layer.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/flatten_layer.cpp.o.d"
+  "/root/repo/opennn/genetic_algorithm.cpp" "opennn/CMakeFiles/opennn.dir/genetic_algorithm.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/genetic_algorithm.cpp.o.d"
+  "/root/repo/opennn/gradient_descent.cpp" "opennn/CMakeFiles/opennn.dir/gradient_descent.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/gradient_descent.cpp.o.d"
+  "/root/repo/opennn/growing_inputs.cpp" "opennn/CMakeFiles/opennn.dir/growing_inputs.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/growing_inputs.cpp.o.d"
+  "/root/repo/opennn/growing_neurons.cpp" "opennn/CMakeFiles/opennn.dir/growing_neurons.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/growing_neurons.cpp.o.d"
+  "/root/repo/opennn/image_augmentation.cpp" "opennn/CMakeFiles/opennn.dir/image_augmentation.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/image_augmentation.cpp.o.d"
+  "/root/repo/opennn/inputs_selection.cpp" "opennn/CMakeFiles/opennn.dir/inputs_selection.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/inputs_selection.cpp.o.d"
+  "/root/repo/opennn/json_to_xml.cpp" "opennn/CMakeFiles/opennn.dir/json_to_xml.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/json_to_xml.cpp.o.d"
+  "/root/repo/opennn/kmeans.cpp" "opennn/CMakeFiles/opennn.dir/kmeans.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/kmeans.cpp.o.d"
+  "/root/repo/opennn/layer.cpp" "opennn/CMakeFiles/opennn.dir/layer.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/layer.cpp.o.d"
+  "/root/repo/opennn/learning_rate_algorithm.cpp" "opennn/CMakeFiles/opennn.dir/learning_rate_algorithm.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/learning_rate_algorithm.cpp.o.d"
+  "/root/repo/opennn/levenberg_marquardt_algorithm.cpp" "opennn/CMakeFiles/opennn.dir/levenberg_marquardt_algorithm.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/levenberg_marquardt_algorithm.cpp.o.d"
+  "/root/repo/opennn/long_short_term_memory_layer.cpp" "opennn/CMakeFiles/opennn.dir/long_short_term_memory_layer.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/long_short_term_memory_layer.cpp.o.d"
+  "/root/repo/opennn/loss_index.cpp" "opennn/CMakeFiles/opennn.dir/loss_index.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/loss_index.cpp.o.d"
+  "/root/repo/opennn/mapped_file.cpp" "opennn/CMakeFiles/opennn.dir/mapped_file.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/mapped_file.cpp.o.d"
+  "/root/repo/opennn/mean_squared_error.cpp" "opennn/CMakeFiles/opennn.dir/mean_squared_error.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/mean_squared_error.cpp.o.d"
+  "/root/repo/opennn/memory_planner.cpp" "opennn/CMakeFiles/opennn.dir/memory_planner.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/memory_planner.cpp.o.d"
+  "/root/repo/opennn/minkowski_error.cpp" "opennn/CMakeFiles/opennn.dir/minkowski_error.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/minkowski_error.cpp.o.d"
+  "/root/repo/opennn/model_selection.cpp" "opennn/CMakeFiles/opennn.dir/model_selection.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/model_selection.cpp.o.d"
+  "/root/repo/opennn/multihead_attention_layer.cpp" "opennn/CMakeFiles/opennn.dir/multihead_attention_layer.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/multihead_attention_layer.cpp.o.d"
+  "/root/repo/opennn/neural_network.cpp" "opennn/CMakeFiles/opennn.dir/neural_network.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/neural_network.cpp.o.d"
+  "/root/repo/opennn/neurons_selection.cpp" "opennn/CMakeFiles/opennn.dir/neurons_selection.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/neurons_selection.cpp.o.d"
+  "/root/repo/opennn/non_max_suppression_layer.cpp" "opennn/CMakeFiles/opennn.dir/non_max_suppression_layer.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/non_max_suppression_layer.cpp.o.d"
+  "/root/repo/opennn/normalized_squared_error.cpp" "opennn/CMakeFiles/opennn.dir/normalized_squared_error.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/normalized_squared_error.cpp.o.d"
+  "/root/repo/opennn/numerical_differentiation.cpp" "opennn/CMakeFiles/opennn.dir/numerical_differentiation.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/numerical_differentiation.cpp.o.d"
+  "/root/repo/opennn/opennn_images.cpp" "opennn/CMakeFiles/opennn.dir/opennn_images.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/opennn_images.cpp.o.d"
+  "/root/repo/opennn/opennn_strings.cpp" "opennn/CMakeFiles/opennn.dir/opennn_strings.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/opennn_strings.cpp.o.d"
+  "/root/repo/opennn/optimization_algorithm.cpp" "opennn/CMakeFiles/opennn.dir/optimization_algorithm.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/optimization_algorithm.cpp.o.d"
+  "/root/repo/opennn/optimizer_kernels.cpp" "opennn/CMakeFiles/opennn.dir/optimizer_kernels.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/optimizer_kernels.cpp.o.d"
+  "/root/repo/opennn/perceptron_layer.cpp" "opennn/CMakeFiles/opennn.dir/perceptron_layer.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/perceptron_layer.cpp.o.d"
+  "/root/repo/opennn/pooling_layer.cpp" "opennn/CMakeFiles/opennn.dir/pooling_layer.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/pooling_layer.cpp.o.d"
+  "/root/repo/opennn/probabilistic_layer.cpp" "opennn/CMakeFiles/opennn.dir/probabilistic_layer.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/probabilistic_layer.cpp.o.d"
+  "/root/repo/opennn/pruning_inputs.cpp" "opennn/CMakeFiles/opennn.dir/pruning_inputs.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/pruning_inputs.cpp.o.d"
+  "/root/repo/opennn/quasi_newton_method.cpp" "opennn/CMakeFiles/opennn.dir/quasi_newton_method.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/quasi_newton_method.cpp.o.d"
+  "/root/repo/opennn/recurrent_layer.cpp" "opennn/CMakeFiles/opennn.dir/recurrent_layer.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/recurrent_layer.cpp.o.d"
+  "/root/repo/opennn/region_based_object_detector.cpp" "opennn/CMakeFiles/opennn.dir/region_based_object_detector.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/region_based_object_detector.cpp.o.d"
+  "/root/repo/opennn/resnet50.cpp" "opennn/CMakeFiles/opennn.dir/resnet50.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/resnet50.cpp.o.d"
+  "/root/repo/opennn/response_optimization.cpp" "opennn/CMakeFiles/opennn.dir/response_optimization.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/response_optimization.cpp.o.d"
+  "/root/repo/opennn/scaling.cpp" "opennn/CMakeFiles/opennn.dir/scaling.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/scaling.cpp.o.d"
+  "/root/repo/opennn/scaling_layer.cpp" "opennn/CMakeFiles/opennn.dir/scaling_layer.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/scaling_layer.cpp.o.d"
+  "/root/repo/opennn/statistics.cpp" "opennn/CMakeFiles/opennn.dir/statistics.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/statistics.cpp.o.d"
+  "/root/repo/opennn/statistics_accumulator.cpp" "opennn/CMakeFiles/opennn.dir/statistics_accumulator.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/statistics_accumulator.cpp.o.d"
+  "/root/repo/opennn/stochastic_gradient_descent.cpp" "opennn/CMakeFiles/opennn.dir/stochastic_gradient_descent.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/stochastic_gradient_descent.cpp.o.d"
+  "/root/repo/opennn/storage_precision.cpp" "opennn/CMakeFiles/opennn.dir/storage_precision.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/storage_precision.cpp.o.d"
+  "/root/repo/opennn/sum_squared_error.cpp" "opennn/CMakeFiles/opennn.dir/sum_squared_error.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/sum_squared_error.cpp.o.d"
+  "/root/repo/opennn/tensor_utilities.cpp" "opennn/CMakeFiles/opennn.dir/tensor_utilities.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/tensor_utilities.cpp.o.d"
+  "/root/repo/opennn/testing_analysis.cpp" "opennn/CMakeFiles/opennn.dir/testing_analysis.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/testing_analysis.cpp.o.d"
+  "/root/repo/opennn/text_analytics.cpp" "opennn/CMakeFiles/opennn.dir/text_analytics.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/text_analytics.cpp.o.d"
+  "/root/repo/opennn/tinyxml2.cpp" "opennn/CMakeFiles/opennn.dir/tinyxml2.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/tinyxml2.cpp.o.d"
+  "/root/repo/opennn/training_cache.cpp" "opennn/CMakeFiles/opennn.dir/training_cache.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/training_cache.cpp.o.d"
+  "/root/repo/opennn/training_strategy.cpp" "opennn/CMakeFiles/opennn.dir/training_strategy.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/training_strategy.cpp.o.d"
+  "/root/repo/opennn/unit_testing.cpp" "opennn/CMakeFiles/opennn.dir/unit_testing.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/unit_testing.cpp.o.d"
+  "/root/repo/opennn/unscaling_layer.cpp" "opennn/CMakeFiles/opennn.dir/unscaling_layer.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/unscaling_layer.cpp.o.d"
+  "/root/repo/opennn/vgg16.cpp" "opennn/CMakeFiles/opennn.dir/vgg16.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/vgg16.cpp.o.d"
+  "/root/repo/opennn/weighted_squared_error.cpp" "opennn/CMakeFiles/opennn.dir/weighted_squared_error.cpp.o" "gcc" "opennn/CMakeFiles/opennn.dir/weighted_squared_error.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
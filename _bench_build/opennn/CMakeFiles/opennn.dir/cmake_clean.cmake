@@ -0,0 +1,157 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/opennn.dir/adaptive_moment_estimation.cpp.o"
+  "CMakeFiles/opennn.dir/adaptive_moment_estimation.cpp.o.d"
+  "CMakeFiles/opennn.dir/addition_layer.cpp.o"
+  "CMakeFiles/opennn.dir/addition_layer.cpp.o.d"
+  "CMakeFiles/opennn.dir/batch_loader.cpp.o"
+  "CMakeFiles/opennn.dir/batch_loader.cpp.o.d"
+  "CMakeFiles/opennn.dir/binary_data_file.cpp.o"
+  "CMakeFiles/opennn.dir/binary_data_file.cpp.o.d"
+  "CMakeFiles/opennn.dir/bounding_box_regressor_layer.cpp.o"
+  "CMakeFiles/opennn.dir/bounding_box_regressor_layer.cpp.o.d"
+  "CMakeFiles/opennn.dir/bounding_layer.cpp.o"
+  "CMakeFiles/opennn.dir/bounding_layer.cpp.o.d"
+  "CMakeFiles/opennn.dir/codification.cpp.o"
+  "CMakeFiles/opennn.dir/codification.cpp.o.d"
+  "CMakeFiles/opennn.dir/concatenation_layer.cpp.o"
+  "CMakeFiles/opennn.dir/concatenation_layer.cpp.o.d"
+  "CMakeFiles/opennn.dir/conjugate_gradient.cpp.o"
+  "CMakeFiles/opennn.dir/conjugate_gradient.cpp.o.d"
+  "CMakeFiles/opennn.dir/convolution_engine.cpp.o"
+  "CMakeFiles/opennn.dir/convolution_engine.cpp.o.d"
+  "CMakeFiles/opennn.dir/convolutional_layer.cpp.o"
+  "CMakeFiles/opennn.dir/convolutional_layer.cpp.o.d"
+  "CMakeFiles/opennn.dir/correlations.cpp.o"
+  "CMakeFiles/opennn.dir/correlations.cpp.o.d"
+  "CMakeFiles/opennn.dir/cross_entropy_error.cpp.o"
+  "CMakeFiles/opennn.dir/cross_entropy_error.cpp.o.d"
+  "CMakeFiles/opennn.dir/csv_reader.cpp.o"
+  "CMakeFiles/opennn.dir/csv_reader.cpp.o.d"
+  "CMakeFiles/opennn.dir/data_parallel.cpp.o"
+  "CMakeFiles/opennn.dir/data_parallel.cpp.o.d"
+  "CMakeFiles/opennn.dir/data_set.cpp.o"
+  "CMakeFiles/opennn.dir/data_set.cpp.o.d"
+  "CMakeFiles/opennn.dir/data_shards.cpp.o"
+  "CMakeFiles/opennn.dir/data_shards.cpp.o.d"
+  "CMakeFiles/opennn.dir/embedding_layer.cpp.o"
+  "CMakeFiles/opennn.dir/embedding_layer.cpp.o.d"
+  "CMakeFiles/opennn.dir/execution_context.cpp.o"
+  "CMakeFiles/opennn.dir/execution_context.cpp.o.d"
+  "CMakeFiles/opennn.dir/flatten_layer.cpp.o"
+  "CMakeFiles/opennn.dir/flatten_layer.cpp.o.d"
+  "CMakeFiles/opennn.dir/genetic_algorithm.cpp.o"
+  "CMakeFiles/opennn.dir/genetic_algorithm.cpp.o.d"
+  "CMakeFiles/opennn.dir/gradient_descent.cpp.o"
+  "CMakeFiles/opennn.dir/gradient_descent.cpp.o.d"
+  "CMakeFiles/opennn.dir/growing_inputs.cpp.o"
+  "CMakeFiles/opennn.dir/growing_inputs.cpp.o.d"
+  "CMakeFiles/opennn.dir/growing_neurons.cpp.o"
+  "CMakeFiles/opennn.dir/growing_neurons.cpp.o.d"
+  "CMakeFiles/opennn.dir/image_augmentation.cpp.o"
+  "CMakeFiles/opennn.dir/image_augmentation.cpp.o.d"
+  "CMakeFiles/opennn.dir/inputs_selection.cpp.o"
+  "CMakeFiles/opennn.dir/inputs_selection.cpp.o.d"
+  "CMakeFiles/opennn.dir/json_to_xml.cpp.o"
+  "CMakeFiles/opennn.dir/json_to_xml.cpp.o.d"
+  "CMakeFiles/opennn.dir/kmeans.cpp.o"
+  "CMakeFiles/opennn.dir/kmeans.cpp.o.d"
+  "CMakeFiles/opennn.dir/layer.cpp.o"
+  "CMakeFiles/opennn.dir/layer.cpp.o.d"
+  "CMakeFiles/opennn.dir/learning_rate_algorithm.cpp.o"
+  "CMakeFiles/opennn.dir/learning_rate_algorithm.cpp.o.d"
+  "CMakeFiles/opennn.dir/levenberg_marquardt_algorithm.cpp.o"
+  "CMakeFiles/opennn.dir/levenberg_marquardt_algorithm.cpp.o.d"
+  "CMakeFiles/opennn.dir/long_short_term_memory_layer.cpp.o"
+  "CMakeFiles/opennn.dir/long_short_term_memory_layer.cpp.o.d"
+  "CMakeFiles/opennn.dir/loss_index.cpp.o"
+  "CMakeFiles/opennn.dir/loss_index.cpp.o.d"
+  "CMakeFiles/opennn.dir/mapped_file.cpp.o"
+  "CMakeFiles/opennn.dir/mapped_file.cpp.o.d"
+  "CMakeFiles/opennn.dir/mean_squared_error.cpp.o"
+  "CMakeFiles/opennn.dir/mean_squared_error.cpp.o.d"
+  "CMakeFiles/opennn.dir/memory_planner.cpp.o"
+  "CMakeFiles/opennn.dir/memory_planner.cpp.o.d"
+  "CMakeFiles/opennn.dir/minkowski_error.cpp.o"
+  "CMakeFiles/opennn.dir/minkowski_error.cpp.o.d"
+  "CMakeFiles/opennn.dir/model_selection.cpp.o"
+  "CMakeFiles/opennn.dir/model_selection.cpp.o.d"
+  "CMakeFiles/opennn.dir/multihead_attention_layer.cpp.o"
+  "CMakeFiles/opennn.dir/multihead_attention_layer.cpp.o.d"
+  "CMakeFiles/opennn.dir/neural_network.cpp.o"
+  "CMakeFiles/opennn.dir/neural_network.cpp.o.d"
+  "CMakeFiles/opennn.dir/neurons_selection.cpp.o"
+  "CMakeFiles/opennn.dir/neurons_selection.cpp.o.d"
+  "CMakeFiles/opennn.dir/non_max_suppression_layer.cpp.o"
+  "CMakeFiles/opennn.dir/non_max_suppression_layer.cpp.o.d"
+  "CMakeFiles/opennn.dir/normalized_squared_error.cpp.o"
+  "CMakeFiles/opennn.dir/normalized_squared_error.cpp.o.d"
+  "CMakeFiles/opennn.dir/numerical_differentiation.cpp.o"
+  "CMakeFiles/opennn.dir/numerical_differentiation.cpp.o.d"
+  "CMakeFiles/opennn.dir/opennn_images.cpp.o"
+  "CMakeFiles/opennn.dir/opennn_images.cpp.o.d"
+  "CMakeFiles/opennn.dir/opennn_strings.cpp.o"
+  "CMakeFiles/opennn.dir/opennn_strings.cpp.o.d"
+  "CMakeFiles/opennn.dir/optimization_algorithm.cpp.o"
+  "CMakeFiles/opennn.dir/optimization_algorithm.cpp.o.d"
+  "CMakeFiles/opennn.dir/optimizer_kernels.cpp.o"
+  "CMakeFiles/opennn.dir/optimizer_kernels.cpp.o.d"
+  "CMakeFiles/opennn.dir/perceptron_layer.cpp.o"
+  "CMakeFiles/opennn.dir/perceptron_layer.cpp.o.d"
+  "CMakeFiles/opennn.dir/pooling_layer.cpp.o"
+  "CMakeFiles/opennn.dir/pooling_layer.cpp.o.d"
+  "CMakeFiles/opennn.dir/probabilistic_layer.cpp.o"
+  "CMakeFiles/opennn.dir/probabilistic_layer.cpp.o.d"
+  "CMakeFiles/opennn.dir/pruning_inputs.cpp.o"
+  "CMakeFiles/opennn.dir/pruning_inputs.cpp.o.d"
+  "CMakeFiles/opennn.dir/quasi_newton_method.cpp.o"
+  "CMakeFiles/opennn.dir/quasi_newton_method.cpp.o.d"
+  "CMakeFiles/opennn.dir/recurrent_layer.cpp.o"
+  "CMakeFiles/opennn.dir/recurrent_layer.cpp.o.d"
+  "CMakeFiles/opennn.dir/region_based_object_detector.cpp.o"
+  "CMakeFiles/opennn.dir/region_based_object_detector.cpp.o.d"
+  "CMakeFiles/opennn.dir/resnet50.cpp.o"
+  "CMakeFiles/opennn.dir/resnet50.cpp.o.d"
+  "CMakeFiles/opennn.dir/response_optimization.cpp.o"
+  "CMakeFiles/opennn.dir/response_optimization.cpp.o.d"
+  "CMakeFiles/opennn.dir/scaling.cpp.o"
+  "CMakeFiles/opennn.dir/scaling.cpp.o.d"
+  "CMakeFiles/opennn.dir/scaling_layer.cpp.o"
+  "CMakeFiles/opennn.dir/scaling_layer.cpp.o.d"
+  "CMakeFiles/opennn.dir/statistics.cpp.o"
+  "CMakeFiles/opennn.dir/statistics.cpp.o.d"
+  "CMakeFiles/opennn.dir/statistics_accumulator.cpp.o"
+  "CMakeFiles/opennn.dir/statistics_accumulator.cpp.o.d"
+  "CMakeFiles/opennn.dir/stochastic_gradient_descent.cpp.o"
+  "CMakeFiles/opennn.dir/stochastic_gradient_descent.cpp.o.d"
+  "CMakeFiles/opennn.dir/storage_precision.cpp.o"
+  "CMakeFiles/opennn.dir/storage_precision.cpp.o.d"
+  "CMakeFiles/opennn.dir/sum_squared_error.cpp.o"
+  "CMakeFiles/opennn.dir/sum_squared_error.cpp.o.d"
+  "CMakeFiles/opennn.dir/tensor_utilities.cpp.o"
+  "CMakeFiles/opennn.dir/tensor_utilities.cpp.o.d"
+  "CMakeFiles/opennn.dir/testing_analysis.cpp.o"
+  "CMakeFiles/opennn.dir/testing_analysis.cpp.o.d"
+  "CMakeFiles/opennn.dir/text_analytics.cpp.o"
+  "CMakeFiles/opennn.dir/text_analytics.cpp.o.d"
+  "CMakeFiles/opennn.dir/tinyxml2.cpp.o"
+  "CMakeFiles/opennn.dir/tinyxml2.cpp.o.d"
+  "CMakeFiles/opennn.dir/training_cache.cpp.o"
+  "CMakeFiles/opennn.dir/training_cache.cpp.o.d"
+  "CMakeFiles/opennn.dir/training_strategy.cpp.o"
+  "CMakeFiles/opennn.dir/training_strategy.cpp.o.d"
+  "CMakeFiles/opennn.dir/unit_testing.cpp.o"
+  "CMakeFiles/opennn.dir/unit_testing.cpp.o.d"
+  "CMakeFiles/opennn.dir/unscaling_layer.cpp.o"
+  "CMakeFiles/opennn.dir/unscaling_layer.cpp.o.d"
+  "CMakeFiles/opennn.dir/vgg16.cpp.o"
+  "CMakeFiles/opennn.dir/vgg16.cpp.o.d"
+  "CMakeFiles/opennn.dir/weighted_squared_error.cpp.o"
+  "CMakeFiles/opennn.dir/weighted_squared_error.cpp.o.d"
+  "libopennn.a"
+  "libopennn.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/opennn.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,161 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   B A T C H   G A T H E R   B E N C H M A R K
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+// This benchmark gathers random batches from a wide data matrix with the two layouts.
+// The reference is fill_submatrix, which reads the column major data matrix column by column,
+// with one random row per value. The second layout is the training cache, which holds the samples in rows,
+// so that each sample of a batch is read contiguously. Both report the time per batch and the
+// gather throughput in GB/s. The numbers of samples and columns are taken from the command line,
+// by default 100000 samples of 1000 columns.
+
+// System includes
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+// OpenNN includes
+
+#include "../../opennn/opennn.h"
+
+using namespace opennn;
+
+
+template<typename Function>
+double get_time(const Function& function)
+{
+    const auto beginning_time = chrono::steady_clock::now();
+
+    function();
+
+    return chrono::duration<double>(chrono::steady_clock::now() - beginning_time).count();
+}
+
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        cout << "OpenNN. Batch gather benchmark." << endl;
+
+        const Index samples_number = argc > 1 ? atoi(argv[1]) : 100000;
+        const Index columns_number = argc > 2 ? atoi(argv[2]) : 1000;
+
+        const Index batch_samples_number = 1000;
+        const Index batches_number = 100;
+
+        cout << "Threads: " << ExecutionContext::get_threads_number() << endl;
+        cout << "Data: " << samples_number << " samples, " << columns_number << " columns" << endl;
+
+        Tensor<type, 2> data(samples_number, columns_number);
+        data.setRandom();
+
+        Tensor<Index, 1> input_variables_indices(columns_number - 1);
+
+        for(Index j = 0; j < columns_number - 1; j++) input_variables_indices(j) = j;
+
+        Tensor<Index, 1> target_variables_indices(1);
+        target_variables_indices.setConstant(columns_number - 1);
+
+        Tensor<Index, 1> samples_indices(samples_number);
+
+        for(Index i = 0; i < samples_number; i++) samples_indices(i) = i;
+
+        mt19937 random_engine(0);
+
+        shuffle(samples_indices.data(), samples_indices.data() + samples_number, random_engine);
+
+        Tensor<Index, 2> batches_samples_indices(batches_number, batch_samples_number);
+
+        for(Index i = 0; i < batches_number; i++)
+            for(Index j = 0; j < batch_samples_number; j++)
+                batches_samples_indices(i, j) = samples_indices((i*batch_samples_number + j)%samples_number);
+
+        Tensor<Index, 1> batch_samples_indices(batch_samples_number);
+
+        Tensor<type, 2> inputs(batch_samples_number, columns_number - 1);
+        Tensor<type, 2> targets(batch_samples_number, 1);
+
+        const double gigabytes = double(batches_number*batch_samples_number*columns_number*sizeof(type))/1.0e9;
+
+        // Column major data
+
+        const double columns_time = get_time([&]()
+        {
+            for(Index i = 0; i < batches_number; i++)
+            {
+                batch_samples_indices = batches_samples_indices.chip(i, 0);
+
+                fill_submatrix(data, batch_samples_indices, input_variables_indices, inputs.data());
+                fill_submatrix(data, batch_samples_indices, target_variables_indices, targets.data());
+            }
+        });
+
+        const Tensor<type, 0> columns_checksum = inputs.sum();
+
+        cout << "Column major data: " << 1000*columns_time/batches_number << " ms per batch, "
+             << gigabytes/columns_time << " GB/s" << endl;
+
+        // Training cache
+
+        TrainingCache training_cache;
+
+        const double build_time = get_time([&]()
+        {
+            training_cache.set(data, input_variables_indices, target_variables_indices);
+        });
+
+        const double cache_time = get_time([&]()
+        {
+            for(Index i = 0; i < batches_number; i++)
+            {
+                batch_samples_indices = batches_samples_indices.chip(i, 0);
+
+                training_cache.fill_inputs(batch_samples_indices, inputs.data());
+                training_cache.fill_targets(batch_samples_indices, targets.data());
+            }
+        });
+
+        const Tensor<type, 0> cache_checksum = inputs.sum();
+
+        cout << "Training cache: " << 1000*cache_time/batches_number << " ms per batch, "
+             << gigabytes/cache_time << " GB/s, built in " << build_time << " s" << endl;
+
+        if(columns_checksum(0) != cache_checksum(0))
+            cerr << "Batches differ." << endl;
+
+        cout << "Bye!" << endl;
+
+        return 0;
+    }
+    catch(const exception& e)
+    {
+        cerr << e.what() << endl;
+
+        return 1;
+    }
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) Artificial Intelligence Techniques SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
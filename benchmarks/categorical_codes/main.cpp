@@ -0,0 +1,190 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   C A T E G O R I C A L   C O D E S   B E N C H M A R K
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+// This benchmark trains a neural network on a data set with two categorical inputs of many categories,
+// once with the categorical inputs as one hot variables and once as codes of their categories.
+// It reports the memory of the training cache, the multiply-adds of the first layer per sample,
+// the time per epoch and the training error of each representation.
+
+// System includes
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+// OpenNN includes
+
+#include "../../opennn/opennn.h"
+
+using namespace opennn;
+
+
+int main()
+{
+    try
+    {
+        cout << "OpenNN. Categorical codes benchmark." << endl;
+
+        cout << "Threads: " << ExecutionContext::get_threads_number() << endl;
+
+        const Index samples_number = 10000;
+        const Index numeric_columns_number = 8;
+        const Index categorical_columns_number = 2;
+        const Index categories_number = 2000;
+
+        const Index neurons_number = 64;
+        const Index batch_samples_number = 1000;
+        const Index epochs_number = 10;
+
+        const Index variables_number = numeric_columns_number + categorical_columns_number*categories_number + 1;
+
+        // Data
+
+        mt19937 random_engine(0);
+        normal_distribution<type> normal_distribution(type(0), type(1));
+        uniform_int_distribution<Index> categories_distribution(0, categories_number - 1);
+
+        Tensor<type, 2> categories_effects(categories_number, categorical_columns_number);
+
+        for(Index i = 0; i < categories_effects.size(); i++) categories_effects(i) = normal_distribution(random_engine);
+
+        Tensor<type, 2> data(samples_number, variables_number);
+        data.setZero();
+
+        for(Index i = 0; i < samples_number; i++)
+        {
+            type target = type(0);
+
+            for(Index j = 0; j < numeric_columns_number; j++)
+            {
+                data(i, j) = normal_distribution(random_engine);
+
+                target += data(i, j)/type(numeric_columns_number);
+            }
+
+            for(Index j = 0; j < categorical_columns_number; j++)
+            {
+                const Index category = categories_distribution(random_engine);
+
+                data(i, numeric_columns_number + j*categories_number + category) = type(1);
+
+                target += categories_effects(category, j);
+            }
+
+            data(i, variables_number - 1) = target;
+        }
+
+        Tensor<DataSet::Column, 1> columns(numeric_columns_number + categorical_columns_number + 1);
+
+        for(Index j = 0; j < numeric_columns_number; j++)
+        {
+            columns(j) = DataSet::Column("x_" + to_string(j), DataSet::VariableUse::Input,
+                                         DataSet::ColumnType::Numeric, Scaler::MeanStandardDeviation);
+        }
+
+        Tensor<string, 1> categories(categories_number);
+
+        for(Index k = 0; k < categories_number; k++) categories(k) = to_string(k);
+
+        Tensor<DataSet::VariableUse, 1> categories_uses(categories_number);
+        categories_uses.setConstant(DataSet::VariableUse::Input);
+
+        for(Index j = 0; j < categorical_columns_number; j++)
+        {
+            columns(numeric_columns_number + j) = DataSet::Column("category_" + to_string(j), DataSet::VariableUse::Input,
+                                                                  DataSet::ColumnType::Categorical, Scaler::MinimumMaximum,
+                                                                  categories, categories_uses);
+        }
+
+        columns(numeric_columns_number + categorical_columns_number)
+                = DataSet::Column("y", DataSet::VariableUse::Target, DataSet::ColumnType::Numeric, Scaler::MeanStandardDeviation);
+
+        cout << "Samples: " << samples_number << ", columns: " << columns.size()
+             << ", variables: " << variables_number << ", neurons: " << neurons_number << endl;
+
+        // Training
+
+        for(const bool& use_categorical_inputs_codes : {false, true})
+        {
+            DataSet data_set;
+
+            data_set.set_data(data);
+            data_set.set_columns(columns);
+            data_set.set_training();
+            data_set.set_display(false);
+
+            data_set.set_use_training_cache(true);
+            data_set.set_use_categorical_inputs_codes(use_categorical_inputs_codes);
+
+            srand(0);
+
+            NeuralNetwork neural_network(NeuralNetwork::ProjectType::Approximation,
+                                         {data_set.get_input_variables_number(), neurons_number, data_set.get_target_variables_number()});
+
+            TrainingStrategy training_strategy(&neural_network, &data_set);
+
+            training_strategy.set_optimization_method(TrainingStrategy::OptimizationMethod::ADAPTIVE_MOMENT_ESTIMATION);
+
+            AdaptiveMomentEstimation* adaptive_moment_estimation_pointer = training_strategy.get_adaptive_moment_estimation_pointer();
+
+            adaptive_moment_estimation_pointer->set_batch_samples_number(batch_samples_number);
+            adaptive_moment_estimation_pointer->set_maximum_epochs_number(epochs_number);
+
+            training_strategy.set_display(false);
+
+            const auto beginning_time = chrono::steady_clock::now();
+
+            TrainingResults training_results = training_strategy.perform_training();
+
+            const double time = chrono::duration<double>(chrono::steady_clock::now() - beginning_time).count();
+
+            // Unscaling the data after training frees the training cache, which has the same size for the unscaled data
+
+            data_set.update_training_cache();
+
+            // Each input column of the batches costs a multiply-add per neuron, a code adds a single row of synaptic weights
+
+            const Index first_layer_multiply_adds = data_set.get_input_codes_number()*neurons_number;
+
+            cout << (use_categorical_inputs_codes ? "Codes: " : "One hot: ")
+                 << double(data_set.get_training_cache().get_bytes_number())/1.0e6 << " MB of training cache, "
+                 << first_layer_multiply_adds << " first layer multiply-adds per sample, "
+                 << 1000*time/epochs_number << " ms per epoch, "
+                 << "training error " << training_results.get_training_error() << endl;
+        }
+
+        cout << "Bye!" << endl;
+
+        return 0;
+    }
+    catch(const exception& e)
+    {
+        cerr << e.what() << endl;
+
+        return 1;
+    }
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) Artificial Intelligence Techniques SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -0,0 +1,130 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   C O N C U R R E N T   L I N E   S E A R C H   B E N C H M A R K
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+// This benchmark trains a neural network with the quasi-Newton method and the gradient descent,
+// evaluating 1, 2, 4 and 8 learning rates concurrently in each round of the line search.
+// It reports the time per epoch and the training error for each number of candidates.
+// The candidates only run concurrently with more than one thread.
+
+// System includes
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// OpenNN includes
+
+#include "../../opennn/opennn.h"
+
+using namespace opennn;
+
+
+int main()
+{
+    try
+    {
+        cout << "OpenNN. Concurrent line search benchmark." << endl;
+
+        cout << "Threads: " << ExecutionContext::get_threads_number() << endl;
+
+        const Index samples_number = 2000;
+        const Index inputs_number = 20;
+        const Index neurons_number = 50;
+        const Index outputs_number = 1;
+
+        const Index epochs_number = 20;
+
+        DataSet data_set;
+
+        data_set.set(samples_number, inputs_number, outputs_number);
+        data_set.set_data_random();
+        data_set.set_training();
+        data_set.set_display(false);
+
+        NeuralNetwork neural_network(NeuralNetwork::ProjectType::Approximation, {inputs_number, neurons_number, outputs_number});
+
+        for(const TrainingStrategy::OptimizationMethod& optimization_method : {TrainingStrategy::OptimizationMethod::QUASI_NEWTON_METHOD,
+                                                                              TrainingStrategy::OptimizationMethod::GRADIENT_DESCENT})
+        {
+            TrainingStrategy training_strategy(&neural_network, &data_set);
+
+            training_strategy.set_loss_method(TrainingStrategy::LossMethod::MEAN_SQUARED_ERROR);
+            training_strategy.set_optimization_method(optimization_method);
+
+            const bool is_quasi_Newton = optimization_method == TrainingStrategy::OptimizationMethod::QUASI_NEWTON_METHOD;
+
+            cout << (is_quasi_Newton ? "Quasi-Newton method" : "Gradient descent") << endl;
+
+            for(const Index& candidates_number : {1, 2, 4, 8})
+            {
+                if(is_quasi_Newton)
+                {
+                    QuasiNewtonMethod* quasi_newton_method_pointer = training_strategy.get_quasi_Newton_method_pointer();
+
+                    quasi_newton_method_pointer->get_learning_rate_algorithm_pointer()->set_candidates_number(candidates_number);
+                    quasi_newton_method_pointer->set_maximum_epochs_number(epochs_number);
+                    quasi_newton_method_pointer->set_minimum_loss_decrease(type(0));
+                    quasi_newton_method_pointer->set_loss_goal(type(0));
+                }
+                else
+                {
+                    GradientDescent* gradient_descent_pointer = training_strategy.get_gradient_descent_pointer();
+
+                    gradient_descent_pointer->get_learning_rate_algorithm_pointer()->set_candidates_number(candidates_number);
+                    gradient_descent_pointer->set_maximum_epochs_number(epochs_number);
+                    gradient_descent_pointer->set_minimum_loss_decrease(type(0));
+                    gradient_descent_pointer->set_loss_goal(type(0));
+                }
+
+                training_strategy.set_display(false);
+
+                srand(0);
+
+                neural_network.set_parameters_random();
+
+                const auto beginning_time = chrono::steady_clock::now();
+
+                TrainingResults training_results = training_strategy.perform_training();
+
+                const double time = chrono::duration<double>(chrono::steady_clock::now() - beginning_time).count();
+
+                cout << "  " << candidates_number << " candidates: "
+                     << 1000*time/double(training_results.get_epochs_number() + 1) << " ms per epoch, "
+                     << "training error " << training_results.get_training_error() << endl;
+            }
+        }
+
+        cout << "Bye!" << endl;
+
+        return 0;
+    }
+    catch(const exception& e)
+    {
+        cerr << e.what() << endl;
+
+        return 1;
+    }
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) Artificial Intelligence Techniques SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
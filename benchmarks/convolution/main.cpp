@@ -0,0 +1,246 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   C O N V O L U T I O N   B E N C H M A R K
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+// This benchmark times the convolution backends on layer shapes taken from VGG16 and ResNet50,
+// with smaller batches and images so that it runs in a few seconds.
+// The reference is the previous implementation, which padded the inputs and called the Eigen
+// tensor convolution once per kernel. Each backend reports the forward convolutions, the kernels
+// derivatives and the inputs derivatives, and the backend the autotuner chooses.
+
+// System includes
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// OpenNN includes
+
+#include "../../opennn/opennn.h"
+
+using namespace opennn;
+
+struct Shape
+{
+    string name;
+    ConvolutionDimensions dimensions;
+};
+
+
+ConvolutionDimensions get_dimensions(const Index& batch_samples_number,
+                                     const Index& inputs_size,
+                                     const Index& inputs_channels_number,
+                                     const Index& kernel_size,
+                                     const Index& kernels_number,
+                                     const Index& stride)
+{
+    ConvolutionDimensions dimensions;
+
+    dimensions.batch_samples_number = batch_samples_number;
+    dimensions.inputs_rows_number = inputs_size;
+    dimensions.inputs_columns_number = inputs_size;
+    dimensions.inputs_channels_number = inputs_channels_number;
+    dimensions.kernels_rows_number = kernel_size;
+    dimensions.kernels_columns_number = kernel_size;
+    dimensions.kernels_number = kernels_number;
+    dimensions.row_stride = stride;
+    dimensions.column_stride = stride;
+    dimensions.padding_rows = (kernel_size - 1)/2;
+    dimensions.padding_columns = (kernel_size - 1)/2;
+
+    return dimensions;
+}
+
+
+template<typename Function>
+double get_minimum_time(const Function& function, const int& repetitions_number)
+{
+    double minimum_time = numeric_limits<double>::max();
+
+    for(int i = 0; i < repetitions_number; i++)
+    {
+        const auto beginning_time = chrono::steady_clock::now();
+
+        function();
+
+        minimum_time = min(minimum_time, chrono::duration<double>(chrono::steady_clock::now() - beginning_time).count());
+    }
+
+    return minimum_time*1000;
+}
+
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        cout << "OpenNN. Convolution benchmark." << endl;
+
+        srand(0);
+
+        const Index batch_samples_number = argc > 1 ? atoi(argv[1]) : 8;
+        const int repetitions_number = argc > 2 ? atoi(argv[2]) : 3;
+
+        cout << "Threads: " << ExecutionContext::get_threads_number() << endl;
+        cout << "Batch samples: " << batch_samples_number << endl;
+
+        const Shape shapes[] = {{"VGG16 block 1, 3x3 3->64, 56x56", get_dimensions(batch_samples_number, 56, 3, 3, 64, 1)},
+                                {"VGG16 block 2, 3x3 64->64, 56x56", get_dimensions(batch_samples_number, 56, 64, 3, 64, 1)},
+                                {"VGG16 block 4, 3x3 256->256, 14x14", get_dimensions(batch_samples_number, 14, 256, 3, 256, 1)},
+                                {"ResNet50 stem, 7x7/2 3->64, 56x56", get_dimensions(batch_samples_number, 56, 3, 7, 64, 2)},
+                                {"ResNet50 bottleneck, 1x1 256->64, 28x28", get_dimensions(batch_samples_number, 28, 256, 1, 64, 1)}};
+
+        ThreadPoolDevice* thread_pool_device = ExecutionContext::get_thread_pool_device();
+
+        for(const Shape& shape : shapes)
+        {
+            const ConvolutionDimensions& dimensions = shape.dimensions;
+
+            const Index outputs_rows_number = dimensions.get_outputs_rows_number();
+            const Index outputs_columns_number = dimensions.get_outputs_columns_number();
+
+            Tensor<type, 4> inputs(dimensions.batch_samples_number,
+                                   dimensions.inputs_rows_number,
+                                   dimensions.inputs_columns_number,
+                                   dimensions.inputs_channels_number);
+
+            Tensor<type, 4> synaptic_weights(dimensions.kernels_rows_number,
+                                             dimensions.kernels_columns_number,
+                                             dimensions.inputs_channels_number,
+                                             dimensions.kernels_number);
+
+            Tensor<type, 1> biases(dimensions.kernels_number);
+
+            Tensor<type, 4> outputs(dimensions.batch_samples_number,
+                                    outputs_rows_number,
+                                    outputs_columns_number,
+                                    dimensions.kernels_number);
+
+            Tensor<type, 4> synaptic_weights_derivatives(synaptic_weights.dimensions());
+            Tensor<type, 1> biases_derivatives(biases.dimension(0));
+            Tensor<type, 4> inputs_derivatives(inputs.dimensions());
+
+            inputs.setRandom();
+            synaptic_weights.setRandom();
+            biases.setRandom();
+
+            cout << endl << shape.name << ", "
+                 << 2.0e-9*outputs.size()*dimensions.get_kernel_size() << " GFLOP per pass" << endl;
+
+            // Previous implementation, stride one only
+
+            if(dimensions.row_stride == 1 && dimensions.column_stride == 1)
+            {
+                const Eigen::array<pair<Index, Index>, 4> paddings = {make_pair(0, 0),
+                                                                      make_pair(dimensions.padding_rows, dimensions.padding_rows),
+                                                                      make_pair(dimensions.padding_columns, dimensions.padding_columns),
+                                                                      make_pair(0, 0)};
+
+                const Eigen::array<ptrdiff_t, 3> convolutions_dimensions = {1, 2, 3};
+
+                Tensor<type, 4> preprocessed_inputs;
+
+                const Index single_kernel_size = dimensions.get_kernel_size();
+                const Index single_output_size = dimensions.batch_samples_number*outputs_rows_number*outputs_columns_number;
+
+                const double forward_time = get_minimum_time([&]()
+                {
+                    preprocessed_inputs = inputs.pad(paddings);
+
+                    for(Index kernel_index = 0; kernel_index < dimensions.kernels_number; kernel_index++)
+                    {
+                        const TensorMap<Tensor<type, 3>> kernel(synaptic_weights.data() + kernel_index*single_kernel_size,
+                                                                dimensions.kernels_rows_number,
+                                                                dimensions.kernels_columns_number,
+                                                                dimensions.inputs_channels_number);
+
+                        TensorMap<Tensor<type, 4>> convolution(outputs.data() + kernel_index*single_output_size,
+                                                               dimensions.batch_samples_number,
+                                                               outputs_rows_number,
+                                                               outputs_columns_number,
+                                                               1);
+
+                        convolution.device(*thread_pool_device) = preprocessed_inputs.convolve(kernel, convolutions_dimensions)
+                                                                  + biases(kernel_index);
+                    }
+                }, repetitions_number);
+
+                cout << "  Eigen convolve: forward " << forward_time << " ms" << endl;
+            }
+
+            // Backends
+
+            const ConvolutionEngine::Backend backends[] = {ConvolutionEngine::Backend::Im2col,
+                                                           ConvolutionEngine::Backend::Winograd,
+                                                           ConvolutionEngine::Backend::Direct};
+
+            for(const ConvolutionEngine::Backend& backend : backends)
+            {
+                if(!ConvolutionEngine::is_applicable(backend, dimensions)) continue;
+
+                ConvolutionEngine convolution_engine(dimensions, backend);
+
+                const double forward_time = get_minimum_time([&]()
+                {
+                    convolution_engine.calculate_convolutions(inputs.data(), synaptic_weights.data(), biases.data(), outputs.data());
+                }, repetitions_number);
+
+                const double synaptic_weights_derivatives_time = get_minimum_time([&]()
+                {
+                    convolution_engine.calculate_synaptic_weights_derivatives(inputs.data(),
+                                                                              outputs.data(),
+                                                                              synaptic_weights_derivatives.data(),
+                                                                              biases_derivatives.data());
+                }, repetitions_number);
+
+                const double inputs_derivatives_time = get_minimum_time([&]()
+                {
+                    convolution_engine.calculate_inputs_derivatives(outputs.data(), synaptic_weights.data(), inputs_derivatives.data());
+                }, repetitions_number);
+
+                cout << "  " << ConvolutionEngine::write_backend(backend) << ": "
+                     << "forward " << forward_time << " ms, "
+                     << "kernels derivatives " << synaptic_weights_derivatives_time << " ms, "
+                     << "inputs derivatives " << inputs_derivatives_time << " ms" << endl;
+            }
+
+            ConvolutionEngine convolution_engine(dimensions);
+
+            convolution_engine.calculate_convolutions(inputs.data(), synaptic_weights.data(), biases.data(), outputs.data());
+
+            cout << "  Autotuner choice: " << ConvolutionEngine::write_backend(convolution_engine.get_selected_backend()) << endl;
+        }
+
+        cout << "Bye!" << endl;
+
+        return 0;
+    }
+    catch(const exception& e)
+    {
+        cerr << e.what() << endl;
+
+        return 1;
+    }
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) Artificial Intelligence Techniques SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
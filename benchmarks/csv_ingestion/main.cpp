@@ -0,0 +1,173 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   C S V   I N G E S T I O N   B E N C H M A R K
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+// This benchmark writes a synthetic numeric data file and loads it twice.
+// The reference is the previous implementation, which read the file line by line with getline
+// and parsed each value with strtof. The second load is read_csv, which maps the file and parses
+// chunks of lines concurrently. Both report the loading time and the throughput in MB/s.
+// The size of the file in MB and its path are taken from the command line, by default 5 GB in the
+// temporary directory.
+
+// System includes
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+// OpenNN includes
+
+#include "../../opennn/opennn.h"
+
+using namespace opennn;
+
+
+void write_data_file(const string& file_name, const Index& megabytes_number, const Index& columns_number)
+{
+    ofstream file(file_name);
+
+    if(!file.is_open())
+    {
+        ostringstream buffer;
+
+        buffer << "Cannot open file " << file_name << "\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    for(Index i = 0; i < columns_number; i++)
+        file << "column_" << i << (i == columns_number - 1 ? '\n' : ',');
+
+    const Index bytes_number = megabytes_number*1024*1024;
+
+    string line;
+
+    while(Index(file.tellp()) < bytes_number)
+    {
+        line.clear();
+
+        for(Index i = 0; i < columns_number; i++)
+        {
+            line += to_string(double(rand())/RAND_MAX*2000 - 1000);
+            line += (i == columns_number - 1 ? '\n' : ',');
+        }
+
+        file << line;
+    }
+}
+
+
+template<typename Function>
+double get_time(const Function& function)
+{
+    const auto beginning_time = chrono::steady_clock::now();
+
+    function();
+
+    return chrono::duration<double>(chrono::steady_clock::now() - beginning_time).count();
+}
+
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        cout << "OpenNN. CSV ingestion benchmark." << endl;
+
+        srand(0);
+
+        const Index megabytes_number = argc > 1 ? atoi(argv[1]) : 5*1024;
+
+        const string file_name = argc > 2
+                ? string(argv[2])
+                : (filesystem::temp_directory_path()/"opennn_csv_ingestion.csv").string();
+
+        const Index columns_number = 20;
+
+        cout << "Threads: " << ExecutionContext::get_threads_number() << endl;
+        cout << "Writing " << megabytes_number << " MB to " << file_name << "..." << endl;
+
+        write_data_file(file_name, megabytes_number, columns_number);
+
+        const double megabytes = double(filesystem::file_size(file_name))/(1024*1024);
+
+        // Previous implementation
+
+        DataSet data_set;
+
+        data_set.set_data_file_name(file_name);
+        data_set.set_separator(',');
+        data_set.set_has_columns_names(true);
+        data_set.set_display(false);
+
+        const double line_reader_time = get_time([&]()
+        {
+            data_set.read_csv_1();
+            data_set.read_csv_2_simple();
+            data_set.read_csv_3_simple();
+        });
+
+        const Index line_reader_samples_number = data_set.get_samples_number();
+
+        cout << "Line reader: " << line_reader_time << " s, "
+             << megabytes/line_reader_time << " MB/s, "
+             << line_reader_samples_number << " samples" << endl;
+
+        // Mapped reader
+
+        data_set.set();
+
+        data_set.set_data_file_name(file_name);
+        data_set.set_separator(',');
+        data_set.set_has_columns_names(true);
+        data_set.set_display(false);
+
+        const double mapped_reader_time = get_time([&]()
+        {
+            data_set.read_csv();
+        });
+
+        cout << "Mapped reader: " << mapped_reader_time << " s, "
+             << megabytes/mapped_reader_time << " MB/s, "
+             << data_set.get_samples_number() << " samples" << endl;
+
+        if(data_set.get_samples_number() != line_reader_samples_number)
+            cerr << "Samples numbers differ." << endl;
+
+        if(argc <= 2) filesystem::remove(file_name);
+
+        cout << "Bye!" << endl;
+
+        return 0;
+    }
+    catch(const exception& e)
+    {
+        cerr << e.what() << endl;
+
+        return 1;
+    }
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) Artificial Intelligence Techniques SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
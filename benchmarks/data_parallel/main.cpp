@@ -0,0 +1,262 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   D A T A   P A R A L L E L   B E N C H M A R K
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+// This benchmark trains a neural network with the adaptive moment estimation in 1, 2, 4 and 8 processes
+// on the local machine, connected with Unix domain sockets or, with the argument "tcp", with loopback TCP sockets.
+// The threads of the machine are split among the processes, and the batch of all the processes has the same size.
+// It reports the time per epoch, the speedup and the efficiency for each number of processes,
+// and checks that the final parameters are bit-identical in all the processes.
+
+// System includes
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+// OpenNN includes
+
+#include "../../opennn/opennn.h"
+
+using namespace opennn;
+
+
+const Index samples_number = 16384;
+const Index inputs_number = 32;
+const Index neurons_number = 128;
+const Index outputs_number = 1;
+
+const Index batch_samples_number = 512;
+const Index epochs_number = 10;
+
+
+/// Trains the neural network in a process of the ring and writes the hash of its parameters and the time per epoch to a pipe.
+
+void run_worker(const Index& rank, const Index& ranks_number, const SocketTransport::Family& family, const string& address, const int& pipe_descriptor)
+{
+    const int threads_number = max(1, int(thread::hardware_concurrency())/int(ranks_number));
+
+    ExecutionContext::set_threads_number(threads_number);
+
+    // The same data on all the processes
+
+    mt19937 generator(0);
+    uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    Tensor<type, 2> data(samples_number, inputs_number + outputs_number);
+
+    for(Index j = 0; j < inputs_number; j++)
+        for(Index i = 0; i < samples_number; i++)
+            data(i, j) = type(distribution(generator));
+
+    for(Index i = 0; i < samples_number; i++)
+    {
+        type target = type(0);
+
+        for(Index j = 0; j < inputs_number; j++) target += sin(data(i, j)*type(j + 1));
+
+        data(i, inputs_number) = target/type(inputs_number);
+    }
+
+    DataSet data_set(samples_number, inputs_number, outputs_number);
+    data_set.set_data(data);
+    data_set.set_training();
+    data_set.set_display(false);
+
+    NeuralNetwork neural_network(NeuralNetwork::ProjectType::Approximation, {inputs_number, neurons_number, outputs_number});
+
+    srand(unsigned(rank + 1));
+
+    neural_network.set_parameters_random();
+
+    MeanSquaredError mean_squared_error(&neural_network, &data_set);
+
+    SocketTransport transport(rank, ranks_number, family, address);
+
+    Communicator communicator(&transport);
+
+    AdaptiveMomentEstimation adaptive_moment_estimation(&mean_squared_error);
+
+    adaptive_moment_estimation.set_communicator_pointer(&communicator);
+    adaptive_moment_estimation.set_batch_samples_number(batch_samples_number);
+    adaptive_moment_estimation.set_maximum_epochs_number(epochs_number - 1);
+    adaptive_moment_estimation.set_loss_goal(type(0));
+    adaptive_moment_estimation.set_display(false);
+
+    const auto beginning_time = chrono::steady_clock::now();
+
+    adaptive_moment_estimation.perform_training();
+
+    const double time = chrono::duration<double>(chrono::steady_clock::now() - beginning_time).count();
+
+    // FNV-1a hash of the bytes of the parameters
+
+    const Tensor<type, 1> parameters = neural_network.get_parameters();
+
+    const unsigned char* parameters_bytes = reinterpret_cast<const unsigned char*>(parameters.data());
+
+    unsigned long long hash = 14695981039346656037ULL;
+
+    for(size_t i = 0; i < size_t(parameters.size())*sizeof(type); i++)
+    {
+        hash ^= parameters_bytes[i];
+        hash *= 1099511628211ULL;
+    }
+
+    const string line = to_string(hash) + " " + to_string(1000*time/double(epochs_number)) + "\n";
+
+    if(write(pipe_descriptor, line.c_str(), line.size()) != ssize_t(line.size())) exit(1);
+}
+
+
+int main(int argc, char* argv[])
+{
+    const bool is_tcp = argc > 1 && string(argv[1]) == "tcp";
+
+    const SocketTransport::Family family = is_tcp ? SocketTransport::Family::TCP : SocketTransport::Family::Unix;
+
+    cout << "OpenNN. Data parallel benchmark." << endl;
+
+    cout << "Transport: " << (is_tcp ? "TCP loopback" : "Unix domain sockets") << endl;
+
+    cout << "Threads: " << thread::hardware_concurrency() << endl;
+
+    double single_process_time = 0.0;
+
+    int port = 23000;
+
+    for(const Index& ranks_number : {1, 2, 4, 8})
+    {
+        const string address = is_tcp
+                ? "127.0.0.1:" + to_string(port)
+                : "/tmp/opennn_data_parallel_benchmark_" + to_string(getpid());
+
+        port += 10;
+
+        // The processes are forked before any thread is created
+
+        Tensor<int, 1> pipes_descriptors(ranks_number);
+        Tensor<pid_t, 1> processes_identifiers(ranks_number);
+
+        for(Index rank = 0; rank < ranks_number; rank++)
+        {
+            int pipe_descriptors[2];
+
+            if(pipe(pipe_descriptors) != 0) return 1;
+
+            const pid_t process_identifier = fork();
+
+            if(process_identifier == 0)
+            {
+                close(pipe_descriptors[0]);
+
+                try
+                {
+                    run_worker(rank, ranks_number, family, address, pipe_descriptors[1]);
+                }
+                catch(const exception& e)
+                {
+                    cerr << e.what() << endl;
+
+                    _exit(1);
+                }
+
+                _exit(0);
+            }
+
+            close(pipe_descriptors[1]);
+
+            pipes_descriptors(rank) = pipe_descriptors[0];
+            processes_identifiers(rank) = process_identifier;
+        }
+
+        // Results of the processes
+
+        Tensor<string, 1> hashes(ranks_number);
+
+        double time_per_epoch = 0.0;
+
+        bool has_failed = false;
+
+        for(Index rank = 0; rank < ranks_number; rank++)
+        {
+            char line[128] = {0};
+
+            FILE* pipe_file = fdopen(pipes_descriptors(rank), "r");
+
+            unsigned long long hash = 0;
+            double rank_time_per_epoch = 0.0;
+
+            if(!fgets(line, sizeof(line), pipe_file) || sscanf(line, "%llu %lf", &hash, &rank_time_per_epoch) != 2)
+                has_failed = true;
+
+            fclose(pipe_file);
+
+            int status = 0;
+
+            waitpid(processes_identifiers(rank), &status, 0);
+
+            if(!WIFEXITED(status) || WEXITSTATUS(status) != 0) has_failed = true;
+
+            hashes(rank) = to_string(hash);
+
+            time_per_epoch = max(time_per_epoch, rank_time_per_epoch);
+        }
+
+        if(has_failed)
+        {
+            cerr << ranks_number << " processes: training failed." << endl;
+
+            return 1;
+        }
+
+        bool are_identical = true;
+
+        for(Index rank = 1; rank < ranks_number; rank++)
+            if(hashes(rank) != hashes(0)) are_identical = false;
+
+        if(ranks_number == 1) single_process_time = time_per_epoch;
+
+        const double speedup = single_process_time/time_per_epoch;
+
+        cout << "  " << ranks_number << " processes: "
+             << time_per_epoch << " ms per epoch, "
+             << "speedup " << speedup << ", "
+             << "efficiency " << 100.0*speedup/double(ranks_number) << " %, "
+             << "parameters " << (are_identical ? "identical" : "DIFFERENT") << endl;
+
+        if(!are_identical) return 1;
+    }
+
+    cout << "Bye!" << endl;
+
+    return 0;
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) Artificial Intelligence Techniques SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -0,0 +1,161 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   D A T A   P R O F I L I N G   B E N C H M A R K
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+// This benchmark profiles a data matrix, with the descriptives, box plots and histograms of every column.
+// The reference copies each column and calls descriptives(), box_plot() and histogram(),
+// which scan the column several times and sort it for the quartiles.
+// The accumulators compute the descriptives and the box plots in a single parallel pass,
+// with a quantile sketch for the quartiles, and the histograms in two passes.
+// It reports the times and the largest differences of the means and the quartiles.
+// The numbers of samples and columns are taken from the command line, by default 1000000 samples of 20 columns.
+
+// System includes
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// OpenNN includes
+
+#include "../../opennn/opennn.h"
+
+using namespace opennn;
+
+
+template<typename Function>
+double get_time(const Function& function)
+{
+    const auto beginning_time = chrono::steady_clock::now();
+
+    function();
+
+    return chrono::duration<double>(chrono::steady_clock::now() - beginning_time).count();
+}
+
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        cout << "OpenNN. Data profiling benchmark." << endl;
+
+        const Index samples_number = argc > 1 ? atoi(argv[1]) : 1000000;
+        const Index columns_number = argc > 2 ? atoi(argv[2]) : 20;
+
+        const Index bins_number = 10;
+
+        cout << "Threads: " << ExecutionContext::get_threads_number() << endl;
+        cout << "Data: " << samples_number << " samples, " << columns_number << " columns" << endl;
+
+        Tensor<type, 2> data(samples_number, columns_number);
+        data.setRandom();
+
+        Tensor<Index, 1> samples_indices(samples_number);
+
+        for(Index i = 0; i < samples_number; i++) samples_indices(i) = i;
+
+        Tensor<Index, 1> columns_indices(columns_number);
+
+        for(Index j = 0; j < columns_number; j++) columns_indices(j) = j;
+
+        // Column by column
+
+        Tensor<Descriptives, 1> columns_descriptives(columns_number);
+        Tensor<BoxPlot, 1> box_plots(columns_number);
+        Tensor<Histogram, 1> histograms(columns_number);
+
+        const double columns_time = get_time([&]()
+        {
+            Tensor<type, 1> column(samples_number);
+
+            for(Index j = 0; j < columns_number; j++)
+            {
+                column = data.chip(j, 1);
+
+                columns_descriptives(j) = Descriptives(column);
+                box_plots(j) = box_plot(column, samples_indices);
+                histograms(j) = histogram(column, bins_number);
+            }
+        });
+
+        cout << "Column by column: " << columns_time << " s" << endl;
+
+        // Accumulators
+
+        Tensor<Descriptives, 1> accumulated_descriptives;
+        Tensor<BoxPlot, 1> accumulated_box_plots(columns_number);
+        Tensor<Histogram, 1> accumulated_histograms;
+
+        const double accumulators_time = get_time([&]()
+        {
+            const Tensor<StatisticsAccumulator, 1> accumulators
+                    = accumulate_statistics(data, samples_indices, columns_indices, StatisticsAccumulator(true));
+
+            accumulated_descriptives.resize(columns_number);
+
+            for(Index j = 0; j < columns_number; j++)
+            {
+                accumulated_descriptives(j) = accumulators(j).to_descriptives();
+                accumulated_box_plots(j) = accumulators(j).to_box_plot();
+            }
+
+            accumulated_histograms = columns_histograms(data, samples_indices, columns_indices, bins_number);
+        });
+
+        cout << "Accumulators: " << accumulators_time << " s" << endl;
+
+        type mean_error = type(0);
+        type quartiles_error = type(0);
+        Index frequencies_error = 0;
+
+        for(Index j = 0; j < columns_number; j++)
+        {
+            mean_error = max(mean_error, abs(accumulated_descriptives(j).mean - columns_descriptives(j).mean));
+
+            quartiles_error = max(quartiles_error, abs(accumulated_box_plots(j).first_quartile - box_plots(j).first_quartile));
+            quartiles_error = max(quartiles_error, abs(accumulated_box_plots(j).median - box_plots(j).median));
+            quartiles_error = max(quartiles_error, abs(accumulated_box_plots(j).third_quartile - box_plots(j).third_quartile));
+
+            for(Index k = 0; k < histograms(j).get_bins_number(); k++)
+                frequencies_error = max(frequencies_error, abs(accumulated_histograms(j).frequencies(k) - histograms(j).frequencies(k)));
+        }
+
+        cout << "Largest differences: mean " << mean_error << ", quartiles " << quartiles_error
+             << ", frequencies " << frequencies_error << endl;
+
+        cout << "Speedup: " << columns_time/accumulators_time << endl;
+
+        cout << "Bye!" << endl;
+
+        return 0;
+    }
+    catch(const exception& e)
+    {
+        cerr << e.what() << endl;
+
+        return 1;
+    }
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) Artificial Intelligence Techniques SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -0,0 +1,134 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   L I M I T E D   M E M O R Y   B F G S   B E N C H M A R K
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+// This benchmark trains neural networks of increasing size with the quasi-Newton method,
+// approximating the inverse hessian with BFGS and with limited memory BFGS.
+// It reports the memory of the inverse hessian approximation, the time per epoch and the training error.
+// BFGS is skipped when its inverse hessians would not fit in a few hundred megabytes.
+
+// System includes
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// OpenNN includes
+
+#include "../../opennn/opennn.h"
+
+using namespace opennn;
+
+
+int main()
+{
+    try
+    {
+        cout << "OpenNN. Limited memory BFGS benchmark." << endl;
+
+        cout << "Threads: " << ExecutionContext::get_threads_number() << endl;
+
+        const Index samples_number = 1000;
+        const Index inputs_number = 20;
+        const Index outputs_number = 1;
+
+        const Index epochs_number = 20;
+        const Index history_size = 10;
+
+        const double maximum_dense_megabytes = 500;
+
+        DataSet data_set(samples_number, inputs_number, outputs_number);
+
+        data_set.set_data_random();
+        data_set.set_training();
+        data_set.set_display(false);
+
+        for(const Index& neurons_number : {50, 200, 2000})
+        {
+            NeuralNetwork neural_network(NeuralNetwork::ProjectType::Approximation, {inputs_number, neurons_number, outputs_number});
+
+            const Index parameters_number = neural_network.get_parameters_number();
+
+            cout << "Parameters: " << parameters_number << endl;
+
+            for(const string& method : {"BFGS", "L-BFGS"})
+            {
+                TrainingStrategy training_strategy(&neural_network, &data_set);
+
+                training_strategy.set_loss_method(TrainingStrategy::LossMethod::MEAN_SQUARED_ERROR);
+                training_strategy.set_optimization_method(TrainingStrategy::OptimizationMethod::QUASI_NEWTON_METHOD);
+
+                QuasiNewtonMethod* quasi_newton_method_pointer = training_strategy.get_quasi_Newton_method_pointer();
+
+                quasi_newton_method_pointer->set_inverse_hessian_approximation_method(method);
+                quasi_newton_method_pointer->set_history_size(history_size);
+                quasi_newton_method_pointer->set_maximum_epochs_number(epochs_number);
+                quasi_newton_method_pointer->set_minimum_loss_decrease(type(0));
+                quasi_newton_method_pointer->set_loss_goal(type(0));
+
+                training_strategy.set_display(false);
+
+                // The dense methods store the inverse hessian and the old inverse hessian,
+                // the limited memory method the parameters and gradient differences
+
+                const double megabytes = method == "BFGS"
+                        ? 2.0*double(parameters_number)*double(parameters_number)*sizeof(type)/1.0e6
+                        : 2.0*double(parameters_number)*double(history_size)*sizeof(type)/1.0e6;
+
+                cout << "  " << method << ": " << megabytes << " MB of inverse hessian approximation";
+
+                if(megabytes > maximum_dense_megabytes)
+                {
+                    cout << ", skipped" << endl;
+
+                    continue;
+                }
+
+                srand(0);
+
+                neural_network.set_parameters_random();
+
+                const auto beginning_time = chrono::steady_clock::now();
+
+                TrainingResults training_results = training_strategy.perform_training();
+
+                const double time = chrono::duration<double>(chrono::steady_clock::now() - beginning_time).count();
+
+                cout << ", " << 1000*time/double(training_results.get_epochs_number() + 1) << " ms per epoch, "
+                     << "training error " << training_results.get_training_error() << endl;
+            }
+        }
+
+        cout << "Bye!" << endl;
+
+        return 0;
+    }
+    catch(const exception& e)
+    {
+        cerr << e.what() << endl;
+
+        return 1;
+    }
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) Artificial Intelligence Techniques SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -0,0 +1,304 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   S T O R A G E   P R E C I S I O N   B E N C H M A R K
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+// This benchmark compares the single, half and bfloat16 storage precisions in three parts.
+// The first part gathers random batches from training caches of a wide data matrix, and reports the memory
+// of each cache, the gather throughput and the largest rounding error of the batches.
+// The second part calculates the outputs of a large multilayer perceptron with its parameters in single precision
+// and frozen in the reduced precisions, and reports the time per batch and the largest difference of the outputs.
+// The third part trains the bundled airfoil self noise and iris plant examples with the training cache in each
+// precision, and reports the testing errors of the trained networks with their parameters in each precision.
+// The directory of the examples is taken from the command line, by default that of the source tree.
+
+// System includes
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+// OpenNN includes
+
+#include "../../opennn/opennn.h"
+
+using namespace opennn;
+
+
+template<typename Function>
+double get_time(const Function& function)
+{
+    const auto beginning_time = chrono::steady_clock::now();
+
+    function();
+
+    return chrono::duration<double>(chrono::steady_clock::now() - beginning_time).count();
+}
+
+
+const StoragePrecision storage_precisions[] = {StoragePrecision::Single, StoragePrecision::Half, StoragePrecision::BFloat16};
+
+
+void benchmark_training_cache()
+{
+    cout << "\nTraining cache" << endl;
+
+    const Index samples_number = 100000;
+    const Index columns_number = 500;
+
+    const Index batch_samples_number = 1000;
+    const Index batches_number = 100;
+
+    Tensor<type, 2> data(samples_number, columns_number);
+    data.setRandom();
+
+    Tensor<Index, 1> input_variables_indices(columns_number - 1);
+
+    for(Index j = 0; j < columns_number - 1; j++) input_variables_indices(j) = j;
+
+    Tensor<Index, 1> target_variables_indices(1);
+    target_variables_indices.setConstant(columns_number - 1);
+
+    mt19937 random_engine(0);
+    uniform_int_distribution<Index> samples_distribution(0, samples_number - 1);
+
+    Tensor<Index, 2> batches_samples_indices(batch_samples_number, batches_number);
+
+    for(Index i = 0; i < batches_samples_indices.size(); i++) batches_samples_indices(i) = samples_distribution(random_engine);
+
+    Tensor<Index, 1> batch_samples_indices(batch_samples_number);
+
+    Tensor<type, 2> inputs(batch_samples_number, columns_number - 1);
+    Tensor<type, 2> targets(batch_samples_number, 1);
+
+    Tensor<type, 2> data_inputs(batch_samples_number, columns_number - 1);
+
+    batch_samples_indices = batches_samples_indices.chip(0, 1);
+
+    fill_submatrix(data, batch_samples_indices, input_variables_indices, data_inputs.data());
+
+    const double gigabytes = double(batches_number*batch_samples_number*columns_number*sizeof(type))/1.0e9;
+
+    for(const StoragePrecision& storage_precision : storage_precisions)
+    {
+        TrainingCache training_cache(data, input_variables_indices, target_variables_indices, storage_precision);
+
+        const double time = get_time([&]()
+        {
+            for(Index i = 0; i < batches_number; i++)
+            {
+                batch_samples_indices = batches_samples_indices.chip(i, 1);
+
+                training_cache.fill_inputs(batch_samples_indices, inputs.data());
+                training_cache.fill_targets(batch_samples_indices, targets.data());
+            }
+        });
+
+        batch_samples_indices = batches_samples_indices.chip(0, 1);
+
+        training_cache.fill_inputs(batch_samples_indices, inputs.data());
+
+        const Tensor<type, 0> maximum_error = (inputs - data_inputs).abs().maximum();
+
+        cout << write_storage_precision(storage_precision) << ": "
+             << double(training_cache.get_bytes_number())/1.0e6 << " MB, "
+             << 1000*time/batches_number << " ms per batch, "
+             << gigabytes/time << " GB/s of batches, "
+             << "largest error " << maximum_error(0) << endl;
+    }
+}
+
+
+void benchmark_inference()
+{
+    cout << "\nInference" << endl;
+
+    const Index inputs_number = 1024;
+    const Index neurons_number = 2048;
+    const Index outputs_number = 16;
+
+    const Index batch_samples_number = 64;
+    const Index batches_number = 50;
+
+    NeuralNetwork neural_network(NeuralNetwork::ProjectType::Approximation,
+                                 {inputs_number, neurons_number, neurons_number, outputs_number});
+
+    neural_network.set_parameters_random();
+
+    Tensor<type, 2> inputs(batch_samples_number, inputs_number);
+    inputs.setRandom();
+
+    Tensor<Index, 1> inputs_dimensions = get_dimensions(inputs);
+
+    const Tensor<type, 2> outputs = neural_network.calculate_outputs(inputs.data(), inputs_dimensions);
+
+    cout << "Network: " << inputs_number << "-" << neurons_number << "-" << neurons_number << "-" << outputs_number
+         << ", batches of " << batch_samples_number << " samples" << endl;
+
+    for(const StoragePrecision& storage_precision : storage_precisions)
+    {
+        neural_network.freeze_parameters(storage_precision);
+
+        Tensor<type, 2> frozen_outputs = neural_network.calculate_outputs(inputs.data(), inputs_dimensions);
+
+        const double time = get_time([&]()
+        {
+            for(Index i = 0; i < batches_number; i++)
+            {
+                frozen_outputs = neural_network.calculate_outputs(inputs.data(), inputs_dimensions);
+            }
+        });
+
+        const Tensor<type, 0> maximum_difference = (frozen_outputs - outputs).abs().maximum();
+
+        cout << write_storage_precision(storage_precision) << ": "
+             << 1000*time/batches_number << " ms per batch, "
+             << "largest difference " << maximum_difference(0) << endl;
+    }
+}
+
+
+Tensor<type, 2> calculate_testing_outputs(NeuralNetwork& neural_network, DataSet& data_set)
+{
+    Tensor<type, 2> inputs = data_set.get_testing_input_data();
+
+    Tensor<Index, 1> inputs_dimensions = get_dimensions(inputs);
+
+    return neural_network.calculate_outputs(inputs.data(), inputs_dimensions);
+}
+
+
+type calculate_testing_error(NeuralNetwork& neural_network, DataSet& data_set)
+{
+    const Tensor<type, 2> targets = data_set.get_testing_target_data();
+
+    const Tensor<type, 2> outputs = calculate_testing_outputs(neural_network, data_set);
+
+    const Tensor<type, 0> mean_squared_error = (outputs - targets).square().mean();
+
+    return mean_squared_error(0);
+}
+
+
+type calculate_testing_accuracy(NeuralNetwork& neural_network, DataSet& data_set)
+{
+    const Tensor<type, 2> targets = data_set.get_testing_target_data();
+
+    const Tensor<type, 2> outputs = calculate_testing_outputs(neural_network, data_set);
+
+    const Tensor<Index, 1> outputs_classes = outputs.argmax(1);
+    const Tensor<Index, 1> targets_classes = targets.argmax(1);
+
+    Index correct_samples_number = 0;
+
+    for(Index i = 0; i < targets.dimension(0); i++)
+    {
+        if(outputs_classes(i) == targets_classes(i)) correct_samples_number++;
+    }
+
+    return type(correct_samples_number)/type(targets.dimension(0));
+}
+
+
+void benchmark_example(const string& data_file_name, const NeuralNetwork::ProjectType& project_type, const Index& neurons_number)
+{
+    cout << "\n" << data_file_name << endl;
+
+    for(const StoragePrecision& training_cache_precision : storage_precisions)
+    {
+        srand(0);
+
+        DataSet data_set(data_file_name, ';', true);
+
+        data_set.set_use_training_cache(true);
+        data_set.set_training_cache_precision(training_cache_precision);
+
+        NeuralNetwork neural_network(project_type,
+                                     {data_set.get_input_variables_number(), neurons_number, data_set.get_target_variables_number()});
+
+        TrainingStrategy training_strategy(&neural_network, &data_set);
+
+        training_strategy.set_optimization_method(TrainingStrategy::OptimizationMethod::ADAPTIVE_MOMENT_ESTIMATION);
+        training_strategy.get_adaptive_moment_estimation_pointer()->set_maximum_epochs_number(1000);
+        training_strategy.set_display(false);
+
+        training_strategy.perform_training();
+
+        cout << "Training cache in " << write_storage_precision(training_cache_precision) << ", testing";
+
+        for(const StoragePrecision& parameters_precision : storage_precisions)
+        {
+            neural_network.freeze_parameters(parameters_precision);
+
+            if(project_type == NeuralNetwork::ProjectType::Classification)
+            {
+                cout << " accuracy with " << write_storage_precision(parameters_precision) << " parameters "
+                     << calculate_testing_accuracy(neural_network, data_set) << ";";
+            }
+            else
+            {
+                cout << " error with " << write_storage_precision(parameters_precision) << " parameters "
+                     << calculate_testing_error(neural_network, data_set) << ";";
+            }
+        }
+
+        cout << endl;
+    }
+}
+
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        cout << "OpenNN. Storage precision benchmark." << endl;
+
+        const string examples_directory = argc > 1 ? argv[1] : OPENNN_EXAMPLES_DIRECTORY;
+
+        cout << "Threads: " << ExecutionContext::get_threads_number() << endl;
+
+        benchmark_training_cache();
+
+        benchmark_inference();
+
+        benchmark_example(examples_directory + "/airfoil_self_noise/data/airfoil_self_noise.csv",
+                          NeuralNetwork::ProjectType::Approximation,
+                          10);
+
+        benchmark_example(examples_directory + "/iris_plant/data/iris_plant_original.csv",
+                          NeuralNetwork::ProjectType::Classification,
+                          3);
+
+        cout << "Bye!" << endl;
+
+        return 0;
+    }
+    catch(const exception& e)
+    {
+        cerr << e.what() << endl;
+
+        return 1;
+    }
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) Artificial Intelligence Techniques SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -0,0 +1,123 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   S T R E A M I N G   L E V E N B E R G   M A R Q U A R D T   B E N C H M A R K
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+// This benchmark trains a neural network with the Levenberg-Marquardt algorithm on data sets of increasing size,
+// forming the squared errors Jacobian of all the training samples and accumulating it over blocks of samples.
+// It reports the memory of the Jacobian, the time per epoch and the training error of each damped system solver.
+
+// System includes
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// OpenNN includes
+
+#include "../../opennn/opennn.h"
+
+using namespace opennn;
+
+
+int main()
+{
+    try
+    {
+        cout << "OpenNN. Streaming Levenberg-Marquardt benchmark." << endl;
+
+        cout << "Threads: " << ExecutionContext::get_threads_number() << endl;
+
+        const Index inputs_number = 10;
+        const Index neurons_number = 20;
+        const Index outputs_number = 1;
+
+        const Index epochs_number = 10;
+        const Index block_samples_number = 1000;
+
+        for(const Index& samples_number : {2000, 20000})
+        {
+            DataSet data_set(samples_number, inputs_number, outputs_number);
+
+            data_set.set_data_random();
+            data_set.set_training();
+            data_set.set_display(false);
+
+            NeuralNetwork neural_network(NeuralNetwork::ProjectType::Approximation, {inputs_number, neurons_number, outputs_number});
+
+            const Index parameters_number = neural_network.get_parameters_number();
+
+            cout << "Samples: " << samples_number << ", parameters: " << parameters_number << endl;
+
+            for(const Index& block_size : {samples_number, block_samples_number})
+            {
+                for(const string& damped_system_solver : {"Cholesky", "EigenDecomposition"})
+                {
+                    TrainingStrategy training_strategy(&neural_network, &data_set);
+
+                    training_strategy.set_loss_method(TrainingStrategy::LossMethod::MEAN_SQUARED_ERROR);
+                    training_strategy.set_optimization_method(TrainingStrategy::OptimizationMethod::LEVENBERG_MARQUARDT_ALGORITHM);
+
+                    LevenbergMarquardtAlgorithm* Levenberg_Marquardt_algorithm_pointer
+                            = training_strategy.get_Levenberg_Marquardt_algorithm_pointer();
+
+                    Levenberg_Marquardt_algorithm_pointer->set_block_samples_number(block_size);
+                    Levenberg_Marquardt_algorithm_pointer->set_damped_system_solver(damped_system_solver);
+                    Levenberg_Marquardt_algorithm_pointer->set_maximum_epochs_number(epochs_number);
+                    Levenberg_Marquardt_algorithm_pointer->set_minimum_loss_decrease(type(0));
+                    Levenberg_Marquardt_algorithm_pointer->set_loss_goal(type(0));
+
+                    training_strategy.set_display(false);
+
+                    const double megabytes = double(block_size)*double(outputs_number)*double(parameters_number)*sizeof(type)/1.0e6;
+
+                    srand(0);
+
+                    neural_network.set_parameters_random();
+
+                    const auto beginning_time = chrono::steady_clock::now();
+
+                    TrainingResults training_results = training_strategy.perform_training();
+
+                    const double time = chrono::duration<double>(chrono::steady_clock::now() - beginning_time).count();
+
+                    cout << "  " << (block_size == samples_number ? "Full" : "Blocks") << ", " << damped_system_solver << ": "
+                         << megabytes << " MB of Jacobian, "
+                         << 1000*time/double(training_results.get_epochs_number() + 1) << " ms per epoch, "
+                         << "training error " << training_results.get_training_error() << endl;
+                }
+            }
+        }
+
+        cout << "Bye!" << endl;
+
+        return 0;
+    }
+    catch(const exception& e)
+    {
+        cerr << e.what() << endl;
+
+        return 1;
+    }
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) Artificial Intelligence Techniques SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
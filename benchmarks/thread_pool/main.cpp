@@ -0,0 +1,189 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   T H R E A D   P O O L   B E N C H M A R K
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+// This benchmark builds a deep network together with a training strategy and a testing analysis,
+// and reports how many operating system threads the process has.
+// All the objects share the pool of the execution context, so the count does not grow with the number of layers.
+// It then trains the network with several thread configurations and reports the time and the
+// involuntary context switches, which grow when the machine is oversubscribed.
+
+// System includes
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+    #include <sys/resource.h>
+#endif
+
+// OpenNN includes
+
+#include "../../opennn/opennn.h"
+
+using namespace opennn;
+
+
+/// Returns the number of threads of this process, or -1 if it cannot be known.
+
+long threads_number()
+{
+    ifstream file("/proc/self/status");
+
+    string line;
+
+    while(getline(file, line))
+        if(line.compare(0, 8, "Threads:") == 0)
+            return stol(line.substr(8));
+
+    return -1;
+}
+
+
+/// Returns the number of times this process has been descheduled by the system while it was runnable.
+
+long involuntary_context_switches()
+{
+#ifdef __linux__
+    rusage usage;
+
+    getrusage(RUSAGE_SELF, &usage);
+
+    return usage.ru_nivcsw;
+#else
+    return 0;
+#endif
+}
+
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        cout << "OpenNN. Thread pool benchmark." << endl;
+
+        srand(0);
+
+        const Index hidden_layers_number = argc > 1 ? atoi(argv[1]) : 50;
+        const Index samples_number = argc > 2 ? atoi(argv[2]) : 4096;
+        const int epochs_number = argc > 3 ? atoi(argv[3]) : 5;
+
+        const Index inputs_number = 32;
+        const Index hidden_neurons_number = 64;
+        const Index outputs_number = 1;
+
+        const int cores_number = max(1, static_cast<int>(thread::hardware_concurrency()));
+
+        cout << "Cores: " << cores_number << endl;
+        cout << "NUMA nodes: " << ExecutionContext::get_numa_nodes_number() << endl;
+        cout << "Threads before building the model: " << threads_number() << endl;
+
+        // Data set
+
+        DataSet data_set(samples_number, inputs_number, outputs_number);
+
+        data_set.set_data_random();
+
+        // Neural network
+
+        Tensor<Index, 1> architecture(hidden_layers_number + 2);
+
+        architecture.setConstant(hidden_neurons_number);
+        architecture(0) = inputs_number;
+        architecture(hidden_layers_number + 1) = outputs_number;
+
+        NeuralNetwork neural_network(NeuralNetwork::ProjectType::Approximation, architecture);
+
+        // Training strategy and testing analysis
+
+        TrainingStrategy training_strategy(&neural_network, &data_set);
+
+        training_strategy.set_loss_method(TrainingStrategy::LossMethod::MEAN_SQUARED_ERROR);
+        training_strategy.set_optimization_method(TrainingStrategy::OptimizationMethod::ADAPTIVE_MOMENT_ESTIMATION);
+        training_strategy.set_maximum_epochs_number(epochs_number);
+        training_strategy.set_display(false);
+
+        TestingAnalysis testing_analysis(&neural_network, &data_set);
+
+        // One layer, six loss indices, six optimization algorithms, three learning rate algorithms,
+        // the data set and the testing analysis used to own a pool each.
+
+        const Index pool_owners_number = neural_network.get_layers_number() + 6 + 6 + 3 + 1 + 1;
+
+        cout << "Layers: " << neural_network.get_layers_number() << endl;
+        cout << "Objects evaluating on the shared pool: " << pool_owners_number << endl;
+        cout << "Threads with one pool per object would be about: " << pool_owners_number*ExecutionContext::get_threads_number() << endl;
+        cout << "Threads after building the model: " << threads_number() << endl;
+
+        // Training with several thread configurations
+
+        struct Configuration
+        {
+            string name;
+            int threads_number;
+            bool pin;
+        };
+
+        const Configuration configurations[] = {{"All cores", cores_number, false},
+                                                {"All cores, pinned", cores_number, true},
+                                                {"Half of the cores", max(1, cores_number/2), false},
+                                                {"One core", 1, false}};
+
+        for(const Configuration& configuration : configurations)
+        {
+            ExecutionContext::set(configuration.threads_number, configuration.pin, -1);
+
+            neural_network.set_parameters_random();
+
+            const long beginning_switches = involuntary_context_switches();
+            const auto beginning_time = chrono::steady_clock::now();
+
+            TrainingResults training_results = training_strategy.perform_training();
+
+            const double seconds = chrono::duration<double>(chrono::steady_clock::now() - beginning_time).count();
+            const long switches = involuntary_context_switches() - beginning_switches;
+
+            cout << configuration.name << ": "
+                 << configuration.threads_number << " pool threads, "
+                 << threads_number() << " process threads, "
+                 << seconds << " s, "
+                 << switches << " involuntary context switches, "
+                 << "training error " << training_results.get_training_error() << endl;
+        }
+
+        cout << "Bye!" << endl;
+
+        return 0;
+    }
+    catch(const exception& e)
+    {
+        cerr << e.what() << endl;
+
+        return 1;
+    }
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) Artificial Intelligence Techniques SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -0,0 +1,303 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   T R A I N I N G   A L L O C A T I O N S   B E N C H M A R K
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+// This benchmark trains a deep stack of perceptron layers with Adam and counts
+// the heap allocations made in every phase of a training iteration.
+// In steady state the forward propagation should not allocate nor copy activations.
+// It also counts the allocations of the forward propagation for deployment, and reports the memory
+// that the outputs of the layers take when training and when deploying.
+
+// System includes
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+
+// OpenNN includes
+
+#include "../../opennn/opennn.h"
+
+using namespace opennn;
+
+// Allocation counting
+
+static atomic<long long> allocations_number(0);
+
+void* operator new(size_t size)
+{
+    allocations_number.fetch_add(1, memory_order_relaxed);
+
+    void* pointer = std::malloc(size == 0 ? 1 : size);
+
+    if(!pointer) throw bad_alloc();
+
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
+#ifdef __GLIBC__
+
+// DynamicTensor and Eigen allocate with malloc, so malloc itself is wrapped when glibc allows it.
+// Allocations through operator new end up here as well, so they are not counted twice.
+
+extern "C"
+{
+    void* __libc_malloc(size_t);
+    void* __libc_calloc(size_t, size_t);
+    void* __libc_realloc(void*, size_t);
+
+    void* malloc(size_t size)
+    {
+        allocations_number.fetch_add(1, memory_order_relaxed);
+
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t elements_number, size_t size)
+    {
+        allocations_number.fetch_add(1, memory_order_relaxed);
+
+        return __libc_calloc(elements_number, size);
+    }
+
+    void* realloc(void* pointer, size_t size)
+    {
+        allocations_number.fetch_add(1, memory_order_relaxed);
+
+        return __libc_realloc(pointer, size);
+    }
+}
+
+#endif
+
+
+struct PhaseCounter
+{
+    void start()
+    {
+        beginning_allocations = allocations_number.load();
+        beginning_time = chrono::steady_clock::now();
+    }
+
+    void stop()
+    {
+        allocations += allocations_number.load() - beginning_allocations;
+        microseconds += chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - beginning_time).count();
+    }
+
+    void print(const string& name, const Index& iterations_number) const
+    {
+        cout << name << ": "
+             << static_cast<double>(allocations)/static_cast<double>(iterations_number) << " allocations/iteration, "
+             << static_cast<double>(microseconds)/static_cast<double>(iterations_number) << " us/iteration" << endl;
+    }
+
+    long long beginning_allocations = 0;
+    chrono::steady_clock::time_point beginning_time;
+
+    long long allocations = 0;
+    long long microseconds = 0;
+};
+
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        cout << "OpenNN. Training allocations benchmark." << endl;
+
+        srand(0);
+
+        const Index samples_number = argc > 1 ? atoi(argv[1]) : 2048;
+        const Index inputs_number = 64;
+        const Index hidden_layers_number = argc > 2 ? atoi(argv[2]) : 16;
+        const Index hidden_neurons_number = 256;
+        const Index outputs_number = 8;
+        const Index batch_samples_number = 256;
+
+        const Index warm_up_iterations_number = 5;
+        const Index iterations_number = 50;
+
+        // Data set
+
+        DataSet data_set(samples_number, inputs_number, outputs_number);
+
+        data_set.set_data_random();
+
+        // The default uses make only the last column a target
+
+        Tensor<Index, 1> input_columns_indices(inputs_number);
+        for(Index i = 0; i < inputs_number; i++) input_columns_indices(i) = i;
+
+        Tensor<Index, 1> target_columns_indices(outputs_number);
+        for(Index i = 0; i < outputs_number; i++) target_columns_indices(i) = inputs_number + i;
+
+        data_set.set_input_target_columns(input_columns_indices, target_columns_indices);
+
+        data_set.set_training();
+
+        const Tensor<Index, 1> input_variables_indices = data_set.get_input_variables_indices();
+        const Tensor<Index, 1> target_variables_indices = data_set.get_target_variables_indices();
+        const Tensor<Index, 1> training_samples_indices = data_set.get_training_samples_indices();
+
+        // Neural network
+
+        Tensor<Index, 1> architecture(hidden_layers_number + 2);
+
+        architecture.setConstant(hidden_neurons_number);
+        architecture(0) = inputs_number;
+        architecture(hidden_layers_number + 1) = outputs_number;
+
+        NeuralNetwork neural_network(NeuralNetwork::ProjectType::Approximation, architecture);
+
+        cout << "Perceptron layers: " << neural_network.get_perceptron_layers_number() << endl;
+        cout << "Parameters: " << neural_network.get_parameters_number() << endl;
+
+        // Training objects
+
+        MeanSquaredError mean_squared_error(&neural_network, &data_set);
+
+        AdaptiveMomentEstimation adaptive_moment_estimation(&mean_squared_error);
+
+        DataSetBatch batch(batch_samples_number, &data_set);
+
+        NeuralNetworkForwardPropagation forward_propagation(batch_samples_number, &neural_network);
+
+        LossIndexBackPropagation back_propagation(batch_samples_number, &mean_squared_error);
+
+        AdaptiveMomentEstimationData optimization_data(&adaptive_moment_estimation);
+
+        optimization_data.iteration = 1;
+
+        const Tensor<Index, 2> training_batches = data_set.get_batches(training_samples_indices, batch_samples_number, false);
+
+        const Index batches_number = training_batches.dimension(0);
+
+        Tensor<Index, 1> batch_samples_indices(batch_samples_number);
+
+        bool is_training = true;
+
+        PhaseCounter fill_counter;
+        PhaseCounter forward_counter;
+        PhaseCounter backward_counter;
+        PhaseCounter update_counter;
+
+        for(Index iteration = 0; iteration < warm_up_iterations_number + iterations_number; iteration++)
+        {
+            const bool measure = iteration >= warm_up_iterations_number;
+
+            batch_samples_indices = training_batches.chip(iteration%batches_number, 0);
+
+            if(measure) fill_counter.start();
+
+            batch.fill(batch_samples_indices, input_variables_indices, target_variables_indices);
+
+            if(measure) fill_counter.stop();
+
+            if(measure) forward_counter.start();
+
+            neural_network.forward_propagate(batch, forward_propagation, is_training);
+
+            if(measure) forward_counter.stop();
+
+            if(measure) backward_counter.start();
+
+            mean_squared_error.back_propagate(batch, forward_propagation, back_propagation);
+
+            if(measure) backward_counter.stop();
+
+            if(measure) update_counter.start();
+
+            adaptive_moment_estimation.update_parameters(back_propagation, optimization_data);
+
+            if(measure) update_counter.stop();
+        }
+
+        cout << "Iterations: " << iterations_number << endl;
+
+        fill_counter.print("Batch fill", iterations_number);
+        forward_counter.print("Forward propagation", iterations_number);
+        backward_counter.print("Back propagation", iterations_number);
+        update_counter.print("Parameters update", iterations_number);
+
+        cout << "Total: "
+             << static_cast<double>(fill_counter.allocations + forward_counter.allocations + backward_counter.allocations + update_counter.allocations)
+                /static_cast<double>(iterations_number)
+             << " allocations/iteration" << endl;
+
+        cout << "Loss: " << back_propagation.loss << endl;
+
+        // Deployment
+
+        NeuralNetworkForwardPropagation deployment_forward_propagation(batch_samples_number, &neural_network);
+
+        PhaseCounter deployment_counter;
+
+        for(Index iteration = 0; iteration < warm_up_iterations_number + iterations_number; iteration++)
+        {
+            const bool measure = iteration >= warm_up_iterations_number;
+
+            if(measure) deployment_counter.start();
+
+            neural_network.forward_propagate_deploy(batch, deployment_forward_propagation);
+
+            if(measure) deployment_counter.stop();
+        }
+
+        deployment_counter.print("Deployment forward propagation", iterations_number);
+
+        cout << "Outputs memory without planning: "
+             << forward_propagation.memory_planner.get_buffers_size()*Index(sizeof(type)) << " bytes" << endl;
+
+        cout << "Outputs memory for training: "
+             << forward_propagation.memory_planner.get_arena_size()*Index(sizeof(type)) << " bytes" << endl;
+
+        cout << "Outputs memory for deployment: "
+             << deployment_forward_propagation.memory_planner.get_arena_size()*Index(sizeof(type)) << " bytes" << endl;
+
+        cout << "Bye!" << endl;
+
+        return 0;
+    }
+    catch(const exception& e)
+    {
+        cerr << e.what() << endl;
+
+        return 1;
+    }
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) Artificial Intelligence Techniques SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -49,6 +49,14 @@ Index AdaptiveMomentEstimation::get_batch_samples_number() const
 }
 
 
+/// Returns the number of batches filled in the background while the current batch is trained.
+
+const Index& AdaptiveMomentEstimation::get_prefetched_batches_number() const
+{
+    return prefetched_batches_number;
+}
+
+
 /// Returns beta 1.
 
 const type& AdaptiveMomentEstimation::get_beta_1() const
@@ -73,6 +81,22 @@ const type& AdaptiveMomentEstimation::get_epsilon() const
 }
 
 
+/// Returns the decoupled weight decay.
+
+const type& AdaptiveMomentEstimation::get_weight_decay() const
+{
+    return weight_decay;
+}
+
+
+/// Returns the precision in which the moments are stored.
+
+const StoragePrecision& AdaptiveMomentEstimation::get_moments_precision() const
+{
+    return moments_precision;
+}
+
+
 /// Returns the initial learning rate.
 
 const type& AdaptiveMomentEstimation::get_initial_learning_rate() const
@@ -107,6 +131,27 @@ void AdaptiveMomentEstimation::set_batch_samples_number(const Index& new_batch_s
 }
 
 
+/// Sets the number of batches filled in the background while the current batch is trained. Default 2.
+/// With 0, each batch is filled after the previous one has been trained.
+/// @param new_prefetched_batches_number Number of prefetched batches.
+
+void AdaptiveMomentEstimation::set_prefetched_batches_number(const Index& new_prefetched_batches_number)
+{
+    if(new_prefetched_batches_number < 0)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: AdaptiveMomentEstimation class.\n"
+               << "void set_prefetched_batches_number(const Index&) method.\n"
+               << "Prefetched batches number (" << new_prefetched_batches_number << ") must be equal or greater than 0.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    prefetched_batches_number = new_prefetched_batches_number;
+}
+
+
 /// Sets beta 1 generally close to 1.
 /// @param new_beta_1 New value for beta 1.
 
@@ -142,6 +187,50 @@ void AdaptiveMomentEstimation::set_epsilon(const type& new_epsilon)
 }
 
 
+/// Sets the decoupled weight decay of the AdamW variant.
+/// In each iteration the parameters shrink by the initial learning rate times the weight decay,
+/// independently of the moments of the gradient. With 0 the algorithm is the original Adam.
+/// @param new_weight_decay Weight decay, equal or greater than 0.
+
+void AdaptiveMomentEstimation::set_weight_decay(const type& new_weight_decay)
+{
+    if(new_weight_decay < type(0))
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: AdaptiveMomentEstimation class.\n"
+               << "void set_weight_decay(const type&) method.\n"
+               << "Weight decay (" << new_weight_decay << ") must be equal or greater than 0.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    weight_decay = new_weight_decay;
+}
+
+
+/// Sets the precision in which the moments are stored.
+/// BFloat16 halves the memory and the bandwidth of the moments, which are updated in single precision.
+/// Half precision is not supported, because the square gradients fall below its range.
+/// @param new_moments_precision Single or BFloat16.
+
+void AdaptiveMomentEstimation::set_moments_precision(const StoragePrecision& new_moments_precision)
+{
+    if(new_moments_precision == StoragePrecision::Half)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: AdaptiveMomentEstimation class.\n"
+               << "void set_moments_precision(const StoragePrecision&) method.\n"
+               << "Moments cannot be stored in half precision.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    moments_precision = new_moments_precision;
+}
+
+
 /// Sets a new learning rate.
 /// @param new_learning_rate New learning rate.
 
@@ -248,8 +337,15 @@ TrainingResults AdaptiveMomentEstimation::perform_training()
     const Tensor<Index, 1> input_variables_indices = data_set_pointer->get_input_variables_indices();
     const Tensor<Index, 1> target_variables_indices = data_set_pointer->get_target_variables_indices();
 
-    const Tensor<Index, 1> training_samples_indices = data_set_pointer->get_training_samples_indices();
-    const Tensor<Index, 1> selection_samples_indices = data_set_pointer->get_selection_samples_indices();
+    // In data parallel training each process trains on its own shard of the samples
+
+    const Tensor<Index, 1> training_samples_indices = communicator_pointer
+            ? communicator_pointer->get_shard(data_set_pointer->get_training_samples_indices())
+            : data_set_pointer->get_training_samples_indices();
+
+    const Tensor<Index, 1> selection_samples_indices = communicator_pointer
+            ? communicator_pointer->get_shard(data_set_pointer->get_selection_samples_indices())
+            : data_set_pointer->get_selection_samples_indices();
 
     const Tensor<string, 1> inputs_names = data_set_pointer->get_input_variables_names();
 
@@ -265,25 +361,25 @@ TrainingResults AdaptiveMomentEstimation::perform_training()
     Index batch_samples_number_training = 0;
     Index batch_samples_number_selection = 0;
 
-    const Index training_samples_number = data_set_pointer->get_training_samples_number();
-    const Index selection_samples_number = data_set_pointer->get_selection_samples_number();
+    const Index training_samples_number = training_samples_indices.size();
+    const Index selection_samples_number = selection_samples_indices.size();
 
-    training_samples_number < batch_samples_number
-            ? batch_samples_number_training = training_samples_number
-            : batch_samples_number_training = batch_samples_number;
+    // The batches of all the processes together have the batch samples number
 
-    selection_samples_number < batch_samples_number && selection_samples_number != 0
-            ? batch_samples_number_selection = selection_samples_number
-            : batch_samples_number_selection = batch_samples_number;
+    const Index ranks_number = communicator_pointer ? communicator_pointer->get_ranks_number() : 1;
+
+    const Index rank_batch_samples_number = max(Index(1), batch_samples_number/ranks_number);
 
-    DataSetBatch batch_training(batch_samples_number_training, data_set_pointer);
-    DataSetBatch batch_selection(batch_samples_number_selection, data_set_pointer);
+    training_samples_number < rank_batch_samples_number
+            ? batch_samples_number_training = training_samples_number
+            : batch_samples_number_training = rank_batch_samples_number;
 
-    const Index training_batches_number = training_samples_number/batch_samples_number_training;
-    const Index selection_batches_number = selection_samples_number/batch_samples_number_selection;
+    selection_samples_number < rank_batch_samples_number && selection_samples_number != 0
+            ? batch_samples_number_selection = selection_samples_number
+            : batch_samples_number_selection = rank_batch_samples_number;
 
-    Tensor<Index, 2> training_batches(training_batches_number, batch_samples_number_training);
-    Tensor<Index, 2> selection_batches(selection_batches_number, batch_samples_number_selection);
+    BatchLoader training_batch_loader(data_set_pointer, batch_samples_number_training, prefetched_batches_number + 1);
+    BatchLoader selection_batch_loader(data_set_pointer, batch_samples_number_selection, prefetched_batches_number + 1);
 
     // Neural network
 
@@ -292,6 +388,8 @@ TrainingResults AdaptiveMomentEstimation::perform_training()
     neural_network_pointer->set_inputs_names(inputs_names);
     neural_network_pointer->set_outputs_names(targets_names);
 
+    neural_network_pointer->set_inputs_categories_numbers(data_set_pointer->get_input_categories_numbers());
+
     if(neural_network_pointer->has_scaling_layer())
     {
         ScalingLayer* scaling_layer_pointer = neural_network_pointer->get_scaling_layer_pointer();
@@ -306,6 +404,8 @@ TrainingResults AdaptiveMomentEstimation::perform_training()
         unscaling_layer_pointer->set(target_variables_descriptives, target_variables_scalers);
     }
 
+    data_set_pointer->update_training_cache();
+
     NeuralNetworkForwardPropagation training_forward_propagation(batch_samples_number_training, neural_network_pointer);
 
     NeuralNetworkForwardPropagation selection_forward_propagation(batch_samples_number_selection, neural_network_pointer);
@@ -314,6 +414,17 @@ TrainingResults AdaptiveMomentEstimation::perform_training()
 
     loss_index_pointer->set_normalization_coefficient();
 
+    // All the processes start from the parameters of the first one
+
+    if(communicator_pointer)
+    {
+        Tensor<type, 1> parameters = neural_network_pointer->get_parameters();
+
+        communicator_pointer->broadcast(parameters);
+
+        neural_network_pointer->set_parameters(parameters);
+    }
+
     LossIndexBackPropagation training_back_propagation(batch_samples_number_training, loss_index_pointer);
     LossIndexBackPropagation selection_back_propagation(batch_samples_number_selection, loss_index_pointer);
 
@@ -349,8 +460,14 @@ TrainingResults AdaptiveMomentEstimation::perform_training()
     {
         if(display && epoch%display_period == 0) cout << "Epoch: " << epoch << endl;
 
-        training_batches = data_set_pointer->get_batches(training_samples_indices, batch_samples_number_training, shuffle);
-        const Index batches_number = training_batches.dimension(0);
+        training_batch_loader.start(training_samples_indices, input_variables_indices, target_variables_indices, shuffle);
+
+        const Index batches_number = training_batch_loader.get_batches_number();
+
+        // Selection batches are filled while the training batches are trained
+
+        if(has_selection)
+            selection_batch_loader.start(selection_samples_indices, input_variables_indices, target_variables_indices, shuffle);
 
         training_loss = type(0);
         training_error = type(0);
@@ -363,7 +480,7 @@ TrainingResults AdaptiveMomentEstimation::perform_training()
 
             // Data set
 
-            batch_training.fill(training_batches.chip(iteration, 0), input_variables_indices, target_variables_indices);
+            const DataSetBatch& batch_training = training_batch_loader.next_batch();
 
             // Neural network
 
@@ -373,6 +490,13 @@ TrainingResults AdaptiveMomentEstimation::perform_training()
 
             loss_index_pointer->back_propagate(batch_training, training_forward_propagation, training_back_propagation); // !!!
 
+            if(communicator_pointer)
+            {
+                communicator_pointer->all_reduce_mean(training_back_propagation.gradient);
+
+                training_back_propagation.set_gradient_modified();
+            }
+
             results.training_error_history(epoch) = training_back_propagation.error;
 
             training_error += training_back_propagation.error;
@@ -392,7 +516,7 @@ TrainingResults AdaptiveMomentEstimation::perform_training()
 
         if(has_selection)
         {
-            selection_batches = data_set_pointer->get_batches(selection_samples_indices, batch_samples_number_selection, shuffle);
+            const Index selection_batches_number = selection_batch_loader.get_batches_number();
 
             selection_error = type(0);
 
@@ -400,7 +524,7 @@ TrainingResults AdaptiveMomentEstimation::perform_training()
             {
                 // Data set
 
-                batch_selection.fill(selection_batches.chip(iteration,0), input_variables_indices, target_variables_indices);
+                const DataSetBatch& batch_selection = selection_batch_loader.next_batch();
 
                 // Neural network
 
@@ -420,7 +544,7 @@ TrainingResults AdaptiveMomentEstimation::perform_training()
 
             results.selection_error_history(epoch) = selection_error;
 
-            if(epoch != 0 && results.selection_error_history(epoch) > results.selection_error_history(epoch-1)) selection_failures++;
+            if(!communicator_pointer && epoch != 0 && results.selection_error_history(epoch) > results.selection_error_history(epoch-1)) selection_failures++;
 
         }
 
@@ -429,6 +553,31 @@ TrainingResults AdaptiveMomentEstimation::perform_training()
         time(&current_time);
         elapsed_time = static_cast<type>(difftime(current_time, beginning_time));
 
+        // The processes take the same stopping decisions from the means of their errors and times
+
+        if(communicator_pointer)
+        {
+            Tensor<type, 1> epoch_values(4);
+
+            epoch_values.setValues({training_error, training_loss, selection_error, elapsed_time});
+
+            communicator_pointer->all_reduce_mean(epoch_values);
+
+            training_error = epoch_values(0);
+            training_loss = epoch_values(1);
+            selection_error = epoch_values(2);
+            elapsed_time = epoch_values(3);
+
+            results.training_error_history(epoch) = training_error;
+
+            if(has_selection)
+            {
+                results.selection_error_history(epoch) = selection_error;
+
+                if(epoch != 0 && selection_error > results.selection_error_history(epoch-1)) selection_failures++;
+            }
+        }
+
         if(display && epoch%display_period == 0)
         {
             cout << "Training error: " << training_error << endl;
@@ -487,10 +636,14 @@ TrainingResults AdaptiveMomentEstimation::perform_training()
 
             results.elapsed_time = write_time(elapsed_time);
 
+            results.data_waiting_time = training_batch_loader.get_waiting_time() + selection_batch_loader.get_waiting_time();
+
             break;
         }
 
-        if(epoch != 0 && epoch % save_period == 0) neural_network_pointer->save(neural_network_file_name);
+        const bool is_first_rank = !communicator_pointer || communicator_pointer->get_rank() == 0;
+
+        if(is_first_rank && epoch != 0 && epoch % save_period == 0) neural_network_pointer->save(neural_network_file_name);
     }
 
     if(neural_network_pointer->get_project_type() == NeuralNetwork::ProjectType::AutoAssociation)
@@ -594,43 +747,164 @@ Tensor<string, 2> AdaptiveMomentEstimation::to_string_matrix() const
 void AdaptiveMomentEstimation::update_parameters(LossIndexBackPropagation& back_propagation,
     AdaptiveMomentEstimationData& optimization_data) const
 {
-    const type learning_rate =
+    AdamStep step;
+
+    step.learning_rate =
         type(initial_learning_rate *
             sqrt(type(1) - pow(beta_2, static_cast<type>(optimization_data.iteration))) /
             (type(1) - pow(beta_1, static_cast<type>(optimization_data.iteration))));
 
-#ifdef OPENNN_MKL
+    step.beta_1 = beta_1;
+    step.beta_2 = beta_2;
+    step.epsilon = epsilon;
+    step.weight_decay_rate = initial_learning_rate*weight_decay;
+
+    const Index parameters_number = back_propagation.parameters.size();
+
+    // The lazy update leaves the rows of the lookup tables outside the batch as they are,
+    // so it does not apply when something else changes them: weight decay, the regularization gradient,
+    // or the averaged gradient of a data parallel training, which are dense
+
+    const bool is_lazy = !communicator_pointer
+                      && weight_decay == type(0)
+                      && back_propagation.loss_index_pointer->get_regularization_method() == LossIndex::RegularizationMethod::NoRegularization
+                      && back_propagation.loss_index_pointer->get_neural_network_pointer()->has_embedding_layer();
+
+    if(is_lazy)
+    {
+        update_parameters_lazily(back_propagation, optimization_data, step);
+    }
+    else if(moments_precision == StoragePrecision::BFloat16)
+    {
+        update_parameters_adam(thread_pool_device,
+                               step,
+                               parameters_number,
+                               back_propagation.gradient.data(),
+                               back_propagation.parameters.data(),
+                               optimization_data.bfloat16_gradient_exponential_decay.data(),
+                               optimization_data.bfloat16_square_gradient_exponential_decay.data());
+    }
+    else
+    {
+        update_parameters_adam(thread_pool_device,
+                               step,
+                               parameters_number,
+                               back_propagation.gradient.data(),
+                               back_propagation.parameters.data(),
+                               optimization_data.gradient_exponential_decay.data(),
+                               optimization_data.square_gradient_exponential_decay.data());
+    }
+
+    optimization_data.iteration++;
 
-    int parameters_number = back_propagation.gradient.size();
+    // Update parameters
+    // The parameters were updated in place in the parameters arena, so this only copies if the neural network has none
 
-    int incx = 1;
-    int incy = 1;
+    back_propagation.loss_index_pointer->get_neural_network_pointer()->set_parameters(back_propagation.parameters);
+}
 
-    type a = (type(1) - beta_1);
-    type b = beta_1;
 
-    saxpby(&parameters_number, &a, back_propagation.gradient.data(), &incx, &b, optimization_data.gradient_exponential_decay.data(), &incy);
+/// Updates the parameters layer by layer, applying the update of the lookup tables of embedding layers only to the rows in the batch.
+/// The moments of the other rows are not decayed, as if those rows were not part of the model in this iteration.
+/// This makes the cost of an iteration independent of the vocabulary size for the lookup tables.
+/// It is only valid without weight decay nor regularization, which change all the rows.
+/// A lookup table whose gradient has been written outside the layer, as flagged by set_gradient_modified(), is updated as usual,
+/// as are the other layers.
+/// @param back_propagation Back-propagation with the gradient and the rows of each embedding layer which have derivatives.
+/// @param optimization_data Moments of the gradient.
+/// @param step Hyperparameters of this iteration, with the bias corrections in the learning rate.
 
-#else
+void AdaptiveMomentEstimation::update_parameters_lazily(LossIndexBackPropagation& back_propagation,
+                                                       AdaptiveMomentEstimationData& optimization_data,
+                                                       const AdamStep& step) const
+{
+    const NeuralNetwork* neural_network_pointer = back_propagation.loss_index_pointer->get_neural_network_pointer();
 
-    optimization_data.gradient_exponential_decay.device(*thread_pool_device)
-        = back_propagation.gradient * (type(1) - beta_1)
-        + optimization_data.gradient_exponential_decay * beta_1;
+    const Tensor<Layer*, 1> trainable_layers_pointers = neural_network_pointer->get_trainable_layers_pointers();
 
-#endif
+    const Tensor<Index, 1> trainable_layers_parameters_numbers = neural_network_pointer->get_trainable_layers_parameters_numbers();
 
-    optimization_data.square_gradient_exponential_decay.device(*thread_pool_device)
-        = back_propagation.gradient * back_propagation.gradient * (type(1) - beta_2)
-        + optimization_data.square_gradient_exponential_decay * beta_2;
+    const bool use_bfloat16_moments = moments_precision == StoragePrecision::BFloat16;
 
-    back_propagation.parameters.device(*thread_pool_device)
-        -= learning_rate * optimization_data.gradient_exponential_decay / (optimization_data.square_gradient_exponential_decay.sqrt() + epsilon);
-        
-    optimization_data.iteration++;
+    type* gradient_data = back_propagation.gradient.data();
+    type* parameters_data = back_propagation.parameters.data();
+    type* gradient_exponential_decay_data = optimization_data.gradient_exponential_decay.data();
+    type* square_gradient_exponential_decay_data = optimization_data.square_gradient_exponential_decay.data();
+    Eigen::bfloat16* bfloat16_gradient_exponential_decay_data = optimization_data.bfloat16_gradient_exponential_decay.data();
+    Eigen::bfloat16* bfloat16_square_gradient_exponential_decay_data = optimization_data.bfloat16_square_gradient_exponential_decay.data();
 
-    // Update parameters
+    Index index = 0;
 
-    back_propagation.loss_index_pointer->get_neural_network_pointer()->set_parameters(back_propagation.parameters);
+    for(Index i = 0; i < trainable_layers_pointers.size(); i++)
+    {
+        const Index layer_parameters_number = trainable_layers_parameters_numbers(i);
+
+        const EmbeddingLayerBackPropagation* embedding_layer_back_propagation
+                = trainable_layers_pointers(i)->get_type() == Layer::Type::Embedding
+                ? static_cast<EmbeddingLayerBackPropagation*>(back_propagation.neural_network.layers(i))
+                : nullptr;
+
+        if(embedding_layer_back_propagation && embedding_layer_back_propagation->has_sparse_derivatives)
+        {
+            const EmbeddingLayer* embedding_layer_pointer = static_cast<EmbeddingLayer*>(trainable_layers_pointers(i));
+
+            const Index depth = embedding_layer_pointer->get_depth();
+
+            const Index rows_number = embedding_layer_back_propagation->rows_number;
+            const Index* rows_indices_data = embedding_layer_back_propagation->rows_indices.data();
+
+            // The rows of the lookup table are contiguous
+
+            #pragma omp parallel for
+            for(Index k = 0; k < rows_number; k++)
+            {
+                for(Index j = 0; j < depth; j++)
+                {
+                    const Index parameter_index = index + rows_indices_data[k]*depth + j;
+
+                    if(use_bfloat16_moments)
+                    {
+                        type first_moment = type(bfloat16_gradient_exponential_decay_data[parameter_index]);
+                        type second_moment = type(bfloat16_square_gradient_exponential_decay_data[parameter_index]);
+
+                        step.update(gradient_data[parameter_index], parameters_data[parameter_index], first_moment, second_moment);
+
+                        bfloat16_gradient_exponential_decay_data[parameter_index] = Eigen::bfloat16(first_moment);
+                        bfloat16_square_gradient_exponential_decay_data[parameter_index] = Eigen::bfloat16(second_moment);
+                    }
+                    else
+                    {
+                        step.update(gradient_data[parameter_index],
+                                    parameters_data[parameter_index],
+                                    gradient_exponential_decay_data[parameter_index],
+                                    square_gradient_exponential_decay_data[parameter_index]);
+                    }
+                }
+            }
+        }
+        else if(use_bfloat16_moments)
+        {
+            update_parameters_adam(thread_pool_device,
+                                   step,
+                                   layer_parameters_number,
+                                   gradient_data + index,
+                                   parameters_data + index,
+                                   bfloat16_gradient_exponential_decay_data + index,
+                                   bfloat16_square_gradient_exponential_decay_data + index);
+        }
+        else
+        {
+            update_parameters_adam(thread_pool_device,
+                                   step,
+                                   layer_parameters_number,
+                                   gradient_data + index,
+                                   parameters_data + index,
+                                   gradient_exponential_decay_data + index,
+                                   square_gradient_exponential_decay_data + index);
+        }
+
+        index += layer_parameters_number;
+    }
 }
 
 
@@ -663,6 +937,17 @@ void AdaptiveMomentEstimation::write_XML(tinyxml2::XMLPrinter& file_stream) cons
 
     file_stream.CloseElement();
 
+    // Prefetched batches number
+
+    file_stream.OpenElement("PrefetchedBatchesNumber");
+
+    buffer.str("");
+    buffer << prefetched_batches_number;
+
+    file_stream.PushText(buffer.str().c_str());
+
+    file_stream.CloseElement();
+
     // Loss goal
 
     file_stream.OpenElement("LossGoal");
@@ -696,6 +981,25 @@ void AdaptiveMomentEstimation::write_XML(tinyxml2::XMLPrinter& file_stream) cons
 
     file_stream.CloseElement();
 
+    // Weight decay
+
+    file_stream.OpenElement("WeightDecay");
+
+    buffer.str("");
+    buffer << weight_decay;
+
+    file_stream.PushText(buffer.str().c_str());
+
+    file_stream.CloseElement();
+
+    // Moments precision
+
+    file_stream.OpenElement("MomentsPrecision");
+
+    file_stream.PushText(write_storage_precision(moments_precision).c_str());
+
+    file_stream.CloseElement();
+
     // Hardware use
 
     file_stream.OpenElement("HardwareUse");
@@ -750,6 +1054,24 @@ void AdaptiveMomentEstimation::from_XML(const tinyxml2::XMLDocument& document)
         }
     }
 
+    // Prefetched batches number
+
+    const tinyxml2::XMLElement* prefetched_batches_number_element = root_element->FirstChildElement("PrefetchedBatchesNumber");
+
+    if(prefetched_batches_number_element)
+    {
+        const Index new_prefetched_batches_number = static_cast<Index>(atoi(prefetched_batches_number_element->GetText()));
+
+        try
+        {
+            set_prefetched_batches_number(new_prefetched_batches_number);
+        }
+        catch(const invalid_argument& e)
+        {
+            cerr << e.what() << endl;
+        }
+    }
+
     // Loss goal
     {
         const tinyxml2::XMLElement* element = root_element->FirstChildElement("LossGoal");
@@ -807,6 +1129,42 @@ void AdaptiveMomentEstimation::from_XML(const tinyxml2::XMLDocument& document)
         }
     }
 
+    // Weight decay
+    {
+        const tinyxml2::XMLElement* element = root_element->FirstChildElement("WeightDecay");
+
+        if(element)
+        {
+            const type new_weight_decay = static_cast<type>(atof(element->GetText()));
+
+            try
+            {
+                set_weight_decay(new_weight_decay);
+            }
+            catch(const invalid_argument& e)
+            {
+                cerr << e.what() << endl;
+            }
+        }
+    }
+
+    // Moments precision
+    {
+        const tinyxml2::XMLElement* element = root_element->FirstChildElement("MomentsPrecision");
+
+        if(element)
+        {
+            try
+            {
+                set_moments_precision(read_storage_precision(element->GetText()));
+            }
+            catch(const invalid_argument& e)
+            {
+                cerr << e.what() << endl;
+            }
+        }
+    }
+
     // Hardware use
     {
         const tinyxml2::XMLElement* element = root_element->FirstChildElement("HardwareUse");
@@ -858,13 +1216,22 @@ void AdaptiveMomentEstimationData::set(AdaptiveMomentEstimation* new_adaptive_mo
 
     const Index parameters_number = neural_network_pointer->get_parameters_number();
 
-    gradient_exponential_decay.resize(parameters_number);
+    // The moments are only allocated in the precision in which they are stored
+
+    const Index single_parameters_number
+            = new_adaptive_moment_estimation_pointer->get_moments_precision() == StoragePrecision::BFloat16 ? 0 : parameters_number;
+
+    gradient_exponential_decay.resize(single_parameters_number);
     gradient_exponential_decay.setZero();
 
-    square_gradient_exponential_decay.resize(parameters_number);
+    square_gradient_exponential_decay.resize(single_parameters_number);
     square_gradient_exponential_decay.setZero();
 
-    square_gradient_exponential_decay.setZero();
+    bfloat16_gradient_exponential_decay.resize(parameters_number - single_parameters_number);
+    bfloat16_gradient_exponential_decay.setZero();
+
+    bfloat16_square_gradient_exponential_decay.resize(parameters_number - single_parameters_number);
+    bfloat16_square_gradient_exponential_decay.setZero();
 }
 
 
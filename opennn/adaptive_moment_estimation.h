@@ -31,6 +31,9 @@
 
 #include "loss_index.h"
 #include "optimization_algorithm.h"
+#include "batch_loader.h"
+#include "storage_precision.h"
+#include "optimizer_kernels.h"
 #include "config.h"
 
 namespace opennn
@@ -48,6 +51,8 @@ struct AdaptiveMomentEstimationData;
 /// \ref https://www.opennn.net/files/high_performance_optimization_algorithms_for_neural_networks.pdf .
 ///
 /// \cite 2 D. P. Kingma and J. L. Ba, "Adam: A Method for Stochastic Optimization." arXiv preprint arXiv:1412.6980v8 (2014).
+///
+/// \cite 3 I. Loshchilov and F. Hutter, "Decoupled Weight Decay Regularization." arXiv preprint arXiv:1711.05101 (2019).
 
 class AdaptiveMomentEstimation : public OptimizationAlgorithm
 {
@@ -68,6 +73,8 @@ public:
    const type& get_beta_1() const;
    const type& get_beta_2() const;
    const type& get_epsilon() const;
+   const type& get_weight_decay() const;
+   const StoragePrecision& get_moments_precision() const;
 
    // Stopping criteria
 
@@ -80,18 +87,24 @@ public:
 
    void set_batch_samples_number(const Index& new_batch_samples_number);
 
+   void set_prefetched_batches_number(const Index&);
+
    void set_default() final;
 
    // Get methods
 
    Index get_batch_samples_number() const;
 
+   const Index& get_prefetched_batches_number() const;
+
    // Training operators
 
    void set_initial_learning_rate(const type&);
    void set_beta_1(const type&);
    void set_beta_2(const type&);
    void set_epsilon(const type&);
+   void set_weight_decay(const type&);
+   void set_moments_precision(const StoragePrecision&);
 
    // Training parameters
 
@@ -120,6 +133,8 @@ public:
 
    void update_parameters(LossIndexBackPropagation&, AdaptiveMomentEstimationData&) const;
 
+   void update_parameters_lazily(LossIndexBackPropagation&, AdaptiveMomentEstimationData&, const AdamStep&) const;
+
 private:
 
    // TRAINING OPERATORS
@@ -144,6 +159,14 @@ private:
 
    type epsilon =static_cast<type>(1.e-7);
 
+   /// Decoupled weight decay, which shrinks the parameters independently of the moments (AdamW).
+
+   type weight_decay = type(0);
+
+   /// Precision in which the moments are stored.
+
+   StoragePrecision moments_precision = StoragePrecision::Single;
+
     // Stopping criteria
 
    /// Goal value for the loss. It a stopping criterion.
@@ -166,6 +189,10 @@ private:
 
    Index batch_samples_number = 1000;
 
+   /// Number of batches filled in the background while the current batch is trained.
+
+   Index prefetched_batches_number = 2;
+
 
 #ifdef OPENNN_CUDA
     #include "../../opennn-cuda/opennn-cuda/adaptive_moment_estimation_cuda.h"
@@ -191,6 +218,9 @@ struct AdaptiveMomentEstimationData : public OptimizationAlgorithmData
     Tensor<type, 1> gradient_exponential_decay;
     Tensor<type, 1> square_gradient_exponential_decay;
 
+    Tensor<Eigen::bfloat16, 1> bfloat16_gradient_exponential_decay;
+    Tensor<Eigen::bfloat16, 1> bfloat16_square_gradient_exponential_decay;
+
     Index iteration = 0;
 
     Index learning_rate_iteration = 0;
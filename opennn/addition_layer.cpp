@@ -25,7 +25,7 @@ AdditionLayer::AdditionLayer() : Layer()
 
 AdditionLayer::AdditionLayer(const Tensor<Index, 1>& new_input_variables_dimensions) : Layer()
 {
-    set_default();
+    set(new_input_variables_dimensions);
 }
 
 
@@ -48,7 +48,11 @@ AdditionLayer::AdditionLayer(const Tensor<Index, 1>& new_input_variables_dimensi
 
 Index AdditionLayer::get_neurons_number() const
 {
-    return get_outputs_rows_number() * get_outputs_columns_number();
+    Index neurons_number = 1;
+
+    for(Index i = 0; i < inputs_dimensions.size(); i++) neurons_number *= inputs_dimensions(i);
+
+    return neurons_number;
 }
 
 
@@ -56,13 +60,7 @@ Index AdditionLayer::get_neurons_number() const
 
 Tensor<Index, 1> AdditionLayer::get_outputs_dimensions() const
 {
-    Tensor<Index, 1> outputs_dimensions(3);
-
-    outputs_dimensions[0] = get_outputs_rows_number();
-    outputs_dimensions[1] = get_outputs_columns_number();
-    outputs_dimensions[2] = inputs_dimensions[2];
-
-    return outputs_dimensions;
+    return inputs_dimensions;
 }
 
 
@@ -103,7 +101,7 @@ Index AdditionLayer::get_channels_number() const
 
 Index AdditionLayer::get_outputs_rows_number() const
 {
-    return 0;
+    return get_inputs_rows_number();
 }
 
 
@@ -111,7 +109,7 @@ Index AdditionLayer::get_outputs_rows_number() const
 
 Index AdditionLayer::get_outputs_columns_number() const
 {
-    return 0;
+    return get_inputs_columns_number();
 }
 
 
@@ -139,6 +137,17 @@ Tensor<Index, 1> AdditionLayer::get_inputs_dimensions() const
 }
 
 
+/// Sets the dimensions of each of the inputs, which are also the dimensions of the outputs.
+/// @param new_inputs_dimensions Dimensions of an input, without the batch samples.
+
+void AdditionLayer::set(const Tensor<Index, 1>& new_inputs_dimensions)
+{
+    inputs_dimensions = new_inputs_dimensions;
+
+    set_default();
+}
+
+
 void AdditionLayer::set(const Tensor<Index, 1>& new_input_variables_dimensions, const Tensor<Index, 1>& new_pool_dimensions)
 {
     inputs_dimensions = new_input_variables_dimensions;
@@ -160,49 +169,121 @@ void AdditionLayer::set_inputs_dimensions(const Tensor<Index, 1>& new_inputs_dim
 }
 
 
-/// Sets the layer type to Layer::Pooling.
+/// Sets the layer type to Layer::Addition.
 
 void AdditionLayer::set_default()
 {
-    layer_type = Layer::Type::Pooling;
+    layer_type = Layer::Type::Addition;
 }
 
 
-void AdditionLayer::forward_propagate(const Tensor<DynamicTensor<type>, 1>&,
+void AdditionLayer::forward_propagate(const Tensor<DynamicTensor<type>, 1>& inputs,
                                      LayerForwardPropagation* layer_forward_propagation,
                                      const bool& is_training)
 {
-    if(layer_forward_propagation == nullptr) cout << "NULL" << endl;
+    const Index inputs_number = inputs.size();
+
+    DynamicTensor<type>& outputs = layer_forward_propagation->outputs(0);
+
+    const Index outputs_size = outputs.size();
+
+    for(Index i = 0; i < inputs_number; i++)
+    {
+        if(inputs(i).size() != outputs_size)
+        {
+            ostringstream buffer;
+
+            buffer << "OpenNN Exception: AdditionLayer class.\n"
+                   << "void forward_propagate(const Tensor<DynamicTensor<type>, 1>&, LayerForwardPropagation*, const bool&) method.\n"
+                   << "Size of input " << i << " (" << inputs(i).size() << ") must be equal to size of outputs (" << outputs_size << ").\n";
+
+            throw invalid_argument(buffer.str());
+        }
+    }
+
+    TensorMap<Tensor<type, 1>> outputs_map(outputs.get_data(), outputs_size);
+
+    if(inputs_number == 0)
+    {
+        outputs_map.setZero();
+
+        return;
+    }
 
+    const TensorMap<Tensor<type, 1>> first_inputs(inputs(0).get_data(), outputs_size);
+
+    if(inputs_number == 1)
+    {
+        outputs_map.device(*thread_pool_device) = first_inputs;
+
+        return;
+    }
+
+    const TensorMap<Tensor<type, 1>> second_inputs(inputs(1).get_data(), outputs_size);
+
+    outputs_map.device(*thread_pool_device) = first_inputs + second_inputs;
+
+    for(Index i = 2; i < inputs_number; i++)
+    {
+        const TensorMap<Tensor<type, 1>> other_inputs(inputs(i).get_data(), outputs_size);
+
+        outputs_map.device(*thread_pool_device) += other_inputs;
+    }
 }
 
 
+/// Calculates the derivatives of the error with respect to the outputs of this layer, from the next layer.
+/// The next layer can be a perceptron layer or another addition layer.
+
 void AdditionLayer::calculate_hidden_delta(LayerForwardPropagation* next_layer_forward_propagation,
-                                          LayerBackPropagation* next_layer_back_propagation,
-                                          LayerBackPropagation* this_layeer_back_propagation) const
+                                           LayerBackPropagation* next_layer_back_propagation,
+                                           LayerBackPropagation* layer_back_propagation) const
 {
-    /// @todo put switch
-    /*
-    if(pooling_method == PoolingMethod::NoPooling) return next_layer_delta;
+    const Index batch_samples_number = layer_back_propagation->batch_samples_number;
+    const Index neurons_number = get_neurons_number();
+
+    TensorMap<Tensor<type, 2>> deltas(layer_back_propagation->deltas_data, batch_samples_number, neurons_number);
 
-    else
+    switch(next_layer_back_propagation->layer_pointer->get_type())
     {
-        const Type layer_type = next_layer_pointer->get_type();
+    case Type::Perceptron:
+    {
+        const PerceptronLayerForwardPropagation* next_perceptron_layer_forward_propagation =
+                static_cast<PerceptronLayerForwardPropagation*>(next_layer_forward_propagation);
 
-        if(layer_type == Type::Convolutional)
-        {
-            ConvolutionalLayer* convolutional_layer = dynamic_cast<ConvolutionalLayer*>(next_layer_pointer);
+        const PerceptronLayer* next_perceptron_layer_pointer =
+                static_cast<PerceptronLayer*>(next_layer_back_propagation->layer_pointer);
 
-            return calculate_hidden_delta_convolutional(convolutional_layer, activations, activations_derivatives, next_layer_delta);
-        }
-        else if(layer_type == Type::Pooling)
-        {
-            AdditionLayer* pooling_layer = dynamic_cast<AdditionLayer*>(next_layer_pointer);
+        const TensorMap<Tensor<type, 2>>& next_synaptic_weights = next_perceptron_layer_pointer->get_synaptic_weights();
 
-            return calculate_hidden_delta_pooling(pooling_layer, activations, activations_derivatives, next_layer_delta);
-        }
+        const TensorMap<Tensor<type, 2>> next_deltas(next_layer_back_propagation->deltas_data,
+                                                     next_layer_back_propagation->deltas_dimensions(0),
+                                                     next_layer_back_propagation->deltas_dimensions(1));
+
+        deltas.device(*thread_pool_device) =
+                (next_deltas*next_perceptron_layer_forward_propagation->activations_derivatives).contract(next_synaptic_weights, A_BT);
+    }
+        break;
+
+    case Type::Addition:
+    {
+        const TensorMap<Tensor<type, 2>> next_deltas(next_layer_back_propagation->deltas_data, batch_samples_number, neurons_number);
+
+        deltas.device(*thread_pool_device) = next_deltas;
+    }
+        break;
+
+    default:
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: AdditionLayer class.\n"
+               << "void calculate_hidden_delta(LayerForwardPropagation*, LayerBackPropagation*, LayerBackPropagation*) const method.\n"
+               << "Next layer type (" << next_layer_back_propagation->layer_pointer->get_type_string() << ") is not supported.\n";
+
+        throw invalid_argument(buffer.str());
+    }
     }
-    */
 }
 
 
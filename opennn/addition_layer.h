@@ -25,6 +25,7 @@
 #include "convolutional_layer.h"
 #include "layer.h"
 #include "flatten_layer.h"
+#include "perceptron_layer.h"
 
 #include "statistics.h"
 
@@ -37,6 +38,11 @@ struct AdditionLayerBackPropagation;
 /// This class represents the Pooling Layer in Convolutional Neural Network(CNN).
 /// Pooling: is the procross_entropy_errors of merging, ie, reducing the size of the data and remove some noise by different processes.
 
+/// This layer adds its inputs element by element.
+
+/// It merges the branches of a network, such as the shortcut connections of residual networks.
+/// All the inputs have the dimensions of the layer, and so do the outputs.
+
 class AdditionLayer : public Layer
 {
 
@@ -75,6 +81,8 @@ public:
 
     // Set methods
 
+    void set(const Tensor<Index, 1>&);
+
     void set(const Tensor<Index, 1>&, const Tensor<Index, 1>&);
 
     void set_inputs_number(const Index&) {}
@@ -97,7 +105,7 @@ public:
 
     void calculate_hidden_delta(LayerForwardPropagation*,
                                 LayerBackPropagation*,
-                                LayerBackPropagation*) const;
+                                LayerBackPropagation*) const final;
 
     // Serialization methods
 
@@ -132,54 +140,21 @@ struct AdditionLayerForwardPropagation : LayerForwardPropagation
         set(new_batch_samples_number, new_layer_pointer);
     }
 
-    Eigen::array<ptrdiff_t, 4> get_inputs_dimensions_array() const
-    {
-        AdditionLayer* addition_layer_pointer = static_cast<AdditionLayer*>(layer_pointer);
-
-        const Index inputs_rows_number = addition_layer_pointer->get_inputs_rows_number();
-        const Index inputs_columns_number = addition_layer_pointer->get_inputs_columns_number();
-        const Index inputs_channels_number = addition_layer_pointer->get_channels_number();
-
-        return Eigen::array<ptrdiff_t, 4>({batch_samples_number,
-                                           inputs_rows_number,
-                                           inputs_columns_number,
-                                           inputs_channels_number});
-    }
-
-    Eigen::array<ptrdiff_t, 4> get_outputs_dimensions_array() const
-    {
-        AdditionLayer* addition_layer_pointer = static_cast<AdditionLayer*>(layer_pointer);
-
-        const Index oututs_columns_number =  addition_layer_pointer->get_outputs_columns_number();
-        const Index oututs_rows_number = addition_layer_pointer->get_outputs_rows_number();
-        const Index outputs_channels_number = addition_layer_pointer->get_channels_number();
-
-        return Eigen::array<ptrdiff_t, 4>({batch_samples_number,
-                                           oututs_rows_number,
-                                           oututs_columns_number,
-                                           outputs_channels_number});
-    }
-
     void set(const Index& new_batch_samples_number, Layer* new_layer_pointer)
     {
         batch_samples_number = new_batch_samples_number;
 
         layer_pointer = new_layer_pointer;
 
-        const AdditionLayer* addition_layer_pointer = static_cast<AdditionLayer*>(layer_pointer);
+        const Tensor<Index, 1> layer_outputs_dimensions = layer_pointer->get_outputs_dimensions();
 
-        const Index outputs_rows_number = addition_layer_pointer->get_outputs_rows_number();
+        Tensor<Index, 1> output_dimensions(layer_outputs_dimensions.size() + 1);
 
-        const Index outputs_columns_number = addition_layer_pointer->get_outputs_columns_number();
+        output_dimensions(0) = batch_samples_number;
 
-        const Index channels_number = addition_layer_pointer->get_channels_number();
+        for(Index i = 0; i < layer_outputs_dimensions.size(); i++) output_dimensions(i+1) = layer_outputs_dimensions(i);
 
         outputs.resize(1);
-        Tensor<Index, 1> output_dimensions(4);
-        output_dimensions.setValues({batch_samples_number,
-                                     outputs_rows_number,
-                                     outputs_columns_number,
-                                     channels_number});
         outputs(0).set_dimensions(output_dimensions);
     }
 
@@ -190,10 +165,6 @@ struct AdditionLayerForwardPropagation : LayerForwardPropagation
 
         cout << "Outputs dimensions:" << endl;
         cout << outputs[0].get_dimensions() << endl;
-
-        cout << "Outputs:" << endl;
-
-        cout << outputs(0).to_tensor_map<4>() << endl;
      }
 };
 
@@ -222,28 +193,21 @@ struct AdditionLayerBackPropagation : LayerBackPropagation
 
         layer_pointer = new_layer_pointer;
 
+        const Index neurons_number = layer_pointer->get_neurons_number();
 
-        const AdditionLayer* pooling_layer_pointer = static_cast<AdditionLayer*>(layer_pointer);
-
-        const Index outputs_rows_number = pooling_layer_pointer->get_outputs_rows_number();
-        const Index outputs_columns_number = pooling_layer_pointer->get_outputs_columns_number();
+        deltas_dimensions.resize(2);
+        deltas_dimensions.setValues({batch_samples_number, neurons_number});
 
-        deltas_dimensions.resize(4);
-/*
-        deltas_dimensions.setValues({batch_samples_number,
-                                     kernels_number,
-                                     outputs_rows_number,
-                                     outputs_columns_number});
+        free(deltas_data);
 
-        deltas_data = (type*)malloc(static_cast<size_t>(batch_samples_number*kernels_number*outputs_rows_number*outputs_columns_number*sizeof(type)));
-*/
+        deltas_data = (type*)malloc(static_cast<size_t>(batch_samples_number*neurons_number*sizeof(type)));
     }
 
 
     void print() const
     {
         cout << "Deltas:" << endl;
-        //cout << deltas << endl;
+        cout << TensorMap<Tensor<type, 2>>(deltas_data, deltas_dimensions(0), deltas_dimensions(1)) << endl;
 
     }
 };
@@ -0,0 +1,402 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   B A T C H   L O A D E R   C L A S S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "batch_loader.h"
+
+namespace opennn
+{
+
+/// Default constructor.
+/// It creates a loader without data set and without buffers.
+
+BatchLoader::BatchLoader()
+{
+}
+
+
+/// Data set constructor.
+/// It creates the batch buffers of a loader for a data set.
+/// @param new_data_set_pointer Pointer to the data set.
+/// @param new_batch_samples_number Number of samples of each batch.
+/// @param new_buffers_number Number of batch buffers.
+/// @param new_workers_number Number of background threads.
+
+BatchLoader::BatchLoader(DataSet* new_data_set_pointer,
+                         const Index& new_batch_samples_number,
+                         const Index& new_buffers_number,
+                         const Index& new_workers_number)
+{
+    set(new_data_set_pointer, new_batch_samples_number, new_buffers_number, new_workers_number);
+}
+
+
+/// Destructor.
+/// It stops the workers.
+
+BatchLoader::~BatchLoader()
+{
+    stop();
+}
+
+
+/// Returns the pointer to the data set whose samples are loaded.
+
+DataSet* BatchLoader::get_data_set_pointer() const
+{
+    return data_set_pointer;
+}
+
+
+/// Returns the number of samples of each batch.
+
+const Index& BatchLoader::get_batch_samples_number() const
+{
+    return batch_samples_number;
+}
+
+
+/// Returns the number of batch buffers.
+
+const Index& BatchLoader::get_buffers_number() const
+{
+    return buffers_number;
+}
+
+
+/// Returns the number of background threads which fill the batches.
+
+const Index& BatchLoader::get_workers_number() const
+{
+    return workers_number;
+}
+
+
+/// Returns the number of batches of the current epoch.
+
+const Index& BatchLoader::get_batches_number() const
+{
+    return batches_number;
+}
+
+
+/// Returns the time, in seconds, during which next_batch() has waited for batches to be filled.
+
+const type& BatchLoader::get_waiting_time() const
+{
+    return waiting_time;
+}
+
+
+/// Returns the number of calls to next_batch() which have waited for their batch to be filled.
+
+const Index& BatchLoader::get_waits_number() const
+{
+    return waits_number;
+}
+
+
+/// Sets the data set and creates the batch buffers, after stopping the workers.
+/// The random number generator is seeded from rand(), so that the shuffles are fixed by srand().
+/// @param new_data_set_pointer Pointer to the data set.
+/// @param new_batch_samples_number Number of samples of each batch.
+/// @param new_buffers_number Number of batch buffers. With one buffer, the batches are not filled ahead of the trainer.
+/// @param new_workers_number Number of background threads. It is not greater than the number of buffers.
+
+void BatchLoader::set(DataSet* new_data_set_pointer,
+                      const Index& new_batch_samples_number,
+                      const Index& new_buffers_number,
+                      const Index& new_workers_number)
+{
+    if(new_batch_samples_number <= 0 || new_buffers_number <= 0 || new_workers_number <= 0)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: BatchLoader class.\n"
+               << "void set(DataSet*, const Index&, const Index&, const Index&) method.\n"
+               << "Batch samples number (" << new_batch_samples_number << "), "
+               << "buffers number (" << new_buffers_number << ") and "
+               << "workers number (" << new_workers_number << ") must be greater than 0.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    stop();
+
+    data_set_pointer = new_data_set_pointer;
+
+    batch_samples_number = new_batch_samples_number;
+    buffers_number = new_buffers_number;
+    workers_number = min(new_workers_number, new_buffers_number);
+
+    batches.resize(buffers_number);
+
+    for(Index i = 0; i < buffers_number; i++)
+    {
+        batches(i).set(batch_samples_number, data_set_pointer);
+    }
+
+    buffers_batches_indices.resize(buffers_number);
+    buffers_batches_indices.setConstant(-1);
+
+    batches_number = 0;
+
+    set_seed(unsigned(rand()));
+
+    reset_waiting_time();
+}
+
+
+/// Seeds the random number generator of the shuffles and the augmentations.
+/// @param new_seed Seed of the generator.
+
+void BatchLoader::set_seed(const unsigned& new_seed)
+{
+    random_engine.seed(new_seed);
+}
+
+
+/// Sets to zero the waiting time and the number of waits.
+
+void BatchLoader::reset_waiting_time()
+{
+    waiting_time = type(0);
+
+    waits_number = 0;
+}
+
+
+/// Starts filling the batches of an epoch in the background, after stopping the workers of the previous one.
+/// The samples are split into as many complete batches as they fill.
+/// @param new_samples_indices Indices of the samples of the epoch.
+/// @param new_input_variables_indices Indices of the input variables.
+/// @param new_target_variables_indices Indices of the target variables.
+/// @param new_shuffle True if the samples are shuffled before they are split into batches.
+
+void BatchLoader::start(const Tensor<Index, 1>& new_samples_indices,
+                        const Tensor<Index, 1>& new_input_variables_indices,
+                        const Tensor<Index, 1>& new_target_variables_indices,
+                        const bool& new_shuffle)
+{
+    if(new_samples_indices.size() < batch_samples_number)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: BatchLoader class.\n"
+               << "void start(const Tensor<Index, 1>&, const Tensor<Index, 1>&, const Tensor<Index, 1>&, const bool&) method.\n"
+               << "Number of samples (" << new_samples_indices.size() << ") must be greater than or equal to "
+               << "batch samples number (" << batch_samples_number << ").\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    stop();
+
+    samples_indices = new_samples_indices;
+    input_variables_indices = new_input_variables_indices;
+    target_variables_indices = new_target_variables_indices;
+
+    shuffle = new_shuffle;
+
+    is_split = false;
+    is_stopping = false;
+
+    batches_number = samples_indices.size()/batch_samples_number;
+
+    next_filled_batch_index = 0;
+    next_returned_batch_index = 0;
+    released_batches_number = 0;
+
+    buffers_batches_indices.setConstant(-1);
+
+    worker_exception = nullptr;
+
+    workers.reserve(size_t(workers_number));
+
+    for(Index i = 0; i < workers_number; i++)
+    {
+        workers.emplace_back(&BatchLoader::fill_batches, this);
+    }
+}
+
+
+/// Returns the next batch of the epoch, and releases the buffer of the previous one, which must not be used anymore.
+/// It waits until the batch has been filled, and rethrows the exceptions of the workers.
+
+DataSetBatch& BatchLoader::next_batch()
+{
+    unique_lock<mutex> lock(loader_mutex);
+
+    if(next_returned_batch_index >= batches_number)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: BatchLoader class.\n"
+               << "DataSetBatch& next_batch() method.\n"
+               << "All the batches (" << batches_number << ") of the epoch have been returned.\n";
+
+        throw logic_error(buffer.str());
+    }
+
+    const Index batch_index = next_returned_batch_index;
+    const Index buffer_index = batch_index%buffers_number;
+
+    // The previous batch is released
+
+    released_batches_number = batch_index;
+
+    buffer_released.notify_all();
+
+    const auto is_filled = [&]{ return buffers_batches_indices(buffer_index) == batch_index || worker_exception != nullptr; };
+
+    if(!is_filled())
+    {
+        const auto beginning_time = chrono::steady_clock::now();
+
+        batch_filled.wait(lock, is_filled);
+
+        waiting_time += type(chrono::duration<double>(chrono::steady_clock::now() - beginning_time).count());
+
+        waits_number++;
+    }
+
+    if(worker_exception != nullptr) rethrow_exception(worker_exception);
+
+    next_returned_batch_index++;
+
+    return batches(buffer_index);
+}
+
+
+/// Stops the workers and waits for them to finish the batches that they are filling.
+
+void BatchLoader::stop()
+{
+    {
+        lock_guard<mutex> lock(loader_mutex);
+
+        is_stopping = true;
+    }
+
+    buffer_released.notify_all();
+
+    for(thread& worker : workers)
+    {
+        if(worker.joinable()) worker.join();
+    }
+
+    workers.clear();
+}
+
+
+/// Shuffles the samples of the epoch, if required, splits them into batches and draws the augmentation seed of each batch.
+
+void BatchLoader::split_samples()
+{
+    if(shuffle)
+    {
+        samples_indices = data_set_pointer->shuffle_samples_indices(samples_indices, random_engine);
+    }
+
+    batches_samples_indices.resize(batches_number, batch_samples_number);
+
+    for(Index i = 0; i < batches_number; i++)
+    {
+        for(Index j = 0; j < batch_samples_number; j++)
+        {
+            batches_samples_indices(i, j) = samples_indices(i*batch_samples_number + j);
+        }
+    }
+
+    batches_augmentation_seeds.resize(batches_number);
+
+    for(Index i = 0; i < batches_number; i++)
+    {
+        batches_augmentation_seeds(i) = unsigned(random_engine());
+    }
+
+    is_split = true;
+}
+
+
+/// Loop of the workers.
+/// Each worker takes the next batch of the epoch, waits until its buffer has been released and fills it.
+
+void BatchLoader::fill_batches()
+{
+    Tensor<Index, 1> batch_samples_indices(batch_samples_number);
+
+    unsigned batch_augmentation_seed = 0;
+
+    while(true)
+    {
+        Index batch_index = 0;
+
+        {
+            unique_lock<mutex> lock(loader_mutex);
+
+            if(!is_split && !is_stopping) split_samples();
+
+            if(is_stopping || next_filled_batch_index >= batches_number || worker_exception != nullptr) return;
+
+            batch_index = next_filled_batch_index++;
+
+            // The buffer of the batch holds a previous batch until the trainer releases it
+
+            buffer_released.wait(lock, [&]{ return is_stopping || batch_index < released_batches_number + buffers_number; });
+
+            if(is_stopping) return;
+
+            buffers_batches_indices(batch_index%buffers_number) = -1;
+
+            batch_samples_indices = batches_samples_indices.chip(batch_index, 0);
+
+            batch_augmentation_seed = batches_augmentation_seeds(batch_index);
+        }
+
+        try
+        {
+            batches(batch_index%buffers_number).augmentation_seed = batch_augmentation_seed;
+
+            batches(batch_index%buffers_number).fill(batch_samples_indices, input_variables_indices, target_variables_indices);
+        }
+        catch(...)
+        {
+            lock_guard<mutex> lock(loader_mutex);
+
+            if(worker_exception == nullptr) worker_exception = current_exception();
+        }
+
+        {
+            lock_guard<mutex> lock(loader_mutex);
+
+            buffers_batches_indices(batch_index%buffers_number) = batch_index;
+        }
+
+        batch_filled.notify_all();
+    }
+}
+
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
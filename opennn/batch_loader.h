@@ -0,0 +1,220 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   B A T C H   L O A D E R   C L A S S   H E A D E R
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#ifndef BATCHLOADER_H
+#define BATCHLOADER_H
+
+// System includes
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// OpenNN includes
+
+#include "config.h"
+#include "data_set.h"
+
+namespace opennn
+{
+
+/// This class fills the batches of an epoch in background threads, while the previous batches are trained.
+
+/// The loader owns a ring of batch buffers.
+/// The workers take the batches of the epoch in order, and fill each one, including its augmentation,
+/// as soon as its buffer has been released by the trainer.
+/// The trainer gets the batches in the same order with next_batch(), which releases the buffer of the previous batch.
+/// The batch of each buffer is fixed by its position in the epoch,
+/// so the batches are the same for any number of workers, and the shuffle and the augmentation only depend on the seed.
+///
+/// The loader also measures the time during which the trainer waits for data.
+
+class BatchLoader
+{
+
+public:
+
+    // Constructors
+
+    explicit BatchLoader();
+
+    explicit BatchLoader(DataSet*, const Index&, const Index& = 2, const Index& = 1);
+
+    BatchLoader(const BatchLoader&) = delete;
+
+    BatchLoader& operator=(const BatchLoader&) = delete;
+
+    // Destructor
+
+    virtual ~BatchLoader();
+
+    // Get methods
+
+    DataSet* get_data_set_pointer() const;
+
+    const Index& get_batch_samples_number() const;
+
+    const Index& get_buffers_number() const;
+
+    const Index& get_workers_number() const;
+
+    const Index& get_batches_number() const;
+
+    const type& get_waiting_time() const;
+
+    const Index& get_waits_number() const;
+
+    // Set methods
+
+    void set(DataSet*, const Index&, const Index& = 2, const Index& = 1);
+
+    void set_seed(const unsigned&);
+
+    void reset_waiting_time();
+
+    // Loading methods
+
+    void start(const Tensor<Index, 1>&, const Tensor<Index, 1>&, const Tensor<Index, 1>&, const bool& = false);
+
+    DataSetBatch& next_batch();
+
+    void stop();
+
+private:
+
+    void split_samples();
+
+    void fill_batches();
+
+    /// Pointer to the data set whose samples are loaded.
+
+    DataSet* data_set_pointer = nullptr;
+
+    /// Number of samples of each batch.
+
+    Index batch_samples_number = 0;
+
+    /// Number of batch buffers, which is the maximum number of batches filled ahead of the trainer plus one.
+
+    Index buffers_number = 0;
+
+    /// Number of background threads which fill the batches.
+
+    Index workers_number = 0;
+
+    /// Ring of batch buffers.
+
+    Tensor<DataSetBatch, 1> batches;
+
+    /// Index in the epoch of the batch held by each buffer, or -1 if the buffer is being filled.
+
+    Tensor<Index, 1> buffers_batches_indices;
+
+    /// Samples of the epoch, shuffled or not, before they are split into batches.
+
+    Tensor<Index, 1> samples_indices;
+
+    Tensor<Index, 1> input_variables_indices;
+
+    Tensor<Index, 1> target_variables_indices;
+
+    /// Samples of each batch of the epoch, one batch per row.
+
+    Tensor<Index, 2> batches_samples_indices;
+
+    /// Seed of the augmentation of each batch of the epoch.
+
+    Tensor<unsigned, 1> batches_augmentation_seeds;
+
+    /// True if the samples are shuffled before they are split into batches.
+
+    bool shuffle = false;
+
+    /// True once the samples of the epoch have been split into batches by the first worker.
+
+    bool is_split = false;
+
+    /// True when the workers must finish.
+
+    bool is_stopping = false;
+
+    /// Number of batches of the epoch.
+
+    Index batches_number = 0;
+
+    /// Index of the next batch to be taken by a worker.
+
+    Index next_filled_batch_index = 0;
+
+    /// Index of the next batch to be returned to the trainer.
+
+    Index next_returned_batch_index = 0;
+
+    /// Number of batches whose buffers have been released by the trainer.
+
+    Index released_batches_number = 0;
+
+    /// Random number generator of the shuffles and the augmentation seeds, which goes on from one epoch to the next.
+
+    mt19937 random_engine;
+
+    /// First exception thrown by a worker, which is rethrown to the trainer.
+
+    exception_ptr worker_exception;
+
+    /// Time, in seconds, during which the trainer has waited for batches.
+
+    type waiting_time = type(0);
+
+    /// Number of calls to next_batch() whose batch was not ready.
+
+    Index waits_number = 0;
+
+    vector<thread> workers;
+
+    mutex loader_mutex;
+
+    /// Signals the workers that a buffer has been released.
+
+    condition_variable buffer_released;
+
+    /// Signals the trainer that a batch has been filled.
+
+    condition_variable batch_filled;
+};
+
+}
+
+#endif
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -0,0 +1,297 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   B I N A R Y   D A T A   F I L E   C L A S S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "binary_data_file.h"
+
+#include <filesystem>
+
+namespace opennn
+{
+
+static_assert(sizeof(BinaryDataFile::Header) == 64, "The header of the binary data files must take 64 bytes.");
+
+/// Default constructor.
+/// It creates an object without file.
+
+BinaryDataFile::BinaryDataFile()
+{
+}
+
+
+/// File constructor.
+/// It maps a binary data file and checks its header.
+/// @param new_file_name Name of the file.
+
+BinaryDataFile::BinaryDataFile(const string& new_file_name)
+{
+    set(new_file_name);
+}
+
+
+/// Destructor.
+
+BinaryDataFile::~BinaryDataFile()
+{
+}
+
+
+/// Returns the name of the mapped file.
+
+const string& BinaryDataFile::get_file_name() const
+{
+    return mapped_file.get_file_name();
+}
+
+
+/// Returns the version of the format of the mapped file.
+
+Index BinaryDataFile::get_version() const
+{
+    return Index(header.version);
+}
+
+
+/// Returns the number of samples, which is the number of rows of the data matrix.
+
+Index BinaryDataFile::get_samples_number() const
+{
+    return Index(header.samples_number);
+}
+
+
+/// Returns the number of variables, which is the number of columns of the data matrix.
+
+Index BinaryDataFile::get_variables_number() const
+{
+    return Index(header.variables_number);
+}
+
+
+/// Returns the number of values of each block, which is the number of samples rounded up to the alignment.
+
+Index BinaryDataFile::get_block_size() const
+{
+    return Index(header.block_size);
+}
+
+
+/// Returns the metadata text of the mapped file.
+
+string BinaryDataFile::get_metadata() const
+{
+    return string(mapped_file.get_data() + sizeof(Header), size_t(header.metadata_size));
+}
+
+
+/// Returns a view of the mapped blocks, without copies.
+/// Each column of the view is a block, whose rows beyond the number of samples are padding.
+
+TensorMap<const Tensor<type, 2>> BinaryDataFile::get_blocks() const
+{
+    const type* blocks_data = reinterpret_cast<const type*>(mapped_file.get_data() + header.data_offset);
+
+    return TensorMap<const Tensor<type, 2>>(blocks_data, get_block_size(), get_variables_number());
+}
+
+
+/// Returns a view of the values of a variable for all the samples, without copies.
+/// @param variable_index Index of the variable.
+
+TensorMap<const Tensor<type, 1>> BinaryDataFile::get_variable(const Index& variable_index) const
+{
+    if(variable_index < 0 || variable_index >= get_variables_number())
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: BinaryDataFile class.\n"
+               << "TensorMap<const Tensor<type, 1>> get_variable(const Index&) const method.\n"
+               << "Variable index (" << variable_index << ") must be less than number of variables (" << get_variables_number() << ").\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    const type* blocks_data = reinterpret_cast<const type*>(mapped_file.get_data() + header.data_offset);
+
+    return TensorMap<const Tensor<type, 1>>(blocks_data + variable_index*get_block_size(), get_samples_number());
+}
+
+
+/// Maps a binary data file and checks that its header is consistent with the file and with this build.
+/// @param new_file_name Name of the file.
+
+void BinaryDataFile::set(const string& new_file_name)
+{
+    mapped_file.open(new_file_name);
+
+    header = Header();
+
+    ostringstream buffer;
+
+    buffer << "OpenNN Exception: BinaryDataFile class.\n"
+           << "void set(const string&) method.\n";
+
+    if(mapped_file.get_size() < Index(sizeof(Header))
+    || memcmp(mapped_file.get_data(), header.magic, sizeof(header.magic)) != 0)
+    {
+        buffer << "File is not a binary data file: " << new_file_name << "\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    memcpy(&header, mapped_file.get_data(), sizeof(Header));
+
+    const Header current_header;
+
+    if(header.version > current_header.version)
+    {
+        buffer << "Version (" << header.version << ") is newer than supported version (" << current_header.version << ").\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    if(header.byte_order != current_header.byte_order)
+    {
+        buffer << "Byte order of the file is different from the byte order of this machine.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    if(header.value_size != current_header.value_size)
+    {
+        buffer << "Size of values (" << header.value_size << ") is different from size of type (" << current_header.value_size << ").\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    const Index data_size = Index(header.variables_number)*Index(header.block_size)*Index(sizeof(type));
+
+    if(header.samples_number < 0
+    || header.variables_number < 0
+    || header.block_size < header.samples_number
+    || header.metadata_size < 0
+    || Index(sizeof(Header)) + header.metadata_size > header.data_offset
+    || header.alignment == 0
+    || header.data_offset % header.alignment != 0
+    || header.data_offset + data_size > mapped_file.get_size())
+    {
+        buffer << "Header is inconsistent with size of file (" << mapped_file.get_size() << ").\n";
+
+        throw invalid_argument(buffer.str());
+    }
+}
+
+
+/// Returns true if a file starts with the magic string of the binary data files, and false otherwise.
+/// The files saved by previous versions, which start with the dimensions of the matrix, are not.
+/// @param file_name Name of the file.
+
+bool BinaryDataFile::is_binary_data_file(const string& file_name)
+{
+    ifstream file(filesystem::u8path(file_name), ios::binary);
+
+    const Header current_header;
+
+    char magic[sizeof(current_header.magic)];
+
+    if(!file.read(magic, sizeof(magic))) return false;
+
+    return memcmp(magic, current_header.magic, sizeof(magic)) == 0;
+}
+
+
+/// Writes a binary data file.
+/// @param file_name Name of the file.
+/// @param metadata Text which describes the columns of the data matrix.
+/// @param data Data matrix, whose columns are the variables.
+
+void BinaryDataFile::write(const string& file_name, const string& metadata, const Tensor<type, 2>& data)
+{
+    ofstream file(filesystem::u8path(file_name), ios::binary);
+
+    if(!file.is_open())
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: BinaryDataFile class.\n"
+               << "static void write(const string&, const string&, const Tensor<type, 2>&) method.\n"
+               << "Cannot open binary data file: " << file_name << "\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    Header header;
+
+    header.samples_number = int64_t(data.dimension(0));
+    header.variables_number = int64_t(data.dimension(1));
+    header.metadata_size = int64_t(metadata.size());
+    header.data_offset = int64_t(get_aligned_size(Index(sizeof(Header) + metadata.size())));
+    header.block_size = int64_t(get_aligned_size(data.dimension(0)*Index(sizeof(type)))/Index(sizeof(type)));
+
+    const vector<char> padding(size_t(header.alignment), 0);
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+    file.write(metadata.data(), streamsize(metadata.size()));
+
+    file.write(padding.data(), streamsize(header.data_offset - Index(sizeof(Header)) - header.metadata_size));
+
+    // Blocks, in the column major order of the data matrix
+
+    const streamsize values_size = streamsize(data.dimension(0)*Index(sizeof(type)));
+    const streamsize padding_size = streamsize(header.block_size*Index(sizeof(type))) - values_size;
+
+    for(Index j = 0; j < data.dimension(1); j++)
+    {
+        file.write(reinterpret_cast<const char*>(data.data() + j*data.dimension(0)), values_size);
+
+        file.write(padding.data(), padding_size);
+    }
+
+    if(!file)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: BinaryDataFile class.\n"
+               << "static void write(const string&, const string&, const Tensor<type, 2>&) method.\n"
+               << "Cannot write binary data file: " << file_name << "\n";
+
+        throw invalid_argument(buffer.str());
+    }
+}
+
+
+/// Rounds up a number of bytes to the alignment of the blocks.
+/// @param size Number of bytes.
+
+Index BinaryDataFile::get_aligned_size(const Index& size)
+{
+    const Index alignment = Index(Header().alignment);
+
+    return (size + alignment - 1)/alignment*alignment;
+}
+
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
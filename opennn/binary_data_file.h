@@ -0,0 +1,140 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   B I N A R Y   D A T A   F I L E   C L A S S   H E A D E R
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#ifndef BINARYDATAFILE_H
+#define BINARYDATAFILE_H
+
+// System includes
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+// OpenNN includes
+
+#include "config.h"
+#include "mapped_file.h"
+
+namespace opennn
+{
+
+/// This class writes and maps the binary format of the data matrices.
+/// A file starts with a header of 64 bytes, which holds a magic string, the version of the format,
+/// a byte order marker, the size of the values and the dimensions of the matrix.
+/// The header is followed by a metadata text, which describes the columns, and by one block per variable.
+/// Each block holds the values of a variable for all the samples, and starts at a multiple of 64 bytes,
+/// so that the mapped blocks are read as aligned vectors without copies.
+
+class BinaryDataFile
+{
+
+public:
+
+    /// Header at the beginning of the file.
+
+    struct Header
+    {
+        char magic[8] = {'O', 'P', 'E', 'N', 'N', 'N', 'D', 'S'};
+
+        uint32_t version = 1;
+
+        uint32_t byte_order = 0x01020304;
+
+        uint32_t value_size = uint32_t(sizeof(type));
+
+        uint32_t alignment = 64;
+
+        int64_t samples_number = 0;
+
+        int64_t variables_number = 0;
+
+        int64_t metadata_size = 0;
+
+        int64_t data_offset = 0;
+
+        int64_t block_size = 0;
+    };
+
+    // Constructors
+
+    explicit BinaryDataFile();
+
+    explicit BinaryDataFile(const string&);
+
+    // Destructor
+
+    virtual ~BinaryDataFile();
+
+    // Get methods
+
+    const string& get_file_name() const;
+
+    Index get_version() const;
+
+    Index get_samples_number() const;
+
+    Index get_variables_number() const;
+
+    Index get_block_size() const;
+
+    string get_metadata() const;
+
+    TensorMap<const Tensor<type, 2>> get_blocks() const;
+
+    TensorMap<const Tensor<type, 1>> get_variable(const Index&) const;
+
+    // Set methods
+
+    void set(const string&);
+
+    // Serialization methods
+
+    static bool is_binary_data_file(const string&);
+
+    static void write(const string&, const string&, const Tensor<type, 2>&);
+
+private:
+
+    static Index get_aligned_size(const Index&);
+
+    /// Mapping of the file.
+
+    MappedFile mapped_file;
+
+    /// Header of the mapped file.
+
+    Header header;
+};
+
+}
+
+#endif
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
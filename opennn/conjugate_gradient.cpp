@@ -744,6 +744,8 @@ TrainingResults ConjugateGradient::perform_training()
 
     NeuralNetwork* neural_network_pointer = loss_index_pointer->get_neural_network_pointer();
 
+    neural_network_pointer->set_inputs_categories_numbers(data_set_pointer->get_input_categories_numbers());
+
     if(neural_network_pointer->has_scaling_layer())
     {
         ScalingLayer* scaling_layer_pointer = neural_network_pointer->get_scaling_layer_pointer();
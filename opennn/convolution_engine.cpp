@@ -0,0 +1,1246 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   C O N V O L U T I O N   E N G I N E   C L A S S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "convolution_engine.h"
+
+namespace opennn
+{
+
+map<ConvolutionDimensions, ConvolutionEngine::Backend> ConvolutionEngine::tuned_backends;
+
+mutex ConvolutionEngine::tuned_backends_mutex;
+
+
+/// Default constructor.
+/// It creates an engine without dimensions.
+
+ConvolutionEngine::ConvolutionEngine()
+{
+    thread_pool_device = ExecutionContext::get_thread_pool_device();
+}
+
+
+/// Dimensions constructor.
+/// @param new_dimensions Shape of the convolutions.
+/// @param new_backend Backend that computes the convolutions.
+
+ConvolutionEngine::ConvolutionEngine(const ConvolutionDimensions& new_dimensions, const Backend& new_backend)
+{
+    thread_pool_device = ExecutionContext::get_thread_pool_device();
+
+    set(new_dimensions, new_backend);
+}
+
+
+/// Returns the shape of the convolutions.
+
+const ConvolutionDimensions& ConvolutionEngine::get_dimensions() const
+{
+    return dimensions;
+}
+
+
+/// Returns the backend requested for this engine.
+
+const ConvolutionEngine::Backend& ConvolutionEngine::get_backend() const
+{
+    return backend;
+}
+
+
+/// Returns the backend that computes the convolutions.
+/// With the automatic backend, it is automatic until the first convolution has been tuned.
+
+ConvolutionEngine::Backend ConvolutionEngine::get_selected_backend() const
+{
+    return selected_backend;
+}
+
+
+/// Returns true if a backend can compute convolutions of a given shape, and false otherwise.
+/// @param candidate_backend Convolution backend.
+/// @param convolution_dimensions Shape of the convolutions.
+
+bool ConvolutionEngine::is_applicable(const Backend& candidate_backend, const ConvolutionDimensions& convolution_dimensions)
+{
+    switch(candidate_backend)
+    {
+    case Backend::Winograd:
+        return convolution_dimensions.kernels_rows_number == 3
+            && convolution_dimensions.kernels_columns_number == 3
+            && convolution_dimensions.row_stride == 1
+            && convolution_dimensions.column_stride == 1
+            && convolution_dimensions.padding_rows <= 2
+            && convolution_dimensions.padding_columns <= 2;
+
+    default:
+        return true;
+    }
+}
+
+
+/// Returns a string with the name of a backend.
+
+string ConvolutionEngine::write_backend(const Backend& convolution_backend)
+{
+    switch(convolution_backend)
+    {
+    case Backend::Automatic:
+        return "Automatic";
+
+    case Backend::Im2col:
+        return "Im2col";
+
+    case Backend::Winograd:
+        return "Winograd";
+
+    case Backend::Direct:
+        return "Direct";
+    }
+
+    return string();
+}
+
+
+/// Returns the backend chosen by the autotuner for a shape, or automatic if that shape has not been tuned yet.
+
+ConvolutionEngine::Backend ConvolutionEngine::get_tuned_backend(const ConvolutionDimensions& convolution_dimensions)
+{
+    lock_guard<mutex> lock(tuned_backends_mutex);
+
+    const auto iterator = tuned_backends.find(convolution_dimensions);
+
+    return iterator == tuned_backends.end() ? Backend::Automatic : iterator->second;
+}
+
+
+/// Sets the shape and the backend of the convolutions.
+/// @param new_dimensions Shape of the convolutions.
+/// @param new_backend Backend that computes the convolutions.
+
+void ConvolutionEngine::set(const ConvolutionDimensions& new_dimensions, const Backend& new_backend)
+{
+    dimensions = new_dimensions;
+
+    set_backend(new_backend);
+}
+
+
+/// Sets the backend that computes the convolutions.
+/// @param new_backend Convolution backend. It must be applicable to the shape of the engine.
+
+void ConvolutionEngine::set_backend(const Backend& new_backend)
+{
+    if(!is_applicable(new_backend, dimensions))
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: ConvolutionEngine class.\n"
+               << "void set_backend(const Backend&) method.\n"
+               << "Backend " << write_backend(new_backend) << " cannot compute these convolutions.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    backend = new_backend;
+
+    selected_backend = new_backend;
+}
+
+
+/// Forgets the backends chosen by the autotuner, so that every shape is tuned again.
+
+void ConvolutionEngine::clear_tuned_backends()
+{
+    lock_guard<mutex> lock(tuned_backends_mutex);
+
+    tuned_backends.clear();
+}
+
+
+/// Calculates the convolutions of the inputs with the kernels, plus the biases.
+/// @param inputs Inputs data, with dimensions (batch, rows, columns, channels).
+/// @param synaptic_weights Kernels data, with dimensions (rows, columns, channels, kernels).
+/// @param biases Biases data, one per kernel.
+/// @param outputs Outputs data, with dimensions (batch, rows, columns, kernels).
+
+void ConvolutionEngine::calculate_convolutions(const type* inputs,
+                                               const type* synaptic_weights,
+                                               const type* biases,
+                                               type* outputs)
+{
+    if(selected_backend == Backend::Automatic)
+    {
+        selected_backend = tune(inputs, synaptic_weights, biases, outputs);
+
+        return;
+    }
+
+    calculate_convolutions(selected_backend, inputs, synaptic_weights, biases, outputs);
+}
+
+
+/// Calculates the derivatives of the error with respect to the kernels and the biases.
+/// @param inputs Inputs data of the convolutions.
+/// @param deltas Derivatives of the error with respect to the outputs of the convolutions.
+/// @param synaptic_weights_derivatives Kernels derivatives data.
+/// @param biases_derivatives Biases derivatives data.
+
+void ConvolutionEngine::calculate_synaptic_weights_derivatives(const type* inputs,
+                                                               const type* deltas,
+                                                               type* synaptic_weights_derivatives,
+                                                               type* biases_derivatives)
+{
+    select_tuned_backend();
+
+    const Index outputs_number
+            = dimensions.batch_samples_number*dimensions.get_outputs_rows_number()*dimensions.get_outputs_columns_number();
+
+    const TensorMap<Tensor<type, 2>> deltas_map(const_cast<type*>(deltas), outputs_number, dimensions.kernels_number);
+
+    TensorMap<Tensor<type, 1>> biases_derivatives_map(biases_derivatives, dimensions.kernels_number);
+
+    const Eigen::array<Index, 1> rows_dimension = {0};
+
+    biases_derivatives_map.device(*thread_pool_device) = deltas_map.sum(rows_dimension);
+
+    switch(selected_backend)
+    {
+    case Backend::Direct:
+        calculate_direct_synaptic_weights_derivatives(inputs, deltas, synaptic_weights_derivatives);
+        return;
+
+    default:
+        calculate_im2col_synaptic_weights_derivatives(inputs, deltas, synaptic_weights_derivatives);
+        return;
+    }
+}
+
+
+/// Calculates the derivatives of the error with respect to the inputs of the convolutions.
+/// @param deltas Derivatives of the error with respect to the outputs of the convolutions.
+/// @param synaptic_weights Kernels data.
+/// @param inputs_derivatives Inputs derivatives data, with the dimensions of the inputs.
+
+void ConvolutionEngine::calculate_inputs_derivatives(const type* deltas,
+                                                     const type* synaptic_weights,
+                                                     type* inputs_derivatives)
+{
+    select_tuned_backend();
+
+    switch(selected_backend)
+    {
+    case Backend::Winograd:
+        calculate_winograd_inputs_derivatives(deltas, synaptic_weights, inputs_derivatives);
+        return;
+
+    case Backend::Direct:
+        calculate_direct_inputs_derivatives(deltas, synaptic_weights, inputs_derivatives);
+        return;
+
+    default:
+        calculate_im2col_inputs_derivatives(deltas, synaptic_weights, inputs_derivatives);
+        return;
+    }
+}
+
+
+/// Times the backends applicable to the shape of the engine, keeping the outputs, and returns the fastest one.
+/// The result is shared by all the engines with the same shape.
+
+ConvolutionEngine::Backend ConvolutionEngine::tune(const type* inputs,
+                                                   const type* synaptic_weights,
+                                                   const type* biases,
+                                                   type* outputs)
+{
+    const Backend tuned_backend = get_tuned_backend(dimensions);
+
+    if(tuned_backend != Backend::Automatic)
+    {
+        calculate_convolutions(tuned_backend, inputs, synaptic_weights, biases, outputs);
+
+        return tuned_backend;
+    }
+
+    // The direct backend is only timed for kernels with few weights, where it can be competitive.
+
+    const Index direct_maximum_kernel_size = 128;
+
+    vector<Backend> candidates = {Backend::Im2col};
+
+    if(is_applicable(Backend::Winograd, dimensions)) candidates.push_back(Backend::Winograd);
+
+    if(dimensions.get_kernel_size() <= direct_maximum_kernel_size) candidates.push_back(Backend::Direct);
+
+    Backend fastest_backend = Backend::Im2col;
+
+    double minimum_time = numeric_limits<double>::max();
+
+    for(const Backend& candidate : candidates)
+    {
+        // The first run allocates the buffers of the backend
+
+        calculate_convolutions(candidate, inputs, synaptic_weights, biases, outputs);
+
+        const auto beginning_time = chrono::steady_clock::now();
+
+        calculate_convolutions(candidate, inputs, synaptic_weights, biases, outputs);
+
+        const double elapsed_time = chrono::duration<double>(chrono::steady_clock::now() - beginning_time).count();
+
+        if(elapsed_time < minimum_time)
+        {
+            minimum_time = elapsed_time;
+            fastest_backend = candidate;
+        }
+    }
+
+    if(fastest_backend != candidates[candidates.size() - 1])
+    {
+        calculate_convolutions(fastest_backend, inputs, synaptic_weights, biases, outputs);
+    }
+
+    lock_guard<mutex> lock(tuned_backends_mutex);
+
+    tuned_backends[dimensions] = fastest_backend;
+
+    return fastest_backend;
+}
+
+
+/// Selects the backend of the derivatives when it is automatic.
+/// The derivatives follow the backend tuned for the convolutions of the same shape, or im2col if there is none.
+
+void ConvolutionEngine::select_tuned_backend()
+{
+    if(selected_backend != Backend::Automatic) return;
+
+    const Backend tuned_backend = get_tuned_backend(dimensions);
+
+    selected_backend = tuned_backend == Backend::Automatic ? Backend::Im2col : tuned_backend;
+}
+
+
+void ConvolutionEngine::calculate_convolutions(const Backend& convolution_backend,
+                                               const type* inputs,
+                                               const type* synaptic_weights,
+                                               const type* biases,
+                                               type* outputs)
+{
+    switch(convolution_backend)
+    {
+    case Backend::Winograd:
+        calculate_winograd_convolutions(dimensions, inputs, synaptic_weights, biases, outputs);
+        return;
+
+    case Backend::Direct:
+        calculate_direct_convolutions(inputs, synaptic_weights, biases, outputs);
+        return;
+
+    default:
+        calculate_im2col_convolutions(inputs, synaptic_weights, biases, outputs);
+        return;
+    }
+}
+
+
+/// Returns the number of output columns lowered at once, so that the buffers do not exceed the maximum columns size.
+/// @param convolution_dimensions Shape of the convolutions.
+/// @param row_size Number of elements stored for each output.
+
+Index ConvolutionEngine::get_columns_chunk(const ConvolutionDimensions& convolution_dimensions, const Index& row_size) const
+{
+    const Index outputs_columns_number = convolution_dimensions.get_outputs_columns_number();
+
+    const Index column_size = convolution_dimensions.batch_samples_number*convolution_dimensions.get_outputs_rows_number()*row_size;
+
+    return min(outputs_columns_number, max(Index(1), maximum_columns_size/column_size));
+}
+
+
+/// Lowers the receptive fields of a range of output columns to a matrix.
+/// Each row of the matrix holds the inputs under the kernel for one output, with the batch samples varying fastest,
+/// and each column one kernel weight, so that the product with the kernels gives the convolutions.
+/// @param convolution_dimensions Shape of the convolutions.
+/// @param inputs Inputs data.
+/// @param first_output_column First output column of the range.
+/// @param last_output_column Output column past the end of the range.
+/// @param columns_data Matrix data.
+
+void ConvolutionEngine::calculate_columns(const ConvolutionDimensions& convolution_dimensions,
+                                          const type* inputs,
+                                          const Index& first_output_column,
+                                          const Index& last_output_column,
+                                          type* columns_data) const
+{
+    const Index batch_samples_number = convolution_dimensions.batch_samples_number;
+    const Index inputs_rows_number = convolution_dimensions.inputs_rows_number;
+    const Index inputs_columns_number = convolution_dimensions.inputs_columns_number;
+
+    const Index kernels_rows_number = convolution_dimensions.kernels_rows_number;
+    const Index kernels_columns_number = convolution_dimensions.kernels_columns_number;
+
+    const Index outputs_rows_number = convolution_dimensions.get_outputs_rows_number();
+
+    const Index rows_number = batch_samples_number*outputs_rows_number*(last_output_column - first_output_column);
+
+    const TensorOpCost cost(rows_number*sizeof(type), rows_number*sizeof(type), 0);
+
+    thread_pool_device->parallelFor(convolution_dimensions.get_kernel_size(), cost, [&](Index first_index, Index last_index)
+    {
+        for(Index column_index = first_index; column_index < last_index; column_index++)
+        {
+            const Index kernel_row = column_index%kernels_rows_number;
+            const Index kernel_column = (column_index/kernels_rows_number)%kernels_columns_number;
+            const Index channel = column_index/(kernels_rows_number*kernels_columns_number);
+
+            type* column = columns_data + column_index*rows_number;
+
+            for(Index output_column = first_output_column; output_column < last_output_column; output_column++)
+            {
+                const Index input_column = output_column*convolution_dimensions.column_stride + kernel_column - convolution_dimensions.padding_columns;
+
+                for(Index output_row = 0; output_row < outputs_rows_number; output_row++)
+                {
+                    const Index input_row = output_row*convolution_dimensions.row_stride + kernel_row - convolution_dimensions.padding_rows;
+
+                    type* destination = column + batch_samples_number*(output_row + outputs_rows_number*(output_column - first_output_column));
+
+                    if(input_row < 0 || input_row >= inputs_rows_number || input_column < 0 || input_column >= inputs_columns_number)
+                    {
+                        fill(destination, destination + batch_samples_number, type(0));
+                    }
+                    else
+                    {
+                        const type* source = inputs + batch_samples_number*(input_row + inputs_rows_number*(input_column + inputs_columns_number*channel));
+
+                        copy(source, source + batch_samples_number, destination);
+                    }
+                }
+            }
+        }
+    });
+}
+
+
+/// Adds a lowered matrix back to the inputs it was taken from. This is the adjoint of calculate_columns.
+/// @param convolution_dimensions Shape of the convolutions.
+/// @param columns_data Matrix data.
+/// @param first_output_column First output column of the range.
+/// @param last_output_column Output column past the end of the range.
+/// @param inputs Inputs data, which are incremented.
+
+void ConvolutionEngine::add_columns(const ConvolutionDimensions& convolution_dimensions,
+                                    const type* columns_data,
+                                    const Index& first_output_column,
+                                    const Index& last_output_column,
+                                    type* inputs) const
+{
+    const Index batch_samples_number = convolution_dimensions.batch_samples_number;
+    const Index inputs_rows_number = convolution_dimensions.inputs_rows_number;
+    const Index inputs_columns_number = convolution_dimensions.inputs_columns_number;
+
+    const Index kernels_rows_number = convolution_dimensions.kernels_rows_number;
+    const Index kernels_columns_number = convolution_dimensions.kernels_columns_number;
+
+    const Index outputs_rows_number = convolution_dimensions.get_outputs_rows_number();
+
+    const Index rows_number = batch_samples_number*outputs_rows_number*(last_output_column - first_output_column);
+
+    const Index kernel_area = kernels_rows_number*kernels_columns_number;
+
+    const TensorOpCost cost(kernel_area*rows_number*sizeof(type), kernel_area*rows_number*sizeof(type), kernel_area*rows_number);
+
+    // Each channel of the inputs is only written from its own columns, so channels can be added in parallel.
+
+    thread_pool_device->parallelFor(convolution_dimensions.inputs_channels_number, cost, [&](Index first_channel, Index last_channel)
+    {
+        for(Index channel = first_channel; channel < last_channel; channel++)
+        {
+            for(Index kernel_column = 0; kernel_column < kernels_columns_number; kernel_column++)
+            {
+                for(Index kernel_row = 0; kernel_row < kernels_rows_number; kernel_row++)
+                {
+                    const Index column_index = kernel_row + kernels_rows_number*(kernel_column + kernels_columns_number*channel);
+
+                    const type* column = columns_data + column_index*rows_number;
+
+                    for(Index output_column = first_output_column; output_column < last_output_column; output_column++)
+                    {
+                        const Index input_column = output_column*convolution_dimensions.column_stride + kernel_column - convolution_dimensions.padding_columns;
+
+                        if(input_column < 0 || input_column >= inputs_columns_number) continue;
+
+                        for(Index output_row = 0; output_row < outputs_rows_number; output_row++)
+                        {
+                            const Index input_row = output_row*convolution_dimensions.row_stride + kernel_row - convolution_dimensions.padding_rows;
+
+                            if(input_row < 0 || input_row >= inputs_rows_number) continue;
+
+                            const Map<const Array<type, Dynamic, 1>> source(column + batch_samples_number*(output_row + outputs_rows_number*(output_column - first_output_column)),
+                                                                            batch_samples_number);
+
+                            Map<Array<type, Dynamic, 1>> destination(inputs + batch_samples_number*(input_row + inputs_rows_number*(input_column + inputs_columns_number*channel)),
+                                                                     batch_samples_number);
+
+                            destination += source;
+                        }
+                    }
+                }
+            }
+        }
+    });
+}
+
+
+void ConvolutionEngine::calculate_im2col_convolutions(const type* inputs,
+                                                      const type* synaptic_weights,
+                                                      const type* biases,
+                                                      type* outputs)
+{
+    const Index kernel_size = dimensions.get_kernel_size();
+    const Index kernels_number = dimensions.kernels_number;
+
+    const Index outputs_rows_number = dimensions.get_outputs_rows_number();
+    const Index outputs_columns_number = dimensions.get_outputs_columns_number();
+
+    const Index column_size = dimensions.batch_samples_number*outputs_rows_number;
+    const Index outputs_number = column_size*outputs_columns_number;
+
+    const Index columns_chunk = get_columns_chunk(dimensions, max(kernel_size, kernels_number));
+
+    if(columns.size() < column_size*columns_chunk*kernel_size) columns.resize(column_size*columns_chunk*kernel_size);
+
+    if(columns_chunk < outputs_columns_number && products.size() < column_size*columns_chunk*kernels_number)
+    {
+        products.resize(column_size*columns_chunk*kernels_number);
+    }
+
+    const TensorMap<Tensor<type, 2>> synaptic_weights_map(const_cast<type*>(synaptic_weights), kernel_size, kernels_number);
+
+    const Eigen::array<IndexPair<Index>, 1> A_B = {IndexPair<Index>(1, 0)};
+
+    for(Index first_output_column = 0; first_output_column < outputs_columns_number; first_output_column += columns_chunk)
+    {
+        const Index last_output_column = min(first_output_column + columns_chunk, outputs_columns_number);
+
+        const Index rows_number = column_size*(last_output_column - first_output_column);
+
+        calculate_columns(dimensions, inputs, first_output_column, last_output_column, columns.data());
+
+        const TensorMap<Tensor<type, 2>> columns_map(columns.data(), rows_number, kernel_size);
+
+        // Small convolutions are multiplied straight into the outputs
+
+        type* products_data = rows_number == outputs_number ? outputs : products.data();
+
+        TensorMap<Tensor<type, 2>> products_map(products_data, rows_number, kernels_number);
+
+        products_map.device(*thread_pool_device) = columns_map.contract(synaptic_weights_map, A_B);
+
+        // Biases
+
+        const Index offset = column_size*first_output_column;
+
+        const TensorOpCost cost(rows_number*sizeof(type), rows_number*sizeof(type), rows_number);
+
+        thread_pool_device->parallelFor(kernels_number, cost, [&](Index first_kernel, Index last_kernel)
+        {
+            for(Index kernel_index = first_kernel; kernel_index < last_kernel; kernel_index++)
+            {
+                const Map<const Array<type, Dynamic, 1>> product(products_data + kernel_index*rows_number, rows_number);
+
+                Map<Array<type, Dynamic, 1>> output(outputs + kernel_index*outputs_number + offset, rows_number);
+
+                output = product + biases[kernel_index];
+            }
+        });
+    }
+}
+
+
+void ConvolutionEngine::calculate_im2col_synaptic_weights_derivatives(const type* inputs,
+                                                                      const type* deltas,
+                                                                      type* synaptic_weights_derivatives)
+{
+    const Index kernel_size = dimensions.get_kernel_size();
+    const Index kernels_number = dimensions.kernels_number;
+
+    const Index outputs_rows_number = dimensions.get_outputs_rows_number();
+    const Index outputs_columns_number = dimensions.get_outputs_columns_number();
+
+    const Index column_size = dimensions.batch_samples_number*outputs_rows_number;
+    const Index outputs_number = column_size*outputs_columns_number;
+
+    const Index columns_chunk = get_columns_chunk(dimensions, max(kernel_size, kernels_number));
+
+    if(columns.size() < column_size*columns_chunk*kernel_size) columns.resize(column_size*columns_chunk*kernel_size);
+
+    if(columns_chunk < outputs_columns_number && products.size() < column_size*columns_chunk*kernels_number)
+    {
+        products.resize(column_size*columns_chunk*kernels_number);
+    }
+
+    TensorMap<Tensor<type, 2>> synaptic_weights_derivatives_map(synaptic_weights_derivatives, kernel_size, kernels_number);
+
+    const Eigen::array<IndexPair<Index>, 1> AT_B = {IndexPair<Index>(0, 0)};
+
+    for(Index first_output_column = 0; first_output_column < outputs_columns_number; first_output_column += columns_chunk)
+    {
+        const Index last_output_column = min(first_output_column + columns_chunk, outputs_columns_number);
+
+        const Index rows_number = column_size*(last_output_column - first_output_column);
+
+        calculate_columns(dimensions, inputs, first_output_column, last_output_column, columns.data());
+
+        const TensorMap<Tensor<type, 2>> columns_map(columns.data(), rows_number, kernel_size);
+
+        // The deltas of a chunk are gathered so that they are contiguous
+
+        const type* deltas_data = deltas;
+
+        if(rows_number != outputs_number)
+        {
+            const Index offset = column_size*first_output_column;
+
+            for(Index kernel_index = 0; kernel_index < kernels_number; kernel_index++)
+            {
+                copy(deltas + kernel_index*outputs_number + offset,
+                     deltas + kernel_index*outputs_number + offset + rows_number,
+                     products.data() + kernel_index*rows_number);
+            }
+
+            deltas_data = products.data();
+        }
+
+        const TensorMap<Tensor<type, 2>> deltas_map(const_cast<type*>(deltas_data), rows_number, kernels_number);
+
+        if(first_output_column == 0)
+        {
+            synaptic_weights_derivatives_map.device(*thread_pool_device) = columns_map.contract(deltas_map, AT_B);
+        }
+        else
+        {
+            synaptic_weights_derivatives_map.device(*thread_pool_device) += columns_map.contract(deltas_map, AT_B);
+        }
+    }
+}
+
+
+void ConvolutionEngine::calculate_im2col_inputs_derivatives(const type* deltas,
+                                                            const type* synaptic_weights,
+                                                            type* inputs_derivatives)
+{
+    const Index kernel_size = dimensions.get_kernel_size();
+    const Index kernels_number = dimensions.kernels_number;
+
+    const Index outputs_rows_number = dimensions.get_outputs_rows_number();
+    const Index outputs_columns_number = dimensions.get_outputs_columns_number();
+
+    const Index column_size = dimensions.batch_samples_number*outputs_rows_number;
+    const Index outputs_number = column_size*outputs_columns_number;
+
+    const Index columns_chunk = get_columns_chunk(dimensions, max(kernel_size, kernels_number));
+
+    if(columns.size() < column_size*columns_chunk*kernel_size) columns.resize(column_size*columns_chunk*kernel_size);
+
+    if(columns_chunk < outputs_columns_number && products.size() < column_size*columns_chunk*kernels_number)
+    {
+        products.resize(column_size*columns_chunk*kernels_number);
+    }
+
+    const TensorMap<Tensor<type, 2>> synaptic_weights_map(const_cast<type*>(synaptic_weights), kernel_size, kernels_number);
+
+    TensorMap<Tensor<type, 1>> inputs_derivatives_map(inputs_derivatives,
+                                                      dimensions.batch_samples_number
+                                                      *dimensions.inputs_rows_number
+                                                      *dimensions.inputs_columns_number
+                                                      *dimensions.inputs_channels_number);
+
+    inputs_derivatives_map.device(*thread_pool_device) = inputs_derivatives_map.constant(type(0));
+
+    const Eigen::array<IndexPair<Index>, 1> A_BT = {IndexPair<Index>(1, 1)};
+
+    for(Index first_output_column = 0; first_output_column < outputs_columns_number; first_output_column += columns_chunk)
+    {
+        const Index last_output_column = min(first_output_column + columns_chunk, outputs_columns_number);
+
+        const Index rows_number = column_size*(last_output_column - first_output_column);
+
+        const type* deltas_data = deltas;
+
+        if(rows_number != outputs_number)
+        {
+            const Index offset = column_size*first_output_column;
+
+            for(Index kernel_index = 0; kernel_index < kernels_number; kernel_index++)
+            {
+                copy(deltas + kernel_index*outputs_number + offset,
+                     deltas + kernel_index*outputs_number + offset + rows_number,
+                     products.data() + kernel_index*rows_number);
+            }
+
+            deltas_data = products.data();
+        }
+
+        const TensorMap<Tensor<type, 2>> deltas_map(const_cast<type*>(deltas_data), rows_number, kernels_number);
+
+        TensorMap<Tensor<type, 2>> columns_map(columns.data(), rows_number, kernel_size);
+
+        columns_map.device(*thread_pool_device) = deltas_map.contract(synaptic_weights_map, A_BT);
+
+        add_columns(dimensions, columns.data(), first_output_column, last_output_column, inputs_derivatives);
+    }
+}
+
+
+/// Calculates the convolutions with the minimal filtering algorithm F(2x2, 3x3).
+/// Each 2x2 block of outputs is obtained from a 4x4 block of inputs with 16 products instead of 36.
+/// The products of all the blocks are done as 16 matrix multiplications over the channels.
+/// @param convolution_dimensions Shape of the convolutions. The kernels must be 3x3 and the strides one.
+/// @param inputs Inputs data.
+/// @param synaptic_weights Kernels data.
+/// @param biases Biases data, or null for no biases.
+/// @param outputs Outputs data.
+
+void ConvolutionEngine::calculate_winograd_convolutions(const ConvolutionDimensions& convolution_dimensions,
+                                                        const type* inputs,
+                                                        const type* synaptic_weights,
+                                                        const type* biases,
+                                                        type* outputs)
+{
+    const Index batch_samples_number = convolution_dimensions.batch_samples_number;
+    const Index inputs_rows_number = convolution_dimensions.inputs_rows_number;
+    const Index inputs_columns_number = convolution_dimensions.inputs_columns_number;
+    const Index channels_number = convolution_dimensions.inputs_channels_number;
+    const Index kernels_number = convolution_dimensions.kernels_number;
+
+    const Index outputs_rows_number = convolution_dimensions.get_outputs_rows_number();
+    const Index outputs_columns_number = convolution_dimensions.get_outputs_columns_number();
+
+    const Index tiles_rows_number = (outputs_rows_number + 1)/2;
+    const Index tiles_columns_number = (outputs_columns_number + 1)/2;
+
+    const Index tiles_column_size = batch_samples_number*tiles_rows_number;
+
+    const Index tiles_columns_chunk = min(tiles_columns_number,
+                                          max(Index(1), maximum_columns_size/(16*tiles_column_size*max(channels_number, kernels_number))));
+
+    const Index chunk_size = tiles_column_size*tiles_columns_chunk;
+
+    if(columns.size() < 16*chunk_size*channels_number) columns.resize(16*chunk_size*channels_number);
+    if(products.size() < 16*chunk_size*kernels_number) products.resize(16*chunk_size*kernels_number);
+    if(transformed_synaptic_weights.size() < 16*channels_number*kernels_number) transformed_synaptic_weights.resize(16*channels_number*kernels_number);
+
+    type* transformed_inputs_data = columns.data();
+    type* transformed_outputs_data = products.data();
+    type* transformed_synaptic_weights_data = transformed_synaptic_weights.data();
+
+    // Kernels transformation G g G^T
+
+    const Index kernels_matrix_size = channels_number*kernels_number;
+
+    thread_pool_device->parallelFor(kernels_matrix_size, TensorOpCost(9*sizeof(type), 16*sizeof(type), 64), [&](Index first_index, Index last_index)
+    {
+        type Gg[4][3];
+
+        for(Index index = first_index; index < last_index; index++)
+        {
+            const type* g = synaptic_weights + 9*index;
+
+            for(Index j = 0; j < 3; j++)
+            {
+                Gg[0][j] = g[3*j];
+                Gg[1][j] = type(0.5)*(g[3*j] + g[1 + 3*j] + g[2 + 3*j]);
+                Gg[2][j] = type(0.5)*(g[3*j] - g[1 + 3*j] + g[2 + 3*j]);
+                Gg[3][j] = g[2 + 3*j];
+            }
+
+            for(Index a = 0; a < 4; a++)
+            {
+                type* u = transformed_synaptic_weights_data + 4*a*kernels_matrix_size + index;
+
+                u[0] = Gg[a][0];
+                u[kernels_matrix_size] = type(0.5)*(Gg[a][0] + Gg[a][1] + Gg[a][2]);
+                u[2*kernels_matrix_size] = type(0.5)*(Gg[a][0] - Gg[a][1] + Gg[a][2]);
+                u[3*kernels_matrix_size] = Gg[a][2];
+            }
+        }
+    });
+
+    Tensor<type, 1> zeros(batch_samples_number);
+    zeros.setZero();
+
+    const Eigen::array<IndexPair<Index>, 1> A_B = {IndexPair<Index>(1, 0)};
+
+    for(Index first_tiles_column = 0; first_tiles_column < tiles_columns_number; first_tiles_column += tiles_columns_chunk)
+    {
+        const Index last_tiles_column = min(first_tiles_column + tiles_columns_chunk, tiles_columns_number);
+
+        const Index tiles_number = tiles_column_size*(last_tiles_column - first_tiles_column);
+
+        // Inputs transformation B^T d B
+
+        const TensorOpCost inputs_cost(16*tiles_number*sizeof(type), 16*tiles_number*sizeof(type), 48*tiles_number);
+
+        thread_pool_device->parallelFor(channels_number, inputs_cost, [&](Index first_channel, Index last_channel)
+        {
+            Tensor<type, 1> workspace(16*batch_samples_number);
+
+            const type* d[4][4];
+
+            for(Index channel = first_channel; channel < last_channel; channel++)
+            {
+                for(Index tiles_column = first_tiles_column; tiles_column < last_tiles_column; tiles_column++)
+                {
+                    for(Index tiles_row = 0; tiles_row < tiles_rows_number; tiles_row++)
+                    {
+                        for(Index a = 0; a < 4; a++)
+                        {
+                            const Index input_row = 2*tiles_row + a - convolution_dimensions.padding_rows;
+
+                            for(Index b = 0; b < 4; b++)
+                            {
+                                const Index input_column = 2*tiles_column + b - convolution_dimensions.padding_columns;
+
+                                d[a][b] = input_row < 0 || input_row >= inputs_rows_number || input_column < 0 || input_column >= inputs_columns_number
+                                        ? zeros.data()
+                                        : inputs + batch_samples_number*(input_row + inputs_rows_number*(input_column + inputs_columns_number*channel));
+                            }
+                        }
+
+                        for(Index b = 0; b < 4; b++)
+                        {
+                            const Map<const Array<type, Dynamic, 1>> d0(d[0][b], batch_samples_number);
+                            const Map<const Array<type, Dynamic, 1>> d1(d[1][b], batch_samples_number);
+                            const Map<const Array<type, Dynamic, 1>> d2(d[2][b], batch_samples_number);
+                            const Map<const Array<type, Dynamic, 1>> d3(d[3][b], batch_samples_number);
+
+                            Map<Array<type, Dynamic, 1>>(workspace.data() + b*batch_samples_number, batch_samples_number) = d0 - d2;
+                            Map<Array<type, Dynamic, 1>>(workspace.data() + (4 + b)*batch_samples_number, batch_samples_number) = d1 + d2;
+                            Map<Array<type, Dynamic, 1>>(workspace.data() + (8 + b)*batch_samples_number, batch_samples_number) = d2 - d1;
+                            Map<Array<type, Dynamic, 1>>(workspace.data() + (12 + b)*batch_samples_number, batch_samples_number) = d1 - d3;
+                        }
+
+                        const Index tile_offset = batch_samples_number*(tiles_row + tiles_rows_number*(tiles_column - first_tiles_column));
+
+                        for(Index a = 0; a < 4; a++)
+                        {
+                            const Map<const Array<type, Dynamic, 1>> t0(workspace.data() + 4*a*batch_samples_number, batch_samples_number);
+                            const Map<const Array<type, Dynamic, 1>> t1(workspace.data() + (4*a + 1)*batch_samples_number, batch_samples_number);
+                            const Map<const Array<type, Dynamic, 1>> t2(workspace.data() + (4*a + 2)*batch_samples_number, batch_samples_number);
+                            const Map<const Array<type, Dynamic, 1>> t3(workspace.data() + (4*a + 3)*batch_samples_number, batch_samples_number);
+
+                            type* v = transformed_inputs_data + 4*a*tiles_number*channels_number + channel*tiles_number + tile_offset;
+
+                            Map<Array<type, Dynamic, 1>>(v, batch_samples_number) = t0 - t2;
+                            Map<Array<type, Dynamic, 1>>(v + tiles_number*channels_number, batch_samples_number) = t1 + t2;
+                            Map<Array<type, Dynamic, 1>>(v + 2*tiles_number*channels_number, batch_samples_number) = t2 - t1;
+                            Map<Array<type, Dynamic, 1>>(v + 3*tiles_number*channels_number, batch_samples_number) = t1 - t3;
+                        }
+                    }
+                }
+            }
+        });
+
+        // Element-wise products, summed over the channels
+
+        for(Index element = 0; element < 16; element++)
+        {
+            const TensorMap<Tensor<type, 2>> transformed_inputs(transformed_inputs_data + element*tiles_number*channels_number,
+                                                                tiles_number,
+                                                                channels_number);
+
+            const TensorMap<Tensor<type, 2>> transformed_synaptic_weights_map(transformed_synaptic_weights_data + element*kernels_matrix_size,
+                                                                              channels_number,
+                                                                              kernels_number);
+
+            TensorMap<Tensor<type, 2>> transformed_outputs(transformed_outputs_data + element*tiles_number*kernels_number,
+                                                           tiles_number,
+                                                           kernels_number);
+
+            transformed_outputs.device(*thread_pool_device) = transformed_inputs.contract(transformed_synaptic_weights_map, A_B);
+        }
+
+        // Outputs transformation A^T m A
+
+        const TensorOpCost outputs_cost(16*tiles_number*sizeof(type), 4*tiles_number*sizeof(type), 24*tiles_number);
+
+        thread_pool_device->parallelFor(kernels_number, outputs_cost, [&](Index first_kernel, Index last_kernel)
+        {
+            Tensor<type, 1> workspace(8*batch_samples_number);
+
+            for(Index kernel_index = first_kernel; kernel_index < last_kernel; kernel_index++)
+            {
+                const type bias = biases == nullptr ? type(0) : biases[kernel_index];
+
+                for(Index tiles_column = first_tiles_column; tiles_column < last_tiles_column; tiles_column++)
+                {
+                    for(Index tiles_row = 0; tiles_row < tiles_rows_number; tiles_row++)
+                    {
+                        const Index tile_offset = batch_samples_number*(tiles_row + tiles_rows_number*(tiles_column - first_tiles_column));
+
+                        const type* m = transformed_outputs_data + kernel_index*tiles_number + tile_offset;
+
+                        const Index element_size = tiles_number*kernels_number;
+
+                        for(Index b = 0; b < 4; b++)
+                        {
+                            const Map<const Array<type, Dynamic, 1>> m0(m + b*element_size, batch_samples_number);
+                            const Map<const Array<type, Dynamic, 1>> m1(m + (4 + b)*element_size, batch_samples_number);
+                            const Map<const Array<type, Dynamic, 1>> m2(m + (8 + b)*element_size, batch_samples_number);
+                            const Map<const Array<type, Dynamic, 1>> m3(m + (12 + b)*element_size, batch_samples_number);
+
+                            Map<Array<type, Dynamic, 1>>(workspace.data() + b*batch_samples_number, batch_samples_number) = m0 + m1 + m2;
+                            Map<Array<type, Dynamic, 1>>(workspace.data() + (4 + b)*batch_samples_number, batch_samples_number) = m1 - m2 - m3;
+                        }
+
+                        for(Index r = 0; r < 2; r++)
+                        {
+                            const Index output_row = 2*tiles_row + r;
+
+                            if(output_row >= outputs_rows_number) continue;
+
+                            const Map<const Array<type, Dynamic, 1>> s0(workspace.data() + 4*r*batch_samples_number, batch_samples_number);
+                            const Map<const Array<type, Dynamic, 1>> s1(workspace.data() + (4*r + 1)*batch_samples_number, batch_samples_number);
+                            const Map<const Array<type, Dynamic, 1>> s2(workspace.data() + (4*r + 2)*batch_samples_number, batch_samples_number);
+                            const Map<const Array<type, Dynamic, 1>> s3(workspace.data() + (4*r + 3)*batch_samples_number, batch_samples_number);
+
+                            const Index output_column = 2*tiles_column;
+
+                            Map<Array<type, Dynamic, 1>>(outputs + batch_samples_number*(output_row + outputs_rows_number*(output_column + outputs_columns_number*kernel_index)),
+                                                         batch_samples_number) = s0 + s1 + s2 + bias;
+
+                            if(output_column + 1 >= outputs_columns_number) continue;
+
+                            Map<Array<type, Dynamic, 1>>(outputs + batch_samples_number*(output_row + outputs_rows_number*(output_column + 1 + outputs_columns_number*kernel_index)),
+                                                         batch_samples_number) = s1 - s2 - s3 + bias;
+                        }
+                    }
+                }
+            }
+        });
+    }
+}
+
+
+/// Calculates the inputs derivatives as the convolution of the padded deltas with the flipped kernels,
+/// which is also a 3x3 convolution with unit strides.
+
+void ConvolutionEngine::calculate_winograd_inputs_derivatives(const type* deltas,
+                                                              const type* synaptic_weights,
+                                                              type* inputs_derivatives)
+{
+    const Index channels_number = dimensions.inputs_channels_number;
+    const Index kernels_number = dimensions.kernels_number;
+
+    if(flipped_synaptic_weights.size() != 9*channels_number*kernels_number) flipped_synaptic_weights.resize(9*channels_number*kernels_number);
+
+    type* flipped_synaptic_weights_data = flipped_synaptic_weights.data();
+
+    for(Index channel = 0; channel < channels_number; channel++)
+    {
+        for(Index kernel_index = 0; kernel_index < kernels_number; kernel_index++)
+        {
+            const type* kernel = synaptic_weights + 9*(channel + channels_number*kernel_index);
+
+            type* flipped_kernel = flipped_synaptic_weights_data + 9*(kernel_index + kernels_number*channel);
+
+            for(Index i = 0; i < 9; i++)
+            {
+                flipped_kernel[i] = kernel[8 - i];
+            }
+        }
+    }
+
+    calculate_winograd_convolutions(dimensions.get_transposed(), deltas, flipped_synaptic_weights_data, nullptr, inputs_derivatives);
+}
+
+
+/// Returns the range of outputs along one dimension that read inputs inside the image for a given kernel offset.
+/// @param inputs_number Number of inputs along the dimension.
+/// @param outputs_number Number of outputs along the dimension.
+/// @param stride Stride along the dimension.
+/// @param padding Padding along the dimension.
+/// @param kernel_offset Row or column of the kernel.
+/// @param first_output First output of the range.
+/// @param last_output Output past the end of the range.
+
+void ConvolutionEngine::get_outputs_range(const Index& inputs_number,
+                                          const Index& outputs_number,
+                                          const Index& stride,
+                                          const Index& padding,
+                                          const Index& kernel_offset,
+                                          Index& first_output,
+                                          Index& last_output)
+{
+    first_output = padding > kernel_offset ? (padding - kernel_offset + stride - 1)/stride : 0;
+
+    const Index last_input = inputs_number - 1 + padding - kernel_offset;
+
+    last_output = last_input < 0 ? 0 : min(outputs_number, last_input/stride + 1);
+
+    if(last_output < first_output) last_output = first_output;
+}
+
+
+/// Calculates the convolutions as a sum of the inputs scaled by each kernel weight.
+/// With unit row strides, the inputs under a kernel weight for a whole output column are contiguous,
+/// so each weight is applied with a single vector operation over the batch and the rows.
+
+void ConvolutionEngine::calculate_direct_convolutions(const type* inputs,
+                                                      const type* synaptic_weights,
+                                                      const type* biases,
+                                                      type* outputs) const
+{
+    const Index batch_samples_number = dimensions.batch_samples_number;
+    const Index inputs_rows_number = dimensions.inputs_rows_number;
+    const Index inputs_columns_number = dimensions.inputs_columns_number;
+    const Index channels_number = dimensions.inputs_channels_number;
+
+    const Index kernels_rows_number = dimensions.kernels_rows_number;
+    const Index kernels_columns_number = dimensions.kernels_columns_number;
+    const Index kernel_size = dimensions.get_kernel_size();
+
+    const Index outputs_rows_number = dimensions.get_outputs_rows_number();
+    const Index outputs_columns_number = dimensions.get_outputs_columns_number();
+
+    const Index kernel_outputs_number = batch_samples_number*outputs_rows_number*outputs_columns_number;
+
+    const TensorOpCost cost(kernel_size*kernel_outputs_number*sizeof(type), kernel_outputs_number*sizeof(type), 2*kernel_size*kernel_outputs_number);
+
+    thread_pool_device->parallelFor(dimensions.kernels_number, cost, [&](Index first_kernel, Index last_kernel)
+    {
+        for(Index kernel_index = first_kernel; kernel_index < last_kernel; kernel_index++)
+        {
+            const type* kernel = synaptic_weights + kernel_index*kernel_size;
+
+            type* kernel_outputs = outputs + kernel_index*kernel_outputs_number;
+
+            Map<Array<type, Dynamic, 1>>(kernel_outputs, kernel_outputs_number).setConstant(biases[kernel_index]);
+
+            for(Index channel = 0; channel < channels_number; channel++)
+            {
+                const type* channel_inputs = inputs + channel*batch_samples_number*inputs_rows_number*inputs_columns_number;
+
+                for(Index kernel_column = 0; kernel_column < kernels_columns_number; kernel_column++)
+                {
+                    Index first_output_column;
+                    Index last_output_column;
+
+                    get_outputs_range(inputs_columns_number, outputs_columns_number, dimensions.column_stride, dimensions.padding_columns,
+                                      kernel_column, first_output_column, last_output_column);
+
+                    for(Index kernel_row = 0; kernel_row < kernels_rows_number; kernel_row++)
+                    {
+                        Index first_output_row;
+                        Index last_output_row;
+
+                        get_outputs_range(inputs_rows_number, outputs_rows_number, dimensions.row_stride, dimensions.padding_rows,
+                                          kernel_row, first_output_row, last_output_row);
+
+                        const type weight = kernel[kernel_row + kernels_rows_number*(kernel_column + kernels_columns_number*channel)];
+
+                        const Index segment_size = dimensions.row_stride == 1 ? batch_samples_number*(last_output_row - first_output_row) : batch_samples_number;
+
+                        for(Index output_column = first_output_column; output_column < last_output_column; output_column++)
+                        {
+                            const Index input_column = output_column*dimensions.column_stride + kernel_column - dimensions.padding_columns;
+
+                            for(Index output_row = first_output_row; output_row < last_output_row; output_row += segment_size/batch_samples_number)
+                            {
+                                const Index input_row = output_row*dimensions.row_stride + kernel_row - dimensions.padding_rows;
+
+                                const Map<const Array<type, Dynamic, 1>> input(channel_inputs + batch_samples_number*(input_row + inputs_rows_number*input_column),
+                                                                               segment_size);
+
+                                Map<Array<type, Dynamic, 1>> output(kernel_outputs + batch_samples_number*(output_row + outputs_rows_number*output_column),
+                                                                    segment_size);
+
+                                output += weight*input;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    });
+}
+
+
+void ConvolutionEngine::calculate_direct_synaptic_weights_derivatives(const type* inputs,
+                                                                      const type* deltas,
+                                                                      type* synaptic_weights_derivatives) const
+{
+    const Index batch_samples_number = dimensions.batch_samples_number;
+    const Index inputs_rows_number = dimensions.inputs_rows_number;
+    const Index inputs_columns_number = dimensions.inputs_columns_number;
+
+    const Index kernels_rows_number = dimensions.kernels_rows_number;
+    const Index kernels_columns_number = dimensions.kernels_columns_number;
+    const Index kernel_size = dimensions.get_kernel_size();
+
+    const Index outputs_rows_number = dimensions.get_outputs_rows_number();
+    const Index outputs_columns_number = dimensions.get_outputs_columns_number();
+
+    const Index kernel_outputs_number = batch_samples_number*outputs_rows_number*outputs_columns_number;
+
+    const TensorOpCost cost(2*kernel_outputs_number*sizeof(type), sizeof(type), 2*kernel_outputs_number);
+
+    thread_pool_device->parallelFor(kernel_size*dimensions.kernels_number, cost, [&](Index first_index, Index last_index)
+    {
+        for(Index index = first_index; index < last_index; index++)
+        {
+            const Index kernel_row = index%kernels_rows_number;
+            const Index kernel_column = (index/kernels_rows_number)%kernels_columns_number;
+            const Index channel = (index/(kernels_rows_number*kernels_columns_number))%dimensions.inputs_channels_number;
+            const Index kernel_index = index/kernel_size;
+
+            const type* channel_inputs = inputs + channel*batch_samples_number*inputs_rows_number*inputs_columns_number;
+            const type* kernel_deltas = deltas + kernel_index*kernel_outputs_number;
+
+            Index first_output_row;
+            Index last_output_row;
+            Index first_output_column;
+            Index last_output_column;
+
+            get_outputs_range(inputs_rows_number, outputs_rows_number, dimensions.row_stride, dimensions.padding_rows,
+                              kernel_row, first_output_row, last_output_row);
+
+            get_outputs_range(inputs_columns_number, outputs_columns_number, dimensions.column_stride, dimensions.padding_columns,
+                              kernel_column, first_output_column, last_output_column);
+
+            const Index segment_size = dimensions.row_stride == 1 ? batch_samples_number*(last_output_row - first_output_row) : batch_samples_number;
+
+            type derivative = type(0);
+
+            for(Index output_column = first_output_column; output_column < last_output_column; output_column++)
+            {
+                const Index input_column = output_column*dimensions.column_stride + kernel_column - dimensions.padding_columns;
+
+                for(Index output_row = first_output_row; output_row < last_output_row; output_row += segment_size/batch_samples_number)
+                {
+                    const Index input_row = output_row*dimensions.row_stride + kernel_row - dimensions.padding_rows;
+
+                    const Map<const Array<type, Dynamic, 1>> input(channel_inputs + batch_samples_number*(input_row + inputs_rows_number*input_column),
+                                                                   segment_size);
+
+                    const Map<const Array<type, Dynamic, 1>> delta(kernel_deltas + batch_samples_number*(output_row + outputs_rows_number*output_column),
+                                                                   segment_size);
+
+                    derivative += (input*delta).sum();
+                }
+            }
+
+            synaptic_weights_derivatives[index] = derivative;
+        }
+    });
+}
+
+
+void ConvolutionEngine::calculate_direct_inputs_derivatives(const type* deltas,
+                                                            const type* synaptic_weights,
+                                                            type* inputs_derivatives) const
+{
+    const Index batch_samples_number = dimensions.batch_samples_number;
+    const Index inputs_rows_number = dimensions.inputs_rows_number;
+    const Index inputs_columns_number = dimensions.inputs_columns_number;
+    const Index kernels_number = dimensions.kernels_number;
+
+    const Index kernels_rows_number = dimensions.kernels_rows_number;
+    const Index kernels_columns_number = dimensions.kernels_columns_number;
+    const Index kernel_size = dimensions.get_kernel_size();
+
+    const Index outputs_rows_number = dimensions.get_outputs_rows_number();
+    const Index outputs_columns_number = dimensions.get_outputs_columns_number();
+
+    const Index channel_inputs_number = batch_samples_number*inputs_rows_number*inputs_columns_number;
+    const Index kernel_outputs_number = batch_samples_number*outputs_rows_number*outputs_columns_number;
+
+    const Index channel_operations_number = kernels_number*kernels_rows_number*kernels_columns_number*kernel_outputs_number;
+
+    const TensorOpCost cost(2*channel_operations_number*sizeof(type), channel_inputs_number*sizeof(type), 2*channel_operations_number);
+
+    // Each channel of the inputs derivatives only depends on its own weights, so channels are calculated in parallel.
+
+    thread_pool_device->parallelFor(dimensions.inputs_channels_number, cost, [&](Index first_channel, Index last_channel)
+    {
+        for(Index channel = first_channel; channel < last_channel; channel++)
+        {
+            type* channel_inputs_derivatives = inputs_derivatives + channel*channel_inputs_number;
+
+            fill(channel_inputs_derivatives, channel_inputs_derivatives + channel_inputs_number, type(0));
+
+            for(Index kernel_index = 0; kernel_index < kernels_number; kernel_index++)
+            {
+                const type* kernel_deltas = deltas + kernel_index*kernel_outputs_number;
+
+                for(Index kernel_column = 0; kernel_column < kernels_columns_number; kernel_column++)
+                {
+                    Index first_output_column;
+                    Index last_output_column;
+
+                    get_outputs_range(inputs_columns_number, outputs_columns_number, dimensions.column_stride, dimensions.padding_columns,
+                                      kernel_column, first_output_column, last_output_column);
+
+                    for(Index kernel_row = 0; kernel_row < kernels_rows_number; kernel_row++)
+                    {
+                        Index first_output_row;
+                        Index last_output_row;
+
+                        get_outputs_range(inputs_rows_number, outputs_rows_number, dimensions.row_stride, dimensions.padding_rows,
+                                          kernel_row, first_output_row, last_output_row);
+
+                        const type weight = synaptic_weights[kernel_row + kernels_rows_number*(kernel_column + kernels_columns_number*channel) + kernel_index*kernel_size];
+
+                        const Index segment_size = dimensions.row_stride == 1 ? batch_samples_number*(last_output_row - first_output_row) : batch_samples_number;
+
+                        for(Index output_column = first_output_column; output_column < last_output_column; output_column++)
+                        {
+                            const Index input_column = output_column*dimensions.column_stride + kernel_column - dimensions.padding_columns;
+
+                            for(Index output_row = first_output_row; output_row < last_output_row; output_row += segment_size/batch_samples_number)
+                            {
+                                const Index input_row = output_row*dimensions.row_stride + kernel_row - dimensions.padding_rows;
+
+                                const Map<const Array<type, Dynamic, 1>> delta(kernel_deltas + batch_samples_number*(output_row + outputs_rows_number*output_column),
+                                                                               segment_size);
+
+                                Map<Array<type, Dynamic, 1>> input_derivative(channel_inputs_derivatives + batch_samples_number*(input_row + inputs_rows_number*input_column),
+                                                                              segment_size);
+
+                                input_derivative += weight*delta;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    });
+}
+
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
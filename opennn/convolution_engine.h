@@ -0,0 +1,260 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   C O N V O L U T I O N   E N G I N E   C L A S S   H E A D E R
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#ifndef CONVOLUTIONENGINE_H
+#define CONVOLUTIONENGINE_H
+
+// System includes
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+// OpenNN includes
+
+#include "config.h"
+#include "execution_context.h"
+
+namespace opennn
+{
+
+/// Shape of a two-dimensional convolution.
+/// Tensors are stored in column-major order, with the batch samples as the innermost dimension:
+/// inputs are (batch, rows, columns, channels), kernels (rows, columns, channels, kernels)
+/// and outputs (batch, rows, columns, kernels).
+
+struct ConvolutionDimensions
+{
+    Index batch_samples_number = 0;
+
+    Index inputs_rows_number = 0;
+    Index inputs_columns_number = 0;
+    Index inputs_channels_number = 0;
+
+    Index kernels_rows_number = 0;
+    Index kernels_columns_number = 0;
+    Index kernels_number = 0;
+
+    Index row_stride = 1;
+    Index column_stride = 1;
+
+    Index padding_rows = 0;
+    Index padding_columns = 0;
+
+    Index get_outputs_rows_number() const
+    {
+        return (inputs_rows_number - kernels_rows_number + 2*padding_rows)/row_stride + 1;
+    }
+
+    Index get_outputs_columns_number() const
+    {
+        return (inputs_columns_number - kernels_columns_number + 2*padding_columns)/column_stride + 1;
+    }
+
+    /// Number of weights of a single kernel.
+
+    Index get_kernel_size() const
+    {
+        return kernels_rows_number*kernels_columns_number*inputs_channels_number;
+    }
+
+    /// Shape of the convolution that propagates the deltas of the outputs back to the inputs.
+    /// It is only defined for unit strides.
+
+    ConvolutionDimensions get_transposed() const
+    {
+        ConvolutionDimensions transposed = *this;
+
+        transposed.inputs_rows_number = get_outputs_rows_number();
+        transposed.inputs_columns_number = get_outputs_columns_number();
+        transposed.inputs_channels_number = kernels_number;
+        transposed.kernels_number = inputs_channels_number;
+        transposed.padding_rows = kernels_rows_number - 1 - padding_rows;
+        transposed.padding_columns = kernels_columns_number - 1 - padding_columns;
+
+        return transposed;
+    }
+
+    bool operator<(const ConvolutionDimensions& other) const
+    {
+        const Index values[] = {batch_samples_number, inputs_rows_number, inputs_columns_number, inputs_channels_number,
+                                kernels_rows_number, kernels_columns_number, kernels_number,
+                                row_stride, column_stride, padding_rows, padding_columns};
+
+        const Index other_values[] = {other.batch_samples_number, other.inputs_rows_number, other.inputs_columns_number, other.inputs_channels_number,
+                                      other.kernels_rows_number, other.kernels_columns_number, other.kernels_number,
+                                      other.row_stride, other.column_stride, other.padding_rows, other.padding_columns};
+
+        return lexicographical_compare(begin(values), end(values), begin(other_values), end(other_values));
+    }
+};
+
+
+/// This class computes the convolutions of a convolutional layer and their derivatives.
+/// It offers several backends:
+/// <ul>
+/// <li> Im2col: Lowers the receptive fields to a matrix and multiplies it by the kernels.
+/// <li> Winograd: Minimal filtering F(2x2, 3x3), only for 3x3 kernels with unit strides.
+/// <li> Direct: Accumulates the products directly, vectorized along the batch. It suits kernels with few weights.
+/// </ul>
+/// With the automatic backend, the first convolution of each shape times the applicable backends
+/// and the fastest one is kept for all the engines with that shape.
+
+class ConvolutionEngine
+{
+
+public:
+
+    /// Enumeration of the available convolution backends.
+
+    enum class Backend{Automatic, Im2col, Winograd, Direct};
+
+    // Constructors
+
+    explicit ConvolutionEngine();
+
+    explicit ConvolutionEngine(const ConvolutionDimensions&, const Backend& = Backend::Automatic);
+
+    // Get methods
+
+    const ConvolutionDimensions& get_dimensions() const;
+
+    const Backend& get_backend() const;
+
+    Backend get_selected_backend() const;
+
+    static bool is_applicable(const Backend&, const ConvolutionDimensions&);
+
+    static string write_backend(const Backend&);
+
+    static Backend get_tuned_backend(const ConvolutionDimensions&);
+
+    // Set methods
+
+    void set(const ConvolutionDimensions&, const Backend& = Backend::Automatic);
+
+    void set_backend(const Backend&);
+
+    static void clear_tuned_backends();
+
+    // Convolution methods
+
+    void calculate_convolutions(const type*, const type*, const type*, type*);
+
+    void calculate_synaptic_weights_derivatives(const type*, const type*, type*, type*);
+
+    void calculate_inputs_derivatives(const type*, const type*, type*);
+
+private:
+
+    Backend tune(const type*, const type*, const type*, type*);
+
+    void select_tuned_backend();
+
+    void calculate_convolutions(const Backend&, const type*, const type*, const type*, type*);
+
+    // Im2col
+
+    Index get_columns_chunk(const ConvolutionDimensions&, const Index&) const;
+
+    void calculate_columns(const ConvolutionDimensions&, const type*, const Index&, const Index&, type*) const;
+
+    void add_columns(const ConvolutionDimensions&, const type*, const Index&, const Index&, type*) const;
+
+    void calculate_im2col_convolutions(const type*, const type*, const type*, type*);
+
+    void calculate_im2col_synaptic_weights_derivatives(const type*, const type*, type*);
+
+    void calculate_im2col_inputs_derivatives(const type*, const type*, type*);
+
+    // Winograd
+
+    void calculate_winograd_convolutions(const ConvolutionDimensions&, const type*, const type*, const type*, type*);
+
+    void calculate_winograd_inputs_derivatives(const type*, const type*, type*);
+
+    // Direct
+
+    static void get_outputs_range(const Index&, const Index&, const Index&, const Index&, const Index&, Index&, Index&);
+
+    void calculate_direct_convolutions(const type*, const type*, const type*, type*) const;
+
+    void calculate_direct_synaptic_weights_derivatives(const type*, const type*, type*) const;
+
+    void calculate_direct_inputs_derivatives(const type*, const type*, type*) const;
+
+    /// Shape of the convolutions.
+
+    ConvolutionDimensions dimensions;
+
+    /// Backend requested for this engine.
+
+    Backend backend = Backend::Automatic;
+
+    /// Backend that runs the convolutions. It differs from the requested one only when that is automatic.
+
+    Backend selected_backend = Backend::Automatic;
+
+    /// Maximum number of elements of the lowered inputs. Larger convolutions are computed in chunks of output columns.
+
+    Index maximum_columns_size = Index(1) << 23;
+
+    /// Lowered receptive fields, or transformed inputs for the Winograd backend.
+
+    Tensor<type, 1> columns;
+
+    /// Products of the lowered inputs and the kernels, or transformed outputs for the Winograd backend.
+
+    Tensor<type, 1> products;
+
+    /// Kernels transformed for the Winograd backend.
+
+    Tensor<type, 1> transformed_synaptic_weights;
+
+    /// Kernels rotated 180 degrees, with channels and kernels swapped, which convolve the deltas back to the inputs.
+
+    Tensor<type, 1> flipped_synaptic_weights;
+
+    ThreadPoolDevice* thread_pool_device = nullptr;
+
+    /// Backend chosen for each convolution shape by the autotuner.
+
+    static map<ConvolutionDimensions, Backend> tuned_backends;
+
+    static mutex tuned_backends_mutex;
+};
+
+}
+
+#endif
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
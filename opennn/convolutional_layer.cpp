@@ -99,7 +99,8 @@ void ConvolutionalLayer::insert_padding(const Tensor<type, 4>& inputs, Tensor<ty
 }
 
 
-/// Calculate convolutions
+/// Calculates the convolutions of the inputs with the kernels, plus the biases, with the convolution engine of the forward propagation.
+/// The padding and the strides are applied while reading the inputs, so they are not copied.
 
 void ConvolutionalLayer::calculate_convolutions(type* inputs_data,
                                                 LayerForwardPropagation* layer_forward_propagation) const
@@ -107,70 +108,12 @@ void ConvolutionalLayer::calculate_convolutions(type* inputs_data,
     ConvolutionalLayerForwardPropagation* convolutional_layer_forward_propagation
             = static_cast<ConvolutionalLayerForwardPropagation*>(layer_forward_propagation);
 
-    const Eigen::array<ptrdiff_t, 4> inputs_dimensions_array
-            = convolutional_layer_forward_propagation->get_inputs_dimensions_array();
-
     type* outputs_data = layer_forward_propagation->outputs(0).get_data();
 
-    type* synaptic_weights_pointer = const_cast<type*>(synaptic_weights.data());
-
-    type* biases_pointer = const_cast<type*>(biases.data());
-
-    TensorMap<Tensor<type, 4>> inputs(inputs_data, inputs_dimensions_array);
-
-    Tensor<type, 4>& preprocessed_inputs = convolutional_layer_forward_propagation->preprocessed_inputs;
-
-    const Index kernels_rows_number = get_kernels_rows_number();
-    const Index kernels_columns_number = get_kernels_columns_number();
-    const Index kernels_channels_number = get_kernels_channels_number();
-    const Index kernels_number = get_kernels_number();
-
-    const Index single_kernel_size = kernels_channels_number*kernels_rows_number*kernels_columns_number;
-
-    const Index batch_samples_number = layer_forward_propagation->batch_samples_number;
-    const Index outputs_rows_number = get_outputs_rows_number();
-    const Index outputs_columns_number = get_outputs_columns_number();
-    const Index single_output_size = batch_samples_number*outputs_rows_number*outputs_columns_number;
-
-    if(convolution_type == ConvolutionType::Same)
-    {
-        const Eigen::array<pair<Index, Index>, 4> paddings = get_paddings();
-
-        preprocessed_inputs = inputs.pad(paddings);
-    }
-    else
-    {
-        preprocessed_inputs = inputs;
-    }
-
-    if(row_stride != 1 || column_stride != 1)
-    {
-        const Eigen::array<ptrdiff_t, 4> strides = get_strides();
-
-        preprocessed_inputs.device(*thread_pool_device) = preprocessed_inputs.stride(strides);
-    }
-
-//    const Eigen::array<pair<Index, Index>, 4> paddings = get_paddings();
-//    const Eigen::array<ptrdiff_t, 4> strides = get_strides();
-
-//    preprocessed_inputs = inputs.pad(paddings).stride(strides);
-
-    for(Index kernel_index = 0; kernel_index < kernels_number; kernel_index++)
-    {
-        const TensorMap<Tensor<type, 3>> kernel(synaptic_weights_pointer + kernel_index*single_kernel_size,
-                                                kernels_rows_number,
-                                                kernels_columns_number,
-                                                kernels_channels_number);
-
-        TensorMap<Tensor<type, 4>> convolution(outputs_data + kernel_index*single_output_size,
-                                               batch_samples_number,
-                                               outputs_rows_number,
-                                               outputs_columns_number,
-                                               1);
-
-        convolution.device(*thread_pool_device) = preprocessed_inputs.convolve(kernel, convolutions_dimensions)
-                                                                     + biases_pointer[kernel_index];
-    }
+    convolutional_layer_forward_propagation->convolution_engine.calculate_convolutions(inputs_data,
+                                                                                       synaptic_weights.data(),
+                                                                                       biases.data(),
+                                                                                       outputs_data);
 }
 
 
@@ -392,6 +335,8 @@ void ConvolutionalLayer::calculate_hidden_delta(LayerForwardPropagation* next_la
                               next_convolutional_layer_back_propagation,
                               this_convolutional_layer_back_propagation);
     }
+        break;
+
     case Type::Flatten:
     {
 
@@ -419,23 +364,23 @@ void ConvolutionalLayer::calculate_hidden_delta(ConvolutionalLayerForwardPropaga
                                                 ConvolutionalLayerBackPropagation* next_convolutional_layer_back_propagation,
                                                 ConvolutionalLayerBackPropagation* this_convolutional_layer_back_propagation) const
 {
+    const ConvolutionalLayer* next_convolutional_layer_pointer
+            = static_cast<ConvolutionalLayer*>(next_convolutional_layer_forward_propagation->layer_pointer);
+
     const TensorMap<Tensor<type, 4>> next_deltas(next_convolutional_layer_back_propagation->deltas_data,
-                                                 next_convolutional_layer_back_propagation->deltas_dimensions(0),
-                                                 next_convolutional_layer_back_propagation->deltas_dimensions(1),
-                                                 next_convolutional_layer_back_propagation->deltas_dimensions(2),
-                                                 next_convolutional_layer_back_propagation->deltas_dimensions(3));
+                                                 next_convolutional_layer_back_propagation->get_deltas_dimensions_array());
 
+    Tensor<type, 4>& next_deltas_times_activations_derivatives
+            = next_convolutional_layer_back_propagation->deltas_times_activations_derivatives;
 
-    // (next deltas * activations derivatives) ¿convolve? kernels
+    next_deltas_times_activations_derivatives.device(*thread_pool_device)
+            = next_deltas * next_convolutional_layer_forward_propagation->activations_derivatives;
 
-    const Index kernels_number = get_kernels_number();
+    // The deltas are the next layer's deltas times activations derivatives, convolved back through its kernels
 
-    for(Index kernel_index = 0; kernel_index < kernels_number; kernel_index++)
-    {
-
-    }
-
-    next_deltas * next_convolutional_layer_forward_propagation->activations_derivatives;
+    next_convolutional_layer_back_propagation->convolution_engine.calculate_inputs_derivatives(next_deltas_times_activations_derivatives.data(),
+                                                                                               next_convolutional_layer_pointer->get_synaptic_weights().data(),
+                                                                                               this_convolutional_layer_back_propagation->deltas_data);
 }
 
 
@@ -468,99 +413,29 @@ void ConvolutionalLayer::calculate_error_gradient(type* input_data,
                                                   LayerForwardPropagation* forward_propagation,
                                                   LayerBackPropagation* back_propagation) const
 {
-    const Index batch_samples_number = back_propagation->batch_samples_number;   
-    const Index inputs_rows_number = get_inputs_rows_number();
-    const Index inputs_columns_number = get_inputs_columns_number();
-    const Index inputs_channels_number = get_inputs_channels_number();
-
-    const Index kernels_number = get_kernels_number(); 
-    const Index kernels_rows_number = get_kernels_rows_number();
-    const Index kernels_columns_number = get_kernels_columns_number();
-    const Index kernels_channels_number = get_kernels_channels_number();
-
-    const Index outputs_rows_number = get_outputs_rows_number();
-    const Index outputs_columns_number = get_outputs_columns_number();
-
     ConvolutionalLayerForwardPropagation* convolutional_layer_forward_propagation =
             static_cast<ConvolutionalLayerForwardPropagation*>(forward_propagation);
 
     ConvolutionalLayerBackPropagation* convolutional_layer_back_propagation =
             static_cast<ConvolutionalLayerBackPropagation*>(back_propagation);
 
-    const Eigen::array<ptrdiff_t, 4> inputs_dimensions_array = convolutional_layer_forward_propagation->get_inputs_dimensions_array();
-
-    const TensorMap<Tensor<type,4>> inputs(input_data, inputs_dimensions_array);
-
     type* deltas_data = convolutional_layer_back_propagation->deltas_data;
 
     const Eigen::array<ptrdiff_t, 4> deltas_dimensions_array = convolutional_layer_back_propagation->get_deltas_dimensions_array();
 
     const TensorMap<Tensor<type, 4>> deltas(deltas_data, deltas_dimensions_array);
 
-    convolutional_layer_back_propagation->deltas_times_activations_derivatives.device(*thread_pool_device)
-            = deltas * convolutional_layer_forward_propagation->activations_derivatives;
-
-    Eigen::array<Eigen::Index, 4> offsets;
-    Eigen::array<Eigen::Index, 4> extents;
-
-    // Synaptic weights derivatives
+    Tensor<type, 4>& deltas_times_activations_derivatives = convolutional_layer_back_propagation->deltas_times_activations_derivatives;
 
-    const Eigen::array<ptrdiff_t, 3> convolutions_dimensions = {0, 1, 2};
-
-    Tensor<type, 4> delta_slice;
-    Tensor<type, 4> image_slice;
-
-    type* synaptic_weights_derivatives_data = convolutional_layer_back_propagation->synaptic_weights_derivatives.data();
-
-    const Index kernel_synaptic_weights_number = kernels_channels_number*kernels_rows_number*kernels_columns_number;
-
-    for(Index kernel_index = 0; kernel_index < kernels_number; kernel_index++)
-    {
-        TensorMap<Tensor<type, 3>> kernel_synaptic_weights_derivatives(synaptic_weights_derivatives_data + kernel_index*kernel_synaptic_weights_number,
-                                                                       kernels_rows_number,
-                                                                       kernels_columns_number,
-                                                                       kernels_channels_number);
+    deltas_times_activations_derivatives.device(*thread_pool_device)
+            = deltas * convolutional_layer_forward_propagation->activations_derivatives;
 
-        for(Index image_index = 0; image_index < batch_samples_number; image_index++)
-        {
-            offsets = {image_index, 0, 0, kernel_index};
-            extents = {1, outputs_rows_number, outputs_columns_number, 1};
-
-            delta_slice = convolutional_layer_back_propagation->deltas_times_activations_derivatives.slice(offsets, extents);
-
-            offsets = {image_index, 0, 0, 0};
-            extents = {1, inputs_rows_number, inputs_columns_number, inputs_channels_number};
-
-            image_slice = inputs.slice(offsets, extents);
-
-            const TensorMap<Tensor<type, 3>> image(image_slice.data(),
-                                                   inputs_rows_number,
-                                                   inputs_columns_number,
-                                                   inputs_channels_number);
-
-            const TensorMap<Tensor<type, 3>> delta_reshape(delta_slice.data(),
-                                                           outputs_rows_number,
-                                                           outputs_columns_number,
-                                                           1);
-
-            const Tensor<type, 0> current_sum = delta_slice.sum();
-
-            if(image_index == 0)
-            {
-                kernel_synaptic_weights_derivatives = image.convolve(delta_reshape, convolutions_dimensions);
-                convolutional_layer_back_propagation->biases_derivatives(kernel_index) = current_sum();
-            }
-            else
-            {
-                kernel_synaptic_weights_derivatives += image.convolve(delta_reshape, convolutions_dimensions);
-                convolutional_layer_back_propagation->biases_derivatives(kernel_index) += current_sum();
-            }
-        }
+    // Synaptic weights and biases derivatives
 
-        memcpy(synaptic_weights_derivatives_data + kernel_synaptic_weights_number*kernel_index,
-               kernel_synaptic_weights_derivatives.data(),
-               static_cast<size_t>(kernel_synaptic_weights_number)*sizeof(type));
-    }
+    convolutional_layer_back_propagation->convolution_engine.calculate_synaptic_weights_derivatives(input_data,
+                                                                                                    deltas_times_activations_derivatives.data(),
+                                                                                                    convolutional_layer_back_propagation->synaptic_weights_derivatives.data(),
+                                                                                                    convolutional_layer_back_propagation->biases_derivatives.data());
 }
 
 
@@ -717,6 +592,52 @@ string ConvolutionalLayer::write_convolution_type() const
 }
 
 
+/// Returns the backend that computes the convolutions.
+
+const ConvolutionEngine::Backend& ConvolutionalLayer::get_convolution_backend() const
+{
+    return convolution_backend;
+}
+
+
+/// Returns a string with the name of the convolution backend.
+/// This can be Automatic, Im2col, Winograd and Direct.
+
+string ConvolutionalLayer::write_convolution_backend() const
+{
+    return ConvolutionEngine::write_backend(convolution_backend);
+}
+
+
+/// Returns the shape of the convolutions of this layer for a batch.
+/// @param batch_samples_number Number of samples in the batch.
+
+ConvolutionDimensions ConvolutionalLayer::get_convolution_dimensions(const Index& batch_samples_number) const
+{
+    ConvolutionDimensions convolution_dimensions;
+
+    convolution_dimensions.batch_samples_number = batch_samples_number;
+
+    convolution_dimensions.inputs_rows_number = get_inputs_rows_number();
+    convolution_dimensions.inputs_columns_number = get_inputs_columns_number();
+    convolution_dimensions.inputs_channels_number = get_inputs_channels_number();
+
+    convolution_dimensions.kernels_rows_number = get_kernels_rows_number();
+    convolution_dimensions.kernels_columns_number = get_kernels_columns_number();
+    convolution_dimensions.kernels_number = get_kernels_number();
+
+    convolution_dimensions.row_stride = row_stride;
+    convolution_dimensions.column_stride = column_stride;
+
+    const pair<Index, Index> padding = get_padding();
+
+    convolution_dimensions.padding_rows = padding.first;
+    convolution_dimensions.padding_columns = padding.second;
+
+    return convolution_dimensions;
+}
+
+
 /// Returns the column stride.
 
 Index ConvolutionalLayer::get_column_stride() const
@@ -1090,6 +1011,51 @@ void ConvolutionalLayer::set_convolution_type(const string& new_convolution_type
     }
 }
 
+
+/// Sets the backend that computes the convolutions.
+/// Backends that do not apply to the layer shape are rejected when the propagation structures are set.
+/// @param new_convolution_backend Convolution backend.
+
+void ConvolutionalLayer::set_convolution_backend(const ConvolutionEngine::Backend& new_convolution_backend)
+{
+    convolution_backend = new_convolution_backend;
+}
+
+
+/// Sets the backend that computes the convolutions from its name.
+/// @param new_convolution_backend Automatic, Im2col, Winograd or Direct.
+
+void ConvolutionalLayer::set_convolution_backend(const string& new_convolution_backend)
+{
+    if(new_convolution_backend == "Automatic")
+    {
+        convolution_backend = ConvolutionEngine::Backend::Automatic;
+    }
+    else if(new_convolution_backend == "Im2col")
+    {
+        convolution_backend = ConvolutionEngine::Backend::Im2col;
+    }
+    else if(new_convolution_backend == "Winograd")
+    {
+        convolution_backend = ConvolutionEngine::Backend::Winograd;
+    }
+    else if(new_convolution_backend == "Direct")
+    {
+        convolution_backend = ConvolutionEngine::Backend::Direct;
+    }
+    else
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: ConvolutionalLayer class.\n"
+               << "void set_convolution_backend(const string&) method.\n"
+               << "Unknown convolution backend: " << new_convolution_backend << ".\n";
+
+        throw invalid_argument(buffer.str());
+    }
+}
+
+
 /// Sets the kernels' row stride.
 /// @param new_stride_row The desired row stride.
 
@@ -24,6 +24,7 @@
 
 #include "layer.h"
 #include "config.h"
+#include "convolution_engine.h"
 #include "flatten_layer.h"
 #include "pooling_layer.h"
 
@@ -100,6 +101,11 @@ public:
     ConvolutionType get_convolution_type() const;
     string write_convolution_type() const;
 
+    const ConvolutionEngine::Backend& get_convolution_backend() const;
+    string write_convolution_backend() const;
+
+    ConvolutionDimensions get_convolution_dimensions(const Index&) const;
+
     Index get_column_stride() const;
 
     Index get_row_stride() const;
@@ -140,6 +146,9 @@ public:
     void set_convolution_type(const ConvolutionType&);
     void set_convolution_type(const string&);
 
+    void set_convolution_backend(const ConvolutionEngine::Backend&);
+    void set_convolution_backend(const string&);
+
     void set_parameters(const Tensor<type, 1>&, const Index& index = 0);
 
     void set_row_stride(const Index&);
@@ -230,6 +239,11 @@ protected:
 
    ConvolutionType convolution_type = ConvolutionType::Valid;
 
+   /// Backend that computes the convolutions and their derivatives.
+   /// The automatic backend times the applicable ones on the first batch of each shape and keeps the fastest.
+
+   ConvolutionEngine::Backend convolution_backend = ConvolutionEngine::Backend::Automatic;
+
    ActivationFunction activation_function = ActivationFunction::Linear;
 
    const Eigen::array<ptrdiff_t, 3> convolutions_dimensions = {1, 2, 3};
@@ -331,19 +345,12 @@ struct ConvolutionalLayerForwardPropagation : LayerForwardPropagation
 
        const ConvolutionalLayer* convolutional_layer_pointer = static_cast<ConvolutionalLayer*>(layer_pointer);
 
-       const Index inputs_rows_number = convolutional_layer_pointer->get_inputs_rows_number();
-       const Index inputs_columns_number = convolutional_layer_pointer->get_inputs_columns_number();
-
-       const Index inputs_channels_number = convolutional_layer_pointer->get_inputs_channels_number();
-
        const Index kernels_number = convolutional_layer_pointer->get_kernels_number();
        const Index outputs_rows_number = convolutional_layer_pointer->get_outputs_rows_number();
        const Index outputs_columns_number = convolutional_layer_pointer->get_outputs_columns_number();
 
-       preprocessed_inputs.resize(batch_samples_number,
-                                  inputs_rows_number,
-                                  inputs_columns_number,
-                                  inputs_channels_number);
+       convolution_engine.set(convolutional_layer_pointer->get_convolution_dimensions(batch_samples_number),
+                              convolutional_layer_pointer->get_convolution_backend());
 
        outputs.resize(1);
        Tensor<Index, 1> output_dimensions(4);
@@ -363,6 +370,12 @@ struct ConvolutionalLayerForwardPropagation : LayerForwardPropagation
    }
 
 
+   void free_training_memory() final
+   {
+       activations_derivatives.resize(0, 0, 0, 0);
+   }
+
+
    void print() const
    {
        cout << "Convolutional" << endl;
@@ -378,7 +391,7 @@ struct ConvolutionalLayerForwardPropagation : LayerForwardPropagation
        cout << activations_derivatives << endl;
    }
 
-   Tensor<type, 4> preprocessed_inputs;
+   ConvolutionEngine convolution_engine;
 
    Tensor<type, 1> means;
    Tensor<type, 1> standard_deviations;
@@ -464,6 +477,9 @@ struct ConvolutionalLayerBackPropagation : LayerBackPropagation
                                            kernels_columns_number,
                                            kernels_channels_number,
                                            kernels_number);
+
+       convolution_engine.set(convolutional_layer_pointer->get_convolution_dimensions(batch_samples_number),
+                              convolutional_layer_pointer->get_convolution_backend());
    }
 
    void print() const
@@ -483,6 +499,8 @@ struct ConvolutionalLayerBackPropagation : LayerBackPropagation
 
    Tensor<type, 1> biases_derivatives;
    Tensor<type, 4> synaptic_weights_derivatives;
+
+   ConvolutionEngine convolution_engine;
 };
 
 
@@ -198,9 +198,7 @@ void CrossEntropyError::calculate_binary_output_delta(const DataSetBatch& batch,
             (static_cast<type>(-1)*(targets/outputs) + (static_cast<type>(1) - targets)/(static_cast<type>(1) - outputs));
 
 
-    Tensor<type, 2> output_deltas(deltas);
-
-    if(has_NAN(output_deltas))
+    if(has_NAN(deltas.data(), deltas.size()))
     {
         ostringstream buffer;
 
@@ -233,9 +231,7 @@ void CrossEntropyError::calculate_multiple_output_delta(const DataSetBatch& batc
 
     deltas.device(*thread_pool_device) = static_cast<type>(1)/static_cast<type>(batch_samples_number) *(-targets/outputs);
 
-    Tensor<type, 2> output_deltas(deltas);
-
-    if(has_NAN(output_deltas))
+    if(has_NAN(deltas.data(), deltas.size()))
     {
         ostringstream buffer;
 
@@ -0,0 +1,502 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   C S V   R E A D E R   C L A S S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "csv_reader.h"
+
+namespace opennn
+{
+
+/// Default constructor.
+/// It creates a reader without file.
+
+CsvReader::CsvReader()
+{
+}
+
+
+/// File constructor.
+/// It maps a file and splits its lines into chunks.
+/// @param new_file_name Name of the file.
+/// @param new_separator Separator between the tokens of a line.
+/// @param has_header True if the first non-empty line is a header, which is not read.
+
+CsvReader::CsvReader(const string& new_file_name, const char& new_separator, const bool& has_header)
+{
+    set(new_file_name, new_separator, has_header);
+}
+
+
+/// Destructor.
+
+CsvReader::~CsvReader()
+{
+}
+
+
+/// Returns the name of the mapped file.
+
+const string& CsvReader::get_file_name() const
+{
+    return mapped_file.get_file_name();
+}
+
+
+/// Returns the number of characters of the mapped file.
+
+Index CsvReader::get_file_size() const
+{
+    return file_size;
+}
+
+
+/// Returns the number of chunks into which the lines are split.
+
+Index CsvReader::get_chunks_number() const
+{
+    return Index(chunks_begins.size()) - 1;
+}
+
+
+/// Returns the number of non-empty lines after the header.
+/// The lines must have been counted.
+
+Index CsvReader::get_samples_number() const
+{
+    return chunks_samples_begins.empty() ? 0 : chunks_samples_begins.back();
+}
+
+
+/// Returns the number of non-empty lines before a chunk, which is the index of its first sample.
+/// The lines must have been counted.
+/// @param chunk_index Index of the chunk.
+
+Index CsvReader::get_chunk_samples_begin(const Index& chunk_index) const
+{
+    return chunks_samples_begins[size_t(chunk_index)];
+}
+
+
+/// Returns the last non-empty line after the header, trimmed, or an empty token if there is none.
+
+CsvReader::Token CsvReader::get_last_line() const
+{
+    const char* end = file_data + file_size;
+
+    while(end > lines_begin)
+    {
+        const char* begin = end;
+
+        while(begin > lines_begin && *(begin - 1) != '\n') begin--;
+
+        const Token line = trim({begin, end});
+
+        if(!line.empty()) return line;
+
+        end = begin - 1;
+    }
+
+    return Token();
+}
+
+
+/// Maps a file and splits its lines into as many chunks as suit the file size and the execution context.
+/// @param new_file_name Name of the file.
+/// @param new_separator Separator between the tokens of a line.
+/// @param has_header True if the first non-empty line is a header, which is not read.
+
+void CsvReader::set(const string& new_file_name, const char& new_separator, const bool& has_header)
+{
+    clear();
+
+    separator = new_separator;
+
+    mapped_file.open(new_file_name, MappedFile::Access::Sequential);
+
+    file_data = mapped_file.get_data();
+    file_size = mapped_file.get_size();
+
+    // Header
+
+    lines_begin = file_data;
+    header_lines_number = 0;
+
+    const char* end = file_data + file_size;
+
+    while(has_header && lines_begin < end)
+    {
+        const char* line_end = static_cast<const char*>(memchr(lines_begin, '\n', size_t(end - lines_begin)));
+
+        if(line_end == nullptr) line_end = end;
+
+        const bool is_empty = trim({lines_begin, line_end}).empty();
+
+        lines_begin = line_end == end ? end : line_end + 1;
+        header_lines_number++;
+
+        if(!is_empty) break;
+    }
+
+    // Chunks of at least one megabyte
+
+    const Index minimum_chunk_size = Index(1) << 20;
+
+    const Index maximum_chunks_number = Index(4*ExecutionContext::get_threads_number());
+
+    set_chunks_number(max(Index(1), min(maximum_chunks_number, Index(end - lines_begin)/minimum_chunk_size)));
+}
+
+
+/// Splits the lines after the header into a number of chunks of about the same size.
+/// Each chunk starts after a newline, so that no line is split.
+/// @param new_chunks_number Number of chunks.
+
+void CsvReader::set_chunks_number(const Index& new_chunks_number)
+{
+    if(new_chunks_number < 1)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: CsvReader class.\n"
+               << "void set_chunks_number(const Index&) method.\n"
+               << "Number of chunks (" << new_chunks_number << ") must be greater than zero.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    const char* end = file_data + file_size;
+
+    const Index lines_size = Index(end - lines_begin);
+
+    chunks_begins.resize(size_t(new_chunks_number + 1));
+
+    chunks_begins[0] = lines_begin;
+
+    for(Index i = 1; i < new_chunks_number; i++)
+    {
+        const char* chunk_begin = max(lines_begin + lines_size*i/new_chunks_number, chunks_begins[size_t(i - 1)]);
+
+        if(chunk_begin > lines_begin && chunk_begin < end && *(chunk_begin - 1) != '\n')
+        {
+            const char* newline = static_cast<const char*>(memchr(chunk_begin, '\n', size_t(end - chunk_begin)));
+
+            chunk_begin = newline == nullptr ? end : newline + 1;
+        }
+
+        chunks_begins[size_t(i)] = chunk_begin;
+    }
+
+    chunks_begins[size_t(new_chunks_number)] = end;
+
+    chunks_lines_begins.clear();
+    chunks_samples_begins.clear();
+}
+
+
+/// Counts the lines and the non-empty lines of each chunk, concurrently.
+/// It must be called before reading the lines.
+
+void CsvReader::count_samples()
+{
+    const Index chunks_number = get_chunks_number();
+
+    vector<Index> chunks_lines_numbers(size_t(chunks_number), 0);
+    vector<Index> chunks_samples_numbers(size_t(chunks_number), 0);
+
+    ExecutionContext::run_concurrently(chunks_number, [&](const Index& chunk_index)
+    {
+        const char* line_begin = chunks_begins[size_t(chunk_index)];
+        const char* chunk_end = chunks_begins[size_t(chunk_index + 1)];
+
+        Index lines_number = 0;
+        Index samples_number = 0;
+
+        while(line_begin < chunk_end)
+        {
+            const char* line_end = static_cast<const char*>(memchr(line_begin, '\n', size_t(chunk_end - line_begin)));
+
+            if(line_end == nullptr) line_end = chunk_end;
+
+            lines_number++;
+
+            if(!trim({line_begin, line_end}).empty()) samples_number++;
+
+            line_begin = line_end + 1;
+        }
+
+        chunks_lines_numbers[size_t(chunk_index)] = lines_number;
+        chunks_samples_numbers[size_t(chunk_index)] = samples_number;
+    });
+
+    chunks_lines_begins.resize(size_t(chunks_number + 1));
+    chunks_samples_begins.resize(size_t(chunks_number + 1));
+
+    chunks_lines_begins[0] = header_lines_number;
+    chunks_samples_begins[0] = 0;
+
+    for(Index i = 0; i < chunks_number; i++)
+    {
+        chunks_lines_begins[size_t(i + 1)] = chunks_lines_begins[size_t(i)] + chunks_lines_numbers[size_t(i)];
+        chunks_samples_begins[size_t(i + 1)] = chunks_samples_begins[size_t(i)] + chunks_samples_numbers[size_t(i)];
+    }
+}
+
+
+/// Calls a function for each non-empty line after the header, reading the chunks concurrently.
+/// The lines of a chunk are visited in order by the same task.
+/// @param line_function Function which takes the index of the chunk, the number of the line in the file,
+/// starting at one, and the line without leading and trailing whitespace.
+
+void CsvReader::read_lines(const function<void(const Index&, const Index&, const Token&)>& line_function) const
+{
+    if(chunks_lines_begins.empty())
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: CsvReader class.\n"
+               << "void read_lines(const function<void(const Index&, const Index&, const Token&)>&) const method.\n"
+               << "Lines must be counted before reading them.\n";
+
+        throw logic_error(buffer.str());
+    }
+
+    ExecutionContext::run_concurrently(get_chunks_number(), [&](const Index& chunk_index)
+    {
+        const char* line_begin = chunks_begins[size_t(chunk_index)];
+        const char* chunk_end = chunks_begins[size_t(chunk_index + 1)];
+
+        Index line_number = chunks_lines_begins[size_t(chunk_index)];
+
+        while(line_begin < chunk_end)
+        {
+            const char* line_end = static_cast<const char*>(memchr(line_begin, '\n', size_t(chunk_end - line_begin)));
+
+            if(line_end == nullptr) line_end = chunk_end;
+
+            line_number++;
+
+            const Token line = trim({line_begin, line_end});
+
+            if(!line.empty()) line_function(chunk_index, line_number, line);
+
+            line_begin = line_end + 1;
+        }
+    });
+}
+
+
+/// Splits a line into tokens without leading and trailing whitespace.
+/// It returns false, leaving the tokens undefined, for lines which need the general tokenizer:
+/// lines with quotes, empty tokens, or separators at the beginning or the end.
+/// @param line Line without leading and trailing whitespace.
+/// @param separator Separator between tokens.
+/// @param tokens Tokens of the line.
+
+bool CsvReader::split_tokens(const Token& line, const char& separator, vector<Token>& tokens)
+{
+    tokens.clear();
+
+    if(line.empty() || memchr(line.begin, '"', size_t(line.size())) != nullptr) return false;
+
+    const char* token_begin = line.begin;
+
+    while(true)
+    {
+        const char* token_end = static_cast<const char*>(memchr(token_begin, separator, size_t(line.end - token_begin)));
+
+        if(token_end == nullptr) token_end = line.end;
+
+        const Token token = trim({token_begin, token_end});
+
+        if(token.empty()) return false;
+
+        tokens.push_back(token);
+
+        if(token_end == line.end) return true;
+
+        token_begin = token_end + 1;
+    }
+}
+
+
+/// Converts a token to a number, if the whole token is a decimal number with optional sign, point and exponent.
+/// Numbers with up to 15 significant digits and small exponents are converted exactly without copies.
+/// The rest are converted by the standard library.
+/// @param token Token without leading and trailing whitespace.
+/// @param value Number of the token.
+
+bool CsvReader::parse_number(const Token& token, type& value)
+{
+    const char* character = token.begin;
+    const char* end = token.end;
+
+    bool is_negative = false;
+
+    if(character != end && (*character == '-' || *character == '+'))
+    {
+        is_negative = *character == '-';
+        character++;
+    }
+
+    unsigned long long mantissa = 0;
+    Index digits_number = 0;
+    Index exponent = 0;
+    bool has_digits = false;
+
+    for(; character != end && *character >= '0' && *character <= '9'; character++)
+    {
+        has_digits = true;
+
+        if(mantissa == 0 && *character == '0') continue;
+
+        if(digits_number < 19)
+        {
+            mantissa = 10*mantissa + static_cast<unsigned long long>(*character - '0');
+            digits_number++;
+        }
+        else
+        {
+            exponent++;
+        }
+    }
+
+    if(character != end && *character == '.')
+    {
+        character++;
+
+        for(; character != end && *character >= '0' && *character <= '9'; character++)
+        {
+            has_digits = true;
+
+            if(mantissa == 0 && *character == '0')
+            {
+                exponent--;
+                continue;
+            }
+
+            if(digits_number < 19)
+            {
+                mantissa = 10*mantissa + static_cast<unsigned long long>(*character - '0');
+                digits_number++;
+                exponent--;
+            }
+        }
+    }
+
+    if(!has_digits) return false;
+
+    if(character != end && (*character == 'e' || *character == 'E'))
+    {
+        character++;
+
+        bool is_negative_exponent = false;
+
+        if(character != end && (*character == '-' || *character == '+'))
+        {
+            is_negative_exponent = *character == '-';
+            character++;
+        }
+
+        if(character == end) return false;
+
+        Index exponent_value = 0;
+
+        for(; character != end && *character >= '0' && *character <= '9'; character++)
+        {
+            if(exponent_value < 100000) exponent_value = 10*exponent_value + (*character - '0');
+        }
+
+        exponent += is_negative_exponent ? -exponent_value : exponent_value;
+    }
+
+    if(character != end) return false;
+
+    static const double powers_of_ten[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                           1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    if(mantissa == 0)
+    {
+        value = is_negative ? -type(0) : type(0);
+    }
+    else if(mantissa < (1ull << 53) && exponent >= -22 && exponent <= 22)
+    {
+        // Both the mantissa and the power of ten are exact doubles, so the result is correctly rounded
+
+        const double number = exponent < 0
+                ? double(mantissa)/powers_of_ten[-exponent]
+                : double(mantissa)*powers_of_ten[exponent];
+
+        value = type(is_negative ? -number : number);
+    }
+    else
+    {
+        value = type(strtod(token.to_string().c_str(), nullptr));
+    }
+
+    return true;
+}
+
+
+/// Unmaps the file, if any, and removes the chunks.
+
+void CsvReader::clear()
+{
+    mapped_file.close();
+
+    file_data = nullptr;
+    file_size = 0;
+
+    lines_begin = nullptr;
+
+    chunks_begins.clear();
+    chunks_lines_begins.clear();
+    chunks_samples_begins.clear();
+}
+
+
+/// Returns true for the characters which are trimmed from lines and tokens.
+
+bool CsvReader::is_space(const char& character)
+{
+    return character == ' ' || character == '\t' || character == '\r' || character == '\n'
+        || character == '\f' || character == '\v' || character == '\b';
+}
+
+
+/// Returns a range without leading and trailing whitespace.
+
+CsvReader::Token CsvReader::trim(const Token& token)
+{
+    const char* begin = token.begin;
+    const char* end = token.end;
+
+    while(begin < end && is_space(*begin)) begin++;
+    while(end > begin && is_space(*(end - 1))) end--;
+
+    return {begin, end};
+}
+
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -0,0 +1,176 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   C S V   R E A D E R   C L A S S   H E A D E R
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#ifndef CSVREADER_H
+#define CSVREADER_H
+
+// System includes
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+// OpenNN includes
+
+#include "config.h"
+#include "execution_context.h"
+#include "mapped_file.h"
+
+namespace opennn
+{
+
+/// This class reads delimited text files through a memory mapping of the whole file.
+/// The lines after the header are split into chunks which start and end at line boundaries,
+/// so that the chunks are read concurrently, each by a task of the execution context.
+/// Lines are passed to the callers as ranges of characters of the mapping, without copies.
+
+class CsvReader
+{
+
+public:
+
+    /// Range of characters of the mapped file.
+
+    struct Token
+    {
+        const char* begin = nullptr;
+        const char* end = nullptr;
+
+        Index size() const
+        {
+            return Index(end - begin);
+        }
+
+        bool empty() const
+        {
+            return begin == end;
+        }
+
+        bool operator==(const string& other) const
+        {
+            return size() == Index(other.size()) && equal(begin, end, other.data());
+        }
+
+        string to_string() const
+        {
+            return string(begin, end);
+        }
+    };
+
+    // Constructors
+
+    explicit CsvReader();
+
+    explicit CsvReader(const string&, const char&, const bool&);
+
+    // Destructor
+
+    virtual ~CsvReader();
+
+    // Get methods
+
+    const string& get_file_name() const;
+
+    Index get_file_size() const;
+
+    Index get_chunks_number() const;
+
+    Index get_samples_number() const;
+
+    Index get_chunk_samples_begin(const Index&) const;
+
+    Token get_last_line() const;
+
+    // Set methods
+
+    void set(const string&, const char&, const bool&);
+
+    void set_chunks_number(const Index&);
+
+    // Reading methods
+
+    void count_samples();
+
+    void read_lines(const function<void(const Index&, const Index&, const Token&)>&) const;
+
+    static bool split_tokens(const Token&, const char&, vector<Token>&);
+
+    static bool parse_number(const Token&, type&);
+
+private:
+
+    void clear();
+
+    static bool is_space(const char&);
+
+    static Token trim(const Token&);
+
+    /// Mapping of the file.
+
+    MappedFile mapped_file;
+
+    /// Separator between the tokens of a line.
+
+    char separator = ',';
+
+    /// First character of the mapping, or null for empty files.
+
+    const char* file_data = nullptr;
+
+    /// Number of characters of the file.
+
+    Index file_size = 0;
+
+    /// Beginning of the first line after the header.
+
+    const char* lines_begin = nullptr;
+
+    /// Number of lines, empty or not, before lines_begin.
+
+    Index header_lines_number = 0;
+
+    /// Beginning of each chunk, and end of the last one.
+
+    vector<const char*> chunks_begins;
+
+    /// Number of lines, empty or not, before each chunk.
+
+    vector<Index> chunks_lines_begins;
+
+    /// Number of non-empty lines before each chunk, and total number of non-empty lines.
+
+    vector<Index> chunks_samples_begins;
+};
+
+}
+
+#endif
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -0,0 +1,587 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   D A T A   P A R A L L E L   C L A S S E S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "data_parallel.h"
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <cerrno>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace opennn
+{
+
+/// Constructor.
+/// It creates the transport of a rank within a ring.
+/// @param new_rank Number of this process, from 0 to the number of ranks minus 1.
+/// @param new_ranks_number Number of processes of the ring.
+
+Transport::Transport(const Index& new_rank, const Index& new_ranks_number)
+{
+    if(new_ranks_number < 1 || new_rank < 0 || new_rank >= new_ranks_number)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: Transport class.\n"
+               << "Transport(const Index&, const Index&) constructor.\n"
+               << "Rank (" << new_rank << ") must be between 0 and the number of ranks (" << new_ranks_number << ") minus 1.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    rank = new_rank;
+    ranks_number = new_ranks_number;
+}
+
+
+/// Destructor.
+
+Transport::~Transport()
+{
+}
+
+
+/// Returns the number of this process within the ring.
+
+const Index& Transport::get_rank() const
+{
+    return rank;
+}
+
+
+/// Returns the number of processes of the ring.
+
+const Index& Transport::get_ranks_number() const
+{
+    return ranks_number;
+}
+
+
+/// Returns the rank to which this rank sends.
+
+Index Transport::get_next_rank() const
+{
+    return (rank + 1)%ranks_number;
+}
+
+
+/// Returns the rank from which this rank receives.
+
+Index Transport::get_previous_rank() const
+{
+    return (rank + ranks_number - 1)%ranks_number;
+}
+
+
+#ifndef _WIN32
+
+/// Fills the socket address on which a rank listens.
+/// @param family Socket family.
+/// @param address Prefix of the socket files for Unix sockets, or host:port of rank 0 for TCP sockets.
+/// @param rank Rank which listens on the address.
+/// @param socket_address Socket address.
+/// Returns the length of the socket address.
+
+socklen_t set_socket_address(const SocketTransport::Family& family,
+                             const string& address,
+                             const Index& rank,
+                             sockaddr_storage& socket_address)
+{
+    memset(&socket_address, 0, sizeof(socket_address));
+
+    if(family == SocketTransport::Family::Unix)
+    {
+        sockaddr_un* unix_address = reinterpret_cast<sockaddr_un*>(&socket_address);
+
+        const string path = address + "_" + to_string(rank);
+
+        if(path.size() >= sizeof(unix_address->sun_path))
+        {
+            ostringstream buffer;
+
+            buffer << "OpenNN Exception: SocketTransport class.\n"
+                   << "socklen_t set_socket_address(const Family&, const string&, const Index&, sockaddr_storage&) method.\n"
+                   << "Socket path is too long: " << path << "\n";
+
+            throw invalid_argument(buffer.str());
+        }
+
+        unix_address->sun_family = AF_UNIX;
+
+        strcpy(unix_address->sun_path, path.c_str());
+
+        return socklen_t(sizeof(sockaddr_un));
+    }
+
+    const size_t separator_position = address.rfind(':');
+
+    string host = separator_position == string::npos ? string("127.0.0.1") : address.substr(0, separator_position);
+
+    if(host == "localhost") host = "127.0.0.1";
+
+    const int port = separator_position == string::npos
+            ? atoi(address.c_str())
+            : atoi(address.substr(separator_position + 1).c_str());
+
+    sockaddr_in* internet_address = reinterpret_cast<sockaddr_in*>(&socket_address);
+
+    internet_address->sin_family = AF_INET;
+    internet_address->sin_port = htons(uint16_t(port + int(rank)));
+
+    if(port <= 0 || inet_pton(AF_INET, host.c_str(), &internet_address->sin_addr) != 1)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: SocketTransport class.\n"
+               << "socklen_t set_socket_address(const Family&, const string&, const Index&, sockaddr_storage&) method.\n"
+               << "Address must be of the form host:port with a numeric IPv4 host: " << address << "\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    return socklen_t(sizeof(sockaddr_in));
+}
+
+#endif
+
+
+/// Constructor.
+/// It connects this rank with the previous and the next ranks of the ring.
+/// All the ranks must be created with the same number of ranks, family and address.
+/// With a single rank there is nothing to connect.
+/// @param new_rank Number of this process.
+/// @param new_ranks_number Number of processes of the ring.
+/// @param new_family Socket family.
+/// @param address Prefix of the socket files for Unix sockets, or host:port of rank 0 for TCP sockets.
+/// @param timeout Seconds to wait for the other ranks.
+
+SocketTransport::SocketTransport(const Index& new_rank,
+                                 const Index& new_ranks_number,
+                                 const Family& new_family,
+                                 const string& address,
+                                 const type& timeout)
+    : Transport(new_rank, new_ranks_number), family(new_family)
+{
+    if(ranks_number > 1) connect_ring(address, timeout);
+}
+
+
+/// Destructor.
+/// It closes the connections.
+
+SocketTransport::~SocketTransport()
+{
+    close();
+}
+
+
+/// Returns the socket family.
+
+const SocketTransport::Family& SocketTransport::get_family() const
+{
+    return family;
+}
+
+
+/// Listens on the address of this rank, connects to the next rank and accepts the connection of the previous rank.
+/// The connections to ranks which are not listening yet are retried until the timeout.
+/// @param address Prefix of the socket files for Unix sockets, or host:port of rank 0 for TCP sockets.
+/// @param timeout Seconds to wait for the other ranks.
+
+void SocketTransport::connect_ring(const string& address, const type& timeout)
+{
+    ostringstream buffer;
+
+#ifdef _WIN32
+
+    buffer << "OpenNN Exception: SocketTransport class.\n"
+           << "void connect_ring(const string&, const type&) method.\n"
+           << "Socket transport is not available on Windows.\n";
+
+    throw invalid_argument(buffer.str());
+
+#else
+
+    const int domain = family == Family::Unix ? AF_UNIX : AF_INET;
+
+    sockaddr_storage listening_address;
+    sockaddr_storage next_address;
+
+    const socklen_t listening_address_length = set_socket_address(family, address, rank, listening_address);
+    const socklen_t next_address_length = set_socket_address(family, address, get_next_rank(), next_address);
+
+    // Listen
+
+    const int listening_socket = socket(domain, SOCK_STREAM, 0);
+
+    if(family == Family::Unix)
+    {
+        unlink(reinterpret_cast<sockaddr_un*>(&listening_address)->sun_path);
+    }
+    else
+    {
+        const int reuse_address = 1;
+
+        setsockopt(listening_socket, SOL_SOCKET, SO_REUSEADDR, &reuse_address, sizeof(reuse_address));
+    }
+
+    if(listening_socket == -1
+    || ::bind(listening_socket, reinterpret_cast<sockaddr*>(&listening_address), listening_address_length) != 0
+    || listen(listening_socket, 1) != 0)
+    {
+        if(listening_socket != -1) ::close(listening_socket);
+
+        buffer << "OpenNN Exception: SocketTransport class.\n"
+               << "void connect_ring(const string&, const type&) method.\n"
+               << "Rank " << rank << " cannot listen on " << address << ": " << strerror(errno) << "\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    // Connect to the next rank, which might not be listening yet
+
+    const auto beginning_time = chrono::steady_clock::now();
+
+    const auto elapsed_seconds = [&]()
+    {
+        return type(chrono::duration<double>(chrono::steady_clock::now() - beginning_time).count());
+    };
+
+    while(true)
+    {
+        next_socket = socket(domain, SOCK_STREAM, 0);
+
+        if(next_socket != -1
+        && connect(next_socket, reinterpret_cast<sockaddr*>(&next_address), next_address_length) == 0)
+        {
+            break;
+        }
+
+        if(next_socket != -1) ::close(next_socket);
+
+        next_socket = -1;
+
+        if(elapsed_seconds() > timeout) break;
+
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+
+    // Accept the previous rank
+
+    if(next_socket != -1)
+    {
+        pollfd listening_poll = {listening_socket, POLLIN, 0};
+
+        const int remaining_milliseconds = int(max(type(0), timeout - elapsed_seconds())*type(1000));
+
+        if(poll(&listening_poll, 1, remaining_milliseconds) == 1)
+        {
+            previous_socket = accept(listening_socket, nullptr, nullptr);
+        }
+    }
+
+    ::close(listening_socket);
+
+    if(family == Family::Unix) unlink(reinterpret_cast<sockaddr_un*>(&listening_address)->sun_path);
+
+    if(next_socket == -1 || previous_socket == -1)
+    {
+        close();
+
+        buffer << "OpenNN Exception: SocketTransport class.\n"
+               << "void connect_ring(const string&, const type&) method.\n"
+               << "Rank " << rank << " cannot connect with ranks " << get_previous_rank() << " and " << get_next_rank()
+               << " in " << timeout << " seconds.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    if(family == Family::TCP)
+    {
+        const int no_delay = 1;
+
+        setsockopt(next_socket, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+        setsockopt(previous_socket, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+    }
+
+#endif
+}
+
+
+/// Closes the connections with the previous and the next ranks.
+
+void SocketTransport::close()
+{
+#ifndef _WIN32
+
+    if(next_socket != -1) ::close(next_socket);
+    if(previous_socket != -1) ::close(previous_socket);
+
+#endif
+
+    next_socket = -1;
+    previous_socket = -1;
+}
+
+
+/// Sends bytes to the next rank while it receives bytes from the previous rank.
+/// The sockets are polled so that the transfers in both directions progress at the same time,
+/// even when the messages are larger than the buffers of the sockets.
+/// @param sent_data Pointer to the bytes sent to the next rank.
+/// @param sent_bytes_number Number of bytes sent.
+/// @param received_data Pointer to the bytes received from the previous rank.
+/// @param received_bytes_number Number of bytes received.
+
+void SocketTransport::exchange(const char* sent_data,
+                               const Index& sent_bytes_number,
+                               char* received_data,
+                               const Index& received_bytes_number)
+{
+#ifndef _WIN32
+
+#ifdef MSG_NOSIGNAL
+    const int send_flags = MSG_DONTWAIT | MSG_NOSIGNAL;
+#else
+    const int send_flags = MSG_DONTWAIT;
+#endif
+
+    Index sent_count = 0;
+    Index received_count = 0;
+
+    while(sent_count < sent_bytes_number || received_count < received_bytes_number)
+    {
+        pollfd sockets_polls[2];
+
+        nfds_t polls_number = 0;
+
+        if(sent_count < sent_bytes_number) sockets_polls[polls_number++] = {next_socket, POLLOUT, 0};
+
+        if(received_count < received_bytes_number) sockets_polls[polls_number++] = {previous_socket, POLLIN, 0};
+
+        if(poll(sockets_polls, polls_number, -1) < 0)
+        {
+            if(errno == EINTR) continue;
+
+            break;
+        }
+
+        for(nfds_t i = 0; i < polls_number; i++)
+        {
+            if(sockets_polls[i].revents == 0) continue;
+
+            ssize_t bytes_number;
+
+            if(sockets_polls[i].fd == next_socket)
+            {
+                bytes_number = send(next_socket, sent_data + sent_count, size_t(sent_bytes_number - sent_count), send_flags);
+
+                if(bytes_number > 0) sent_count += Index(bytes_number);
+            }
+            else
+            {
+                bytes_number = recv(previous_socket, received_data + received_count, size_t(received_bytes_number - received_count), MSG_DONTWAIT);
+
+                if(bytes_number > 0) received_count += Index(bytes_number);
+
+                // A closed connection reads 0 bytes
+
+                if(bytes_number == 0) errno = ECONNRESET;
+            }
+
+            if(bytes_number <= 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            {
+                ostringstream buffer;
+
+                buffer << "OpenNN Exception: SocketTransport class.\n"
+                       << "void exchange(const char*, const Index&, char*, const Index&) method.\n"
+                       << "Rank " << rank << " lost the connection with the ring: " << strerror(errno) << "\n";
+
+                throw invalid_argument(buffer.str());
+            }
+        }
+    }
+
+#endif
+}
+
+
+/// Constructor.
+/// It creates a communicator over a transport, which must outlive it.
+/// @param new_transport_pointer Pointer to the transport between the ranks.
+
+Communicator::Communicator(Transport* new_transport_pointer)
+    : transport_pointer(new_transport_pointer)
+{
+}
+
+
+/// Returns the transport between the ranks.
+
+Transport* Communicator::get_transport_pointer() const
+{
+    return transport_pointer;
+}
+
+
+/// Returns the number of this process within the ring.
+
+const Index& Communicator::get_rank() const
+{
+    return transport_pointer->get_rank();
+}
+
+
+/// Returns the number of processes of the ring.
+
+const Index& Communicator::get_ranks_number() const
+{
+    return transport_pointer->get_ranks_number();
+}
+
+
+/// Returns the samples of this rank, a contiguous block of the samples of the same size for every rank.
+/// The samples which do not fill a block for each rank are left out, so that all the ranks train the same number of batches.
+/// @param samples_indices Indices of the samples, which must be the same on all the ranks.
+
+Tensor<Index, 1> Communicator::get_shard(const Tensor<Index, 1>& samples_indices) const
+{
+    const Index ranks_number = get_ranks_number();
+
+    const Index shard_samples_number = samples_indices.size()/ranks_number;
+
+    if(samples_indices.size() > 0 && shard_samples_number == 0)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: Communicator class.\n"
+               << "Tensor<Index, 1> get_shard(const Tensor<Index, 1>&) const method.\n"
+               << "Number of samples (" << samples_indices.size() << ") is less than the number of ranks (" << ranks_number << ").\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    const Tensor<Index, 1> shard = samples_indices.slice(Eigen::array<Index, 1>({get_rank()*shard_samples_number}),
+                                                         Eigen::array<Index, 1>({shard_samples_number}));
+
+    return shard;
+}
+
+
+/// Replaces a vector by the sum of the vectors of all the ranks, with a ring all-reduce.
+/// In the reduce-scatter, each rank sends a chunk to the next rank and adds the chunk it receives to its own one,
+/// so that after the number of ranks minus 1 steps each rank holds one chunk summed over all the ranks.
+/// In the all-gather, the summed chunks travel along the ring and overwrite the chunks of the other ranks.
+/// @param vector Vector of this rank, which must have the same size on all the ranks.
+
+void Communicator::all_reduce_sum(Tensor<type, 1>& vector)
+{
+    const Index ranks_number = get_ranks_number();
+
+    if(ranks_number == 1) return;
+
+    const Index rank = get_rank();
+
+    const Index size = vector.size();
+
+    type* vector_data = vector.data();
+
+    const auto chunk_begin = [&](const Index& chunk)
+    {
+        return (chunk*size)/ranks_number;
+    };
+
+    const auto chunk_size = [&](const Index& chunk)
+    {
+        return chunk_begin(chunk + 1) - chunk_begin(chunk);
+    };
+
+    if(received_chunk.size() != size/ranks_number + 1) received_chunk.resize(size/ranks_number + 1);
+
+    // Reduce-scatter
+
+    for(Index step = 0; step < ranks_number - 1; step++)
+    {
+        const Index sent_chunk = (rank - step + ranks_number)%ranks_number;
+        const Index reduced_chunk = (rank - step - 1 + 2*ranks_number)%ranks_number;
+
+        transport_pointer->exchange(reinterpret_cast<const char*>(vector_data + chunk_begin(sent_chunk)),
+                                    chunk_size(sent_chunk)*Index(sizeof(type)),
+                                    reinterpret_cast<char*>(received_chunk.data()),
+                                    chunk_size(reduced_chunk)*Index(sizeof(type)));
+
+        TensorMap<Tensor<type, 1>> chunk(vector_data + chunk_begin(reduced_chunk), chunk_size(reduced_chunk));
+
+        chunk += received_chunk.slice(Eigen::array<Index, 1>({0}), Eigen::array<Index, 1>({chunk_size(reduced_chunk)}));
+    }
+
+    // All-gather
+
+    for(Index step = 0; step < ranks_number - 1; step++)
+    {
+        const Index sent_chunk = (rank + 1 - step + ranks_number)%ranks_number;
+        const Index gathered_chunk = (rank - step + ranks_number)%ranks_number;
+
+        transport_pointer->exchange(reinterpret_cast<const char*>(vector_data + chunk_begin(sent_chunk)),
+                                    chunk_size(sent_chunk)*Index(sizeof(type)),
+                                    reinterpret_cast<char*>(vector_data + chunk_begin(gathered_chunk)),
+                                    chunk_size(gathered_chunk)*Index(sizeof(type)));
+    }
+}
+
+
+/// Replaces a vector by the mean of the vectors of all the ranks.
+/// @param vector Vector of this rank, which must have the same size on all the ranks.
+
+void Communicator::all_reduce_mean(Tensor<type, 1>& vector)
+{
+    all_reduce_sum(vector);
+
+    if(get_ranks_number() > 1) vector = vector/type(get_ranks_number());
+}
+
+
+/// Replaces a vector by the vector of rank 0 on all the ranks.
+/// The other ranks contribute zeros to a sum, so that it takes the same path as the all-reduce.
+/// @param vector Vector of this rank, which must have the same size on all the ranks.
+
+void Communicator::broadcast(Tensor<type, 1>& vector)
+{
+    if(get_rank() != 0) vector.setZero();
+
+    all_reduce_sum(vector);
+}
+
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
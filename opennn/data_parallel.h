@@ -0,0 +1,195 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   D A T A   P A R A L L E L   C L A S S E S   H E A D E R
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#ifndef DATAPARALLEL_H
+#define DATAPARALLEL_H
+
+// System includes
+
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <stdexcept>
+
+// OpenNN includes
+
+#include "config.h"
+
+namespace opennn
+{
+
+/// This abstract class represents the connections of a process with the other processes of a ring.
+
+/// The processes, or ranks, are numbered from 0 to the number of ranks minus 1,
+/// and each rank sends to the next one and receives from the previous one.
+/// The derived classes implement the exchange of bytes over a particular medium.
+
+class Transport
+{
+
+public:
+
+    // Constructors
+
+    explicit Transport(const Index& = 0, const Index& = 1);
+
+    Transport(const Transport&) = delete;
+
+    Transport& operator=(const Transport&) = delete;
+
+    // Destructor
+
+    virtual ~Transport();
+
+    // Get methods
+
+    const Index& get_rank() const;
+
+    const Index& get_ranks_number() const;
+
+    Index get_next_rank() const;
+
+    Index get_previous_rank() const;
+
+    // Communication methods
+
+    /// Sends bytes to the next rank while it receives bytes from the previous rank.
+    /// Both transfers progress at the same time, so that all the ranks of the ring can exchange at once without deadlock.
+
+    virtual void exchange(const char*, const Index&, char*, const Index&) = 0;
+
+protected:
+
+    /// Number of this process within the ring.
+
+    Index rank = 0;
+
+    /// Number of processes of the ring.
+
+    Index ranks_number = 1;
+};
+
+
+/// This class connects the ranks of a ring with stream sockets on the local machine or a network.
+
+/// Each rank listens on its own address and connects to the address of the next rank.
+/// Unix domain sockets use the address as a prefix of a socket file per rank,
+/// and TCP sockets use an address of the form host:port, the rank being added to the port.
+/// The constructor waits until the connections with the previous and the next ranks are established.
+
+class SocketTransport : public Transport
+{
+
+public:
+
+    /// Enumeration of the available socket families.
+
+    enum class Family{Unix, TCP};
+
+    // Constructors
+
+    explicit SocketTransport(const Index&, const Index&, const Family&, const string&, const type& = type(60));
+
+    // Destructor
+
+    virtual ~SocketTransport();
+
+    // Get methods
+
+    const Family& get_family() const;
+
+    // Communication methods
+
+    void exchange(const char*, const Index&, char*, const Index&) final;
+
+private:
+
+    void connect_ring(const string&, const type&);
+
+    void close();
+
+    /// Socket family.
+
+    Family family = Family::Unix;
+
+    /// Socket connected to the next rank.
+
+    int next_socket = -1;
+
+    /// Socket connected to the previous rank.
+
+    int previous_socket = -1;
+};
+
+
+/// This class performs the collective operations of data parallel training over a transport.
+
+/// The sums are calculated with a ring all-reduce: the vector is split in as many chunks as ranks,
+/// each chunk is accumulated along the ring by a reduce-scatter and then copied to every rank by an all-gather.
+/// Each rank sends and receives about twice the size of the vector, whatever the number of ranks.
+/// Every chunk is summed once, in the same order, and then copied, so the results are bit-identical on all ranks.
+
+class Communicator
+{
+
+public:
+
+    // Constructors
+
+    explicit Communicator(Transport*);
+
+    // Get methods
+
+    Transport* get_transport_pointer() const;
+
+    const Index& get_rank() const;
+
+    const Index& get_ranks_number() const;
+
+    Tensor<Index, 1> get_shard(const Tensor<Index, 1>&) const;
+
+    // Collective methods
+
+    void all_reduce_sum(Tensor<type, 1>&);
+
+    void all_reduce_mean(Tensor<type, 1>&);
+
+    void broadcast(Tensor<type, 1>&);
+
+private:
+
+    /// Transport between the ranks.
+
+    Transport* transport_pointer = nullptr;
+
+    /// Chunk received from the previous rank in the reduce-scatter.
+
+    Tensor<type, 1> received_chunk;
+};
+
+}
+
+#endif
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -115,8 +115,6 @@ DataSet::DataSet(const string& data_file_name, const char& separator, const bool
 
 DataSet::~DataSet()
 {
-    delete thread_pool;
-    delete thread_pool_device;
 }
 
 
@@ -457,7 +455,10 @@ void DataSet::Column::from_XML(const tinyxml2::XMLDocument& column_document)
         set_type(new_type);
     }
 
-    if(type == ColumnType::Categorical)
+    // Binary columns keep their categories when they have been written
+
+    if(type == ColumnType::Categorical
+    || (type == ColumnType::Binary && column_document.FirstChildElement("Categories")))
     {
         // Categories
 
@@ -885,6 +886,21 @@ Index DataSet::Column::get_used_categories_number() const
 }
 
 
+/// Returns the number of categories of a categorical column which are inputs.
+
+Index DataSet::Column::get_input_categories_number() const
+{
+    Index input_categories_number = 0;
+
+    for(Index i = 0; i < categories.size(); i++)
+    {
+        if(categories_uses(i) == VariableUse::Input) input_categories_number++;
+    }
+
+    return input_categories_number;
+}
+
+
 /// Returns a string vector that contains the names of the used variables in the data set.
 
 Tensor<string, 1> DataSet::Column::get_used_variables_names() const
@@ -2418,6 +2434,8 @@ void DataSet::split_samples_sequential(const type& training_samples_ratio,
 void DataSet::set_columns(const Tensor<Column, 1>& new_columns)
 {
     columns = new_columns;
+
+    training_cache.set();
 }
 
 
@@ -2964,9 +2982,15 @@ Tensor<Scaler, 1> DataSet::get_input_variables_scalers() const
 
     for(Index i = 0; i < input_columns_number; i++)
     {
+        // The codes are read from the one hot variables, which must not be scaled
+
+        const Scaler scaler = use_categorical_inputs_codes && input_columns(i).type == ColumnType::Categorical
+                ? Scaler::NoScaling
+                : input_columns(i).scaler;
+
         for(Index j = 0;  j < input_columns(i).get_variables_number(); j++)
         {
-            input_variables_scalers(index) = input_columns(i).scaler;
+            input_variables_scalers(index) = scaler;
             index++;
         }
     }
@@ -3988,6 +4012,8 @@ void DataSet::set_columns_uses(const Tensor<string, 1>& new_columns_uses)
 
     input_variables_dimensions.resize(1);
     input_variables_dimensions.setConstant(get_input_variables_number());
+
+    training_cache.set();
 }
 
 
@@ -4017,6 +4043,8 @@ void DataSet::set_columns_uses(const Tensor<VariableUse, 1>& new_columns_uses)
 
     input_variables_dimensions.resize(1);
     input_variables_dimensions.setConstant(get_input_variables_number());
+
+    training_cache.set();
 }
 
 
@@ -4139,6 +4167,8 @@ void DataSet::set_column_use(const Index& index, const VariableUse& new_use)
     {
         columns(index).set_categories_uses(new_use);
     }
+
+    training_cache.set();
 }
 
 void DataSet::set_columns_unused(const Tensor<Index, 1>& unused_columns_index)
@@ -4347,6 +4377,8 @@ void DataSet::set_input()
 
         columns(i).set_use(VariableUse::Input);
     }
+
+    training_cache.set();
 }
 
 
@@ -4358,6 +4390,8 @@ void DataSet::set_target()
     {
         columns(i).set_use(VariableUse::Target);
     }
+
+    training_cache.set();
 }
 
 
@@ -4369,6 +4403,8 @@ void DataSet::set_variables_unused()
     {
         columns(i).set_use(VariableUse::Unused);
     }
+
+    training_cache.set();
 }
 
 
@@ -5944,11 +5980,18 @@ Tensor<type, 2> DataSet::get_subtensor_data(const Tensor<Index, 1> & rows_indice
 
 void DataSet::set()
 {
-    thread_pool = nullptr;
-    thread_pool_device = nullptr;
+    thread_pool_device = ExecutionContext::get_thread_pool_device();
 
     data.resize(0,0);
 
+    data_shards.set();
+
+    batch_variables_scalers.resize(0);
+
+    batch_variables_descriptives.resize(0);
+
+    training_cache.set();
+
     samples_uses.resize(0);
 
     columns.resize(0);
@@ -6085,6 +6128,14 @@ void DataSet::set(const Index& new_samples_number, const Index& new_variables_nu
 
     data.resize(new_samples_number, new_variables_number);
 
+    data_shards.set();
+
+    batch_variables_scalers.resize(0);
+
+    batch_variables_descriptives.resize(0);
+
+    training_cache.set();
+
     columns.resize(new_variables_number);
 
     for(Index index = 0; index < new_variables_number-1; index++)
@@ -6120,6 +6171,14 @@ void DataSet::set(const Index& new_samples_number,
 
     data.resize(new_samples_number, new_variables_number);
 
+    data_shards.set();
+
+    batch_variables_scalers.resize(0);
+
+    batch_variables_descriptives.resize(0);
+
+    training_cache.set();
+
     columns.resize(new_variables_number);
 
     for(Index i = 0; i < new_variables_number; i++)
@@ -6201,6 +6260,26 @@ void DataSet::set(const DataSet& other_data_set)
 
     data = other_data_set.data;
 
+    data_shards = other_data_set.data_shards;
+
+    map_binary_data = other_data_set.map_binary_data;
+
+    training_cache = other_data_set.training_cache;
+
+    use_training_cache = other_data_set.use_training_cache;
+
+    training_cache_precision = other_data_set.training_cache_precision;
+
+    use_categorical_inputs_codes = other_data_set.use_categorical_inputs_codes;
+
+    batch_variables_scalers = other_data_set.batch_variables_scalers;
+
+    batch_variables_descriptives = other_data_set.batch_variables_descriptives;
+
+    shuffle_buffer_size = other_data_set.shuffle_buffer_size;
+
+    batch_scaling = other_data_set.batch_scaling;
+
     columns = other_data_set.columns;
 
     display = other_data_set.display;
@@ -6212,9 +6291,6 @@ void DataSet::set(const DataSet& other_data_set)
 
 void DataSet::set(const tinyxml2::XMLDocument& data_set_document)
 {
-    if(thread_pool != nullptr) delete thread_pool;
-    if(thread_pool_device != nullptr) delete thread_pool_device;
-
     set_default();
 
     from_XML(data_set_document);
@@ -6316,9 +6392,7 @@ void DataSet::set_random_vertical_translation_maximum(const type& new_random_ver
 
 void DataSet::set_default()
 {
-    const int n = omp_get_max_threads();
-    thread_pool = new ThreadPool(n);
-    thread_pool_device = new ThreadPoolDevice(thread_pool, n);
+    thread_pool_device = ExecutionContext::get_thread_pool_device();
 
     has_columns_names = false;
 
@@ -6405,6 +6479,8 @@ void DataSet::set_data(const Tensor<type, 2>& new_data)
 void DataSet::set_data(const Tensor<type, 2>& new_data, const bool& new_samples)
 {
     data = new_data;
+
+    training_cache.set();
 }
 
 
@@ -6789,13 +6865,12 @@ type DataSet::calculate_intersection_over_union(const BoundingBox& bounding_box_
 }
 
 
+/// Sets the number of threads of the thread pool shared by all the objects.
+/// @param new_threads_number Number of threads.
+
 void DataSet::set_threads_number(const int& new_threads_number)
 {
-    if(thread_pool != nullptr) delete thread_pool;
-    if(thread_pool_device != nullptr) delete thread_pool_device;
-
-    thread_pool = new ThreadPool(new_threads_number);
-    thread_pool_device = new ThreadPoolDevice(thread_pool, new_threads_number);
+    ExecutionContext::set_threads_number(new_threads_number);
 }
 
 
@@ -6986,6 +7061,11 @@ Tensor<Histogram, 1> DataSet::calculate_columns_distribution(const Index& bins_n
 
     Tensor<Histogram, 1> histograms(used_columns_number);
 
+    // The numeric columns are binned together, after the loop
+
+    vector<Index> numeric_variables_indices;
+    vector<Index> numeric_histograms_indices;
+
     Index variable_index = 0;
     Index used_column_index = 0;
 
@@ -6999,14 +7079,8 @@ Tensor<Histogram, 1> DataSet::calculate_columns_distribution(const Index& bins_n
             }
             else
             {
-                Tensor<type, 1> column(used_samples_number);
-
-                for(Index j = 0; j < used_samples_number; j++)
-                {
-                    column(j) = data(used_samples_indices(j), variable_index);
-                }
-
-                histograms(used_column_index) = histogram(column, bins_number);
+                numeric_variables_indices.push_back(variable_index);
+                numeric_histograms_indices.push_back(used_column_index);
 
                 variable_index++;
                 used_column_index++;
@@ -7094,6 +7168,19 @@ Tensor<Histogram, 1> DataSet::calculate_columns_distribution(const Index& bins_n
         }
     }
 
+    const Index numeric_columns_number = Index(numeric_variables_indices.size());
+
+    const Tensor<Histogram, 1> numeric_histograms
+            = columns_histograms(data,
+                                 used_samples_indices,
+                                 TensorMap<const Tensor<Index, 1>>(numeric_variables_indices.data(), numeric_columns_number),
+                                 bins_number);
+
+    for(Index i = 0; i < numeric_columns_number; i++)
+    {
+        histograms(numeric_histograms_indices[size_t(i)]) = numeric_histograms(i);
+    }
+
     return histograms;
 }
 
@@ -7147,7 +7234,11 @@ Tensor<BoxPlot, 1> DataSet::calculate_columns_box_plots() const
 
     Tensor<BoxPlot, 1> box_plots(columns_number);
 
-    Index used_column_index = 0;
+    // The used numeric and binary columns are summarized together, after the loop
+
+    vector<Index> used_variables_indices;
+    vector<Index> used_columns_indices;
+
     Index variable_index = 0;
 
     for(Index i = 0; i < columns_number; i++)
@@ -7156,9 +7247,8 @@ Tensor<BoxPlot, 1> DataSet::calculate_columns_box_plots() const
         {
             if(columns(i).column_use != VariableUse::Unused)
             {
-                box_plots(i) = box_plot(data.chip(variable_index, 1), used_samples_indices);
-
-                used_column_index++;
+                used_variables_indices.push_back(variable_index);
+                used_columns_indices.push_back(i);
             }
             else
             {
@@ -7180,6 +7270,18 @@ Tensor<BoxPlot, 1> DataSet::calculate_columns_box_plots() const
         }
     }
 
+    const Index used_columns_number = Index(used_columns_indices.size());
+
+    const Tensor<BoxPlot, 1> used_box_plots
+            = columns_box_plots(data,
+                                used_samples_indices,
+                                TensorMap<const Tensor<Index, 1>>(used_variables_indices.data(), used_columns_number));
+
+    for(Index i = 0; i < used_columns_number; i++)
+    {
+        box_plots(used_columns_indices[size_t(i)]) = used_box_plots(i);
+    }
+
     return box_plots;
 }
 
@@ -7347,6 +7449,8 @@ Tensor<Descriptives, 1> DataSet::calculate_used_variables_descriptives() const
     const Tensor<Index, 1> used_samples_indices = get_used_samples_indices();
     const Tensor<Index, 1> used_variables_indices = get_used_variables_indices();
 
+    if(has_data_shards()) return data_shards.calculate_descriptives(used_samples_indices, used_variables_indices);
+
     return descriptives(data, used_samples_indices, used_variables_indices);
 }
 
@@ -7559,6 +7663,8 @@ Tensor<Descriptives, 1> DataSet::calculate_input_variables_descriptives() const
 
     const Tensor<Index, 1> input_variables_indices = get_input_variables_indices();
 
+    if(has_data_shards()) return data_shards.calculate_descriptives(used_samples_indices, input_variables_indices);
+
     return descriptives(data, used_samples_indices, input_variables_indices);
 }
 
@@ -7578,6 +7684,8 @@ Tensor<Descriptives, 1> DataSet::calculate_target_variables_descriptives() const
 
     const Tensor<Index, 1> target_variables_indices = get_target_variables_indices();
 
+    if(has_data_shards()) return data_shards.calculate_descriptives(used_indices, target_variables_indices);
+
     return descriptives(data, used_indices, target_variables_indices);
 }
 
@@ -7588,6 +7696,8 @@ Tensor<Descriptives, 1> DataSet::calculate_testing_target_variables_descriptives
 
     const Tensor<Index, 1> target_variables_indices = get_target_variables_indices();
 
+    if(has_data_shards()) return data_shards.calculate_descriptives(testing_indices, target_variables_indices);
+
     return descriptives(data, testing_indices, target_variables_indices);
 }
 
@@ -7752,10 +7862,6 @@ void DataSet::set_gmt(Index& new_gmt)
 
 Tensor<Correlation, 2> DataSet::calculate_input_target_columns_correlations() const
 {
-    const int number_of_thread = omp_get_max_threads();
-    ThreadPool* correlations_thread_pool = new ThreadPool(number_of_thread);
-    ThreadPoolDevice* correlations_thread_pool_device = new ThreadPoolDevice(correlations_thread_pool, number_of_thread);
-
     const Index input_columns_number = get_input_columns_number();
     const Index target_columns_number = get_target_columns_number();
 
@@ -7780,13 +7886,10 @@ Tensor<Correlation, 2> DataSet::calculate_input_target_columns_correlations() co
 
             const Tensor<type, 2> target_column_data = get_column_data(target_index, used_samples_indices);
 
-            correlations(i,j) = opennn::correlation(correlations_thread_pool_device, input_column_data, target_column_data);
+            correlations(i,j) = opennn::correlation(thread_pool_device, input_column_data, target_column_data);
         }
     }
 
-    delete correlations_thread_pool;
-    delete correlations_thread_pool_device;
-
     return correlations;
 }
 
@@ -7794,10 +7897,6 @@ Tensor<Correlation, 2> DataSet::calculate_input_target_columns_correlations() co
 Tensor<Correlation, 2> DataSet::calculate_relevant_input_target_columns_correlations(const Tensor<Index, 1>& input_columns_indices,
                                                                                      const Tensor<Index, 1>& target_columns_indices) const
 {
-    const int number_of_thread = omp_get_max_threads();
-    ThreadPool* correlations_thread_pool = new ThreadPool(number_of_thread);
-    ThreadPoolDevice* correlations_thread_pool_device = new ThreadPoolDevice(correlations_thread_pool, number_of_thread);
-
     const Index input_columns_number = input_columns_indices.dimension(0);
     const Index target_columns_number = target_columns_indices.dimension(0);
 
@@ -7816,7 +7915,7 @@ Tensor<Correlation, 2> DataSet::calculate_relevant_input_target_columns_correlat
             const Tensor<type, 2> input_column_data = get_column_data(input_index, get_used_samples_indices());
             const Tensor<type, 2> target_column_data = get_column_data(target_index, get_used_samples_indices());
 
-            correlations(i, j) = opennn::correlation(correlations_thread_pool_device, input_column_data, target_column_data);
+            correlations(i, j) = opennn::correlation(thread_pool_device, input_column_data, target_column_data);
         }
     }
 */
@@ -7834,13 +7933,10 @@ Tensor<Correlation, 2> DataSet::calculate_relevant_input_target_columns_correlat
 
             const Tensor<type, 2> target_column_data = get_column_data(target_index, get_used_samples_indices());
 
-            correlations(i,j) = opennn::correlation(correlations_thread_pool_device, input_column_data, target_column_data);
+            correlations(i,j) = opennn::correlation(thread_pool_device, input_column_data, target_column_data);
         }
     }
 
-    delete correlations_thread_pool;
-    delete correlations_thread_pool_device;
-
     return correlations;
 }
 
@@ -8285,6 +8381,7 @@ void DataSet::unscale_data(const Tensor<Descriptives, 1>& variables_descriptives
 
 /// It scales every input variable with the given method.
 /// The method to be used is that in the scaling and unscaling method variable.
+/// With batch scaling, the data are not changed, and the variables are scaled when the batches are filled.
 
 Tensor<Descriptives, 1> DataSet::scale_input_variables()
 {
@@ -8295,6 +8392,15 @@ Tensor<Descriptives, 1> DataSet::scale_input_variables()
 
     const Tensor<Descriptives, 1> input_variables_descriptives = calculate_input_variables_descriptives();
 
+    if(is_batch_scaling())
+    {
+        set_batch_variables_scalers(input_variables_indices, input_variables_scalers, input_variables_descriptives);
+
+        return input_variables_descriptives;
+    }
+
+    training_cache.set();
+
     for(Index i = 0; i < input_variables_number; i++)
     {
         switch(input_variables_scalers(i))
@@ -8340,6 +8446,7 @@ Tensor<Descriptives, 1> DataSet::scale_input_variables()
 /// Then it scales the target variables with those values.
 /// The method to be used is that in the scaling and unscaling method variable.
 /// Finally, it returns the descriptives.
+/// With batch scaling, the data are not changed, and the variables are scaled when the batches are filled.
 
 Tensor<Descriptives, 1> DataSet::scale_target_variables()
 {
@@ -8350,6 +8457,15 @@ Tensor<Descriptives, 1> DataSet::scale_target_variables()
 
     const Tensor<Descriptives, 1> target_variables_descriptives = calculate_target_variables_descriptives();
 
+    if(is_batch_scaling())
+    {
+        set_batch_variables_scalers(target_variables_indices, target_variables_scalers, target_variables_descriptives);
+
+        return target_variables_descriptives;
+    }
+
+    training_cache.set();
+
     for(Index i = 0; i < target_variables_number; i++)
     {
         switch(target_variables_scalers(i))
@@ -8402,6 +8518,18 @@ void DataSet::unscale_input_variables(const Tensor<Descriptives, 1>& input_varia
 
     const Tensor<Scaler, 1> input_variables_scalers = get_input_variables_scalers();
 
+    if(is_batch_scaling())
+    {
+        Tensor<Scaler, 1> no_scalers(input_variables_number);
+        no_scalers.setConstant(Scaler::NoScaling);
+
+        set_batch_variables_scalers(input_variables_indices, no_scalers, input_variables_descriptives);
+
+        return;
+    }
+
+    training_cache.set();
+
     for(Index i = 0; i < input_variables_number; i++)
     {
         switch(input_variables_scalers(i))
@@ -8450,6 +8578,18 @@ void DataSet::unscale_target_variables(const Tensor<Descriptives, 1>& targets_de
     const Tensor<Index, 1> target_variables_indices = get_target_variables_indices();
     const Tensor<Scaler, 1> target_variables_scalers = get_target_variables_scalers();
 
+    if(is_batch_scaling())
+    {
+        Tensor<Scaler, 1> no_scalers(target_variables_number);
+        no_scalers.setConstant(Scaler::NoScaling);
+
+        set_batch_variables_scalers(target_variables_indices, no_scalers, targets_descriptives);
+
+        return;
+    }
+
+    training_cache.set();
+
     for(Index i = 0; i < target_variables_number; i++)
     {
         switch(target_variables_scalers(i))
@@ -10603,70 +10743,60 @@ void DataSet::save_data() const
 }
 
 
-/// Saves to the data file the values of the data matrix in binary format.
+/// Saves to a file the data matrix in the binary format, together with the description of the columns.
+/// The columns, with their names, uses, types, scalers and categories, are written as XML in the metadata of the file,
+/// and the values of each variable are written as an aligned block, so that the file can be mapped into memory.
+/// @param binary_data_file_name Name of the binary data file.
 
 void DataSet::save_data_binary(const string& binary_data_file_name) const
 {
-    regex accent_regex("[\\xC0-\\xFF]");
-    std::ofstream file;
+    cout << "Saving binary data file..." << endl;
 
-    #ifdef _WIN32
+    BinaryDataFile::write(binary_data_file_name, write_columns_metadata(), data);
 
-    if(regex_search(binary_data_file_name, accent_regex))
-    {
-        wstring_convert<codecvt_utf8<wchar_t>> conv;
-        wstring file_name_wide = conv.from_bytes(binary_data_file_name);
-        file.open(file_name_wide, ios::binary);
-    }
-    else
-    {
-        file.open(binary_data_file_name.c_str(), ios::binary);
-    }
+    cout << "Binary data file saved." << endl;
+}
 
-    #else
-        file.open(binary_data_file_name.c_str(), ios::binary);
-    #endif
 
-    if(!file.is_open())
-    {
-        ostringstream buffer;
+/// Returns the XML text which describes the columns in the binary data files.
 
-        buffer << "OpenNN Exception: DataSet class." << endl
-               << "void save_data_binary() method." << endl
-               << "Cannot open data binary file." << endl;
+string DataSet::write_columns_metadata() const
+{
+    tinyxml2::XMLPrinter file_stream;
 
-        throw invalid_argument(buffer.str());
-    }
+    file_stream.OpenElement("DataSet");
 
-    // Write data
+    file_stream.OpenElement("Columns");
 
-    streamsize size = sizeof(Index);
+    // Columns number
+    {
+        file_stream.OpenElement("ColumnsNumber");
 
-    Index columns_number = data.dimension(1);
-    Index rows_number = data.dimension(0);
+        file_stream.PushText(to_string(get_columns_number()).c_str());
 
-    cout << "Saving binary data file..." << endl;
+        file_stream.CloseElement();
+    }
 
-    file.write(reinterpret_cast<char*>(&columns_number), size);
-    file.write(reinterpret_cast<char*>(&rows_number), size);
+    // Columns items
 
-    size = sizeof(type);
+    for(Index i = 0; i < get_columns_number(); i++)
+    {
+        file_stream.OpenElement("Column");
 
-    type value;
+        file_stream.PushAttribute("Item", to_string(i+1).c_str());
 
-    for(int i = 0; i < columns_number; i++)
-    {
-        for(int j = 0; j < rows_number; j++)
-        {
-            value = data(j,i);
+        columns(i).write_XML(file_stream);
 
-            file.write(reinterpret_cast<char*>(&value), size);
-        }
+        file_stream.CloseElement();
     }
 
-    file.close();
+    // Close columns
 
-    cout << "Binary data file saved." << endl;
+    file_stream.CloseElement();
+
+    file_stream.CloseElement();
+
+    return file_stream.CStr();
 }
 
 
@@ -10803,137 +10933,854 @@ void DataSet::transform_associative_dataset()
 
 
 /// This method loads the data from a binary data file.
+/// Files in the binary format are mapped into memory, their columns are read from the metadata,
+/// and the block of each variable is copied straight into the data matrix.
+/// If the binary data is mapped, the file is instead kept as a read-only data shard and nothing is copied.
+/// Files saved by previous versions, which only hold the dimensions and the values, are read sequentially.
 
 void DataSet::load_data_binary()
 {
-    regex accent_regex("[\\xC0-\\xFF]");
-    std::ifstream file;
-
-    #ifdef _WIN32
-
-    if(regex_search(data_file_name, accent_regex))
-    {
-        wstring_convert<codecvt_utf8<wchar_t>> conv;
-        wstring file_name_wide = conv.from_bytes(data_file_name);
-        file.open(file_name_wide, ios::binary);
-    }
-    else
+    if(!BinaryDataFile::is_binary_data_file(data_file_name))
     {
-        file.open(data_file_name.c_str(), ios::binary);
+        load_data_binary_previous_version();
+
+        return;
     }
-    #else
-        file.open(data_file_name.c_str(), ios::binary);
-    #endif
 
-    if(!file.is_open())
+    if(map_binary_data)
     {
-        ostringstream buffer;
+        const Tensor<SampleUse, 1> old_samples_uses = samples_uses;
 
-        buffer << "OpenNN Exception: DataSet class.\n"
-               << "void load_data_binary() method.\n"
-               << "Cannot open binary file: " << data_file_name << "\n";
+        Tensor<string, 1> file_names(1);
+        file_names.setValues({data_file_name});
 
-        throw invalid_argument(buffer.str());
-    }
+        set_data_shards(file_names);
 
-    streamsize size = sizeof(Index);
+        if(old_samples_uses.size() == samples_uses.size()) samples_uses = old_samples_uses;
 
-    Index columns_number;
-    Index rows_number;
+        return;
+    }
 
-    file.read(reinterpret_cast<char*>(&columns_number), size);
-    file.read(reinterpret_cast<char*>(&rows_number), size);
+    const BinaryDataFile binary_data_file(data_file_name);
 
-    size = sizeof(type);
+    data_shards.set();
 
-    type value;
+    batch_variables_scalers.resize(0);
 
-    data.resize(rows_number, columns_number);
+    batch_variables_descriptives.resize(0);
 
-    for(Index i = 0; i < rows_number*columns_number; i++)
-    {
-        file.read(reinterpret_cast<char*>(&value), size);
-        data(i) = value;
-    }
+    training_cache.set();
 
-    file.close();
-}
+    // Columns
 
+    read_columns_metadata(binary_data_file.get_metadata(), binary_data_file.get_variables_number());
 
-/// This method loads time series data from a binary data file.
+    // Data
 
-void DataSet::load_time_series_data_binary(const string& time_series_data_file_name)
-{
-    std::ifstream file;
+    const Index samples_number = binary_data_file.get_samples_number();
+    const Index variables_number = binary_data_file.get_variables_number();
 
-    file.open(time_series_data_file_name.c_str(), ios::binary);
+    data.resize(samples_number, variables_number);
 
-    if(!file.is_open())
-    {
-        ostringstream buffer;
+    #pragma omp parallel for
 
-        buffer << "OpenNN Exception: DataSet class.\n"
-               << "void load_time_series_data_binary(const string&) method.\n"
-               << "Cannot open binary file: " << time_series_data_file_name << "\n";
+    for(Index j = 0; j < variables_number; j++)
+    {
+        const TensorMap<const Tensor<type, 1>> variable = binary_data_file.get_variable(j);
 
-        throw invalid_argument(buffer.str());
+        copy(variable.data(), variable.data() + samples_number, data.data() + j*samples_number);
     }
 
-    streamsize size = sizeof(Index);
-
-    Index columns_number;
-    Index rows_number;
+    if(samples_uses.size() != samples_number)
+    {
+        samples_uses.resize(samples_number);
 
-    file.read(reinterpret_cast<char*>(&columns_number), size);
-    file.read(reinterpret_cast<char*>(&rows_number), size);
+        split_samples_random();
+    }
+}
 
-    size = sizeof(type);
 
-    type value;
+/// Sets the columns from the XML text which describes them in the binary data files.
+/// @param metadata Metadata text of a binary data file.
+/// @param variables_number Number of variables of the binary data file, which must be that of the columns.
 
-    time_series_data.resize(rows_number, columns_number);
+void DataSet::read_columns_metadata(const string& metadata, const Index& variables_number)
+{
+    tinyxml2::XMLDocument metadata_document;
 
-    for(Index i = 0; i < rows_number*columns_number; i++)
+    if(metadata_document.Parse(metadata.c_str(), metadata.size()) != tinyxml2::XML_SUCCESS)
     {
-        file.read(reinterpret_cast<char*>(&value), size);
-
-        time_series_data(i) = value;
-    }
+        ostringstream buffer;
 
-    file.close();
-}
+        buffer << "OpenNN Exception: DataSet class.\n"
+               << "void read_columns_metadata(const string&, const Index&) method.\n"
+               << "Cannot parse metadata of binary data file.\n";
 
+        throw invalid_argument(buffer.str());
+    }
 
-/// This method loads associative data from a binary data file.
+    const tinyxml2::XMLElement* data_set_element = metadata_document.FirstChildElement("DataSet");
 
-void DataSet::load_auto_associative_data_binary(const string& auto_associative_data_file_name)
-{
-    std::ifstream file;
+    const tinyxml2::XMLElement* columns_element = data_set_element ? data_set_element->FirstChildElement("Columns") : nullptr;
 
-    file.open(auto_associative_data_file_name.c_str(), ios::binary);
+    const tinyxml2::XMLElement* columns_number_element = columns_element ? columns_element->FirstChildElement("ColumnsNumber") : nullptr;
 
-    if(!file.is_open())
+    if(!columns_number_element || !columns_number_element->GetText())
     {
         ostringstream buffer;
 
         buffer << "OpenNN Exception: DataSet class.\n"
-               << "void load_auto_associative_data_binary(const string&) method.\n"
-               << "Cannot open binary file: " << auto_associative_data_file_name << "\n";
+               << "void read_columns_metadata(const string&, const Index&) method.\n"
+               << "Columns number element is nullptr.\n";
 
         throw invalid_argument(buffer.str());
     }
 
-    streamsize size = sizeof(Index);
-
-    Index columns_number;
-    Index rows_number;
+    const Index new_columns_number = static_cast<Index>(atoi(columns_number_element->GetText()));
 
-    file.read(reinterpret_cast<char*>(&columns_number), size);
-    file.read(reinterpret_cast<char*>(&rows_number), size);
+    Tensor<Column, 1> new_columns(new_columns_number);
 
-    size = sizeof(type);
+    const tinyxml2::XMLElement* start_element = columns_number_element;
 
-    type value;
+    for(Index i = 0; i < new_columns_number; i++)
+    {
+        const tinyxml2::XMLElement* column_element = start_element->NextSiblingElement("Column");
+
+        if(!column_element)
+        {
+            ostringstream buffer;
+
+            buffer << "OpenNN Exception: DataSet class.\n"
+                   << "void read_columns_metadata(const string&, const Index&) method.\n"
+                   << "Column element " << i+1 << " is nullptr.\n";
+
+            throw invalid_argument(buffer.str());
+        }
+
+        start_element = column_element;
+
+        tinyxml2::XMLDocument column_document;
+
+        for(const tinyxml2::XMLElement* element = column_element->FirstChildElement(); element; element = element->NextSiblingElement())
+        {
+            column_document.InsertEndChild(element->DeepClone(&column_document));
+        }
+
+        new_columns(i).from_XML(column_document);
+    }
+
+    Index new_variables_number = 0;
+
+    for(Index i = 0; i < new_columns_number; i++)
+    {
+        new_variables_number += new_columns(i).get_variables_number();
+    }
+
+    if(new_variables_number != variables_number)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: DataSet class.\n"
+               << "void read_columns_metadata(const string&, const Index&) method.\n"
+               << "Number of variables of columns (" << new_variables_number << ") is not equal to "
+               << "number of variables of binary data file (" << variables_number << ").\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    columns = new_columns;
+}
+
+
+/// Returns true if the data matrix is held by data shards on disk, and false otherwise.
+
+bool DataSet::has_data_shards() const
+{
+    return data_shards.get_shards_number() != 0;
+}
+
+
+/// Returns a constant reference to the data shards on disk which hold the data matrix.
+
+const DataShards& DataSet::get_data_shards() const
+{
+    return data_shards;
+}
+
+
+/// Returns the number of samples of the buffer through which the samples of the data shards are shuffled.
+
+const Index& DataSet::get_shuffle_buffer_size() const
+{
+    return shuffle_buffer_size;
+}
+
+
+/// Returns true if the binary data files are mapped read-only as a data shard when they are loaded,
+/// and false if they are copied into the data matrix.
+
+const bool& DataSet::get_map_binary_data() const
+{
+    return map_binary_data;
+}
+
+
+/// Sets the data shards which hold the data matrix, instead of loading it into memory.
+/// The columns are read from the metadata of the shards, and the samples are split at random.
+/// The descriptives, the scaling and the batches are then computed by streaming over the shards,
+/// which must be binary data files of the same variables.
+/// @param file_names Names of the binary data files, in the order of their samples.
+
+void DataSet::set_data_shards(const Tensor<string, 1>& file_names)
+{
+    const DataShards new_data_shards(file_names);
+
+    read_columns_metadata(new_data_shards.get_metadata(), new_data_shards.get_variables_number());
+
+    data.resize(0, 0);
+
+    training_cache.set();
+
+    data_shards = new_data_shards;
+
+    batch_variables_scalers.resize(0);
+
+    batch_variables_descriptives.resize(0);
+
+    samples_uses.resize(data_shards.get_samples_number());
+
+    split_samples_random();
+
+    input_variables_dimensions.resize(1);
+    input_variables_dimensions.setConstant(get_input_variables_number());
+}
+
+
+/// Sets the number of samples of the buffer through which the samples of the data shards are shuffled.
+/// Larger buffers give better shuffles, and read from more shards at the same time.
+/// @param new_shuffle_buffer_size Number of samples of the shuffle buffer.
+
+void DataSet::set_shuffle_buffer_size(const Index& new_shuffle_buffer_size)
+{
+    if(new_shuffle_buffer_size <= 0)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: DataSet class.\n"
+               << "void set_shuffle_buffer_size(const Index&) method.\n"
+               << "Shuffle buffer size must be greater than 0.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    shuffle_buffer_size = new_shuffle_buffer_size;
+}
+
+
+/// Sets whether the binary data files are mapped read-only as a data shard when they are loaded, instead of copied into the data matrix.
+/// A mapped file is read by the operating system as the batches access it, so it can be larger than the memory,
+/// but the data matrix stays empty and the data set is read-only.
+/// @param new_map_binary_data True to map the binary data files, false to copy them.
+
+void DataSet::set_map_binary_data(const bool& new_map_binary_data)
+{
+    map_binary_data = new_map_binary_data;
+}
+
+
+/// Saves the data matrix as data shards, which are binary data files of consecutive samples.
+/// Each shard holds the description of the columns, so that it can be read with set_data_shards().
+/// Returns the names of the shards, which are the prefix followed by the index of the shard.
+/// @param prefix Prefix of the names of the shards.
+/// @param shard_samples_number Number of samples of each shard, except maybe the last one.
+
+Tensor<string, 1> DataSet::save_data_shards(const string& prefix, const Index& shard_samples_number) const
+{
+    return DataShards::write(prefix, write_columns_metadata(), data, shard_samples_number);
+}
+
+
+/// Returns a permutation of the given samples, for the batches of a training epoch.
+/// The samples in memory are shuffled at random.
+/// The samples of data shards are shuffled by shards, and then locally through the shuffle buffer,
+/// so that the batches do not read from all the shards at the same time.
+/// @param samples_indices Indices of the samples.
+/// @param random_engine Random number generator.
+
+Tensor<Index, 1> DataSet::shuffle_samples_indices(const Tensor<Index, 1>& samples_indices, mt19937& random_engine) const
+{
+    if(has_data_shards())
+    {
+        return data_shards.shuffle_samples_indices(samples_indices, shuffle_buffer_size, random_engine);
+    }
+
+    Tensor<Index, 1> shuffled_samples_indices = samples_indices;
+
+    std::shuffle(shuffled_samples_indices.data(),
+                 shuffled_samples_indices.data() + shuffled_samples_indices.size(),
+                 random_engine);
+
+    return shuffled_samples_indices;
+}
+
+
+/// Scales a column major batch submatrix,
+/// with the scalers and descriptives set by scale_input_variables() and scale_target_variables() for batch scaling.
+/// @param variables_indices Indices of the variables of the columns of the submatrix.
+/// @param rows_number Number of rows of the submatrix.
+/// @param submatrix_data Pointer to the values of the submatrix.
+
+void DataSet::scale_submatrix(const Tensor<Index, 1>& variables_indices, const Index& rows_number, type* submatrix_data) const
+{
+    if(batch_variables_scalers.size() == 0) return;
+
+    const Index columns_number = variables_indices.size();
+
+    #pragma omp parallel for
+
+    for(Index j = 0; j < columns_number; j++)
+    {
+        const Index variable_index = variables_indices(j);
+
+        scale_values(submatrix_data + j*rows_number,
+                     rows_number,
+                     batch_variables_scalers(variable_index),
+                     batch_variables_descriptives(variable_index));
+    }
+}
+
+
+/// Copies the values of some samples and variables of the data matrix into a column major batch submatrix,
+/// and scales them for batch scaling.
+/// Each column is scaled as soon as it has been gathered, while it is still in cache,
+/// so the batch is not read again and the data matrix is not changed.
+/// @param rows_indices Indices of the samples, which are the rows of the submatrix.
+/// @param variables_indices Indices of the variables, which are the columns of the submatrix.
+/// @param submatrix_data Pointer to the values of the submatrix.
+
+void DataSet::fill_scaled_submatrix(const Tensor<Index, 1>& rows_indices,
+                                    const Tensor<Index, 1>& variables_indices,
+                                    type* submatrix_data) const
+{
+    if(batch_variables_scalers.size() == 0)
+    {
+        fill_submatrix(data, rows_indices, variables_indices, submatrix_data);
+
+        return;
+    }
+
+    const Index rows_number = rows_indices.size();
+    const Index columns_number = variables_indices.size();
+
+    const Index data_rows_number = data.dimension(0);
+
+    #pragma omp parallel for
+
+    for(Index j = 0; j < columns_number; j++)
+    {
+        const Index variable_index = variables_indices(j);
+
+        const type* data_column_pointer = data.data() + data_rows_number*variable_index;
+        type* submatrix_column_pointer = submatrix_data + rows_number*j;
+
+        for(Index i = 0; i < rows_number; i++)
+        {
+            submatrix_column_pointer[i] = data_column_pointer[rows_indices(i)];
+        }
+
+        scale_values(submatrix_column_pointer,
+                     rows_number,
+                     batch_variables_scalers(variable_index),
+                     batch_variables_descriptives(variable_index));
+    }
+}
+
+
+/// Returns true if the variables are scaled when the batches are filled, instead of in the data matrix.
+
+const bool& DataSet::get_batch_scaling() const
+{
+    return batch_scaling;
+}
+
+
+/// Returns true if scale_input_variables() and scale_target_variables() set the scalers of the batches,
+/// and false if they scale the data matrix.
+/// The data shards are always scaled by batches, while images are always scaled in the data matrix.
+
+bool DataSet::is_batch_scaling() const
+{
+    if(has_data_shards()) return true;
+
+    return batch_scaling && input_variables_dimensions.size() <= 1;
+}
+
+
+/// Sets whether the variables are scaled when the batches are filled, instead of in the data matrix.
+/// Batch scaling does not change the data, so no pass over the data matrix is needed to scale or unscale it,
+/// the values do not drift from the round trip, and the training cache is kept from one training to the next.
+/// It must not be changed while the variables are scaled.
+/// @param new_batch_scaling True to scale the batches, and false to scale the data matrix.
+
+void DataSet::set_batch_scaling(const bool& new_batch_scaling)
+{
+    batch_scaling = new_batch_scaling;
+}
+
+
+/// Returns true if the batches are gathered from a copy of the used variables with the samples in rows,
+/// and false otherwise.
+
+const bool& DataSet::get_use_training_cache() const
+{
+    return use_training_cache;
+}
+
+
+/// Returns a constant reference to the copy of the used variables with the samples in rows.
+
+const TrainingCache& DataSet::get_training_cache() const
+{
+    return training_cache;
+}
+
+
+/// Sets whether the batches are gathered from a copy of the used variables with the samples in rows.
+/// This is faster for data sets with many variables, and takes the memory of the used variables.
+/// @param new_use_training_cache True to use the training cache, and false otherwise.
+
+void DataSet::set_use_training_cache(const bool& new_use_training_cache)
+{
+    use_training_cache = new_use_training_cache;
+
+    if(!use_training_cache) training_cache.set();
+}
+
+
+/// Returns the precision of the values of the training cache.
+
+const StoragePrecision& DataSet::get_training_cache_precision() const
+{
+    return training_cache_precision;
+}
+
+
+/// Sets the precision of the values of the training cache.
+/// The half and bfloat16 precisions halve the memory of the cache and the bandwidth of the batches,
+/// whose values are rounded to the precision but are filled and trained in single precision.
+/// The data matrix keeps the values in single precision for the analyses and the scaling.
+/// @param new_training_cache_precision Precision of the training cache.
+
+void DataSet::set_training_cache_precision(const StoragePrecision& new_training_cache_precision)
+{
+    if(new_training_cache_precision != training_cache_precision) training_cache.set();
+
+    training_cache_precision = new_training_cache_precision;
+}
+
+
+/// Sets the precision of the values of the training cache.
+/// @param new_training_cache_precision Name of the precision: "Single", "Half" or "BFloat16".
+
+void DataSet::set_training_cache_precision(const string& new_training_cache_precision)
+{
+    set_training_cache_precision(read_storage_precision(new_training_cache_precision));
+}
+
+
+/// Builds the training cache, if it is used and it does not hold the input and target variables.
+/// The cache is freed when the uses of the columns or the data change,
+/// so it must be updated after the variables are selected and the data are scaled, before the batches are filled.
+
+void DataSet::update_training_cache()
+{
+    if(!use_training_cache || has_data_shards()) return;
+
+    const Tensor<Index, 1> input_variables_indices = get_input_variables_indices();
+    const Tensor<Index, 1> target_variables_indices = get_target_variables_indices();
+
+    const Tensor<Index, 1> input_categories_numbers = get_input_categories_numbers();
+
+    if(training_cache.has_variables(input_variables_indices, target_variables_indices, input_categories_numbers)
+    && training_cache.get_storage_precision() == training_cache_precision)
+    {
+        return;
+    }
+
+    training_cache.set(data, input_variables_indices, target_variables_indices, training_cache_precision, input_categories_numbers);
+}
+
+
+/// Returns true if the batches hold the categorical inputs as the codes of their categories, and false otherwise.
+
+const bool& DataSet::get_use_categorical_inputs_codes() const
+{
+    return use_categorical_inputs_codes;
+}
+
+
+/// Sets whether the batches hold each categorical input as a single code, the position of its category
+/// among the input categories of the column, instead of one hot variable per category.
+/// The batches then have as many columns as input columns, and the training cache stores the codes,
+/// so their memory grows with the number of columns instead of the number of categories.
+/// The first layer of the neural network must then read the codes, see NeuralNetwork::set_inputs_categories_numbers().
+/// The one hot variables of the categorical inputs are not scaled, so the neural network gives the same outputs
+/// for the one hot variables.
+/// @param new_use_categorical_inputs_codes True to fill the batches with codes, and false for one hot variables.
+
+void DataSet::set_use_categorical_inputs_codes(const bool& new_use_categorical_inputs_codes)
+{
+    if(new_use_categorical_inputs_codes != use_categorical_inputs_codes) training_cache.set();
+
+    use_categorical_inputs_codes = new_use_categorical_inputs_codes;
+}
+
+
+/// Returns the number of categories of each input code of the batches, in the order of the input variables.
+/// A categorical input column with at least two input categories is a code with that number of categories,
+/// and each other input variable is a code of zero categories, which holds the value of the variable.
+/// It is empty if the categorical inputs are not coded, or if there are no such columns.
+
+Tensor<Index, 1> DataSet::get_input_categories_numbers() const
+{
+    if(!use_categorical_inputs_codes || input_variables_dimensions.size() > 1) return Tensor<Index, 1>();
+
+    const Index columns_number = columns.size();
+
+    Index input_codes_number = 0;
+    bool has_codes = false;
+
+    for(Index i = 0; i < columns_number; i++)
+    {
+        if(columns(i).type == ColumnType::Categorical)
+        {
+            const Index input_categories_number = columns(i).get_input_categories_number();
+
+            if(input_categories_number > 1) has_codes = true;
+
+            input_codes_number += input_categories_number > 1 ? 1 : input_categories_number;
+        }
+        else if(columns(i).column_use == VariableUse::Input)
+        {
+            input_codes_number++;
+        }
+    }
+
+    if(!has_codes) return Tensor<Index, 1>();
+
+    Tensor<Index, 1> input_categories_numbers(input_codes_number);
+
+    Index index = 0;
+
+    for(Index i = 0; i < columns_number; i++)
+    {
+        if(columns(i).type == ColumnType::Categorical)
+        {
+            const Index input_categories_number = columns(i).get_input_categories_number();
+
+            if(input_categories_number > 1)
+            {
+                input_categories_numbers(index++) = input_categories_number;
+            }
+            else if(input_categories_number == 1)
+            {
+                input_categories_numbers(index++) = 0;
+            }
+        }
+        else if(columns(i).column_use == VariableUse::Input)
+        {
+            input_categories_numbers(index++) = 0;
+        }
+    }
+
+    return input_categories_numbers;
+}
+
+
+/// Returns the number of input columns of the batches.
+/// It is the number of input variables, unless the categorical inputs are coded.
+
+Index DataSet::get_input_codes_number() const
+{
+    const Tensor<Index, 1> input_categories_numbers = get_input_categories_numbers();
+
+    return input_categories_numbers.size() == 0
+            ? get_input_variables_number()
+            : input_categories_numbers.size();
+}
+
+
+/// Returns the index of the first variable of each input code, which is the variable of the codes of zero categories.
+/// The batch scalers of these variables scale the input columns of the batches.
+
+Tensor<Index, 1> DataSet::get_input_codes_variables_indices() const
+{
+    const Tensor<Index, 1> input_variables_indices = get_input_variables_indices();
+
+    const Tensor<Index, 1> input_categories_numbers = get_input_categories_numbers();
+
+    const Index input_codes_number = input_categories_numbers.size();
+
+    if(input_codes_number == 0) return input_variables_indices;
+
+    Tensor<Index, 1> input_codes_variables_indices(input_codes_number);
+
+    Index variable_index = 0;
+
+    for(Index j = 0; j < input_codes_number; j++)
+    {
+        input_codes_variables_indices(j) = input_variables_indices(variable_index);
+
+        variable_index += max(input_categories_numbers(j), Index(1));
+    }
+
+    return input_codes_variables_indices;
+}
+
+
+/// Fills a column major batch submatrix with the input codes of some samples of the data matrix, and scales it.
+/// The code of a categorical input is the position of the first of its one hot variables greater than one half,
+/// or minus one if none is, for instance for a category which is not an input.
+/// @param rows_indices Indices of the samples, which are the rows of the submatrix.
+/// @param variables_indices Indices of the input variables, which the codes take in order.
+/// @param categories_numbers Number of categories of each code, or zero for the codes which hold a variable.
+/// @param submatrix_data Pointer to the values of the submatrix, with a column per code.
+
+void DataSet::fill_input_codes_submatrix(const Tensor<Index, 1>& rows_indices,
+                                         const Tensor<Index, 1>& variables_indices,
+                                         const Tensor<Index, 1>& categories_numbers,
+                                         type* submatrix_data) const
+{
+    const Index rows_number = rows_indices.size();
+    const Index codes_number = categories_numbers.size();
+
+    const Index data_rows_number = data.dimension(0);
+
+    Tensor<Index, 1> codes_variables_begins(codes_number);
+
+    Index variables_begin = 0;
+
+    for(Index j = 0; j < codes_number; j++)
+    {
+        codes_variables_begins(j) = variables_begin;
+
+        variables_begin += max(categories_numbers(j), Index(1));
+    }
+
+    if(variables_begin != variables_indices.size())
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: DataSet class.\n"
+               << "void fill_input_codes_submatrix(const Tensor<Index, 1>&, const Tensor<Index, 1>&, const Tensor<Index, 1>&, type*) const method.\n"
+               << "Number of coded variables (" << variables_begin << ") must be equal to "
+               << "number of variables (" << variables_indices.size() << ").\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    #pragma omp parallel for
+
+    for(Index j = 0; j < codes_number; j++)
+    {
+        const Index* code_variables_indices = variables_indices.data() + codes_variables_begins(j);
+
+        type* submatrix_column_pointer = submatrix_data + rows_number*j;
+
+        if(categories_numbers(j) == 0)
+        {
+            const type* data_column_pointer = data.data() + data_rows_number*code_variables_indices[0];
+
+            for(Index i = 0; i < rows_number; i++)
+            {
+                submatrix_column_pointer[i] = data_column_pointer[rows_indices(i)];
+            }
+
+            if(batch_variables_scalers.size() != 0)
+            {
+                scale_values(submatrix_column_pointer,
+                             rows_number,
+                             batch_variables_scalers(code_variables_indices[0]),
+                             batch_variables_descriptives(code_variables_indices[0]));
+            }
+
+            continue;
+        }
+
+        for(Index i = 0; i < rows_number; i++)
+        {
+            submatrix_column_pointer[i] = type(-1);
+
+            for(Index k = 0; k < categories_numbers(j); k++)
+            {
+                if(data(rows_indices(i), code_variables_indices[k]) > type(0.5))
+                {
+                    submatrix_column_pointer[i] = type(k);
+
+                    break;
+                }
+            }
+        }
+    }
+}
+
+
+/// Sets the scalers which are applied to some variables when the batches are filled.
+/// @param variables_indices Indices of the variables.
+/// @param variables_scalers Scalers of the variables.
+/// @param variables_descriptives Descriptives of the variables, which are not used by the variables with no scaling.
+
+void DataSet::set_batch_variables_scalers(const Tensor<Index, 1>& variables_indices,
+                                          const Tensor<Scaler, 1>& variables_scalers,
+                                          const Tensor<Descriptives, 1>& variables_descriptives)
+{
+    const Index variables_number = get_variables_number();
+
+    if(batch_variables_scalers.size() != variables_number)
+    {
+        batch_variables_scalers.resize(variables_number);
+        batch_variables_scalers.setConstant(Scaler::NoScaling);
+
+        batch_variables_descriptives.resize(variables_number);
+    }
+
+    for(Index i = 0; i < variables_indices.size(); i++)
+    {
+        batch_variables_scalers(variables_indices(i)) = variables_scalers(i);
+
+        if(variables_scalers(i) != Scaler::NoScaling)
+        {
+            batch_variables_descriptives(variables_indices(i)) = variables_descriptives(i);
+        }
+    }
+}
+
+
+/// This method loads the data from a binary data file saved by previous versions,
+/// which holds the number of columns, the number of rows and the values in column major order.
+
+void DataSet::load_data_binary_previous_version()
+{
+    regex accent_regex("[\\xC0-\\xFF]");
+    std::ifstream file;
+
+    #ifdef _WIN32
+
+    if(regex_search(data_file_name, accent_regex))
+    {
+        wstring_convert<codecvt_utf8<wchar_t>> conv;
+        wstring file_name_wide = conv.from_bytes(data_file_name);
+        file.open(file_name_wide, ios::binary);
+    }
+    else
+    {
+        file.open(data_file_name.c_str(), ios::binary);
+    }
+    #else
+        file.open(data_file_name.c_str(), ios::binary);
+    #endif
+
+    if(!file.is_open())
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: DataSet class.\n"
+               << "void load_data_binary() method.\n"
+               << "Cannot open binary file: " << data_file_name << "\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    streamsize size = sizeof(Index);
+
+    Index columns_number;
+    Index rows_number;
+
+    file.read(reinterpret_cast<char*>(&columns_number), size);
+    file.read(reinterpret_cast<char*>(&rows_number), size);
+
+    data.resize(rows_number, columns_number);
+
+    file.read(reinterpret_cast<char*>(data.data()), streamsize(data.size())*streamsize(sizeof(type)));
+
+    file.close();
+}
+
+
+/// This method loads time series data from a binary data file.
+
+void DataSet::load_time_series_data_binary(const string& time_series_data_file_name)
+{
+    std::ifstream file;
+
+    file.open(time_series_data_file_name.c_str(), ios::binary);
+
+    if(!file.is_open())
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: DataSet class.\n"
+               << "void load_time_series_data_binary(const string&) method.\n"
+               << "Cannot open binary file: " << time_series_data_file_name << "\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    streamsize size = sizeof(Index);
+
+    Index columns_number;
+    Index rows_number;
+
+    file.read(reinterpret_cast<char*>(&columns_number), size);
+    file.read(reinterpret_cast<char*>(&rows_number), size);
+
+    size = sizeof(type);
+
+    type value;
+
+    time_series_data.resize(rows_number, columns_number);
+
+    for(Index i = 0; i < rows_number*columns_number; i++)
+    {
+        file.read(reinterpret_cast<char*>(&value), size);
+
+        time_series_data(i) = value;
+    }
+
+    file.close();
+}
+
+
+/// This method loads associative data from a binary data file.
+
+void DataSet::load_auto_associative_data_binary(const string& auto_associative_data_file_name)
+{
+    std::ifstream file;
+
+    file.open(auto_associative_data_file_name.c_str(), ios::binary);
+
+    if(!file.is_open())
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: DataSet class.\n"
+               << "void load_auto_associative_data_binary(const string&) method.\n"
+               << "Cannot open binary file: " << auto_associative_data_file_name << "\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    streamsize size = sizeof(Index);
+
+    Index columns_number;
+    Index rows_number;
+
+    file.read(reinterpret_cast<char*>(&columns_number), size);
+    file.read(reinterpret_cast<char*>(&rows_number), size);
+
+    size = sizeof(type);
+
+    type value;
 
     associative_data.resize(rows_number, columns_number);
 
@@ -13085,11 +13932,26 @@ void DataSet::scrub_missing_values()
 
 }
 
+/// Reads the data file, which is a csv file.
+/// UTF-8 files are read through a memory mapping, and files with other codifications line by line.
+
 void DataSet::read_csv()
 {
+    data_shards.set();
+
+    batch_variables_scalers.resize(0);
+
+    batch_variables_descriptives.resize(0);
+
+    training_cache.set();
+
     read_csv_1();
 
-    if(!has_time_columns() && !has_categorical_columns())
+    if(codification == Codification::UTF8)
+    {
+        read_csv_mapped();
+    }
+    else if(!has_time_columns() && !has_categorical_columns())
     {
         read_csv_2_simple();
 
@@ -15039,62 +15901,195 @@ void DataSet::read_csv_2_simple()
 
     Index tokens_count;
 
-    if(display) cout << "Setting data dimensions..." << endl;
+    if(display) cout << "Setting data dimensions..." << endl;
+
+    const char separator_char = get_separator_char();
+
+    const Index columns_number = get_columns_number();
+    const Index raw_columns_number = has_rows_labels ? columns_number + 1 : columns_number;
+
+    while(file.good())
+    {
+        line_number++;
+
+        getline(file, line);
+
+        trim(line);
+
+        erase(line, '"');
+
+        if(line.empty()) continue;
+
+        tokens_count = count_tokens(line, separator_char);
+
+        if(tokens_count != raw_columns_number)
+        {
+            ostringstream buffer;
+
+            buffer << "OpenNN Exception: DataSet class.\n"
+                   << "void read_csv_2_simple() method.\n"
+                   << "Line " << line_number << ": Size of tokens("
+                   << tokens_count << ") is not equal to number of columns("
+                   << raw_columns_number << ").\n";
+
+            throw invalid_argument(buffer.str());
+        }
+
+        samples_count++;
+    }
+
+    file.close();
+
+    data.resize(samples_count, columns_number);
+
+    set_default_columns_uses();
+
+    samples_uses.resize(samples_count);
+    samples_uses.setConstant(SampleUse::Training);
+
+    split_samples_random();
+}
+
+
+void DataSet::read_csv_3_simple()
+{
+    std::regex accent_regex("[\\xC0-\\xFF]");
+    std::ifstream file;
+
+    #ifdef _WIN32
+
+    if (std::regex_search(data_file_name, accent_regex))
+    {
+        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
+        std::wstring file_name_wide = conv.from_bytes(data_file_name);
+        file.open(file_name_wide);
+    }else
+    {
+        file.open(data_file_name.c_str());
+    }
+
+    #else
+        file.open(data_file_name.c_str());
+    #endif
+
+    if(!file.is_open())
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: DataSet class.\n"
+               << "void read_csv_3_simple() method.\n"
+               << "Cannot open data file: " << data_file_name << "\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    const bool is_float = is_same<type, float>::value;
+
+    const char separator_char = get_separator_char();
+
+    string line;
+
+    // Read header
+
+    if(has_columns_names)
+    {
+        while(file.good())
+        {
+            getline(file, line);
+
+            line = decode(line);
+
+            if(line.empty()) continue;
+
+            break;
+        }
+    }
+
+    // Read data
+
+    const Index raw_columns_number = has_rows_labels ? get_columns_number() + 1 : get_columns_number();
+
+    Tensor<string, 1> tokens(raw_columns_number);
+
+    const Index samples_number = data.dimension(0);
+
+    if(has_rows_labels) rows_labels.resize(samples_number);
 
-    const char separator_char = get_separator_char();
+    if(display) cout << "Reading data..." << endl;
 
-    const Index columns_number = get_columns_number();
-    const Index raw_columns_number = has_rows_labels ? columns_number + 1 : columns_number;
+    Index sample_index = 0;
+    Index column_index = 0;
 
     while(file.good())
     {
-        line_number++;
-
         getline(file, line);
 
+        line = decode(line);
+
         trim(line);
 
         erase(line, '"');
 
         if(line.empty()) continue;
 
-        tokens_count = count_tokens(line, separator_char);
+        fill_tokens(line, separator_char, tokens);
 
-        if(tokens_count != raw_columns_number)
+        for(Index j = 0; j < raw_columns_number; j++)
         {
-            ostringstream buffer;
-
-            buffer << "OpenNN Exception: DataSet class.\n"
-                   << "void read_csv_2_simple() method.\n"
-                   << "Line " << line_number << ": Size of tokens("
-                   << tokens_count << ") is not equal to number of columns("
-                   << raw_columns_number << ").\n";
+            trim(tokens(j));
 
-            throw invalid_argument(buffer.str());
+            if(has_rows_labels && j == 0)
+            {
+                rows_labels(sample_index) = tokens(j);
+            }
+            else if(tokens(j) == missing_values_label || tokens(j).empty())
+            {
+                data(sample_index, column_index) = static_cast<type>(NAN);
+                column_index++;
+            }
+            else if(is_float)
+            {
+                data(sample_index, column_index) = type(strtof(tokens(j).data(), nullptr));
+                column_index++;
+            }
+            else
+            {
+                data(sample_index, column_index) = type(stof(tokens(j)));
+                column_index++;
+            }
         }
 
-        samples_count++;
+        column_index = 0;
+        sample_index++;
     }
 
+    const Index data_file_preview_index = has_columns_names ? 3 : 2;
+
+    data_file_preview(data_file_preview_index) = tokens;
+
     file.close();
 
-    data.resize(samples_count, columns_number);
+    if(display) cout << "Data read succesfully..." << endl;
 
-    set_default_columns_uses();
+    // Check Constant
 
-    samples_uses.resize(samples_count);
-    samples_uses.setConstant(SampleUse::Training);
+    check_constant_columns();
+
+    // Check Binary
+
+    if(display) cout << "Checking binary columns..." << endl;
+
+    set_binary_simple_columns();
 
-    split_samples_random();
 }
 
 
-void DataSet::read_csv_3_simple()
+void DataSet::read_csv_3_language_model()
 {
     std::regex accent_regex("[\\xC0-\\xFF]");
     std::ifstream file;
 
-    #ifdef _WIN32
+#ifdef _WIN32
 
     if (std::regex_search(data_file_name, accent_regex))
     {
@@ -15106,9 +16101,9 @@ void DataSet::read_csv_3_simple()
         file.open(data_file_name.c_str());
     }
 
-    #else
-        file.open(data_file_name.c_str());
-    #endif
+#else
+    file.open(data_file_name.c_str());
+#endif
 
     if(!file.is_open())
     {
@@ -15212,55 +16207,222 @@ void DataSet::read_csv_3_simple()
     // Check Constant
 
     check_constant_columns();
+}
 
-    // Check Binary
+void DataSet::read_csv_2_complete()
+{
+    regex accent_regex("[\\xC0-\\xFF]");
+    std::ifstream file;
 
-    if(display) cout << "Checking binary columns..." << endl;
+    #ifdef _WIN32
 
-    set_binary_simple_columns();
+    if(regex_search(data_file_name, accent_regex))
+    {
+        wstring_convert<codecvt_utf8<wchar_t>> conv;
+        wstring file_name_wide = conv.from_bytes(data_file_name);
+        file.open(file_name_wide);
+    }
+    else
+    {
+        file.open(data_file_name.c_str());
+    }
+#else
+    file.open(data_file_name.c_str());
+#endif
+
+
+    if(!file.is_open())
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: DataSet class.\n"
+               << "void read_csv_2_complete() method.\n"
+               << "Cannot open data file: " << data_file_name << "\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    const char separator_char = get_separator_char();
+
+    string line;
+
+    Tensor<string, 1> tokens;
+
+    Index lines_count = 0;
+    Index tokens_count;
+
+    const Index columns_number = columns.size();
+
+    for(Index j = 0; j < columns_number; j++)
+    {
+        if(columns(j).type != ColumnType::Categorical)
+        {
+            columns(j).column_use = VariableUse::Input;
+        }
+    }
+
+    // Skip header
+
+    if(has_columns_names)
+    {
+        while(file.good())
+        {
+            getline(file, line);
+
+            trim(line);
+
+            if(line.empty()) continue;
+
+            break;
+        }
+    }
+
+    // Read data
+
+    if(display) cout << "Setting data dimensions..." << endl;
+
+    const Index raw_columns_number = has_rows_labels ? columns_number + 1 : columns_number;
+
+    Index column_index = 0;
+
+    while(file.good())
+    {
+        getline(file, line);
+
+        line = decode(line);
+
+        trim(line);
+
+        erase(line, '"');
+
+        if(line.empty()) continue;
+
+        tokens = get_tokens(line, separator_char);
+
+        tokens_count = tokens.size();
+
+        if(static_cast<unsigned>(tokens_count) != raw_columns_number)
+        {
+            const string message =
+                    "Sample " + to_string(lines_count+1) + " error:\n"
+                                                           "Size of tokens (" + to_string(tokens_count) + ") is not equal to number of columns (" + to_string(raw_columns_number) + ").\n"
+                                                                                                                                                                                    "Please check the format of the data file (e.g: Use of commas both as decimal and column separator)";
+
+            throw invalid_argument(message);
+        }
+
+        for(unsigned j = 0; j < raw_columns_number; j++)
+        {
+            if(has_rows_labels && j == 0) continue;
+
+            if(columns(column_index).type == ColumnType::Categorical)
+            {
+                if(find(columns(column_index).categories.data(), columns(column_index).categories.data() + columns(column_index).categories.size(), tokens(j)) == (columns(column_index).categories.data() + columns(column_index).categories.size()))
+                {
+                    if(tokens(j) == missing_values_label || tokens(j).find(missing_values_label) != string::npos)
+                    {
+                        column_index++;
+                        continue;
+                    }
+
+                    columns(column_index).add_category(tokens(j));
+                }
+            }
+
+            column_index++;
+        }
+
+        column_index = 0;
+
+        lines_count++;
+    }
+
+    if(display) cout << "Setting types..." << endl;
+
+    for(Index j = 0; j < columns_number; j++)
+    {
+        if(columns(j).type == ColumnType::Categorical)
+        {
+            if(columns(j).categories.size() == 2)
+            {
+                columns(j).type = ColumnType::Binary;
+            }
+        }
+    }
+
+    file.close();
+
+    const Index samples_number = static_cast<unsigned>(lines_count);
+
+    const Index variables_number = get_variables_number();
+
+    data.resize(static_cast<Index>(samples_number), variables_number);
+    data.setZero();
+
+    if(has_rows_labels) rows_labels.resize(samples_number);
+
+    set_default_columns_uses();
+
+    samples_uses.resize(static_cast<Index>(samples_number));
+
+    samples_uses.setConstant(SampleUse::Training);
+
+    split_samples_random();
 
 }
 
 
-void DataSet::read_csv_3_language_model()
+void DataSet::read_csv_3_complete()
 {
-    std::regex accent_regex("[\\xC0-\\xFF]");
+    regex accent_regex("[\\xC0-\\xFF]");
     std::ifstream file;
 
-#ifdef _WIN32
+    #ifdef _WIN32
 
-    if (std::regex_search(data_file_name, accent_regex))
+    if(regex_search(data_file_name, accent_regex))
     {
-        std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
-        std::wstring file_name_wide = conv.from_bytes(data_file_name);
+        wstring_convert<codecvt_utf8<wchar_t>> conv;
+        wstring file_name_wide = conv.from_bytes(data_file_name);
         file.open(file_name_wide);
-    }else
+    }
+    else
     {
         file.open(data_file_name.c_str());
     }
 
-#else
-    file.open(data_file_name.c_str());
-#endif
+    #else
+        file.open(data_file_name.c_str());
+    #endif
+
 
     if(!file.is_open())
     {
         ostringstream buffer;
 
         buffer << "OpenNN Exception: DataSet class.\n"
-               << "void read_csv_3_simple() method.\n"
+               << "void read_csv_3_complete() method.\n"
                << "Cannot open data file: " << data_file_name << "\n";
 
         throw invalid_argument(buffer.str());
     }
 
-    const bool is_float = is_same<type, float>::value;
-
     const char separator_char = get_separator_char();
 
+    const Index columns_number = columns.size();
+
+    const Index raw_columns_number = has_rows_labels ? columns_number+1 : columns_number;
+
     string line;
 
-    // Read header
+    Tensor<string, 1> tokens;
+
+    string token;
+
+    unsigned sample_index = 0;
+    unsigned variable_index = 0;
+    unsigned column_index = 0;
+
+    // Skip header
 
     if(has_columns_names)
     {
@@ -15270,6 +16432,8 @@ void DataSet::read_csv_3_language_model()
 
             line = decode(line);
 
+            trim(line);
+
             if(line.empty()) continue;
 
             break;
@@ -15278,19 +16442,8 @@ void DataSet::read_csv_3_language_model()
 
     // Read data
 
-    const Index raw_columns_number = has_rows_labels ? get_columns_number() + 1 : get_columns_number();
-
-    Tensor<string, 1> tokens(raw_columns_number);
-
-    const Index samples_number = data.dimension(0);
-
-    if(has_rows_labels) rows_labels.resize(samples_number);
-
     if(display) cout << "Reading data..." << endl;
 
-    Index sample_index = 0;
-    Index column_index = 0;
-
     while(file.good())
     {
         getline(file, line);
@@ -15303,34 +16456,115 @@ void DataSet::read_csv_3_language_model()
 
         if(line.empty()) continue;
 
-        fill_tokens(line, separator_char, tokens);
+        tokens = get_tokens(line, separator_char);
+
+        variable_index = 0;
+        column_index = 0;
 
         for(Index j = 0; j < raw_columns_number; j++)
         {
             trim(tokens(j));
 
-            if(has_rows_labels && j == 0)
+            if(has_rows_labels && j ==0)
             {
                 rows_labels(sample_index) = tokens(j);
+                continue;
             }
-            else if(tokens(j) == missing_values_label || tokens(j).empty())
+            else if(columns(column_index).type == ColumnType::Numeric)
             {
-                data(sample_index, column_index) = static_cast<type>(NAN);
-                column_index++;
+                if(tokens(j) == missing_values_label || tokens(j).empty())
+                {
+                    data(sample_index, variable_index) = static_cast<type>(NAN);
+                    variable_index++;
+                }
+                else
+                {
+                    try
+                    {
+                        data(sample_index, variable_index) = static_cast<type>(stod(tokens(j)));
+                        variable_index++;
+                    }
+                    catch(const invalid_argument& e)
+                    {
+                        ostringstream buffer;
+
+                        buffer << "OpenNN Exception: DataSet class.\n"
+                               << "void read_csv_3_complete() method.\n"
+                               << "Sample " << sample_index << "; Invalid number: " << tokens(j) << "\n";
+
+                        throw invalid_argument(buffer.str());
+                    }
+                }
             }
-            else if(is_float)
+            else if(columns(column_index).type == ColumnType::DateTime)
             {
-                data(sample_index, column_index) = type(strtof(tokens(j).data(), nullptr));
-                column_index++;
+                if(tokens(j) == missing_values_label || tokens(j).empty())
+                {
+                    data(sample_index, variable_index) = static_cast<type>(NAN);
+                    variable_index++;
+                }
+                else
+                {
+                    data(sample_index, variable_index) = static_cast<type>(date_to_timestamp(tokens(j), gmt));
+                    variable_index++;
+                }
             }
-            else
+            else if(columns(column_index).type == ColumnType::Categorical)
             {
-                data(sample_index, column_index) = type(stof(tokens(j)));
-                column_index++;
+                for(Index k = 0; k < columns(column_index).get_categories_number(); k++)
+                {
+                    if(tokens(j) == missing_values_label)
+                    {
+                        data(sample_index, variable_index) = static_cast<type>(NAN);
+                    }
+                    else if(tokens(j) == columns(column_index).categories(k))
+                    {
+                        data(sample_index, variable_index) = type(1);
+                    }
+
+                    variable_index++;
+                }
+            }
+            else if(columns(column_index).type == ColumnType::Binary)
+            {
+                string lower_case_token = tokens(j);
+
+                trim(lower_case_token);
+                transform(lower_case_token.begin(), lower_case_token.end(), lower_case_token.begin(), ::tolower);
+
+                Tensor<string,1> positive_words(5);
+                Tensor<string,1> negative_words(5);
+
+                positive_words.setValues({"yes", "positive", "+", "true", "si"});
+                negative_words.setValues({"no", "negative", "-", "false", "no"});
+
+                if(tokens(j) == missing_values_label || tokens(j).find(missing_values_label) != string::npos)
+                {
+                    data(sample_index, variable_index) = static_cast<type>(NAN);
+                }
+                else if( contains(positive_words, lower_case_token) )
+                {
+                    data(sample_index, variable_index) = type(1);
+                }
+                else if( contains(negative_words, lower_case_token) )
+                {
+                    data(sample_index, variable_index) = type(0);
+                }
+                else if(columns(column_index).categories.size() > 0 && tokens(j) == columns(column_index).categories(0))
+                {
+                    data(sample_index, variable_index) = type(1);
+                }
+                else if(tokens(j) == columns(column_index).name)
+                {
+                    data(sample_index, variable_index) = type(1);
+                }
+
+                variable_index++;
             }
+
+            column_index++;
         }
 
-        column_index = 0;
         sample_index++;
     }
 
@@ -15338,387 +16572,370 @@ void DataSet::read_csv_3_language_model()
 
     data_file_preview(data_file_preview_index) = tokens;
 
-    file.close();
-
     if(display) cout << "Data read succesfully..." << endl;
 
-    // Check Constant
-
-    check_constant_columns();
-}
+    file.close();
 
-void DataSet::read_csv_2_complete()
-{
-    regex accent_regex("[\\xC0-\\xFF]");
-    std::ifstream file;
+    // Check Constant and DateTime to unused
 
-    #ifdef _WIN32
+    check_constant_columns();
 
-    if(regex_search(data_file_name, accent_regex))
-    {
-        wstring_convert<codecvt_utf8<wchar_t>> conv;
-        wstring file_name_wide = conv.from_bytes(data_file_name);
-        file.open(file_name_wide);
-    }
-    else
-    {
-        file.open(data_file_name.c_str());
-    }
-#else
-    file.open(data_file_name.c_str());
-#endif
+    // Check binary
 
+    if(display) cout << "Checking binary columns..." << endl;
 
-    if(!file.is_open())
-    {
-        ostringstream buffer;
+    set_binary_simple_columns();
+}
 
-        buffer << "OpenNN Exception: DataSet class.\n"
-               << "void read_csv_2_complete() method.\n"
-               << "Cannot open data file: " << data_file_name << "\n";
 
-        throw invalid_argument(buffer.str());
-    }
+/// Reads the data of the csv file, whose columns have been set from the preview, through a memory mapping of the file.
+/// The lines are read concurrently in chunks, and numeric tokens are converted straight into the data matrix.
+/// When there are categorical columns, a first pass collects the categories of each chunk in order of appearance,
+/// and they are merged in the order of the chunks, so that the categories are the same as reading the file sequentially.
 
+void DataSet::read_csv_mapped()
+{
     const char separator_char = get_separator_char();
 
-    string line;
-
-    Tensor<string, 1> tokens;
-
-    Index lines_count = 0;
-    Index tokens_count;
-
-    const Index columns_number = columns.size();
-
-    for(Index j = 0; j < columns_number; j++)
-    {
-        if(columns(j).type != ColumnType::Categorical)
-        {
-            columns(j).column_use = VariableUse::Input;
-        }
-    }
-
-    // Skip header
+    CsvReader csv_reader(data_file_name, separator_char, has_columns_names);
 
-    if(has_columns_names)
-    {
-        while(file.good())
-        {
-            getline(file, line);
+    if(display) cout << "Setting data dimensions..." << endl;
 
-            trim(line);
+    csv_reader.count_samples();
 
-            if(line.empty()) continue;
+    const Index samples_number = csv_reader.get_samples_number();
+    const Index chunks_number = csv_reader.get_chunks_number();
 
-            break;
-        }
-    }
+    const Index columns_number = get_columns_number();
+    const Index raw_columns_number = has_rows_labels ? columns_number + 1 : columns_number;
 
-    // Read data
+    const bool is_simple = !has_time_columns() && !has_categorical_columns();
 
-    if(display) cout << "Setting data dimensions..." << endl;
+    // Tokens, with buffers for each chunk
 
-    const Index raw_columns_number = has_rows_labels ? columns_number + 1 : columns_number;
+    vector<vector<CsvReader::Token>> chunks_tokens(static_cast<size_t>(chunks_number));
+    vector<Tensor<string, 1>> chunks_strings(static_cast<size_t>(chunks_number));
 
-    Index column_index = 0;
+    // The categories are collected from tokens with their whitespace, as the line reader does
 
-    while(file.good())
+    const auto get_line_tokens = [&](const Index& chunk_index,
+                                     const Index& line_number,
+                                     const CsvReader::Token& line,
+                                     const bool& trim_tokens) -> const vector<CsvReader::Token>&
     {
-        getline(file, line);
+        vector<CsvReader::Token>& tokens = chunks_tokens[size_t(chunk_index)];
 
-        line = decode(line);
-
-        trim(line);
-
-        erase(line, '"');
+        if(CsvReader::split_tokens(line, separator_char, tokens))
+        {
+            if(!trim_tokens)
+            {
+                for(CsvReader::Token& token : tokens)
+                {
+                    while(token.begin > line.begin && *(token.begin - 1) != separator_char) token.begin--;
+                    while(token.end < line.end && *token.end != separator_char) token.end++;
+                }
+            }
+        }
+        else
+        {
+            // Lines with quotes or missing tokens go through the general tokenizer
 
-        if(line.empty()) continue;
+            Tensor<string, 1>& strings = chunks_strings[size_t(chunk_index)];
 
-        tokens = get_tokens(line, separator_char);
+            string line_string = line.to_string();
 
-        tokens_count = tokens.size();
+            trim(line_string);
 
-        if(static_cast<unsigned>(tokens_count) != raw_columns_number)
-        {
-            const string message =
-                    "Sample " + to_string(lines_count+1) + " error:\n"
-                                                           "Size of tokens (" + to_string(tokens_count) + ") is not equal to number of columns (" + to_string(raw_columns_number) + ").\n"
-                                                                                                                                                                                    "Please check the format of the data file (e.g: Use of commas both as decimal and column separator)";
+            erase(line_string, '"');
 
-            throw invalid_argument(message);
-        }
+            strings = get_tokens(line_string, separator_char);
 
-        for(unsigned j = 0; j < raw_columns_number; j++)
-        {
-            if(has_rows_labels && j == 0) continue;
+            tokens.resize(size_t(strings.size()));
 
-            if(columns(column_index).type == ColumnType::Categorical)
+            for(Index i = 0; i < strings.size(); i++)
             {
-                if(find(columns(column_index).categories.data(), columns(column_index).categories.data() + columns(column_index).categories.size(), tokens(j)) == (columns(column_index).categories.data() + columns(column_index).categories.size()))
-                {
-                    if(tokens(j) == missing_values_label || tokens(j).find(missing_values_label) != string::npos)
-                    {
-                        column_index++;
-                        continue;
-                    }
+                if(trim_tokens) trim(strings(i));
 
-                    columns(column_index).add_category(tokens(j));
-                }
+                tokens[size_t(i)] = {strings(i).data(), strings(i).data() + strings(i).size()};
             }
+        }
+
+        if(Index(tokens.size()) != raw_columns_number)
+        {
+            ostringstream buffer;
 
-            column_index++;
-        }
+            buffer << "OpenNN Exception: DataSet class.\n"
+                   << "void read_csv_mapped() method.\n"
+                   << "Line " << line_number << ": Size of tokens("
+                   << tokens.size() << ") is not equal to number of columns("
+                   << raw_columns_number << ").\n";
 
-        column_index = 0;
+            throw invalid_argument(buffer.str());
+        }
 
-        lines_count++;
-    }
+        return tokens;
+    };
 
-    if(display) cout << "Setting types..." << endl;
+    // Categories
 
-    for(Index j = 0; j < columns_number; j++)
+    if(!is_simple)
     {
-        if(columns(j).type == ColumnType::Categorical)
+        for(Index j = 0; j < columns_number; j++)
         {
-            if(columns(j).categories.size() == 2)
+            if(columns(j).type != ColumnType::Categorical)
             {
-                columns(j).type = ColumnType::Binary;
+                columns(j).column_use = VariableUse::Input;
             }
         }
-    }
 
-    file.close();
+        struct Categories
+        {
+            void add(const string_view& category)
+            {
+                if(names_set.count(category) != 0) return;
 
-    const Index samples_number = static_cast<unsigned>(lines_count);
+                names.emplace_back(category);
+                names_set.insert(string_view(names.back()));
+            }
 
-    const Index variables_number = get_variables_number();
+            deque<string> names;
+            unordered_set<string_view> names_set;
+        };
 
-    data.resize(static_cast<Index>(samples_number), variables_number);
-    data.setZero();
+        vector<vector<Categories>> chunks_categories(static_cast<size_t>(chunks_number), vector<Categories>(static_cast<size_t>(columns_number)));
 
-    if(has_rows_labels) rows_labels.resize(samples_number);
+        csv_reader.read_lines([&](const Index& chunk_index, const Index& line_number, const CsvReader::Token& line)
+        {
+            const vector<CsvReader::Token>& tokens = get_line_tokens(chunk_index, line_number, line, false);
 
-    set_default_columns_uses();
+            vector<Categories>& categories = chunks_categories[size_t(chunk_index)];
 
-    samples_uses.resize(static_cast<Index>(samples_number));
+            for(Index j = has_rows_labels ? 1 : 0; j < raw_columns_number; j++)
+            {
+                const Index column_index = has_rows_labels ? j - 1 : j;
 
-    samples_uses.setConstant(SampleUse::Training);
+                if(columns(column_index).type != ColumnType::Categorical) continue;
 
-    split_samples_random();
+                const string_view token(tokens[size_t(j)].begin, size_t(tokens[size_t(j)].size()));
 
-}
+                if(token.find(missing_values_label) != string_view::npos) continue;
 
+                categories[size_t(column_index)].add(token);
+            }
+        });
 
-void DataSet::read_csv_3_complete()
-{
-    regex accent_regex("[\\xC0-\\xFF]");
-    std::ifstream file;
+        if(display) cout << "Setting types..." << endl;
 
-    #ifdef _WIN32
+        for(Index j = 0; j < columns_number; j++)
+        {
+            if(columns(j).type != ColumnType::Categorical) continue;
 
-    if(regex_search(data_file_name, accent_regex))
-    {
-        wstring_convert<codecvt_utf8<wchar_t>> conv;
-        wstring file_name_wide = conv.from_bytes(data_file_name);
-        file.open(file_name_wide);
-    }
-    else
-    {
-        file.open(data_file_name.c_str());
-    }
+            Categories column_categories;
 
-    #else
-        file.open(data_file_name.c_str());
-    #endif
+            for(Index i = 0; i < chunks_number; i++)
+                for(const string& category : chunks_categories[size_t(i)][size_t(j)].names)
+                    column_categories.add(category);
 
+            const Index categories_number = Index(column_categories.names.size());
 
-    if(!file.is_open())
-    {
-        ostringstream buffer;
+            columns(j).categories.resize(categories_number);
+            copy(column_categories.names.begin(), column_categories.names.end(), columns(j).categories.data());
 
-        buffer << "OpenNN Exception: DataSet class.\n"
-               << "void read_csv_3_complete() method.\n"
-               << "Cannot open data file: " << data_file_name << "\n";
+            columns(j).categories_uses.resize(categories_number);
+            columns(j).categories_uses.setConstant(columns(j).column_use);
 
-        throw invalid_argument(buffer.str());
+            if(categories_number == 2) columns(j).type = ColumnType::Binary;
+        }
     }
 
-    const char separator_char = get_separator_char();
+    // Data dimensions
 
-    const Index columns_number = columns.size();
+    data.resize(samples_number, get_variables_number());
 
-    const Index raw_columns_number = has_rows_labels ? columns_number+1 : columns_number;
+    if(!is_simple) data.setZero();
 
-    string line;
+    if(has_rows_labels) rows_labels.resize(samples_number);
 
-    Tensor<string, 1> tokens;
+    set_default_columns_uses();
 
-    string token;
+    samples_uses.resize(samples_number);
+    samples_uses.setConstant(SampleUse::Training);
 
-    unsigned sample_index = 0;
-    unsigned variable_index = 0;
-    unsigned column_index = 0;
+    split_samples_random();
 
-    // Skip header
+    // Data
 
-    if(has_columns_names)
-    {
-        while(file.good())
-        {
-            getline(file, line);
+    if(display) cout << "Reading data..." << endl;
 
-            line = decode(line);
+    Tensor<Index, 1> columns_variables_begins(columns_number);
 
-            trim(line);
+    vector<unordered_map<string_view, Index>> columns_categories_indices(static_cast<size_t>(columns_number));
 
-            if(line.empty()) continue;
+    Index variables_count = 0;
 
-            break;
-        }
-    }
+    for(Index j = 0; j < columns_number; j++)
+    {
+        columns_variables_begins(j) = variables_count;
 
-    // Read data
+        variables_count += columns(j).get_variables_number();
 
-    if(display) cout << "Reading data..." << endl;
+        if(columns(j).type != ColumnType::Categorical) continue;
 
-    while(file.good())
-    {
-        getline(file, line);
+        for(Index k = 0; k < columns(j).categories.size(); k++)
+            columns_categories_indices[size_t(j)].emplace(string_view(columns(j).categories(k)), k);
+    }
 
-        line = decode(line);
+    const bool is_float = is_same<type, float>::value;
 
-        trim(line);
+    Tensor<string, 1> positive_words(5);
+    Tensor<string, 1> negative_words(5);
 
-        erase(line, '"');
+    positive_words.setValues({"yes", "positive", "+", "true", "si"});
+    negative_words.setValues({"no", "negative", "-", "false", "no"});
 
-        if(line.empty()) continue;
+    vector<Index> chunks_samples_indices(static_cast<size_t>(chunks_number));
 
-        tokens = get_tokens(line, separator_char);
+    for(Index i = 0; i < chunks_number; i++)
+        chunks_samples_indices[size_t(i)] = csv_reader.get_chunk_samples_begin(i);
 
-        variable_index = 0;
-        column_index = 0;
+    csv_reader.read_lines([&](const Index& chunk_index, const Index& line_number, const CsvReader::Token& line)
+    {
+        const vector<CsvReader::Token>& tokens = get_line_tokens(chunk_index, line_number, line, true);
+
+        Index& sample_index = chunks_samples_indices[size_t(chunk_index)];
 
         for(Index j = 0; j < raw_columns_number; j++)
         {
-            trim(tokens(j));
+            const CsvReader::Token& token = tokens[size_t(j)];
 
-            if(has_rows_labels && j ==0)
+            if(has_rows_labels && j == 0)
             {
-                rows_labels(sample_index) = tokens(j);
+                rows_labels(sample_index) = token.to_string();
                 continue;
             }
-            else if(columns(column_index).type == ColumnType::Numeric)
+
+            const Index column_index = has_rows_labels ? j - 1 : j;
+
+            const Column& column = columns(column_index);
+
+            const Index variable_index = columns_variables_begins(column_index);
+
+            if(column.type == ColumnType::Numeric)
             {
-                if(tokens(j) == missing_values_label || tokens(j).empty())
+                if(token.empty() || token == missing_values_label)
                 {
                     data(sample_index, variable_index) = static_cast<type>(NAN);
-                    variable_index++;
                 }
-                else
+                else if(!CsvReader::parse_number(token, data(sample_index, variable_index)))
                 {
-                    try
+                    const string number = token.to_string();
+
+                    if(is_simple)
                     {
-                        data(sample_index, variable_index) = static_cast<type>(stod(tokens(j)));
-                        variable_index++;
+                        data(sample_index, variable_index) = is_float
+                                ? type(strtof(number.c_str(), nullptr))
+                                : type(strtod(number.c_str(), nullptr));
                     }
-                    catch(const invalid_argument& e)
+                    else
                     {
-                        ostringstream buffer;
+                        try
+                        {
+                            data(sample_index, variable_index) = static_cast<type>(stod(number));
+                        }
+                        catch(const invalid_argument&)
+                        {
+                            ostringstream buffer;
 
-                        buffer << "OpenNN Exception: DataSet class.\n"
-                               << "void read_csv_3_complete() method.\n"
-                               << "Sample " << sample_index << "; Invalid number: " << tokens(j) << "\n";
+                            buffer << "OpenNN Exception: DataSet class.\n"
+                                   << "void read_csv_mapped() method.\n"
+                                   << "Sample " << sample_index << "; Invalid number: " << number << "\n";
 
-                        throw invalid_argument(buffer.str());
+                            throw invalid_argument(buffer.str());
+                        }
                     }
                 }
             }
-            else if(columns(column_index).type == ColumnType::DateTime)
+            else if(column.type == ColumnType::DateTime)
             {
-                if(tokens(j) == missing_values_label || tokens(j).empty())
+                data(sample_index, variable_index) = token.empty() || token == missing_values_label
+                        ? static_cast<type>(NAN)
+                        : static_cast<type>(date_to_timestamp(token.to_string(), gmt));
+            }
+            else if(column.type == ColumnType::Categorical)
+            {
+                if(token == missing_values_label)
                 {
-                    data(sample_index, variable_index) = static_cast<type>(NAN);
-                    variable_index++;
+                    for(Index k = 0; k < column.categories.size(); k++)
+                        data(sample_index, variable_index + k) = static_cast<type>(NAN);
                 }
                 else
                 {
-                    data(sample_index, variable_index) = static_cast<type>(date_to_timestamp(tokens(j), gmt));
-                    variable_index++;
-                }
-            }
-            else if(columns(column_index).type == ColumnType::Categorical)
-            {
-                for(Index k = 0; k < columns(column_index).get_categories_number(); k++)
-                {
-                    if(tokens(j) == missing_values_label)
-                    {
-                        data(sample_index, variable_index) = static_cast<type>(NAN);
-                    }
-                    else if(tokens(j) == columns(column_index).categories(k))
-                    {
-                        data(sample_index, variable_index) = type(1);
-                    }
+                    const unordered_map<string_view, Index>& categories_indices = columns_categories_indices[size_t(column_index)];
 
-                    variable_index++;
+                    const auto category = categories_indices.find(string_view(token.begin, size_t(token.size())));
+
+                    if(category != categories_indices.end())
+                        data(sample_index, variable_index + category->second) = type(1);
                 }
             }
-            else if(columns(column_index).type == ColumnType::Binary)
+            else if(column.type == ColumnType::Binary)
             {
-                string lower_case_token = tokens(j);
+                string lower_case_token = token.to_string();
 
-                trim(lower_case_token);
                 transform(lower_case_token.begin(), lower_case_token.end(), lower_case_token.begin(), ::tolower);
 
-                Tensor<string,1> positive_words(5);
-                Tensor<string,1> negative_words(5);
-
-                positive_words.setValues({"yes", "positive", "+", "true", "si"});
-                negative_words.setValues({"no", "negative", "-", "false", "no"});
-
-                if(tokens(j) == missing_values_label || tokens(j).find(missing_values_label) != string::npos)
+                if(token.to_string().find(missing_values_label) != string::npos)
                 {
                     data(sample_index, variable_index) = static_cast<type>(NAN);
                 }
-                else if( contains(positive_words, lower_case_token) )
+                else if(contains(positive_words, lower_case_token))
                 {
                     data(sample_index, variable_index) = type(1);
                 }
-                else if( contains(negative_words, lower_case_token) )
+                else if(contains(negative_words, lower_case_token))
                 {
                     data(sample_index, variable_index) = type(0);
                 }
-                else if(columns(column_index).categories.size() > 0 && tokens(j) == columns(column_index).categories(0))
+                else if(column.categories.size() > 0 && token == column.categories(0))
                 {
                     data(sample_index, variable_index) = type(1);
                 }
-                else if(tokens(j) == columns(column_index).name)
+                else if(token == column.name)
                 {
                     data(sample_index, variable_index) = type(1);
                 }
-
-                variable_index++;
             }
-
-            column_index++;
         }
 
         sample_index++;
-    }
+    });
 
-    const Index data_file_preview_index = has_columns_names ? 3 : 2;
+    // Preview of the last line
 
-    data_file_preview(data_file_preview_index) = tokens;
+    const CsvReader::Token last_line = csv_reader.get_last_line();
 
-    if(display) cout << "Data read succesfully..." << endl;
+    if(!last_line.empty())
+    {
+        string line = last_line.to_string();
 
-    file.close();
+        trim(line);
 
-    // Check Constant and DateTime to unused
+        erase(line, '"');
+
+        Tensor<string, 1> tokens = get_tokens(line, separator_char);
+
+        for(Index i = 0; i < tokens.size(); i++) trim(tokens(i));
+
+        data_file_preview(has_columns_names ? 3 : 2) = tokens;
+    }
+
+    if(display) cout << "Data read succesfully..." << endl;
+
+    // Check Constant
 
     check_constant_columns();
 
-    // Check binary
+    // Check Binary
 
     if(display) cout << "Checking binary columns..." << endl;
 
@@ -16092,12 +17309,41 @@ void DataSetBatch::fill(const Tensor<Index, 1>& samples,
                         const Tensor<Index, 1>& inputs,
                         const Tensor<Index, 1>& targets)
 {
+    if(data_set_pointer->has_data_shards())
+    {
+        fill_from_data_shards(samples, inputs, targets);
+
+        return;
+    }
+
     const Tensor<type, 2>& data = data_set_pointer->get_data();
     const Tensor<Index, 1>& input_variables_dimensions = data_set_pointer->get_input_variables_dimensions();
 
+    const TrainingCache& training_cache = data_set_pointer->get_training_cache();
+
+    const Tensor<Index, 1> input_categories_numbers = data_set_pointer->get_input_categories_numbers();
+
+    if(input_categories_numbers.size() != 0)
+    {
+        fill_input_codes(samples, inputs, targets, input_categories_numbers);
+
+        return;
+    }
+
+    if(input_variables_dimensions.size() == 1 && training_cache.has_variables(inputs, targets))
+    {
+        training_cache.fill_inputs(samples, this->inputs(0).get_data());
+        training_cache.fill_targets(samples, this->targets.get_data());
+
+        data_set_pointer->scale_submatrix(inputs, samples.size(), this->inputs(0).get_data());
+        data_set_pointer->scale_submatrix(targets, samples.size(), this->targets.get_data());
+
+        return;
+    }
+
     if(input_variables_dimensions.size() == 1)
     {
-        fill_submatrix(data, samples, inputs, this->inputs(0).get_data());
+        data_set_pointer->fill_scaled_submatrix(samples, inputs, this->inputs(0).get_data());
     }
     else if(input_variables_dimensions.size() == 3)
     {
@@ -16119,7 +17365,7 @@ void DataSetBatch::fill(const Tensor<Index, 1>& samples,
                 {
                     for(Index channel = 0; channel < channels_number ; channel++)
                     {
-                        inputs(image, row, column, channel) = data(image, index);
+                        inputs(image, row, column, channel) = data(samples(image), index);
 
                         index++;
                     }
@@ -16129,83 +17375,104 @@ void DataSetBatch::fill(const Tensor<Index, 1>& samples,
 
         const bool augmentation = data_set_pointer->get_augmentation();
 
-        if(augmentation) perform_augmentation();
+        if(augmentation) perform_augmentation(samples);
     }
-    fill_submatrix(data, samples, targets, this->targets.get_data());
+    data_set_pointer->fill_scaled_submatrix(samples, targets, this->targets.get_data());
 }
 
 
-void DataSetBatch::perform_augmentation()
-{
-    const Tensor<Index, 1>& input_variables_dimensions = data_set_pointer->get_input_variables_dimensions();
+/// Fills the batch with the categorical inputs as the codes of their categories, from the training cache if it holds them.
+/// The input columns which are not codes and the targets are scaled with the scalers set by the data set.
+/// @param samples Indices of the samples of the batch.
+/// @param inputs Indices of the input variables.
+/// @param targets Indices of the target variables.
+/// @param input_categories_numbers Number of categories of each input code, or zero for the other inputs.
 
-    const Index rows_number = input_variables_dimensions(0);
-    const Index columns_number = input_variables_dimensions(1);
-    const Index channels_number = input_variables_dimensions(2);
-    const Index input_size = rows_number*columns_number*channels_number;
+void DataSetBatch::fill_input_codes(const Tensor<Index, 1>& samples,
+                                    const Tensor<Index, 1>& inputs,
+                                    const Tensor<Index, 1>& targets,
+                                    const Tensor<Index, 1>& input_categories_numbers)
+{
+    const Index samples_number = samples.size();
 
-//    TensorMap<Tensor<type, 4>> inputs(inputs_data,
-//                                      batch_size,
-//                                      rows_number,
-//                                      columns_number,
-//                                      channels_number);
+    const Tensor<Index, 1> input_codes_variables_indices = data_set_pointer->get_input_codes_variables_indices();
 
-    const bool random_reflection_axis_x = data_set_pointer->get_random_reflection_axis_x();
-    const bool random_reflection_axis_y = data_set_pointer->get_random_reflection_axis_y();
-    const type random_rotation_minimum = data_set_pointer->get_random_rotation_minimum();
-    const type random_rotation_maximum = data_set_pointer->get_random_rotation_maximum();
-    const type random_rescaling_minimum = type(0);
-    const type random_rescaling_maximum = type(0);
-    const type random_horizontal_translation_minimum = data_set_pointer->get_random_horizontal_translation_minimum();
-    const type random_horizontal_translation_maximum = data_set_pointer->get_random_horizontal_translation_maximum();
-    const type random_vertical_translation_minimum = data_set_pointer->get_random_vertical_translation_minimum();
-    const type random_vertical_translation_maximum = data_set_pointer->get_random_vertical_translation_maximum();
+    const TrainingCache& training_cache = data_set_pointer->get_training_cache();
 
-    for(Index batch = 0; batch < batch_size; batch++)
+    if(training_cache.has_variables(inputs, targets, input_categories_numbers))
     {
+        training_cache.fill_inputs(samples, this->inputs(0).get_data());
+        training_cache.fill_targets(samples, this->targets.get_data());
 
-        TensorMap<Tensor<type, 3>> current_image((this->inputs(0).get_data()) + batch*input_size,
-                                                 rows_number,
-                                                 columns_number,
-                                                 channels_number);
+        data_set_pointer->scale_submatrix(input_codes_variables_indices, samples_number, this->inputs(0).get_data());
+        data_set_pointer->scale_submatrix(targets, samples_number, this->targets.get_data());
 
-        if(random_reflection_axis_x)
-        {
-            reflect_image_x(current_image, current_image);
-        }
+        return;
+    }
 
-        if(random_reflection_axis_y)
-        {
-            reflect_image_y(current_image, current_image);
-        }
+    data_set_pointer->fill_input_codes_submatrix(samples, inputs, input_categories_numbers, this->inputs(0).get_data());
+    data_set_pointer->fill_scaled_submatrix(samples, targets, this->targets.get_data());
+}
 
-        if(random_rotation_minimum != 0 && random_rotation_maximum != 0)
-        {
-            const type angle = (random_rotation_minimum < random_rotation_maximum)
-                    ? random_rotation_minimum + rand()
-                    : random_rotation_maximum;
 
-            rotate_image(current_image, current_image, angle);
-        }
+/// Fills the batch with the samples of the data shards, which are read from the mapped files,
+/// and then scales the variables with the scalers set by the data set.
+/// Only inputs with one dimension are read from the shards.
 
-        if(random_rescaling_minimum != 0 && random_rescaling_maximum != 0)
-        {
-            const type rescaling = (random_rescaling_minimum < random_rescaling_maximum)
-                    ? random_rescaling_minimum + rand()
-                    : random_rescaling_maximum;
+void DataSetBatch::fill_from_data_shards(const Tensor<Index, 1>& samples,
+                                         const Tensor<Index, 1>& inputs,
+                                         const Tensor<Index, 1>& targets)
+{
+    if(data_set_pointer->get_input_variables_dimensions().size() > 1)
+    {
+        ostringstream buffer;
 
-//            rescale_image(current_image, current_image, rescaling);
-        }
+        buffer << "OpenNN Exception: DataSetBatch class.\n"
+               << "void fill_from_data_shards(const Tensor<Index, 1>&, const Tensor<Index, 1>&, const Tensor<Index, 1>&) method.\n"
+               << "Inputs of data shards must have one dimension.\n";
 
-        if(random_horizontal_translation_minimum != 0 && random_horizontal_translation_maximum != 0)
-        {
-            const type translation = (random_horizontal_translation_minimum < random_rescaling_maximum)
-                    ? random_horizontal_translation_minimum + rand()
-                    : random_rescaling_maximum;
+        throw invalid_argument(buffer.str());
+    }
 
-            translate_image(current_image, current_image, translation);
-        }
+    if(data_set_pointer->get_input_categories_numbers().size() != 0)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: DataSetBatch class.\n"
+               << "void fill_from_data_shards(const Tensor<Index, 1>&, const Tensor<Index, 1>&, const Tensor<Index, 1>&) method.\n"
+               << "Categorical inputs codes are not read from data shards.\n";
+
+        throw invalid_argument(buffer.str());
     }
+
+    const DataShards& data_shards = data_set_pointer->get_data_shards();
+
+    const Index samples_number = samples.size();
+
+    data_shards.fill_submatrix(samples, inputs, this->inputs(0).get_data());
+    data_set_pointer->scale_submatrix(inputs, samples_number, this->inputs(0).get_data());
+
+    data_shards.fill_submatrix(samples, targets, this->targets.get_data());
+    data_set_pointer->scale_submatrix(targets, samples_number, this->targets.get_data());
+}
+
+
+/// Applies the random reflections, rotations and translations of the data set to the images of the batch, in place.
+/// The transformations are drawn from the augmentation seed of the batch and the indices of its samples.
+/// @param samples Indices in the data set of the samples of the batch.
+
+void DataSetBatch::perform_augmentation(const Tensor<Index, 1>& samples)
+{
+    image_augmentation.set_random_reflection_axis_x(data_set_pointer->get_random_reflection_axis_x());
+    image_augmentation.set_random_reflection_axis_y(data_set_pointer->get_random_reflection_axis_y());
+    image_augmentation.set_random_rotation_minimum(data_set_pointer->get_random_rotation_minimum());
+    image_augmentation.set_random_rotation_maximum(data_set_pointer->get_random_rotation_maximum());
+    image_augmentation.set_random_horizontal_translation_minimum(data_set_pointer->get_random_horizontal_translation_minimum());
+    image_augmentation.set_random_horizontal_translation_maximum(data_set_pointer->get_random_horizontal_translation_maximum());
+    image_augmentation.set_random_vertical_translation_minimum(data_set_pointer->get_random_vertical_translation_minimum());
+    image_augmentation.set_random_vertical_translation_maximum(data_set_pointer->get_random_vertical_translation_maximum());
+
+    image_augmentation.augment(this->inputs(0).get_data(), batch_size, samples, augmentation_seed);
 }
 
 
@@ -16221,7 +17488,7 @@ void DataSetBatch::set(const Index& new_batch_size, DataSet* new_data_set_pointe
 
     data_set_pointer = new_data_set_pointer;
 
-    const Index input_variables_number = data_set_pointer->get_input_variables_number();
+    const Index input_codes_number = data_set_pointer->get_input_codes_number();
     const Index target_variables_number = data_set_pointer->get_target_variables_number();
 
     const Tensor<Index, 1> input_variables_dimensions = data_set_pointer->get_input_variables_dimensions();
@@ -16231,7 +17498,7 @@ void DataSetBatch::set(const Index& new_batch_size, DataSet* new_data_set_pointe
         inputs.resize(1);
 
         Tensor<Index, 1> inputs_dimensions(2);
-        inputs_dimensions.setValues({batch_size, input_variables_number});
+        inputs_dimensions.setValues({batch_size, input_codes_number});
 
         inputs(0).set_dimensions(inputs_dimensions);
     }
@@ -16246,6 +17513,8 @@ void DataSetBatch::set(const Index& new_batch_size, DataSet* new_data_set_pointe
 
         inputs.resize(1);
         inputs(0) = DynamicTensor<type>(inputs_dimensions);
+
+        image_augmentation.set(input_variables_dimensions(0), input_variables_dimensions(1), input_variables_dimensions(2));
     }
 
     Tensor<Index, 1> targets_dimensions(2);
@@ -29,6 +29,10 @@
 #include <stdio.h>
 #include <limits.h>
 #include <list>
+#include <deque>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 #include <filesystem>
 //#include <experimental/filesystem>
 
@@ -38,7 +42,14 @@
 // OpenNN includes
 
 #include "config.h"
+#include "execution_context.h"
+#include "csv_reader.h"
+#include "binary_data_file.h"
+#include "data_shards.h"
+#include "training_cache.h"
+#include "image_augmentation.h"
 #include "statistics.h"
+#include "statistics_accumulator.h"
 #include "scaling.h"
 #include "correlations.h"
 #include "tensor_utilities.h"
@@ -187,6 +198,7 @@ public:
 
         Index get_categories_number() const;
         Index get_used_categories_number() const;
+        Index get_input_categories_number() const;
 
         Tensor<string, 1> get_used_variables_names() const;
 
@@ -902,6 +914,68 @@ public:
     void save_auto_associative_data_binary(const string&) const;
 
     void load_data_binary();
+    void load_data_binary_previous_version();
+
+    // Data shards methods
+
+    bool has_data_shards() const;
+
+    const DataShards& get_data_shards() const;
+
+    const Index& get_shuffle_buffer_size() const;
+
+    const bool& get_map_binary_data() const;
+
+    void set_data_shards(const Tensor<string, 1>&);
+
+    void set_shuffle_buffer_size(const Index&);
+
+    void set_map_binary_data(const bool&);
+
+    Tensor<string, 1> save_data_shards(const string&, const Index&) const;
+
+    Tensor<Index, 1> shuffle_samples_indices(const Tensor<Index, 1>&, mt19937&) const;
+
+    void scale_submatrix(const Tensor<Index, 1>&, const Index&, type*) const;
+
+    // Batch scaling methods
+
+    const bool& get_batch_scaling() const;
+
+    bool is_batch_scaling() const;
+
+    void set_batch_scaling(const bool&);
+
+    void fill_scaled_submatrix(const Tensor<Index, 1>&, const Tensor<Index, 1>&, type*) const;
+
+    // Training cache methods
+
+    const bool& get_use_training_cache() const;
+
+    const TrainingCache& get_training_cache() const;
+
+    void set_use_training_cache(const bool&);
+
+    const StoragePrecision& get_training_cache_precision() const;
+
+    void set_training_cache_precision(const StoragePrecision&);
+    void set_training_cache_precision(const string&);
+
+    void update_training_cache();
+
+    // Categorical inputs codes methods
+
+    const bool& get_use_categorical_inputs_codes() const;
+
+    void set_use_categorical_inputs_codes(const bool&);
+
+    Tensor<Index, 1> get_input_categories_numbers() const;
+
+    Index get_input_codes_number() const;
+
+    Tensor<Index, 1> get_input_codes_variables_indices() const;
+
+    void fill_input_codes_submatrix(const Tensor<Index, 1>&, const Tensor<Index, 1>&, const Tensor<Index, 1>&, type*) const;
 
     void load_time_series_data_binary(const string&);
 
@@ -1000,15 +1074,24 @@ public:
     void read_csv_2_complete();
     void read_csv_3_complete();
 
+    void read_csv_mapped();
+
     void check_separators(const string&) const;
 
     void check_special_characters(const string&) const;
 
 private:
 
+    string write_columns_metadata() const;
+
+    void read_columns_metadata(const string&, const Index&);
+
+    void set_batch_variables_scalers(const Tensor<Index, 1>&, const Tensor<Scaler, 1>&, const Tensor<Descriptives, 1>&);
+
     DataSet::ProjectType project_type;
 
-    ThreadPool* thread_pool = nullptr;
+    /// Thread pool device shared by all the objects, owned by the execution context.
+
     ThreadPoolDevice* thread_pool_device = nullptr;
 
     // DATA
@@ -1019,6 +1102,47 @@ private:
 
     Tensor<type, 2> data;
 
+    /// Shards on disk which hold the data matrix instead of the data member, if it does not fit in memory.
+
+    DataShards data_shards;
+
+    /// True if the variables are scaled when the batches are filled, instead of in the data matrix.
+
+    bool batch_scaling = false;
+
+    /// Scalers applied to the variables when the batches are filled.
+
+    Tensor<Scaler, 1> batch_variables_scalers;
+
+    /// Descriptives used by the scalers of the batches.
+
+    Tensor<Descriptives, 1> batch_variables_descriptives;
+
+    /// Number of samples of the buffer through which the samples of the shards are shuffled.
+
+    Index shuffle_buffer_size = 100000;
+
+    /// True if the binary data files are mapped read-only as a single data shard when they are loaded,
+    /// instead of being copied into the data matrix.
+
+    bool map_binary_data = false;
+
+    /// Copy of the input and target variables with the samples in rows, from which the batches are gathered.
+
+    TrainingCache training_cache;
+
+    /// True if the batches are gathered from the training cache.
+
+    bool use_training_cache = false;
+
+    /// Precision of the values of the training cache.
+
+    StoragePrecision training_cache_precision = StoragePrecision::Single;
+
+    /// True if the batches hold the categorical inputs as the codes of their categories, instead of one hot variables.
+
+    bool use_categorical_inputs_codes = false;
+
     // Samples
 
     Tensor<SampleUse, 1> samples_uses;
@@ -1259,7 +1383,11 @@ struct DataSetBatch
 */
     void fill(const Tensor<Index, 1>&, const Tensor<Index, 1>&, const Tensor<Index, 1>&);
 
-    void perform_augmentation();
+    void fill_input_codes(const Tensor<Index, 1>&, const Tensor<Index, 1>&, const Tensor<Index, 1>&, const Tensor<Index, 1>&);
+
+    void fill_from_data_shards(const Tensor<Index, 1>&, const Tensor<Index, 1>&, const Tensor<Index, 1>&);
+
+    void perform_augmentation(const Tensor<Index, 1>&);
 
     void print() const;
 
@@ -1267,6 +1395,12 @@ struct DataSetBatch
 
     DataSet* data_set_pointer = nullptr;
 
+    /// Seed of the random transformations of the images of the batch.
+
+    unsigned augmentation_seed = 0;
+
+    ImageAugmentation image_augmentation;
+
     Tensor<DynamicTensor<type>, 1> inputs;
 
     DynamicTensor<type> targets;
@@ -0,0 +1,427 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   D A T A   S H A R D S   C L A S S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "data_shards.h"
+
+namespace opennn
+{
+
+/// Default constructor.
+/// It creates an object without shards.
+
+DataShards::DataShards()
+{
+    set();
+}
+
+
+/// File names constructor.
+/// It maps the shards.
+/// @param new_file_names Names of the binary data files, in the order of their samples.
+
+DataShards::DataShards(const Tensor<string, 1>& new_file_names)
+{
+    set(new_file_names);
+}
+
+
+/// Destructor.
+
+DataShards::~DataShards()
+{
+}
+
+
+/// Returns the number of mapped shards.
+
+Index DataShards::get_shards_number() const
+{
+    return Index(shards.size());
+}
+
+
+/// Returns the number of samples of all the shards.
+
+Index DataShards::get_samples_number() const
+{
+    return shards_samples_begins.back();
+}
+
+
+/// Returns the number of variables, which is the same for all the shards.
+
+Index DataShards::get_variables_number() const
+{
+    return shards.empty() ? 0 : shards[0]->get_variables_number();
+}
+
+
+/// Returns the names of the files of the shards.
+
+Tensor<string, 1> DataShards::get_file_names() const
+{
+    Tensor<string, 1> file_names(get_shards_number());
+
+    for(Index i = 0; i < get_shards_number(); i++)
+    {
+        file_names(i) = shards[size_t(i)]->get_file_name();
+    }
+
+    return file_names;
+}
+
+
+/// Returns the metadata text of the shards, which describes their columns.
+
+string DataShards::get_metadata() const
+{
+    return shards.empty() ? string() : shards[0]->get_metadata();
+}
+
+
+/// Returns the index of the shard which holds a sample.
+/// @param sample_index Index of the sample among the samples of all the shards.
+
+Index DataShards::get_shard_index(const Index& sample_index) const
+{
+    return Index(upper_bound(shards_samples_begins.begin(), shards_samples_begins.end(), sample_index)
+                 - shards_samples_begins.begin()) - 1;
+}
+
+
+/// Returns the value of a variable for a sample.
+/// @param sample_index Index of the sample among the samples of all the shards.
+/// @param variable_index Index of the variable.
+
+type DataShards::get_value(const Index& sample_index, const Index& variable_index) const
+{
+    const Index shard_index = get_shard_index(sample_index);
+
+    if(sample_index < 0 || shard_index >= get_shards_number())
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: DataShards class.\n"
+               << "type get_value(const Index&, const Index&) const method.\n"
+               << "Sample index (" << sample_index << ") must be less than number of samples (" << get_samples_number() << ").\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    return shards[size_t(shard_index)]->get_variable(variable_index)(sample_index - shards_samples_begins[size_t(shard_index)]);
+}
+
+
+/// Unmaps all the shards.
+
+void DataShards::set()
+{
+    shards.clear();
+
+    shards_samples_begins.assign(1, 0);
+}
+
+
+/// Maps the shards, after unmapping the previous ones.
+/// All the shards must have the same variables and the same metadata.
+/// @param new_file_names Names of the binary data files, in the order of their samples.
+
+void DataShards::set(const Tensor<string, 1>& new_file_names)
+{
+    set();
+
+    for(Index i = 0; i < new_file_names.size(); i++)
+    {
+        shared_ptr<const BinaryDataFile> shard = make_shared<const BinaryDataFile>(new_file_names(i));
+
+        if(i != 0
+        && (shard->get_variables_number() != get_variables_number() || shard->get_metadata() != get_metadata()))
+        {
+            const string first_file_name = shards[0]->get_file_name();
+
+            set();
+
+            ostringstream buffer;
+
+            buffer << "OpenNN Exception: DataShards class.\n"
+                   << "void set(const Tensor<string, 1>&) method.\n"
+                   << "Columns of shard " << new_file_names(i) << " are different from columns of shard " << first_file_name << ".\n";
+
+            throw invalid_argument(buffer.str());
+        }
+
+        shards.push_back(shard);
+
+        shards_samples_begins.push_back(shards_samples_begins.back() + shard->get_samples_number());
+    }
+}
+
+
+/// Copies the values of some samples and variables into a column major submatrix.
+/// @param rows_indices Indices of the samples, which are the rows of the submatrix.
+/// @param columns_indices Indices of the variables, which are the columns of the submatrix.
+/// @param submatrix_pointer Pointer to the first value of the submatrix.
+
+void DataShards::fill_submatrix(const Tensor<Index, 1>& rows_indices,
+                                const Tensor<Index, 1>& columns_indices,
+                                type* submatrix_pointer) const
+{
+    const Index rows_number = rows_indices.size();
+    const Index columns_number = columns_indices.size();
+
+    // The shard of each row is found once for all the columns
+
+    Tensor<const type*, 1> rows_blocks(rows_number);
+    Tensor<Index, 1> rows_block_sizes(rows_number);
+
+    for(Index i = 0; i < rows_number; i++)
+    {
+        const Index shard_index = get_shard_index(rows_indices(i));
+
+        const BinaryDataFile& shard = *shards[size_t(shard_index)];
+
+        rows_blocks(i) = shard.get_blocks().data() + (rows_indices(i) - shards_samples_begins[size_t(shard_index)]);
+        rows_block_sizes(i) = shard.get_block_size();
+    }
+
+    #pragma omp parallel for
+
+    for(Index j = 0; j < columns_number; j++)
+    {
+        const Index column_index = columns_indices(j);
+
+        type* submatrix_column_pointer = submatrix_pointer + rows_number*j;
+
+        for(Index i = 0; i < rows_number; i++)
+        {
+            submatrix_column_pointer[i] = rows_blocks(i)[column_index*rows_block_sizes(i)];
+        }
+    }
+}
+
+
+/// Returns the minimum, maximum, mean and standard deviation of some variables over some samples.
+/// Each variable is read block after block, so that only a few pages of the shards are in memory at a time.
+/// Missing values are skipped.
+/// @param samples_indices Indices of the samples.
+/// @param variables_indices Indices of the variables.
+
+Tensor<Descriptives, 1> DataShards::calculate_descriptives(const Tensor<Index, 1>& samples_indices,
+                                                           const Tensor<Index, 1>& variables_indices) const
+{
+    const Index samples_number = samples_indices.size();
+    const Index variables_number = variables_indices.size();
+
+    for(Index j = 0; j < variables_number; j++)
+    {
+        if(variables_indices(j) < 0 || variables_indices(j) >= get_variables_number())
+        {
+            ostringstream buffer;
+
+            buffer << "OpenNN Exception: DataShards class.\n"
+                   << "Tensor<Descriptives, 1> calculate_descriptives(const Tensor<Index, 1>&, const Tensor<Index, 1>&) const method.\n"
+                   << "Variable index (" << variables_indices(j) << ") must be less than number of variables (" << get_variables_number() << ").\n";
+
+            throw invalid_argument(buffer.str());
+        }
+    }
+
+    // Samples are visited in the order of the shards
+
+    vector<Index> sorted_samples_indices(samples_indices.data(), samples_indices.data() + samples_number);
+
+    sort(sorted_samples_indices.begin(), sorted_samples_indices.end());
+
+    Tensor<Descriptives, 1> descriptives(variables_number);
+
+    #pragma omp parallel for schedule(dynamic)
+
+    for(Index j = 0; j < variables_number; j++)
+    {
+        type minimum = numeric_limits<type>::max();
+        type maximum = numeric_limits<type>::lowest();
+
+        double sum = 0;
+        double squared_sum = 0;
+        Index count = 0;
+
+        Index shard_index = 0;
+        const type* variable_pointer = nullptr;
+
+        for(Index i = 0; i < samples_number; i++)
+        {
+            const Index sample_index = sorted_samples_indices[size_t(i)];
+
+            if(variable_pointer == nullptr || sample_index >= shards_samples_begins[size_t(shard_index) + 1])
+            {
+                shard_index = get_shard_index(sample_index);
+
+                variable_pointer = shards[size_t(shard_index)]->get_variable(variables_indices(j)).data();
+            }
+
+            const type value = variable_pointer[sample_index - shards_samples_begins[size_t(shard_index)]];
+
+            if(isnan(value)) continue;
+
+            minimum = min(minimum, value);
+            maximum = max(maximum, value);
+
+            sum += double(value);
+            squared_sum += double(value)*double(value);
+            count++;
+        }
+
+        const double mean = count == 0 ? 0 : sum/double(count);
+
+        const double variance = count < 2 ? 0 : max((squared_sum - double(count)*mean*mean)/double(count - 1), 0.0);
+
+        descriptives(j).set(minimum, maximum, type(mean), type(sqrt(variance)));
+    }
+
+    return descriptives;
+}
+
+
+/// Returns the samples of an epoch in a random order which keeps the reads local.
+/// The order of the shards is shuffled, and then the samples stream through a buffer,
+/// from which each sample is replaced by the next one at a random position.
+/// @param samples_indices Indices of the samples.
+/// @param buffer_size Number of samples of the shuffle buffer.
+/// @param random_engine Random number generator.
+
+Tensor<Index, 1> DataShards::shuffle_samples_indices(const Tensor<Index, 1>& samples_indices,
+                                                     const Index& buffer_size,
+                                                     mt19937& random_engine) const
+{
+    const Index samples_number = samples_indices.size();
+
+    // Samples of each shard
+
+    vector<vector<Index>> shards_samples_indices(shards.size());
+
+    for(Index i = 0; i < samples_number; i++)
+    {
+        shards_samples_indices[size_t(get_shard_index(samples_indices(i)))].push_back(samples_indices(i));
+    }
+
+    vector<Index> shards_order(shards.size());
+
+    for(size_t i = 0; i < shards_order.size(); i++) shards_order[i] = Index(i);
+
+    shuffle(shards_order.begin(), shards_order.end(), random_engine);
+
+    // Shuffle buffer
+
+    vector<Index> buffer;
+    buffer.reserve(size_t(max(buffer_size, Index(1))));
+
+    uniform_int_distribution<size_t> buffer_distribution(0, buffer.capacity() - 1);
+
+    Tensor<Index, 1> shuffled_samples_indices(samples_number);
+
+    Index index = 0;
+
+    for(const Index& shard_index : shards_order)
+    {
+        for(const Index& sample_index : shards_samples_indices[size_t(shard_index)])
+        {
+            if(buffer.size() < buffer.capacity())
+            {
+                buffer.push_back(sample_index);
+
+                continue;
+            }
+
+            const size_t random_index = buffer_distribution(random_engine);
+
+            shuffled_samples_indices(index++) = buffer[random_index];
+
+            buffer[random_index] = sample_index;
+        }
+    }
+
+    shuffle(buffer.begin(), buffer.end(), random_engine);
+
+    for(const Index& sample_index : buffer)
+    {
+        shuffled_samples_indices(index++) = sample_index;
+    }
+
+    return shuffled_samples_indices;
+}
+
+
+/// Writes a data matrix as consecutive shards, and returns the names of their files.
+/// The files are named after the prefix, followed by the index of the shard and the extension ".bin".
+/// @param file_name_prefix Prefix of the names of the files.
+/// @param metadata Text which describes the columns of the data matrix, written in every shard.
+/// @param data Data matrix.
+/// @param shard_samples_number Maximum number of samples of each shard.
+
+Tensor<string, 1> DataShards::write(const string& file_name_prefix,
+                                    const string& metadata,
+                                    const Tensor<type, 2>& data,
+                                    const Index& shard_samples_number)
+{
+    if(shard_samples_number <= 0)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: DataShards class.\n"
+               << "static Tensor<string, 1> write(const string&, const string&, const Tensor<type, 2>&, const Index&) method.\n"
+               << "Shard samples number (" << shard_samples_number << ") must be greater than 0.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    const Index samples_number = data.dimension(0);
+    const Index variables_number = data.dimension(1);
+
+    const Index shards_number = max((samples_number + shard_samples_number - 1)/shard_samples_number, Index(1));
+
+    Tensor<string, 1> file_names(shards_number);
+
+    Tensor<type, 2> shard_data;
+
+    for(Index i = 0; i < shards_number; i++)
+    {
+        const Index shard_samples_begin = i*shard_samples_number;
+        const Index shard_samples_size = min(shard_samples_number, samples_number - shard_samples_begin);
+
+        const Eigen::array<Index, 2> offsets = {shard_samples_begin, 0};
+        const Eigen::array<Index, 2> extents = {shard_samples_size, variables_number};
+
+        shard_data = data.slice(offsets, extents);
+
+        file_names(i) = file_name_prefix + "_" + to_string(i) + ".bin";
+
+        BinaryDataFile::write(file_names(i), metadata, shard_data);
+    }
+
+    return file_names;
+}
+
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -0,0 +1,121 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   D A T A   S H A R D S   C L A S S   H E A D E R
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#ifndef DATASHARDS_H
+#define DATASHARDS_H
+
+// System includes
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+// OpenNN includes
+
+#include "config.h"
+#include "binary_data_file.h"
+#include "statistics.h"
+
+namespace opennn
+{
+
+/// This class reads a data matrix stored on disk as a sequence of binary data files, called shards.
+
+/// The shards hold consecutive samples of the same variables, and are mapped into memory, never loaded.
+/// The operating system reads their pages when they are accessed, and drops them when memory is needed,
+/// so the matrix can be larger than the memory.
+/// Each variable of a shard is a contiguous block, so the descriptives are computed by streaming over the blocks.
+/// The samples of an epoch are shuffled by shards, and then locally through a buffer,
+/// so that consecutive batches read from a few shards at a time.
+
+class DataShards
+{
+
+public:
+
+    // Constructors
+
+    explicit DataShards();
+
+    explicit DataShards(const Tensor<string, 1>&);
+
+    // Destructor
+
+    virtual ~DataShards();
+
+    // Get methods
+
+    Index get_shards_number() const;
+
+    Index get_samples_number() const;
+
+    Index get_variables_number() const;
+
+    Tensor<string, 1> get_file_names() const;
+
+    string get_metadata() const;
+
+    Index get_shard_index(const Index&) const;
+
+    type get_value(const Index&, const Index&) const;
+
+    // Set methods
+
+    void set();
+
+    void set(const Tensor<string, 1>&);
+
+    // Reading methods
+
+    void fill_submatrix(const Tensor<Index, 1>&, const Tensor<Index, 1>&, type*) const;
+
+    Tensor<Descriptives, 1> calculate_descriptives(const Tensor<Index, 1>&, const Tensor<Index, 1>&) const;
+
+    Tensor<Index, 1> shuffle_samples_indices(const Tensor<Index, 1>&, const Index&, mt19937&) const;
+
+    // Serialization methods
+
+    static Tensor<string, 1> write(const string&, const string&, const Tensor<type, 2>&, const Index&);
+
+private:
+
+    /// Mapped shards. They are shared by the copies of the object.
+
+    vector<shared_ptr<const BinaryDataFile>> shards;
+
+    /// Index of the first sample of each shard, followed by the number of samples.
+
+    vector<Index> shards_samples_begins;
+};
+
+}
+
+#endif
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
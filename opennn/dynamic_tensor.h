@@ -49,46 +49,88 @@ public:
     }
 
 
+    /// View constructor.
+    /// It creates a dynamic tensor which does not own its data, but refers to memory owned by someone else.
+    /// The caller must keep that memory alive while the view is in use.
+    /// @param new_data Pointer to the first element.
+    /// @param new_dimensions Dimensions of the viewed tensor.
+
+    DynamicTensor(T* new_data, const Tensor<Index, 1>& new_dimensions)
+    {
+        set_view(new_data, new_dimensions);
+    }
+
+
+    /// Copy constructor.
+    /// The new tensor always owns a deep copy of the data, also when other is a view.
+
+    DynamicTensor(const DynamicTensor& other)
+    {
+        *this = other;
+    }
+
+
+    /// Move constructor.
+    /// Ownership (or the view) is transferred from other, which is left empty.
+
+    DynamicTensor(DynamicTensor&& other) noexcept
+    {
+        data = other.data;
+        dimensions = other.dimensions;
+        owns_data = other.owns_data;
+        allocated_size = other.allocated_size;
+
+        other.data = nullptr;
+        other.dimensions.resize(0);
+        other.owns_data = true;
+        other.allocated_size = 0;
+    }
+
+
+    /// Assignment operator.
+    /// It deep copies the data of other into this tensor.
+    /// When this tensor already owns a buffer of the same size, that buffer is reused, so no heap memory is touched.
+
     DynamicTensor& operator = (const DynamicTensor& other)
     {
         if(this != &other)
         {
-//            const Tensor<bool, 0> different_dimensions = (dimensions != other.dimensions).all();
-
-            bool different_dimensions = false;
+            const Index size = other.size();
 
-            if(dimensions.size() != other.dimensions.size())
+            if(!owns_data || allocated_size != size)
             {
-                different_dimensions = true;
-            }
+                release();
 
-            if(!different_dimensions)
-            {
-                for(Index i =  0; i < dimensions.size(); i++)
-                {
-                    if(dimensions(i) != other.dimensions(i))
-                    {
-                        different_dimensions = true;
-                        break;
-                    }
-                }
-            }
+                data = (T*) malloc(static_cast<size_t>(size*sizeof(T)));
 
-            if(different_dimensions)
-            {
-                dimensions = other.dimensions;
+                owns_data = true;
+                allocated_size = size;
             }
 
-            if(data != nullptr)
-            {
-                free(data);
-            }
+            dimensions = other.dimensions;
+
+            if(size != 0) memcpy(data, other.data, static_cast<size_t>(size*sizeof(T)));
+        }
 
-            const Tensor<Index, 0> size = dimensions.prod();
+        return *this;
+    }
 
-            data = (T*) malloc(static_cast<size_t>(size(0)*sizeof(T)));
 
-            memcpy(data, other.data, static_cast<size_t>(size(0)*sizeof(T)) );
+    DynamicTensor& operator = (DynamicTensor&& other) noexcept
+    {
+        if(this != &other)
+        {
+            release();
+
+            data = other.data;
+            dimensions = other.dimensions;
+            owns_data = other.owns_data;
+            allocated_size = other.allocated_size;
+
+            other.data = nullptr;
+            other.dimensions.resize(0);
+            other.owns_data = true;
+            other.allocated_size = 0;
         }
 
         return *this;
@@ -132,67 +174,104 @@ public:
 
     }
 
-/*
-    DynamicTensor(const T* new_data, const Tensor<Index, 1>& new_dimensions)
+    virtual ~DynamicTensor()
     {
-        /// @todo check if data size matches dimensions
-        data = (T*) new_data;
-
-        dimensions = new_dimensions;
+        release();
     }
 
-    DynamicTensor(const Tensor<T, 2>& new_tensor_2)
+    T* get_data() const
     {
-        dimensions = opennn::get_dimensions(new_tensor_2);
-
-        data = (T*) new_tensor_2.data();
+        return data;
     }
 
-    DynamicTensor(const Tensor<T, 4>& new_tensor_4)
+    const Tensor<Index, 1>& get_dimensions() const
     {
-        dimensions = opennn::get_dimensions(new_tensor_4);
-
-        data = (T*) new_tensor_4.data();
+        return dimensions;
     }
-*/
-    virtual ~DynamicTensor()
+
+
+    Index get_dimension(const Index& index) const
     {
-        free(data);
+        return dimensions(index);
     }
 
-    T* get_data() const
+
+    /// Returns the number of elements, this is, the product of all the dimensions.
+
+    Index size() const
     {
-        return data;
+        if(dimensions.size() == 0) return 0;
+
+        Index size = 1;
+
+        for(Index i = 0; i < dimensions.size(); i++) size *= dimensions(i);
+
+        return size;
     }
 
-    const Tensor<Index, 1>& get_dimensions() const
+
+    /// Returns true if this tensor refers to memory that it does not own.
+
+    bool is_view() const
     {
-        return dimensions;
+        return !owns_data;
     }
 
 
-    Index get_dimension(const Index& index) const
+    /// Returns a non owning dynamic tensor which refers to the data of this one.
+
+    DynamicTensor view() const
     {
-        return dimensions(index);
+        return DynamicTensor(data, dimensions);
     }
 
+
     void set_data(const T* new_data)
     {
-        free(data);
+        release();
 
         data = (T*) new_data;
+
+        owns_data = true;
+        allocated_size = size();
     }
 
 
-    void set_dimensions(const Tensor<Index, 1> new_dimensions)
+    /// Makes this tensor a view of memory owned by someone else.
+    /// The previously owned buffer, if any, is released.
+    /// @param new_data Pointer to the first element.
+    /// @param new_dimensions Dimensions of the viewed tensor.
+
+    void set_view(T* new_data, const Tensor<Index, 1>& new_dimensions)
     {
-        free(data);
+        release();
+
+        data = new_data;
 
         dimensions = new_dimensions;
 
-        const Tensor<Index, 0> size = dimensions.prod();
+        owns_data = false;
+        allocated_size = 0;
+    }
+
+
+    /// Sets new dimensions and allocates the memory for them.
+    /// If this tensor already owns a buffer with the same number of elements, it is kept.
+
+    void set_dimensions(const Tensor<Index, 1> new_dimensions)
+    {
+        dimensions = new_dimensions;
+
+        const Index new_size = size();
+
+        if(owns_data && data != nullptr && allocated_size == new_size) return;
+
+        release();
 
-        data = (T*) malloc(static_cast<size_t>(size(0)*sizeof(T)));
+        data = (T*) malloc(static_cast<size_t>(new_size*sizeof(T)));
+
+        owns_data = true;
+        allocated_size = new_size;
     }
 
     template <int rank>
@@ -211,9 +290,27 @@ public:
 
 private:
 
+    void release()
+    {
+        if(owns_data) free(data);
+
+        data = nullptr;
+
+        owns_data = true;
+        allocated_size = 0;
+    }
+
     T* data = nullptr;
 
     Tensor<Index, 1> dimensions;
+
+    /// True if data was allocated by this tensor and must be freed by it.
+
+    bool owns_data = true;
+
+    /// Number of elements allocated in data, used to reuse the buffer across assignments.
+
+    Index allocated_size = 0;
 };
 };
 
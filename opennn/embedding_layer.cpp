@@ -67,11 +67,37 @@ Index EmbeddingLayer::get_depth() const
 }
 
 
-/// Each returns the layer's Perceptron sub-layer.
+/// Returns the number of inputs of each sample, which is the input length.
 
-PerceptronLayer EmbeddingLayer::get_perceptron_layer() const
+Index EmbeddingLayer::get_inputs_number() const
 {
-    return perceptron_layer;
+    return input_length;
+}
+
+
+/// Returns the number of outputs of each input value, which is the embedding depth.
+
+Index EmbeddingLayer::get_neurons_number() const
+{
+    return depth;
+}
+
+
+/// Returns the lookup table of the layer, with a row for each possible input value.
+/// The rows are contiguous, so the map has dimensions (depth, input_dim) and the row of a value is a column of it.
+
+const TensorMap<Tensor<type, 2>>& EmbeddingLayer::get_embedding_weights() const
+{
+    return embedding_weights;
+}
+
+
+/// Returns the positional encoding which is added to the outputs of each sample.
+/// It is empty if the layer does not add positional encoding.
+
+const Tensor<type, 2>& EmbeddingLayer::get_positional_encoding_matrix() const
+{
+    return positional_encoding_matrix;
 }
 
 
@@ -79,7 +105,27 @@ PerceptronLayer EmbeddingLayer::get_perceptron_layer() const
 
 Index EmbeddingLayer::get_parameters_number() const
 {
-    return perceptron_layer.get_parameters_number();
+    return embedding_weights.size();
+}
+
+
+/// Returns a single vector with the lookup table, row by row.
+
+Tensor<type, 1> EmbeddingLayer::get_parameters() const
+{
+    Tensor<type, 1> parameters(embedding_weights.size());
+
+    memcpy(parameters.data(), embedding_weights.data(), static_cast<size_t>(embedding_weights.size())*sizeof(type));
+
+    return parameters;
+}
+
+
+/// Returns a pointer to the lookup table of the layer.
+
+type* EmbeddingLayer::get_parameters_data() const
+{
+    return embedding_weights.data();
 }
 
 
@@ -159,7 +205,9 @@ void EmbeddingLayer::set()
 
     positional_encoding = false;
 
-    perceptron_layer.set();
+    allocate_parameters();
+
+    positional_encoding_matrix.resize(0, 0);
 
     set_default();
 }
@@ -180,10 +228,14 @@ void EmbeddingLayer::set(const Index& new_input_dim,
 
     depth = new_depth;
 
-    set_perceptron();
+    allocate_parameters();
+
+    set_parameters_random();
 
     positional_encoding = new_positional_encoding;
 
+    set_positional_encoding_matrix();
+
     activation_function = new_activation_function;
 
     set_default();
@@ -214,7 +266,9 @@ void EmbeddingLayer::set_input_dim(const Index& new_input_dim)
 {
     input_dim = new_input_dim;
 
-    set_perceptron();
+    allocate_parameters();
+
+    set_parameters_random();
 }
 
 
@@ -223,6 +277,8 @@ void EmbeddingLayer::set_input_dim(const Index& new_input_dim)
 void EmbeddingLayer::set_input_length(const Index& new_input_length)
 {
     input_length = new_input_length;
+
+    set_positional_encoding_matrix();
 }
 
 
@@ -232,15 +288,92 @@ void EmbeddingLayer::set_depth(const Index& new_depth)
 {
     depth = new_depth;
 
-    set_perceptron();
+    allocate_parameters();
+
+    set_parameters_random();
+
+    set_positional_encoding_matrix();
+}
+
+
+/// Allocates storage owned by the layer for the lookup table, and makes the table a view of it.
+/// This detaches the layer from any parameters arena. The values of the parameters are not initialized.
+
+void EmbeddingLayer::allocate_parameters()
+{
+    parameters.resize(input_dim*depth);
+
+    new (&embedding_weights) TensorMap<Tensor<type, 2>>(parameters.data(), depth, input_dim);
 }
 
 
-/// Sets the perceptron sub-layer according to the layer's parameters.
+/// Builds the positional encoding for the input length and the depth of the layer, if the layer adds it.
+/// It is built here once, instead of in every forward propagation.
 
-void EmbeddingLayer::set_perceptron()
+void EmbeddingLayer::set_positional_encoding_matrix()
 {
-    perceptron_layer.set(input_dim, depth, activation_function);
+    if(positional_encoding && input_length > 0 && depth > 1)
+    {
+        positional_encoding_matrix = build_positional_encoding_matrix();
+    }
+    else
+    {
+        positional_encoding_matrix.resize(0, 0);
+    }
+}
+
+
+/// Sets the lookup table of this layer from a vector of parameters.
+/// @param new_parameters Parameters vector.
+/// @param index Position of the first parameter of the layer in the vector.
+
+void EmbeddingLayer::set_parameters(const Tensor<type, 1>& new_parameters, const Index& index)
+{
+    memcpy(embedding_weights.data(),
+           new_parameters.data() + index,
+           static_cast<size_t>(embedding_weights.size())*sizeof(type));
+}
+
+
+/// Moves the lookup table of the layer to a block of memory owned by the caller, usually the parameters arena of a neural network.
+/// The current values are copied there, and from then on the table is a view of that block.
+/// @param new_parameters_data Pointer to a block with room for all the parameters of the layer.
+
+void EmbeddingLayer::set_parameters_data(type* new_parameters_data)
+{
+    if(new_parameters_data != embedding_weights.data())
+    {
+        copy(embedding_weights.data(), embedding_weights.data() + embedding_weights.size(), new_parameters_data);
+    }
+
+    new (&embedding_weights) TensorMap<Tensor<type, 2>>(new_parameters_data, depth, input_dim);
+
+    if(new_parameters_data != parameters.data()) parameters.resize(0);
+}
+
+
+/// Initializes all the values of the lookup table with a given value.
+/// @param value Parameters initialization value.
+
+void EmbeddingLayer::set_parameters_constant(const type& value)
+{
+    embedding_weights.setConstant(value);
+}
+
+
+/// Initializes all the values of the lookup table at random with values comprised between -0.2 and +0.2.
+
+void EmbeddingLayer::set_parameters_random()
+{
+    const type minimum = type(-0.2);
+    const type maximum = type(0.2);
+
+    for(Index i = 0; i < embedding_weights.size(); i++)
+    {
+        const type random = static_cast<type>(rand()/(RAND_MAX+1.0));
+
+        embedding_weights(i) = minimum + (maximum - minimum)*random;
+    }
 }
 
 /// This class sets a new activation(or transfer) function in the layer.
@@ -325,53 +458,78 @@ void EmbeddingLayer::set_display(const bool& new_display)
 }
 
 
-/// Calculates one-hot encoding, of dimension = input_dim, of an input row (assuming all input values are integers)
-/// @return Matrix of one-hot encodings of all values in input_row
+/// Converts the inputs of a batch, which must be integers, to row indices of the lookup table.
+/// @param inputs Batch of inputs, with a row for each sample and a column for each position.
+/// @param tokens Row index of each input, in the same order as the inputs.
 
-Tensor<type, 2> EmbeddingLayer::one_hot_encode_row(const Tensor<type, 1>& input_row)
+void EmbeddingLayer::calculate_tokens(const TensorMap<Tensor<type, 2>>& inputs, Tensor<Index, 1>& tokens) const
 {
-    Tensor<type, 2> one_hot_encoded_input_row(input_length, input_dim);
-    one_hot_encoded_input_row.setZero();
+    const Index tokens_number = inputs.size();
 
-    const Tensor<type, 0> max_input = input_row.maximum();
+    const type* inputs_data = inputs.data();
 
-    if(max_input(0) >= type(input_dim))
+    for(Index i = 0; i < tokens_number; i++)
     {
-        ostringstream buffer;
-        buffer << "OpenNN Exception: EmbeddingLayer class.\n"
-               << "void EmbeddingLayer::one_hot_encode_row(const Tensor<Index, 1>&)\n"
-               << "All input values must be less than " << input_dim << " (" << max_input(0) << ").\n";
-        throw invalid_argument(buffer.str());
-    }
-
-#pragma omp parallel for
-    for(Index i = 0; i < input_length; i++)
-        one_hot_encoded_input_row(i, Index(input_row(i))) = 1;
+        if(inputs_data[i] < type(0) || inputs_data[i] >= type(input_dim))
+        {
+            ostringstream buffer;
+            buffer << "OpenNN Exception: EmbeddingLayer class.\n"
+                   << "void calculate_tokens(const TensorMap<Tensor<type, 2>>&, Tensor<Index, 1>&) const method.\n"
+                   << "All input values must be between 0 and " << input_dim - 1 << " (" << inputs_data[i] << ").\n";
+            throw invalid_argument(buffer.str());
+        }
 
-    return one_hot_encoded_input_row;
+        tokens(i) = Index(inputs_data[i]);
+    }
 }
 
 
-/// Looks up embedding of an input row, by passing its one-hot encoding through a perceptron layer (that corresponds to the lookup table)
-/// Saves the embedding matrix of the row in outputs_data of the given perceptron layer forward propagation structure
+/// Looks up the embeddings of a batch of input values by gathering rows of the lookup table.
+/// The inputs are processed in blocks. The rows of a block are copied whole into a buffer,
+/// which is then transposed into the outputs, so that both the reads and the writes are contiguous.
+/// @param tokens Row index of each input value.
+/// @param outputs_data Pointer to the outputs, with the input values as the fastest dimension and the depth as the slowest one.
 
-void EmbeddingLayer::lookup_embedding(const Tensor<type, 1>& input_row,
-                                    PerceptronLayerForwardPropagation* perceptron_forward_propagation,
-                                    const bool& is_training)
+void EmbeddingLayer::lookup_embedding(const Tensor<Index, 1>& tokens, type* outputs_data) const
 {
-    Tensor<type, 2> one_hot_encoded_input_row = one_hot_encode_row(input_row);
+    const Index tokens_number = tokens.size();
 
-    Tensor<type*, 1> one_hot_encoded_input_row_data(1);
-    one_hot_encoded_input_row_data.setValues({one_hot_encoded_input_row.data()});
+    const Index* tokens_data = tokens.data();
 
-    Tensor<Tensor<Index, 1>, 1> one_hot_encoded_input_row_dimensions;
-    one_hot_encoded_input_row_dimensions.setValues({get_dimensions(one_hot_encoded_input_row)});
+    const type* embedding_weights_data = embedding_weights.data();
 
-//    perceptron_layer.forward_propagate(one_hot_encoded_input_row_data,
-//                                       one_hot_encoded_input_row_dimensions, // input_length is batch_size
-//                                       perceptron_forward_propagation,
-//                                       is_training);
-};
+    const Index block_size = 64;
+
+    const Index blocks_number = (tokens_number + block_size - 1)/block_size;
+
+    #pragma omp parallel
+    {
+        Tensor<type, 1> block(block_size*depth);
+
+        type* block_data = block.data();
+
+        #pragma omp for
+        for(Index i = 0; i < blocks_number; i++)
+        {
+            const Index beginning = i*block_size;
+
+            const Index current_block_size = min(block_size, tokens_number - beginning);
+
+            for(Index k = 0; k < current_block_size; k++)
+                memcpy(block_data + k*depth,
+                       embedding_weights_data + tokens_data[beginning + k]*depth,
+                       static_cast<size_t>(depth)*sizeof(type));
+
+            for(Index j = 0; j < depth; j++)
+            {
+                type* outputs_column = outputs_data + j*tokens_number + beginning;
+
+                for(Index k = 0; k < current_block_size; k++)
+                    outputs_column[k] = block_data[k*depth + j];
+            }
+        }
+    }
+}
 
 
 /// Builds positional encoding matrix with dimensions (input_length, depth) of the layer.
@@ -432,31 +590,164 @@ void EmbeddingLayer::forward_propagate(const Tensor<DynamicTensor<type>, 1>& inp
     EmbeddingLayerForwardPropagation* embedding_layer_forward_propagation
         = static_cast<EmbeddingLayerForwardPropagation*>(forward_propagation);
 
-    PerceptronLayerForwardPropagation perceptron_layer_forward_propagation =
-        embedding_layer_forward_propagation->perceptron_forward_propagation;
+    Tensor<Index, 1>& tokens = embedding_layer_forward_propagation->tokens;
 
-    Tensor<type, 1> input_row(input_length);
+    calculate_tokens(inputs_tensor_map, tokens);
 
-//#pragma omp parallel for
-    for(Index i = 0; i < batch_size; i++)
+    lookup_embedding(tokens, embedding_layer_forward_propagation->outputs(0).get_data());
+
+    if(positional_encoding)
     {
-        input_row = inputs_tensor_map.chip(i, 0);
-        lookup_embedding(input_row, &perceptron_layer_forward_propagation, is_training);
+        TensorMap<Tensor<type, 3>> outputs = embedding_layer_forward_propagation->outputs(0).to_tensor_map<3>();
 
-        memcpy(embedding_layer_forward_propagation->outputs(0).get_data() + i*input_length*depth,
-               perceptron_layer_forward_propagation.outputs(0).get_data(),
-               static_cast<size_t>(input_length*depth*sizeof(type)));
+        outputs.device(*thread_pool_device)
+                += positional_encoding_matrix.reshape(Eigen::array<Index, 3>({1, input_length, depth}))
+                                             .broadcast(Eigen::array<Index, 3>({batch_size, 1, 1}));
     }
+}
 
-    if(positional_encoding)
+
+/// Calculates the derivatives of the error with respect to the outputs of this layer, from the next layer.
+/// The next layer can only be a multihead attention layer, whose inputs derivatives fed by this layer are added.
+
+void EmbeddingLayer::calculate_hidden_delta(LayerForwardPropagation* next_layer_forward_propagation,
+                                            LayerBackPropagation* next_layer_back_propagation,
+                                            LayerBackPropagation* layer_back_propagation) const
+{
+    switch(next_layer_back_propagation->layer_pointer->get_type())
     {
-        TensorMap<Tensor<type, 3>> outputs = embedding_layer_forward_propagation->outputs(0).to_tensor_map<3>();
+    case Type::MultiheadAttention:
+    {
+        const MultiheadAttentionLayer* next_multihead_attention_layer_pointer
+                = static_cast<MultiheadAttentionLayer*>(next_layer_back_propagation->layer_pointer);
 
-        const Tensor<type, 2> positional_encoding_matrix = build_positional_encoding_matrix();
-#pragma omp parallel for
-        for(Index i = 0; i < batch_size; i++)
-            outputs.chip(i, 0) += positional_encoding_matrix;
+        next_multihead_attention_layer_pointer->calculate_input_layer_deltas(this,
+                                                                             next_layer_forward_propagation,
+                                                                             next_layer_back_propagation,
+                                                                             layer_back_propagation);
     }
+        break;
+
+    default:
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: EmbeddingLayer class.\n"
+               << "void calculate_hidden_delta(LayerForwardPropagation*, LayerBackPropagation*, LayerBackPropagation*) const method.\n"
+               << "Next layer type (" << next_layer_back_propagation->layer_pointer->get_type_string() << ") is not supported.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+    }
+}
+
+
+/// Calculates the derivatives of the error with respect to the lookup table.
+/// The deltas of each input value are added to the row of that value, so the cost does not depend on the number of possible values.
+/// The derivatives of the rows not in the batch are zero, and the rows in the batch are kept sorted in the back-propagation structure,
+/// so that optimizers can update only them.
+/// Only the rows of the previous batch are cleared, unless the derivatives have been written outside the layer since then.
+
+void EmbeddingLayer::calculate_error_gradient(type*,
+                                              LayerForwardPropagation* forward_propagation,
+                                              LayerBackPropagation* back_propagation) const
+{
+    const EmbeddingLayerForwardPropagation* embedding_layer_forward_propagation
+        = static_cast<EmbeddingLayerForwardPropagation*>(forward_propagation);
+
+    EmbeddingLayerBackPropagation* embedding_layer_back_propagation
+        = static_cast<EmbeddingLayerBackPropagation*>(back_propagation);
+
+    const Tensor<Index, 1>& tokens = embedding_layer_forward_propagation->tokens;
+
+    const Index tokens_number = tokens.size();
+
+    const Index* tokens_data = tokens.data();
+
+    const type* deltas_data = back_propagation->deltas_data;
+
+    TensorMap<Tensor<type, 2>>& embedding_weights_derivatives = embedding_layer_back_propagation->embedding_weights_derivatives;
+
+    type* embedding_weights_derivatives_data = embedding_weights_derivatives.data();
+
+    Index* rows_indices_data = embedding_layer_back_propagation->rows_indices.data();
+    Index* positions_data = embedding_layer_back_propagation->positions.data();
+    Index* rows_beginnings_data = embedding_layer_back_propagation->rows_beginnings.data();
+
+    // Clear the rows of the previous batch
+
+    if(embedding_layer_back_propagation->has_sparse_derivatives)
+    {
+        const Index previous_rows_number = embedding_layer_back_propagation->rows_number;
+
+        #pragma omp parallel for
+        for(Index k = 0; k < previous_rows_number; k++)
+            fill_n(embedding_weights_derivatives_data + rows_indices_data[k]*depth, depth, type(0));
+    }
+    else
+    {
+        embedding_weights_derivatives.setZero();
+    }
+
+    // Positions of the inputs grouped by row
+
+    iota(positions_data, positions_data + tokens_number, Index(0));
+
+    stable_sort(positions_data, positions_data + tokens_number,
+                [tokens_data](const Index& a, const Index& b) { return tokens_data[a] < tokens_data[b]; });
+
+    Index rows_number = 0;
+
+    for(Index i = 0; i < tokens_number; i++)
+    {
+        if(i == 0 || tokens_data[positions_data[i]] != tokens_data[positions_data[i - 1]])
+        {
+            rows_indices_data[rows_number] = tokens_data[positions_data[i]];
+            rows_beginnings_data[rows_number] = i;
+            rows_number++;
+        }
+    }
+
+    rows_beginnings_data[rows_number] = tokens_number;
+
+    embedding_layer_back_propagation->rows_number = rows_number;
+
+    // Each thread adds to different rows, so repeated values do not collide
+
+    #pragma omp parallel for
+    for(Index k = 0; k < rows_number; k++)
+    {
+        type* derivatives_row = embedding_weights_derivatives_data + rows_indices_data[k]*depth;
+
+        for(Index p = rows_beginnings_data[k]; p < rows_beginnings_data[k + 1]; p++)
+        {
+            const Index position = positions_data[p];
+
+            for(Index j = 0; j < depth; j++)
+                derivatives_row[j] += deltas_data[j*tokens_number + position];
+        }
+    }
+
+    embedding_layer_back_propagation->has_sparse_derivatives = true;
+}
+
+
+void EmbeddingLayer::insert_gradient(LayerBackPropagation* back_propagation,
+                                     const Index& index,
+                                     Tensor<type, 1>& gradient) const
+{
+    const EmbeddingLayerBackPropagation* embedding_layer_back_propagation
+        = static_cast<EmbeddingLayerBackPropagation*>(back_propagation);
+
+    const type* embedding_weights_derivatives_data = embedding_layer_back_propagation->embedding_weights_derivatives.data();
+
+    // Already computed in place
+
+    if(embedding_weights_derivatives_data == gradient.data() + index) return;
+
+    copy(embedding_weights_derivatives_data,
+         embedding_weights_derivatives_data + embedding_layer_back_propagation->embedding_weights_derivatives.size(),
+         gradient.data() + index);
 }
 
 /*
@@ -11,10 +11,12 @@
 
 // System includes
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <numeric>
 #include <string>
 #include <sstream>
 
@@ -23,6 +25,7 @@
 #include "config.h"
 #include "layer.h"
 #include "perceptron_layer.h"
+#include "multihead_attention_layer.h"
 
 #ifdef OPENNN_MKL
 #include "../mkl/mkl.h"
@@ -44,7 +47,9 @@ struct EmbeddingLayerBackPropagationLM;
 
 /// EmbeddingLayer has inputs of a fixed length (input_length) and within a fixed set of possible integer values (input_dim).
 /// The layer will assign to each possible value a dense vector of fixed length (depth).
-/// The vectors are learnable parameters, which is implemented by passing a one-hot encoding of each value through a PerceptronLayer.
+/// The vectors are learnable parameters, stored in a lookup table with a row for each possible value.
+/// The rows are contiguous in memory, so the table is mapped with dimensions (depth, input_dim).
+/// The outputs are gathered from the rows of the table, and the gradient only has derivatives in the rows of the values in the batch.
 
 
 class EmbeddingLayer : public Layer
@@ -68,6 +73,11 @@ public:
                             const bool& = false, /// Add positional encoding or not
                             const PerceptronLayer::ActivationFunction& = PerceptronLayer::ActivationFunction::Linear);
 
+    /// The lookup table is a view of storage which a copy would share, so copies are not allowed.
+
+    EmbeddingLayer(const EmbeddingLayer&) = delete;
+    EmbeddingLayer& operator=(const EmbeddingLayer&) = delete;
+
     // Get methods
 
     bool is_empty() const;
@@ -75,9 +85,17 @@ public:
     Index get_input_dim() const;
     Index get_input_length() const;
     Index get_depth() const;
-    PerceptronLayer get_perceptron_layer() const;
+
+    Index get_inputs_number() const final;
+    Index get_neurons_number() const final;
+
+    const TensorMap<Tensor<type, 2>>& get_embedding_weights() const;
+
+    const Tensor<type, 2>& get_positional_encoding_matrix() const;
 
     Index get_parameters_number() const final;
+    Tensor<type, 1> get_parameters() const final;
+    type* get_parameters_data() const final;
 
     const PerceptronLayer::ActivationFunction& get_activation_function() const;
 
@@ -102,7 +120,19 @@ public:
     void set_input_length(const Index&);
     void set_depth(const Index&);
 
-    void set_perceptron();
+    void allocate_parameters();
+
+    void set_positional_encoding_matrix();
+
+    // Parameters
+
+    void set_parameters(const Tensor<type, 1>&, const Index& index = 0) final;
+    void set_parameters_data(type*) final;
+
+    // Parameters initialization methods
+
+    void set_parameters_constant(const type&) final;
+    void set_parameters_random() final;
 
     void set_activation_function(const PerceptronLayer::ActivationFunction&);
     void set_activation_function(const string&);
@@ -113,9 +143,9 @@ public:
 
     // Embedding lookup
 
-    Tensor<type, 2> one_hot_encode_row(const Tensor<type, 1>&);
+    void calculate_tokens(const TensorMap<Tensor<type, 2>>&, Tensor<Index, 1>&) const;
 
-    void lookup_embedding(const Tensor<type, 1>&, PerceptronLayerForwardPropagation*, const bool&);
+    void lookup_embedding(const Tensor<Index, 1>&, type*) const;
 
     // Positional encoding
 
@@ -125,6 +155,16 @@ public:
 
     void forward_propagate(const Tensor<DynamicTensor<type>, 1>&, LayerForwardPropagation*, const bool&) final;
 
+    // Delta methods
+
+    void calculate_hidden_delta(LayerForwardPropagation*, LayerBackPropagation*, LayerBackPropagation*) const final;
+
+    // Gradient methods
+
+    void calculate_error_gradient(type*, LayerForwardPropagation*, LayerBackPropagation*) const final;
+
+    void insert_gradient(LayerBackPropagation*, const Index&, Tensor<type, 1>&) const final;
+
     /*
     void forward_propagate(type*,
                            const Tensor<Index, 1>&,
@@ -159,14 +199,23 @@ protected:
 
     Index depth;
 
-    /// Perceptron layer
+    /// Storage of the lookup table, used while the layer is not part of a parameters arena.
 
-    PerceptronLayer perceptron_layer;
+    Tensor<type, 1> parameters;
+
+    /// Lookup table, with a contiguous row for each possible input value.
+    /// It is mapped with dimensions (depth, input_dim), so the row of a value is the column of the map.
+
+    TensorMap<Tensor<type, 2>> embedding_weights = TensorMap<Tensor<type, 2>>(nullptr, 0, 0);
 
     /// Whether the layer has to add positional encoding or not
 
     bool positional_encoding;
 
+    /// Positional encoding added to the outputs, built once for the input length and the depth of the layer.
+
+    Tensor<type, 2> positional_encoding_matrix;
+
     /// Activation function variable.
 
     PerceptronLayer::ActivationFunction activation_function;
@@ -202,13 +251,15 @@ protected:
 
         void set(const Index& new_batch_samples_number, Layer* new_layer_pointer)
         {
-            EmbeddingLayer* layer_pointer = static_cast<EmbeddingLayer*>(new_layer_pointer);
+            layer_pointer = new_layer_pointer;
 
             batch_samples_number = new_batch_samples_number;
 
-            const Index input_length = layer_pointer->get_input_length();
+            const EmbeddingLayer* embedding_layer_pointer = static_cast<EmbeddingLayer*>(layer_pointer);
+
+            const Index input_length = embedding_layer_pointer->get_input_length();
 
-            const Index depth = layer_pointer->get_depth();
+            const Index depth = embedding_layer_pointer->get_depth();
 
             // Outputs
 
@@ -219,9 +270,7 @@ protected:
 
             // Rest of quantities
 
-            PerceptronLayer perceptron_layer = layer_pointer-> get_perceptron_layer();
-
-            perceptron_forward_propagation.set(input_length, &perceptron_layer);
+            tokens.resize(batch_samples_number*input_length);
         }
 
         void print() const
@@ -240,7 +289,9 @@ protected:
             //            cout << attention_scores << endl;
         }
 
-        PerceptronLayerForwardPropagation perceptron_forward_propagation;
+        /// Input values of the batch as row indices of the lookup table, in the order of the inputs.
+
+        Tensor<Index, 1> tokens;
     };
 
 
@@ -318,38 +369,69 @@ protected:
             set(new_batch_samples_number, new_layer_pointer);
         }
 
-        /// @todo
-        /*
+        /// The derivatives are views of a gradient which a copy would share, so copies are not allowed.
+
+        EmbeddingLayerBackPropagation(const EmbeddingLayerBackPropagation&) = delete;
+        EmbeddingLayerBackPropagation& operator=(const EmbeddingLayerBackPropagation&) = delete;
+
         void set(const Index& new_batch_samples_number, Layer* new_layer_pointer)
         {
             layer_pointer = new_layer_pointer;
 
             batch_samples_number = new_batch_samples_number;
 
-            const Index neurons_number = layer_pointer->get_neurons_number();
-            const Index inputs_number = layer_pointer->get_inputs_number();
+            const EmbeddingLayer* embedding_layer_pointer = static_cast<EmbeddingLayer*>(layer_pointer);
+
+            const Index input_dim = embedding_layer_pointer->get_input_dim();
+            const Index input_length = embedding_layer_pointer->get_input_length();
+            const Index depth = embedding_layer_pointer->get_depth();
+
+            deltas_dimensions.resize(3);
+            deltas_dimensions.setValues({batch_samples_number, input_length, depth});
 
-            deltas_dimensions.resize(2);
-            deltas_dimensions.setValues({batch_samples_number, neurons_number});
+            deltas_data = (type*)malloc(static_cast<size_t>(batch_samples_number*input_length*depth*sizeof(type)));
 
-            deltas_data = (type*)malloc( static_cast<size_t>(batch_samples_number*neurons_number*sizeof(type)));
+            gradient.resize(input_dim*depth);
 
-            biases_derivatives.resize(neurons_number);
+            set_gradient_data(gradient.data());
 
-            synaptic_weights_derivatives.resize(inputs_number, neurons_number);
+            // A batch touches at most a row for each input value
 
-            deltas_times_activations_derivatives.resize(batch_samples_number, neurons_number);
+            rows_indices.resize(batch_samples_number*input_length);
+
+            rows_number = 0;
+
+            positions.resize(batch_samples_number*input_length);
+
+            rows_beginnings.resize(batch_samples_number*input_length + 1);
         }
 
-        Tensor< TensorMap< Tensor<type, 1> >*, 1> get_layer_gradient()
+
+        void set_gradient_data(type* new_gradient_data) final
         {
-            Tensor< TensorMap< Tensor<type, 1> >*, 1> layer_gradient(2);
+            const EmbeddingLayer* embedding_layer_pointer = static_cast<EmbeddingLayer*>(layer_pointer);
 
-            const Index inputs_number = layer_pointer->get_inputs_number();
-            const Index neurons_number = layer_pointer->get_neurons_number();
+            new (&embedding_weights_derivatives) TensorMap<Tensor<type, 2>>(new_gradient_data,
+                                                                            embedding_layer_pointer->get_depth(),
+                                                                            embedding_layer_pointer->get_input_dim());
 
-            layer_gradient(0) = new TensorMap<Tensor<type, 1>>(biases_derivatives.data(), neurons_number);
-            layer_gradient(1) = new TensorMap<Tensor<type, 1>>(synaptic_weights_derivatives.data(), inputs_number*neurons_number);
+            if(new_gradient_data != gradient.data()) gradient.resize(0);
+
+            has_sparse_derivatives = false;
+        }
+
+
+        void set_gradient_modified() final
+        {
+            has_sparse_derivatives = false;
+        }
+
+
+        Tensor< TensorMap< Tensor<type, 1> >*, 1> get_layer_gradient()
+        {
+            Tensor< TensorMap< Tensor<type, 1> >*, 1> layer_gradient(1);
+
+            layer_gradient(0) = new TensorMap<Tensor<type, 1>>(embedding_weights_derivatives.data(), embedding_weights_derivatives.size());
 
             return layer_gradient;
         }
@@ -357,21 +439,35 @@ protected:
 
         void print() const
         {
-            cout << "Deltas:" << endl;
-            //cout << deltas << endl;
-
-            cout << "Biases derivatives:" << endl;
-            cout << biases_derivatives << endl;
+            cout << "Rows indices:" << endl;
+            cout << rows_indices.slice(Eigen::array<Index, 1>({0}), Eigen::array<Index, 1>({rows_number})) << endl;
 
-            cout << "Synaptic weights derivatives:" << endl;
-            cout << synaptic_weights_derivatives << endl;
+            cout << "Embedding weights derivatives:" << endl;
+            cout << embedding_weights_derivatives << endl;
         }
 
-        Tensor<type, 1> biases_derivatives;
-        Tensor<type, 2> synaptic_weights_derivatives;
+        /// Derivatives of the lookup table, with the layout of the table. Only the rows in rows_indices can be different from zero.
 
-        Tensor<type, 2> deltas_times_activations_derivatives;
-*/
+        TensorMap<Tensor<type, 2>> embedding_weights_derivatives = TensorMap<Tensor<type, 2>>(nullptr, 0, 0);
+
+        /// Sorted rows of the lookup table which have derivatives. Only the first rows_number are valid.
+
+        Tensor<Index, 1> rows_indices;
+
+        Index rows_number = 0;
+
+        /// Positions of the inputs of the batch, sorted by input value.
+
+        Tensor<Index, 1> positions;
+
+        /// First element in positions of each row in rows_indices, followed by the number of inputs.
+
+        Tensor<Index, 1> rows_beginnings;
+
+        /// Whether all the derivatives outside the rows in rows_indices are zero,
+        /// so that the next batch only has to clear those rows instead of the whole table.
+
+        bool has_sparse_derivatives = false;
     };
 
 }
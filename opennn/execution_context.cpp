@@ -0,0 +1,450 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   E X E C U T I O N   C O N T E X T   C L A S S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "execution_context.h"
+
+#include <atomic>
+#include <fstream>
+#include <thread>
+
+#ifdef __linux__
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+namespace opennn
+{
+
+/// Default constructor.
+/// It creates a pool with as many threads as OpenMP would use, not pinned to any core.
+
+ExecutionContext::ExecutionContext()
+{
+    threads_number = omp_get_max_threads();
+
+    build();
+}
+
+
+/// Destructor.
+
+ExecutionContext::~ExecutionContext()
+{
+    if(thread_pool_device != nullptr) thread_pool_device->~ThreadPoolDevice();
+}
+
+
+/// Returns the unique execution context of the process, which is created the first time it is used.
+
+ExecutionContext& ExecutionContext::get_instance()
+{
+    static ExecutionContext execution_context;
+
+    return execution_context;
+}
+
+
+/// Returns a pointer to the thread pool device shared by all the objects.
+/// The pointer remains valid when the number of threads or the pinning change.
+
+ThreadPoolDevice* ExecutionContext::get_thread_pool_device()
+{
+    return get_instance().thread_pool_device;
+}
+
+
+/// Returns the number of worker threads of the shared pool.
+
+int ExecutionContext::get_threads_number()
+{
+    return get_instance().threads_number;
+}
+
+
+/// Returns true if the worker threads are pinned to single cores, and false otherwise.
+
+bool ExecutionContext::get_pin_threads()
+{
+    return get_instance().pin;
+}
+
+
+/// Returns the NUMA node whose cores are used by the worker threads, or -1 if they can run on any core.
+
+int ExecutionContext::get_numa_node()
+{
+    return get_instance().numa_node;
+}
+
+
+/// Returns the cores on which the worker threads can run.
+/// These are the cores of the selected NUMA node, or all the cores available to the process.
+
+Tensor<int, 1> ExecutionContext::get_cores()
+{
+    const int node = get_instance().numa_node;
+
+    if(node >= 0) return get_numa_node_cores(node);
+
+    vector<int> cores;
+
+#ifdef __linux__
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+
+    if(sched_getaffinity(0, sizeof(cpu_set_t), &cpu_set) == 0)
+    {
+        for(int i = 0; i < CPU_SETSIZE; i++)
+        {
+            if(CPU_ISSET(i, &cpu_set)) cores.push_back(i);
+        }
+    }
+
+#endif
+
+    if(cores.empty())
+    {
+        const int cores_number = max(1, static_cast<int>(thread::hardware_concurrency()));
+
+        for(int i = 0; i < cores_number; i++) cores.push_back(i);
+    }
+
+    Tensor<int, 1> cores_tensor(static_cast<Index>(cores.size()));
+
+    copy(cores.begin(), cores.end(), cores_tensor.data());
+
+    return cores_tensor;
+}
+
+
+/// Sets a new number of worker threads, and rebuilds the shared pool.
+/// The number of OpenMP threads is set to the same value, so that both never oversubscribe the machine.
+/// @param new_threads_number Number of threads.
+
+void ExecutionContext::set_threads_number(const int& new_threads_number)
+{
+    ExecutionContext& execution_context = get_instance();
+
+    set(new_threads_number, execution_context.pin, execution_context.numa_node);
+}
+
+
+/// Sets whether the worker threads must be pinned to single cores.
+/// @param new_pin True to pin each thread to a core, false to let the system schedule them.
+
+void ExecutionContext::set_pin_threads(const bool& new_pin)
+{
+    ExecutionContext& execution_context = get_instance();
+
+    set(execution_context.threads_number, new_pin, execution_context.numa_node);
+}
+
+
+/// Restricts the worker threads to the cores of a NUMA node.
+/// @param new_numa_node Index of the node, or -1 to use all the cores.
+
+void ExecutionContext::set_numa_node(const int& new_numa_node)
+{
+    ExecutionContext& execution_context = get_instance();
+
+    set(execution_context.threads_number, execution_context.pin, new_numa_node);
+}
+
+
+/// Sets all the members of the execution context at once, and rebuilds the shared pool only if any of them changed.
+/// @param new_threads_number Number of threads.
+/// @param new_pin True to pin each thread to a core.
+/// @param new_numa_node NUMA node to run on, or -1 to use all the cores.
+
+void ExecutionContext::set(const int& new_threads_number, const bool& new_pin, const int& new_numa_node)
+{
+    if(new_threads_number < 1)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: ExecutionContext class.\n"
+               << "void set(const int&, const bool&, const int&) method.\n"
+               << "Number of threads must be greater than 0: " << new_threads_number << "\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    if(new_numa_node >= get_numa_nodes_number())
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: ExecutionContext class.\n"
+               << "void set(const int&, const bool&, const int&) method.\n"
+               << "NUMA node " << new_numa_node << " does not exist.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    ExecutionContext& execution_context = get_instance();
+
+    lock_guard<mutex> lock(execution_context.context_mutex);
+
+    omp_set_num_threads(new_threads_number);
+
+    if(new_threads_number == execution_context.threads_number
+    && new_pin == execution_context.pin
+    && new_numa_node == execution_context.numa_node)
+        return;
+
+    execution_context.threads_number = new_threads_number;
+    execution_context.pin = new_pin;
+    execution_context.numa_node = new_numa_node < 0 ? -1 : new_numa_node;
+
+    execution_context.build();
+}
+
+
+/// Returns the number of NUMA nodes of the machine, or 1 if it cannot be known.
+
+int ExecutionContext::get_numa_nodes_number()
+{
+    int nodes_number = 0;
+
+#ifdef __linux__
+
+    while(ifstream("/sys/devices/system/node/node" + to_string(nodes_number) + "/cpulist").good())
+        nodes_number++;
+
+#endif
+
+    return max(nodes_number, 1);
+}
+
+
+/// Returns the cores which belong to a NUMA node, as listed by the operating system.
+/// @param node Index of the node.
+
+Tensor<int, 1> ExecutionContext::get_numa_node_cores(const int& node)
+{
+    vector<int> cores;
+
+#ifdef __linux__
+
+    ifstream file("/sys/devices/system/node/node" + to_string(node) + "/cpulist");
+
+    string cpu_list;
+
+    getline(file, cpu_list);
+
+    // The list has the form "0-15,32-47"
+
+    stringstream cpu_list_stream(cpu_list);
+
+    string range;
+
+    while(getline(cpu_list_stream, range, ','))
+    {
+        if(range.empty()) continue;
+
+        const size_t dash_position = range.find('-');
+
+        const int first = stoi(range.substr(0, dash_position));
+        const int last = dash_position == string::npos ? first : stoi(range.substr(dash_position + 1));
+
+        for(int i = first; i <= last; i++) cores.push_back(i);
+    }
+
+#endif
+
+    if(cores.empty())
+    {
+        if(node != 0)
+        {
+            ostringstream buffer;
+
+            buffer << "OpenNN Exception: ExecutionContext class.\n"
+                   << "static Tensor<int, 1> get_numa_node_cores(const int&) method.\n"
+                   << "Cannot read the cores of NUMA node " << node << ".\n";
+
+            throw invalid_argument(buffer.str());
+        }
+
+        // Machines without NUMA information are treated as a single node with all the cores.
+
+        const int cores_number = max(1, static_cast<int>(thread::hardware_concurrency()));
+
+        for(int i = 0; i < cores_number; i++) cores.push_back(i);
+    }
+
+    Tensor<int, 1> cores_tensor(static_cast<Index>(cores.size()));
+
+    copy(cores.begin(), cores.end(), cores_tensor.data());
+
+    return cores_tensor;
+}
+
+
+/// Runs a number of independent tasks concurrently, and returns when all of them have finished.
+/// The calling thread runs the first task, and the rest are scheduled on the tasks pool.
+/// With a single thread, or when called from a task, the tasks run one after the other.
+/// If any task throws, the first exception is rethrown once all the tasks have finished.
+/// @param tasks_number Number of tasks.
+/// @param task Function which runs the task with the given index.
+
+void ExecutionContext::run_concurrently(const Index& tasks_number, const function<void(const Index&)>& task)
+{
+    ExecutionContext& execution_context = get_instance();
+
+    ThreadPool* tasks_thread_pool = tasks_number > 1 && execution_context.threads_number > 1
+            ? execution_context.get_tasks_thread_pool()
+            : nullptr;
+
+    if(tasks_thread_pool == nullptr || tasks_thread_pool->CurrentThreadId() != -1)
+    {
+        for(Index i = 0; i < tasks_number; i++) task(i);
+
+        return;
+    }
+
+    vector<exception_ptr> exceptions(static_cast<size_t>(tasks_number));
+
+    Barrier barrier(static_cast<unsigned>(tasks_number - 1));
+
+    for(Index i = 1; i < tasks_number; i++)
+    {
+        tasks_thread_pool->Schedule([&, i]()
+        {
+            try
+            {
+                task(i);
+            }
+            catch(...)
+            {
+                exceptions[static_cast<size_t>(i)] = current_exception();
+            }
+
+            barrier.Notify();
+        });
+    }
+
+    try
+    {
+        task(0);
+    }
+    catch(...)
+    {
+        exceptions[0] = current_exception();
+    }
+
+    barrier.Wait();
+
+    for(const exception_ptr& exception : exceptions)
+    {
+        if(exception) rethrow_exception(exception);
+    }
+}
+
+
+/// Returns the pool for independent tasks, creating it if needed.
+/// The calling thread also runs tasks, so the pool has one thread less than the device.
+
+ThreadPool* ExecutionContext::get_tasks_thread_pool()
+{
+    lock_guard<mutex> lock(context_mutex);
+
+    if(!tasks_thread_pool) tasks_thread_pool.reset(new ThreadPool(max(threads_number - 1, 1)));
+
+    return tasks_thread_pool.get();
+}
+
+
+/// Creates a new pool with the current number of threads, and constructs the device in place on top of it.
+/// The old pool is destroyed, joining its threads, after the device already refers to the new one.
+
+void ExecutionContext::build()
+{
+    unique_ptr<ThreadPool> new_thread_pool(new ThreadPool(threads_number));
+
+    if(thread_pool_device != nullptr) thread_pool_device->~ThreadPoolDevice();
+
+    thread_pool_device = new (thread_pool_device_storage) ThreadPoolDevice(new_thread_pool.get(), threads_number);
+
+    thread_pool = move(new_thread_pool);
+
+    tasks_thread_pool.reset();
+
+    if(pin || numa_node >= 0) pin_threads();
+}
+
+
+/// Sets the affinity of every worker thread.
+/// When pinning, worker i runs only on core i modulo the number of available cores.
+/// Otherwise, workers can run on any of the available cores, which restricts them to the NUMA node if one is selected.
+
+void ExecutionContext::pin_threads()
+{
+#ifdef __linux__
+
+    const Tensor<int, 1> cores = get_cores();
+
+    const int cores_number = static_cast<int>(cores.size());
+
+    atomic<int> started_threads_number(0);
+
+    Barrier barrier(static_cast<unsigned>(threads_number));
+
+    // Every task waits until all of them have started, so that each one runs on a different worker.
+
+    for(int i = 0; i < threads_number; i++)
+    {
+        thread_pool->Schedule([&]()
+        {
+            const int thread_index = thread_pool->CurrentThreadId();
+
+            cpu_set_t cpu_set;
+            CPU_ZERO(&cpu_set);
+
+            if(pin)
+            {
+                CPU_SET(cores(thread_index%cores_number), &cpu_set);
+            }
+            else
+            {
+                for(int j = 0; j < cores_number; j++) CPU_SET(cores(j), &cpu_set);
+            }
+
+            pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set);
+
+            started_threads_number++;
+
+            while(started_threads_number.load() < threads_number) this_thread::yield();
+
+            barrier.Notify();
+        });
+    }
+
+    barrier.Wait();
+
+#endif
+}
+
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -0,0 +1,142 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   E X E C U T I O N   C O N T E X T   C L A S S   H E A D E R
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#ifndef EXECUTIONCONTEXT_H
+#define EXECUTIONCONTEXT_H
+
+// System includes
+
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sstream>
+
+// OpenNN includes
+
+#include "config.h"
+
+namespace opennn
+{
+
+/// This class holds the thread pool shared by all the objects of the library.
+
+/// Layers, loss indices, optimization algorithms, learning rate algorithms, data sets and testing analyses
+/// evaluate their tensor expressions on the same thread pool device, instead of creating their own pools.
+/// The device returned by get_thread_pool_device() keeps its address for the whole life of the program,
+/// so objects can store the pointer, and set_threads_number() rebuilds the pool behind it.
+/// Optionally, the worker threads can be pinned to cores, and restricted to the cores of a NUMA node.
+///
+/// Independent tasks, such as the branches of a neural network, run on a second work-stealing pool.
+/// The tasks wait for the expressions they evaluate on the device, so they cannot share its workers.
+///
+/// The context must not be modified while another thread is evaluating expressions on the device.
+
+class ExecutionContext
+{
+
+public:
+
+    // Get methods
+
+    static ThreadPoolDevice* get_thread_pool_device();
+
+    static int get_threads_number();
+
+    static bool get_pin_threads();
+
+    static int get_numa_node();
+
+    static Tensor<int, 1> get_cores();
+
+    // Set methods
+
+    static void set_threads_number(const int&);
+
+    static void set_pin_threads(const bool&);
+
+    static void set_numa_node(const int&);
+
+    static void set(const int&, const bool&, const int&);
+
+    // Topology methods
+
+    static int get_numa_nodes_number();
+
+    static Tensor<int, 1> get_numa_node_cores(const int&);
+
+    // Tasks methods
+
+    static void run_concurrently(const Index&, const function<void(const Index&)>&);
+
+private:
+
+    explicit ExecutionContext();
+
+    virtual ~ExecutionContext();
+
+    static ExecutionContext& get_instance();
+
+    void build();
+
+    void pin_threads();
+
+    ThreadPool* get_tasks_thread_pool();
+
+    /// Pool of worker threads.
+
+    unique_ptr<ThreadPool> thread_pool;
+
+    /// Storage for the device, so that its address does not change when the pool is rebuilt.
+
+    alignas(ThreadPoolDevice) unsigned char thread_pool_device_storage[sizeof(ThreadPoolDevice)];
+
+    ThreadPoolDevice* thread_pool_device = nullptr;
+
+    /// Pool of threads for independent tasks. It is created the first time that several tasks run concurrently.
+
+    unique_ptr<ThreadPool> tasks_thread_pool;
+
+    /// Number of worker threads.
+
+    int threads_number = 0;
+
+    /// True if each worker thread is bound to a single core.
+
+    bool pin = false;
+
+    /// NUMA node whose cores are used by the workers, or -1 to use all of them.
+
+    int numa_node = -1;
+
+    mutex context_mutex;
+};
+
+}
+
+#endif
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
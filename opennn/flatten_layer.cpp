@@ -195,7 +195,7 @@ void FlattenLayer::calculate_hidden_delta(PerceptronLayerForwardPropagation* nex
                                           PerceptronLayerBackPropagation* next_perceptron_layer_back_propagation,
                                           FlattenLayerBackPropagation* flatten_layer_back_propagation) const
 {
-    const Tensor<type, 2>& next_synaptic_weights = static_cast<PerceptronLayer*>(next_perceptron_layer_back_propagation->layer_pointer)->get_synaptic_weights();
+    const TensorMap<Tensor<type, 2>>& next_synaptic_weights = static_cast<PerceptronLayer*>(next_perceptron_layer_back_propagation->layer_pointer)->get_synaptic_weights();
 
     const TensorMap<Tensor<type, 2>> next_deltas(next_perceptron_layer_back_propagation->deltas_data,
                                                  next_perceptron_layer_back_propagation->deltas_dimensions(0),
@@ -222,7 +222,7 @@ void FlattenLayer::calculate_hidden_delta(ProbabilisticLayerForwardPropagation*
 
     const ProbabilisticLayer* probabilistic_layer_pointer = static_cast<ProbabilisticLayer*>(next_perceptron_layer_back_propagation->layer_pointer);
 
-    const Tensor<type, 2>& next_synaptic_weights = probabilistic_layer_pointer->get_synaptic_weights();
+    const TensorMap<Tensor<type, 2>>& next_synaptic_weights = probabilistic_layer_pointer->get_synaptic_weights();
 
     const Index next_neurons_number = probabilistic_layer_pointer->get_biases_number();
 
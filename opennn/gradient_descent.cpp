@@ -366,6 +366,8 @@ TrainingResults GradientDescent::perform_training()
     neural_network_pointer->set_inputs_names(inputs_names);
     neural_network_pointer->set_outputs_names(targets_names);
 
+    neural_network_pointer->set_inputs_categories_numbers(data_set_pointer->get_input_categories_numbers());
+
     if(neural_network_pointer->has_scaling_layer())
     {
         ScalingLayer* scaling_layer_pointer = neural_network_pointer->get_scaling_layer_pointer();
@@ -181,6 +181,8 @@ NeuronsSelectionResults GrowingNeurons::perform_neurons_selection()
 
         trainable_layers_pointers(trainable_layers_number-1)->set_inputs_number(neurons_number);
 
+        neural_network->allocate_parameters_arena();
+
         neurons_selection_results.neurons_number_history(epoch) = neurons_number;
 
         // Loss index
@@ -299,6 +301,8 @@ NeuronsSelectionResults GrowingNeurons::perform_neurons_selection()
     trainable_layers_pointers[trainable_layers_number-1]->set_inputs_number(neurons_selection_results.optimal_neurons_number);
     trainable_layers_pointers[trainable_layers_number-2]->set_neurons_number(neurons_selection_results.optimal_neurons_number);
 
+    neural_network->allocate_parameters_arena();
+
     neural_network->set_parameters(neurons_selection_results.optimal_parameters);
 
     if(display) neurons_selection_results.print();
@@ -0,0 +1,366 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   I M A G E   A U G M E N T A T I O N   C L A S S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "image_augmentation.h"
+
+namespace opennn
+{
+
+/// Default constructor.
+/// It creates an augmentation for empty images, which does not transform them.
+
+ImageAugmentation::ImageAugmentation()
+{
+}
+
+
+/// Images dimensions constructor.
+/// It creates an augmentation which does not transform the images until its ranges are set.
+/// @param new_rows_number Number of rows of the images.
+/// @param new_columns_number Number of columns of the images.
+/// @param new_channels_number Number of channels of the images.
+
+ImageAugmentation::ImageAugmentation(const Index& new_rows_number,
+                                     const Index& new_columns_number,
+                                     const Index& new_channels_number)
+{
+    set(new_rows_number, new_columns_number, new_channels_number);
+}
+
+
+/// Destructor.
+
+ImageAugmentation::~ImageAugmentation()
+{
+}
+
+
+/// Returns the number of rows of the images.
+
+const Index& ImageAugmentation::get_rows_number() const
+{
+    return rows_number;
+}
+
+
+/// Returns the number of columns of the images.
+
+const Index& ImageAugmentation::get_columns_number() const
+{
+    return columns_number;
+}
+
+
+/// Returns the number of channels of the images.
+
+const Index& ImageAugmentation::get_channels_number() const
+{
+    return channels_number;
+}
+
+
+/// Returns true if the augmentation leaves every image unchanged, and false otherwise.
+
+bool ImageAugmentation::is_identity() const
+{
+    return !random_reflection_axis_x
+        && !random_reflection_axis_y
+        && abs(random_rotation_minimum) < NUMERIC_LIMITS_MIN
+        && abs(random_rotation_maximum) < NUMERIC_LIMITS_MIN
+        && abs(random_horizontal_translation_minimum) < NUMERIC_LIMITS_MIN
+        && abs(random_horizontal_translation_maximum) < NUMERIC_LIMITS_MIN
+        && abs(random_vertical_translation_minimum) < NUMERIC_LIMITS_MIN
+        && abs(random_vertical_translation_maximum) < NUMERIC_LIMITS_MIN;
+}
+
+
+/// Sets empty images and releases the scratch memory.
+
+void ImageAugmentation::set()
+{
+    rows_number = 0;
+    columns_number = 0;
+    channels_number = 0;
+
+    images_scratch.resize(0, 0);
+    source_indices_scratch.resize(0, 0);
+}
+
+
+/// Sets the dimensions of the images, and allocates a scratch image for each thread of the execution context.
+/// @param new_rows_number Number of rows of the images.
+/// @param new_columns_number Number of columns of the images.
+/// @param new_channels_number Number of channels of the images.
+
+void ImageAugmentation::set(const Index& new_rows_number,
+                            const Index& new_columns_number,
+                            const Index& new_channels_number)
+{
+    if(new_rows_number < 0 || new_columns_number < 0 || new_channels_number < 0)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: ImageAugmentation class.\n"
+               << "void set(const Index&, const Index&, const Index&) method.\n"
+               << "Images dimensions (" << new_rows_number << ", " << new_columns_number << ", " << new_channels_number << ") "
+               << "must be greater than or equal to 0.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    rows_number = new_rows_number;
+    columns_number = new_columns_number;
+    channels_number = new_channels_number;
+
+    const Index tasks_number = max(Index(1), Index(ExecutionContext::get_threads_number()));
+
+    images_scratch.resize(rows_number*columns_number*channels_number, tasks_number);
+    source_indices_scratch.resize(rows_number*columns_number, tasks_number);
+}
+
+
+/// Sets whether the columns of the images are reflected with probability one half.
+/// @param new_random_reflection_axis_x True if the images are randomly reflected.
+
+void ImageAugmentation::set_random_reflection_axis_x(const bool& new_random_reflection_axis_x)
+{
+    random_reflection_axis_x = new_random_reflection_axis_x;
+}
+
+
+/// Sets whether the rows of the images are reflected with probability one half.
+/// @param new_random_reflection_axis_y True if the images are randomly reflected.
+
+void ImageAugmentation::set_random_reflection_axis_y(const bool& new_random_reflection_axis_y)
+{
+    random_reflection_axis_y = new_random_reflection_axis_y;
+}
+
+
+/// Sets the minimum angle, in degrees, of the random rotations.
+/// @param new_random_rotation_minimum Minimum angle.
+
+void ImageAugmentation::set_random_rotation_minimum(const type& new_random_rotation_minimum)
+{
+    random_rotation_minimum = new_random_rotation_minimum;
+}
+
+
+/// Sets the maximum angle, in degrees, of the random rotations.
+/// @param new_random_rotation_maximum Maximum angle.
+
+void ImageAugmentation::set_random_rotation_maximum(const type& new_random_rotation_maximum)
+{
+    random_rotation_maximum = new_random_rotation_maximum;
+}
+
+
+/// Sets the minimum shift, in pixels, of the random translations along the columns.
+/// @param new_random_horizontal_translation_minimum Minimum shift.
+
+void ImageAugmentation::set_random_horizontal_translation_minimum(const type& new_random_horizontal_translation_minimum)
+{
+    random_horizontal_translation_minimum = new_random_horizontal_translation_minimum;
+}
+
+
+/// Sets the maximum shift, in pixels, of the random translations along the columns.
+/// @param new_random_horizontal_translation_maximum Maximum shift.
+
+void ImageAugmentation::set_random_horizontal_translation_maximum(const type& new_random_horizontal_translation_maximum)
+{
+    random_horizontal_translation_maximum = new_random_horizontal_translation_maximum;
+}
+
+
+/// Sets the minimum shift, in pixels, of the random translations along the rows.
+/// @param new_random_vertical_translation_minimum Minimum shift.
+
+void ImageAugmentation::set_random_vertical_translation_minimum(const type& new_random_vertical_translation_minimum)
+{
+    random_vertical_translation_minimum = new_random_vertical_translation_minimum;
+}
+
+
+/// Sets the maximum shift, in pixels, of the random translations along the rows.
+/// @param new_random_vertical_translation_maximum Maximum shift.
+
+void ImageAugmentation::set_random_vertical_translation_maximum(const type& new_random_vertical_translation_maximum)
+{
+    random_vertical_translation_maximum = new_random_vertical_translation_maximum;
+}
+
+
+/// Returns the seed of the random transformation of a sample, by mixing the seed of its batch with its index.
+/// @param seed Seed of the batch.
+/// @param sample_index Index of the sample in the data set.
+
+unsigned ImageAugmentation::calculate_sample_seed(const unsigned& seed, const Index& sample_index)
+{
+    uint64_t state = (uint64_t(seed) << 32) ^ uint64_t(sample_index);
+
+    state += 0x9E3779B97F4A7C15ULL;
+    state = (state ^ (state >> 30))*0xBF58476D1CE4E5B9ULL;
+    state = (state ^ (state >> 27))*0x94D049BB133111EBULL;
+    state = state ^ (state >> 31);
+
+    return unsigned(state >> 32);
+}
+
+
+/// Draws a random transformation and calculates, for each pixel of the transformed image,
+/// the index of the source pixel in the column major image, or -1 if it falls outside the image.
+/// The image is reflected, then rotated around its centre and then translated.
+/// @param random_engine Generator of the transformation.
+/// @param source_indices Pointer to the rows times columns source indices.
+
+void ImageAugmentation::calculate_source_indices(mt19937& random_engine, Index* source_indices) const
+{
+    bernoulli_distribution reflection_distribution(0.5);
+
+    const bool reflect_columns = random_reflection_axis_x && reflection_distribution(random_engine);
+    const bool reflect_rows = random_reflection_axis_y && reflection_distribution(random_engine);
+
+    const type angle = calculate_random_uniform(random_engine, random_rotation_minimum, random_rotation_maximum)
+            *type(3.14159265358979323846)/type(180);
+
+    const type horizontal_translation
+            = calculate_random_uniform(random_engine, random_horizontal_translation_minimum, random_horizontal_translation_maximum);
+
+    const type vertical_translation
+            = calculate_random_uniform(random_engine, random_vertical_translation_minimum, random_vertical_translation_maximum);
+
+    const type cos_angle = cos(angle);
+    const type sin_angle = sin(angle);
+
+    const type center_row = type(rows_number - 1)/type(2);
+    const type center_column = type(columns_number - 1)/type(2);
+
+    for(Index column = 0; column < columns_number; column++)
+    {
+        for(Index row = 0; row < rows_number; row++)
+        {
+            // Inverse translation, rotation and reflection
+
+            const type x = type(column) - center_column - horizontal_translation;
+            const type y = type(row) - center_row - vertical_translation;
+
+            type source_x = cos_angle*x + sin_angle*y;
+            type source_y = -sin_angle*x + cos_angle*y;
+
+            if(reflect_columns) source_x = -source_x;
+            if(reflect_rows) source_y = -source_y;
+
+            const Index source_column = Index(lround(source_x + center_column));
+            const Index source_row = Index(lround(source_y + center_row));
+
+            source_indices[row + rows_number*column]
+                    = (source_row < 0 || source_row >= rows_number || source_column < 0 || source_column >= columns_number)
+                    ? -1
+                    : source_row + rows_number*source_column;
+        }
+    }
+}
+
+
+/// Augments in place the images of a batch.
+/// The batch tensor is column major, with dimensions images, rows, columns and channels.
+/// @param images Pointer to the batch of images.
+/// @param images_number Number of images of the batch.
+/// @param samples_indices Indices in the data set of the samples of the batch.
+/// @param seed Seed of the batch.
+
+void ImageAugmentation::augment(type* images,
+                                const Index& images_number,
+                                const Tensor<Index, 1>& samples_indices,
+                                const unsigned& seed)
+{
+    if(samples_indices.size() < images_number)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: ImageAugmentation class.\n"
+               << "void augment(type*, const Index&, const Tensor<Index, 1>&, const unsigned&) method.\n"
+               << "Number of samples indices (" << samples_indices.size() << ") must be greater than or equal to "
+               << "number of images (" << images_number << ").\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    if(is_identity() || images_number == 0) return;
+
+    const Index pixels_number = rows_number*columns_number;
+    const Index image_size = pixels_number*channels_number;
+
+    const Index tasks_number = min(Index(images_scratch.dimension(1)), images_number);
+
+    ExecutionContext::run_concurrently(tasks_number, [&](const Index& task)
+    {
+        type* image = images_scratch.data() + task*image_size;
+        Index* source_indices = source_indices_scratch.data() + task*pixels_number;
+
+        for(Index i = task; i < images_number; i += tasks_number)
+        {
+            mt19937 random_engine(calculate_sample_seed(seed, samples_indices(i)));
+
+            calculate_source_indices(random_engine, source_indices);
+
+            for(Index j = 0; j < image_size; j++)
+            {
+                image[j] = images[i + images_number*j];
+            }
+
+            for(Index channel = 0; channel < channels_number; channel++)
+            {
+                const type* channel_image = image + channel*pixels_number;
+
+                type* channel_images = images + i + images_number*channel*pixels_number;
+
+                for(Index j = 0; j < pixels_number; j++)
+                {
+                    const Index source_index = source_indices[j];
+
+                    channel_images[images_number*j] = source_index == -1 ? type(0) : channel_image[source_index];
+                }
+            }
+        }
+    });
+}
+
+
+/// Returns a random number uniformly distributed between a minimum and a maximum,
+/// or the minimum if it is not lower than the maximum.
+
+type ImageAugmentation::calculate_random_uniform(mt19937& random_engine, const type& minimum, const type& maximum) const
+{
+    if(minimum >= maximum) return minimum;
+
+    uniform_real_distribution<type> distribution(minimum, maximum);
+
+    return distribution(random_engine);
+}
+
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -0,0 +1,165 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   I M A G E   A U G M E N T A T I O N   C L A S S   H E A D E R
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#ifndef IMAGEAUGMENTATION_H
+#define IMAGEAUGMENTATION_H
+
+// System includes
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <sstream>
+#include <stdexcept>
+
+// OpenNN includes
+
+#include "config.h"
+#include "execution_context.h"
+
+namespace opennn
+{
+
+/// This class applies random reflections, rotations and translations to the images of a batch.
+
+/// The three transformations of an image are fused into a single affine map around its centre,
+/// which is inverted into the source pixel of each output pixel and resampled with the nearest pixel.
+/// The pixels which fall outside the source image are set to zero.
+/// The images are augmented in place and in parallel, with a scratch image per task, so that no memory is allocated.
+/// The random transformation of each image is drawn from a generator seeded with the batch seed and the sample index,
+/// so that augmented trainings can be reproduced whatever the number of threads.
+
+class ImageAugmentation
+{
+
+public:
+
+    // Constructors
+
+    explicit ImageAugmentation();
+
+    explicit ImageAugmentation(const Index&, const Index&, const Index&);
+
+    // Destructor
+
+    virtual ~ImageAugmentation();
+
+    // Get methods
+
+    const Index& get_rows_number() const;
+
+    const Index& get_columns_number() const;
+
+    const Index& get_channels_number() const;
+
+    bool is_identity() const;
+
+    // Set methods
+
+    void set();
+
+    void set(const Index&, const Index&, const Index&);
+
+    void set_random_reflection_axis_x(const bool&);
+
+    void set_random_reflection_axis_y(const bool&);
+
+    void set_random_rotation_minimum(const type&);
+
+    void set_random_rotation_maximum(const type&);
+
+    void set_random_horizontal_translation_minimum(const type&);
+
+    void set_random_horizontal_translation_maximum(const type&);
+
+    void set_random_vertical_translation_minimum(const type&);
+
+    void set_random_vertical_translation_maximum(const type&);
+
+    // Augmentation methods
+
+    static unsigned calculate_sample_seed(const unsigned&, const Index&);
+
+    void calculate_source_indices(mt19937&, Index*) const;
+
+    void augment(type*, const Index&, const Tensor<Index, 1>&, const unsigned&);
+
+private:
+
+    type calculate_random_uniform(mt19937&, const type&, const type&) const;
+
+    /// Number of rows of the images.
+
+    Index rows_number = 0;
+
+    /// Number of columns of the images.
+
+    Index columns_number = 0;
+
+    /// Number of channels of the images.
+
+    Index channels_number = 0;
+
+    /// True if the columns of the images are randomly reflected.
+
+    bool random_reflection_axis_x = false;
+
+    /// True if the rows of the images are randomly reflected.
+
+    bool random_reflection_axis_y = false;
+
+    /// Range of the random rotation, in degrees.
+
+    type random_rotation_minimum = type(0);
+
+    type random_rotation_maximum = type(0);
+
+    /// Range of the random translation along the columns, in pixels.
+
+    type random_horizontal_translation_minimum = type(0);
+
+    type random_horizontal_translation_maximum = type(0);
+
+    /// Range of the random translation along the rows, in pixels.
+
+    type random_vertical_translation_minimum = type(0);
+
+    type random_vertical_translation_maximum = type(0);
+
+    /// Copy of the image being augmented by each task.
+
+    Tensor<type, 2> images_scratch;
+
+    /// Source pixel of each output pixel of the image being augmented by each task.
+
+    Tensor<Index, 2> source_indices_scratch;
+};
+
+}
+
+#endif
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -13,8 +13,6 @@ namespace opennn
 
 Layer::~Layer()
 {
-    delete thread_pool;
-    delete thread_pool_device;
 }
 
 
@@ -70,19 +68,21 @@ string Layer::get_type_string() const
     case Type::NonMaxSuppression:
         return "NonMaxSuppression";
 
+    case Type::Addition:
+        return "Addition";
+
     default:
         return "Unkown type";
     }
 }
 
 
+/// Sets the number of threads of the thread pool shared by all the objects.
+/// @param new_threads_number Number of threads.
+
 void Layer::set_threads_number(const int& new_threads_number)
 {
-    if(thread_pool != nullptr) delete thread_pool;
-    if(thread_pool_device != nullptr) delete thread_pool_device;
-
-    thread_pool = new ThreadPool(new_threads_number);
-    thread_pool_device = new ThreadPoolDevice(thread_pool, new_threads_number);
+    ExecutionContext::set_threads_number(new_threads_number);
 }
 
 
@@ -1351,17 +1351,13 @@ void Layer::scaled_exponential_linear_derivatives(type* combinations_data, const
 
         f_2 = lambda*combinations;
 
-        // Activations
-
-        activations.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
-
-        // Activations Derivatives
+        // Activations derivatives
 
-        f_1 = lambda*alpha*combinations.exp();
+        activations_derivatives.device(*thread_pool_device) = if_sentence.select(lambda*alpha*combinations.exp(), combinations.constant(type(1))*lambda);
 
-        f_2 = combinations.constant(type(1))*lambda;
+        // Activations
 
-        activations_derivatives.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
+        activations.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
     }
     else if(rank == 2)
     {
@@ -1379,17 +1375,13 @@ void Layer::scaled_exponential_linear_derivatives(type* combinations_data, const
 
         f_2 = lambda*combinations;
 
-        // Activations
-
-        activations.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
-
-        // Activations Derivatives
+        // Activations derivatives
 
-        f_1 = lambda*alpha*combinations.exp();
+        activations_derivatives.device(*thread_pool_device) = if_sentence.select(lambda*alpha*combinations.exp(), combinations.constant(type(1))*lambda);
 
-        f_2 = combinations.constant(type(1))*lambda;
+        // Activations
 
-        activations_derivatives.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
+        activations.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
     }
     else if(rank == 4)
     {
@@ -1407,17 +1399,13 @@ void Layer::scaled_exponential_linear_derivatives(type* combinations_data, const
 
         f_2 = lambda*combinations;
 
-        // Activations
-
-        activations.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
-
-        // Activations Derivatives
+        // Activations derivatives
 
-        f_1 = lambda*alpha*combinations.exp();
+        activations_derivatives.device(*thread_pool_device) = if_sentence.select(lambda*alpha*combinations.exp(), combinations.constant(type(1))*lambda);
 
-        f_2 = combinations.constant(type(1))*lambda;
+        // Activations
 
-        activations_derivatives.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
+        activations.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
     }
     else
     {
@@ -1522,8 +1510,8 @@ void Layer::soft_plus_derivatives(type* combinations_data,
         TensorMap<Tensor<type, 1>> activations(activations_data, activations_dimensions(0));
         TensorMap<Tensor<type, 1>> activations_derivatives(activations_derivatives_data, activations_derivatives_dimensions(0));
 
-        activations.device(*thread_pool_device) = (combinations.constant(type(1)) + combinations.exp()).log();
         activations_derivatives.device(*thread_pool_device) = static_cast<type>(1.0) / (static_cast<type>(1.0) + combinations.exp().inverse());
+        activations.device(*thread_pool_device) = (combinations.constant(type(1)) + combinations.exp()).log();
     }
     else if(rank == 2)
     {
@@ -1531,12 +1519,12 @@ void Layer::soft_plus_derivatives(type* combinations_data,
         TensorMap<Tensor<type, 2>> activations(activations_data, activations_dimensions(0), activations_dimensions(1));
         TensorMap<Tensor<type, 2>> activations_derivatives(activations_derivatives_data, activations_derivatives_dimensions(0), activations_derivatives_dimensions(1));
 
-        activations.device(*thread_pool_device)
-                = (combinations.constant(type(1)) + combinations.exp()).log();
-
         activations_derivatives.device(*thread_pool_device)
                 = static_cast<type>(1.0) / (static_cast<type>(1.0) + combinations.exp().inverse());
 
+        activations.device(*thread_pool_device)
+                = (combinations.constant(type(1)) + combinations.exp()).log();
+
     }
     else if(rank == 4)
     {
@@ -1544,8 +1532,8 @@ void Layer::soft_plus_derivatives(type* combinations_data,
         TensorMap<Tensor<type, 4>> activations(activations_data, activations_dimensions(0), activations_dimensions(1), activations_dimensions(2), activations_dimensions(3));
         TensorMap<Tensor<type, 4>> activations_derivatives(activations_derivatives_data, activations_derivatives_dimensions(0), activations_derivatives_dimensions(1), activations_derivatives_dimensions(2), activations_derivatives_dimensions(3));
 
-        activations.device(*thread_pool_device) = (combinations.constant(type(1)) + combinations.exp()).log();
         activations_derivatives.device(*thread_pool_device) = static_cast<type>(1.0) / (static_cast<type>(1.0) + combinations.exp().inverse());
+        activations.device(*thread_pool_device) = (combinations.constant(type(1)) + combinations.exp()).log();
     }
     else
     {
@@ -1687,17 +1675,13 @@ void Layer::soft_sign_derivatives(type* combinations_data, const Tensor<Index, 1
 
         f_2 = combinations / (static_cast<type>(1) + combinations);
 
-        // Activations
-
-        activations.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
-
-        // Activations Derivatives
+        // Activations derivatives
 
-        f_1 = static_cast<type>(1.0) / (static_cast<type>(1.0) - combinations).pow(type(2));
+        activations_derivatives.device(*thread_pool_device) = if_sentence.select(static_cast<type>(1.0) / (static_cast<type>(1.0) - combinations).pow(type(2)), static_cast<type>(1.0) / (static_cast<type>(1.0) + combinations).pow(type(2)));
 
-        f_2 = static_cast<type>(1.0) / (static_cast<type>(1.0) + combinations).pow(type(2));
+        // Activations
 
-        activations_derivatives.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
+        activations.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
     }
     else if(rank == 2)
     {
@@ -1715,17 +1699,13 @@ void Layer::soft_sign_derivatives(type* combinations_data, const Tensor<Index, 1
 
         f_2 = combinations / (static_cast<type>(1) + combinations);
 
-        // Activations
-
-        activations.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
-
-        // Activations Derivatives
+        // Activations derivatives
 
-        f_1 = static_cast<type>(1.0) / (static_cast<type>(1.0) - combinations).pow(type(2));
+        activations_derivatives.device(*thread_pool_device) = if_sentence.select(static_cast<type>(1.0) / (static_cast<type>(1.0) - combinations).pow(type(2)), static_cast<type>(1.0) / (static_cast<type>(1.0) + combinations).pow(type(2)));
 
-        f_2 = static_cast<type>(1.0) / (static_cast<type>(1.0) + combinations).pow(type(2));
+        // Activations
 
-        activations_derivatives.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
+        activations.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
     }
     else if(rank == 4)
     {
@@ -1743,17 +1723,13 @@ void Layer::soft_sign_derivatives(type* combinations_data, const Tensor<Index, 1
 
         f_2 = combinations / (static_cast<type>(1) + combinations);
 
-        // Activations
-
-        activations.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
-
-        // Activations Derivatives
+        // Activations derivatives
 
-        f_1 = static_cast<type>(1.0) / (static_cast<type>(1.0) - combinations).pow(type(2));
+        activations_derivatives.device(*thread_pool_device) = if_sentence.select(static_cast<type>(1.0) / (static_cast<type>(1.0) - combinations).pow(type(2)), static_cast<type>(1.0) / (static_cast<type>(1.0) + combinations).pow(type(2)));
 
-        f_2 = static_cast<type>(1.0) / (static_cast<type>(1.0) + combinations).pow(type(2));
+        // Activations
 
-        activations_derivatives.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
+        activations.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
     }
     else
     {
@@ -1897,17 +1873,13 @@ void Layer::exponential_linear_derivatives(type* combinations_data, const Tensor
         Tensor<type, 1> f_2(combinations.dimension(0));
         f_2 = combinations;
 
-        // Activations
-
-        activations.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
-
-        // Activations Derivatives
+        // Activations derivatives
 
-        f_1 = alpha * combinations.exp();
+        activations_derivatives.device(*thread_pool_device) = if_sentence.select(alpha * combinations.exp(), combinations.constant(type(1)));
 
-        f_2 = combinations.constant(type(1));
+        // Activations
 
-        activations_derivatives.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
+        activations.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
     }
     else if(rank == 2)
     {
@@ -1925,17 +1897,13 @@ void Layer::exponential_linear_derivatives(type* combinations_data, const Tensor
 
         f_2 = combinations;
 
-        // Activations
-
-        activations.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
-
-        // Activations Derivatives
+        // Activations derivatives
 
-        f_1 = alpha * combinations.exp();
+        activations_derivatives.device(*thread_pool_device) = if_sentence.select(alpha * combinations.exp(), combinations.constant(type(1)));
 
-        f_2 = combinations.constant(type(1));
+        // Activations
 
-        activations_derivatives.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
+        activations.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
     }
     else if(rank == 4)
     {
@@ -1953,17 +1921,13 @@ void Layer::exponential_linear_derivatives(type* combinations_data, const Tensor
 
         f_2 = combinations;
 
-        // Activations
-
-        activations.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
-
-        // Activations Derivatives
+        // Activations derivatives
 
-        f_1 = alpha * combinations.exp();
+        activations_derivatives.device(*thread_pool_device) = if_sentence.select(alpha * combinations.exp(), combinations.constant(type(1)));
 
-        f_2 = combinations.constant(type(1));
+        // Activations
 
-        activations_derivatives.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
+        activations.device(*thread_pool_device) = if_sentence.select(f_1, f_2);
     }
     else
     {
@@ -24,10 +24,12 @@
 // OpenNN includes
 
 #include "config.h"
+#include "execution_context.h"
 #include "tensor_utilities.h"
 #include "dynamic_tensor.h"
 #include "statistics.h"
 #include "scaling.h"
+#include "storage_precision.h"
 //#include "data_set.h"
 
 #include <tuple>
@@ -72,16 +74,14 @@ public:
                     RegionProposal,
                     NonMaxSuppression,
                     MultiheadAttention,
-                    Embedding};
+                    Embedding,
+                    Addition};
 
     // Constructor
 
     explicit Layer()   
     {
-        const int n = omp_get_max_threads();
-
-        thread_pool = new ThreadPool(n);
-        thread_pool_device = new ThreadPoolDevice(thread_pool, n);
+        thread_pool_device = ExecutionContext::get_thread_pool_device();
     }
 
     // Destructor
@@ -132,6 +132,19 @@ public:
 
     virtual void set_parameters(const Tensor<type, 1>&, const Index&);
 
+    /// Returns a pointer to the parameters of the layer if they are stored contiguously, or nullptr otherwise.
+
+    virtual type* get_parameters_data() const {return nullptr;}
+
+    /// Moves the parameters of the layer to a block of memory owned by someone else, such as the neural network.
+
+    virtual void set_parameters_data(type*) {}
+
+    /// Stores a copy of the parameters in a reduced precision, which is used for the inference until it is released.
+    /// The layers which do not support reduced precisions keep calculating with their parameters in single precision.
+
+    virtual void freeze_parameters(const StoragePrecision&) {}
+
     void set_threads_number(const int&);
 
     virtual void insert_gradient(LayerBackPropagation*, const Index&, Tensor<type, 1>&) const {}
@@ -154,6 +167,11 @@ public:
                                            LayerBackPropagationLM*,
                                            LayerBackPropagationLM*) const {}
 
+    /// Calculates the derivatives of the error with respect to the inputs of the layer, once its deltas are complete.
+    /// Only the layers whose inputs derivatives are shared by several layers which feed them need it.
+
+    virtual void calculate_inputs_derivatives(LayerForwardPropagation*, LayerBackPropagation*) const {}
+
     // Jacobian
 
     virtual void calculate_inputs_outputs_derivatives(LayerForwardPropagation*) const {}
@@ -201,7 +219,8 @@ public:
 
 protected:
 
-    ThreadPool* thread_pool = nullptr;
+    /// Thread pool device shared by all the objects, owned by the execution context.
+
     ThreadPoolDevice* thread_pool_device = nullptr;
 
     /// Layer name.
@@ -276,6 +295,10 @@ struct LayerForwardPropagation
 
     virtual void print() const {}
 
+    /// Frees the quantities which only back-propagation needs, when the layer is just deployed.
+
+    virtual void free_training_memory() {}
+
     Index batch_samples_number;
 
     Layer* layer_pointer = nullptr;
@@ -299,6 +322,15 @@ struct LayerBackPropagation
 
     virtual void print() const {}   
 
+    /// Makes the derivatives of the layer views of a block of memory owned by someone else, such as the loss index gradient.
+
+    virtual void set_gradient_data(type*) {}
+
+    /// Tells the layer that its block of the gradient has been written outside it, for instance by the regularization.
+    /// Layers which keep only part of their derivatives up to date must then rewrite all of them.
+
+    virtual void set_gradient_modified() {}
+
     virtual Tensor< TensorMap< Tensor<type, 1> >*, 1> get_layer_gradient()
     {
         ostringstream buffer;
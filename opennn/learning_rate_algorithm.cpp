@@ -37,8 +37,6 @@ LearningRateAlgorithm::LearningRateAlgorithm(LossIndex* new_loss_index_pointer)
 
 LearningRateAlgorithm::~LearningRateAlgorithm()
 {
-    delete thread_pool;
-    delete thread_pool_device;
 }
 
 
@@ -114,6 +112,14 @@ const type& LearningRateAlgorithm::get_learning_rate_tolerance() const
 }
 
 
+/// Returns the number of learning rates evaluated concurrently in each round of the line search.
+
+const Index& LearningRateAlgorithm::get_candidates_number() const
+{
+    return candidates_number;
+}
+
+
 /// Returns true if messages from this class can be displayed on the screen, or false if messages from
 /// this class can't be displayed on the screen.
 
@@ -150,12 +156,7 @@ void LearningRateAlgorithm::set(LossIndex* new_loss_index_pointer)
 
 void LearningRateAlgorithm::set_default()
 {
-    delete thread_pool;
-    delete thread_pool_device;
-
-    const int n = omp_get_max_threads();
-    thread_pool = new ThreadPool(n);
-    thread_pool_device = new ThreadPoolDevice(thread_pool, n);
+    thread_pool_device = ExecutionContext::get_thread_pool_device();
 
     // TRAINING OPERATORS
 
@@ -165,6 +166,8 @@ void LearningRateAlgorithm::set_default()
 
     learning_rate_tolerance = numeric_limits<type>::epsilon();
     loss_tolerance = numeric_limits<type>::epsilon();
+
+    candidates_number = 1;
 }
 
 
@@ -177,13 +180,12 @@ void LearningRateAlgorithm::set_loss_index_pointer(LossIndex* new_loss_index_poi
 }
 
 
+/// Sets the number of threads of the thread pool shared by all the objects.
+/// @param new_threads_number Number of threads.
+
 void LearningRateAlgorithm::set_threads_number(const int& new_threads_number)
 {
-    if(thread_pool != nullptr) delete thread_pool;
-    if(thread_pool_device != nullptr) delete thread_pool_device;
-
-    thread_pool = new ThreadPool(new_threads_number);
-    thread_pool_device = new ThreadPoolDevice(thread_pool, new_threads_number);
+    ExecutionContext::set_threads_number(new_threads_number);
 }
 
 
@@ -249,6 +251,27 @@ void LearningRateAlgorithm::set_learning_rate_tolerance(const type& new_learning
 }
 
 
+/// Sets the number of learning rates evaluated concurrently in each round of the line search.
+/// Each candidate holds a copy of the neural network and the forward propagation of a batch.
+/// @param new_candidates_number Number of candidates, 1 for the line search which evaluates the learning rates one by one.
+
+void LearningRateAlgorithm::set_candidates_number(const Index& new_candidates_number)
+{
+    if(new_candidates_number < 1)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: LearningRateAlgorithm class.\n"
+               << "void set_candidates_number(const Index&) method.\n"
+               << "Number of candidates must be greater than 0.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    candidates_number = new_candidates_number;
+}
+
+
 /// Sets a new display value.
 /// If it is set to true messages from this class are displayed on the screen;
 /// if it is set to false messages from this class are not displayed on the screen.
@@ -309,6 +332,11 @@ pair<type,type> LearningRateAlgorithm::calculate_directional_point(
 
 #endif
 
+    if(candidates_number > 1)
+    {
+        return calculate_concurrent_directional_point(batch, back_propagation, optimization_data);
+    }
+
     ostringstream buffer;
 
     // Bracket minimum
@@ -685,6 +713,280 @@ type LearningRateAlgorithm::calculate_Brent_method_learning_rate(const Triplet&
 }
 
 
+/// Allocates a forward propagation of the neural network and a back-propagation with only the errors for each candidate,
+/// unless they have already been allocated for the same batch size.
+/// The candidates share the neural network, and each of them forward propagates its own parameters.
+/// @param batch Batch of samples of the line search.
+/// @param optimization_data Optimization data which holds the candidates.
+
+void LearningRateAlgorithm::set_candidates(const DataSetBatch& batch, OptimizationAlgorithmData& optimization_data) const
+{
+    const Index batch_samples_number = batch.get_batch_samples_number();
+
+    if(optimization_data.candidates_forward_propagations.size() == candidates_number
+    && optimization_data.candidates_forward_propagations(0)->batch_samples_number == batch_samples_number)
+    {
+        return;
+    }
+
+    optimization_data.delete_candidates();
+
+    NeuralNetwork* neural_network_pointer = loss_index_pointer->get_neural_network_pointer();
+
+    const Index parameters_number = neural_network_pointer->get_parameters_number();
+
+    optimization_data.candidates_forward_propagations.resize(candidates_number);
+    optimization_data.candidates_back_propagations.resize(candidates_number);
+    optimization_data.candidates_parameters.resize(candidates_number);
+
+    for(Index i = 0; i < candidates_number; i++)
+    {
+        optimization_data.candidates_forward_propagations(i)
+                = new NeuralNetworkForwardPropagation(batch_samples_number, neural_network_pointer);
+
+        optimization_data.candidates_back_propagations(i) = new LossIndexBackPropagation;
+
+        optimization_data.candidates_back_propagations(i)->set_errors(batch_samples_number, loss_index_pointer);
+
+        optimization_data.candidates_parameters(i).resize(parameters_number);
+    }
+}
+
+
+/// Calculates the loss of the batch for several learning rates along the training direction.
+/// Each learning rate is evaluated by a candidate, which forward propagates its parameters on the shared neural network.
+/// If the layers of the neural network can be forward propagated with given parameters, the candidates run concurrently,
+/// while the parameters and the training direction are only read. Otherwise, they run one after the other.
+/// The losses which are not a number are set to the maximum value, so that they are never chosen.
+/// @param batch Batch of samples of the line search.
+/// @param back_propagation Back-propagation with the current parameters.
+/// @param optimization_data Optimization data with the training direction and the candidates.
+/// @param learning_rates Learning rates to evaluate, at most as many as candidates.
+/// @param losses Losses for the learning rates.
+
+void LearningRateAlgorithm::calculate_candidates_losses(const DataSetBatch& batch,
+                                                        const LossIndexBackPropagation& back_propagation,
+                                                        OptimizationAlgorithmData& optimization_data,
+                                                        const Tensor<type, 1>& learning_rates,
+                                                        Tensor<type, 1>& losses) const
+{
+    set_candidates(batch, optimization_data);
+
+    const NeuralNetwork* neural_network_pointer = loss_index_pointer->get_neural_network_pointer();
+
+    const type regularization_weight = loss_index_pointer->get_regularization_weight();
+
+    const auto calculate_candidate_loss = [&](const Index& i)
+    {
+        Tensor<type, 1>& candidate_parameters = optimization_data.candidates_parameters(i);
+
+        candidate_parameters.device(*thread_pool_device)
+                = back_propagation.parameters + optimization_data.training_direction*learning_rates(i);
+
+        NeuralNetworkForwardPropagation& candidate_forward_propagation = *optimization_data.candidates_forward_propagations(i);
+        LossIndexBackPropagation& candidate_back_propagation = *optimization_data.candidates_back_propagations(i);
+
+        neural_network_pointer->forward_propagate(batch, candidate_parameters, candidate_forward_propagation);
+
+        loss_index_pointer->calculate_errors(batch, candidate_forward_propagation, candidate_back_propagation);
+        loss_index_pointer->calculate_error(batch, candidate_forward_propagation, candidate_back_propagation);
+
+        const type regularization = loss_index_pointer->calculate_regularization(candidate_parameters);
+
+        losses(i) = candidate_back_propagation.error + regularization_weight*regularization;
+
+        if(!isfinite(losses(i))) losses(i) = numeric_limits<type>::max();
+    };
+
+    if(neural_network_pointer->has_parameters_forward_propagation())
+    {
+        ExecutionContext::run_concurrently(learning_rates.size(), calculate_candidate_loss);
+    }
+    else
+    {
+        for(Index i = 0; i < learning_rates.size(); i++) calculate_candidate_loss(i);
+    }
+}
+
+
+/// Returns a bracketing triplet, evaluating several learning rates concurrently in each round.
+/// The first round evaluates geometrically growing learning rates from the initial learning rate.
+/// While the loss keeps decreasing at the largest learning rate, the next round evaluates larger ones,
+/// and while no learning rate improves the current loss, the next round evaluates smaller ones.
+/// @param batch Batch of samples of the line search.
+/// @param back_propagation Back-propagation with the current parameters and loss.
+/// @param optimization_data Optimization data with the training direction, the initial learning rate and the candidates.
+
+LearningRateAlgorithm::Triplet LearningRateAlgorithm::calculate_concurrent_bracketing_triplet(
+    const DataSetBatch& batch,
+    const LossIndexBackPropagation& back_propagation,
+    OptimizationAlgorithmData& optimization_data) const
+{
+    Triplet triplet;
+
+    const auto loss_less = [](const pair<type, type>& point_1, const pair<type, type>& point_2)
+    {
+        return point_1.second < point_2.second;
+    };
+
+    vector<pair<type, type>> points(1, make_pair(type(0), back_propagation.loss));
+
+    Tensor<type, 1> learning_rates(candidates_number);
+    Tensor<type, 1> losses(candidates_number);
+
+    while(true)
+    {
+        const size_t minimal_index = static_cast<size_t>(min_element(points.begin(), points.end(), loss_less) - points.begin());
+
+        if(minimal_index > 0 && minimal_index < points.size() - 1)
+        {
+            triplet.A = points[minimal_index - 1];
+            triplet.U = points[minimal_index];
+            triplet.B = points[minimal_index + 1];
+
+            return triplet;
+        }
+
+        if(points.size() == 1)
+        {
+            for(Index i = 0; i < candidates_number; i++)
+            {
+                learning_rates(i) = optimization_data.initial_learning_rate*pow(golden_ratio, type(i));
+            }
+        }
+        else if(minimal_index == points.size() - 1)
+        {
+            const type right_learning_rate = points.back().first;
+
+            for(Index i = 0; i < candidates_number; i++)
+            {
+                learning_rates(i) = right_learning_rate*pow(golden_ratio, type(i + 1));
+            }
+        }
+        else
+        {
+            const type left_learning_rate = points[1].first;
+
+            if(left_learning_rate*type(0.382) <= learning_rate_tolerance) break;
+
+            for(Index i = 0; i < candidates_number; i++)
+            {
+                learning_rates(i) = left_learning_rate*pow(type(0.382), type(i + 1));
+            }
+        }
+
+        if(!isfinite(learning_rates(candidates_number - 1))) break;
+
+        calculate_candidates_losses(batch, back_propagation, optimization_data, learning_rates, losses);
+
+        for(Index i = 0; i < candidates_number; i++)
+        {
+            points.push_back(make_pair(learning_rates(i), losses(i)));
+        }
+
+        sort(points.begin(), points.end());
+    }
+
+    // No interior minimum, so the triplet is the minimal point and it does not pass the check
+
+    triplet.A = *min_element(points.begin(), points.end(), loss_less);
+    triplet.U = triplet.A;
+    triplet.B = triplet.A;
+
+    return triplet;
+}
+
+
+/// Returns the learning rate and the loss of a directional minimum,
+/// evaluating several learning rates concurrently in each round instead of one at a time.
+/// Each round evaluates learning rates evenly spaced within the bracketing triplet,
+/// replacing one of them by the minimum of the parabola through the triplet for the Brent method,
+/// and narrows the triplet to the minimal point and its neighbours.
+/// @param batch Batch of samples of the line search.
+/// @param back_propagation Back-propagation with the current parameters and loss.
+/// @param optimization_data Optimization data with the training direction, the initial learning rate and the candidates.
+
+pair<type, type> LearningRateAlgorithm::calculate_concurrent_directional_point(
+    const DataSetBatch& batch,
+    const LossIndexBackPropagation& back_propagation,
+    OptimizationAlgorithmData& optimization_data) const
+{
+    Triplet triplet = calculate_concurrent_bracketing_triplet(batch, back_propagation, optimization_data);
+
+    try
+    {
+        triplet.check();
+    }
+    catch(const invalid_argument&)
+    {
+        return triplet.minimum();
+    }
+
+    const auto loss_less = [](const pair<type, type>& point_1, const pair<type, type>& point_2)
+    {
+        return point_1.second < point_2.second;
+    };
+
+    Tensor<type, 1> learning_rates(candidates_number);
+    Tensor<type, 1> losses(candidates_number);
+
+    vector<pair<type, type>> points;
+
+    while(abs(triplet.A.first - triplet.B.first) > learning_rate_tolerance
+       || abs(triplet.A.second - triplet.B.second) > loss_tolerance)
+    {
+        const type length = triplet.get_length();
+
+        for(Index i = 0; i < candidates_number; i++)
+        {
+            learning_rates(i) = triplet.A.first + length*type(i + 1)/type(candidates_number + 1);
+        }
+
+        if(learning_rate_method == LearningRateMethod::BrentMethod)
+        {
+            const type Brent_method_learning_rate = calculate_Brent_method_learning_rate(triplet);
+
+            if(Brent_method_learning_rate > triplet.A.first && Brent_method_learning_rate < triplet.B.first)
+            {
+                learning_rates(candidates_number/2) = Brent_method_learning_rate;
+            }
+        }
+
+        calculate_candidates_losses(batch, back_propagation, optimization_data, learning_rates, losses);
+
+        points.assign({triplet.A, triplet.U, triplet.B});
+
+        for(Index i = 0; i < candidates_number; i++)
+        {
+            points.push_back(make_pair(learning_rates(i), losses(i)));
+        }
+
+        sort(points.begin(), points.end());
+
+        const size_t minimal_index = static_cast<size_t>(min_element(points.begin(), points.end(), loss_less) - points.begin());
+
+        if(minimal_index == 0 || minimal_index == points.size() - 1) return points[minimal_index];
+
+        triplet.A = points[minimal_index - 1];
+        triplet.U = points[minimal_index];
+        triplet.B = points[minimal_index + 1];
+
+        if(triplet.get_length() >= length) return triplet.U;
+
+        try
+        {
+            triplet.check();
+        }
+        catch(const invalid_argument&)
+        {
+            return triplet.minimum();
+        }
+    }
+
+    return triplet.U;
+}
+
+
 /// Serializes the learning rate algorithm object into an XML document of the TinyXML library
 /// without keeping the DOM tree in memory.
 /// See the OpenNN manual for more information about the format of this document.
@@ -716,6 +1018,17 @@ void LearningRateAlgorithm::write_XML(tinyxml2::XMLPrinter& file_stream) const
 
     file_stream.CloseElement();
 
+    // Candidates number
+
+    file_stream.OpenElement("CandidatesNumber");
+
+    buffer.str("");
+    buffer << candidates_number;
+
+    file_stream.PushText(buffer.str().c_str());
+
+    file_stream.CloseElement();
+
     // Learning rate algorithm (end tag)
 
     file_stream.CloseElement();
@@ -779,6 +1092,25 @@ void LearningRateAlgorithm::from_XML(const tinyxml2::XMLDocument& document)
         }
     }
 
+    // Candidates number
+    {
+        const tinyxml2::XMLElement* element = root_element->FirstChildElement("CandidatesNumber");
+
+        if(element)
+        {
+            const Index new_candidates_number = static_cast<Index>(atoi(element->GetText()));
+
+            try
+            {
+                set_candidates_number(new_candidates_number);
+            }
+            catch(const invalid_argument& e)
+            {
+                cerr << e.what() << endl;
+            }
+        }
+    }
+
     // Display warnings
     {
         const tinyxml2::XMLElement* element = root_element->FirstChildElement("Display");
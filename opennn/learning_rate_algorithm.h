@@ -36,6 +36,7 @@ namespace opennn
 /// This class is used by many different optimization algorithms to calculate the learning rate given a training direction.
 ///
 /// It implements the golden section method and the Brent's method.
+/// With more than one candidate, it evaluates several learning rates concurrently in each round of the line search.
 
 class LearningRateAlgorithm
 {
@@ -213,6 +214,8 @@ public:
 
    const type& get_learning_rate_tolerance() const;
 
+   const Index& get_candidates_number() const;
+
    // Utilities
    
    const bool& get_display() const;
@@ -234,6 +237,8 @@ public:
 
    void set_learning_rate_tolerance(const type&);
 
+   void set_candidates_number(const Index&);
+
    // Utilities
 
    void set_display(const bool&);
@@ -255,6 +260,24 @@ public:
                                                 LossIndexBackPropagation&,
                                                 OptimizationAlgorithmData&) const;
 
+   // Concurrent learning rate methods
+
+   void set_candidates(const DataSetBatch&, OptimizationAlgorithmData&) const;
+
+   void calculate_candidates_losses(const DataSetBatch&,
+                                    const LossIndexBackPropagation&,
+                                    OptimizationAlgorithmData&,
+                                    const Tensor<type, 1>&,
+                                    Tensor<type, 1>&) const;
+
+   Triplet calculate_concurrent_bracketing_triplet(const DataSetBatch&,
+                                                   const LossIndexBackPropagation&,
+                                                   OptimizationAlgorithmData&) const;
+
+   pair<type, type> calculate_concurrent_directional_point(const DataSetBatch&,
+                                                           const LossIndexBackPropagation&,
+                                                           OptimizationAlgorithmData&) const;
+
    // Serialization methods
       
    void from_XML(const tinyxml2::XMLDocument&);   
@@ -281,6 +304,11 @@ protected:
 
    type loss_tolerance;
 
+   /// Number of learning rates evaluated concurrently in each round of the line search.
+   /// With a single candidate, the learning rates are evaluated one after the other.
+
+   Index candidates_number;
+
    // UTILITIES
 
    /// Display messages to screen.
@@ -289,7 +317,8 @@ protected:
 
    const type golden_ratio = static_cast<type>(1.618);
 
-   ThreadPool* thread_pool = nullptr;
+   /// Thread pool device shared by all the objects, owned by the execution context.
+
    ThreadPoolDevice* thread_pool_device = nullptr;
 };
 
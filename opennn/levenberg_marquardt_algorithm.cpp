@@ -107,6 +107,46 @@ const type& LevenbergMarquardtAlgorithm::get_maximum_damping_parameter() const
 }
 
 
+/// Returns the number of samples of the blocks over which the squared errors Jacobian is accumulated.
+
+const Index& LevenbergMarquardtAlgorithm::get_block_samples_number() const
+{
+    return block_samples_number;
+}
+
+
+/// Returns the method for solving the damped system of the Hessian approximation.
+
+const LevenbergMarquardtAlgorithm::DampedSystemSolver& LevenbergMarquardtAlgorithm::get_damped_system_solver() const
+{
+    return damped_system_solver;
+}
+
+
+/// Returns the name of the method for solving the damped system of the Hessian approximation.
+
+string LevenbergMarquardtAlgorithm::write_damped_system_solver() const
+{
+    switch(damped_system_solver)
+    {
+    case DampedSystemSolver::Cholesky:
+        return "Cholesky";
+
+    case DampedSystemSolver::EigenDecomposition:
+        return "EigenDecomposition";
+
+    default:
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: LevenbergMarquardtAlgorithm class.\n"
+               << "string write_damped_system_solver() const method.\n"
+               << "Unknown damped system solver.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+}
+
+
 /// Sets the following default values for the Levenberg-Marquardt algorithm:
 /// Training parameters:
 /// <ul>
@@ -146,6 +186,10 @@ void LevenbergMarquardtAlgorithm::set_default()
 
     minimum_damping_parameter = static_cast<type>(1.0e-6);
     maximum_damping_parameter = static_cast<type>(1.0e6);
+
+    block_samples_number = 1000;
+
+    damped_system_solver = DampedSystemSolver::Cholesky;
 }
 
 
@@ -241,6 +285,68 @@ void LevenbergMarquardtAlgorithm::set_maximum_damping_parameter(const type& new_
 }
 
 
+/// Sets the number of samples of the blocks over which the squared errors Jacobian is accumulated.
+/// The memory of the Jacobian is proportional to that number times the number of parameters,
+/// instead of the number of training samples times the number of parameters.
+/// @param new_block_samples_number Number of samples of each block, greater than zero.
+
+void LevenbergMarquardtAlgorithm::set_block_samples_number(const Index& new_block_samples_number)
+{
+    if(new_block_samples_number < 1)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: LevenbergMarquardtAlgorithm class.\n"
+               << "void set_block_samples_number(const Index&) method.\n"
+               << "Number of samples of the blocks must be greater than 0.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    block_samples_number = new_block_samples_number;
+}
+
+
+/// Sets a new method for solving the damped system of the Hessian approximation.
+/// @param new_damped_system_solver Damped system solver.
+
+void LevenbergMarquardtAlgorithm::set_damped_system_solver(const DampedSystemSolver& new_damped_system_solver)
+{
+    damped_system_solver = new_damped_system_solver;
+}
+
+
+/// Sets a new method for solving the damped system of the Hessian approximation from its name.
+/// Possible values are:
+/// <ul>
+/// <li> "Cholesky"
+/// <li> "EigenDecomposition"
+/// </ul>
+/// @param new_damped_system_solver_name Name of the damped system solver.
+
+void LevenbergMarquardtAlgorithm::set_damped_system_solver(const string& new_damped_system_solver_name)
+{
+    if(new_damped_system_solver_name == "Cholesky")
+    {
+        damped_system_solver = DampedSystemSolver::Cholesky;
+    }
+    else if(new_damped_system_solver_name == "EigenDecomposition")
+    {
+        damped_system_solver = DampedSystemSolver::EigenDecomposition;
+    }
+    else
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: LevenbergMarquardtAlgorithm class.\n"
+               << "void set_damped_system_solver(const string&) method.\n"
+               << "Unknown damped system solver: " << new_damped_system_solver_name << ".\n";
+
+        throw invalid_argument(buffer.str());
+    }
+}
+
+
 /// Sets a new minimum loss improvement during training.
 /// @param new_minimum_loss_decrease Minimum improvement in the loss between two iterations.
 
@@ -415,6 +521,8 @@ TrainingResults LevenbergMarquardtAlgorithm::perform_training()
     neural_network_pointer->set_inputs_names(inputs_names);
     neural_network_pointer->set_outputs_names(targets_names);
 
+    neural_network_pointer->set_inputs_categories_numbers(data_set_pointer->get_input_categories_numbers());
+
     if(neural_network_pointer->has_scaling_layer())
     {
         input_variables_descriptives = data_set_pointer->scale_input_variables();
@@ -431,13 +539,12 @@ TrainingResults LevenbergMarquardtAlgorithm::perform_training()
         unscaling_layer_pointer->set(target_variables_descriptives, target_variables_scalers);
     }
 
-    DataSetBatch training_batch(training_samples_number, data_set_pointer);
-    training_batch.fill(training_samples_indices, input_variables_indices, target_variables_indices);
+    DataSetBatch training_batch;
 
     DataSetBatch selection_batch(selection_samples_number, data_set_pointer);
     selection_batch.fill(selection_samples_indices, input_variables_indices, target_variables_indices);
 
-    NeuralNetworkForwardPropagation training_forward_propagation(training_samples_number, neural_network_pointer);
+    NeuralNetworkForwardPropagation training_forward_propagation;
     NeuralNetworkForwardPropagation selection_forward_propagation(selection_samples_number, neural_network_pointer);
 
     // Loss index
@@ -449,8 +556,31 @@ TrainingResults LevenbergMarquardtAlgorithm::perform_training()
 
     Index selection_failures = 0;
 
-    LossIndexBackPropagationLM training_back_propagation_lm(training_samples_number, loss_index_pointer);
-    LossIndexBackPropagationLM selection_back_propagation_lm(selection_samples_number, loss_index_pointer);
+    LevenbergMarquardtAlgorithmData optimization_data(this);
+
+    // The squared errors Jacobian is accumulated over blocks of the training samples if there are more than one,
+    // and then the training samples are only propagated block by block.
+    // The selection samples only need the errors.
+
+    LossIndexBackPropagationLM training_back_propagation_lm;
+
+    if(optimization_data.has_blocks())
+    {
+        training_back_propagation_lm.set_accumulated(training_samples_number, loss_index_pointer);
+    }
+    else
+    {
+        training_batch.set(training_samples_number, data_set_pointer);
+        training_batch.fill(training_samples_indices, input_variables_indices, target_variables_indices);
+
+        training_forward_propagation.set(training_samples_number, neural_network_pointer);
+
+        training_back_propagation_lm.set(training_samples_number, loss_index_pointer);
+    }
+
+    LossIndexBackPropagationLM selection_back_propagation_lm;
+
+    selection_back_propagation_lm.set_accumulated(selection_samples_number, loss_index_pointer);
 
     // Training strategy stuff
 
@@ -462,8 +592,6 @@ TrainingResults LevenbergMarquardtAlgorithm::perform_training()
     time(&beginning_time);
     type elapsed_time = type(0);
 
-    LevenbergMarquardtAlgorithmData optimization_data(this);
-
     // Main loop
 
     for(Index epoch = 0; epoch <= maximum_epochs_number; epoch++)
@@ -472,17 +600,22 @@ TrainingResults LevenbergMarquardtAlgorithm::perform_training()
 
         optimization_data.epoch = epoch;
 
-        // Neural network
+        // Neural network and loss index
 
-        neural_network_pointer->forward_propagate(training_batch,
-                                                  training_forward_propagation,
-                                                  is_training);
-
-        // Loss index
+        if(optimization_data.has_blocks())
+        {
+            back_propagate_blocks(training_back_propagation_lm, optimization_data);
+        }
+        else
+        {
+            neural_network_pointer->forward_propagate(training_batch,
+                                                      training_forward_propagation,
+                                                      is_training);
 
-        loss_index_pointer->back_propagate_lm(training_batch,
-                                              training_forward_propagation,
-                                              training_back_propagation_lm);
+            loss_index_pointer->back_propagate_lm(training_batch,
+                                                  training_forward_propagation,
+                                                  training_back_propagation_lm);
+        }
 
         results.training_error_history(epoch) = training_back_propagation_lm.error;
 
@@ -636,6 +769,175 @@ TrainingResults LevenbergMarquardtAlgorithm::perform_training()
 }
 
 
+/// Fills the block of the optimization data with the training samples from a given one on.
+/// The last block ends at the last training sample, so it may start before the given sample.
+/// Returns the number of first samples of the block which were already in the previous block.
+/// @param beginning Position of the first sample of the block in the training samples.
+/// @param optimization_data Levenberg-Marquardt data, which holds the block.
+
+Index LevenbergMarquardtAlgorithm::fill_block(const Index& beginning, LevenbergMarquardtAlgorithmData& optimization_data) const
+{
+    const Index training_samples_number = optimization_data.training_samples_indices.size();
+    const Index block_samples_number = optimization_data.block_samples_indices.size();
+
+    const Index block_beginning = min(beginning, training_samples_number - block_samples_number);
+
+    copy(optimization_data.training_samples_indices.data() + block_beginning,
+         optimization_data.training_samples_indices.data() + block_beginning + block_samples_number,
+         optimization_data.block_samples_indices.data());
+
+    optimization_data.block.fill(optimization_data.block_samples_indices,
+                                 optimization_data.input_variables_indices,
+                                 optimization_data.target_variables_indices);
+
+    return beginning - block_beginning;
+}
+
+
+/// Calculates the error, the loss, the gradient and the Hessian approximation of the training samples,
+/// accumulating the squared errors Jacobian over blocks of samples instead of forming it for all of them.
+/// The blocks are forward propagated one after another, and the products of each block Jacobian
+/// are calculated in parallel on the thread pool.
+/// The training samples are never forward propagated together, and the error is summed over the blocks.
+/// @param back_propagation_lm Back-propagation of the training samples, set with set_accumulated().
+/// @param optimization_data Levenberg-Marquardt data, which holds the block.
+
+void LevenbergMarquardtAlgorithm::back_propagate_blocks(LossIndexBackPropagationLM& back_propagation_lm,
+                                                        LevenbergMarquardtAlgorithmData& optimization_data) const
+{
+    NeuralNetwork* neural_network_pointer = loss_index_pointer->get_neural_network_pointer();
+
+    back_propagation_lm.error = type(0);
+    back_propagation_lm.gradient.setZero();
+    back_propagation_lm.hessian.setZero();
+
+    const Index training_samples_number = optimization_data.training_samples_indices.size();
+    const Index block_samples_number = optimization_data.block_samples_indices.size();
+
+    bool is_training = true;
+
+    for(Index beginning = 0; beginning < training_samples_number; beginning += block_samples_number)
+    {
+        const Index skipped_samples_number = fill_block(beginning, optimization_data);
+
+        neural_network_pointer->forward_propagate(optimization_data.block,
+                                                  optimization_data.block_forward_propagation,
+                                                  is_training);
+
+        loss_index_pointer->accumulate_squared_errors_jacobian_lm(optimization_data.block,
+                                                                  optimization_data.block_forward_propagation,
+                                                                  optimization_data.block_back_propagation_lm,
+                                                                  skipped_samples_number,
+                                                                  back_propagation_lm);
+    }
+
+    loss_index_pointer->calculate_accumulated_error_gradient_hessian_lm(back_propagation_lm);
+}
+
+
+/// Returns the error of the training samples for given parameters, calculated block by block.
+/// It is used to evaluate the steps of the algorithm without forward propagating all the training samples together.
+/// The parameters of the neural network are restored afterwards.
+/// @param parameters Parameters of the neural network.
+/// @param optimization_data Levenberg-Marquardt data, which holds the block.
+
+type LevenbergMarquardtAlgorithm::calculate_blocks_error(Tensor<type, 1>& parameters,
+                                                         LevenbergMarquardtAlgorithmData& optimization_data) const
+{
+    NeuralNetwork* neural_network_pointer = loss_index_pointer->get_neural_network_pointer();
+
+    Tensor<type, 1> original_parameters = neural_network_pointer->get_parameters();
+
+    neural_network_pointer->set_parameters(parameters);
+
+    LossIndexBackPropagationLM& block_back_propagation_lm = optimization_data.block_back_propagation_lm;
+
+    const Index training_samples_number = optimization_data.training_samples_indices.size();
+    const Index block_samples_number = optimization_data.block_samples_indices.size();
+
+    bool is_training = true;
+
+    type sum_squared_error = type(0);
+
+    Tensor<type, 0> block_sum_squared_error;
+
+    for(Index beginning = 0; beginning < training_samples_number; beginning += block_samples_number)
+    {
+        const Index skipped_samples_number = fill_block(beginning, optimization_data);
+
+        neural_network_pointer->forward_propagate(optimization_data.block, optimization_data.block_forward_propagation, is_training);
+
+        loss_index_pointer->calculate_errors_lm(optimization_data.block, optimization_data.block_forward_propagation, block_back_propagation_lm);
+
+        loss_index_pointer->calculate_squared_errors_lm(optimization_data.block, optimization_data.block_forward_propagation, block_back_propagation_lm);
+
+        block_sum_squared_error.device(*thread_pool_device)
+                = block_back_propagation_lm.squared_errors.slice(Eigen::array<Index, 1>({skipped_samples_number}),
+                                                                 Eigen::array<Index, 1>({block_samples_number - skipped_samples_number}))
+                                                          .square().sum();
+
+        sum_squared_error += block_sum_squared_error(0);
+    }
+
+    neural_network_pointer->set_parameters(original_parameters);
+
+    return loss_index_pointer->get_squared_errors_coefficient_lm(training_samples_number)*sum_squared_error;
+}
+
+
+/// Solves the system of the Hessian approximation plus the damping parameter times the identity
+/// for the parameters increment, with the damped system solver.
+/// The eigendecomposition must have been calculated for the current Hessian approximation.
+/// Returns false if the damped system is not positive definite, and true otherwise.
+/// @param back_propagation_lm Back-propagation with the gradient and the Hessian approximation.
+/// @param optimization_data Levenberg-Marquardt data, where the parameters increment is written.
+
+bool LevenbergMarquardtAlgorithm::solve_damped_system(const LossIndexBackPropagationLM& back_propagation_lm,
+                                                      LevenbergMarquardtAlgorithmData& optimization_data) const
+{
+    const Index parameters_number = back_propagation_lm.gradient.size();
+
+    const Map<const Matrix<type, Dynamic, Dynamic>> hessian(back_propagation_lm.hessian.data(), parameters_number, parameters_number);
+    const Map<const Matrix<type, Dynamic, 1>> gradient(back_propagation_lm.gradient.data(), parameters_number);
+
+    Map<Matrix<type, Dynamic, 1>> parameters_increment(optimization_data.parameters_increment.data(), parameters_number);
+
+    switch(damped_system_solver)
+    {
+    case DampedSystemSolver::Cholesky:
+    {
+        optimization_data.cholesky_factorization.compute(
+                    hessian + damping_parameter*Matrix<type, Dynamic, Dynamic>::Identity(parameters_number, parameters_number));
+
+        if(optimization_data.cholesky_factorization.info() != Eigen::Success) return false;
+
+        parameters_increment = -optimization_data.cholesky_factorization.solve(gradient);
+
+        return true;
+    }
+
+    case DampedSystemSolver::EigenDecomposition:
+    {
+        if(optimization_data.eigen_decomposition.info() != Eigen::Success) return false;
+
+        const Matrix<type, Dynamic, 1>& eigenvalues = optimization_data.eigen_decomposition.eigenvalues();
+
+        if(eigenvalues.minCoeff() + damping_parameter <= type(0)) return false;
+
+        const Map<const Matrix<type, Dynamic, 1>> eigen_gradient(optimization_data.eigen_gradient.data(), parameters_number);
+
+        parameters_increment.noalias() = -optimization_data.eigen_decomposition.eigenvectors()
+                *(eigen_gradient.array()/(eigenvalues.array() + damping_parameter)).matrix();
+
+        return true;
+    }
+
+    default:
+        return false;
+    }
+}
+
+
 /// \brief LevenbergMarquardtAlgorithm::update_parameters
 /// \param batch
 /// \param forward_propagation
@@ -654,23 +956,48 @@ void LevenbergMarquardtAlgorithm::update_parameters(const DataSetBatch& batch,
 
     bool success = false;
 
+    if(damped_system_solver == DampedSystemSolver::EigenDecomposition)
+    {
+        const Index parameters_number = back_propagation_lm.gradient.size();
+
+        const Map<const Matrix<type, Dynamic, Dynamic>> hessian(back_propagation_lm.hessian.data(), parameters_number, parameters_number);
+        const Map<const Matrix<type, Dynamic, 1>> gradient(back_propagation_lm.gradient.data(), parameters_number);
+
+        optimization_data.eigen_decomposition.compute(hessian);
+
+        optimization_data.eigen_gradient.resize(parameters_number);
+
+        Map<Matrix<type, Dynamic, 1>> eigen_gradient(optimization_data.eigen_gradient.data(), parameters_number);
+
+        eigen_gradient.noalias() = optimization_data.eigen_decomposition.eigenvectors().transpose()*gradient;
+    }
+
     do
     {
-        sum_diagonal(back_propagation_lm.hessian, damping_parameter);
+        if(!solve_damped_system(back_propagation_lm, optimization_data))
+        {
+            set_damping_parameter(damping_parameter*damping_parameter_factor);
 
-        optimization_data.parameters_increment
-                = perform_Householder_QR_decomposition(back_propagation_lm.hessian,(type(-1))*back_propagation_lm.gradient);
+            continue;
+        }
 
         optimization_data.potential_parameters.device(*thread_pool_device)
                 = back_propagation_lm.parameters + optimization_data.parameters_increment;
 
-        neural_network_pointer->forward_propagate(batch, optimization_data.potential_parameters, forward_propagation);
+        if(optimization_data.has_blocks())
+        {
+            back_propagation_lm.error = calculate_blocks_error(optimization_data.potential_parameters, optimization_data);
+        }
+        else
+        {
+            neural_network_pointer->forward_propagate(batch, optimization_data.potential_parameters, forward_propagation);
 
-        loss_index_pointer->calculate_errors_lm(batch, forward_propagation, back_propagation_lm);
+            loss_index_pointer->calculate_errors_lm(batch, forward_propagation, back_propagation_lm);
 
-        loss_index_pointer->calculate_squared_errors_lm(batch, forward_propagation, back_propagation_lm);
+            loss_index_pointer->calculate_squared_errors_lm(batch, forward_propagation, back_propagation_lm);
 
-        loss_index_pointer->calculate_error_lm(batch, forward_propagation, back_propagation_lm);
+            loss_index_pointer->calculate_error_lm(batch, forward_propagation, back_propagation_lm);
+        }
 
         type new_loss;
 
@@ -696,8 +1023,6 @@ void LevenbergMarquardtAlgorithm::update_parameters(const DataSetBatch& batch,
         }
         else
         {
-            sum_diagonal(back_propagation_lm.hessian, -damping_parameter);
-
             set_damping_parameter(damping_parameter*damping_parameter_factor);
         }
     }while(damping_parameter < maximum_damping_parameter);
@@ -806,6 +1131,25 @@ void LevenbergMarquardtAlgorithm::write_XML(tinyxml2::XMLPrinter& file_stream) c
 
     file_stream.CloseElement();
 
+    // Block samples number
+
+    file_stream.OpenElement("BlockSamplesNumber");
+
+    buffer.str("");
+    buffer << block_samples_number;
+
+    file_stream.PushText(buffer.str().c_str());
+
+    file_stream.CloseElement();
+
+    // Damped system solver
+
+    file_stream.OpenElement("DampedSystemSolver");
+
+    file_stream.PushText(write_damped_system_solver().c_str());
+
+    file_stream.CloseElement();
+
     // Minimum loss decrease
 
     file_stream.OpenElement("MinimumLossDecrease");
@@ -914,6 +1258,42 @@ void LevenbergMarquardtAlgorithm::from_XML(const tinyxml2::XMLDocument& document
         }
     }
 
+    // Block samples number
+
+    const tinyxml2::XMLElement* block_samples_number_element = root_element->FirstChildElement("BlockSamplesNumber");
+
+    if(block_samples_number_element)
+    {
+        const Index new_block_samples_number = static_cast<Index>(atoi(block_samples_number_element->GetText()));
+
+        try
+        {
+            set_block_samples_number(new_block_samples_number);
+        }
+        catch(const invalid_argument& e)
+        {
+            cerr << e.what() << endl;
+        }
+    }
+
+    // Damped system solver
+
+    const tinyxml2::XMLElement* damped_system_solver_element = root_element->FirstChildElement("DampedSystemSolver");
+
+    if(damped_system_solver_element)
+    {
+        const string new_damped_system_solver = damped_system_solver_element->GetText();
+
+        try
+        {
+            set_damped_system_solver(new_damped_system_solver);
+        }
+        catch(const invalid_argument& e)
+        {
+            cerr << e.what() << endl;
+        }
+    }
+
     // Minimum loss decrease
 
     const tinyxml2::XMLElement* minimum_loss_decrease_element = root_element->FirstChildElement("MinimumLossDecrease");
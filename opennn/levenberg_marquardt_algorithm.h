@@ -49,6 +49,14 @@ class LevenbergMarquardtAlgorithm : public OptimizationAlgorithm
 
 public:
 
+   // Enumerations
+
+   /// Enumeration of the methods for solving the damped system of the Hessian approximation.
+   /// The Cholesky factorization is calculated for each damping parameter tried,
+   /// while the eigendecomposition is calculated once per epoch and reused for all of them.
+
+   enum class DampedSystemSolver{Cholesky, EigenDecomposition};
+
    // Constructors
 
    explicit LevenbergMarquardtAlgorithm();
@@ -76,6 +84,11 @@ public:
    const type& get_minimum_damping_parameter() const;
    const type& get_maximum_damping_parameter() const;
 
+   const Index& get_block_samples_number() const;
+
+   const DampedSystemSolver& get_damped_system_solver() const;
+   string write_damped_system_solver() const;
+
    // Set methods
 
    void set_default() override;
@@ -87,6 +100,11 @@ public:
    void set_minimum_damping_parameter(const type&);
    void set_maximum_damping_parameter(const type&);
 
+   void set_block_samples_number(const Index&);
+
+   void set_damped_system_solver(const DampedSystemSolver&);
+   void set_damped_system_solver(const string&);
+
    // Stopping criteria
 
    void set_minimum_loss_decrease(const type&);
@@ -103,6 +121,14 @@ public:
 
    TrainingResults perform_training() final;
 
+   Index fill_block(const Index&, LevenbergMarquardtAlgorithmData&) const;
+
+   void back_propagate_blocks(LossIndexBackPropagationLM&, LevenbergMarquardtAlgorithmData&) const;
+
+   type calculate_blocks_error(Tensor<type, 1>&, LevenbergMarquardtAlgorithmData&) const;
+
+   bool solve_damped_system(const LossIndexBackPropagationLM&, LevenbergMarquardtAlgorithmData&) const;
+
    void update_parameters(
            const DataSetBatch&,
            NeuralNetworkForwardPropagation&,
@@ -139,6 +165,14 @@ private:
 
    type damping_parameter_factor;
 
+   /// Number of samples of the blocks over which the squared errors Jacobian is accumulated.
+
+   Index block_samples_number;
+
+   /// Method for solving the damped system.
+
+   DampedSystemSolver damped_system_solver;
+
    // Stopping criteria 
 
    /// Minimum loss improvement between two successive iterations. It is a stopping criterion.
@@ -183,7 +217,7 @@ struct LevenbergMarquardtAlgorithmData : public OptimizationAlgorithmData
     {
         Levenberg_Marquardt_algorithm = new_Levenberg_Marquardt_method_pointer;
 
-        const LossIndex* loss_index_pointer = Levenberg_Marquardt_algorithm->get_loss_index_pointer();
+        LossIndex* loss_index_pointer = Levenberg_Marquardt_algorithm->get_loss_index_pointer();
 
         const NeuralNetwork* neural_network_pointer = loss_index_pointer->get_neural_network_pointer();
 
@@ -197,6 +231,41 @@ struct LevenbergMarquardtAlgorithmData : public OptimizationAlgorithmData
 
         potential_parameters.resize(parameters_number);
         parameters_increment.resize(parameters_number);
+
+        // Blocks data
+
+        DataSet* data_set_pointer = loss_index_pointer->get_data_set_pointer();
+
+        training_samples_indices = data_set_pointer->get_training_samples_indices();
+        input_variables_indices = data_set_pointer->get_input_variables_indices();
+        target_variables_indices = data_set_pointer->get_target_variables_indices();
+
+        const Index training_samples_number = training_samples_indices.size();
+
+        const Index block_samples_number
+                = min(Levenberg_Marquardt_algorithm->get_block_samples_number(), training_samples_number);
+
+        if(block_samples_number < training_samples_number)
+        {
+            block_samples_indices.resize(block_samples_number);
+
+            block.set(block_samples_number, data_set_pointer);
+
+            block_forward_propagation.set(block_samples_number, loss_index_pointer->get_neural_network_pointer());
+
+            block_back_propagation_lm.set_block(block_samples_number, loss_index_pointer);
+        }
+        else
+        {
+            block_samples_indices.resize(0);
+        }
+    }
+
+    /// Returns true if the squared errors Jacobian of the training samples is accumulated over blocks, and false otherwise.
+
+    bool has_blocks() const
+    {
+        return block_samples_indices.size() > 0;
     }
 
     LevenbergMarquardtAlgorithm* Levenberg_Marquardt_algorithm = nullptr;
@@ -210,6 +279,30 @@ struct LevenbergMarquardtAlgorithmData : public OptimizationAlgorithmData
 
     Tensor<type, 1> parameters_increment;
 
+    // Blocks data
+
+    Tensor<Index, 1> training_samples_indices;
+    Tensor<Index, 1> input_variables_indices;
+    Tensor<Index, 1> target_variables_indices;
+
+    Tensor<Index, 1> block_samples_indices;
+
+    DataSetBatch block;
+
+    NeuralNetworkForwardPropagation block_forward_propagation;
+
+    LossIndexBackPropagationLM block_back_propagation_lm;
+
+    // Damped system data
+
+    Eigen::LLT<Matrix<type, Dynamic, Dynamic>> cholesky_factorization;
+
+    Eigen::SelfAdjointEigenSolver<Matrix<type, Dynamic, Dynamic>> eigen_decomposition;
+
+    /// Gradient in the basis of the eigenvectors of the Hessian approximation.
+
+    Tensor<type, 1> eigen_gradient;
+
     // Loss index data
 
     type old_loss = type(0);
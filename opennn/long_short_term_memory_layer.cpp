@@ -422,20 +422,31 @@ void LongShortTermMemoryLayer::set()
 
 void LongShortTermMemoryLayer::set(const Index& new_inputs_number, const Index& new_neurons_number)
 {
-    input_biases.resize(new_neurons_number);
-    forget_biases.resize(new_neurons_number);
-    state_biases.resize(new_neurons_number);
-    output_biases.resize(new_neurons_number);
+    const Index weights_number = new_inputs_number*new_neurons_number;
+    const Index recurrent_weights_number = new_neurons_number*new_neurons_number;
 
-    input_weights.resize(new_inputs_number, new_neurons_number);
-    forget_weights.resize(new_inputs_number, new_neurons_number);
-    state_weights.resize(new_inputs_number, new_neurons_number);
-    output_weights.resize(new_inputs_number, new_neurons_number);
+    gates_parameters.resize(4*(new_neurons_number + weights_number + recurrent_weights_number));
 
-    input_recurrent_weights.resize(new_neurons_number, new_neurons_number);
-    forget_recurrent_weights.resize(new_neurons_number, new_neurons_number);
-    state_recurrent_weights.resize(new_neurons_number, new_neurons_number);
-    output_recurrent_weights.resize(new_neurons_number, new_neurons_number);
+    type* biases_data = gates_parameters.data();
+
+    new (&forget_biases) TensorMap<Tensor<type, 1>>(biases_data, new_neurons_number);
+    new (&input_biases) TensorMap<Tensor<type, 1>>(biases_data + new_neurons_number, new_neurons_number);
+    new (&state_biases) TensorMap<Tensor<type, 1>>(biases_data + 2*new_neurons_number, new_neurons_number);
+    new (&output_biases) TensorMap<Tensor<type, 1>>(biases_data + 3*new_neurons_number, new_neurons_number);
+
+    type* weights_data = biases_data + 4*new_neurons_number;
+
+    new (&forget_weights) TensorMap<Tensor<type, 2>>(weights_data, new_inputs_number, new_neurons_number);
+    new (&input_weights) TensorMap<Tensor<type, 2>>(weights_data + weights_number, new_inputs_number, new_neurons_number);
+    new (&state_weights) TensorMap<Tensor<type, 2>>(weights_data + 2*weights_number, new_inputs_number, new_neurons_number);
+    new (&output_weights) TensorMap<Tensor<type, 2>>(weights_data + 3*weights_number, new_inputs_number, new_neurons_number);
+
+    type* recurrent_weights_data = weights_data + 4*weights_number;
+
+    new (&forget_recurrent_weights) TensorMap<Tensor<type, 2>>(recurrent_weights_data, new_neurons_number, new_neurons_number);
+    new (&input_recurrent_weights) TensorMap<Tensor<type, 2>>(recurrent_weights_data + recurrent_weights_number, new_neurons_number, new_neurons_number);
+    new (&state_recurrent_weights) TensorMap<Tensor<type, 2>>(recurrent_weights_data + 2*recurrent_weights_number, new_neurons_number, new_neurons_number);
+    new (&output_recurrent_weights) TensorMap<Tensor<type, 2>>(recurrent_weights_data + 3*recurrent_weights_number, new_neurons_number, new_neurons_number);
 
     hidden_states.resize(new_neurons_number); // memory
     hidden_states.setZero();
@@ -523,6 +534,8 @@ void LongShortTermMemoryLayer::set_neurons_number(const Index& new_neurons_numbe
 
 void LongShortTermMemoryLayer::set_forget_biases(const Tensor<type, 1>& new_biases)
 {
+    check_gate_dimensions(new_biases.size(), 1, forget_biases.size(), 1);
+
     forget_biases = new_biases;
 }
 
@@ -532,6 +545,8 @@ void LongShortTermMemoryLayer::set_forget_biases(const Tensor<type, 1>& new_bias
 
 void LongShortTermMemoryLayer::set_input_biases(const Tensor<type, 1>& new_biases)
 {
+    check_gate_dimensions(new_biases.size(), 1, input_biases.size(), 1);
+
     input_biases = new_biases;
 }
 
@@ -541,6 +556,8 @@ void LongShortTermMemoryLayer::set_input_biases(const Tensor<type, 1>& new_biase
 
 void LongShortTermMemoryLayer::set_state_biases(const Tensor<type, 1>& new_biases)
 {
+    check_gate_dimensions(new_biases.size(), 1, state_biases.size(), 1);
+
     state_biases = new_biases;
 }
 
@@ -550,6 +567,8 @@ void LongShortTermMemoryLayer::set_state_biases(const Tensor<type, 1>& new_biase
 
 void LongShortTermMemoryLayer::set_output_biases(const Tensor<type, 1>& new_biases)
 {
+    check_gate_dimensions(new_biases.size(), 1, output_biases.size(), 1);
+
     output_biases = new_biases;
 }
 
@@ -562,6 +581,8 @@ void LongShortTermMemoryLayer::set_output_biases(const Tensor<type, 1>& new_bias
 
 void LongShortTermMemoryLayer::set_forget_weights(const Tensor<type, 2>& new_forget_weights)
 {
+    check_gate_dimensions(new_forget_weights.dimension(0), new_forget_weights.dimension(1), forget_weights.dimension(0), forget_weights.dimension(1));
+
     forget_weights = new_forget_weights;
 }
 
@@ -574,6 +595,8 @@ void LongShortTermMemoryLayer::set_forget_weights(const Tensor<type, 2>& new_for
 
 void LongShortTermMemoryLayer::set_input_weights(const Tensor<type, 2>& new_input_weight)
 {
+    check_gate_dimensions(new_input_weight.dimension(0), new_input_weight.dimension(1), input_weights.dimension(0), input_weights.dimension(1));
+
     input_weights = new_input_weight;
 }
 
@@ -586,6 +609,8 @@ void LongShortTermMemoryLayer::set_input_weights(const Tensor<type, 2>& new_inpu
 
 void LongShortTermMemoryLayer::set_state_weights(const Tensor<type, 2>& new_state_weights)
 {
+    check_gate_dimensions(new_state_weights.dimension(0), new_state_weights.dimension(1), state_weights.dimension(0), state_weights.dimension(1));
+
     state_weights = new_state_weights;
 }
 
@@ -598,8 +623,9 @@ void LongShortTermMemoryLayer::set_state_weights(const Tensor<type, 2>& new_stat
 
 void LongShortTermMemoryLayer::set_output_weights(const Tensor<type, 2>& new_output_weight)
 {
-    output_weights = new_output_weight;
+    check_gate_dimensions(new_output_weight.dimension(0), new_output_weight.dimension(1), output_weights.dimension(0), output_weights.dimension(1));
 
+    output_weights = new_output_weight;
 }
 
 
@@ -611,6 +637,8 @@ void LongShortTermMemoryLayer::set_output_weights(const Tensor<type, 2>& new_out
 
 void LongShortTermMemoryLayer::set_forget_recurrent_weights(const Tensor<type, 2>& new_forget_recurrent_weight)
 {
+    check_gate_dimensions(new_forget_recurrent_weight.dimension(0), new_forget_recurrent_weight.dimension(1), forget_recurrent_weights.dimension(0), forget_recurrent_weights.dimension(1));
+
     forget_recurrent_weights = new_forget_recurrent_weight;
 }
 
@@ -624,6 +652,8 @@ void LongShortTermMemoryLayer::set_forget_recurrent_weights(const Tensor<type, 2
 
 void LongShortTermMemoryLayer::set_input_recurrent_weights(const Tensor<type, 2>& new_input_recurrent_weight)
 {
+    check_gate_dimensions(new_input_recurrent_weight.dimension(0), new_input_recurrent_weight.dimension(1), input_recurrent_weights.dimension(0), input_recurrent_weights.dimension(1));
+
     input_recurrent_weights = new_input_recurrent_weight;
 }
 
@@ -636,6 +666,8 @@ void LongShortTermMemoryLayer::set_input_recurrent_weights(const Tensor<type, 2>
 
 void LongShortTermMemoryLayer::set_state_recurrent_weights(const Tensor<type, 2>& new_state_recurrent_weight)
 {
+    check_gate_dimensions(new_state_recurrent_weight.dimension(0), new_state_recurrent_weight.dimension(1), state_recurrent_weights.dimension(0), state_recurrent_weights.dimension(1));
+
     state_recurrent_weights = new_state_recurrent_weight;
 }
 
@@ -648,10 +680,36 @@ void LongShortTermMemoryLayer::set_state_recurrent_weights(const Tensor<type, 2>
 
 void LongShortTermMemoryLayer::set_output_recurrent_weights(const Tensor<type, 2>& new_output_recurrent_weight)
 {
+    check_gate_dimensions(new_output_recurrent_weight.dimension(0), new_output_recurrent_weight.dimension(1), output_recurrent_weights.dimension(0), output_recurrent_weights.dimension(1));
+
     output_recurrent_weights = new_output_recurrent_weight;
 }
 
 
+/// Checks that new parameters of a gate have the dimensions of that gate.
+/// The parameters of all the gates are packed side by side, so a single gate cannot be resized.
+/// @param new_rows_number Number of rows of the new parameters.
+/// @param new_columns_number Number of columns of the new parameters.
+/// @param rows_number Number of rows of the parameters of the gate.
+/// @param columns_number Number of columns of the parameters of the gate.
+
+void LongShortTermMemoryLayer::check_gate_dimensions(const Index& new_rows_number, const Index& new_columns_number,
+                                                     const Index& rows_number, const Index& columns_number) const
+{
+    if(new_rows_number != rows_number || new_columns_number != columns_number)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: LongShortTermMemoryLayer class.\n"
+               << "void check_gate_dimensions(const Index&, const Index&, const Index&, const Index&) const method.\n"
+               << "Dimensions of new parameters (" << new_rows_number << ", " << new_columns_number << ") "
+               << "must be equal to those of the gate (" << rows_number << ", " << columns_number << ").\n";
+
+        throw invalid_argument(buffer.str());
+    }
+}
+
+
 /// Sets the parameters of this layer.
 /// @param new_parameters Parameters vector for that layer.
 
@@ -1530,7 +1588,7 @@ void LongShortTermMemoryLayer::calculate_hidden_delta(PerceptronLayerForwardProp
                                                       PerceptronLayerBackPropagation* next_back_propagation,
                                                       LongShortTermMemoryLayerBackPropagation* back_propagation) const
 {
-    const Tensor<type, 2>& next_synaptic_weights = static_cast<PerceptronLayer*>(next_back_propagation->layer_pointer)->get_synaptic_weights();
+    const TensorMap<Tensor<type, 2>>& next_synaptic_weights = static_cast<PerceptronLayer*>(next_back_propagation->layer_pointer)->get_synaptic_weights();
 
     const TensorMap<Tensor<type,2>> next_layer_deltas(next_back_propagation->deltas_data,
                                                       next_back_propagation->deltas_dimensions(0),
@@ -1551,7 +1609,7 @@ void LongShortTermMemoryLayer::calculate_hidden_delta(ProbabilisticLayerForwardP
 {
     const ProbabilisticLayer* probabilistic_layer_pointer = static_cast<ProbabilisticLayer*>(next_back_propagation->layer_pointer);
 
-    const Tensor<type, 2>& next_synaptic_weights = probabilistic_layer_pointer->get_synaptic_weights();
+    const TensorMap<Tensor<type, 2>>& next_synaptic_weights = probabilistic_layer_pointer->get_synaptic_weights();
 
     const TensorMap<Tensor<type, 2>> next_deltas(next_back_propagation->deltas_data, next_back_propagation->deltas_dimensions(0), next_back_propagation->deltas_dimensions(1));;
     TensorMap<Tensor<type, 2>> deltas(back_propagation->deltas_data, back_propagation->deltas_dimensions(0), back_propagation->deltas_dimensions(1));
@@ -1627,483 +1685,244 @@ void LongShortTermMemoryLayer::forward_propagate(const Tensor<DynamicTensor<type
                                                  LayerForwardPropagation* forward_propagation,
                                                  const bool& is_training)
 {
-    LongShortTermMemoryLayerForwardPropagation* long_short_term_memory_layer_forward_propagation
-            = static_cast<LongShortTermMemoryLayerForwardPropagation*>(forward_propagation);
-
-    Tensor<Index, 1> inputs_dimensions = inputs(0).get_dimensions();
-
-    const Index samples_number = inputs_dimensions(0);
-    const Index neurons_number = get_neurons_number();
-
-    if(inputs_dimensions.size() != 2)
+    if(inputs(0).get_dimensions().size() != 2)
     {
         ostringstream buffer;
 
-        buffer << "OpenNN Exception: ProbabilisticLayer class.\n"
-               << "void forward_propagate(type*, const Tensor<Index, 1>&, LayerForwardPropagation*) final.\n"
+        buffer << "OpenNN Exception: LongShortTermMemoryLayer class.\n"
+               << "void forward_propagate(const Tensor<DynamicTensor<type>, 1>&, LayerForwardPropagation*, const bool&) final.\n"
                << "Inputs rank must be equal to 2.\n";
 
         throw invalid_argument(buffer.str());
     }
 
-    TensorMap<Tensor<type, 2>> inputs_map = inputs(0).to_tensor_map<2>();
-
-    const Tensor<Index, 1> outputs_dimensions = forward_propagation->outputs[0].get_dimensions();
-
-    Tensor<Index, 1> current_inputs_dimensions = get_dimensions(Tensor<Index, 1>(samples_number));
-    Tensor<Index, 1> current_outputs_dimensions = get_dimensions(Tensor<Index, 1>(neurons_number));
-
-    const TensorMap<Tensor<type, 2>> outputs = forward_propagation->outputs(0).to_tensor_map<2>();
-
-    type* current_inputs_data = long_short_term_memory_layer_forward_propagation->current_inputs.data();
-    type* current_forget_combinations_data = long_short_term_memory_layer_forward_propagation->current_forget_combinations.data();
-    type* current_forget_activations_data =  long_short_term_memory_layer_forward_propagation->current_forget_activations.data();
-    type* current_forget_activations_derivatives_data =  long_short_term_memory_layer_forward_propagation->current_forget_activations_derivatives.data();
-    type* current_input_combinations_data = long_short_term_memory_layer_forward_propagation->current_input_combinations.data();
-    type* current_input_activations_data = long_short_term_memory_layer_forward_propagation->current_input_activations.data();
-    type* current_input_activations_derivatives_data = long_short_term_memory_layer_forward_propagation->current_input_activations_derivatives.data();
-    type* current_state_combinations_data = long_short_term_memory_layer_forward_propagation->current_state_combinations.data();
-    type* current_state_activations_data = long_short_term_memory_layer_forward_propagation->current_state_activations.data();
-    type* current_state_activations_derivatives_data = long_short_term_memory_layer_forward_propagation->current_state_activations_derivatives.data();
-    type* current_output_combinations_data = long_short_term_memory_layer_forward_propagation->current_output_combinations.data();
-    type* current_output_activations_data = long_short_term_memory_layer_forward_propagation->current_output_activations.data();
-    type* current_output_activations_derivatives_data = long_short_term_memory_layer_forward_propagation->current_output_activations_derivatives.data();
-    type* cell_states_data = cell_states.data();
-    type* hidden_states_data = hidden_states.data();
-    type* current_hidden_states_derivatives_data = long_short_term_memory_layer_forward_propagation->current_hidden_states_derivatives.data();
-    type* forget_activations_data = long_short_term_memory_layer_forward_propagation->forget_activations.data();
-    type* forget_activations_derivatives_data = long_short_term_memory_layer_forward_propagation->forget_activations_derivatives.data();
-    type* input_activations_data = long_short_term_memory_layer_forward_propagation->input_activations.data();
-    type* input_activations_derivatives_data = long_short_term_memory_layer_forward_propagation->input_activations_derivatives.data();
-    type* state_activations_data = long_short_term_memory_layer_forward_propagation->state_activations.data();
-    type* state_activations_derivatives_data = long_short_term_memory_layer_forward_propagation->state_activations_derivatives.data();
-    type* output_activations_data = long_short_term_memory_layer_forward_propagation->output_activations.data();
-    type* output_activations_derivatives_data = long_short_term_memory_layer_forward_propagation->output_activations_derivatives.data();
-    type* cell_states_activations_data = long_short_term_memory_layer_forward_propagation->cell_states_activations.data();
-    type* hidden_states_activations_data = long_short_term_memory_layer_forward_propagation->hidden_states_activations.data();
-    type* hidden_states_activations_derivatives_data = long_short_term_memory_layer_forward_propagation->hidden_states_activations_derivatives.data();
-
-    Index copy_index = 0;
-
-    for(Index i = 0; i < samples_number; i++)
-    {
-        if(i%timesteps == 0)
-        {
-            hidden_states.setZero();
-            cell_states.setZero();
-        }
-
-        long_short_term_memory_layer_forward_propagation->current_inputs = inputs_map.chip(i,0);
-
-        current_inputs_dimensions.setValues(
-                    {long_short_term_memory_layer_forward_propagation->current_inputs.size()});
-
-        // f_t = σ(W_f * x_t + U_f * h_(t-1) + b_f)
-
-        calculate_combinations(current_inputs_data,
-                               current_inputs_dimensions,
-                               forget_weights,
-                               forget_recurrent_weights,
-                               forget_biases,
-                               current_forget_combinations_data,
-                               current_outputs_dimensions);
-
-        if(is_training)
-        {
-            calculate_recurrent_activations_derivatives(current_forget_combinations_data,
-                                                        current_outputs_dimensions,
-                                                        current_forget_activations_data,
-                                                        current_outputs_dimensions,
-                                                        current_forget_activations_derivatives_data,
-                                                        current_outputs_dimensions);
-        }
-        else
-        {
-            calculate_recurrent_activations(current_forget_combinations_data,
-                                  current_outputs_dimensions,
-                                  current_forget_activations_data,
-                                  current_outputs_dimensions);
-        }
-
-        // i_t = σ(W_i * x_t + U_i * h_(t-1) + b_i)
-
-        calculate_combinations(current_inputs_data,
-                               current_inputs_dimensions,
-                               input_weights,
-                               input_recurrent_weights,
-                               input_biases,
-                               current_input_combinations_data,
-                               current_outputs_dimensions);
-
-        if(is_training)
-        {
-            calculate_recurrent_activations_derivatives(current_input_combinations_data,
-                                                        current_outputs_dimensions,
-                                                        current_input_activations_data,
-                                                        current_outputs_dimensions,
-                                                        current_input_activations_derivatives_data,
-                                                        current_outputs_dimensions);
-        }
-        else
-        {
-            calculate_recurrent_activations(current_input_combinations_data,
-                                  current_outputs_dimensions,
-                                  current_input_activations_data,
-                                  current_outputs_dimensions);
-        }
-
-        // C~_t = tanh(W_C * x_t + U_C * h_(t-1) + b_C)
-
-        calculate_combinations(current_inputs_data,
-                               current_inputs_dimensions,
-                               state_weights,
-                               state_recurrent_weights,
-                               state_biases,
-                               current_state_combinations_data,
-                               current_outputs_dimensions);
-
-        if(is_training)
-        {
-            calculate_activations_derivatives(current_state_combinations_data,
-                                                        current_outputs_dimensions,
-                                                        current_state_activations_data,
-                                                        current_outputs_dimensions,
-                                                        current_state_activations_derivatives_data,
-                                                        current_outputs_dimensions);
-        }
-        else
-        {
-            calculate_activations(current_state_combinations_data,
-                                  current_outputs_dimensions,
-                                  current_state_activations_data,
-                                  current_outputs_dimensions);
-        }
-
-        // o_t = σ(W_o * x_t + U_o * h_(t-1) + b_o)
-
-        calculate_combinations(current_inputs_data,
-                               current_inputs_dimensions,
-                               output_weights,
-                               output_recurrent_weights,
-                               output_biases,
-                               current_output_combinations_data,
-                               current_outputs_dimensions);
-
-        if(is_training)
-        {
-            calculate_recurrent_activations_derivatives(current_output_combinations_data,
-                                                        current_outputs_dimensions,
-                                                        current_output_activations_data,
-                                                        current_outputs_dimensions,
-                                                        current_output_activations_derivatives_data,
-                                                        current_outputs_dimensions);
-        }
-        else
-        {
-            calculate_recurrent_activations(current_output_combinations_data,
-                                  current_outputs_dimensions,
-                                  current_output_activations_data,
-                                  current_outputs_dimensions);
-        }
+    LongShortTermMemoryLayerForwardPropagation* long_short_term_memory_layer_forward_propagation
+            = static_cast<LongShortTermMemoryLayerForwardPropagation*>(forward_propagation);
 
-        // C_t = f_t * C_(t-1) + i_t * C~_t
+    set_gates_parameters(long_short_term_memory_layer_forward_propagation, gates_parameters.data());
 
-        cell_states = long_short_term_memory_layer_forward_propagation->current_forget_activations * cell_states +
-                long_short_term_memory_layer_forward_propagation->current_input_activations * long_short_term_memory_layer_forward_propagation->current_state_activations;
+    const TensorMap<Tensor<type, 2>> inputs_map = inputs(0).to_tensor_map<2>();
 
-        if(is_training)
-        {
+    calculate_sequences_outputs(inputs_map, long_short_term_memory_layer_forward_propagation, is_training);
+}
 
-            calculate_activations_derivatives(cell_states_data,
-                                              current_outputs_dimensions,
-                                              hidden_states_data,
-                                              current_outputs_dimensions,
-                                              current_hidden_states_derivatives_data,
-                                              current_outputs_dimensions);
-        }
-        else
-        {
-            calculate_activations(cell_states_data,
-                                  current_outputs_dimensions,
-                                  hidden_states_data,
-                                  current_outputs_dimensions);
-        }
 
-        // h_t = o_t * tanh(C_t)
+void LongShortTermMemoryLayer::forward_propagate(const Tensor<DynamicTensor<type>, 1>& inputs, Tensor<type, 1>& parameters, LayerForwardPropagation* forward_propagation)
+{
+    if(inputs(0).get_dimensions().size() != 2)
+    {
+        ostringstream buffer;
 
-        hidden_states *= long_short_term_memory_layer_forward_propagation->current_output_activations;
+        buffer << "OpenNN Exception: LongShortTermMemoryLayer class.\n"
+               << "void forward_propagate(const Tensor<DynamicTensor<type>, 1>&, Tensor<type, 1>&, LayerForwardPropagation*) final.\n"
+               << "Inputs rank must be equal to 2.\n";
 
-        // Activations 2d
+        throw invalid_argument(buffer.str());
+    }
 
-        #pragma omp parallel for
+    LongShortTermMemoryLayerForwardPropagation* long_short_term_memory_layer_forward_propagation
+            = static_cast<LongShortTermMemoryLayerForwardPropagation*>(forward_propagation);
 
-        for(Index j = 0; j < neurons_number; j++)
-            outputs(i,j) = hidden_states(j);
+    // The parameters keep the gates side by side, as the layer does
 
-        // Forget (activations and activations derivatives)
+    set_gates_parameters(long_short_term_memory_layer_forward_propagation, parameters.data());
 
-        copy(current_forget_activations_data,
-             current_forget_activations_data + neurons_number,
-             forget_activations_data + copy_index);
+    const TensorMap<Tensor<type, 2>> inputs_map = inputs(0).to_tensor_map<2>();
 
-        copy(current_forget_activations_derivatives_data,
-             current_forget_activations_derivatives_data + neurons_number,
-             forget_activations_derivatives_data + copy_index);
+    calculate_sequences_outputs(inputs_map, long_short_term_memory_layer_forward_propagation, true);
+}
 
-        // Input (activations and activations derivatives)
 
-        copy(current_input_activations_data,
-             current_input_activations_data + neurons_number,
-             input_activations_data + copy_index);
+/// Makes the parameters of the gates in the forward propagation views of the given parameters, without copying them.
+/// @param forward_propagation Forward propagation of the layer.
+/// @param parameters_data Biases, weights and recurrent weights of the gates side by side, in the order of the parameters.
 
-        copy(current_input_activations_derivatives_data,
-             current_input_activations_derivatives_data + neurons_number,
-             input_activations_derivatives_data + copy_index);
+void LongShortTermMemoryLayer::set_gates_parameters(LongShortTermMemoryLayerForwardPropagation* forward_propagation, type* parameters_data) const
+{
+    const Index inputs_number = get_inputs_number();
+    const Index neurons_number = get_neurons_number();
 
-        // State (activations and activations derivatives)
+    new (&forward_propagation->gates_biases) TensorMap<Tensor<type, 1>>(parameters_data, 4*neurons_number);
 
-        copy(current_state_activations_data,
-             current_state_activations_data + neurons_number,
-             state_activations_data + copy_index);
+    new (&forward_propagation->gates_weights) TensorMap<Tensor<type, 2>>(parameters_data + 4*neurons_number,
+                                                                         inputs_number, 4*neurons_number);
 
-        copy(current_state_activations_derivatives_data,
-             current_state_activations_derivatives_data + neurons_number,
-             state_activations_derivatives_data + copy_index);
+    new (&forward_propagation->gates_recurrent_weights) TensorMap<Tensor<type, 2>>(parameters_data + 4*neurons_number + 4*inputs_number*neurons_number,
+                                                                                   neurons_number, 4*neurons_number);
+}
 
-        // Output (activations and activations derivatives)
 
-        copy(current_output_activations_data,
-             current_output_activations_data + neurons_number,
-             output_activations_data + copy_index);
+/// Returns the hidden states of the previous timestep of the sequences which reach the current one, with a row for each sequence.
+/// These are the first rows of the previous timestep. When a sequence has ended there, the rows are not contiguous,
+/// so they are copied to a buffer of the forward propagation, and the products take a map with the exact dimensions.
+/// @param forward_propagation Forward propagation with the hidden states of all the timesteps.
+/// @param previous_sequences_offset First row of the previous timestep in the hidden states.
+/// @param previous_sequences_number Number of sequences which reach the previous timestep.
+/// @param sequences_number Number of sequences which reach the current timestep.
 
-        copy(current_output_activations_derivatives_data,
-             current_output_activations_derivatives_data + neurons_number,
-             output_activations_derivatives_data + copy_index);
+TensorMap<Tensor<type, 2>> LongShortTermMemoryLayer::get_previous_hidden_states(LongShortTermMemoryLayerForwardPropagation* forward_propagation,
+                                                                               const Index& previous_sequences_offset,
+                                                                               const Index& previous_sequences_number,
+                                                                               const Index& sequences_number) const
+{
+    const Index neurons_number = get_neurons_number();
 
-        // Cell states (activations)
+    type* previous_hidden_states_data = forward_propagation->hidden_states.data() + previous_sequences_offset*neurons_number;
 
-        copy(cell_states_data,
-             cell_states_data + neurons_number,
-             cell_states_activations_data + copy_index);
+    if(sequences_number == previous_sequences_number)
+        return TensorMap<Tensor<type, 2>>(previous_hidden_states_data, sequences_number, neurons_number);
 
-        // Hidden states (activations and activations derivatives)
+    const TensorMap<Tensor<type, 2>> previous_hidden_states(previous_hidden_states_data, previous_sequences_number, neurons_number);
 
-        copy(hidden_states_data,
-             hidden_states_data + neurons_number,
-             hidden_states_activations_data + copy_index);
+    TensorMap<Tensor<type, 2>> continuing_hidden_states(forward_propagation->previous_hidden_states.data(), sequences_number, neurons_number);
 
-        copy(current_hidden_states_derivatives_data,
-             current_hidden_states_derivatives_data + neurons_number,
-             hidden_states_activations_derivatives_data + copy_index);
+    continuing_hidden_states.device(*thread_pool_device)
+            = previous_hidden_states.slice(Eigen::array<Index, 2>({0, 0}), Eigen::array<Index, 2>({sequences_number, neurons_number}));
 
-        copy_index += neurons_number;
-    }
+    return continuing_hidden_states;
 }
 
 
-//remove?
-void LongShortTermMemoryLayer::forward_propagate(const Tensor<DynamicTensor<type>, 1>& inputs, Tensor<type, 1>& parameters, LayerForwardPropagation* forward_propagation)
-{
-
-    if(inputs(0).get_dimensions().size() != 2)
-    {
-        ostringstream buffer;
-
-        buffer << "OpenNN Exception: ProbabilisticLayer class.\n"
-               << "void forward_propagate(type*, const Tensor<Index, 1>&, Tensor<type, 1>&, LayerForwardPropagation*) final.\n"
-               << "Inputs rank must be equal to 2.\n";
-
-        throw invalid_argument(buffer.str());
-    }
-
-
-    LongShortTermMemoryLayerForwardPropagation* long_short_term_memory_layer_forward_propagation
-            = static_cast<LongShortTermMemoryLayerForwardPropagation*>(forward_propagation);
+/// Calculates the outputs of the layer for a batch of sequences.
+/// Consecutive rows of the inputs are the timesteps of a sequence, and a new sequence starts every timesteps rows.
+/// The products of the inputs and the weights of all the gates are computed at once for the whole batch.
+/// Then the timesteps are computed one after another, each of them for all the sequences together,
+/// so that the recurrent products are matrix products with a row for each sequence.
+/// @param inputs Batch of inputs, with a row for each sample.
+/// @param forward_propagation Forward propagation with the parameters of the gates, where the quantities are stored.
+/// @param is_training True if the activations derivatives are needed for back-propagation.
 
-    const Index inputs_number = get_inputs_number();
+void LongShortTermMemoryLayer::calculate_sequences_outputs(const TensorMap<Tensor<type, 2>>& inputs,
+                                                           LongShortTermMemoryLayerForwardPropagation* forward_propagation,
+                                                           const bool& is_training)
+{
+    const Index samples_number = inputs.dimension(0);
     const Index neurons_number = get_neurons_number();
 
-    const TensorMap<Tensor<type, 1>> forget_biases(parameters.data(), neurons_number);
-    const TensorMap<Tensor<type, 1>> input_biases(parameters.data()+neurons_number, neurons_number);
-    const TensorMap<Tensor<type, 1>> state_biases(parameters.data()+2*neurons_number, neurons_number);
-    const TensorMap<Tensor<type, 1>> output_biases(parameters.data()+3*neurons_number, neurons_number);
-
-    const TensorMap<Tensor<type, 2>> forget_weights(parameters.data()+4*neurons_number, inputs_number, neurons_number);
-    const TensorMap<Tensor<type, 2>> input_weights(parameters.data()+4*neurons_number+inputs_number*neurons_number, inputs_number, neurons_number);
-    const TensorMap<Tensor<type, 2>> state_weights(parameters.data()+4*neurons_number+2*inputs_number*neurons_number, inputs_number, neurons_number);
-    const TensorMap<Tensor<type, 2>> output_weights(parameters.data()+4*neurons_number+3*inputs_number*neurons_number, inputs_number, neurons_number);
+    const Index steps_number = min(timesteps, samples_number);
 
-    const TensorMap<Tensor<type, 2>> forget_recurrent_weights(parameters.data()+4*neurons_number+4*inputs_number*neurons_number, neurons_number, neurons_number);
-    const TensorMap<Tensor<type, 2>> input_recurrent_weights(parameters.data()+4*neurons_number+4*inputs_number*neurons_number+neurons_number*neurons_number, neurons_number, neurons_number);
-    const TensorMap<Tensor<type, 2>> state_recurrent_weights(parameters.data()+4*neurons_number+4*inputs_number*neurons_number+2*neurons_number*neurons_number, neurons_number, neurons_number);
-    const TensorMap<Tensor<type, 2>> output_recurrent_weights(parameters.data()+4*neurons_number+4*inputs_number*neurons_number+3*neurons_number*neurons_number, neurons_number, neurons_number);
-
-    const Index samples_number = inputs(0).get_dimension(0);
-
-    TensorMap<Tensor<type, 2>> inputs_map = inputs(0).to_tensor_map<2>();
-
-    const Tensor<Index, 1> outputs_dimensions = forward_propagation->outputs[0].get_dimensions();
+    const Eigen::array<Index, 2> rows_strides({timesteps, 1});
 
     TensorMap<Tensor<type, 2>> outputs = forward_propagation->outputs(0).to_tensor_map<2>();
 
-    Tensor<type, 1> forget_combinations(neurons_number);
-    Tensor<type, 1> input_combinations(neurons_number);
-    Tensor<type, 1> state_combinations(neurons_number);
-    Tensor<type, 1> output_combinations(neurons_number);
-
-    Tensor<type, 1> forget_activations(neurons_number);
-    Tensor<type, 1> input_activations(neurons_number);
-    Tensor<type, 1> state_activations(neurons_number);
-    Tensor<type, 1> output_activations(neurons_number);
+    Tensor<type, 2>& inputs_combinations = forward_propagation->inputs_combinations;
 
-    Tensor<type, 1> forget_activations_derivatives(neurons_number);
-    Tensor<type, 1> input_activations_derivatives(neurons_number);
-    Tensor<type, 1> state_activations_derivatives(neurons_number);
-    Tensor<type, 1> output_activations_derivatives(neurons_number);
+    const TensorMap<Tensor<type, 2>>& gates_recurrent_weights = forward_propagation->gates_recurrent_weights;
 
-    Tensor<type, 1> hidden_states_derivatives(neurons_number);
-
-    Tensor<Index, 1> current_inputs_dimensions;
-    Tensor<Index, 1> combinations_dimensions;
-    Tensor<Index, 1> activations_dimensions;
-    Tensor<Index, 1> derivatives_dimensions;
-
-    Index copy_index = 0;
-
-    for(Index i = 0; i < samples_number; i++)
-    {
-        if(i%timesteps == 0)
-        {
-            hidden_states.setZero();
-            cell_states.setZero();
-        }
+    // Inputs combinations of all the gates and samples
 
-        Tensor<type, 1> current_inputs = inputs_map.chip(i,0);
-        current_inputs_dimensions = get_dimensions(current_inputs);
-
-        combinations_dimensions = get_dimensions(forget_combinations);
-        activations_dimensions = get_dimensions(forget_activations);
-        derivatives_dimensions = get_dimensions(forget_activations_derivatives);
-
-        calculate_combinations(current_inputs.data(), current_inputs_dimensions, forget_weights, forget_recurrent_weights, forget_biases, forget_combinations.data(), combinations_dimensions);
-        calculate_recurrent_activations_derivatives(forget_combinations.data(),
-                                                    combinations_dimensions,
-                                                    forget_activations.data(),
-                                                    activations_dimensions,
-                                                    forget_activations_derivatives.data(),
-                                                    derivatives_dimensions);
+    inputs_combinations.device(*thread_pool_device) = inputs.contract(forward_propagation->gates_weights, A_B);
 
-        combinations_dimensions = get_dimensions(input_combinations);
-        activations_dimensions = get_dimensions(input_activations);
-        derivatives_dimensions = get_dimensions(input_activations_derivatives);
+    inputs_combinations.device(*thread_pool_device)
+            += forward_propagation->gates_biases.reshape(Eigen::array<Index, 2>({1, 4*neurons_number}))
+                                                .broadcast(Eigen::array<Index, 2>({samples_number, 1}));
 
-        calculate_combinations(current_inputs.data(), current_inputs_dimensions, input_weights, input_recurrent_weights, input_biases, input_combinations.data(), combinations_dimensions);
-        calculate_recurrent_activations_derivatives(input_combinations.data(),
-                                                    combinations_dimensions,
-                                                    input_activations.data(),
-                                                    activations_dimensions,
-                                                    input_activations_derivatives.data(),
-                                                    derivatives_dimensions);
+    Tensor<Index, 1> gate_dimensions(2);
 
-        combinations_dimensions = get_dimensions(state_combinations);
-        activations_dimensions = get_dimensions(state_activations);
-        derivatives_dimensions = get_dimensions(state_activations_derivatives);
+    Index sequences_offset = 0;
+    Index previous_sequences_number = 0;
 
-        calculate_combinations(current_inputs.data(), current_inputs_dimensions, state_weights, state_recurrent_weights, state_biases, state_combinations.data(), combinations_dimensions);
-        calculate_recurrent_activations_derivatives(state_combinations.data(),
-                                                    combinations_dimensions,
-                                                    state_activations.data(),
-                                                    activations_dimensions,
-                                                    state_activations_derivatives.data(),
-                                                    derivatives_dimensions);
+    for(Index step = 0; step < steps_number; step++)
+    {
+        const Index sequences_number = (samples_number - step + timesteps - 1)/timesteps;
 
-        combinations_dimensions = get_dimensions(output_combinations);
-        activations_dimensions = get_dimensions(output_activations);
-        derivatives_dimensions = get_dimensions(output_activations_derivatives);
+        const Index gate_size = sequences_number*neurons_number;
 
-        calculate_combinations(current_inputs.data(), current_inputs_dimensions, output_weights, output_recurrent_weights, output_biases, output_combinations.data(), combinations_dimensions);
-        calculate_recurrent_activations_derivatives(output_combinations.data(),
-                                                    combinations_dimensions,
-                                                    output_activations.data(),
-                                                    activations_dimensions,
-                                                    output_activations_derivatives.data(),
-                                                    derivatives_dimensions);
+        gate_dimensions.setValues({sequences_number, neurons_number});
 
-        combinations_dimensions = get_dimensions(cell_states);
-        activations_dimensions = get_dimensions(hidden_states);
-        derivatives_dimensions = get_dimensions(hidden_states_derivatives);
+        TensorMap<Tensor<type, 2>> gates_combinations(forward_propagation->gates_combinations.data() + 4*sequences_offset*neurons_number,
+                                                      sequences_number, 4*neurons_number);
 
-        cell_states = forget_activations * cell_states + input_activations * state_activations;
-        calculate_activations_derivatives(cell_states.data(),
-                                          combinations_dimensions,
-                                          hidden_states.data(),
-                                          activations_dimensions,
-                                          hidden_states_derivatives.data(),
-                                          derivatives_dimensions);
+        type* gates_activations_data = forward_propagation->gates_activations.data() + 4*sequences_offset*neurons_number;
+        type* gates_activations_derivatives_data = forward_propagation->gates_activations_derivatives.data() + 4*sequences_offset*neurons_number;
 
-        hidden_states *= output_activations;
+        TensorMap<Tensor<type, 2>> current_cell_states(forward_propagation->cell_states.data() + sequences_offset*neurons_number,
+                                               sequences_number, neurons_number);
 
-        // Activations 2d
+        TensorMap<Tensor<type, 2>> cell_states_activations(forward_propagation->cell_states_activations.data() + sequences_offset*neurons_number,
+                                                           sequences_number, neurons_number);
 
-        for(Index j = 0; j < neurons_number; j++) outputs(i,j) = hidden_states(j);
+        TensorMap<Tensor<type, 2>> current_hidden_states(forward_propagation->hidden_states.data() + sequences_offset*neurons_number,
+                                                 sequences_number, neurons_number);
 
-        // Forget (activations and activations derivatives)
+        // Combinations
 
-        copy(long_short_term_memory_layer_forward_propagation->current_forget_activations.data(),
-             long_short_term_memory_layer_forward_propagation->current_forget_activations.data() + neurons_number,
-             long_short_term_memory_layer_forward_propagation->forget_activations.data() + copy_index);
+        gates_combinations.device(*thread_pool_device)
+                = inputs_combinations.slice(Eigen::array<Index, 2>({step, 0}), Eigen::array<Index, 2>({samples_number - step, 4*neurons_number}))
+                                     .stride(rows_strides);
 
-        copy(long_short_term_memory_layer_forward_propagation->current_forget_activations_derivatives.data(),
-             long_short_term_memory_layer_forward_propagation->current_forget_activations_derivatives.data() + neurons_number,
-             long_short_term_memory_layer_forward_propagation->forget_activations_derivatives.data() + copy_index);
+        if(step > 0)
+        {
+            const TensorMap<Tensor<type, 2>> previous_hidden_states
+                    = get_previous_hidden_states(forward_propagation, sequences_offset - previous_sequences_number, previous_sequences_number, sequences_number);
 
-        // Input (activations and activations derivatives)
+            gates_combinations.device(*thread_pool_device) += previous_hidden_states.contract(gates_recurrent_weights, A_B);
+        }
 
-        copy(long_short_term_memory_layer_forward_propagation->current_input_activations.data(),
-             long_short_term_memory_layer_forward_propagation->current_input_activations.data() + neurons_number,
-             long_short_term_memory_layer_forward_propagation->input_activations.data() + copy_index);
+        // Activations. The forget, input and output gates use the recurrent activation function.
 
-        copy(long_short_term_memory_layer_forward_propagation->current_input_activations_derivatives.data(),
-             long_short_term_memory_layer_forward_propagation->current_input_activations_derivatives.data() + neurons_number,
-             long_short_term_memory_layer_forward_propagation->input_activations_derivatives.data() + copy_index);
+        for(Index gate = 0; gate < 4; gate++)
+        {
+            type* combinations_data = gates_combinations.data() + gate*gate_size;
+            type* activations_data = gates_activations_data + gate*gate_size;
+            type* derivatives_data = gates_activations_derivatives_data + gate*gate_size;
+
+            if(gate == 2 && is_training)
+                calculate_activations_derivatives(combinations_data, gate_dimensions, activations_data, gate_dimensions, derivatives_data, gate_dimensions);
+            else if(gate == 2)
+                calculate_activations(combinations_data, gate_dimensions, activations_data, gate_dimensions);
+            else if(is_training)
+                calculate_recurrent_activations_derivatives(combinations_data, gate_dimensions, activations_data, gate_dimensions, derivatives_data, gate_dimensions);
+            else
+                calculate_recurrent_activations(combinations_data, gate_dimensions, activations_data, gate_dimensions);
+        }
 
-        // State (activations and activations derivatives)
+        const TensorMap<Tensor<type, 2>> forget_activations(gates_activations_data, sequences_number, neurons_number);
+        const TensorMap<Tensor<type, 2>> input_activations(gates_activations_data + gate_size, sequences_number, neurons_number);
+        const TensorMap<Tensor<type, 2>> state_activations(gates_activations_data + 2*gate_size, sequences_number, neurons_number);
+        const TensorMap<Tensor<type, 2>> output_activations(gates_activations_data + 3*gate_size, sequences_number, neurons_number);
 
-        copy(long_short_term_memory_layer_forward_propagation->current_state_activations.data(),
-             long_short_term_memory_layer_forward_propagation->current_state_activations.data() + neurons_number,
-             long_short_term_memory_layer_forward_propagation->state_activations.data() + copy_index);
+        // C_t = f_t * C_(t-1) + i_t * C~_t
 
-        copy(long_short_term_memory_layer_forward_propagation->current_state_activations_derivatives.data(),
-             long_short_term_memory_layer_forward_propagation->current_state_activations_derivatives.data() + neurons_number,
-             long_short_term_memory_layer_forward_propagation->state_activations_derivatives.data() + copy_index);
+        current_cell_states.device(*thread_pool_device) = input_activations*state_activations;
 
-        // Output (activations and activations derivatives)
+        if(step > 0)
+        {
+            const TensorMap<Tensor<type, 2>> previous_cell_states(forward_propagation->cell_states.data() + (sequences_offset - previous_sequences_number)*neurons_number,
+                                                                  previous_sequences_number, neurons_number);
 
-        copy(long_short_term_memory_layer_forward_propagation->current_output_activations.data(),
-             long_short_term_memory_layer_forward_propagation->current_output_activations.data() + neurons_number,
-             long_short_term_memory_layer_forward_propagation->output_activations.data() + copy_index);
+            current_cell_states.device(*thread_pool_device)
+                    += forget_activations*previous_cell_states.slice(Eigen::array<Index, 2>({0, 0}), Eigen::array<Index, 2>({sequences_number, neurons_number}));
+        }
 
-        copy(long_short_term_memory_layer_forward_propagation->current_output_activations_derivatives.data(),
-             long_short_term_memory_layer_forward_propagation->current_output_activations_derivatives.data() + neurons_number,
-             long_short_term_memory_layer_forward_propagation->output_activations_derivatives.data() + copy_index);
+        if(is_training)
+        {
+            calculate_activations_derivatives(current_cell_states.data(), gate_dimensions,
+                                              cell_states_activations.data(), gate_dimensions,
+                                              forward_propagation->cell_states_activations_derivatives.data() + sequences_offset*neurons_number, gate_dimensions);
+        }
+        else
+        {
+            calculate_activations(current_cell_states.data(), gate_dimensions, cell_states_activations.data(), gate_dimensions);
+        }
 
-        // Cell states (activations)
+        // h_t = o_t * tanh(C_t)
 
-        copy(cell_states.data(),
-             cell_states.data() + neurons_number,
-             long_short_term_memory_layer_forward_propagation->cell_states_activations.data() + copy_index);
+        current_hidden_states.device(*thread_pool_device) = output_activations*cell_states_activations;
 
-        // Hidden states (activations and activations derivatives)
+        outputs.slice(Eigen::array<Index, 2>({step, 0}), Eigen::array<Index, 2>({samples_number - step, neurons_number}))
+               .stride(rows_strides).device(*thread_pool_device) = current_hidden_states;
 
-        copy(hidden_states.data(),
-             hidden_states.data() + neurons_number,
-             long_short_term_memory_layer_forward_propagation->hidden_states_activations.data() + copy_index);
+        // States after the last sample
 
-        copy(long_short_term_memory_layer_forward_propagation->current_hidden_states_derivatives.data(),
-             long_short_term_memory_layer_forward_propagation->current_hidden_states_derivatives.data() + neurons_number,
-             long_short_term_memory_layer_forward_propagation->hidden_states_activations_derivatives.data() + copy_index);
+        if(step == (samples_number - 1)%timesteps)
+        {
+            hidden_states = current_hidden_states.chip(sequences_number - 1, 0);
+            cell_states = current_cell_states.chip(sequences_number - 1, 0);
+        }
 
-        copy_index += neurons_number;
+        sequences_offset += sequences_number;
+        previous_sequences_number = sequences_number;
     }
 }
 
@@ -2118,68 +1937,52 @@ void LongShortTermMemoryLayer::insert_gradient(LayerBackPropagation* back_propag
     LongShortTermMemoryLayerBackPropagation* long_short_term_memory_layer_back_propagation =
             static_cast<LongShortTermMemoryLayerBackPropagation*>(back_propagation);
 
-    // Biases
+    type* gradient_data = gradient.data() + index;
 
-    copy(long_short_term_memory_layer_back_propagation->forget_biases_derivatives.data(),
-         long_short_term_memory_layer_back_propagation->forget_biases_derivatives.data() + neurons_number,
-         gradient.data() + index);
+    // Already computed in place
 
-    copy(long_short_term_memory_layer_back_propagation->input_biases_derivatives.data(),
-         long_short_term_memory_layer_back_propagation->input_biases_derivatives.data() + neurons_number,
-         gradient.data() + index + neurons_number);
+    if(long_short_term_memory_layer_back_propagation->gates_biases_derivatives.data() == gradient_data) return;
 
-    copy(long_short_term_memory_layer_back_propagation->state_biases_derivatives.data(),
-         long_short_term_memory_layer_back_propagation->state_biases_derivatives.data() + neurons_number,
-         gradient.data() + index + 2*neurons_number);
+    // Biases
 
-    copy(long_short_term_memory_layer_back_propagation->output_biases_derivatives.data(),
-         long_short_term_memory_layer_back_propagation->output_biases_derivatives.data() + neurons_number,
-         gradient.data() + index + 3*neurons_number);
+    copy(long_short_term_memory_layer_back_propagation->gates_biases_derivatives.data(),
+         long_short_term_memory_layer_back_propagation->gates_biases_derivatives.data() + 4*neurons_number,
+         gradient_data);
 
     // Weights
 
-    copy(long_short_term_memory_layer_back_propagation->forget_weights_derivatives.data(),
-         long_short_term_memory_layer_back_propagation->forget_weights_derivatives.data() + inputs_number*neurons_number,
-         gradient.data() + index + 4*neurons_number);
-
-    copy(long_short_term_memory_layer_back_propagation->input_weights_derivatives.data(),
-         long_short_term_memory_layer_back_propagation->input_weights_derivatives.data() + inputs_number*neurons_number,
-         gradient.data() + index + 4*neurons_number + inputs_number*neurons_number);
-
-    copy(long_short_term_memory_layer_back_propagation->state_weights_derivatives.data(),
-         long_short_term_memory_layer_back_propagation->state_weights_derivatives.data() + inputs_number*neurons_number,
-         gradient.data() + index + 4*neurons_number + 2*inputs_number*neurons_number);
-
-    copy(long_short_term_memory_layer_back_propagation->output_weights_derivatives.data(),
-         long_short_term_memory_layer_back_propagation->output_weights_derivatives.data() + inputs_number*neurons_number,
-         gradient.data() + index + 4*neurons_number + 3*inputs_number*neurons_number);
+    copy(long_short_term_memory_layer_back_propagation->gates_weights_derivatives.data(),
+         long_short_term_memory_layer_back_propagation->gates_weights_derivatives.data() + 4*inputs_number*neurons_number,
+         gradient_data + 4*neurons_number);
 
     // Recurrent weights
 
-    copy(long_short_term_memory_layer_back_propagation->forget_recurrent_weights_derivatives.data(),
-         long_short_term_memory_layer_back_propagation->forget_recurrent_weights_derivatives.data() + neurons_number*neurons_number,
-         gradient.data() + index + 4*neurons_number + 4*inputs_number*neurons_number);
-
-    copy(long_short_term_memory_layer_back_propagation->input_recurrent_weights_derivatives.data(),
-         long_short_term_memory_layer_back_propagation->input_recurrent_weights_derivatives.data() + neurons_number*neurons_number,
-         gradient.data() + index + 4*neurons_number + 4*inputs_number*neurons_number + neurons_number*neurons_number);
-
-    copy(long_short_term_memory_layer_back_propagation->state_recurrent_weights_derivatives.data(),
-         long_short_term_memory_layer_back_propagation->state_recurrent_weights_derivatives.data() + neurons_number*neurons_number,
-         gradient.data() + index + 4*neurons_number + 4*inputs_number*neurons_number + 2*neurons_number*neurons_number);
-
-    copy(long_short_term_memory_layer_back_propagation->output_recurrent_weights_derivatives.data(),
-         long_short_term_memory_layer_back_propagation->output_recurrent_weights_derivatives.data() + neurons_number*neurons_number,
-         gradient.data() + index + 4*neurons_number + 4*inputs_number*neurons_number + 3*neurons_number*neurons_number);
+    copy(long_short_term_memory_layer_back_propagation->gates_recurrent_weights_derivatives.data(),
+         long_short_term_memory_layer_back_propagation->gates_recurrent_weights_derivatives.data() + 4*neurons_number*neurons_number,
+         gradient_data + 4*neurons_number + 4*inputs_number*neurons_number);
 }
 
 
+/// Calculates the gradient of the error with respect to the parameters of the layer by back-propagation through time.
+/// The timesteps are visited backwards, each of them for all the sequences together.
+/// The deltas of the combinations of all the gates are gathered in the order of the batch,
+/// so that the biases and weights derivatives take a single product for the whole batch.
+/// This replaces the real-time recurrent learning of previous versions, which gives the same gradient
+/// by carrying the derivatives of the hidden and cell states with respect to every parameter forward in time.
+/// That needed a matrix of parameters by neurons for each of the twelve groups of parameters and a product of it
+/// with the recurrent weights at every sample, while the backward pass here costs about as much as the forward pass.
+
 void LongShortTermMemoryLayer::calculate_error_gradient(type* inputs_data,
                                                         LayerForwardPropagation* forward_propagation,
-    LayerBackPropagation* back_propagation) const
+                                                        LayerBackPropagation* back_propagation) const
 {
+    const Index samples_number = back_propagation->batch_samples_number;
+    const Index inputs_number = get_inputs_number();
+    const Index neurons_number = get_neurons_number();
 
-    const Index batch_samples_number = back_propagation->batch_samples_number;
+    const Index steps_number = min(timesteps, samples_number);
+
+    const Eigen::array<Index, 2> rows_strides({timesteps, 1});
 
     LongShortTermMemoryLayerForwardPropagation* long_short_term_memory_layer_forward_propagation =
             static_cast<LongShortTermMemoryLayerForwardPropagation*>(forward_propagation);
@@ -2187,1777 +1990,135 @@ void LongShortTermMemoryLayer::calculate_error_gradient(type* inputs_data,
     LongShortTermMemoryLayerBackPropagation* long_short_term_memory_layer_back_propagation =
             static_cast<LongShortTermMemoryLayerBackPropagation*>(back_propagation);
 
-    const TensorMap<Tensor<type, 2>> inputs(inputs_data, batch_samples_number, get_inputs_number());
-
-    #pragma omp parallel
-    {
-        // Biases
-
-        #pragma omp single nowait
-        calculate_forget_biases_error_gradient(inputs,
-                                               long_short_term_memory_layer_forward_propagation,
-                                               long_short_term_memory_layer_back_propagation);
-
-        #pragma omp single nowait
-        calculate_input_biases_error_gradient(inputs,
-                                              long_short_term_memory_layer_forward_propagation,
-                                              long_short_term_memory_layer_back_propagation);
-
-        #pragma omp single nowait
-        calculate_state_biases_error_gradient(inputs,
-                                              long_short_term_memory_layer_forward_propagation,
-                                              long_short_term_memory_layer_back_propagation);
-
-        #pragma omp single nowait
-        calculate_output_biases_error_gradient(inputs,
-                                               long_short_term_memory_layer_forward_propagation,
-                                               long_short_term_memory_layer_back_propagation);
-
-        // Weights
-
-        #pragma omp single nowait
-        calculate_forget_weights_error_gradient(inputs,
-                                                long_short_term_memory_layer_forward_propagation,
-                                                long_short_term_memory_layer_back_propagation);
-
-        #pragma omp single nowait
-        calculate_input_weights_error_gradient(inputs,
-                                               long_short_term_memory_layer_forward_propagation,
-                                               long_short_term_memory_layer_back_propagation);
-
-        #pragma omp single nowait
-        calculate_state_weights_error_gradient(inputs,
-                                               long_short_term_memory_layer_forward_propagation,
-                                               long_short_term_memory_layer_back_propagation);
-
-        #pragma omp single nowait
-        calculate_output_weights_error_gradient(inputs,
-                                                long_short_term_memory_layer_forward_propagation,
-                                                long_short_term_memory_layer_back_propagation);
-
-        // Recurrent weights
-
-        #pragma omp single nowait
-        calculate_forget_recurrent_weights_error_gradient(inputs,
-                                                          long_short_term_memory_layer_forward_propagation,
-                                                          long_short_term_memory_layer_back_propagation);
-
-        #pragma omp single nowait
-        calculate_input_recurrent_weights_error_gradient(inputs,
-                                                         long_short_term_memory_layer_forward_propagation,
-                                                         long_short_term_memory_layer_back_propagation);
-
-        #pragma omp single nowait
-        calculate_state_recurrent_weights_error_gradient(inputs,
-                                                         long_short_term_memory_layer_forward_propagation,
-                                                         long_short_term_memory_layer_back_propagation);
-
-        #pragma omp single nowait
-        calculate_output_recurrent_weights_error_gradient(inputs,
-                                                          long_short_term_memory_layer_forward_propagation,
-                                                          long_short_term_memory_layer_back_propagation);
-    }
-}
-
-
-
-void LongShortTermMemoryLayer::calculate_forget_weights_error_gradient(const Tensor<type, 2>& inputs,
-                                                                       LongShortTermMemoryLayerForwardPropagation* forward_propagation,
-                                                                       LongShortTermMemoryLayerBackPropagation* back_propagation) const
-{
-
-    const Index samples_number = inputs.dimension(0);
-    const Index inputs_number = get_inputs_number();
-    const Index neurons_number = get_neurons_number();
-    const Index parameters_number = inputs_number*neurons_number;
-
-    const TensorMap<Tensor<type, 2>> deltas(back_propagation->deltas_data, back_propagation->deltas_dimensions(0), back_propagation->deltas_dimensions(1));
+    const TensorMap<Tensor<type, 2>> inputs(inputs_data, samples_number, inputs_number);
 
-    Tensor<type, 2> input_combinations_weights_derivatives(parameters_number, neurons_number);
-    Tensor<type, 2> forget_combinations_weights_derivatives(parameters_number, neurons_number);
-    Tensor<type, 2> state_combinations_weights_derivatives(parameters_number, neurons_number);
-    Tensor<type, 2> output_combinations_weights_derivatives(parameters_number, neurons_number);
+    const TensorMap<Tensor<type, 2>> deltas(back_propagation->deltas_data, samples_number, neurons_number);
 
-    Tensor<type, 2> hidden_states_weights_derivatives(parameters_number, neurons_number);
-    Tensor<type, 2> cell_state_weights_derivatives(parameters_number, neurons_number);
+    const TensorMap<Tensor<type, 2>>& gates_recurrent_weights = long_short_term_memory_layer_forward_propagation->gates_recurrent_weights;
 
-    input_combinations_weights_derivatives.setZero();
-    forget_combinations_weights_derivatives.setZero();
-    state_combinations_weights_derivatives.setZero();
-    output_combinations_weights_derivatives.setZero();
-    hidden_states_weights_derivatives.setZero();
-    cell_state_weights_derivatives.setZero();
+    Tensor<type, 2>& combinations_deltas = long_short_term_memory_layer_back_propagation->combinations_deltas;
 
-    Index column_index = 0;
-    Index input_index = 0;
+    TensorMap<Tensor<type, 2>>& gates_recurrent_weights_derivatives = long_short_term_memory_layer_back_propagation->gates_recurrent_weights_derivatives;
 
-    Index copy_index = 0;
+    gates_recurrent_weights_derivatives.setZero();
 
-    back_propagation->forget_weights_derivatives.setZero();
+    Index sequences_offset = samples_number;
+    Index next_sequences_number = 0;
 
-    #pragma omp parallel for
-    for(Index sample = 0; sample < samples_number; sample++)
+    for(Index step = steps_number - 1; step >= 0; step--)
     {
-        const Tensor<type, 1> current_inputs = inputs.chip(sample, 0); // memcpy?
-        const Tensor<type, 1> current_layer_deltas = deltas.chip(sample,0); // memcpy?
-
-        // Forget activations and derivatives
-
-        copy(forward_propagation->forget_activations.data() + copy_index,
-             forward_propagation->forget_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_forget_activations.data());
-
-        copy(forward_propagation->forget_activations_derivatives.data() + copy_index,
-             forward_propagation->forget_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_forget_activations_derivatives.data());
-
-        // Input activations and derivatives
-
-        copy(forward_propagation->input_activations.data() + copy_index,
-             forward_propagation->input_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_input_activations.data());
-
-        copy(forward_propagation->input_activations_derivatives.data() + copy_index,
-             forward_propagation->input_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_input_activations_derivatives.data());
-
-        // State activations and derivatives
-
-        copy(forward_propagation->state_activations.data() + copy_index,
-             forward_propagation->state_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_state_activations.data());
-
-        copy(forward_propagation->state_activations_derivatives.data() + copy_index,
-             forward_propagation->state_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_state_activations_derivatives.data());
-
-        // Output activations and derivatives
-
-        copy(forward_propagation->output_activations.data() + copy_index,
-             forward_propagation->output_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_output_activations.data());
-
-        copy(forward_propagation->output_activations_derivatives.data() + copy_index,
-             forward_propagation->output_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_output_activations_derivatives.data());
+        const Index sequences_number = (samples_number - step + timesteps - 1)/timesteps;
+        const Index previous_sequences_number = step > 0 ? (samples_number - step + timesteps)/timesteps : 0;
 
-        // Cell states and hidden states
+        const Index gate_size = sequences_number*neurons_number;
 
-        copy(forward_propagation->cell_states_activations.data() + copy_index,
-             forward_propagation->cell_states_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_cell_state_activations.data());
+        sequences_offset -= sequences_number;
 
-        copy(forward_propagation->hidden_states_activations_derivatives.data() + copy_index,
-             forward_propagation->hidden_states_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_hidden_states_derivatives.data());
+        type* gates_activations_data = long_short_term_memory_layer_forward_propagation->gates_activations.data() + 4*sequences_offset*neurons_number;
+        type* gates_activations_derivatives_data = long_short_term_memory_layer_forward_propagation->gates_activations_derivatives.data() + 4*sequences_offset*neurons_number;
 
-        if(sample%timesteps == 0)
-        {
-            forward_propagation->previous_cell_state_activations.setZero();
-
-            forget_combinations_weights_derivatives.setZero();
-            input_combinations_weights_derivatives.setZero();
-            output_combinations_weights_derivatives.setZero();
-            state_combinations_weights_derivatives.setZero();
-
-            cell_state_weights_derivatives.setZero();
-        }
-        else
-        {
-            copy(forward_propagation->cell_states_activations.data() + (copy_index-neurons_number),
-                 forward_propagation->cell_states_activations.data() + (copy_index-neurons_number) + neurons_number,
-                 forward_propagation->previous_cell_state_activations.data());
-
-            forget_combinations_weights_derivatives = hidden_states_weights_derivatives.contract(forget_recurrent_weights, A_B);
-
-            input_combinations_weights_derivatives = hidden_states_weights_derivatives.contract(input_recurrent_weights, A_B);
-            multiply_rows(input_combinations_weights_derivatives, forward_propagation->current_input_activations_derivatives);
-
-            state_combinations_weights_derivatives = hidden_states_weights_derivatives.contract(state_recurrent_weights, A_B);
-            multiply_rows(state_combinations_weights_derivatives, forward_propagation->current_state_activations_derivatives);
-
-            output_combinations_weights_derivatives = hidden_states_weights_derivatives.contract(output_recurrent_weights, A_B);
-            multiply_rows(output_combinations_weights_derivatives, forward_propagation->current_output_activations_derivatives);
-        }
-
-        column_index = 0;
-        input_index = 0;
-
-        for(Index i = 0; i < parameters_number; i++)
-        {
-            forget_combinations_weights_derivatives(i, column_index) += current_inputs(input_index);
-
-            input_index++;
-
-            if(input_index == inputs_number)
-            {
-                input_index = 0;
-                column_index++;
-            }
-        }
-
-        multiply_rows(cell_state_weights_derivatives,
-                      forward_propagation->current_forget_activations);
-
-        multiply_rows(input_combinations_weights_derivatives,
-                      forward_propagation->current_state_activations);
-
-        cell_state_weights_derivatives += input_combinations_weights_derivatives;
-
-        multiply_rows(state_combinations_weights_derivatives,
-                      forward_propagation->current_input_activations);
-
-        cell_state_weights_derivatives += state_combinations_weights_derivatives;
-
-        multiply_rows(forget_combinations_weights_derivatives,
-                      forward_propagation->current_forget_activations_derivatives*forward_propagation->previous_cell_state_activations);
-
-        cell_state_weights_derivatives += forget_combinations_weights_derivatives;
-
-        copy(cell_state_weights_derivatives.data(),
-             cell_state_weights_derivatives.data() + cell_state_weights_derivatives.size(),
-             hidden_states_weights_derivatives.data());
-
-        multiply_rows(hidden_states_weights_derivatives,
-                      forward_propagation->current_output_activations*forward_propagation->current_hidden_states_derivatives);
-
-        multiply_rows(output_combinations_weights_derivatives,
-                      calculate_activations(forward_propagation->current_cell_state_activations));
-        hidden_states_weights_derivatives += output_combinations_weights_derivatives;
-
-        back_propagation->forget_weights_derivatives += hidden_states_weights_derivatives.contract(current_layer_deltas, A_B);
-
-        copy_index += neurons_number;
-    }
-}
-
-
-void LongShortTermMemoryLayer::calculate_input_weights_error_gradient(const Tensor<type, 2>& inputs,
-                                                                      LongShortTermMemoryLayerForwardPropagation* forward_propagation,
-                                                                      LongShortTermMemoryLayerBackPropagation* back_propagation) const
-{
-    const Index samples_number = inputs.dimension(0);
-    const Index inputs_number = get_inputs_number();
-    const Index neurons_number = get_neurons_number();
-    const Index parameters_number = inputs_number*neurons_number;
-
-    Tensor<type, 2> input_combinations_weights_derivatives(parameters_number, neurons_number);
-    Tensor<type, 2> forget_combinations_weights_derivatives(parameters_number, neurons_number);
-    Tensor<type, 2> state_combinations_weights_derivatives(parameters_number, neurons_number);
-    Tensor<type, 2> output_combinations_weights_derivatives(parameters_number, neurons_number);
+        const TensorMap<Tensor<type, 2>> forget_activations(gates_activations_data, sequences_number, neurons_number);
+        const TensorMap<Tensor<type, 2>> input_activations(gates_activations_data + gate_size, sequences_number, neurons_number);
+        const TensorMap<Tensor<type, 2>> state_activations(gates_activations_data + 2*gate_size, sequences_number, neurons_number);
+        const TensorMap<Tensor<type, 2>> output_activations(gates_activations_data + 3*gate_size, sequences_number, neurons_number);
 
-    Tensor<type, 2> hidden_states_weights_derivatives(parameters_number, neurons_number);
-    Tensor<type, 2> cell_state_weights_derivatives(parameters_number, neurons_number);
+        const TensorMap<Tensor<type, 2>> forget_activations_derivatives(gates_activations_derivatives_data, sequences_number, neurons_number);
+        const TensorMap<Tensor<type, 2>> input_activations_derivatives(gates_activations_derivatives_data + gate_size, sequences_number, neurons_number);
+        const TensorMap<Tensor<type, 2>> state_activations_derivatives(gates_activations_derivatives_data + 2*gate_size, sequences_number, neurons_number);
+        const TensorMap<Tensor<type, 2>> output_activations_derivatives(gates_activations_derivatives_data + 3*gate_size, sequences_number, neurons_number);
 
-    const TensorMap<Tensor<type, 2>> deltas(back_propagation->deltas_data, back_propagation->deltas_dimensions(0), back_propagation->deltas_dimensions(1));
+        const TensorMap<Tensor<type, 2>> cell_states_activations(long_short_term_memory_layer_forward_propagation->cell_states_activations.data() + sequences_offset*neurons_number,
+                                                                 sequences_number, neurons_number);
 
-    input_combinations_weights_derivatives.setZero();
-    forget_combinations_weights_derivatives.setZero();
-    state_combinations_weights_derivatives.setZero();
-    output_combinations_weights_derivatives.setZero();
-    hidden_states_weights_derivatives.setZero();
-    cell_state_weights_derivatives.setZero();
+        const TensorMap<Tensor<type, 2>> cell_states_activations_derivatives(long_short_term_memory_layer_forward_propagation->cell_states_activations_derivatives.data() + sequences_offset*neurons_number,
+                                                                             sequences_number, neurons_number);
 
-    Index column_index = 0;
-    Index input_index = 0;
+        TensorMap<Tensor<type, 2>> gates_deltas(long_short_term_memory_layer_back_propagation->gates_deltas.data(), sequences_number, 4*neurons_number);
 
-    Index copy_index = 0;
+        TensorMap<Tensor<type, 2>> forget_deltas(gates_deltas.data(), sequences_number, neurons_number);
+        TensorMap<Tensor<type, 2>> input_deltas(gates_deltas.data() + gate_size, sequences_number, neurons_number);
+        TensorMap<Tensor<type, 2>> state_deltas(gates_deltas.data() + 2*gate_size, sequences_number, neurons_number);
+        TensorMap<Tensor<type, 2>> output_deltas(gates_deltas.data() + 3*gate_size, sequences_number, neurons_number);
 
-    back_propagation->input_weights_derivatives.setZero();
+        TensorMap<Tensor<type, 2>> hidden_deltas(long_short_term_memory_layer_back_propagation->hidden_deltas.data(), sequences_number, neurons_number);
+        TensorMap<Tensor<type, 2>> cell_deltas(long_short_term_memory_layer_back_propagation->cell_deltas.data(), sequences_number, neurons_number);
 
-    #pragma omp for
-    for(Index sample = 0; sample < samples_number; sample++)
-    {
-        forward_propagation->current_inputs = inputs.chip(sample, 0); // memcpy?
+        TensorMap<Tensor<type, 2>> recurrent_hidden_deltas(long_short_term_memory_layer_back_propagation->recurrent_hidden_deltas.data(), next_sequences_number, neurons_number);
+        TensorMap<Tensor<type, 2>> next_cell_deltas(long_short_term_memory_layer_back_propagation->next_cell_deltas.data(), next_sequences_number, neurons_number);
 
-        back_propagation->current_layer_deltas = deltas.chip(sample,0); // memcpy?
+        const Eigen::array<Index, 2> next_sequences_offsets({0, 0});
+        const Eigen::array<Index, 2> next_sequences_extents({next_sequences_number, neurons_number});
 
-        copy(forward_propagation->forget_activations.data() + copy_index,
-             forward_propagation->forget_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_forget_activations.data());
+        // Hidden states deltas, from the outputs and from the next timestep
 
-        copy(forward_propagation->forget_activations_derivatives.data() + copy_index,
-             forward_propagation->forget_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_forget_activations_derivatives.data());
+        hidden_deltas.device(*thread_pool_device)
+                = deltas.slice(Eigen::array<Index, 2>({step, 0}), Eigen::array<Index, 2>({samples_number - step, neurons_number}))
+                        .stride(rows_strides);
 
-        copy(forward_propagation->input_activations.data() + copy_index,
-             forward_propagation->input_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_input_activations.data());
+        if(next_sequences_number > 0)
+            hidden_deltas.slice(next_sequences_offsets, next_sequences_extents).device(*thread_pool_device) += recurrent_hidden_deltas;
 
-        copy(forward_propagation->input_activations_derivatives.data() + copy_index,
-             forward_propagation->input_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_input_activations_derivatives.data());
+        // Cell states deltas, from the hidden states and from the next timestep
 
-        copy(forward_propagation->state_activations.data() + copy_index,
-             forward_propagation->state_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_state_activations.data());
+        cell_deltas.device(*thread_pool_device) = hidden_deltas*output_activations*cell_states_activations_derivatives;
 
-        copy(forward_propagation->state_activations_derivatives.data() + copy_index,
-             forward_propagation->state_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_state_activations_derivatives.data());
+        if(next_sequences_number > 0)
+            cell_deltas.slice(next_sequences_offsets, next_sequences_extents).device(*thread_pool_device) += next_cell_deltas;
 
-        copy(forward_propagation->output_activations.data() + copy_index,
-             forward_propagation->output_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_output_activations.data());
+        // Gates deltas
 
-        copy(forward_propagation->output_activations_derivatives.data() + copy_index,
-             forward_propagation->output_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_output_activations_derivatives.data());
+        output_deltas.device(*thread_pool_device) = hidden_deltas*cell_states_activations*output_activations_derivatives;
 
-        copy(forward_propagation->cell_states_activations.data() + copy_index,
-             forward_propagation->cell_states_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_cell_state_activations.data());
+        input_deltas.device(*thread_pool_device) = cell_deltas*state_activations*input_activations_derivatives;
 
-        copy(forward_propagation->hidden_states_activations_derivatives.data() + copy_index,
-             forward_propagation->hidden_states_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_hidden_states_derivatives.data());
+        state_deltas.device(*thread_pool_device) = cell_deltas*input_activations*state_activations_derivatives;
 
-        if(sample%timesteps == 0)
+        if(step > 0)
         {
-            forward_propagation->previous_cell_state_activations.setZero();
-
-            forget_combinations_weights_derivatives.setZero();
-            input_combinations_weights_derivatives.setZero();
-            output_combinations_weights_derivatives.setZero();
-            state_combinations_weights_derivatives.setZero();
+            const TensorMap<Tensor<type, 2>> previous_cell_states(long_short_term_memory_layer_forward_propagation->cell_states.data() + (sequences_offset - previous_sequences_number)*neurons_number,
+                                                                  previous_sequences_number, neurons_number);
 
-            cell_state_weights_derivatives.setZero();
-            hidden_states_weights_derivatives.setZero();
+            forget_deltas.device(*thread_pool_device)
+                    = cell_deltas
+                    *previous_cell_states.slice(Eigen::array<Index, 2>({0, 0}), Eigen::array<Index, 2>({sequences_number, neurons_number}))
+                    *forget_activations_derivatives;
         }
         else
         {
-            copy(forward_propagation->cell_states_activations.data() + (copy_index-neurons_number),
-                 forward_propagation->cell_states_activations.data() + (copy_index-neurons_number) + neurons_number,
-                 forward_propagation->previous_cell_state_activations.data());
-
-            forget_combinations_weights_derivatives = hidden_states_weights_derivatives.contract(forget_recurrent_weights, A_B);
-
-            multiply_rows(forget_combinations_weights_derivatives,
-                          forward_propagation->current_forget_activations_derivatives);
-
-            input_combinations_weights_derivatives = hidden_states_weights_derivatives.contract(input_recurrent_weights, A_B);
-
-            state_combinations_weights_derivatives = hidden_states_weights_derivatives.contract(state_recurrent_weights, A_B);
-
-            multiply_rows(state_combinations_weights_derivatives,
-                          forward_propagation->current_state_activations_derivatives);
-
-            output_combinations_weights_derivatives = hidden_states_weights_derivatives.contract(output_recurrent_weights, A_B);
-
-            multiply_rows(output_combinations_weights_derivatives,
-                          forward_propagation->current_output_activations_derivatives);
-        }
-
-        column_index = 0;
-        input_index = 0;
-
-        for(Index i = 0; i < parameters_number; i++)
-        {
-            input_combinations_weights_derivatives(i, column_index) += forward_propagation->current_inputs[input_index];
-
-            input_index++;
-
-            if(input_index == inputs_number)
-            {
-                input_index = 0;
-                column_index++;
-            }
+            forget_deltas.setZero();
         }
 
-        multiply_rows(cell_state_weights_derivatives,
-                      forward_propagation->current_forget_activations);
-
-        multiply_rows(forget_combinations_weights_derivatives,
-                      forward_propagation->previous_cell_state_activations);
+        combinations_deltas.slice(Eigen::array<Index, 2>({step, 0}), Eigen::array<Index, 2>({samples_number - step, 4*neurons_number}))
+                           .stride(rows_strides).device(*thread_pool_device) = gates_deltas;
 
-        cell_state_weights_derivatives += forget_combinations_weights_derivatives;
+        // Recurrent weights derivatives and deltas for the previous timestep
 
-        multiply_rows(state_combinations_weights_derivatives,
-                      forward_propagation->current_input_activations);
-
-        cell_state_weights_derivatives += state_combinations_weights_derivatives;
+        if(step > 0)
+        {
+            const TensorMap<Tensor<type, 2>> previous_hidden_states
+                    = get_previous_hidden_states(long_short_term_memory_layer_forward_propagation,
+                                                 sequences_offset - previous_sequences_number, previous_sequences_number, sequences_number);
 
-        multiply_rows(input_combinations_weights_derivatives,
-                      forward_propagation->current_input_activations_derivatives*forward_propagation->current_state_activations);
+            gates_recurrent_weights_derivatives.device(*thread_pool_device) += previous_hidden_states.contract(gates_deltas, AT_B);
 
-        cell_state_weights_derivatives += input_combinations_weights_derivatives;
+            TensorMap<Tensor<type, 2>> previous_recurrent_hidden_deltas(long_short_term_memory_layer_back_propagation->recurrent_hidden_deltas.data(), sequences_number, neurons_number);
+            TensorMap<Tensor<type, 2>> previous_next_cell_deltas(long_short_term_memory_layer_back_propagation->next_cell_deltas.data(), sequences_number, neurons_number);
 
-        hidden_states_weights_derivatives = cell_state_weights_derivatives;
+            previous_recurrent_hidden_deltas.device(*thread_pool_device) = gates_deltas.contract(gates_recurrent_weights, A_BT);
 
-        multiply_rows(hidden_states_weights_derivatives,
-                      forward_propagation->current_output_activations*forward_propagation->current_hidden_states_derivatives);
+            previous_next_cell_deltas.device(*thread_pool_device) = cell_deltas*forget_activations;
+        }
 
-        multiply_rows(output_combinations_weights_derivatives,
-                      calculate_activations(forward_propagation->current_cell_state_activations));
+        next_sequences_number = sequences_number;
+    }
 
-        hidden_states_weights_derivatives += output_combinations_weights_derivatives;
+    // Biases and weights derivatives for the whole batch
 
-        back_propagation->input_weights_derivatives
-                += hidden_states_weights_derivatives.contract(back_propagation->current_layer_deltas, A_B);
+    long_short_term_memory_layer_back_propagation->gates_biases_derivatives.device(*thread_pool_device)
+            = combinations_deltas.sum(Eigen::array<Index, 1>({0}));
 
-        copy_index += neurons_number;
-    }
-}
-
-
-void LongShortTermMemoryLayer::calculate_state_weights_error_gradient(const Tensor<type, 2>& inputs,
-                                                                      LongShortTermMemoryLayerForwardPropagation* forward_propagation,
-                                                                      LongShortTermMemoryLayerBackPropagation* back_propagation) const
-{
-    const Index samples_number = inputs.dimension(0);
-    const Index inputs_number = get_inputs_number();
-    const Index neurons_number = get_neurons_number();
-    const Index parameters_number = inputs_number*neurons_number;
-
-    TensorMap<Tensor<type, 2>> deltas(back_propagation->deltas_data, back_propagation->deltas_dimensions(0), back_propagation->deltas_dimensions(1));
-
-    Tensor<type, 2> input_combinations_weights_derivatives(parameters_number, neurons_number);
-    Tensor<type, 2> forget_combinations_weights_derivatives(parameters_number, neurons_number);
-    Tensor<type, 2> state_combinations_weights_derivatives(parameters_number, neurons_number);
-    Tensor<type, 2> output_combinations_weights_derivatives(parameters_number, neurons_number);
-
-    Tensor<type, 2> hidden_states_weights_derivatives(parameters_number, neurons_number);
-    Tensor<type, 2> cell_state_weights_derivatives(parameters_number, neurons_number);
-
-    input_combinations_weights_derivatives.setZero();
-    forget_combinations_weights_derivatives.setZero();
-    state_combinations_weights_derivatives.setZero();
-    output_combinations_weights_derivatives.setZero();
-    hidden_states_weights_derivatives.setZero();
-    cell_state_weights_derivatives.setZero();
-
-    Index column_index = 0;
-    Index input_index = 0;
-
-    Index copy_index = 0;
-
-    back_propagation->state_weights_derivatives.setZero();
-
-    #pragma omp for
-    for(Index sample = 0; sample < samples_number; sample++)
-    {
-        forward_propagation->current_inputs = inputs.chip(sample, 0); // memcpy?
-
-        back_propagation->current_layer_deltas = deltas.chip(sample,0); // memcpy?
-
-        copy(forward_propagation->forget_activations.data() + copy_index,
-             forward_propagation->forget_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_forget_activations.data());
-
-        copy(forward_propagation->forget_activations_derivatives.data() + copy_index,
-             forward_propagation->forget_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_forget_activations_derivatives.data());
-
-        copy(forward_propagation->input_activations.data() + copy_index,
-             forward_propagation->input_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_input_activations.data());
-
-        copy(forward_propagation->input_activations_derivatives.data() + copy_index,
-             forward_propagation->input_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_input_activations_derivatives.data());
-
-        copy(forward_propagation->state_activations.data() + copy_index,
-             forward_propagation->state_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_state_activations.data());
-
-        copy(forward_propagation->state_activations_derivatives.data() + copy_index,
-             forward_propagation->state_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_state_activations_derivatives.data());
-
-        copy(forward_propagation->output_activations.data() + copy_index,
-             forward_propagation->output_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_output_activations.data());
-
-        copy(forward_propagation->output_activations_derivatives.data() + copy_index,
-             forward_propagation->output_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_output_activations_derivatives.data());
-
-        copy(forward_propagation->cell_states_activations.data() + copy_index,
-             forward_propagation->cell_states_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_cell_state_activations.data());
-
-        copy(forward_propagation->hidden_states_activations_derivatives.data() + copy_index,
-             forward_propagation->hidden_states_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_hidden_states_derivatives.data());
-
-        if(sample%timesteps == 0)
-        {
-            forward_propagation->previous_cell_state_activations.setZero();
-
-            forget_combinations_weights_derivatives.setZero();
-            input_combinations_weights_derivatives.setZero();
-            output_combinations_weights_derivatives.setZero();
-            state_combinations_weights_derivatives.setZero();
-
-            cell_state_weights_derivatives.setZero();
-        }
-        else
-        {
-            copy(forward_propagation->cell_states_activations.data() + (copy_index - neurons_number),
-            forward_propagation->cell_states_activations.data() + (copy_index - neurons_number) + neurons_number,
-            forward_propagation->previous_cell_state_activations.data());
-
-            forget_combinations_weights_derivatives = hidden_states_weights_derivatives.contract(forget_recurrent_weights, A_B);
-            multiply_rows(forget_combinations_weights_derivatives, forward_propagation->current_forget_activations_derivatives);
-
-            input_combinations_weights_derivatives = hidden_states_weights_derivatives.contract(input_recurrent_weights, A_B);
-            multiply_rows(input_combinations_weights_derivatives, forward_propagation->current_input_activations_derivatives);
-
-            state_combinations_weights_derivatives = hidden_states_weights_derivatives.contract(state_recurrent_weights, A_B);
-
-            output_combinations_weights_derivatives = hidden_states_weights_derivatives.contract(output_recurrent_weights, A_B);
-            multiply_rows(output_combinations_weights_derivatives, forward_propagation->current_output_activations_derivatives);
-        }
-
-        column_index = 0;
-        input_index = 0;
-
-        for(Index i = 0; i < parameters_number; i++)
-        {
-            state_combinations_weights_derivatives(i, column_index) += forward_propagation->current_inputs[input_index];
-
-            input_index++;
-
-            if(input_index == inputs_number)
-            {
-                input_index = 0;
-                column_index++;
-            }
-        }
-
-        multiply_rows(cell_state_weights_derivatives, forward_propagation->current_forget_activations);
-        multiply_rows(forget_combinations_weights_derivatives, forward_propagation->previous_cell_state_activations);
-        cell_state_weights_derivatives += forget_combinations_weights_derivatives;
-        multiply_rows(input_combinations_weights_derivatives, forward_propagation->current_state_activations);
-        cell_state_weights_derivatives += input_combinations_weights_derivatives;
-        multiply_rows(state_combinations_weights_derivatives, (forward_propagation->current_state_activations_derivatives*forward_propagation->current_input_activations));
-        cell_state_weights_derivatives += state_combinations_weights_derivatives;
-
-        hidden_states_weights_derivatives = cell_state_weights_derivatives;
-        multiply_rows(hidden_states_weights_derivatives, forward_propagation->current_output_activations*forward_propagation->current_hidden_states_derivatives);
-        multiply_rows(output_combinations_weights_derivatives, calculate_activations(forward_propagation->current_cell_state_activations));
-        hidden_states_weights_derivatives += output_combinations_weights_derivatives;
-
-        back_propagation->state_weights_derivatives += hidden_states_weights_derivatives.contract(back_propagation->current_layer_deltas, A_B);
-
-        copy_index += neurons_number;
-    }
-}
-
-
-void LongShortTermMemoryLayer::calculate_output_weights_error_gradient(const Tensor<type, 2>& inputs,
-                                                                       LongShortTermMemoryLayerForwardPropagation* forward_propagation,
-                                                                       LongShortTermMemoryLayerBackPropagation* back_propagation) const
-{
-    const Index samples_number = inputs.dimension(0);
-    const Index inputs_number = get_inputs_number();
-    const Index neurons_number = get_neurons_number();
-    const Index parameters_number = inputs_number*neurons_number;
-
-    const TensorMap<Tensor<type, 2>> deltas(back_propagation->deltas_data, back_propagation->deltas_dimensions(0), back_propagation->deltas_dimensions(1));
-
-    Tensor<type, 2> input_combinations_weights_derivatives(parameters_number, neurons_number);
-    Tensor<type, 2> forget_combinations_weights_derivatives(parameters_number, neurons_number);
-    Tensor<type, 2> state_combinations_weights_derivatives(parameters_number, neurons_number);
-    Tensor<type, 2> output_combinations_weights_derivatives(parameters_number, neurons_number);
-
-    Tensor<type, 2> hidden_states_weights_derivatives(parameters_number, neurons_number);
-    Tensor<type, 2> cell_state_weights_derivatives(parameters_number, neurons_number);
-
-    input_combinations_weights_derivatives.setZero();
-    forget_combinations_weights_derivatives.setZero();
-    state_combinations_weights_derivatives.setZero();
-    output_combinations_weights_derivatives.setZero();
-    hidden_states_weights_derivatives.setZero();
-    cell_state_weights_derivatives.setZero();
-
-    Index column_index = 0;
-    Index input_index = 0;
-
-    Index copy_index = 0;
-
-    back_propagation->output_weights_derivatives.setZero();
-
-    #pragma omp for
-    for(Index sample = 0; sample < samples_number; sample++)
-    {
-        forward_propagation->current_inputs = inputs.chip(sample, 0); // memcpy?
-
-        back_propagation->current_layer_deltas = deltas.chip(sample,0); // memcpy?
-
-        copy(forward_propagation->forget_activations.data() + copy_index,
-             forward_propagation->forget_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_forget_activations.data());
-
-        copy(forward_propagation->forget_activations_derivatives.data() + copy_index,
-             forward_propagation->forget_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_forget_activations_derivatives.data());
-
-        copy(forward_propagation->input_activations.data() + copy_index,
-             forward_propagation->input_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_input_activations.data());
-
-        copy(forward_propagation->input_activations_derivatives.data() + copy_index,
-             forward_propagation->input_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_input_activations_derivatives.data());
-
-        copy(forward_propagation->state_activations.data() + copy_index,
-             forward_propagation->state_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_state_activations.data());
-
-        copy(forward_propagation->state_activations_derivatives.data() + copy_index,
-             forward_propagation->state_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_state_activations_derivatives.data());
-
-        copy(forward_propagation->output_activations.data() + copy_index,
-             forward_propagation->output_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_output_activations.data());
-
-        copy(forward_propagation->output_activations_derivatives.data() + copy_index,
-             forward_propagation->output_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_output_activations_derivatives.data());
-
-        copy(forward_propagation->cell_states_activations.data() + copy_index,
-             forward_propagation->cell_states_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_cell_state_activations.data());
-
-        copy(forward_propagation->hidden_states_activations_derivatives.data() + copy_index,
-             forward_propagation->hidden_states_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_hidden_states_derivatives.data());
-
-        if(sample%timesteps == 0)
-        {
-            forward_propagation->previous_cell_state_activations.setZero();
-
-            forget_combinations_weights_derivatives.setZero();
-            input_combinations_weights_derivatives.setZero();
-            output_combinations_weights_derivatives.setZero();
-            state_combinations_weights_derivatives.setZero();
-
-            cell_state_weights_derivatives.setZero();
-        }
-        else
-        {
-            copy(forward_propagation->cell_states_activations.data() + (copy_index-neurons_number),
-                 forward_propagation->cell_states_activations.data() + (copy_index-neurons_number) + neurons_number,
-                 forward_propagation->previous_cell_state_activations.data());
-
-            forget_combinations_weights_derivatives = hidden_states_weights_derivatives.contract(forget_recurrent_weights, A_B);
-            multiply_rows(forget_combinations_weights_derivatives, forward_propagation->current_forget_activations_derivatives);
-            input_combinations_weights_derivatives = hidden_states_weights_derivatives.contract(input_recurrent_weights, A_B);
-            multiply_rows(input_combinations_weights_derivatives, forward_propagation->current_input_activations_derivatives);
-            state_combinations_weights_derivatives = hidden_states_weights_derivatives.contract(state_recurrent_weights, A_B);
-            multiply_rows(state_combinations_weights_derivatives, forward_propagation->current_state_activations_derivatives);
-            output_combinations_weights_derivatives = hidden_states_weights_derivatives.contract(output_recurrent_weights, A_B);
-        }
-
-        column_index = 0;
-        input_index = 0;
-
-        for(Index i = 0; i < parameters_number; i++)
-        {
-            output_combinations_weights_derivatives(i, column_index) += forward_propagation->current_inputs[input_index];
-
-            input_index++;
-
-            if(input_index == inputs_number)
-            {
-                input_index = 0;
-                column_index++;
-            }
-        }
-
-        multiply_rows(cell_state_weights_derivatives, forward_propagation->current_forget_activations);
-        multiply_rows(forget_combinations_weights_derivatives, forward_propagation->previous_cell_state_activations);
-        cell_state_weights_derivatives += forget_combinations_weights_derivatives;
-        multiply_rows(state_combinations_weights_derivatives, forward_propagation->current_input_activations);
-        cell_state_weights_derivatives += state_combinations_weights_derivatives;
-        multiply_rows(input_combinations_weights_derivatives, forward_propagation->current_state_activations);
-        cell_state_weights_derivatives += input_combinations_weights_derivatives;
-
-         hidden_states_weights_derivatives = cell_state_weights_derivatives;
-         multiply_rows(hidden_states_weights_derivatives, forward_propagation->current_output_activations*forward_propagation->current_hidden_states_derivatives);
-         multiply_rows(output_combinations_weights_derivatives, forward_propagation->current_output_activations_derivatives*calculate_activations(forward_propagation->current_cell_state_activations));
-        hidden_states_weights_derivatives += output_combinations_weights_derivatives;
-
-        back_propagation->output_weights_derivatives += hidden_states_weights_derivatives.contract(back_propagation->current_layer_deltas, A_B);
-
-        copy_index += neurons_number;
-    }
-}
-
-
-void LongShortTermMemoryLayer::calculate_forget_recurrent_weights_error_gradient(const Tensor<type, 2>& inputs,
-                                                                                 LongShortTermMemoryLayerForwardPropagation* forward_propagation,
-                                                                                 LongShortTermMemoryLayerBackPropagation* back_propagation) const
-{
-    const Index samples_number = inputs.dimension(0);
-    const Index neurons_number = get_neurons_number();
-    const Index parameters_number = neurons_number*neurons_number;
-
-    const TensorMap<Tensor<type, 2>> deltas(back_propagation->deltas_data, back_propagation->deltas_dimensions(0), back_propagation->deltas_dimensions(1));
-
-    Tensor<type, 1> forget_recurrent_weights_error_gradient(parameters_number);
-    forget_recurrent_weights_error_gradient.setZero();
-
-    Tensor<type, 2> input_combinations_recurrent_weights_derivatives(parameters_number, neurons_number);
-    Tensor<type, 2> forget_combinations_recurrent_weights_derivatives(parameters_number, neurons_number);
-    Tensor<type, 2> state_combinations_recurrent_weights_derivatives(parameters_number, neurons_number);
-    Tensor<type, 2> output_combinations_recurrent_weights_derivatives(parameters_number, neurons_number);
-
-    Tensor<type, 2> hidden_states_recurrent_weights_derivatives(parameters_number, neurons_number);
-    Tensor<type, 2> cell_state_recurrent_weights_derivatives(parameters_number, neurons_number);
-
-    Index column_index = 0;
-    Index activation_index = 0;
-
-    Index copy_index = 0;
-
-    back_propagation->forget_recurrent_weights_derivatives.setZero();
-
-    for(Index sample = 0; sample < samples_number; sample++)
-    {
-        back_propagation->current_layer_deltas = deltas.chip(sample, 0);
-
-        copy(forward_propagation->forget_activations.data() + copy_index,
-             forward_propagation->forget_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_forget_activations.data());
-
-        copy(forward_propagation->forget_activations_derivatives.data() + copy_index,
-             forward_propagation->forget_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_forget_activations_derivatives.data());
-
-        copy(forward_propagation->input_activations.data() + copy_index,
-             forward_propagation->input_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_input_activations.data());
-
-        copy(forward_propagation->input_activations_derivatives.data() + copy_index,
-             forward_propagation->input_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_input_activations_derivatives.data());
-
-        copy(forward_propagation->state_activations.data() + copy_index,
-             forward_propagation->state_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_state_activations.data());
-
-        copy(forward_propagation->state_activations_derivatives.data() + copy_index,
-             forward_propagation->state_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_state_activations_derivatives.data());
-
-        copy(forward_propagation->output_activations.data() + copy_index,
-             forward_propagation->output_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_output_activations.data());
-
-        copy(forward_propagation->output_activations_derivatives.data() + copy_index,
-             forward_propagation->output_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_output_activations_derivatives.data());
-
-        copy(forward_propagation->cell_states_activations.data() + copy_index,
-             forward_propagation->cell_states_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_cell_state_activations.data());
-
-        copy(forward_propagation->hidden_states_activations_derivatives.data() + copy_index,
-             forward_propagation->hidden_states_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_hidden_states_derivatives.data());
-
-        if(sample%timesteps == 0)
-        {
-            cell_state_recurrent_weights_derivatives.setZero();
-            hidden_states_recurrent_weights_derivatives.setZero();
-        }
-        else
-        {
-            copy(forward_propagation->hidden_states_activations.data() + (copy_index-neurons_number),
-                 forward_propagation->hidden_states_activations.data() + (copy_index-neurons_number) + neurons_number,
-                 forward_propagation->previous_hidden_state_activations.data());
-
-            copy(forward_propagation->cell_states_activations.data() + (copy_index-neurons_number),
-                 forward_propagation->cell_states_activations.data() + (copy_index-neurons_number) + neurons_number,
-                 forward_propagation->previous_cell_state_activations.data());
-
-            forget_combinations_recurrent_weights_derivatives = hidden_states_recurrent_weights_derivatives.contract(forget_recurrent_weights, A_B);
-            input_combinations_recurrent_weights_derivatives = hidden_states_recurrent_weights_derivatives.contract(input_recurrent_weights, A_B);
-            multiply_rows(input_combinations_recurrent_weights_derivatives, forward_propagation->current_input_activations_derivatives);
-            state_combinations_recurrent_weights_derivatives = hidden_states_recurrent_weights_derivatives.contract(state_recurrent_weights, A_B);
-            multiply_rows(state_combinations_recurrent_weights_derivatives, forward_propagation->current_state_activations_derivatives);
-            output_combinations_recurrent_weights_derivatives = hidden_states_recurrent_weights_derivatives.contract(output_recurrent_weights, A_B);
-            multiply_rows(output_combinations_recurrent_weights_derivatives, forward_propagation->current_output_activations_derivatives);
-
-            column_index = 0;
-            activation_index = 0;
-
-            for(Index i = 0; i < parameters_number; i++)
-            {
-                forget_combinations_recurrent_weights_derivatives(i, column_index) += forward_propagation->previous_hidden_state_activations[activation_index];
-
-                activation_index++;
-
-                if(activation_index == neurons_number)
-                {
-                    activation_index = 0;
-                    column_index++;
-                }
-            }
-
-            multiply_rows(cell_state_recurrent_weights_derivatives, forward_propagation->current_forget_activations);
-            multiply_rows(input_combinations_recurrent_weights_derivatives, forward_propagation->current_state_activations);
-            cell_state_recurrent_weights_derivatives += input_combinations_recurrent_weights_derivatives;
-            multiply_rows(state_combinations_recurrent_weights_derivatives, forward_propagation->current_input_activations);
-            cell_state_recurrent_weights_derivatives += state_combinations_recurrent_weights_derivatives;
-            multiply_rows(forget_combinations_recurrent_weights_derivatives, (forward_propagation->current_forget_activations_derivatives*forward_propagation->previous_cell_state_activations));
-            cell_state_recurrent_weights_derivatives += forget_combinations_recurrent_weights_derivatives;
-
-            hidden_states_recurrent_weights_derivatives = cell_state_recurrent_weights_derivatives;
-            multiply_rows(hidden_states_recurrent_weights_derivatives, forward_propagation->current_output_activations*forward_propagation->current_hidden_states_derivatives);
-            multiply_rows(output_combinations_recurrent_weights_derivatives, calculate_activations(forward_propagation->current_cell_state_activations));
-            hidden_states_recurrent_weights_derivatives += output_combinations_recurrent_weights_derivatives;
-        }
-
-        back_propagation->forget_recurrent_weights_derivatives += hidden_states_recurrent_weights_derivatives.contract(back_propagation->current_layer_deltas, A_B);
-
-        copy_index += neurons_number;
-    }
-}
-
-
-void LongShortTermMemoryLayer::calculate_input_recurrent_weights_error_gradient(const Tensor<type, 2>& inputs,
-                                                                                LongShortTermMemoryLayerForwardPropagation* forward_propagation,
-                                                                                LongShortTermMemoryLayerBackPropagation* back_propagation) const
-{
-    const Index samples_number = inputs.dimension(0);
-    const Index neurons_number = get_neurons_number();
-    const Index parameters_number = neurons_number*neurons_number;
-
-    const TensorMap<Tensor<type, 2>> deltas(back_propagation->deltas_data, back_propagation->deltas_dimensions(0), back_propagation->deltas_dimensions(1));
-
-    Tensor<type, 1> forget_recurrent_weights_error_gradient(parameters_number);
-    forget_recurrent_weights_error_gradient.setZero();
-
-    Tensor<type, 2> input_combinations_recurrent_weights_derivatives(parameters_number, neurons_number);
-    Tensor<type, 2> forget_combinations_recurrent_weights_derivatives(parameters_number, neurons_number);
-    Tensor<type, 2> state_combinations_recurrent_weights_derivatives(parameters_number, neurons_number);
-    Tensor<type, 2> output_combinations_recurrent_weights_derivatives(parameters_number, neurons_number);
-
-    Tensor<type, 2> hidden_states_recurrent_weights_derivatives(parameters_number, neurons_number);
-    Tensor<type, 2> cell_state_recurrent_weights_derivatives(parameters_number, neurons_number);
-
-    Index column_index = 0;
-    Index activation_index = 0;
-
-    Index copy_index = 0;
-
-    back_propagation->input_recurrent_weights_derivatives.setZero();
-
-    #pragma omp for
-    for(Index sample = 0; sample < samples_number; sample++)
-    {
-        back_propagation->current_layer_deltas = deltas.chip(sample, 0);
-
-        copy(forward_propagation->forget_activations.data() + copy_index,
-             forward_propagation->forget_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_forget_activations.data());
-
-        copy(forward_propagation->forget_activations_derivatives.data() + copy_index,
-             forward_propagation->forget_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_forget_activations_derivatives.data());
-
-        copy(forward_propagation->input_activations.data() + copy_index,
-             forward_propagation->input_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_input_activations.data());
-
-        copy(forward_propagation->input_activations_derivatives.data() + copy_index,
-             forward_propagation->input_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_input_activations_derivatives.data());
-
-        copy(forward_propagation->state_activations.data() + copy_index,
-             forward_propagation->state_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_state_activations.data());
-
-        copy(forward_propagation->state_activations_derivatives.data() + copy_index,
-             forward_propagation->state_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_state_activations_derivatives.data());
-
-        copy(forward_propagation->output_activations.data() + copy_index,
-             forward_propagation->output_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_output_activations.data());
-
-        copy(forward_propagation->output_activations_derivatives.data() + copy_index,
-             forward_propagation->output_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_output_activations_derivatives.data());
-
-        copy(forward_propagation->cell_states_activations.data() + copy_index,
-             forward_propagation->cell_states_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_cell_state_activations.data());
-
-        copy(forward_propagation->hidden_states_activations_derivatives.data() + copy_index,
-             forward_propagation->hidden_states_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_hidden_states_derivatives.data());
-
-        if(sample%timesteps == 0)
-        {
-            cell_state_recurrent_weights_derivatives.setZero();
-            hidden_states_recurrent_weights_derivatives.setZero();
-        }
-        else
-        {
-            copy(forward_propagation->hidden_states_activations.data() + (copy_index-neurons_number),
-                 forward_propagation->hidden_states_activations.data() + (copy_index-neurons_number) + neurons_number,
-                 forward_propagation->previous_hidden_state_activations.data());
-
-            copy(forward_propagation->cell_states_activations.data() + (copy_index-neurons_number),
-                 forward_propagation->cell_states_activations.data() + (copy_index-neurons_number) + neurons_number,
-                 forward_propagation->previous_cell_state_activations.data());
-
-            forget_combinations_recurrent_weights_derivatives = hidden_states_recurrent_weights_derivatives.contract(forget_recurrent_weights, A_B);
-            multiply_rows(forget_combinations_recurrent_weights_derivatives, forward_propagation->current_forget_activations_derivatives);
-            input_combinations_recurrent_weights_derivatives = hidden_states_recurrent_weights_derivatives.contract(input_recurrent_weights, A_B);
-            state_combinations_recurrent_weights_derivatives = hidden_states_recurrent_weights_derivatives.contract(state_recurrent_weights, A_B);
-            multiply_rows(state_combinations_recurrent_weights_derivatives, forward_propagation->current_state_activations_derivatives);
-            output_combinations_recurrent_weights_derivatives = hidden_states_recurrent_weights_derivatives.contract(output_recurrent_weights, A_B);
-            multiply_rows(output_combinations_recurrent_weights_derivatives, forward_propagation->current_output_activations_derivatives);
-
-            column_index = 0;
-            activation_index = 0;
-
-            for(Index i = 0; i < parameters_number; i++)
-            {
-                input_combinations_recurrent_weights_derivatives(i, column_index) += forward_propagation->previous_hidden_state_activations[activation_index];
-
-                activation_index++;
-
-                if(activation_index == neurons_number)
-                {
-                    activation_index = 0;
-                    column_index++;
-                }
-            }
-
-            multiply_rows(cell_state_recurrent_weights_derivatives, forward_propagation->current_forget_activations);
-            multiply_rows(input_combinations_recurrent_weights_derivatives, forward_propagation->current_input_activations_derivatives*forward_propagation->current_state_activations);
-            cell_state_recurrent_weights_derivatives += input_combinations_recurrent_weights_derivatives;
-            multiply_rows(state_combinations_recurrent_weights_derivatives, forward_propagation->current_input_activations);
-            cell_state_recurrent_weights_derivatives += state_combinations_recurrent_weights_derivatives;
-            multiply_rows(forget_combinations_recurrent_weights_derivatives, forward_propagation->previous_cell_state_activations);
-            cell_state_recurrent_weights_derivatives += forget_combinations_recurrent_weights_derivatives;
-
-            hidden_states_recurrent_weights_derivatives = cell_state_recurrent_weights_derivatives;
-            multiply_rows(hidden_states_recurrent_weights_derivatives, forward_propagation->current_output_activations*forward_propagation->current_hidden_states_derivatives);
-            multiply_rows(output_combinations_recurrent_weights_derivatives, calculate_activations(forward_propagation->current_cell_state_activations));
-            hidden_states_recurrent_weights_derivatives += output_combinations_recurrent_weights_derivatives;
-        }
-
-        back_propagation->input_recurrent_weights_derivatives += hidden_states_recurrent_weights_derivatives.contract(back_propagation->current_layer_deltas, A_B);
-
-        copy_index += neurons_number;
-    }
-}
-
-
-void LongShortTermMemoryLayer::calculate_state_recurrent_weights_error_gradient(const Tensor<type, 2>& inputs,
-                                                                                LongShortTermMemoryLayerForwardPropagation* forward_propagation,
-                                                                                LongShortTermMemoryLayerBackPropagation* back_propagation) const
-{
-    const Index samples_number = inputs.dimension(0);
-    const Index neurons_number = get_neurons_number();
-    const Index parameters_number = neurons_number*neurons_number;
-
-    const TensorMap<Tensor<type, 2>> deltas(back_propagation->deltas_data, back_propagation->deltas_dimensions(0), back_propagation->deltas_dimensions(1));
-
-    Tensor<type, 1> forget_recurrent_weights_error_gradient(parameters_number);
-    forget_recurrent_weights_error_gradient.setZero();
-
-    Index column_index = 0;
-    Index activation_index = 0;
-
-    Index copy_index = 0;
-
-    back_propagation->state_recurrent_weights_derivatives.setZero();
-
-    #pragma omp for
-    for(Index sample = 0; sample < samples_number; sample++)
-    {
-        back_propagation->current_layer_deltas = deltas.chip(sample, 0);
-
-        copy(forward_propagation->forget_activations.data() + copy_index,
-             forward_propagation->forget_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_forget_activations.data());
-
-        copy(forward_propagation->forget_activations_derivatives.data() + copy_index,
-             forward_propagation->forget_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_forget_activations_derivatives.data());
-
-        copy(forward_propagation->input_activations.data() + copy_index,
-             forward_propagation->input_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_input_activations.data());
-
-        copy(forward_propagation->input_activations_derivatives.data() + copy_index,
-             forward_propagation->input_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_input_activations_derivatives.data());
-
-        copy(forward_propagation->state_activations.data() + copy_index,
-             forward_propagation->state_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_state_activations.data());
-
-        copy(forward_propagation->state_activations_derivatives.data() + copy_index,
-             forward_propagation->state_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_state_activations_derivatives.data());
-
-        copy(forward_propagation->output_activations.data() + copy_index,
-             forward_propagation->output_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_output_activations.data());
-
-        copy(forward_propagation->output_activations_derivatives.data() + copy_index,
-             forward_propagation->output_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_output_activations_derivatives.data());
-
-        copy(forward_propagation->cell_states_activations.data() + copy_index,
-             forward_propagation->cell_states_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_cell_state_activations.data());
-
-        copy(forward_propagation->hidden_states_activations_derivatives.data() + copy_index,
-             forward_propagation->hidden_states_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_hidden_states_derivatives.data());
-
-        if(sample%timesteps == 0)
-        {
-            back_propagation->cell_state_recurrent_weights_derivatives.setZero();
-            back_propagation->hidden_states_recurrent_weights_derivatives.setZero();
-        }
-        else
-        {
-            copy(forward_propagation->hidden_states_activations.data() + (copy_index-neurons_number),
-                 forward_propagation->hidden_states_activations.data() + (copy_index-neurons_number) + neurons_number,
-                 forward_propagation->previous_hidden_state_activations.data());
-
-            copy(forward_propagation->cell_states_activations.data() + (copy_index-neurons_number),
-                 forward_propagation->cell_states_activations.data() + (copy_index-neurons_number) + neurons_number,
-                 forward_propagation->previous_cell_state_activations.data());
-
-            back_propagation->forget_combinations_recurrent_weights_derivatives = back_propagation->hidden_states_recurrent_weights_derivatives.contract(forget_recurrent_weights, A_B);
-            multiply_rows(back_propagation->forget_combinations_recurrent_weights_derivatives, forward_propagation->current_forget_activations_derivatives);
-            back_propagation->input_combinations_recurrent_weights_derivatives = back_propagation->hidden_states_recurrent_weights_derivatives.contract(input_recurrent_weights, A_B);
-            multiply_rows(back_propagation->input_combinations_recurrent_weights_derivatives, forward_propagation->current_input_activations_derivatives);
-            back_propagation->state_combinations_recurrent_weights_derivatives = back_propagation->hidden_states_recurrent_weights_derivatives.contract(state_recurrent_weights, A_B);
-            back_propagation->state_combinations_recurrent_weights_derivatives = back_propagation->hidden_states_recurrent_weights_derivatives.contract(output_recurrent_weights, A_B);
-            multiply_rows(back_propagation->state_combinations_recurrent_weights_derivatives, forward_propagation->current_output_activations_derivatives);
-
-            column_index = 0;
-            activation_index = 0;
-
-            for(Index i = 0; i < parameters_number; i++)
-            {
-                back_propagation->state_combinations_recurrent_weights_derivatives(i, column_index) += forward_propagation->previous_hidden_state_activations[activation_index];
-
-                activation_index++;
-
-                if(activation_index == neurons_number)
-                {
-                    activation_index = 0;
-                    column_index++;
-                }
-            }
-
-            multiply_rows(back_propagation->cell_state_recurrent_weights_derivatives, forward_propagation->current_forget_activations);
-            multiply_rows(back_propagation->input_combinations_recurrent_weights_derivatives, forward_propagation->current_state_activations);
-            back_propagation->cell_state_recurrent_weights_derivatives += back_propagation->input_combinations_recurrent_weights_derivatives;
-            multiply_rows(back_propagation->state_combinations_recurrent_weights_derivatives, forward_propagation->current_state_activations_derivatives*forward_propagation->current_input_activations);
-            back_propagation->cell_state_recurrent_weights_derivatives += back_propagation->state_combinations_recurrent_weights_derivatives;
-            multiply_rows(back_propagation->forget_combinations_recurrent_weights_derivatives, forward_propagation->previous_cell_state_activations);
-            back_propagation->cell_state_recurrent_weights_derivatives += back_propagation->forget_combinations_recurrent_weights_derivatives;
-
-            back_propagation->hidden_states_recurrent_weights_derivatives = back_propagation->cell_state_recurrent_weights_derivatives;
-            multiply_rows(back_propagation->hidden_states_recurrent_weights_derivatives, forward_propagation->current_output_activations*forward_propagation->current_hidden_states_derivatives);
-            multiply_rows(back_propagation->state_combinations_recurrent_weights_derivatives, calculate_activations(forward_propagation->current_cell_state_activations));
-            back_propagation->hidden_states_recurrent_weights_derivatives += back_propagation->state_combinations_recurrent_weights_derivatives;
-        }
-
-        back_propagation->state_recurrent_weights_derivatives += back_propagation->hidden_states_recurrent_weights_derivatives.contract(back_propagation->current_layer_deltas, A_B);
-
-        copy_index += neurons_number;
-    }
-}
-
-
-void LongShortTermMemoryLayer::calculate_output_recurrent_weights_error_gradient(const Tensor<type, 2>& inputs,
-                                                                                 LongShortTermMemoryLayerForwardPropagation* forward_propagation,
-                                                                                 LongShortTermMemoryLayerBackPropagation* back_propagation) const
-{
-    const Index samples_number = inputs.dimension(0);
-    const Index neurons_number = get_neurons_number();
-    const Index parameters_number = neurons_number*neurons_number;
-
-    const TensorMap<Tensor<type, 2>> deltas(back_propagation->deltas_data, back_propagation->deltas_dimensions(0), back_propagation->deltas_dimensions(1));
-
-
-    Index column_index = 0;
-    Index activation_index = 0;
-
-    Index copy_index = 0;
-
-    back_propagation->output_recurrent_weights_derivatives.setZero();
-
-    #pragma omp for
-    for(Index sample = 0; sample < samples_number; sample++)
-    {
-        back_propagation->current_layer_deltas = deltas.chip(sample, 0);
-
-        copy(forward_propagation->forget_activations.data() + copy_index,
-             forward_propagation->forget_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_forget_activations.data());
-
-        copy(forward_propagation->forget_activations_derivatives.data() + copy_index,
-             forward_propagation->forget_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_forget_activations_derivatives.data());
-
-        copy(forward_propagation->input_activations.data() + copy_index,
-             forward_propagation->input_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_input_activations.data());
-
-        copy(forward_propagation->input_activations_derivatives.data() + copy_index,
-             forward_propagation->input_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_input_activations_derivatives.data());
-
-        copy(forward_propagation->state_activations.data() + copy_index,
-             forward_propagation->state_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_state_activations.data());
-
-        copy(forward_propagation->state_activations_derivatives.data() + copy_index,
-             forward_propagation->state_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_state_activations_derivatives.data());
-
-        copy(forward_propagation->output_activations.data() + copy_index,
-             forward_propagation->output_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_output_activations.data());
-
-        copy(forward_propagation->output_activations_derivatives.data() + copy_index,
-             forward_propagation->output_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_output_activations_derivatives.data());
-
-        copy(forward_propagation->cell_states_activations.data() + copy_index,
-             forward_propagation->cell_states_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_cell_state_activations.data());
-
-        copy(forward_propagation->hidden_states_activations_derivatives.data() + copy_index,
-             forward_propagation->hidden_states_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_hidden_states_derivatives.data());
-
-        if(sample%timesteps == 0)
-        {
-            back_propagation->cell_state_recurrent_weights_derivatives.setZero();
-            back_propagation->hidden_states_recurrent_weights_derivatives.setZero();
-        }
-        else
-        {
-            copy(forward_propagation->hidden_states_activations.data() + (copy_index-neurons_number),
-                 forward_propagation->hidden_states_activations.data() + (copy_index-neurons_number) + neurons_number,
-                 forward_propagation->previous_hidden_state_activations.data());
-
-            copy(forward_propagation->cell_states_activations.data() + (copy_index-neurons_number),
-                 forward_propagation->cell_states_activations.data() + (copy_index-neurons_number) + neurons_number,
-                 forward_propagation->previous_cell_state_activations.data());
-
-            back_propagation->forget_combinations_recurrent_weights_derivatives = back_propagation->hidden_states_recurrent_weights_derivatives.contract(forget_recurrent_weights, A_B);
-            multiply_rows(back_propagation->forget_combinations_recurrent_weights_derivatives, forward_propagation->current_forget_activations_derivatives);
-            back_propagation->input_combinations_recurrent_weights_derivatives = back_propagation->hidden_states_recurrent_weights_derivatives.contract(input_recurrent_weights, A_B);
-            multiply_rows(back_propagation->input_combinations_recurrent_weights_derivatives, forward_propagation->current_input_activations_derivatives);
-            back_propagation->state_combinations_recurrent_weights_derivatives = back_propagation->hidden_states_recurrent_weights_derivatives.contract(state_recurrent_weights, A_B);
-            multiply_rows(back_propagation->state_combinations_recurrent_weights_derivatives, forward_propagation->current_state_activations_derivatives);
-            back_propagation->output_combinations_recurrent_weights_derivatives = back_propagation->hidden_states_recurrent_weights_derivatives.contract(output_recurrent_weights, A_B);
-
-            column_index = 0;
-            activation_index = 0;
-
-            for(Index i = 0; i < parameters_number; i++)
-            {
-                back_propagation->output_combinations_recurrent_weights_derivatives(i, column_index) += forward_propagation->previous_hidden_state_activations[activation_index];
-
-                activation_index++;
-
-                if(activation_index == neurons_number)
-                {
-                    activation_index = 0;
-                    column_index++;
-                }
-            }
-
-            multiply_rows(back_propagation->cell_state_recurrent_weights_derivatives, forward_propagation->current_forget_activations);
-            multiply_rows(back_propagation->input_combinations_recurrent_weights_derivatives, forward_propagation->current_state_activations);
-            back_propagation->cell_state_recurrent_weights_derivatives += back_propagation->input_combinations_recurrent_weights_derivatives;
-            multiply_rows(back_propagation->state_combinations_recurrent_weights_derivatives, forward_propagation->current_input_activations);
-            back_propagation->cell_state_recurrent_weights_derivatives += back_propagation->state_combinations_recurrent_weights_derivatives;
-            multiply_rows(back_propagation->forget_combinations_recurrent_weights_derivatives, forward_propagation->previous_cell_state_activations);
-            back_propagation->cell_state_recurrent_weights_derivatives += back_propagation->forget_combinations_recurrent_weights_derivatives;
-
-            back_propagation->hidden_states_recurrent_weights_derivatives = back_propagation->cell_state_recurrent_weights_derivatives;
-            multiply_rows(back_propagation->cell_state_recurrent_weights_derivatives, forward_propagation->current_output_activations*forward_propagation->current_hidden_states_derivatives);
-            multiply_rows(back_propagation->output_combinations_recurrent_weights_derivatives, forward_propagation->current_output_activations_derivatives*calculate_activations(forward_propagation->current_cell_state_activations));
-            back_propagation->hidden_states_recurrent_weights_derivatives += back_propagation->output_combinations_recurrent_weights_derivatives;
-        }
-
-        back_propagation->output_recurrent_weights_derivatives += back_propagation->hidden_states_recurrent_weights_derivatives.contract(back_propagation->current_layer_deltas, A_B);
-
-        copy_index += neurons_number;
-    }
-}
-
-
-void LongShortTermMemoryLayer::calculate_forget_biases_error_gradient(const Tensor<type, 2>& inputs,
-                                                                      LongShortTermMemoryLayerForwardPropagation* forward_propagation,
-                                                                      LongShortTermMemoryLayerBackPropagation* back_propagation) const
-{
-    const Index samples_number = inputs.dimension(0);
-    const Index neurons_number = get_neurons_number();
-    const Index parameters_number = neurons_number;
-
-    const TensorMap<Tensor<type, 2>> deltas(back_propagation->deltas_data, back_propagation->deltas_dimensions(0), back_propagation->deltas_dimensions(1));
-
-    back_propagation->input_combinations_biases_derivatives.setZero();
-    back_propagation->forget_combinations_biases_derivatives.setZero();
-    back_propagation->state_combinations_biases_derivatives.setZero();
-    back_propagation->output_combinations_biases_derivatives.setZero();
-
-    back_propagation->hidden_states_biases_derivatives.setZero();
-    back_propagation->cell_state_biases_derivatives.setZero();
-
-    Index copy_index = 0;
-
-    back_propagation->forget_biases_derivatives.setZero();
-
-    #pragma omp for
-    for(Index sample = 0; sample < samples_number; sample++)
-    {
-        const Tensor<type, 1> current_layer_deltas = deltas.chip(sample, 0);
-
-        copy(forward_propagation->forget_activations.data() + copy_index,
-             forward_propagation->forget_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_forget_activations.data());
-
-        copy(forward_propagation->forget_activations_derivatives.data() + copy_index,
-             forward_propagation->forget_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_forget_activations_derivatives.data());
-
-        copy(forward_propagation->input_activations.data() + copy_index,
-             forward_propagation->input_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_input_activations.data());
-
-        copy(forward_propagation->input_activations_derivatives.data() + copy_index,
-             forward_propagation->input_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_input_activations_derivatives.data());
-
-        copy(forward_propagation->state_activations.data() + copy_index,
-             forward_propagation->state_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_state_activations.data());
-
-        copy(forward_propagation->state_activations_derivatives.data() + copy_index,
-             forward_propagation->state_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_state_activations_derivatives.data());
-
-        copy(forward_propagation->output_activations.data() + copy_index,
-             forward_propagation->output_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_output_activations.data());
-
-        copy(forward_propagation->output_activations_derivatives.data() + copy_index,
-             forward_propagation->output_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_output_activations_derivatives.data());
-
-        copy(forward_propagation->cell_states_activations.data() + copy_index,
-             forward_propagation->cell_states_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_cell_state_activations.data());
-
-        copy(forward_propagation->hidden_states_activations_derivatives.data() + copy_index,
-             forward_propagation->hidden_states_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_hidden_states_derivatives.data());
-
-        if(sample%timesteps == 0)
-        {
-            back_propagation->forget_combinations_biases_derivatives.setZero();
-            back_propagation->input_combinations_biases_derivatives.setZero();
-            back_propagation->state_combinations_biases_derivatives.setZero();
-            back_propagation->output_combinations_biases_derivatives.setZero();
-
-            forward_propagation->previous_cell_state_activations.setZero();
-
-            back_propagation->cell_state_biases_derivatives.setZero();
-        }
-        else
-        {
-            copy(forward_propagation->cell_states_activations.data() + (copy_index-neurons_number),
-                 forward_propagation->cell_states_activations.data() + (copy_index-neurons_number) + neurons_number,
-                 forward_propagation->previous_cell_state_activations.data());
-
-            back_propagation->forget_combinations_biases_derivatives
-                    = back_propagation->hidden_states_biases_derivatives.contract(forget_recurrent_weights, A_B);
-
-            back_propagation->input_combinations_biases_derivatives
-                    = back_propagation->hidden_states_biases_derivatives.contract(input_recurrent_weights, A_B);
-
-            multiply_rows(back_propagation->input_combinations_biases_derivatives,
-                          forward_propagation->current_input_activations_derivatives);
-
-            back_propagation->state_combinations_biases_derivatives
-                    = back_propagation->hidden_states_biases_derivatives.contract(state_recurrent_weights, A_B);
-
-            multiply_rows(back_propagation->state_combinations_biases_derivatives,
-                          forward_propagation->current_state_activations_derivatives);
-
-            back_propagation->output_combinations_biases_derivatives
-                    = back_propagation->hidden_states_biases_derivatives.contract(output_recurrent_weights, A_B);
-
-            multiply_rows(back_propagation->output_combinations_biases_derivatives,
-                          forward_propagation->current_output_activations_derivatives);
-        }
-
-        for(Index row = 0; row < parameters_number; row++) back_propagation->forget_combinations_biases_derivatives(row, row) += static_cast<type>(1.0);
-
-        multiply_rows(back_propagation->cell_state_biases_derivatives,
-                      forward_propagation->current_forget_activations);
-
-        multiply_rows(back_propagation->input_combinations_biases_derivatives,
-                      forward_propagation->current_state_activations);
-
-        back_propagation->cell_state_biases_derivatives += back_propagation->input_combinations_biases_derivatives;
-
-        multiply_rows(back_propagation->state_combinations_biases_derivatives,
-                      forward_propagation->current_input_activations);
-
-        back_propagation->cell_state_biases_derivatives += back_propagation->state_combinations_biases_derivatives;
-
-        multiply_rows(back_propagation->forget_combinations_biases_derivatives,
-                      forward_propagation->current_forget_activations_derivatives*forward_propagation->previous_cell_state_activations);
-
-        back_propagation->cell_state_biases_derivatives += back_propagation->forget_combinations_biases_derivatives;
-
-        back_propagation->hidden_states_biases_derivatives = back_propagation->cell_state_biases_derivatives;
-
-        multiply_rows(back_propagation->hidden_states_biases_derivatives,
-                      forward_propagation->current_output_activations*forward_propagation->current_hidden_states_derivatives);
-
-        multiply_rows(back_propagation->output_combinations_biases_derivatives,
-                      calculate_activations(forward_propagation->current_cell_state_activations));
-
-        back_propagation->hidden_states_biases_derivatives += back_propagation->output_combinations_biases_derivatives;
-
-        back_propagation->forget_biases_derivatives += back_propagation->hidden_states_biases_derivatives.contract(current_layer_deltas, A_B);
-
-        copy_index += neurons_number;
-    }
-}
-
-
-void LongShortTermMemoryLayer::calculate_input_biases_error_gradient(const Tensor<type, 2>& inputs,
-                                                                     LongShortTermMemoryLayerForwardPropagation* forward_propagation,
-                                                                     LongShortTermMemoryLayerBackPropagation* back_propagation) const
-{
-    const Index samples_number = inputs.dimension(0);
-    const Index neurons_number = get_neurons_number();
-    const Index parameters_number = neurons_number;
-
-    const TensorMap<Tensor<type, 2>> deltas(back_propagation->deltas_data, back_propagation->deltas_dimensions(0), back_propagation->deltas_dimensions(1));
-
-    back_propagation->input_combinations_biases_derivatives.setZero();
-    back_propagation->forget_combinations_biases_derivatives.setZero();
-    back_propagation->state_combinations_biases_derivatives.setZero();
-    back_propagation->output_combinations_biases_derivatives.setZero();
-
-    back_propagation->hidden_states_biases_derivatives.setZero();
-    back_propagation->cell_state_biases_derivatives.setZero();
-
-    Tensor<type, 1> previous_cell_state_activations(neurons_number);
-
-    Index copy_index = 0;
-
-    back_propagation->input_biases_derivatives.setZero();
-
-    #pragma omp for
-    for(Index sample = 0; sample < samples_number; sample++)
-    {
-        back_propagation->current_layer_deltas = deltas.chip(sample, 0);
-
-        copy(forward_propagation->forget_activations.data() + copy_index,
-             forward_propagation->forget_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_forget_activations.data());
-
-        copy(forward_propagation->forget_activations_derivatives.data() + copy_index,
-             forward_propagation->forget_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_forget_activations_derivatives.data());
-
-        copy(forward_propagation->input_activations.data() + copy_index,
-             forward_propagation->input_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_input_activations.data());
-
-        copy(forward_propagation->input_activations_derivatives.data() + copy_index,
-             forward_propagation->input_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_input_activations_derivatives.data());
-
-        copy(forward_propagation->state_activations.data() + copy_index,
-             forward_propagation->state_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_state_activations.data());
-
-        copy(forward_propagation->state_activations_derivatives.data() + copy_index,
-             forward_propagation->state_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_state_activations_derivatives.data());
-
-        copy(forward_propagation->output_activations.data() + copy_index,
-             forward_propagation->output_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_output_activations.data());
-
-        copy(forward_propagation->output_activations_derivatives.data() + copy_index,
-             forward_propagation->output_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_output_activations_derivatives.data());
-
-        copy(forward_propagation->cell_states_activations.data() + copy_index,
-             forward_propagation->cell_states_activations.data() + copy_index + neurons_number,
-             forward_propagation->current_cell_state_activations.data());
-
-        copy(forward_propagation->hidden_states_activations_derivatives.data() + copy_index,
-             forward_propagation->hidden_states_activations_derivatives.data() + copy_index + neurons_number,
-             forward_propagation->current_hidden_states_derivatives.data());
-
-        if(sample%timesteps == 0)
-        {
-            back_propagation->forget_combinations_biases_derivatives.setZero();
-            back_propagation->input_combinations_biases_derivatives.setZero();
-            back_propagation->state_combinations_biases_derivatives.setZero();
-            back_propagation->output_combinations_biases_derivatives.setZero();
-
-            previous_cell_state_activations.setZero();
-            back_propagation->cell_state_biases_derivatives.setZero();
-        }
-        else
-        {
-            copy(forward_propagation->cell_states_activations.data() + (copy_index-neurons_number),
-                 forward_propagation->cell_states_activations.data() + (copy_index-neurons_number) + neurons_number,
-                 previous_cell_state_activations.data());
-
-            back_propagation->forget_combinations_biases_derivatives
-                    = back_propagation->hidden_states_biases_derivatives.contract(forget_recurrent_weights, A_B);
-
-            multiply_rows(back_propagation->forget_combinations_biases_derivatives,
-                          forward_propagation->current_forget_activations_derivatives);
-
-            back_propagation->input_combinations_biases_derivatives
-                    = back_propagation->hidden_states_biases_derivatives.contract(input_recurrent_weights, A_B);
-
-            back_propagation->state_combinations_biases_derivatives
-                    = back_propagation->hidden_states_biases_derivatives.contract(state_recurrent_weights, A_B);
-
-            multiply_rows(back_propagation->state_combinations_biases_derivatives,
-                          forward_propagation->current_state_activations_derivatives);
-
-            back_propagation->output_combinations_biases_derivatives
-                    = back_propagation->hidden_states_biases_derivatives.contract(output_recurrent_weights, A_B);
-
-            multiply_rows(back_propagation->output_combinations_biases_derivatives,
-                          forward_propagation->current_output_activations_derivatives);
-        }
-
-        for(Index row = 0; row < parameters_number; row++)
-            back_propagation->input_combinations_biases_derivatives(row, row) += static_cast<type>(1.0);
-
-        multiply_rows(back_propagation->cell_state_biases_derivatives,
-                      forward_propagation->current_forget_activations);
-
-        multiply_rows(back_propagation->forget_combinations_biases_derivatives, previous_cell_state_activations);
-
-        back_propagation->cell_state_biases_derivatives += back_propagation->forget_combinations_biases_derivatives;
-
-        multiply_rows(back_propagation->state_combinations_biases_derivatives,
-                      forward_propagation->current_input_activations);
-
-        back_propagation->cell_state_biases_derivatives += back_propagation->state_combinations_biases_derivatives;
-
-        multiply_rows(back_propagation->input_combinations_biases_derivatives,
-                      forward_propagation->current_input_activations_derivatives*forward_propagation->current_state_activations);
-
-        back_propagation->cell_state_biases_derivatives += back_propagation->input_combinations_biases_derivatives;
-
-        back_propagation->hidden_states_biases_derivatives = back_propagation->cell_state_biases_derivatives;
-
-        multiply_rows(back_propagation->hidden_states_biases_derivatives,
-                      forward_propagation->current_output_activations*forward_propagation->current_hidden_states_derivatives);
-
-        multiply_rows(back_propagation->output_combinations_biases_derivatives,
-                      calculate_activations(forward_propagation->current_cell_state_activations));
-
-        back_propagation->hidden_states_biases_derivatives += back_propagation->output_combinations_biases_derivatives;
-
-        back_propagation->input_biases_derivatives
-                += back_propagation->hidden_states_biases_derivatives.contract(back_propagation->current_layer_deltas, A_B);
-
-        copy_index += neurons_number;
-    }
-}
-
-
-void LongShortTermMemoryLayer::calculate_state_biases_error_gradient(const Tensor<type, 2>& inputs,
-                                                                     LongShortTermMemoryLayerForwardPropagation* forward_propagation,
-                                                                     LongShortTermMemoryLayerBackPropagation* back_propagation) const
-{
-    const Index samples_number = inputs.dimension(0);
-    const Index neurons_number = get_neurons_number();
-    const Index parameters_number = neurons_number;
-
-    const TensorMap<Tensor<type, 2>> deltas(back_propagation->deltas_data, back_propagation->deltas_dimensions(0), back_propagation->deltas_dimensions(1));
-
-    back_propagation->input_combinations_biases_derivatives.setZero();
-    back_propagation->forget_combinations_biases_derivatives.setZero();
-    back_propagation->state_combinations_biases_derivatives.setZero();
-    back_propagation->output_combinations_biases_derivatives.setZero();
-
-    back_propagation->hidden_states_biases_derivatives.setZero();
-    back_propagation->cell_state_biases_derivatives.setZero();
-
-    Index copy_index = 0;
-
-    back_propagation->state_biases_derivatives.setZero();
-
-    #pragma omp for
-    for(Index sample = 0; sample < samples_number; sample++)
-    {
-        const Tensor<type, 1> current_layer_deltas = deltas.chip(sample, 0);
-
-        memcpy(forward_propagation->current_forget_activations.data(),
-               forward_propagation->forget_activations.data()+copy_index,
-               static_cast<size_t>(neurons_number)*sizeof(type));
-
-        memcpy(forward_propagation->current_forget_activations_derivatives.data(),
-               forward_propagation->forget_activations_derivatives.data()+copy_index,
-               static_cast<size_t>(neurons_number)*sizeof(type));
-
-        memcpy(forward_propagation->current_input_activations.data(),
-               forward_propagation->input_activations.data()+copy_index,
-               static_cast<size_t>(neurons_number)*sizeof(type));
-
-        memcpy(forward_propagation->current_input_activations_derivatives.data(),
-               forward_propagation->input_activations_derivatives.data()+copy_index,
-               static_cast<size_t>(neurons_number)*sizeof(type));
-
-        memcpy(forward_propagation->current_state_activations.data(),
-               forward_propagation->state_activations.data()+copy_index,
-               static_cast<size_t>(neurons_number)*sizeof(type));
-
-        memcpy(forward_propagation->current_state_activations_derivatives.data(),
-               forward_propagation->state_activations_derivatives.data()+copy_index,
-               static_cast<size_t>(neurons_number)*sizeof(type));
-
-        memcpy(forward_propagation->current_output_activations.data(),
-               forward_propagation->output_activations.data()+copy_index,
-               static_cast<size_t>(neurons_number)*sizeof(type));
-
-        memcpy(forward_propagation->current_output_activations_derivatives.data(),
-               forward_propagation->output_activations_derivatives.data()+copy_index,
-               static_cast<size_t>(neurons_number)*sizeof(type));
-
-        memcpy(forward_propagation->current_cell_state_activations.data(),
-               forward_propagation->cell_states_activations.data()+copy_index,
-               static_cast<size_t>(neurons_number)*sizeof(type));
-
-        memcpy(forward_propagation->current_hidden_states_derivatives.data(),
-               forward_propagation->hidden_states_activations_derivatives.data()+copy_index,
-               static_cast<size_t>(neurons_number)*sizeof(type));
-
-        if(sample%timesteps == 0)
-        {
-            back_propagation->forget_combinations_biases_derivatives.setZero();
-            back_propagation->input_combinations_biases_derivatives.setZero();
-            back_propagation->state_combinations_biases_derivatives.setZero();
-            back_propagation->output_combinations_biases_derivatives.setZero();
-
-            forward_propagation->previous_cell_state_activations.setZero();
-            back_propagation->cell_state_biases_derivatives.setZero();
-        }
-        else
-        {
-            memcpy(forward_propagation->previous_cell_state_activations.data(),
-                   forward_propagation->cell_states_activations.data() + (copy_index-neurons_number),
-                   static_cast<size_t>(neurons_number)*sizeof(type));
-
-            back_propagation->forget_combinations_biases_derivatives = back_propagation->hidden_states_biases_derivatives.contract(forget_recurrent_weights, A_B);
-
-            multiply_rows(back_propagation->forget_combinations_biases_derivatives,
-                          forward_propagation->current_forget_activations_derivatives);
-
-            back_propagation->input_combinations_biases_derivatives = back_propagation->hidden_states_biases_derivatives.contract(input_recurrent_weights, A_B);
-
-            multiply_rows(back_propagation->input_combinations_biases_derivatives,
-                          forward_propagation->current_input_activations_derivatives);
-
-            back_propagation->state_combinations_biases_derivatives = back_propagation->hidden_states_biases_derivatives.contract(state_recurrent_weights, A_B);
-
-            back_propagation->output_combinations_biases_derivatives = back_propagation->hidden_states_biases_derivatives.contract(output_recurrent_weights, A_B);
-
-            multiply_rows(back_propagation->output_combinations_biases_derivatives,
-                          forward_propagation->current_output_activations_derivatives);
-        }
-
-        for(Index row = 0; row < parameters_number; row++) back_propagation->state_combinations_biases_derivatives(row, row) += static_cast<type>(1.0);
-
-        multiply_rows(back_propagation->cell_state_biases_derivatives,
-                      forward_propagation->current_forget_activations);
-
-        multiply_rows(back_propagation->forget_combinations_biases_derivatives, forward_propagation->previous_cell_state_activations);
-
-        back_propagation->cell_state_biases_derivatives += back_propagation->forget_combinations_biases_derivatives;
-
-        multiply_rows(back_propagation->input_combinations_biases_derivatives,
-                      forward_propagation->current_state_activations);
-
-        back_propagation->cell_state_biases_derivatives += back_propagation->input_combinations_biases_derivatives;
-
-        multiply_rows(back_propagation->state_combinations_biases_derivatives,
-                      forward_propagation->current_state_activations_derivatives*forward_propagation->current_input_activations);
-
-        back_propagation->cell_state_biases_derivatives += back_propagation->state_combinations_biases_derivatives;
-
-        back_propagation->hidden_states_biases_derivatives = back_propagation->cell_state_biases_derivatives;
-
-        multiply_rows(back_propagation->hidden_states_biases_derivatives,
-                      forward_propagation->current_output_activations*forward_propagation->current_hidden_states_derivatives);
-
-        multiply_rows(back_propagation->output_combinations_biases_derivatives,
-                      calculate_activations(forward_propagation->current_cell_state_activations));
-
-        back_propagation->hidden_states_biases_derivatives += back_propagation->output_combinations_biases_derivatives;
-
-        back_propagation->state_biases_derivatives += back_propagation->hidden_states_biases_derivatives.contract(current_layer_deltas, A_B);
-
-        copy_index += neurons_number;
-    }
-}
-
-
-void LongShortTermMemoryLayer::calculate_output_biases_error_gradient(const Tensor<type, 2>& inputs,
-                                                                      LongShortTermMemoryLayerForwardPropagation* forward_propagation,
-                                                                      LongShortTermMemoryLayerBackPropagation* back_propagation) const
-{
-    const Index samples_number = inputs.dimension(0);
-    const Index neurons_number = get_neurons_number();
-    const Index parameters_number = neurons_number;
-
-    const TensorMap<Tensor<type, 2>> deltas(back_propagation->deltas_data, back_propagation->deltas_dimensions(0), back_propagation->deltas_dimensions(1));
-
-    back_propagation->input_combinations_biases_derivatives.setZero();
-    back_propagation->forget_combinations_biases_derivatives.setZero();
-    back_propagation->state_combinations_biases_derivatives.setZero();
-    back_propagation->output_combinations_biases_derivatives.setZero();
-    back_propagation->hidden_states_biases_derivatives.setZero();
-    back_propagation->cell_state_biases_derivatives.setZero();
-
-    Index copy_index = 0;
-
-    back_propagation->output_biases_derivatives.setZero();
-
-    #pragma omp for
-    for(Index sample = 0; sample < samples_number; sample++)
-    {
-        back_propagation->current_layer_deltas = deltas.chip(sample, 0);
-
-        memcpy(forward_propagation->current_forget_activations.data(),
-               forward_propagation->forget_activations.data()+copy_index,
-               static_cast<size_t>(neurons_number)*sizeof(type));
-
-        memcpy(forward_propagation->current_forget_activations_derivatives.data(),
-               forward_propagation->forget_activations_derivatives.data()+copy_index,
-               static_cast<size_t>(neurons_number)*sizeof(type));
-
-        memcpy(forward_propagation->current_input_activations.data(),
-               forward_propagation->input_activations.data()+copy_index,
-               static_cast<size_t>(neurons_number)*sizeof(type));
-
-        memcpy(forward_propagation->current_input_activations_derivatives.data(),
-               forward_propagation->input_activations_derivatives.data()+copy_index,
-               static_cast<size_t>(neurons_number)*sizeof(type));
-
-        memcpy(forward_propagation->current_state_activations.data(),
-               forward_propagation->state_activations.data()+copy_index,
-               static_cast<size_t>(neurons_number)*sizeof(type));
-
-        memcpy(forward_propagation->current_state_activations_derivatives.data(),
-               forward_propagation->state_activations_derivatives.data()+copy_index,
-               static_cast<size_t>(neurons_number)*sizeof(type));
-
-        memcpy(forward_propagation->current_output_activations.data(),
-               forward_propagation->output_activations.data()+copy_index,
-               static_cast<size_t>(neurons_number)*sizeof(type));
-
-        memcpy(forward_propagation->current_output_activations_derivatives.data(),
-               forward_propagation->output_activations_derivatives.data()+copy_index,
-               static_cast<size_t>(neurons_number)*sizeof(type));
-
-        memcpy(forward_propagation->current_cell_state_activations.data(),
-               forward_propagation->cell_states_activations.data()+copy_index,
-               static_cast<size_t>(neurons_number)*sizeof(type));
-
-        memcpy(forward_propagation->current_hidden_states_derivatives.data(),
-               forward_propagation->hidden_states_activations_derivatives.data()+copy_index,
-               static_cast<size_t>(neurons_number)*sizeof(type));
-
-        if(sample%timesteps == 0)
-        {
-            back_propagation->forget_combinations_biases_derivatives.setZero();
-            back_propagation->input_combinations_biases_derivatives.setZero();
-            back_propagation->state_combinations_biases_derivatives.setZero();
-            back_propagation->output_combinations_biases_derivatives.setZero();
-
-            forward_propagation->previous_cell_state_activations.setZero();
-            back_propagation->cell_state_biases_derivatives.setZero();
-        }
-        else
-        {
-            memcpy(forward_propagation->previous_cell_state_activations.data(),
-                   forward_propagation->cell_states_activations.data() + (copy_index-neurons_number),
-                   static_cast<size_t>(neurons_number)*sizeof(type));
-
-            back_propagation->forget_combinations_biases_derivatives = back_propagation->hidden_states_biases_derivatives.contract(forget_recurrent_weights, A_B);
-
-            multiply_rows(back_propagation->forget_combinations_biases_derivatives,
-                          forward_propagation->current_forget_activations_derivatives);
-
-            back_propagation->input_combinations_biases_derivatives = back_propagation->hidden_states_biases_derivatives.contract(input_recurrent_weights, A_B);
-
-            multiply_rows(back_propagation->input_combinations_biases_derivatives,
-                          forward_propagation->current_input_activations_derivatives);
-
-            back_propagation->state_combinations_biases_derivatives = back_propagation->hidden_states_biases_derivatives.contract(state_recurrent_weights, A_B);
-
-            multiply_rows(back_propagation->state_combinations_biases_derivatives,
-                          forward_propagation->current_state_activations_derivatives);
-
-            back_propagation->output_combinations_biases_derivatives = back_propagation->hidden_states_biases_derivatives.contract(output_recurrent_weights, A_B);
-        }
-
-        for(Index row = 0; row < parameters_number; row++) back_propagation->output_combinations_biases_derivatives(row, row) += static_cast<type>(1.0);
-
-        multiply_rows(back_propagation->cell_state_biases_derivatives,
-                      forward_propagation->current_forget_activations);
-
-        multiply_rows(back_propagation->forget_combinations_biases_derivatives, forward_propagation->previous_cell_state_activations);
-
-        back_propagation->cell_state_biases_derivatives += back_propagation->forget_combinations_biases_derivatives;
-
-        multiply_rows(back_propagation->state_combinations_biases_derivatives,
-                      forward_propagation->current_input_activations);
-
-        back_propagation->cell_state_biases_derivatives += back_propagation->state_combinations_biases_derivatives;
-
-        multiply_rows(back_propagation->input_combinations_biases_derivatives,
-                      forward_propagation->current_state_activations);
-
-        back_propagation->cell_state_biases_derivatives += back_propagation->input_combinations_biases_derivatives;
-
-        back_propagation->hidden_states_biases_derivatives = back_propagation->cell_state_biases_derivatives;
-
-        multiply_rows(back_propagation->hidden_states_biases_derivatives,
-                      forward_propagation->current_output_activations*forward_propagation->current_hidden_states_derivatives);
-
-        multiply_rows(back_propagation->output_combinations_biases_derivatives,
-                      forward_propagation->current_output_activations_derivatives*calculate_activations(forward_propagation->current_cell_state_activations));
-
-        back_propagation->hidden_states_biases_derivatives += back_propagation->output_combinations_biases_derivatives;
-
-        back_propagation->output_biases_derivatives += back_propagation->hidden_states_biases_derivatives.contract(back_propagation->current_layer_deltas, A_B);
-
-        copy_index += neurons_number;
-    }
+    long_short_term_memory_layer_back_propagation->gates_weights_derivatives.device(*thread_pool_device)
+            = inputs.contract(combinations_deltas, AT_B);
 }
 
 
@@ -4006,7 +2167,7 @@ string LongShortTermMemoryLayer::write_expression(const Tensor<string, 1>& input
         // Forget gate
         for(Index i = 0; i < neurons_number; i++)
         {
-            buffer << "forget_gate_" << to_string(i) << " = " << write_recurrent_activation_function_expression() << " (" << forget_biases[i] << " + ";
+            buffer << "forget_gate_" << to_string(i) << " = " << write_recurrent_activation_function_expression() << " (" << forget_biases(i) << " + ";
 
             for(Index j = 0; j < inputs_number; j++)
             {
@@ -4024,7 +2185,7 @@ string LongShortTermMemoryLayer::write_expression(const Tensor<string, 1>& input
        // Input gate
        for(Index i = 0; i < neurons_number; i++)
        {
-           buffer << "input_gate_" << to_string(i) << " = " << write_recurrent_activation_function_expression() << " (" << input_biases[i] << " + ";
+           buffer << "input_gate_" << to_string(i) << " = " << write_recurrent_activation_function_expression() << " (" << input_biases(i) << " + ";
 
            for(Index j = 0; j < inputs_number; j++)
            {
@@ -4043,7 +2204,7 @@ string LongShortTermMemoryLayer::write_expression(const Tensor<string, 1>& input
        // State gate
        for(Index i = 0; i < neurons_number; i++)
        {
-           buffer << "state_gate_" << to_string(i) << " = " << write_activation_function_expression() << " (" << state_biases[i] << " + ";
+           buffer << "state_gate_" << to_string(i) << " = " << write_activation_function_expression() << " (" << state_biases(i) << " + ";
 
            for(Index j = 0; j < inputs_number; j++)
            {
@@ -4062,7 +2223,7 @@ string LongShortTermMemoryLayer::write_expression(const Tensor<string, 1>& input
 
        for(Index i = 0; i < neurons_number; i++)
        {
-           buffer << "output_gate_" << to_string(i) << " = " << write_recurrent_activation_function_expression() << " (" << output_biases[i] << " + ";
+           buffer << "output_gate_" << to_string(i) << " = " << write_recurrent_activation_function_expression() << " (" << output_biases(i) << " + ";
 
            for(Index j = 0; j < inputs_number; j++)
            {
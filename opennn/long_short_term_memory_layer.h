@@ -52,6 +52,11 @@ public:
 
    explicit LongShortTermMemoryLayer(const Index&, const Index&);
 
+   // The parameters of the gates are views of the packed storage of the layer
+
+   LongShortTermMemoryLayer(const LongShortTermMemoryLayer&) = delete;
+
+   LongShortTermMemoryLayer& operator=(const LongShortTermMemoryLayer&) = delete;
 
    // Get methods
 
@@ -127,6 +132,8 @@ public:
    void set_state_recurrent_weights(const Tensor<type, 2>&);
    void set_output_recurrent_weights(const Tensor<type, 2>&);
 
+   void check_gate_dimensions(const Index&, const Index&, const Index&, const Index&) const;
+
    void set_parameters(const Tensor<type, 1>&, const Index& = 0) final;
 
    // Activation functions
@@ -219,59 +226,17 @@ public:
 
    void forward_propagate(const Tensor<DynamicTensor<type>, 1>&, Tensor<type, 1>&, LayerForwardPropagation*) final;
 
-   // Eror gradient
-
-   void insert_gradient(LayerBackPropagation*, const Index& , Tensor<type, 1>&) const final;
-
-   void calculate_error_gradient(type*, LayerForwardPropagation*, LayerBackPropagation*) const final;
-
-   void calculate_forget_weights_error_gradient(const Tensor<type, 2>&,
-                                                LongShortTermMemoryLayerForwardPropagation*,
-                                                LongShortTermMemoryLayerBackPropagation*) const;
-
-   void calculate_input_weights_error_gradient(const Tensor<type, 2>&,
-                                               LongShortTermMemoryLayerForwardPropagation*,
-                                               LongShortTermMemoryLayerBackPropagation*) const;
-
-   void calculate_state_weights_error_gradient(const Tensor<type, 2>&,
-                                               LongShortTermMemoryLayerForwardPropagation*,
-                                               LongShortTermMemoryLayerBackPropagation*) const;
-
-   void calculate_output_weights_error_gradient(const Tensor<type, 2>&,
-                                                LongShortTermMemoryLayerForwardPropagation*,
-                                                LongShortTermMemoryLayerBackPropagation*) const;
-
-   void calculate_forget_recurrent_weights_error_gradient(const Tensor<type, 2>&,
-                                                          LongShortTermMemoryLayerForwardPropagation*,
-                                                          LongShortTermMemoryLayerBackPropagation*) const;
+   void set_gates_parameters(LongShortTermMemoryLayerForwardPropagation*, type*) const;
 
-   void calculate_input_recurrent_weights_error_gradient(const Tensor<type, 2>&,
-                                                         LongShortTermMemoryLayerForwardPropagation*,
-                                                         LongShortTermMemoryLayerBackPropagation*) const;
+   void calculate_sequences_outputs(const TensorMap<Tensor<type, 2>>&, LongShortTermMemoryLayerForwardPropagation*, const bool&);
 
-   void calculate_state_recurrent_weights_error_gradient(const Tensor<type, 2>&,
-                                                         LongShortTermMemoryLayerForwardPropagation*,
-                                                         LongShortTermMemoryLayerBackPropagation*) const;
+   TensorMap<Tensor<type, 2>> get_previous_hidden_states(LongShortTermMemoryLayerForwardPropagation*, const Index&, const Index&, const Index&) const;
 
-   void calculate_output_recurrent_weights_error_gradient(const Tensor<type, 2>&,
-                                                          LongShortTermMemoryLayerForwardPropagation*,
-                                                          LongShortTermMemoryLayerBackPropagation*) const;
-
-   void calculate_forget_biases_error_gradient(const Tensor<type, 2>&,
-                                               LongShortTermMemoryLayerForwardPropagation*,
-                                               LongShortTermMemoryLayerBackPropagation*) const;
-
-   void calculate_input_biases_error_gradient(const Tensor<type, 2>&,
-                                              LongShortTermMemoryLayerForwardPropagation*,
-                                              LongShortTermMemoryLayerBackPropagation*) const;
+   // Eror gradient
 
-   void calculate_state_biases_error_gradient(const Tensor<type, 2>&,
-                                              LongShortTermMemoryLayerForwardPropagation*,
-                                              LongShortTermMemoryLayerBackPropagation*) const;
+   void insert_gradient(LayerBackPropagation*, const Index& , Tensor<type, 1>&) const final;
 
-   void calculate_output_biases_error_gradient(const Tensor<type, 2>&,
-                                               LongShortTermMemoryLayerForwardPropagation*,
-                                               LongShortTermMemoryLayerBackPropagation*) const;
+   void calculate_error_gradient(type*, LayerForwardPropagation*, LayerBackPropagation*) const final;
 
    // Expression methods
 
@@ -289,20 +254,25 @@ protected:
 
    Index timesteps = 3;
 
-   Tensor<type, 1> input_biases;
-   Tensor<type, 1> forget_biases;
-   Tensor<type, 1> state_biases;
-   Tensor<type, 1> output_biases;
+   /// Biases, weights and recurrent weights of the forget, input, state and output gates side by side,
+   /// in the order of the parameters, so that all the gates are computed with a single product.
+
+   Tensor<type, 1> gates_parameters;
 
-   Tensor<type, 2> input_weights;
-   Tensor<type, 2> forget_weights;
-   Tensor<type, 2> state_weights;
-   Tensor<type, 2> output_weights;
+   TensorMap<Tensor<type, 1>> forget_biases = TensorMap<Tensor<type, 1>>(nullptr, 0);
+   TensorMap<Tensor<type, 1>> input_biases = TensorMap<Tensor<type, 1>>(nullptr, 0);
+   TensorMap<Tensor<type, 1>> state_biases = TensorMap<Tensor<type, 1>>(nullptr, 0);
+   TensorMap<Tensor<type, 1>> output_biases = TensorMap<Tensor<type, 1>>(nullptr, 0);
 
-   Tensor<type, 2> forget_recurrent_weights;
-   Tensor<type, 2> input_recurrent_weights;
-   Tensor<type, 2> state_recurrent_weights;
-   Tensor<type, 2> output_recurrent_weights;
+   TensorMap<Tensor<type, 2>> forget_weights = TensorMap<Tensor<type, 2>>(nullptr, 0, 0);
+   TensorMap<Tensor<type, 2>> input_weights = TensorMap<Tensor<type, 2>>(nullptr, 0, 0);
+   TensorMap<Tensor<type, 2>> state_weights = TensorMap<Tensor<type, 2>>(nullptr, 0, 0);
+   TensorMap<Tensor<type, 2>> output_weights = TensorMap<Tensor<type, 2>>(nullptr, 0, 0);
+
+   TensorMap<Tensor<type, 2>> forget_recurrent_weights = TensorMap<Tensor<type, 2>>(nullptr, 0, 0);
+   TensorMap<Tensor<type, 2>> input_recurrent_weights = TensorMap<Tensor<type, 2>>(nullptr, 0, 0);
+   TensorMap<Tensor<type, 2>> state_recurrent_weights = TensorMap<Tensor<type, 2>>(nullptr, 0, 0);
+   TensorMap<Tensor<type, 2>> output_recurrent_weights = TensorMap<Tensor<type, 2>>(nullptr, 0, 0);
 
    /// Activation function variable.
 
@@ -343,7 +313,6 @@ struct LongShortTermMemoryLayerForwardPropagation : LayerForwardPropagation
     {
         layer_pointer = new_layer_pointer;
 
-        const Index inputs_number = layer_pointer->get_inputs_number();
         const Index neurons_number = layer_pointer->get_neurons_number();
 
         batch_samples_number = new_batch_samples_number;
@@ -357,103 +326,70 @@ struct LongShortTermMemoryLayerForwardPropagation : LayerForwardPropagation
 
         // Rest of quantities
 
-        previous_hidden_state_activations.resize(neurons_number);
-        previous_cell_state_activations.resize(neurons_number);
-
-        current_inputs.resize(inputs_number);
+        inputs_combinations.resize(batch_samples_number, 4*neurons_number);
 
-        current_forget_combinations.resize(neurons_number);
-        current_input_combinations.resize(neurons_number);
-        current_state_combinations.resize(neurons_number);
-        current_output_combinations.resize(neurons_number);
+        gates_combinations.resize(batch_samples_number*4*neurons_number);
+        gates_activations.resize(batch_samples_number*4*neurons_number);
+        gates_activations_derivatives.resize(batch_samples_number*4*neurons_number);
 
-        current_forget_activations.resize(neurons_number);
-        current_input_activations.resize(neurons_number);
-        current_state_activations.resize(neurons_number);
-        current_output_activations.resize(neurons_number);
+        cell_states.resize(batch_samples_number*neurons_number);
+        cell_states_activations.resize(batch_samples_number*neurons_number);
+        cell_states_activations_derivatives.resize(batch_samples_number*neurons_number);
 
-        current_cell_state_activations.resize(neurons_number);
+        hidden_states.resize(batch_samples_number*neurons_number);
 
-        current_forget_activations_derivatives.resize(neurons_number);
-        current_input_activations_derivatives.resize(neurons_number);
-        current_state_activations_derivatives.resize(neurons_number);
-        current_output_activations_derivatives.resize(neurons_number);
-        current_hidden_states_derivatives.resize(neurons_number);
-
-        forget_activations.resize(batch_samples_number, neurons_number);
-        input_activations.resize(batch_samples_number, neurons_number);
-        state_activations.resize(batch_samples_number, neurons_number);
-        output_activations.resize(batch_samples_number, neurons_number);
-        cell_states_activations.resize(batch_samples_number, neurons_number);
-        hidden_states_activations.resize(batch_samples_number, neurons_number);
+        previous_hidden_states.resize(batch_samples_number*neurons_number);
+    }
 
-        forget_activations_derivatives.resize(batch_samples_number, neurons_number);
-        input_activations_derivatives.resize(batch_samples_number, neurons_number);
-        state_activations_derivatives.resize(batch_samples_number, neurons_number);
-        output_activations_derivatives.resize(batch_samples_number, neurons_number);
-        cell_states_activations_derivatives.resize(batch_samples_number, neurons_number);
-        hidden_states_activations_derivatives.resize(batch_samples_number, neurons_number);
 
-        combinations.resize(batch_samples_number, neurons_number);
+    void free_training_memory() final
+    {
+        gates_activations_derivatives.resize(0);
+        cell_states_activations_derivatives.resize(0);
     }
 
+
     void print() const
     {
-        cout << "Combinations: " << endl;
-        cout << combinations << endl;
-
-        cout << "Current inputs: " << endl;
-        cout << current_inputs << endl;
+        cout << "Inputs combinations: " << endl;
+        cout << inputs_combinations << endl;
 
-        cout << "Current input combinations: " << endl;
-        cout << current_input_combinations << endl;
+        cout << "Gates activations: " << endl;
+        cout << gates_activations << endl;
 
-        cout << "Current input activations: " << endl;
-        cout << current_input_activations << endl;
+        cout << "Cell states: " << endl;
+        cout << cell_states << endl;
 
-        cout << "Current input activations derivatives: " << endl;
-        cout << current_input_activations_derivatives << endl;
+        cout << "Hidden states: " << endl;
+        cout << hidden_states << endl;
      }
 
-    Tensor<type, 2> combinations;
+    /// Views of the parameters of the gates side by side, either those of the layer or those given to the forward propagation.
 
-    Tensor<type, 1> previous_hidden_state_activations;
-    Tensor<type, 1> previous_cell_state_activations;
+    TensorMap<Tensor<type, 1>> gates_biases = TensorMap<Tensor<type, 1>>(nullptr, 0);
+    TensorMap<Tensor<type, 2>> gates_weights = TensorMap<Tensor<type, 2>>(nullptr, 0, 0);
+    TensorMap<Tensor<type, 2>> gates_recurrent_weights = TensorMap<Tensor<type, 2>>(nullptr, 0, 0);
 
-    Tensor<type, 1> current_inputs;
+    /// Products of the inputs and the weights of all the gates plus their biases, in the order of the batch.
 
-    Tensor<type, 1> current_forget_combinations;
-    Tensor<type, 1> current_input_combinations;
-    Tensor<type, 1> current_state_combinations;
-    Tensor<type, 1> current_output_combinations;
+    Tensor<type, 2> inputs_combinations;
 
-    Tensor<type, 1> current_forget_activations;
-    Tensor<type, 1> current_input_activations;
-    Tensor<type, 1> current_state_activations;
-    Tensor<type, 1> current_output_activations;
+    /// The quantities below hold the timesteps one after another.
+    /// Each timestep is a matrix with a row for each sequence which reaches it, and the gates side by side.
 
-    Tensor<type, 1> current_forget_activations_derivatives;
-    Tensor<type, 1> current_input_activations_derivatives;
-    Tensor<type, 1> current_state_activations_derivatives;
-    Tensor<type, 1> current_output_activations_derivatives;
+    Tensor<type, 1> gates_combinations;
+    Tensor<type, 1> gates_activations;
+    Tensor<type, 1> gates_activations_derivatives;
 
-    Tensor<type, 1> current_hidden_states_derivatives;
+    Tensor<type, 1> cell_states;
+    Tensor<type, 1> cell_states_activations;
+    Tensor<type, 1> cell_states_activations_derivatives;
 
-    Tensor<type, 1> current_cell_state_activations;
+    Tensor<type, 1> hidden_states;
 
-    Tensor<type, 2, RowMajor> forget_activations;
-    Tensor<type, 2, RowMajor> input_activations;
-    Tensor<type, 2, RowMajor> state_activations;
-    Tensor<type, 2, RowMajor> output_activations;
-    Tensor<type, 2, RowMajor> cell_states_activations;
-    Tensor<type, 2, RowMajor> hidden_states_activations;
+    /// Hidden states of the previous timestep of the sequences which reach the current one, when some sequence has ended before it.
 
-    Tensor<type, 2, RowMajor> forget_activations_derivatives;
-    Tensor<type, 2, RowMajor> input_activations_derivatives;
-    Tensor<type, 2, RowMajor> state_activations_derivatives;
-    Tensor<type, 2, RowMajor> output_activations_derivatives;
-    Tensor<type, 2, RowMajor> cell_states_activations_derivatives;
-    Tensor<type, 2, RowMajor> hidden_states_activations_derivatives;
+    Tensor<type, 1> previous_hidden_states;
 };
 
 
@@ -490,151 +426,83 @@ struct LongShortTermMemoryLayerBackPropagation : LayerBackPropagation
         //delete deltas_data;
         deltas_data = (type*)malloc(static_cast<size_t>(batch_samples_number*neurons_number*sizeof(type)));
 
-        current_layer_deltas.resize(neurons_number);
-
-        forget_weights_derivatives.resize(inputs_number*neurons_number);
-        input_weights_derivatives.resize(inputs_number*neurons_number);
-        state_weights_derivatives.resize(inputs_number*neurons_number);
-        output_weights_derivatives.resize(inputs_number*neurons_number);
-
-        forget_recurrent_weights_derivatives.resize(neurons_number*neurons_number);
-        input_recurrent_weights_derivatives.resize(neurons_number*neurons_number);
-        state_recurrent_weights_derivatives.resize(neurons_number*neurons_number);
-        output_recurrent_weights_derivatives.resize(neurons_number*neurons_number);
+        gradient.resize(4*neurons_number + 4*inputs_number*neurons_number + 4*neurons_number*neurons_number);
 
-        forget_biases_derivatives.resize(neurons_number);
-        input_biases_derivatives.resize(neurons_number);
-        state_biases_derivatives.resize(neurons_number);
-        output_biases_derivatives.resize(neurons_number);
+        set_gradient_data(gradient.data());
 
-        input_combinations_biases_derivatives.resize(neurons_number, neurons_number);
-        forget_combinations_biases_derivatives.resize(neurons_number, neurons_number);
-        state_combinations_biases_derivatives.resize(neurons_number, neurons_number);
-        output_combinations_biases_derivatives.resize(neurons_number, neurons_number);
+        combinations_deltas.resize(batch_samples_number, 4*neurons_number);
 
-        hidden_states_biases_derivatives.resize(neurons_number, neurons_number);
-        cell_state_biases_derivatives.resize(neurons_number, neurons_number);
+        // A timestep has at most a sequence for each sample
 
-        input_combinations_weights_derivatives.resize(inputs_number*neurons_number, neurons_number);
-        forget_combinations_weights_derivatives.resize(inputs_number*neurons_number, neurons_number);
-        state_combinations_weights_derivatives.resize(inputs_number*neurons_number, neurons_number);
-        output_combinations_weights_derivatives.resize(inputs_number*neurons_number, neurons_number);
+        gates_deltas.resize(batch_samples_number*4*neurons_number);
 
-        hidden_states_weights_derivatives.resize(inputs_number*neurons_number, neurons_number);
-        cell_state_weights_derivatives.resize(inputs_number*neurons_number, neurons_number);
-
-        input_combinations_recurrent_weights_derivatives.resize(neurons_number*neurons_number, neurons_number);
-        forget_combinations_recurrent_weights_derivatives.resize(neurons_number*neurons_number, neurons_number);
-        state_combinations_recurrent_weights_derivatives.resize(neurons_number*neurons_number, neurons_number);
-        output_combinations_recurrent_weights_derivatives.resize(neurons_number*neurons_number, neurons_number);
-
-        hidden_states_recurrent_weights_derivatives.resize(neurons_number*neurons_number, neurons_number);
-        cell_state_recurrent_weights_derivatives.resize(neurons_number*neurons_number, neurons_number);
+        hidden_deltas.resize(batch_samples_number*neurons_number);
+        recurrent_hidden_deltas.resize(batch_samples_number*neurons_number);
 
+        cell_deltas.resize(batch_samples_number*neurons_number);
+        next_cell_deltas.resize(batch_samples_number*neurons_number);
     }
 
-    void print() const
-    {
-    }
 
-    Tensor< TensorMap< Tensor<type, 1> >*, 1> get_layer_gradient()
+    /// Makes the derivatives views of a block of a gradient vector, in the order of the parameters of the layer:
+    /// the biases, the weights and the recurrent weights, each of them with the forget, input, state and output gates side by side.
+
+    void set_gradient_data(type* new_gradient_data) final
     {
-        Tensor< TensorMap< Tensor<type, 1> >*, 1> layer_gradient(30);
+        const Index neurons_number = layer_pointer->get_neurons_number();
+        const Index inputs_number = layer_pointer->get_inputs_number();
 
-        auto create_TensorMap_one_dim = [&](Tensor<type, 1> &v, size_t i)
-        {
-            layer_gradient(i) = new TensorMap<Tensor<type, 1>>(v.data(), v.size());
-        };
+        new (&gates_biases_derivatives) TensorMap<Tensor<type, 1>>(new_gradient_data, 4*neurons_number);
 
-        auto create_TensorMap_two_dims = [&](Tensor<type, 2> &v, size_t i)
-        {
-            layer_gradient(i) = new TensorMap<Tensor<type, 1>>(v.data(), v.size());
-        };
+        new (&gates_weights_derivatives) TensorMap<Tensor<type, 2>>(new_gradient_data + 4*neurons_number,
+                                                                    inputs_number, 4*neurons_number);
 
-        create_TensorMap_one_dim(input_biases_derivatives, 0);
-        create_TensorMap_one_dim(forget_biases_derivatives, 1);
-        create_TensorMap_one_dim(state_biases_derivatives, 2);
-        create_TensorMap_one_dim(output_biases_derivatives, 3);
+        new (&gates_recurrent_weights_derivatives) TensorMap<Tensor<type, 2>>(new_gradient_data + 4*neurons_number + 4*inputs_number*neurons_number,
+                                                                              neurons_number, 4*neurons_number);
 
-        create_TensorMap_one_dim(input_weights_derivatives, 4);
-        create_TensorMap_one_dim(forget_weights_derivatives, 5);
-        create_TensorMap_one_dim(state_weights_derivatives, 6);
-        create_TensorMap_one_dim(output_weights_derivatives, 7);
+        if(new_gradient_data != gradient.data()) gradient.resize(0);
+    }
 
-        create_TensorMap_one_dim(input_recurrent_weights_derivatives, 8);
-        create_TensorMap_one_dim(forget_recurrent_weights_derivatives, 9);
-        create_TensorMap_one_dim(state_recurrent_weights_derivatives, 10);
-        create_TensorMap_one_dim(output_recurrent_weights_derivatives, 11);
 
-        create_TensorMap_two_dims(input_combinations_biases_derivatives, 12);
-        create_TensorMap_two_dims(forget_combinations_biases_derivatives, 13);
-        create_TensorMap_two_dims(state_combinations_biases_derivatives, 14);
-        create_TensorMap_two_dims(output_combinations_biases_derivatives, 15);
+    void print() const
+    {
+        cout << "Biases derivatives:" << endl;
+        cout << gates_biases_derivatives << endl;
 
-        create_TensorMap_two_dims(hidden_states_biases_derivatives, 16);
-        create_TensorMap_two_dims(cell_state_biases_derivatives, 17);
+        cout << "Weights derivatives:" << endl;
+        cout << gates_weights_derivatives << endl;
 
-        create_TensorMap_two_dims(input_combinations_weights_derivatives, 18);
-        create_TensorMap_two_dims(forget_combinations_weights_derivatives, 19);
-        create_TensorMap_two_dims(state_combinations_weights_derivatives, 20);
-        create_TensorMap_two_dims(output_combinations_weights_derivatives, 21);
+        cout << "Recurrent weights derivatives:" << endl;
+        cout << gates_recurrent_weights_derivatives << endl;
+    }
 
-        create_TensorMap_two_dims(hidden_states_weights_derivatives, 22);
-        create_TensorMap_two_dims(cell_state_weights_derivatives, 23);
 
-        create_TensorMap_two_dims(input_combinations_recurrent_weights_derivatives, 24);
-        create_TensorMap_two_dims(forget_combinations_recurrent_weights_derivatives, 25);
-        create_TensorMap_two_dims(state_combinations_recurrent_weights_derivatives, 26);
-        create_TensorMap_two_dims(output_combinations_recurrent_weights_derivatives, 27);
+    Tensor< TensorMap< Tensor<type, 1> >*, 1> get_layer_gradient()
+    {
+        Tensor< TensorMap< Tensor<type, 1> >*, 1> layer_gradient(3);
 
-        create_TensorMap_two_dims(hidden_states_recurrent_weights_derivatives, 28);
-        create_TensorMap_two_dims(cell_state_recurrent_weights_derivatives, 29);
+        layer_gradient(0) = new TensorMap<Tensor<type, 1>>(gates_biases_derivatives.data(), gates_biases_derivatives.size());
+        layer_gradient(1) = new TensorMap<Tensor<type, 1>>(gates_weights_derivatives.data(), gates_weights_derivatives.size());
+        layer_gradient(2) = new TensorMap<Tensor<type, 1>>(gates_recurrent_weights_derivatives.data(), gates_recurrent_weights_derivatives.size());
 
         return layer_gradient;
     }
 
+    TensorMap<Tensor<type, 1>> gates_biases_derivatives = TensorMap<Tensor<type, 1>>(nullptr, 0);
+    TensorMap<Tensor<type, 2>> gates_weights_derivatives = TensorMap<Tensor<type, 2>>(nullptr, 0, 0);
+    TensorMap<Tensor<type, 2>> gates_recurrent_weights_derivatives = TensorMap<Tensor<type, 2>>(nullptr, 0, 0);
 
+    /// Derivatives of the error with respect to the combinations of all the gates, in the order of the batch.
 
-    Tensor<type, 1> current_layer_deltas;
-
-    Tensor<type, 1> forget_weights_derivatives;
-    Tensor<type, 1> input_weights_derivatives;
-    Tensor<type, 1> state_weights_derivatives;
-    Tensor<type, 1> output_weights_derivatives;
-
-    Tensor<type, 1> forget_recurrent_weights_derivatives;
-    Tensor<type, 1> input_recurrent_weights_derivatives;
-    Tensor<type, 1> state_recurrent_weights_derivatives;
-    Tensor<type, 1> output_recurrent_weights_derivatives;
-
-    Tensor<type, 1> forget_biases_derivatives;
-    Tensor<type, 1> input_biases_derivatives;
-    Tensor<type, 1> state_biases_derivatives;
-    Tensor<type, 1> output_biases_derivatives;
-
-    Tensor<type, 2> input_combinations_biases_derivatives;
-    Tensor<type, 2> forget_combinations_biases_derivatives;
-    Tensor<type, 2> state_combinations_biases_derivatives;
-    Tensor<type, 2> output_combinations_biases_derivatives;
-
-    Tensor<type, 2> hidden_states_biases_derivatives;
-    Tensor<type, 2> cell_state_biases_derivatives;
-
-    Tensor<type, 2> input_combinations_weights_derivatives;
-    Tensor<type, 2> forget_combinations_weights_derivatives;
-    Tensor<type, 2> state_combinations_weights_derivatives;
-    Tensor<type, 2> output_combinations_weights_derivatives;
+    Tensor<type, 2> combinations_deltas;
 
-    Tensor<type, 2> hidden_states_weights_derivatives;
-    Tensor<type, 2> cell_state_weights_derivatives;
+    Tensor<type, 1> gates_deltas;
 
-    Tensor<type, 2> input_combinations_recurrent_weights_derivatives;
-    Tensor<type, 2> forget_combinations_recurrent_weights_derivatives;
-    Tensor<type, 2> state_combinations_recurrent_weights_derivatives;
-    Tensor<type, 2> output_combinations_recurrent_weights_derivatives;
+    Tensor<type, 1> hidden_deltas;
+    Tensor<type, 1> recurrent_hidden_deltas;
 
-    Tensor<type, 2> hidden_states_recurrent_weights_derivatives;
-    Tensor<type, 2> cell_state_recurrent_weights_derivatives;
+    Tensor<type, 1> cell_deltas;
+    Tensor<type, 1> next_cell_deltas;
 };
 
 
@@ -40,8 +40,6 @@ LossIndex::LossIndex(NeuralNetwork* new_neural_network_pointer, DataSet* new_dat
 
 LossIndex::~LossIndex()
 {
-    delete thread_pool;
-    delete thread_pool_device;
 }
 
 
@@ -170,13 +168,12 @@ void LossIndex::set(const LossIndex& other_error_term)
 }
 
 
+/// Sets the number of threads of the thread pool shared by all the objects.
+/// @param new_threads_number Number of threads.
+
 void LossIndex::set_threads_number(const int& new_threads_number)
 {
-    if(thread_pool != nullptr) delete thread_pool;
-    if(thread_pool_device != nullptr) delete thread_pool_device;
-
-    thread_pool = new ThreadPool(new_threads_number);
-    thread_pool_device = new ThreadPoolDevice(thread_pool, new_threads_number);
+    ExecutionContext::set_threads_number(new_threads_number);
 }
 
 
@@ -201,13 +198,7 @@ void LossIndex::set_data_set_pointer(DataSet* new_data_set_pointer)
 
 void LossIndex::set_default()
 {
-    delete thread_pool;
-    delete thread_pool_device;
-
-    const int n = omp_get_max_threads();
-
-    thread_pool = new ThreadPool(n);
-    thread_pool_device = new ThreadPoolDevice(thread_pool, n);
+    thread_pool_device = ExecutionContext::get_thread_pool_device();
 
     regularization_method = RegularizationMethod::L2;
 }
@@ -400,8 +391,12 @@ void LossIndex::back_propagate(const DataSetBatch& batch,
 
     calculate_layers_delta(batch, forward_propagation, back_propagation);
 
+    // The layers may write their derivatives straight into the gradient, which then holds the error gradient
+
     calculate_layers_error_gradient(batch, forward_propagation, back_propagation);
 
+    assemble_layers_error_gradient(back_propagation);
+
     // Loss
 
     back_propagation.loss = back_propagation.error;
@@ -419,12 +414,9 @@ void LossIndex::back_propagate(const DataSetBatch& batch,
         calculate_regularization_gradient(back_propagation.parameters, back_propagation.regularization_gradient);
 
         back_propagation.gradient.device(*thread_pool_device) += regularization_weight * back_propagation.regularization_gradient;
-    }
-
-    // Assemble gradient
-
-    assemble_layers_error_gradient(back_propagation);
 
+        back_propagation.set_gradient_modified();
+    }
 }
 
 
@@ -450,8 +442,98 @@ void LossIndex::back_propagate_lm(const DataSetBatch& batch,
 
     calculate_error_hessian_lm(batch, loss_index_back_propagation_lm);
 
-    // Loss
+    calculate_loss_lm(loss_index_back_propagation_lm);
+}
+
+
+/// Calculates the squared errors Jacobian of a block of samples of a batch,
+/// and adds its products with the squared errors and with itself to the gradient and the Hessian of the batch.
+/// The sum of the squares of the error terms of the block is added to the error of the batch.
+/// The errors of the block and the layers must have been forward propagated.
+/// The squared errors Jacobian of the whole batch is never formed, so the memory does not grow with the samples.
+/// The gradient and the Hessian are left unscaled, see calculate_accumulated_error_gradient_hessian_lm().
+/// @param block Block of samples of the batch.
+/// @param block_forward_propagation Forward propagation of the block.
+/// @param block_back_propagation_lm Back-propagation of the block, set with set_block().
+/// @param skipped_samples_number Number of first samples of the block already accumulated with a previous block,
+/// which happens when the last block overlaps the previous one.
+/// @param loss_index_back_propagation_lm Back-propagation of the batch, whose gradient and Hessian are accumulated.
+
+void LossIndex::accumulate_squared_errors_jacobian_lm(const DataSetBatch& block,
+                                                      NeuralNetworkForwardPropagation& block_forward_propagation,
+                                                      LossIndexBackPropagationLM& block_back_propagation_lm,
+                                                      const Index& skipped_samples_number,
+                                                      LossIndexBackPropagationLM& loss_index_back_propagation_lm) const
+{
+    calculate_errors_lm(block, block_forward_propagation, block_back_propagation_lm);
+
+    calculate_squared_errors_lm(block, block_forward_propagation, block_back_propagation_lm);
+
+    calculate_layers_delta_lm(block, block_forward_propagation, block_back_propagation_lm);
+
+    calculate_squared_errors_jacobian_lm(block, block_forward_propagation, block_back_propagation_lm);
+
+    Tensor<type, 2>& squared_errors_jacobian = block_back_propagation_lm.squared_errors_jacobian;
+
+    if(skipped_samples_number > 0)
+    {
+        const Index parameters_number = squared_errors_jacobian.dimension(1);
+
+        block_back_propagation_lm.squared_errors.slice(Eigen::array<Index, 1>({0}),
+                                                       Eigen::array<Index, 1>({skipped_samples_number})).setZero();
+
+        squared_errors_jacobian.slice(Eigen::array<Index, 2>({0, 0}),
+                                      Eigen::array<Index, 2>({skipped_samples_number, parameters_number})).setZero();
+    }
+
+    Tensor<type, 0> sum_squared_error;
+
+    sum_squared_error.device(*thread_pool_device) = block_back_propagation_lm.squared_errors.square().sum();
+
+    loss_index_back_propagation_lm.error += sum_squared_error(0);
+
+    loss_index_back_propagation_lm.gradient.device(*thread_pool_device)
+            += squared_errors_jacobian.contract(block_back_propagation_lm.squared_errors, AT_B);
+
+    loss_index_back_propagation_lm.hessian.device(*thread_pool_device)
+            += squared_errors_jacobian.contract(squared_errors_jacobian, AT_B);
+}
+
+
+/// Returns the coefficient of the sum of the squared error terms in the error of a batch,
+/// for the error terms used by the Levenberg-Marquardt algorithm.
+/// The gradient and the Hessian approximation of the error are the products of the squared errors Jacobian times twice this coefficient.
+/// By default the error is the sum of the squared error terms itself.
+/// @param batch_samples_number Number of samples of the batch.
+
+type LossIndex::get_squared_errors_coefficient_lm(const Index&) const
+{
+    return type(1);
+}
+
+
+/// Scales the error, the gradient and the Hessian accumulated over the blocks of a batch, and adds the regularization.
+/// Before this, the error holds the sum of the squares of the error terms of all the blocks.
+
+void LossIndex::calculate_accumulated_error_gradient_hessian_lm(LossIndexBackPropagationLM& loss_index_back_propagation_lm) const
+{
+    const type coefficient = get_squared_errors_coefficient_lm(loss_index_back_propagation_lm.batch_samples_number);
+
+    loss_index_back_propagation_lm.error *= coefficient;
+
+    loss_index_back_propagation_lm.gradient.device(*thread_pool_device) = type(2)*coefficient*loss_index_back_propagation_lm.gradient;
+
+    loss_index_back_propagation_lm.hessian.device(*thread_pool_device) = type(2)*coefficient*loss_index_back_propagation_lm.hessian;
+
+    calculate_loss_lm(loss_index_back_propagation_lm);
+}
 
+
+/// Sets the loss as the error plus the regularization,
+/// and adds the regularization gradient and Hessian to the gradient and the Hessian.
+
+void LossIndex::calculate_loss_lm(LossIndexBackPropagationLM& loss_index_back_propagation_lm) const
+{
     loss_index_back_propagation_lm.loss = loss_index_back_propagation_lm.error;
 
     // Regularization
@@ -649,6 +731,26 @@ type LossIndex::calculate_regularization(const Tensor<type, 1>& parameters) cons
 }
 
 
+/// Returns the regularization term of a view of the parameters, such as the parameters arena of the neural network.
+/// @param parameters View of the parameters to get the regularization term.
+
+type LossIndex::calculate_regularization(const TensorMap<Tensor<type, 1>>& parameters) const
+{
+    switch(regularization_method)
+    {
+        case RegularizationMethod::NoRegularization: return type(0);
+
+        case RegularizationMethod::L1: return l1_norm(thread_pool_device, parameters);
+
+        case RegularizationMethod::L2: return l2_norm(thread_pool_device, parameters);
+
+        default: return type(0);
+    }
+
+    return type(0);
+}
+
+
 /// Returns the gradient of the regularization, according to the regularization type.
 /// That gradient is the vector of partial derivatives of the regularization with respect to the parameters.
 /// The size is thus the number of parameters
@@ -673,6 +775,29 @@ void LossIndex::calculate_regularization_gradient(const Tensor<type, 1>& paramet
 }
 
 
+/// Calculates the gradient of the regularization for a view of the parameters.
+/// @param parameters View of the parameters to get the regularization term.
+/// @param regularization_gradient Vector where the gradient is written.
+
+void LossIndex::calculate_regularization_gradient(const TensorMap<Tensor<type, 1>>& parameters, Tensor<type, 1>& regularization_gradient) const
+{
+    switch(regularization_method)
+    {
+    case RegularizationMethod::NoRegularization:
+        regularization_gradient.setZero(); return;
+
+    case RegularizationMethod::L1:
+        l1_norm_gradient(thread_pool_device, parameters, regularization_gradient); return;
+
+    case RegularizationMethod::L2:
+        l2_norm_gradient(thread_pool_device, parameters, regularization_gradient); return;
+
+    default:
+        return;
+    }
+}
+
+
 /// It calculate the regularization term using the <i>Hessian</i>.
 /// Returns the Hessian of the regularization, according to the regularization type.
 /// That Hessian is the matrix of second partial derivatives of the regularization with respect to the parameters.
@@ -703,25 +828,132 @@ void LossIndex::calculate_layers_delta(const DataSetBatch& batch,
 
     if(trainable_layers_number == 0) return;
 
-    const Tensor<Layer*, 1> trainable_layers_pointers = neural_network_pointer->get_trainable_layers_pointers();
-    const Tensor<Layer*, 1> layers_pointers = neural_network_pointer->get_layers_pointers();
-
-    Index first_trainable_layer_index = neural_network_pointer->get_first_trainable_layer_index();
+    const Index first_trainable_layer_index = neural_network_pointer->get_first_trainable_layer_index();
+    const Index last_trainable_layer_index = neural_network_pointer->get_last_trainable_layer_index();
 
     // Output layer
 
     calculate_output_delta(batch,forward_propagation,
                            back_propagation);
 
-    // Hidden layers
+    neural_network_pointer->get_layer_pointer(last_trainable_layer_index)
+            ->calculate_inputs_derivatives(forward_propagation.layers(last_trainable_layer_index),
+                                           back_propagation.neural_network.get_layer(last_trainable_layer_index));
 
-    for(Index i = static_cast<Index>(trainable_layers_number)-2; i >= 0; i--)
+    // Hidden layers, level by level of the layers graph, from the outputs to the inputs.
+    // The deltas of a layer only depend on the layers which read its outputs, which are in later levels.
+
+    const Tensor<Tensor<Index, 1>, 1>& layers_execution_levels = forward_propagation.layers_execution_levels;
+
+    for(Index i = layers_execution_levels.size() - 1; i >= 0; i--)
     {
-        trainable_layers_pointers(i)
-                ->calculate_hidden_delta(forward_propagation.layers(first_trainable_layer_index+i+1),
-                                         back_propagation.neural_network.layers(i+1),
-                                         back_propagation.neural_network.layers(i));
+        const Index* level_begin = layers_execution_levels(i).data();
+        const Index* level_end = level_begin + layers_execution_levels(i).size();
+
+        const Index* begin = lower_bound(level_begin, level_end, first_trainable_layer_index);
+        const Index* end = lower_bound(begin, level_end, last_trainable_layer_index);
+
+        const Index level_layers_number = end - begin;
+
+        if(level_layers_number == 0) continue;
+
+        if(level_layers_number == 1)
+        {
+            calculate_hidden_delta(*begin, forward_propagation, back_propagation);
+
+            continue;
+        }
+
+        ExecutionContext::run_concurrently(level_layers_number, [&](const Index& j)
+        {
+            calculate_hidden_delta(begin[j], forward_propagation, back_propagation);
+        });
+    }
+}
+
+
+/// Calculates the deltas of a hidden layer, as the sum of the contributions of all the layers which read its outputs.
+/// The deltas of a layer which does not lead to the outputs are zero.
+/// The scaling, unscaling and bounding layers between the trainable layers have no back-propagation,
+/// so the layers which only feed them get no contribution from them.
+/// A multihead attention layer which reads the outputs several times, as a self-attention does,
+/// gives the contribution of all of them at once.
+/// Once the deltas are complete, the layer calculates the derivatives of its inputs, if the layers which feed it need them.
+/// @param layer_index Index of the layer in the neural network.
+
+void LossIndex::calculate_hidden_delta(const Index& layer_index,
+                                       NeuralNetworkForwardPropagation& forward_propagation,
+                                       LossIndexBackPropagation& back_propagation) const
+{
+    const Index last_trainable_layer_index = neural_network_pointer->get_last_trainable_layer_index();
+
+    const Layer* layer_pointer = neural_network_pointer->get_layer_pointer(layer_index);
+
+    const Tensor<Index, 1>& outputs_indices = forward_propagation.layers_outputs_indices(layer_index);
+
+    const Index trainable_layer_index = back_propagation.neural_network.layers_trainable_indices(layer_index);
+
+    LayerBackPropagation* layer_back_propagation = back_propagation.neural_network.get_layer(layer_index);
+
+    if(layer_back_propagation == nullptr || layer_back_propagation->deltas_data == nullptr) return;
+
+    const auto is_output_back_propagated = [&](const Index& i)
+    {
+        const Index output_index = outputs_indices(i);
+
+        if(output_index > last_trainable_layer_index
+        || back_propagation.neural_network.get_layer(output_index) == nullptr) return false;
+
+        return i == 0
+            || output_index != outputs_indices(i-1)
+            || neural_network_pointer->get_layer_pointer(output_index)->get_type() != Layer::Type::MultiheadAttention;
+    };
+
+    Index outputs_number = 0;
+
+    for(Index i = 0; i < outputs_indices.size(); i++)
+    {
+        if(is_output_back_propagated(i)) outputs_number++;
+    }
+
+    const Tensor<Index, 0> deltas_size = layer_back_propagation->deltas_dimensions.prod();
+
+    TensorMap<Tensor<type, 1>> deltas(layer_back_propagation->deltas_data, deltas_size(0));
+
+    if(outputs_number == 0)
+    {
+        deltas.setZero();
     }
+    else
+    {
+        Tensor<type, 1>& deltas_sum = back_propagation.neural_network.layers_deltas_sums(trainable_layer_index);
+
+        Index index = 0;
+
+        for(Index i = 0; i < outputs_indices.size(); i++)
+        {
+            if(!is_output_back_propagated(i)) continue;
+
+            const Index output_index = outputs_indices(i);
+
+            layer_pointer->calculate_hidden_delta(forward_propagation.layers(output_index),
+                                                  back_propagation.neural_network.get_layer(output_index),
+                                                  layer_back_propagation);
+
+            if(outputs_number == 1) break;
+
+            if(index == 0)
+                deltas_sum.device(*thread_pool_device) = deltas;
+            else
+                deltas_sum.device(*thread_pool_device) += deltas;
+
+            index++;
+        }
+
+        if(outputs_number > 1) deltas.device(*thread_pool_device) = deltas_sum;
+    }
+
+    layer_pointer->calculate_inputs_derivatives(forward_propagation.layers(layer_index), layer_back_propagation);
 }
 
 
@@ -767,6 +999,8 @@ void LossIndex::calculate_layers_error_gradient(const DataSetBatch& batch,
 
     const Tensor<Layer*, 1> trainable_layers_pointers = neural_network_pointer->get_trainable_layers_pointers();
 
+    const Tensor<Index, 1> trainable_layers_indices = neural_network_pointer->get_trainable_layers_indices();
+
     const Index first_trainable_layers_index = neural_network_pointer->get_first_trainable_layer_index();
 //    const Index last_trainable_layer_index = neural_network_pointer->get_last_trainable_layer_index();
 
@@ -775,19 +1009,20 @@ void LossIndex::calculate_layers_error_gradient(const DataSetBatch& batch,
     const Tensor<Index, 1> trainable_layers_parameters_number
             = neural_network_pointer->get_trainable_layers_parameters_numbers();
 
-    trainable_layers_pointers(0)->calculate_error_gradient(batch.inputs(0).get_data(),
-                                                           forward_propagation.layers(first_trainable_layers_index),
-                                                           back_propagation.neural_network.layers(0));
+    // Each layer reads the outputs of its first input layer, or the inputs of the batch
 
-    for(Index i = 1; i < trainable_layers_number; i++)
+    for(Index i = 0; i < trainable_layers_number; i++)
     {
-        const LayerForwardPropagation* layer_forward_propagation = forward_propagation.layers(first_trainable_layers_index+i-1);
+        const Tensor<Index, 1>& inputs_indices = forward_propagation.layers_inputs_indices(trainable_layers_indices(i));
 
-        trainable_layers_pointers(i)->calculate_error_gradient(layer_forward_propagation->outputs(0).get_data(),
-                                                               forward_propagation.layers(first_trainable_layers_index+i),
+        type* inputs_data = inputs_indices.size() == 0 || inputs_indices(0) < first_trainable_layers_index
+                ? batch.inputs(0).get_data()
+                : forward_propagation.layers(inputs_indices(0))->outputs(0).get_data();
+
+        trainable_layers_pointers(i)->calculate_error_gradient(inputs_data,
+                                                               forward_propagation.layers(trainable_layers_indices(i)),
                                                                back_propagation.neural_network.layers(i));
     }
-
 }
 
 
@@ -175,6 +175,10 @@ public:
                                NeuralNetworkForwardPropagation&,
                                LossIndexBackPropagation&) const;
 
+   void calculate_hidden_delta(const Index&,
+                               NeuralNetworkForwardPropagation&,
+                               LossIndexBackPropagation&) const;
+
    void calculate_layers_error_gradient(const DataSetBatch&,
                                  const NeuralNetworkForwardPropagation&,
                                  LossIndexBackPropagation&) const;
@@ -217,15 +221,29 @@ public:
    virtual void calculate_error_hessian_lm(const DataSetBatch&,
                                            LossIndexBackPropagationLM&) const {}
 
+   virtual type get_squared_errors_coefficient_lm(const Index&) const;
+
    void back_propagate_lm(const DataSetBatch&,
                           NeuralNetworkForwardPropagation&,
                           LossIndexBackPropagationLM&) const;
 
+   void accumulate_squared_errors_jacobian_lm(const DataSetBatch&,
+                                              NeuralNetworkForwardPropagation&,
+                                              LossIndexBackPropagationLM&,
+                                              const Index&,
+                                              LossIndexBackPropagationLM&) const;
+
+   void calculate_accumulated_error_gradient_hessian_lm(LossIndexBackPropagationLM&) const;
+
+   void calculate_loss_lm(LossIndexBackPropagationLM&) const;
+
    // Regularization methods
 
    type calculate_regularization(const Tensor<type, 1>&) const;
+   type calculate_regularization(const TensorMap<Tensor<type, 1>>&) const;
 
    void calculate_regularization_gradient(const Tensor<type, 1>&, Tensor<type, 1>&) const;
+   void calculate_regularization_gradient(const TensorMap<Tensor<type, 1>>&, Tensor<type, 1>&) const;
    void calculate_regularization_hessian(Tensor<type, 1>&, Tensor<type, 2>&) const;
 
    // Serialization methods
@@ -248,7 +266,7 @@ public:
 
 protected:
 
-   ThreadPool* thread_pool = nullptr;
+   /// Thread pool device shared by all the objects, owned by the execution context.
 
    ThreadPoolDevice* thread_pool_device = nullptr;
 
@@ -326,11 +344,66 @@ struct LossIndexBackPropagation
 
         errors.resize(batch_samples_number, outputs_number);
 
-        parameters = neural_network_pointer->get_parameters();
+        // The parameters are a view of the parameters arena of the neural network, so that optimizers update them in place.
+        // A network whose layers have been resized since it was built has no arena, and the parameters are copied instead.
+
+        type* parameters_data = neural_network_pointer->get_parameters_data();
+
+        if(parameters_data == nullptr)
+        {
+            parameters_storage = neural_network_pointer->get_parameters();
+
+            parameters_data = parameters_storage.data();
+        }
+
+        new (&parameters) TensorMap<Tensor<type, 1>>(parameters_data, parameters_number);
 
         gradient.resize(parameters_number);
 
         regularization_gradient.resize(parameters_number);
+
+        // The layers write their derivatives directly into their block of the gradient
+
+        const Tensor<Index, 1> trainable_layers_parameters_numbers = neural_network_pointer->get_trainable_layers_parameters_numbers();
+
+        Index index = 0;
+
+        for(Index i = 0; i < neural_network.layers.size(); i++)
+        {
+            if(neural_network.layers(i) != nullptr) neural_network.layers(i)->set_gradient_data(gradient.data() + index);
+
+            index += trainable_layers_parameters_numbers(i);
+        }
+    }
+
+
+    /// Sets the back-propagation of a batch whose error is only evaluated, as that of the line search candidates.
+    /// It only allocates the errors, and not the layers back-propagation nor the gradient.
+
+    void set_errors(const Index& new_batch_samples_number, LossIndex* new_loss_index_pointer)
+    {
+        loss_index_pointer = new_loss_index_pointer;
+
+        batch_samples_number = new_batch_samples_number;
+
+        const Index outputs_number = loss_index_pointer->get_neural_network_pointer()->get_outputs_number();
+
+        error = type(0);
+
+        loss = type(0);
+
+        errors.resize(batch_samples_number, outputs_number);
+    }
+
+
+    /// Tells the layers that the whole gradient has been written outside them, as by the regularization or an all-reduce.
+
+    void set_gradient_modified()
+    {
+        for(Index i = 0; i < neural_network.layers.size(); i++)
+        {
+            if(neural_network.layers(i) != nullptr) neural_network.layers(i)->set_gradient_modified();
+        }
     }
 
 
@@ -368,7 +441,15 @@ struct LossIndexBackPropagation
 
     Tensor<type, 2> errors;
 
-    Tensor<type, 1> parameters;
+    /// Storage of the parameters, used only when the neural network has no parameters arena.
+
+    Tensor<type, 1> parameters_storage;
+
+    TensorMap<Tensor<type, 1>> parameters = TensorMap<Tensor<type, 1>>(nullptr, 0);
+
+    /// Gradient of the loss. The layers write their derivatives in their blocks, and an embedding layer only writes
+    /// and clears the rows of its batch. Any code which writes the whole gradient outside the layers,
+    /// as the regularization or an all-reduce, must call set_gradient_modified() afterwards.
 
     Tensor<type, 1> gradient;
     Tensor<type, 1> regularization_gradient;
@@ -430,6 +511,74 @@ struct LossIndexBackPropagationLM
         squared_errors.resize(batch_samples_number);
     }
 
+    /// Sets the back-propagation of a batch whose squared errors Jacobian is accumulated over blocks of samples.
+    /// It does not allocate the squared errors Jacobian nor the layers back-propagation of the batch,
+    /// which take memory proportional to the number of samples times the number of parameters.
+
+    void set_accumulated(const Index& new_batch_samples_number, LossIndex* new_loss_index_pointer)
+    {
+        loss_index_pointer = new_loss_index_pointer;
+
+        batch_samples_number = new_batch_samples_number;
+
+        NeuralNetwork* neural_network_pointer = loss_index_pointer->get_neural_network_pointer();
+
+        const Index parameters_number = neural_network_pointer->get_parameters_number();
+
+        const Index outputs_number = neural_network_pointer->get_outputs_number();
+
+        parameters = neural_network_pointer->get_parameters();
+
+        error = type(0);
+
+        loss = type(0);
+
+        gradient.resize(parameters_number);
+
+        regularization_gradient.resize(parameters_number);
+        regularization_gradient.setZero();
+
+        squared_errors_jacobian.resize(0, parameters_number);
+
+        hessian.resize(parameters_number, parameters_number);
+
+        regularization_hessian.resize(parameters_number, parameters_number);
+        regularization_hessian.setZero();
+
+        errors.resize(batch_samples_number, outputs_number);
+
+        squared_errors.resize(batch_samples_number);
+    }
+
+    /// Sets the back-propagation of a block of samples, whose squared errors Jacobian is accumulated
+    /// into the gradient and the Hessian of a batch.
+    /// It only allocates the errors, the layers back-propagation and the squared errors Jacobian of the block.
+
+    void set_block(const Index& new_block_samples_number, LossIndex* new_loss_index_pointer)
+    {
+        loss_index_pointer = new_loss_index_pointer;
+
+        batch_samples_number = new_block_samples_number;
+
+        NeuralNetwork* neural_network_pointer = loss_index_pointer->get_neural_network_pointer();
+
+        const Index parameters_number = neural_network_pointer->get_parameters_number();
+
+        const Index outputs_number = neural_network_pointer->get_outputs_number();
+
+        neural_network.set(batch_samples_number, neural_network_pointer);
+
+        error = type(0);
+
+        loss = type(0);
+
+        squared_errors_jacobian.resize(batch_samples_number, parameters_number);
+
+        errors.resize(batch_samples_number, outputs_number);
+
+        squared_errors.resize(batch_samples_number);
+    }
+
     void print() const
     {
         cout << "Loss index back-propagation LM" << endl;
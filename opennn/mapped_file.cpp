@@ -0,0 +1,211 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   M A P P E D   F I L E   C L A S S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace opennn
+{
+
+/// Default constructor.
+/// It creates a closed mapping.
+
+MappedFile::MappedFile()
+{
+}
+
+
+/// File constructor.
+/// It maps a file into memory.
+/// @param new_file_name Name of the file.
+/// @param access Expected access pattern.
+
+MappedFile::MappedFile(const string& new_file_name, const Access& access)
+{
+    open(new_file_name, access);
+}
+
+
+/// Destructor.
+/// It unmaps the file.
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+
+/// Returns true if a file is mapped, and false otherwise.
+
+bool MappedFile::is_open() const
+{
+#ifdef _WIN32
+    return file_handle != nullptr;
+#else
+    return file_descriptor != -1;
+#endif
+}
+
+
+/// Returns the name of the mapped file.
+
+const string& MappedFile::get_file_name() const
+{
+    return file_name;
+}
+
+
+/// Returns the first character of the mapping, or null if the file is empty or not mapped.
+
+const char* MappedFile::get_data() const
+{
+    return data;
+}
+
+
+/// Returns the number of characters of the mapped file.
+
+Index MappedFile::get_size() const
+{
+    return size;
+}
+
+
+/// Maps a file into memory, read only, after unmapping the previous one.
+/// @param new_file_name Name of the file.
+/// @param access Expected access pattern.
+
+void MappedFile::open(const string& new_file_name, const Access& access)
+{
+    close();
+
+    file_name = new_file_name;
+
+#ifdef _WIN32
+
+    const int wide_size = MultiByteToWideChar(CP_UTF8, 0, file_name.c_str(), -1, nullptr, 0);
+
+    wstring wide_file_name(size_t(max(wide_size, 1)), L'\0');
+
+    MultiByteToWideChar(CP_UTF8, 0, file_name.c_str(), -1, &wide_file_name[0], wide_size);
+
+    const DWORD flags = access == Access::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS;
+
+    HANDLE new_file_handle = CreateFileW(wide_file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                         OPEN_EXISTING, flags, nullptr);
+
+    if(new_file_handle != INVALID_HANDLE_VALUE)
+    {
+        file_handle = new_file_handle;
+
+        LARGE_INTEGER file_size;
+
+        if(GetFileSizeEx(new_file_handle, &file_size)) size = Index(file_size.QuadPart);
+
+        if(size > 0) mapping_handle = CreateFileMappingW(new_file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if(mapping_handle != nullptr) data = static_cast<const char*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+    }
+
+#else
+
+    file_descriptor = ::open(file_name.c_str(), O_RDONLY);
+
+    struct stat file_status;
+
+    if(file_descriptor != -1 && fstat(file_descriptor, &file_status) == 0)
+    {
+        size = Index(file_status.st_size);
+
+        if(size > 0)
+        {
+            void* mapping = mmap(nullptr, size_t(size), PROT_READ, MAP_SHARED, file_descriptor, 0);
+
+            if(mapping != MAP_FAILED)
+            {
+                madvise(mapping, size_t(size), access == Access::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+
+                data = static_cast<const char*>(mapping);
+            }
+        }
+    }
+
+#endif
+
+    if(!is_open() || (size > 0 && data == nullptr))
+    {
+        close();
+
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: MappedFile class.\n"
+               << "void open(const string&, const Access&) method.\n"
+               << "Cannot open file: " << new_file_name << "\n";
+
+        throw invalid_argument(buffer.str());
+    }
+}
+
+
+/// Unmaps the file, if any, and closes it.
+
+void MappedFile::close()
+{
+#ifdef _WIN32
+
+    if(data != nullptr) UnmapViewOfFile(data);
+    if(mapping_handle != nullptr) CloseHandle(mapping_handle);
+    if(file_handle != nullptr) CloseHandle(file_handle);
+
+    mapping_handle = nullptr;
+    file_handle = nullptr;
+
+#else
+
+    if(data != nullptr) munmap(const_cast<char*>(data), size_t(size));
+    if(file_descriptor != -1) ::close(file_descriptor);
+
+    file_descriptor = -1;
+
+#endif
+
+    data = nullptr;
+    size = 0;
+}
+
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
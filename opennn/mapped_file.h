@@ -0,0 +1,113 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   M A P P E D   F I L E   C L A S S   H E A D E R
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+// System includes
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <stdexcept>
+
+// OpenNN includes
+
+#include "config.h"
+
+namespace opennn
+{
+
+/// This class maps a whole file into memory, read only.
+/// The pages are loaded on demand by the operating system and shared through its page cache,
+/// so that several processes mapping the same file do not hold copies of it.
+
+class MappedFile
+{
+
+public:
+
+    /// Enumeration of the expected access patterns, which are passed to the operating system as hints.
+
+    enum class Access{Sequential, Random};
+
+    // Constructors
+
+    explicit MappedFile();
+
+    explicit MappedFile(const string&, const Access& = Access::Sequential);
+
+    MappedFile(const MappedFile&) = delete;
+
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Destructor
+
+    virtual ~MappedFile();
+
+    // Get methods
+
+    bool is_open() const;
+
+    const string& get_file_name() const;
+
+    const char* get_data() const;
+
+    Index get_size() const;
+
+    // Set methods
+
+    void open(const string&, const Access& = Access::Sequential);
+
+    void close();
+
+private:
+
+    /// Name of the mapped file.
+
+    string file_name;
+
+    /// First character of the mapping, or null for empty or closed files.
+
+    const char* data = nullptr;
+
+    /// Number of characters of the file.
+
+    Index size = 0;
+
+#ifdef _WIN32
+    void* file_handle = nullptr;
+    void* mapping_handle = nullptr;
+#else
+    int file_descriptor = -1;
+#endif
+};
+
+}
+
+#endif
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -117,9 +117,7 @@ void MeanSquaredError::calculate_output_delta(const DataSetBatch& batch,
 
      deltas.device(*thread_pool_device) = coefficient * back_propagation.errors;
 
-     Tensor<type, 2> output_deltas(deltas);
-
-     if(has_NAN(output_deltas))
+     if(has_NAN(deltas.data(), deltas.size()))
      {
          ostringstream buffer;
 
@@ -208,6 +206,20 @@ void MeanSquaredError::calculate_error_hessian_lm(const DataSetBatch& batch,
 }
 
 
+/// Returns the coefficient of the sum of the squared error terms in the mean squared error,
+/// which is the inverse of the number of outputs times the number of samples.
+/// @param batch_samples_number Number of samples of the batch.
+
+type MeanSquaredError::get_squared_errors_coefficient_lm(const Index& batch_samples_number) const
+{
+    const Index outputs_number = neural_network_pointer->get_outputs_number();
+
+    const Index squared_errors_number = outputs_number*batch_samples_number;
+
+    return squared_errors_number > 0 ? type(1)/static_cast<type>(squared_errors_number) : type(1);
+}
+
+
 /// Returns a string with the name of the mean squared error loss type, "MEAN_SQUARED_ERROR".
 
 string MeanSquaredError::get_error_type() const
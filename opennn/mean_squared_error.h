@@ -71,6 +71,8 @@ public:
    void calculate_error_hessian_lm(const DataSetBatch&,
                                         LossIndexBackPropagationLM&) const final;
 
+   type get_squared_errors_coefficient_lm(const Index&) const final;
+
    // Serialization methods
 
    void write_XML(tinyxml2::XMLPrinter &) const final;
@@ -0,0 +1,218 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   M E M O R Y   P L A N N E R   C L A S S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "memory_planner.h"
+
+namespace opennn
+{
+
+/// Default constructor.
+/// It creates a planner without buffers.
+
+MemoryPlanner::MemoryPlanner()
+{
+}
+
+
+/// Returns the number of buffers added to the planner.
+
+Index MemoryPlanner::get_buffers_number() const
+{
+    return static_cast<Index>(sizes.size());
+}
+
+
+/// Returns the offsets of the buffers in the arena, in number of elements.
+/// They are only defined after planning.
+
+const Tensor<Index, 1>& MemoryPlanner::get_offsets() const
+{
+    return offsets;
+}
+
+
+/// Returns the offset of a buffer in the arena, in number of elements.
+/// @param buffer_index Index of the buffer.
+
+Index MemoryPlanner::get_offset(const Index& buffer_index) const
+{
+    if(buffer_index < 0 || buffer_index >= offsets.size())
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: MemoryPlanner class.\n"
+               << "Index get_offset(const Index&) const method.\n"
+               << "Buffer index (" << buffer_index << ") must be less than number of planned buffers (" << offsets.size() << ").\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    return offsets(buffer_index);
+}
+
+
+/// Returns the number of elements of the arena which holds all the buffers.
+
+Index MemoryPlanner::get_arena_size() const
+{
+    return arena_size;
+}
+
+
+/// Returns the number of elements that the buffers would take without sharing any memory.
+
+Index MemoryPlanner::get_buffers_size() const
+{
+    return accumulate(sizes.begin(), sizes.end(), Index(0));
+}
+
+
+/// Rounds up a number of elements so that consecutive buffers keep the alignment of Eigen.
+/// @param size Number of elements.
+
+Index MemoryPlanner::get_aligned_size(const Index& size)
+{
+    const Index alignment = max(Index(EIGEN_MAX_ALIGN_BYTES)/Index(sizeof(type)), Index(1));
+
+    return (size + alignment - 1)/alignment*alignment;
+}
+
+
+/// Removes all the buffers and the plan.
+
+void MemoryPlanner::set()
+{
+    sizes.clear();
+    first_levels.clear();
+    last_levels.clear();
+
+    offsets.resize(0);
+
+    arena_size = 0;
+}
+
+
+/// Adds a buffer to the planner and returns its index.
+/// @param size Number of elements of the buffer.
+/// @param first_level Level which writes the buffer.
+/// @param last_level Last level which reads the buffer.
+
+Index MemoryPlanner::add_buffer(const Index& size, const Index& first_level, const Index& last_level)
+{
+    if(size < 0 || first_level > last_level)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: MemoryPlanner class.\n"
+               << "Index add_buffer(const Index&, const Index&, const Index&) method.\n"
+               << "Size (" << size << ") must be positive and first level (" << first_level << ") "
+               << "must not be greater than last level (" << last_level << ").\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    sizes.push_back(get_aligned_size(size));
+    first_levels.push_back(first_level);
+    last_levels.push_back(last_level);
+
+    return static_cast<Index>(sizes.size()) - 1;
+}
+
+
+/// Assigns an offset in the arena to each buffer.
+/// @param mode In training mode all the buffers are kept alive until the end, so none of them share memory.
+
+void MemoryPlanner::plan(const Mode& mode)
+{
+    const Index buffers_number = get_buffers_number();
+
+    offsets.resize(buffers_number);
+
+    arena_size = 0;
+
+    if(buffers_number == 0) return;
+
+    const Index end_level = *max_element(last_levels.begin(), last_levels.end());
+
+    vector<Index> lifetimes_ends(last_levels);
+
+    if(mode == Mode::Training) fill(lifetimes_ends.begin(), lifetimes_ends.end(), end_level);
+
+    // Largest buffers first, in order of execution for equal sizes
+
+    vector<Index> order(static_cast<size_t>(buffers_number));
+
+    iota(order.begin(), order.end(), Index(0));
+
+    stable_sort(order.begin(), order.end(), [&](const Index& a, const Index& b)
+    {
+        if(sizes[a] != sizes[b]) return sizes[a] > sizes[b];
+
+        return first_levels[a] < first_levels[b];
+    });
+
+    vector<Index> placed_buffers;
+    vector<Index> colliding_buffers;
+
+    for(const Index& buffer_index : order)
+    {
+        // Placed buffers alive at the same time, by offset
+
+        colliding_buffers.clear();
+
+        for(const Index& placed_index : placed_buffers)
+        {
+            if(first_levels[placed_index] <= lifetimes_ends[buffer_index]
+            && first_levels[buffer_index] <= lifetimes_ends[placed_index])
+                colliding_buffers.push_back(placed_index);
+        }
+
+        sort(colliding_buffers.begin(), colliding_buffers.end(), [&](const Index& a, const Index& b)
+        {
+            return offsets(a) < offsets(b);
+        });
+
+        // Lowest gap large enough
+
+        Index offset = 0;
+
+        for(const Index& colliding_index : colliding_buffers)
+        {
+            if(offset + sizes[buffer_index] <= offsets(colliding_index)) break;
+
+            offset = max(offset, offsets(colliding_index) + sizes[colliding_index]);
+        }
+
+        offsets(buffer_index) = offset;
+
+        arena_size = max(arena_size, offset + sizes[buffer_index]);
+
+        placed_buffers.push_back(buffer_index);
+    }
+}
+
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
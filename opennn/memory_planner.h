@@ -0,0 +1,121 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   M E M O R Y   P L A N N E R   C L A S S   H E A D E R
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#ifndef MEMORYPLANNER_H
+#define MEMORYPLANNER_H
+
+// System includes
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+// OpenNN includes
+
+#include "config.h"
+
+namespace opennn
+{
+
+/// This class places a set of buffers in a single arena of memory.
+/// The lifetime of each buffer is the range of execution levels from the one which writes it
+/// to the last one which reads it. Buffers whose lifetimes overlap never share memory,
+/// while the others may reuse the same offsets.
+/// Buffers are placed by decreasing size, each at the lowest offset which does not collide
+/// with the buffers already placed that are alive at the same time.
+
+class MemoryPlanner
+{
+
+public:
+
+    /// Enumeration of the planning modes.
+    /// <ul>
+    /// <li> Inference: A buffer is released after the last level which reads it.
+    /// <li> Training: All the buffers are kept until the end, because back-propagation reads them.
+    /// </ul>
+
+    enum class Mode{Inference, Training};
+
+    // Constructors
+
+    explicit MemoryPlanner();
+
+    // Get methods
+
+    Index get_buffers_number() const;
+
+    const Tensor<Index, 1>& get_offsets() const;
+
+    Index get_offset(const Index&) const;
+
+    Index get_arena_size() const;
+
+    Index get_buffers_size() const;
+
+    static Index get_aligned_size(const Index&);
+
+    // Set methods
+
+    void set();
+
+    Index add_buffer(const Index&, const Index&, const Index&);
+
+    // Planning methods
+
+    void plan(const Mode&);
+
+private:
+
+    /// Aligned size of each buffer, in number of elements.
+
+    vector<Index> sizes;
+
+    /// Level which writes each buffer.
+
+    vector<Index> first_levels;
+
+    /// Last level which reads each buffer.
+
+    vector<Index> last_levels;
+
+    /// Offset of each buffer in the arena, in number of elements.
+
+    Tensor<Index, 1> offsets;
+
+    /// Number of elements of the arena.
+
+    Index arena_size = 0;
+};
+
+}
+
+#endif
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
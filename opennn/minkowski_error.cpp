@@ -142,9 +142,7 @@ void MinkowskiError::calculate_output_delta(const DataSetBatch& batch,
         replace_if(deltas.data(), deltas.data()+deltas.size(), [](type x){return isnan(x);}, 0);
     }
 
-    Tensor<type, 2> output_deltas(deltas);
-
-    if(has_NAN(output_deltas))
+    if(has_NAN(deltas.data(), deltas.size()))
     {
         ostringstream buffer;
 
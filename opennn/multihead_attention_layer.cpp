@@ -74,6 +74,26 @@ Index MultiheadAttentionLayer::get_number_of_heads() const
 }
 
 
+/// Returns the dimensions of the input to the layer, that is, the input size and the embedding depth.
+
+Tensor<Index, 1> MultiheadAttentionLayer::get_inputs_dimensions() const
+{
+    Tensor<Index, 1> inputs_dimensions(2);
+
+    inputs_dimensions.setValues({input_size, depth});
+
+    return inputs_dimensions;
+}
+
+
+/// Returns the dimensions of the outputs of the layer, which are those of the input.
+
+Tensor<Index, 1> MultiheadAttentionLayer::get_outputs_dimensions() const
+{
+    return get_inputs_dimensions();
+}
+
+
 /// Returns linear transformation kernels
 
 Tensor<type, 3> MultiheadAttentionLayer::get_query_kernel() const
@@ -108,6 +128,49 @@ Index MultiheadAttentionLayer::get_parameters_number() const
 }
 
 
+/// Returns a single vector with the query, key, value and projection kernels, in that order.
+
+Tensor<type, 1> MultiheadAttentionLayer::get_parameters() const
+{
+    Tensor<type, 1> parameters(get_parameters_number());
+
+    Index index = 0;
+
+    for(const Tensor<type, 3>* kernel : {&query_kernel, &key_kernel, &value_kernel, &projection_kernel})
+    {
+        copy(kernel->data(), kernel->data() + kernel->size(), parameters.data() + index);
+
+        index += kernel->size();
+    }
+
+    return parameters;
+}
+
+
+/// Returns true if each query only attends to the keys at the same or earlier positions.
+
+const bool& MultiheadAttentionLayer::get_causal_mask() const
+{
+    return causal_mask;
+}
+
+
+/// Returns the number of queries of the tiles in which the attention is computed.
+
+const Index& MultiheadAttentionLayer::get_query_tile_size() const
+{
+    return query_tile_size;
+}
+
+
+/// Returns the number of keys of the tiles in which the attention is computed.
+
+const Index& MultiheadAttentionLayer::get_key_tile_size() const
+{
+    return key_tile_size;
+}
+
+
 /// Returns true if messages from this class are displayed on the screen,
 /// or false if messages from this class are not displayed on the screen.
 
@@ -228,6 +291,23 @@ void MultiheadAttentionLayer::set_kernels()
 }
 
 
+/// Sets the query, key, value and projection kernels of this layer from a vector of parameters.
+/// @param new_parameters Parameters vector.
+/// @param index Position of the first parameter of the layer in the vector.
+
+void MultiheadAttentionLayer::set_parameters(const Tensor<type, 1>& new_parameters, const Index& index)
+{
+    Index kernel_index = index;
+
+    for(Tensor<type, 3>* kernel : {&query_kernel, &key_kernel, &value_kernel, &projection_kernel})
+    {
+        copy(new_parameters.data() + kernel_index, new_parameters.data() + kernel_index + kernel->size(), kernel->data());
+
+        kernel_index += kernel->size();
+    }
+}
+
+
 void MultiheadAttentionLayer::set_parameters_random()
 {
     const type minimum = type(-0.2);
@@ -274,6 +354,37 @@ void MultiheadAttentionLayer::set_display(const bool& new_display)
 }
 
 
+/// Sets whether each query only attends to the keys at the same or earlier positions.
+/// @param new_causal_mask True to mask the keys after each query.
+
+void MultiheadAttentionLayer::set_causal_mask(const bool& new_causal_mask)
+{
+    causal_mask = new_causal_mask;
+}
+
+
+/// Sets the sizes of the tiles in which the attention is computed.
+/// @param new_query_tile_size Number of queries of a tile.
+/// @param new_key_tile_size Number of keys of a tile.
+
+void MultiheadAttentionLayer::set_tile_sizes(const Index& new_query_tile_size, const Index& new_key_tile_size)
+{
+    if(new_query_tile_size <= 0 || new_key_tile_size <= 0)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: MultiheadAttentionLayer class.\n"
+               << "void set_tile_sizes(const Index&, const Index&) method.\n"
+               << "Tile sizes (" << new_query_tile_size << ", " << new_key_tile_size << ") must be greater than zero.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    query_tile_size = new_query_tile_size;
+    key_tile_size = new_key_tile_size;
+}
+
+
 /// @todo fix, update and explain
 void MultiheadAttentionLayer::calculate_query_transformation(const Tensor<type, 3>& query, type* query_transformation_data)
 {
@@ -341,90 +452,335 @@ void MultiheadAttentionLayer::calculate_output_projection(const Tensor<type, 4>&
 }
 
 
-/// Computes the attention scores by comparing (via dot product) query and key.
-/// Attention scores must be computed separately for each batch element and each attention head (batch matrix multiplication).
+/// Copies the elements of a batch element and head of a tensor (batch, rows, depth, heads) into a matrix (depth, rows),
+/// so that the depth of each row is contiguous.
+/// @param data Tensor with dimensions (batch, rows, depth, heads).
+/// @param batch_size Number of batch elements.
+/// @param rows_number Number of rows, which are the queries or the keys.
+/// @param batch_index Index of the batch element.
+/// @param head_index Index of the attention head.
+/// @param head_data Matrix with dimensions (depth, rows).
+
+void MultiheadAttentionLayer::pack_head(const type* data,
+                                        const Index& batch_size,
+                                        const Index& rows_number,
+                                        const Index& batch_index,
+                                        const Index& head_index,
+                                        type* head_data) const
+{
+    const type* head_begin = data + batch_index + batch_size*rows_number*depth*head_index;
+
+    for(Index i = 0; i < rows_number; i++)
+    {
+        const type* row = head_begin + batch_size*i;
+
+        type* head_row = head_data + depth*i;
+
+        for(Index j = 0; j < depth; j++)
+        {
+            head_row[j] = row[batch_size*rows_number*j];
+        }
+    }
+}
+
+
+/// Copies a matrix (depth, rows) back into a batch element and head of a tensor (batch, rows, depth, heads).
+/// It is the inverse of pack_head.
 
-void MultiheadAttentionLayer::compute_attention_scores(type* transformed_query_data,
-                                                       const Tensor<Index, 1>& transformed_query_dimensions,
-                                                       type* transformed_key_data,
-                                                       const Tensor<Index, 1>& transformed_key_dimensions,
-                                                       type* attention_scores_data)
+void MultiheadAttentionLayer::unpack_head(const type* head_data,
+                                          const Index& batch_size,
+                                          const Index& rows_number,
+                                          const Index& batch_index,
+                                          const Index& head_index,
+                                          type* data) const
 {
-    if(transformed_query_dimensions(0) != transformed_key_dimensions(0))
+    type* head_begin = data + batch_index + batch_size*rows_number*depth*head_index;
+
+    for(Index i = 0; i < rows_number; i++)
     {
-        ostringstream buffer;
+        type* row = head_begin + batch_size*i;
 
-        buffer << "OpenNN Exception: MultiheadAttentionLayer class.\n"
-               << "void compute_attention_scores(type*, const Tensor<Index, 1>&, type*, const Tensor<Index, 1>&, type*) method.\n"
-               << "Input batch size (" << transformed_query_dimensions(0) << ") and context batch size (" << transformed_key_dimensions(0) << ") not equal.\n";
+        const type* head_row = head_data + depth*i;
 
-        throw invalid_argument(buffer.str());
+        for(Index j = 0; j < depth; j++)
+        {
+            row[batch_size*rows_number*j] = head_row[j];
+        }
     }
+}
 
-    const Index batch_size = transformed_query_dimensions(0);
 
-    TensorMap<Tensor<type, 4>>  transformed_query(transformed_query_data, batch_size, input_size, depth, number_of_heads);
-    const TensorMap<Tensor<type, 4>>  transformed_key(transformed_key_data, batch_size, context_size, depth, number_of_heads);
+/// Computes the attention outputs by comparing (via dot product) query and key, and weighting the value with the softmax of the scores.
+/// Each batch element and attention head is computed in tiles of queries and keys.
+/// For each tile of queries, the tiles of keys are visited in order: the running maximum and sum of the softmax of each query
+/// are updated with the scores of the tile, and the outputs accumulated so far are rescaled accordingly.
+/// @param transformed_query_data Transformed query, with dimensions (batch, input size, depth, heads).
+/// @param transformed_key_data Transformed key, with dimensions (batch, context size, depth, heads).
+/// @param transformed_value_data Transformed value, with dimensions (batch, context size, depth, heads).
+/// @param batch_size Number of batch elements.
+/// @param attention_outputs_data Attention outputs, with dimensions (batch, input size, depth, heads).
+/// @param softmax_logsumexp_data Logarithm of the softmax denominator of each query, with dimensions (batch, input size, heads).
+
+void MultiheadAttentionLayer::compute_attention_outputs(const type* transformed_query_data,
+                                                        const type* transformed_key_data,
+                                                        const type* transformed_value_data,
+                                                        const Index& batch_size,
+                                                        type* attention_outputs_data,
+                                                        type* softmax_logsumexp_data) const
+{
+    const type scaling_factor = type(1)/sqrt(type(depth));
 
-    const Tensor<type, 4> scaled_query = transformed_query / transformed_query.constant(sqrt(depth));
+    const type infinity = numeric_limits<type>::infinity();
 
-    Tensor<type, 4> raw_attention_scores(batch_size, input_size, context_size, number_of_heads);
+#pragma omp parallel
+    {
+        Tensor<type, 2> query(depth, input_size);
+        Tensor<type, 2> key(depth, context_size);
+        Tensor<type, 2> value(depth, context_size);
+        Tensor<type, 2> outputs(depth, input_size);
 
-    TensorMap<Tensor<type, 4>> attention_scores(attention_scores_data, batch_size, input_size, context_size, number_of_heads);
+        Tensor<type, 1> scores(key_tile_size*query_tile_size);
 
-    Tensor<Index, 1> row_size(1);
-    row_size.setValues({context_size});
+        Tensor<type, 1> maximums(query_tile_size);
+        Tensor<type, 1> sums(query_tile_size);
 
-#pragma omp parallel for collapse(2)
+#pragma omp for collapse(2)
         for(Index batch_index = 0; batch_index < batch_size; batch_index++)
         {
-            for(Index head_index = 0; head_index < number_of_heads ; head_index++)
+            for(Index head_index = 0; head_index < number_of_heads; head_index++)
             {
-            raw_attention_scores.chip(batch_index, 0).chip(head_index, 2)/*.device(thread_pool_device)*/ =
-                    scaled_query.chip(batch_index, 0).chip(head_index, 2).contract(
-                    transformed_key.chip(batch_index, 0).chip(head_index, 2), A_BT);
+                pack_head(transformed_query_data, batch_size, input_size, batch_index, head_index, query.data());
+                pack_head(transformed_key_data, batch_size, context_size, batch_index, head_index, key.data());
+                pack_head(transformed_value_data, batch_size, context_size, batch_index, head_index, value.data());
 
-                Tensor<type, 1> raw_attention_scores_row(context_size);
-                Tensor<type, 1> attention_scores_row(context_size);
-
-                for(Index row_index = 0; row_index < input_size; row_index++)
+                for(Index query_begin = 0; query_begin < input_size; query_begin += query_tile_size)
                 {
-                    raw_attention_scores_row = raw_attention_scores.chip(batch_index, 0).chip(head_index, 2).chip(row_index, 0);
-                    softmax(raw_attention_scores_row.data(),
-                            row_size,
-                            attention_scores_row.data(),
-                            row_size);
-                    attention_scores.chip(batch_index, 0).chip(head_index, 2).chip(row_index, 0) = attention_scores_row;
+                    const Index queries_number = min(query_tile_size, input_size - query_begin);
+
+                    const TensorMap<Tensor<type, 2>> query_tile(query.data() + depth*query_begin, depth, queries_number);
+
+                    TensorMap<Tensor<type, 2>> outputs_tile(outputs.data() + depth*query_begin, depth, queries_number);
+
+                    outputs_tile.setZero();
+
+                    maximums.setConstant(-infinity);
+                    sums.setZero();
+
+                    const Index keys_end = causal_mask ? min(context_size, query_begin + queries_number) : context_size;
+
+                    for(Index key_begin = 0; key_begin < keys_end; key_begin += key_tile_size)
+                    {
+                        const Index keys_number = min(key_tile_size, keys_end - key_begin);
+
+                        const TensorMap<Tensor<type, 2>> key_tile(key.data() + depth*key_begin, depth, keys_number);
+                        const TensorMap<Tensor<type, 2>> value_tile(value.data() + depth*key_begin, depth, keys_number);
+
+                        TensorMap<Tensor<type, 2>> scores_tile(scores.data(), keys_number, queries_number);
+
+                        scores_tile = key_tile.contract(query_tile, AT_B)*scaling_factor;
+
+                        // Streaming softmax
+
+                        for(Index i = 0; i < queries_number; i++)
+                        {
+                            type* scores_column = scores_tile.data() + keys_number*i;
+
+                            const Index unmasked_keys_number = causal_mask
+                                    ? min(keys_number, query_begin + i - key_begin + 1)
+                                    : keys_number;
+
+                            if(unmasked_keys_number <= 0)
+                            {
+                                fill(scores_column, scores_column + keys_number, type(0));
+                                continue;
+                            }
+
+                            type maximum = maximums(i);
+
+                            for(Index j = 0; j < unmasked_keys_number; j++)
+                                maximum = max(maximum, scores_column[j]);
+
+                            const type correction = exp(maximums(i) - maximum);
+
+                            type sum = type(0);
+
+                            for(Index j = 0; j < unmasked_keys_number; j++)
+                            {
+                                scores_column[j] = exp(scores_column[j] - maximum);
+                                sum += scores_column[j];
+                            }
+
+                            fill(scores_column + unmasked_keys_number, scores_column + keys_number, type(0));
+
+                            maximums(i) = maximum;
+                            sums(i) = sums(i)*correction + sum;
+
+                            type* outputs_column = outputs_tile.data() + depth*i;
+
+                            for(Index j = 0; j < depth; j++)
+                                outputs_column[j] *= correction;
+                        }
+
+                        outputs_tile += value_tile.contract(scores_tile, A_B);
+                    }
+
+                    for(Index i = 0; i < queries_number; i++)
+                    {
+                        type* outputs_column = outputs_tile.data() + depth*i;
+
+                        for(Index j = 0; j < depth; j++)
+                            outputs_column[j] /= sums(i);
+
+                        softmax_logsumexp_data[batch_index + batch_size*(query_begin + i + input_size*head_index)]
+                                = maximums(i) + log(sums(i));
+                    }
                 }
+
+                unpack_head(outputs.data(), batch_size, input_size, batch_index, head_index, attention_outputs_data);
             }
-        };
+        }
+    }
+
     /// @todo add dropout
 }
 
 
-void MultiheadAttentionLayer::compute_attention_output(type* transformed_value_data,
-                                                       const Tensor<Index, 1>& transformed_value_dimensions,
-                                                       type* attention_scores_data,
-                                                       const Tensor<Index, 1>& attention_scores_dimensions,
-                                                       type* attention_output_data)
-{    
-    const Index batch_size = transformed_value_dimensions(0);
+/// Computes the derivatives of the attention outputs with respect to the transformed query, key and value.
+/// The attention scores are not stored, so they are recomputed tile by tile from the logarithm of the softmax denominators.
+/// @param transformed_query_data Transformed query, with dimensions (batch, input size, depth, heads).
+/// @param transformed_key_data Transformed key, with dimensions (batch, context size, depth, heads).
+/// @param transformed_value_data Transformed value, with dimensions (batch, context size, depth, heads).
+/// @param attention_outputs_data Attention outputs, with dimensions (batch, input size, depth, heads).
+/// @param softmax_logsumexp_data Logarithm of the softmax denominator of each query, with dimensions (batch, input size, heads).
+/// @param attention_outputs_derivatives_data Derivatives of the error with respect to the attention outputs.
+/// @param batch_size Number of batch elements.
+/// @param transformed_query_derivatives_data Derivatives of the error with respect to the transformed query.
+/// @param transformed_key_derivatives_data Derivatives of the error with respect to the transformed key.
+/// @param transformed_value_derivatives_data Derivatives of the error with respect to the transformed value.
+
+void MultiheadAttentionLayer::compute_attention_outputs_derivatives(const type* transformed_query_data,
+                                                                    const type* transformed_key_data,
+                                                                    const type* transformed_value_data,
+                                                                    const type* attention_outputs_data,
+                                                                    const type* softmax_logsumexp_data,
+                                                                    const type* attention_outputs_derivatives_data,
+                                                                    const Index& batch_size,
+                                                                    type* transformed_query_derivatives_data,
+                                                                    type* transformed_key_derivatives_data,
+                                                                    type* transformed_value_derivatives_data) const
+{
+    const type scaling_factor = type(1)/sqrt(type(depth));
+
+#pragma omp parallel
+    {
+        Tensor<type, 2> query(depth, input_size);
+        Tensor<type, 2> key(depth, context_size);
+        Tensor<type, 2> value(depth, context_size);
+        Tensor<type, 2> outputs(depth, input_size);
+        Tensor<type, 2> outputs_derivatives(depth, input_size);
+
+        Tensor<type, 2> query_derivatives(depth, input_size);
+        Tensor<type, 2> key_derivatives(depth, context_size);
+        Tensor<type, 2> value_derivatives(depth, context_size);
+
+        Tensor<type, 1> scores(key_tile_size*query_tile_size);
+        Tensor<type, 1> scores_derivatives(key_tile_size*query_tile_size);
 
-    TensorMap<Tensor<type, 4>> transformed_value(transformed_value_data, batch_size, context_size, depth, number_of_heads);
-    TensorMap<Tensor<type, 4>> attention_scores(attention_scores_data, batch_size, input_size, context_size, number_of_heads);
+        Tensor<type, 1> outputs_dot_derivatives(input_size);
 
-    TensorMap<Tensor<type, 4>> attention_output(attention_output_data, batch_size, input_size, depth, number_of_heads);
+        const Eigen::array<Index, 1> depth_dimension = {0};
 
-#pragma omp parallel for collapse(2)
+#pragma omp for collapse(2)
         for(Index batch_index = 0; batch_index < batch_size; batch_index++)
         {
-            for(Index head_index = 0; head_index < number_of_heads ; head_index++)
+            for(Index head_index = 0; head_index < number_of_heads; head_index++)
             {
-                attention_output.chip(batch_index, 0).chip(head_index, 2) =
-                    attention_scores.chip(batch_index, 0).chip(head_index, 2).contract(
-                    transformed_value.chip(batch_index, 0).chip(head_index, 2), A_B);
+                pack_head(transformed_query_data, batch_size, input_size, batch_index, head_index, query.data());
+                pack_head(transformed_key_data, batch_size, context_size, batch_index, head_index, key.data());
+                pack_head(transformed_value_data, batch_size, context_size, batch_index, head_index, value.data());
+                pack_head(attention_outputs_data, batch_size, input_size, batch_index, head_index, outputs.data());
+                pack_head(attention_outputs_derivatives_data, batch_size, input_size, batch_index, head_index, outputs_derivatives.data());
+
+                outputs_dot_derivatives = (outputs*outputs_derivatives).sum(depth_dimension);
+
+                query_derivatives.setZero();
+                key_derivatives.setZero();
+                value_derivatives.setZero();
+
+                for(Index query_begin = 0; query_begin < input_size; query_begin += query_tile_size)
+                {
+                    const Index queries_number = min(query_tile_size, input_size - query_begin);
+
+                    const TensorMap<Tensor<type, 2>> query_tile(query.data() + depth*query_begin, depth, queries_number);
+                    const TensorMap<Tensor<type, 2>> outputs_derivatives_tile(outputs_derivatives.data() + depth*query_begin, depth, queries_number);
+
+                    TensorMap<Tensor<type, 2>> query_derivatives_tile(query_derivatives.data() + depth*query_begin, depth, queries_number);
+
+                    const Index keys_end = causal_mask ? min(context_size, query_begin + queries_number) : context_size;
+
+                    for(Index key_begin = 0; key_begin < keys_end; key_begin += key_tile_size)
+                    {
+                        const Index keys_number = min(key_tile_size, keys_end - key_begin);
+
+                        const TensorMap<Tensor<type, 2>> key_tile(key.data() + depth*key_begin, depth, keys_number);
+                        const TensorMap<Tensor<type, 2>> value_tile(value.data() + depth*key_begin, depth, keys_number);
+
+                        TensorMap<Tensor<type, 2>> key_derivatives_tile(key_derivatives.data() + depth*key_begin, depth, keys_number);
+                        TensorMap<Tensor<type, 2>> value_derivatives_tile(value_derivatives.data() + depth*key_begin, depth, keys_number);
+
+                        TensorMap<Tensor<type, 2>> scores_tile(scores.data(), keys_number, queries_number);
+                        TensorMap<Tensor<type, 2>> scores_derivatives_tile(scores_derivatives.data(), keys_number, queries_number);
+
+                        // Attention scores, recomputed
+
+                        scores_tile = key_tile.contract(query_tile, AT_B)*scaling_factor;
+
+                        for(Index i = 0; i < queries_number; i++)
+                        {
+                            type* scores_column = scores_tile.data() + keys_number*i;
+
+                            const Index unmasked_keys_number = causal_mask
+                                    ? max(min(keys_number, query_begin + i - key_begin + 1), Index(0))
+                                    : keys_number;
+
+                            const type logsumexp = softmax_logsumexp_data[batch_index + batch_size*(query_begin + i + input_size*head_index)];
+
+                            for(Index j = 0; j < unmasked_keys_number; j++)
+                                scores_column[j] = exp(scores_column[j] - logsumexp);
+
+                            fill(scores_column + unmasked_keys_number, scores_column + keys_number, type(0));
+                        }
+
+                        value_derivatives_tile += outputs_derivatives_tile.contract(scores_tile, A_BT);
+
+                        // Derivatives of the softmax, scaled as the scores
+
+                        scores_derivatives_tile = value_tile.contract(outputs_derivatives_tile, AT_B);
+
+                        for(Index i = 0; i < queries_number; i++)
+                        {
+                            const type* scores_column = scores_tile.data() + keys_number*i;
+
+                            type* scores_derivatives_column = scores_derivatives_tile.data() + keys_number*i;
+
+                            for(Index j = 0; j < keys_number; j++)
+                                scores_derivatives_column[j] = scores_column[j]
+                                        *(scores_derivatives_column[j] - outputs_dot_derivatives(query_begin + i))
+                                        *scaling_factor;
+                        }
+
+                        query_derivatives_tile += key_tile.contract(scores_derivatives_tile, A_B);
+
+                        key_derivatives_tile += query_tile.contract(scores_derivatives_tile, A_BT);
+                    }
+                }
+
+                unpack_head(query_derivatives.data(), batch_size, input_size, batch_index, head_index, transformed_query_derivatives_data);
+                unpack_head(key_derivatives.data(), batch_size, context_size, batch_index, head_index, transformed_key_derivatives_data);
+                unpack_head(value_derivatives.data(), batch_size, context_size, batch_index, head_index, transformed_value_derivatives_data);
             }
-        };
+        }
+    }
 }
 
 
@@ -489,6 +845,12 @@ void MultiheadAttentionLayer::forward_propagate(const Tensor<DynamicTensor<type>
     const TensorMap<Tensor<type, 3>> key = inputs(1).to_tensor_map<3>();
     const TensorMap<Tensor<type, 3>> value = inputs(2).to_tensor_map<3>();
 
+    // The inputs are only kept for back-propagation, because an inference memory plan may overwrite them
+
+    multihead_attention_layer_forward_propagation->query_data = is_training ? inputs(0).get_data() : nullptr;
+    multihead_attention_layer_forward_propagation->key_data = is_training ? inputs(1).get_data() : nullptr;
+    multihead_attention_layer_forward_propagation->value_data = is_training ? inputs(2).get_data() : nullptr;
+
     type* transformed_query_data = multihead_attention_layer_forward_propagation->get_transformed_query_data();
     type* transformed_key_data = multihead_attention_layer_forward_propagation->get_transformed_key_data();
     type* transformed_value_data = multihead_attention_layer_forward_propagation->get_transformed_value_data();
@@ -497,28 +859,14 @@ void MultiheadAttentionLayer::forward_propagate(const Tensor<DynamicTensor<type>
     calculate_key_transformation(key, transformed_key_data);
     calculate_value_transformation(value, transformed_value_data);
 
-    Tensor<Index, 1> transformed_query_dimensions(4);
-    Tensor<Index, 1> transformed_key_dimensions(4);
-    transformed_query_dimensions.setValues({batch_size, input_size, depth, number_of_heads});
-    transformed_key_dimensions.setValues({batch_size, context_size, depth, number_of_heads});
-
-    type* attention_scores_data = multihead_attention_layer_forward_propagation->get_attention_scores_data();
-
-    compute_attention_scores(transformed_query_data,
-                             transformed_query_dimensions,
-                             transformed_key_data,
-                             transformed_key_dimensions,
-                             attention_scores_data);
-
-    const Tensor<Index, 1> attention_scores_dimensions = get_dimensions(multihead_attention_layer_forward_propagation->attention_scores);
-
     type* attention_outputs_data = multihead_attention_layer_forward_propagation->get_attention_outputs_data();
 
-    compute_attention_output(transformed_value_data,
-                             transformed_key_dimensions,
-                             attention_scores_data,
-                             attention_scores_dimensions,
-                             attention_outputs_data);
+    compute_attention_outputs(transformed_query_data,
+                              transformed_key_data,
+                              transformed_value_data,
+                              batch_size,
+                              attention_outputs_data,
+                              multihead_attention_layer_forward_propagation->get_softmax_logsumexp_data());
 
     const TensorMap<Tensor<type, 4>> attention_outputs(attention_outputs_data, batch_size, input_size, depth, number_of_heads);
 
@@ -527,6 +875,237 @@ void MultiheadAttentionLayer::forward_propagate(const Tensor<DynamicTensor<type>
 }
 
 
+/// Back-propagates the derivatives of the attention outputs, stored in the back-propagation structure,
+/// to the transformed query, key and value.
+/// @param forward_propagation Forward propagation of the layer, with the attention outputs of the batch.
+/// @param back_propagation Back-propagation of the layer.
+
+void MultiheadAttentionLayer::calculate_attention_derivatives(LayerForwardPropagation* forward_propagation,
+                                                              LayerBackPropagation* back_propagation) const
+{
+    MultiheadAttentionLayerForwardPropagation* multihead_attention_layer_forward_propagation
+        = static_cast<MultiheadAttentionLayerForwardPropagation*>(forward_propagation);
+
+    MultiheadAttentionLayerBackPropagation* multihead_attention_layer_back_propagation
+        = static_cast<MultiheadAttentionLayerBackPropagation*>(back_propagation);
+
+    compute_attention_outputs_derivatives(multihead_attention_layer_forward_propagation->get_transformed_query_data(),
+                                          multihead_attention_layer_forward_propagation->get_transformed_key_data(),
+                                          multihead_attention_layer_forward_propagation->get_transformed_value_data(),
+                                          multihead_attention_layer_forward_propagation->get_attention_outputs_data(),
+                                          multihead_attention_layer_forward_propagation->get_softmax_logsumexp_data(),
+                                          multihead_attention_layer_back_propagation->attention_outputs_derivatives.data(),
+                                          multihead_attention_layer_forward_propagation->batch_samples_number,
+                                          multihead_attention_layer_back_propagation->transformed_query_derivatives.data(),
+                                          multihead_attention_layer_back_propagation->transformed_key_derivatives.data(),
+                                          multihead_attention_layer_back_propagation->transformed_value_derivatives.data());
+}
+
+
+/// Calculates the derivatives of the error with respect to the query, key and value, from the deltas of the outputs.
+/// The deltas go back through the projection kernel to the attention outputs, then through the attention
+/// to the transformed query, key and value, and from these through the transformation kernels.
+/// It is called once the deltas are complete, before the layers which feed this one calculate their deltas,
+/// and the derivatives of the transformed query, key and value are then reused by calculate_error_gradient.
+
+void MultiheadAttentionLayer::calculate_inputs_derivatives(LayerForwardPropagation* forward_propagation,
+                                                           LayerBackPropagation* back_propagation) const
+{
+    MultiheadAttentionLayerBackPropagation* multihead_attention_layer_back_propagation
+        = static_cast<MultiheadAttentionLayerBackPropagation*>(back_propagation);
+
+    const Index batch_size = forward_propagation->batch_samples_number;
+
+    const TensorMap<Tensor<type, 3>> deltas(back_propagation->deltas_data, batch_size, input_size, depth);
+
+    // Attention outputs
+
+    multihead_attention_layer_back_propagation->attention_outputs_derivatives.device(*thread_pool_device)
+        = deltas.contract(projection_kernel, Eigen::array<IndexPair<Index>, 1>({IndexPair<Index>(2, 1)}));
+
+    calculate_attention_derivatives(forward_propagation, back_propagation);
+
+    // Query, key and value, summing over the depth and the heads of the transformations
+
+    const Eigen::array<IndexPair<Index>, 2> depth_heads_contraction = {IndexPair<Index>(2, 1), IndexPair<Index>(3, 2)};
+
+    multihead_attention_layer_back_propagation->query_derivatives.device(*thread_pool_device)
+        = multihead_attention_layer_back_propagation->transformed_query_derivatives.contract(query_kernel, depth_heads_contraction);
+
+    multihead_attention_layer_back_propagation->key_derivatives.device(*thread_pool_device)
+        = multihead_attention_layer_back_propagation->transformed_key_derivatives.contract(key_kernel, depth_heads_contraction);
+
+    multihead_attention_layer_back_propagation->value_derivatives.device(*thread_pool_device)
+        = multihead_attention_layer_back_propagation->transformed_value_derivatives.contract(value_kernel, depth_heads_contraction);
+}
+
+
+/// Calculates the deltas of a layer which feeds this one, as the sum of the derivatives of the inputs it gives.
+/// A layer which gives the query, key and value of a self-attention gets the three derivatives at once.
+/// @param input_layer_pointer Layer which feeds this one.
+/// @param forward_propagation Forward propagation of this layer.
+/// @param back_propagation Back-propagation of this layer, with the derivatives of calculate_inputs_derivatives.
+/// @param input_layer_back_propagation Back-propagation of the layer which feeds this one.
+
+void MultiheadAttentionLayer::calculate_input_layer_deltas(const Layer* input_layer_pointer,
+                                                           LayerForwardPropagation* forward_propagation,
+                                                           LayerBackPropagation* back_propagation,
+                                                           LayerBackPropagation* input_layer_back_propagation) const
+{
+    const MultiheadAttentionLayerForwardPropagation* multihead_attention_layer_forward_propagation
+        = static_cast<MultiheadAttentionLayerForwardPropagation*>(forward_propagation);
+
+    const MultiheadAttentionLayerBackPropagation* multihead_attention_layer_back_propagation
+        = static_cast<MultiheadAttentionLayerBackPropagation*>(back_propagation);
+
+    const Tensor<const Layer*, 1>& inputs_layers_pointers = multihead_attention_layer_forward_propagation->inputs_layers_pointers;
+
+    const Tensor<Index, 0> deltas_size = input_layer_back_propagation->deltas_dimensions.prod();
+
+    TensorMap<Tensor<type, 1>> deltas(input_layer_back_propagation->deltas_data, deltas_size(0));
+
+    deltas.setZero();
+
+    Index input_index = 0;
+
+    for(const Tensor<type, 3>* inputs_derivatives : {&multihead_attention_layer_back_propagation->query_derivatives,
+                                                     &multihead_attention_layer_back_propagation->key_derivatives,
+                                                     &multihead_attention_layer_back_propagation->value_derivatives})
+    {
+        if(inputs_layers_pointers(input_index++) != input_layer_pointer) continue;
+
+        if(inputs_derivatives->size() != deltas_size(0))
+        {
+            ostringstream buffer;
+
+            buffer << "OpenNN Exception: MultiheadAttentionLayer class.\n"
+                   << "void calculate_input_layer_deltas(const Layer*, LayerForwardPropagation*, LayerBackPropagation*, LayerBackPropagation*) const method.\n"
+                   << "Size of deltas (" << deltas_size(0) << ") must be equal to size of inputs derivatives (" << inputs_derivatives->size() << ").\n";
+
+            throw invalid_argument(buffer.str());
+        }
+
+        deltas.device(*thread_pool_device) += TensorMap<const Tensor<type, 1>>(inputs_derivatives->data(), deltas_size(0));
+    }
+}
+
+
+/// Calculates the deltas of this layer from the next layer, which can only be another multihead attention layer.
+
+void MultiheadAttentionLayer::calculate_hidden_delta(LayerForwardPropagation* next_layer_forward_propagation,
+                                                     LayerBackPropagation* next_layer_back_propagation,
+                                                     LayerBackPropagation* layer_back_propagation) const
+{
+    switch(next_layer_back_propagation->layer_pointer->get_type())
+    {
+    case Type::MultiheadAttention:
+    {
+        const MultiheadAttentionLayer* next_multihead_attention_layer_pointer
+                = static_cast<MultiheadAttentionLayer*>(next_layer_back_propagation->layer_pointer);
+
+        next_multihead_attention_layer_pointer->calculate_input_layer_deltas(this,
+                                                                             next_layer_forward_propagation,
+                                                                             next_layer_back_propagation,
+                                                                             layer_back_propagation);
+    }
+        break;
+
+    default:
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: MultiheadAttentionLayer class.\n"
+               << "void calculate_hidden_delta(LayerForwardPropagation*, LayerBackPropagation*, LayerBackPropagation*) const method.\n"
+               << "Next layer type (" << next_layer_back_propagation->layer_pointer->get_type_string() << ") is not supported.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+    }
+}
+
+
+/// Calculates the derivatives of the error with respect to the kernels, from the deltas of the outputs
+/// and the derivatives of the transformed query, key and value, which calculate_inputs_derivatives must have calculated.
+/// The query, key and value are those of the last forward propagation, which must have been a training one,
+/// so the first argument is not used.
+
+void MultiheadAttentionLayer::calculate_error_gradient(type*,
+                                                       LayerForwardPropagation* forward_propagation,
+                                                       LayerBackPropagation* back_propagation) const
+{
+    MultiheadAttentionLayerForwardPropagation* multihead_attention_layer_forward_propagation
+        = static_cast<MultiheadAttentionLayerForwardPropagation*>(forward_propagation);
+
+    MultiheadAttentionLayerBackPropagation* multihead_attention_layer_back_propagation
+        = static_cast<MultiheadAttentionLayerBackPropagation*>(back_propagation);
+
+    if(multihead_attention_layer_forward_propagation->query_data == nullptr)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: MultiheadAttentionLayer class.\n"
+               << "void calculate_error_gradient(type*, LayerForwardPropagation*, LayerBackPropagation*) const method.\n"
+               << "The forward propagation has no inputs, because it was not a training one.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    const Index batch_size = multihead_attention_layer_forward_propagation->batch_samples_number;
+
+    const TensorMap<Tensor<type, 3>> query(multihead_attention_layer_forward_propagation->query_data, batch_size, input_size, depth);
+    const TensorMap<Tensor<type, 3>> key(multihead_attention_layer_forward_propagation->key_data, batch_size, context_size, depth);
+    const TensorMap<Tensor<type, 3>> value(multihead_attention_layer_forward_propagation->value_data, batch_size, context_size, depth);
+
+    const TensorMap<Tensor<type, 3>> deltas(back_propagation->deltas_data, batch_size, input_size, depth);
+
+    const TensorMap<Tensor<type, 4>> attention_outputs(multihead_attention_layer_forward_propagation->get_attention_outputs_data(),
+                                                       batch_size, input_size, depth, number_of_heads);
+
+    // Sum over the batch and the rows of the sequence
+
+    const Eigen::array<IndexPair<Index>, 2> batch_rows_contraction = {IndexPair<Index>(0, 0), IndexPair<Index>(1, 1)};
+
+    // Projection kernel, with dimensions (depth, depth, heads) from the contraction (depth, heads, depth)
+
+    multihead_attention_layer_back_propagation->projection_kernel_derivatives.device(*thread_pool_device)
+        = attention_outputs.contract(deltas, batch_rows_contraction).shuffle(Eigen::array<Index, 3>({0, 2, 1}));
+
+    // Transformation kernels
+
+    multihead_attention_layer_back_propagation->query_kernel_derivatives.device(*thread_pool_device)
+        = query.contract(multihead_attention_layer_back_propagation->transformed_query_derivatives, batch_rows_contraction);
+
+    multihead_attention_layer_back_propagation->key_kernel_derivatives.device(*thread_pool_device)
+        = key.contract(multihead_attention_layer_back_propagation->transformed_key_derivatives, batch_rows_contraction);
+
+    multihead_attention_layer_back_propagation->value_kernel_derivatives.device(*thread_pool_device)
+        = value.contract(multihead_attention_layer_back_propagation->transformed_value_derivatives, batch_rows_contraction);
+}
+
+
+/// Copies the derivatives of the kernels into the gradient, in the order of get_parameters().
+
+void MultiheadAttentionLayer::insert_gradient(LayerBackPropagation* back_propagation,
+                                              const Index& index,
+                                              Tensor<type, 1>& gradient) const
+{
+    const MultiheadAttentionLayerBackPropagation* multihead_attention_layer_back_propagation
+        = static_cast<MultiheadAttentionLayerBackPropagation*>(back_propagation);
+
+    Index kernel_index = index;
+
+    for(const Tensor<type, 3>* kernel_derivatives : {&multihead_attention_layer_back_propagation->query_kernel_derivatives,
+                                                     &multihead_attention_layer_back_propagation->key_kernel_derivatives,
+                                                     &multihead_attention_layer_back_propagation->value_kernel_derivatives,
+                                                     &multihead_attention_layer_back_propagation->projection_kernel_derivatives})
+    {
+        copy(kernel_derivatives->data(), kernel_derivatives->data() + kernel_derivatives->size(), gradient.data() + kernel_index);
+
+        kernel_index += kernel_derivatives->size();
+    }
+}
+
+
 /*
 void PerceptronLayer::forward_propagate(type* inputs_data,
                                         const Tensor<Index, 1>& inputs_dimensions,
@@ -11,10 +11,12 @@
 
 // System includes
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <string>
 #include <sstream>
 
@@ -46,6 +48,10 @@ struct MultiheadAttentionLayerBackPropagationLM;
 /// In between there is an attention computation.
 ///
 /// Layers of Multihead Attention will be used to construct Transformer models .
+///
+/// The attention is computed in tiles of queries and keys with a streaming softmax,
+/// so the matrix of attention scores is never stored and memory grows linearly with the sequence length.
+/// Only the logarithm of the softmax denominator of each query is kept, and the backward pass recomputes the tiles from it.
 
 class MultiheadAttentionLayer : public Layer
 
@@ -82,6 +88,12 @@ public:
     Tensor<type, 3> get_projection_kernel() const;
 
     Index get_parameters_number() const final;
+    Tensor<type, 1> get_parameters() const final;
+
+    const bool& get_causal_mask() const;
+
+    const Index& get_query_tile_size() const;
+    const Index& get_key_tile_size() const;
 
     // Display messages
 
@@ -103,10 +115,15 @@ public:
     void set_number_of_heads(const Index&);
 
     void set_kernels();
+    void set_parameters(const Tensor<type, 1>&, const Index&) final;
     void set_parameters_random() final;
 
     void set_dropout_rate(const type&);
 
+    void set_causal_mask(const bool&);
+
+    void set_tile_sizes(const Index&, const Index&);
+
     // Display messages
 
     void set_display(const bool&);
@@ -121,9 +138,12 @@ public:
 
     // Attention computation
 
-    void compute_attention_scores(type*, const Tensor<Index, 1>&, type*, const Tensor<Index, 1>&, type*); /// Softmax before saving
+    void compute_attention_outputs(const type*, const type*, const type*, const Index&, type*, type*) const;
 
-    void compute_attention_output(type*, const Tensor<Index, 1>&, type*, const Tensor<Index, 1>&, type*);
+    void compute_attention_outputs_derivatives(const type*, const type*, const type*,
+                                               const type*, const type*, const type*,
+                                               const Index&,
+                                               type*, type*, type*) const;
 
     // Multihead Attention layer outputs
 
@@ -131,6 +151,26 @@ public:
                            LayerForwardPropagation*,
                            const bool&) final;
 
+    // Multihead Attention layer derivatives
+
+    void calculate_attention_derivatives(LayerForwardPropagation*, LayerBackPropagation*) const;
+
+    void calculate_inputs_derivatives(LayerForwardPropagation*, LayerBackPropagation*) const final;
+
+    // Delta methods
+
+    void calculate_input_layer_deltas(const Layer*, LayerForwardPropagation*, LayerBackPropagation*, LayerBackPropagation*) const;
+
+    void calculate_hidden_delta(LayerForwardPropagation*, LayerBackPropagation*, LayerBackPropagation*) const final;
+
+    // Gradient methods
+
+    void calculate_error_gradient(type*,
+                                  LayerForwardPropagation*,
+                                  LayerBackPropagation*) const final;
+
+    void insert_gradient(LayerBackPropagation*, const Index&, Tensor<type, 1>&) const final;
+
 /*
     void forward_propagate(type*,
                            const Tensor<Index, 1>&,
@@ -183,10 +223,28 @@ protected:
 
     type dropout_rate = type(0);
 
+    /// Whether each query only attends to the keys at the same or earlier positions.
+
+    bool causal_mask = false;
+
+    /// Number of queries of a tile.
+
+    Index query_tile_size = 64;
+
+    /// Number of keys of a tile.
+
+    Index key_tile_size = 64;
+
     /// Display messages to screen.
 
     bool display = true;
 
+private:
+
+    void pack_head(const type*, const Index&, const Index&, const Index&, const Index&, type*) const;
+
+    void unpack_head(const type*, const Index&, const Index&, const Index&, const Index&, type*) const;
+
 #ifdef OPENNN_CUDA
 #include "../../opennn-cuda/opennn-cuda/perceptron_layer_cuda.h"
 #else
@@ -214,17 +272,19 @@ protected:
 
         void set(const Index& new_batch_samples_number, Layer* new_layer_pointer) final
         {
-            MultiheadAttentionLayer* layer_pointer = static_cast<MultiheadAttentionLayer*>(new_layer_pointer);
+            layer_pointer = new_layer_pointer;
 
             batch_samples_number = new_batch_samples_number;
 
-            const Index input_size = layer_pointer->get_input_size();
+            const MultiheadAttentionLayer* multihead_attention_layer_pointer = static_cast<MultiheadAttentionLayer*>(layer_pointer);
+
+            const Index input_size = multihead_attention_layer_pointer->get_input_size();
 
-            const Index context_size = layer_pointer->get_context_size();
+            const Index context_size = multihead_attention_layer_pointer->get_context_size();
 
-            const Index depth = layer_pointer->get_depth();
+            const Index depth = multihead_attention_layer_pointer->get_depth();
 
-            const Index number_of_heads = layer_pointer->get_number_of_heads();
+            const Index number_of_heads = multihead_attention_layer_pointer->get_number_of_heads();
 
             // Outputs
 
@@ -239,8 +299,12 @@ protected:
             transformed_key.resize(new_batch_samples_number, context_size, depth, number_of_heads);
             transformed_value.resize(new_batch_samples_number, context_size, depth, number_of_heads);
 
-            attention_scores.resize(new_batch_samples_number, input_size, context_size, number_of_heads);
             attention_outputs.resize(new_batch_samples_number, input_size, depth, number_of_heads);
+
+            softmax_logsumexp.resize(new_batch_samples_number, input_size, number_of_heads);
+
+            inputs_layers_pointers.resize(3);
+            inputs_layers_pointers.setConstant(nullptr);
         }
 
         void print() const
@@ -274,9 +338,9 @@ protected:
             return transformed_value.data();
         }
 
-        type* get_attention_scores_data()
+        type* get_softmax_logsumexp_data()
         {
-            return attention_scores.data();
+            return softmax_logsumexp.data();
         }
 
         type* get_attention_outputs_data()
@@ -284,12 +348,28 @@ protected:
             return attention_outputs.data();
         }
 
+        /// Query, key and value of the batch, from which the derivatives of the transformation kernels are calculated.
+        /// They are only kept by a training forward propagation, whose memory plan does not reuse the outputs of any layer.
+        /// An inference forward propagation leaves them null, because its inputs may be overwritten by later layers.
+
+        type* query_data = nullptr;
+        type* key_data = nullptr;
+        type* value_data = nullptr;
+
+        /// Layers whose outputs are the query, key and value, set by the neural network.
+        /// A layer which feeds the query, key or value takes the derivatives of those inputs as its deltas.
+
+        Tensor<const Layer*, 1> inputs_layers_pointers;
+
         Tensor<type, 4> transformed_query;
         Tensor<type, 4> transformed_key;
         Tensor<type, 4> transformed_value;
 
-        Tensor<type, 4> attention_scores;
         Tensor<type, 4> attention_outputs;
+
+        /// Logarithm of the softmax denominator of each query, from which the attention scores are recomputed.
+
+        Tensor<type, 3> softmax_logsumexp;
     };
 
 
@@ -372,52 +452,68 @@ protected:
 
             batch_samples_number = new_batch_samples_number;
 
-            const Index neurons_number = layer_pointer->get_neurons_number();
-            const Index inputs_number = layer_pointer->get_inputs_number();
+            const MultiheadAttentionLayer* multihead_attention_layer_pointer = static_cast<MultiheadAttentionLayer*>(layer_pointer);
 
-            deltas_dimensions.resize(2);
-            deltas_dimensions.setValues({batch_samples_number, neurons_number});
+            const Index input_size = multihead_attention_layer_pointer->get_input_size();
+            const Index context_size = multihead_attention_layer_pointer->get_context_size();
+            const Index depth = multihead_attention_layer_pointer->get_depth();
+            const Index number_of_heads = multihead_attention_layer_pointer->get_number_of_heads();
 
-            deltas_data = (type*)malloc( static_cast<size_t>(batch_samples_number*neurons_number*sizeof(type)));
+            deltas_dimensions.resize(3);
+            deltas_dimensions.setValues({batch_samples_number, input_size, depth});
 
-            biases_derivatives.resize(neurons_number);
+            deltas_data = (type*)malloc(static_cast<size_t>(batch_samples_number*input_size*depth*sizeof(type)));
 
-            synaptic_weights_derivatives.resize(inputs_number, neurons_number);
+            attention_outputs_derivatives.resize(batch_samples_number, input_size, depth, number_of_heads);
 
-            deltas_times_activations_derivatives.resize(batch_samples_number, neurons_number);
-        }
+            transformed_query_derivatives.resize(batch_samples_number, input_size, depth, number_of_heads);
+            transformed_key_derivatives.resize(batch_samples_number, context_size, depth, number_of_heads);
+            transformed_value_derivatives.resize(batch_samples_number, context_size, depth, number_of_heads);
 
-        Tensor< TensorMap< Tensor<type, 1> >*, 1> get_layer_gradient()
-        {
-            Tensor< TensorMap< Tensor<type, 1> >*, 1> layer_gradient(2);
-
-            const Index inputs_number = layer_pointer->get_inputs_number();
-            const Index neurons_number = layer_pointer->get_neurons_number();
+            query_kernel_derivatives.resize(depth, depth, number_of_heads);
+            key_kernel_derivatives.resize(depth, depth, number_of_heads);
+            value_kernel_derivatives.resize(depth, depth, number_of_heads);
 
-            layer_gradient(0) = new TensorMap<Tensor<type, 1>>(biases_derivatives.data(), neurons_number);
-            layer_gradient(1) = new TensorMap<Tensor<type, 1>>(synaptic_weights_derivatives.data(), inputs_number*neurons_number);
+            projection_kernel_derivatives.resize(depth, depth, number_of_heads);
 
-            return layer_gradient;
+            query_derivatives.resize(batch_samples_number, input_size, depth);
+            key_derivatives.resize(batch_samples_number, context_size, depth);
+            value_derivatives.resize(batch_samples_number, context_size, depth);
         }
 
 
         void print() const
         {
-            cout << "Deltas:" << endl;
-            //cout << deltas << endl;
+            cout << "Transformed query derivatives:" << endl;
+            cout << transformed_query_derivatives << endl;
+
+            cout << "Transformed key derivatives:" << endl;
+            cout << transformed_key_derivatives << endl;
 
-            cout << "Biases derivatives:" << endl;
-            cout << biases_derivatives << endl;
+            cout << "Transformed value derivatives:" << endl;
+            cout << transformed_value_derivatives << endl;
 
-            cout << "Synaptic weights derivatives:" << endl;
-            cout << synaptic_weights_derivatives << endl;
+            cout << "Projection kernel derivatives:" << endl;
+            cout << projection_kernel_derivatives << endl;
         }
 
-        Tensor<type, 1> biases_derivatives;
-        Tensor<type, 2> synaptic_weights_derivatives;
+        Tensor<type, 4> attention_outputs_derivatives;
+
+        Tensor<type, 4> transformed_query_derivatives;
+        Tensor<type, 4> transformed_key_derivatives;
+        Tensor<type, 4> transformed_value_derivatives;
+
+        Tensor<type, 3> query_kernel_derivatives;
+        Tensor<type, 3> key_kernel_derivatives;
+        Tensor<type, 3> value_kernel_derivatives;
+
+        Tensor<type, 3> projection_kernel_derivatives;
 
-        Tensor<type, 2> deltas_times_activations_derivatives;
+        /// Derivatives of the error with respect to the query, key and value, which are the deltas of the layers which feed them.
 
+        Tensor<type, 3> query_derivatives;
+        Tensor<type, 3> key_derivatives;
+        Tensor<type, 3> value_derivatives;
     };
 
 }
@@ -86,6 +86,8 @@ NeuralNetwork::NeuralNetwork(const Tensor<Layer*, 1>& new_layers_pointers)
     set();
 
     layers_pointers = new_layers_pointers;
+
+    allocate_parameters_arena();
 }
 
 
@@ -113,6 +115,7 @@ void NeuralNetwork::delete_layers()
 
 
 /// Add a new layer to the Neural Network model.
+/// If the layer has parameters, the parameters of all the trainable layers are moved to a new parameters arena.
 /// @param layer The layer that will be added.
 
 void NeuralNetwork::add_layer(Layer* layer_pointer)
@@ -164,6 +167,13 @@ void NeuralNetwork::add_layer(Layer* layer_pointer)
 
             layers_inputs_indices(old_layers_number) = new_layer_inputs_indices;
         }
+
+        // The parameters arena is built as the layers are added, so that it is ready before any training
+
+        if(layer_type != Layer::Type::Scaling
+        && layer_type != Layer::Type::Unscaling
+        && layer_type != Layer::Type::Bounding)
+            allocate_parameters_arena();
     }
     else
     {
@@ -265,6 +275,22 @@ bool NeuralNetwork::has_flatten_layer() const
 }
 
 
+/// Returns true if the neural network object has an embedding layer object inside,
+/// and false otherwise.
+
+bool NeuralNetwork::has_embedding_layer() const
+{
+    const Index layers_number = get_layers_number();
+
+    for(Index i = 0; i < layers_number; i++)
+    {
+        if(layers_pointers[i]->get_type() == Layer::Type::Embedding) return true;
+    }
+
+    return false;
+}
+
+
 
 /// Returns true if the neural network object has a recurrent layer object inside,
 /// and false otherwise.
@@ -521,9 +547,155 @@ Tensor<Index, 1> NeuralNetwork::get_trainable_layers_indices() const
 }
 
 
+/// Returns the indices of the layers whose outputs are the inputs of each layer.
+/// A layer without indices reads the inputs of the network.
+/// If the indices have not been set, each layer reads the outputs of the previous one.
+
 Tensor<Tensor<Index, 1>, 1> NeuralNetwork::get_layers_inputs_indices() const
 {
-    return layers_inputs_indices;
+    const Index layers_number = get_layers_number();
+
+    if(layers_inputs_indices.size() == layers_number) return layers_inputs_indices;
+
+    Tensor<Tensor<Index, 1>, 1> sequential_layers_inputs_indices(layers_number);
+
+    for(Index i = 1; i < layers_number; i++)
+    {
+        sequential_layers_inputs_indices(i).resize(1);
+        sequential_layers_inputs_indices(i)(0) = i-1;
+    }
+
+    return sequential_layers_inputs_indices;
+}
+
+
+/// Returns the indices of the layers which read the outputs of each layer.
+/// The layers which are not read by any other one give the outputs of the network.
+
+Tensor<Tensor<Index, 1>, 1> NeuralNetwork::get_layers_outputs_indices() const
+{
+    const Index layers_number = get_layers_number();
+
+    const Tensor<Tensor<Index, 1>, 1> inputs_indices = get_layers_inputs_indices();
+
+    Tensor<Index, 1> outputs_numbers(layers_number);
+    outputs_numbers.setZero();
+
+    for(Index i = 0; i < layers_number; i++)
+    {
+        for(Index j = 0; j < inputs_indices(i).size(); j++)
+        {
+            const Index input_index = inputs_indices(i)(j);
+
+            if(input_index < 0 || input_index >= layers_number || input_index == i)
+            {
+                ostringstream buffer;
+
+                buffer << "OpenNN Exception: NeuralNetwork class.\n"
+                       << "Tensor<Tensor<Index, 1>, 1> get_layers_outputs_indices() const method.\n"
+                       << "Input " << input_index << " of layer " << i << " is not a valid layer index.\n";
+
+                throw invalid_argument(buffer.str());
+            }
+
+            outputs_numbers(input_index)++;
+        }
+    }
+
+    Tensor<Tensor<Index, 1>, 1> outputs_indices(layers_number);
+
+    for(Index i = 0; i < layers_number; i++)
+    {
+        outputs_indices(i).resize(outputs_numbers(i));
+    }
+
+    outputs_numbers.setZero();
+
+    for(Index i = 0; i < layers_number; i++)
+    {
+        for(Index j = 0; j < inputs_indices(i).size(); j++)
+        {
+            const Index input_index = inputs_indices(i)(j);
+
+            outputs_indices(input_index)(outputs_numbers(input_index)++) = i;
+        }
+    }
+
+    return outputs_indices;
+}
+
+
+/// Sorts the layers topologically, from the inputs indices of each layer.
+/// Returns the layers grouped in levels. The layers of a level only read the outputs of layers of previous levels,
+/// so they can be calculated concurrently. Within each level, the indices are sorted in ascending order.
+
+Tensor<Tensor<Index, 1>, 1> NeuralNetwork::get_layers_execution_levels() const
+{
+    const Index layers_number = get_layers_number();
+
+    const Tensor<Tensor<Index, 1>, 1> inputs_indices = get_layers_inputs_indices();
+    const Tensor<Tensor<Index, 1>, 1> outputs_indices = get_layers_outputs_indices();
+
+    // Kahn's algorithm, one level at a time
+
+    Tensor<Index, 1> pending_inputs_numbers(layers_number);
+
+    for(Index i = 0; i < layers_number; i++) pending_inputs_numbers(i) = inputs_indices(i).size();
+
+    vector<Tensor<Index, 1>> levels;
+
+    vector<Index> current_level;
+
+    for(Index i = 0; i < layers_number; i++)
+    {
+        if(pending_inputs_numbers(i) == 0) current_level.push_back(i);
+    }
+
+    Index sorted_layers_number = 0;
+
+    while(!current_level.empty())
+    {
+        Tensor<Index, 1> level(static_cast<Index>(current_level.size()));
+
+        copy(current_level.begin(), current_level.end(), level.data());
+
+        levels.push_back(level);
+
+        sorted_layers_number += level.size();
+
+        vector<Index> next_level;
+
+        for(const Index& layer_index : current_level)
+        {
+            for(Index j = 0; j < outputs_indices(layer_index).size(); j++)
+            {
+                const Index output_index = outputs_indices(layer_index)(j);
+
+                if(--pending_inputs_numbers(output_index) == 0) next_level.push_back(output_index);
+            }
+        }
+
+        sort(next_level.begin(), next_level.end());
+
+        current_level.swap(next_level);
+    }
+
+    if(sorted_layers_number != layers_number)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: NeuralNetwork class.\n"
+               << "Tensor<Tensor<Index, 1>, 1> get_layers_execution_levels() const method.\n"
+               << "The inputs of the layers form a cycle.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    Tensor<Tensor<Index, 1>, 1> execution_levels(static_cast<Index>(levels.size()));
+
+    for(size_t i = 0; i < levels.size(); i++) execution_levels(static_cast<Index>(i)) = levels[i];
+
+    return execution_levels;
 }
 
 
@@ -1058,6 +1230,8 @@ void NeuralNetwork::set_inputs_number(const Index& new_inputs_number)
     if(trainable_layers_number > 0)
     {
         trainable_layers_pointers[0]->set_inputs_number(new_inputs_number);
+
+        allocate_parameters_arena();
     }
 }
 
@@ -1118,20 +1292,22 @@ void NeuralNetwork::set_default()
 }
 
 
+/// Sets the number of threads used by the library.
+/// All the layers, loss indices, optimization algorithms and data sets share the same thread pool,
+/// so the new number of threads applies to all of them.
+/// @param new_threads_number Number of threads.
+
 void NeuralNetwork::set_threads_number(const int& new_threads_number)
 {
-    const Index layers_number = get_layers_number();
-
-    for(Index i = 0; i < layers_number; i++)
-    {
-        layers_pointers(i)->set_threads_number(new_threads_number);
-    }
+    ExecutionContext::set_threads_number(new_threads_number);
 }
 
 
 void NeuralNetwork::set_layers_pointers(Tensor<Layer*, 1>& new_layers_pointers)
 {
     layers_pointers = new_layers_pointers;
+
+    allocate_parameters_arena();
 }
 
 
@@ -1349,6 +1525,15 @@ Tensor<type, 1> NeuralNetwork::get_parameters() const
 
     Tensor<type, 1> parameters(parameters_number);
 
+    const type* parameters_data = get_parameters_data();
+
+    if(parameters_data != nullptr)
+    {
+        copy(parameters_data, parameters_data + parameters_number, parameters.data());
+
+        return parameters;
+    }
+
     const Index trainable_layers_number = get_trainable_layers_number();
 
     const Tensor<Layer*, 1> trainable_layers_pointers = get_trainable_layers_pointers();
@@ -1371,6 +1556,42 @@ Tensor<type, 1> NeuralNetwork::get_parameters() const
 }
 
 
+/// Returns a pointer to the parameters of the neural network if all the trainable layers hold views of
+/// consecutive blocks of a single vector, which is the case after allocate_parameters_arena().
+/// The layout is the same as that of get_parameters().
+/// Otherwise, for instance when a layer has been resized or does not support views, it returns nullptr.
+
+type* NeuralNetwork::get_parameters_data() const
+{
+    const Index trainable_layers_number = get_trainable_layers_number();
+
+    const Tensor<Layer*, 1> trainable_layers_pointers = get_trainable_layers_pointers();
+
+    type* parameters_data = nullptr;
+
+    Index index = 0;
+
+    for(Index i = 0; i < trainable_layers_number; i++)
+    {
+        const Index layer_parameters_number = trainable_layers_pointers(i)->get_parameters_number();
+
+        if(layer_parameters_number == 0) continue;
+
+        type* layer_parameters_data = trainable_layers_pointers(i)->get_parameters_data();
+
+        if(layer_parameters_data == nullptr) return nullptr;
+
+        if(parameters_data == nullptr) parameters_data = layer_parameters_data;
+
+        if(layer_parameters_data != parameters_data + index) return nullptr;
+
+        index += layer_parameters_number;
+    }
+
+    return parameters_data;
+}
+
+
 Tensor<Index, 1> NeuralNetwork::get_trainable_layers_parameters_numbers() const
 {
     const Index trainable_layers_number = get_trainable_layers_number();
@@ -1555,6 +1776,16 @@ void NeuralNetwork::set_parameters(Tensor<type, 1>& new_parameters) const
 
 #endif
 
+    type* parameters_data = get_parameters_data();
+
+    if(parameters_data != nullptr)
+    {
+        if(new_parameters.data() != parameters_data)
+            copy(new_parameters.data(), new_parameters.data() + get_parameters_number(), parameters_data);
+
+        return;
+    }
+
     const Index trainable_layers_number = get_trainable_layers_number();
 
     const Tensor<Layer*, 1> trainable_layers_pointers = get_trainable_layers_pointers();
@@ -1576,6 +1807,146 @@ void NeuralNetwork::set_parameters(Tensor<type, 1>& new_parameters) const
 }
 
 
+/// Sets the parameters of the neural network from a view of a vector.
+/// If the view is the parameters arena of the neural network itself, as the optimizers use it, nothing is copied.
+/// @param new_parameters View of the new parameters, with the layout of get_parameters().
+
+void NeuralNetwork::set_parameters(const TensorMap<Tensor<type, 1>>& new_parameters) const
+{
+    type* parameters_data = get_parameters_data();
+
+    if(parameters_data != nullptr)
+    {
+        if(new_parameters.data() != parameters_data)
+            copy(new_parameters.data(), new_parameters.data() + get_parameters_number(), parameters_data);
+
+        return;
+    }
+
+    Tensor<type, 1> parameters = new_parameters;
+
+    set_parameters(parameters);
+}
+
+
+/// Moves the parameters of all the trainable layers to a single vector owned by the neural network.
+/// The vector starts at a cache line boundary, and each layer keeps views of its own consecutive block,
+/// so that the parameters can be read, written and updated as a whole without gathering or scattering them.
+/// If some trainable layer with parameters cannot hold views, the layers are left as they are.
+
+void NeuralNetwork::allocate_parameters_arena()
+{
+    const Index trainable_layers_number = get_trainable_layers_number();
+
+    const Tensor<Layer*, 1> trainable_layers_pointers = get_trainable_layers_pointers();
+
+    for(Index i = 0; i < trainable_layers_number; i++)
+    {
+        if(trainable_layers_pointers(i)->get_parameters_number() != 0
+        && trainable_layers_pointers(i)->get_parameters_data() == nullptr)
+            return;
+    }
+
+    const Index parameters_number = get_parameters_number();
+
+    // Some room at the beginning, so that the parameters can start at a cache line
+
+    const size_t cache_line_size = 64;
+
+    Tensor<type, 1> new_parameters_arena(parameters_number + static_cast<Index>(cache_line_size/sizeof(type)));
+
+    void* arena_data = new_parameters_arena.data();
+
+    size_t arena_size = static_cast<size_t>(new_parameters_arena.size())*sizeof(type);
+
+    type* parameters_data = static_cast<type*>(std::align(cache_line_size, static_cast<size_t>(parameters_number)*sizeof(type), arena_data, arena_size));
+
+    Index index = 0;
+
+    for(Index i = 0; i < trainable_layers_number; i++)
+    {
+        const Index layer_parameters_number = trainable_layers_pointers(i)->get_parameters_number();
+
+        if(layer_parameters_number == 0) continue;
+
+        trainable_layers_pointers(i)->set_parameters_data(parameters_data + index);
+
+        index += layer_parameters_number;
+    }
+
+    // The old arena is released only now, because the layers copied their values from it
+
+    parameters_arena = move(new_parameters_arena);
+}
+
+
+/// Returns the precision of the frozen copies of the parameters used for the inference,
+/// or single if the inference uses the parameters.
+
+const StoragePrecision& NeuralNetwork::get_parameters_precision() const
+{
+    return parameters_precision;
+}
+
+
+/// Freezes the parameters of the layers for the inference in a reduced precision.
+/// Each layer which supports it stores a copy of its largest parameters rounded to the precision,
+/// which halves the memory read by the inference, and converts them back to single precision as it calculates,
+/// so the sums are accumulated in single precision. The layers which do not support it keep their parameters.
+/// The training does not update the copies, so the parameters must be frozen after the training.
+/// @param new_parameters_precision Precision of the copies, or single to release them.
+
+void NeuralNetwork::freeze_parameters(const StoragePrecision& new_parameters_precision)
+{
+    const Index layers_number = get_layers_number();
+
+    for(Index i = 0; i < layers_number; i++)
+    {
+        layers_pointers(i)->freeze_parameters(new_parameters_precision);
+    }
+
+    parameters_precision = new_parameters_precision;
+}
+
+
+/// Releases the frozen copies of the parameters, so that the inference uses the parameters in single precision.
+
+void NeuralNetwork::unfreeze_parameters()
+{
+    freeze_parameters(StoragePrecision::Single);
+}
+
+
+/// Sets the first trainable layer to also read the inputs as codes of categories, as filled by the batches of a
+/// data set which codes its categorical inputs. The inputs of the neural network for the deployment are not changed.
+/// The first trainable layer must be a perceptron layer if there are codes.
+/// @param new_inputs_categories_numbers Number of categories of each code, or zero for the inputs which hold values.
+/// It is empty if the inputs are not coded.
+
+void NeuralNetwork::set_inputs_categories_numbers(const Tensor<Index, 1>& new_inputs_categories_numbers)
+{
+    const Index first_trainable_layer_index = get_first_trainable_layer_index();
+
+    if(first_trainable_layer_index < get_layers_number()
+    && layers_pointers(first_trainable_layer_index)->get_type() == Layer::Type::Perceptron)
+    {
+        PerceptronLayer* perceptron_layer_pointer = static_cast<PerceptronLayer*>(layers_pointers(first_trainable_layer_index));
+
+        perceptron_layer_pointer->set_inputs_categories_numbers(new_inputs_categories_numbers);
+    }
+    else if(new_inputs_categories_numbers.size() != 0)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: NeuralNetwork class.\n"
+               << "void set_inputs_categories_numbers(const Tensor<Index, 1>&) method.\n"
+               << "First trainable layer must be a perceptron layer to read inputs codes.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+}
+
+
 /// Sets a new display value.
 /// If it is set to true messages from this class are displayed on the screen;
 /// if it is set to false messages from this class are not displayed on the screen.
@@ -1908,73 +2279,247 @@ void NeuralNetwork::forward_propagate(const DataSetBatch& batch,
                                       NeuralNetworkForwardPropagation& forward_propagation,
                                       bool& is_training) const
 {
+    // Back-propagation needs the outputs of all the layers, so they cannot share memory
 
-    const Tensor<Layer*, 1> layers_pointers = get_layers_pointers();
+    if(!forward_propagation.memory_planned || forward_propagation.memory_mode != MemoryPlanner::Mode::Training)
+        forward_propagation.plan_memory(MemoryPlanner::Mode::Training);
 
-    const Index first_trainable_layer_index = get_first_trainable_layer_index();
-    const Index last_trainable_layer_index = get_last_trainable_layer_index();
+    forward_propagate_layers(batch.inputs,
+                             forward_propagation,
+                             get_first_trainable_layer_index(),
+                             get_last_trainable_layer_index(),
+                             is_training);
+}
+
+
+/// Calculates the outputs of all the layers, scaling and unscaling included, for deployment.
+/// The memory of the outputs of each layer is reused as soon as the last layer which reads them has been calculated.
+/// Only the outputs of the last layers are kept.
+
+void NeuralNetwork::forward_propagate_deploy(DataSetBatch& batch,
+                                             NeuralNetworkForwardPropagation& forward_propagation) const
+{
+    const Index layers_number = layers_pointers.size();
+
+    if(layers_number == 0) return;
+
+    if(!forward_propagation.memory_planned || forward_propagation.memory_mode != MemoryPlanner::Mode::Inference)
+        forward_propagation.plan_memory(MemoryPlanner::Mode::Inference);
+
+    const bool is_training = false;
+
+    forward_propagate_layers(batch.inputs, forward_propagation, 0, layers_number - 1, is_training);
+}
+
+
+/// Calculates the outputs of a range of layers, level by level of the layers graph.
+/// The layers of the same level do not depend on each other, so they run concurrently.
+/// Layers which read the outputs of a layer before the range read the given inputs instead.
+/// @param inputs Inputs of the first layers.
+/// @param forward_propagation Forward propagation structure of the neural network.
+/// @param first_layer_index Index of the first layer to calculate.
+/// @param last_layer_index Index of the last layer to calculate.
+/// @param is_training True if the derivatives needed by back-propagation must be calculated.
+
+void NeuralNetwork::forward_propagate_layers(const Tensor<DynamicTensor<type>, 1>& inputs,
+                                             NeuralNetworkForwardPropagation& forward_propagation,
+                                             const Index& first_layer_index,
+                                             const Index& last_layer_index,
+                                             const bool& is_training) const
+{
+    const Tensor<Tensor<Index, 1>, 1>& layers_execution_levels = forward_propagation.layers_execution_levels;
+
+    const Index levels_number = layers_execution_levels.size();
+
+    for(Index i = 0; i < levels_number; i++)
+    {
+        const Index* level_begin = layers_execution_levels(i).data();
+        const Index* level_end = level_begin + layers_execution_levels(i).size();
+
+        const Index* begin = lower_bound(level_begin, level_end, first_layer_index);
+        const Index* end = upper_bound(begin, level_end, last_layer_index);
 
-    const Tensor<DynamicTensor<type>, 1> inputs = batch.inputs;
+        const Index level_layers_number = end - begin;
 
-    layers_pointers(first_trainable_layer_index)->forward_propagate(inputs,
-                                                                    forward_propagation.layers(first_trainable_layer_index),
-                                                                    is_training);
+        if(level_layers_number == 0) continue;
 
-    for(Index i = first_trainable_layer_index + 1; i <= last_trainable_layer_index; i++)
-    {       
-        const Tensor<DynamicTensor<type>, 1> outputs = forward_propagation.layers(i-1)->outputs;
+        if(level_layers_number == 1)
+        {
+            forward_propagate_layer(*begin, inputs, forward_propagation, first_layer_index, is_training);
+
+            continue;
+        }
 
-        layers_pointers(i)->forward_propagate(outputs,
-                                              forward_propagation.layers(i),
-                                              is_training);
+        ExecutionContext::run_concurrently(level_layers_number, [&](const Index& j)
+        {
+            forward_propagate_layer(begin[j], inputs, forward_propagation, first_layer_index, is_training);
+        });
     }
 }
 
 
-void NeuralNetwork::forward_propagate_deploy(DataSetBatch& batch,
-                                             NeuralNetworkForwardPropagation& forward_propagation) const
+/// Calculates the outputs of a single layer from the outputs of the layers it reads.
+/// The outputs of a single layer are passed in place. For several layers, the layer receives views of all of them.
+/// If the forward propagation has parameters for the layer, the layer uses them instead of its own.
+
+void NeuralNetwork::forward_propagate_layer(const Index& layer_index,
+                                            const Tensor<DynamicTensor<type>, 1>& inputs,
+                                            NeuralNetworkForwardPropagation& forward_propagation,
+                                            const Index& first_layer_index,
+                                            const bool& is_training) const
 {
-    const Tensor<Layer*, 1> layers_pointers = get_layers_pointers();
+    const Tensor<Index, 1>& inputs_indices = forward_propagation.layers_inputs_indices(layer_index);
 
-    const Index layers_number = layers_pointers.size();
+    LayerForwardPropagation* layer_forward_propagation = forward_propagation.layers(layer_index);
 
-    const bool is_training = false;
+    const bool has_layer_parameters = forward_propagation.has_layers_parameters
+                                   && forward_propagation.layers_parameters(layer_index).size() != 0;
 
-    Tensor<DynamicTensor<type>, 1> inputs = batch.inputs;
+    const Index inputs_number = inputs_indices.size();
 
-    layers_pointers(0)->forward_propagate(inputs,
-                                          forward_propagation.layers(0),
-                                          is_training);
+    if(inputs_number <= 1)
+    {
+        const Tensor<DynamicTensor<type>, 1>& layer_inputs = inputs_number == 0 || inputs_indices(0) < first_layer_index
+                ? inputs
+                : forward_propagation.layers(inputs_indices(0))->outputs;
 
-    for(Index i = 1; i < layers_number; i++)
+        if(has_layer_parameters)
+            layers_pointers(layer_index)->forward_propagate(layer_inputs, forward_propagation.layers_parameters(layer_index), layer_forward_propagation);
+        else
+            layers_pointers(layer_index)->forward_propagate(layer_inputs, layer_forward_propagation, is_training);
+
+        return;
+    }
+
+    Index layer_inputs_number = 0;
+
+    for(Index i = 0; i < inputs_number; i++)
+    {
+        layer_inputs_number += inputs_indices(i) < first_layer_index
+                ? inputs.size()
+                : forward_propagation.layers(inputs_indices(i))->outputs.size();
+    }
+
+    Tensor<DynamicTensor<type>, 1>& layer_inputs = forward_propagation.layers_inputs(layer_index);
+
+    if(layer_inputs.size() != layer_inputs_number) layer_inputs.resize(layer_inputs_number);
+
+    Index index = 0;
+
+    for(Index i = 0; i < inputs_number; i++)
     {
-        const Tensor<DynamicTensor<type>, 1> outputs = forward_propagation.layers(i-1)->outputs;
+        const Tensor<DynamicTensor<type>, 1>& outputs = inputs_indices(i) < first_layer_index
+                ? inputs
+                : forward_propagation.layers(inputs_indices(i))->outputs;
 
-        layers_pointers(i)->forward_propagate(outputs,
-                                              forward_propagation.layers(i),
-                                              is_training);
+        for(Index j = 0; j < outputs.size(); j++)
+        {
+            layer_inputs(index++).set_view(outputs(j).get_data(), outputs(j).get_dimensions());
+        }
     }
+
+    if(has_layer_parameters)
+        layers_pointers(layer_index)->forward_propagate(layer_inputs, forward_propagation.layers_parameters(layer_index), layer_forward_propagation);
+    else
+        layers_pointers(layer_index)->forward_propagate(layer_inputs, layer_forward_propagation, is_training);
 }
 
 
-/// Calculates the forward propagation in the neural network.
+/// Calculates the forward propagation in the neural network for given parameters.
+/// If has_parameters_forward_propagation() is true, the layers read the parameters from the forward propagation,
+/// and the neural network is not modified, so that several parameters can be forward propagated concurrently.
+/// Otherwise, the parameters of the neural network are set, and restored afterwards.
 /// @param batch DataSetBatch of data set that contains the inputs and targets to be trained.
-/// @param parameters Parameters of neural network.
-/// @param foward_propagation Is a NeuralNetwork class structure where save the necessary parameters of forward propagation.
+/// @param new_parameters Parameters of neural network.
+/// @param forward_propagation Is a NeuralNetwork class structure where save the necessary parameters of forward propagation.
 
 void NeuralNetwork::forward_propagate(const DataSetBatch& batch,
                                       Tensor<type, 1>& new_parameters,
                                       NeuralNetworkForwardPropagation& forward_propagation) const
 {
-    Tensor<type, 1> original_parameters = get_parameters();
+    bool is_training = true;
 
-    set_parameters(new_parameters);
+    if(!has_parameters_forward_propagation())
+    {
+        Tensor<type, 1> original_parameters = get_parameters();
 
-    bool is_training = true;
+        set_parameters(new_parameters);
+
+        forward_propagate(batch, forward_propagation, is_training);
+
+        set_parameters(original_parameters);
+
+        return;
+    }
+
+    if(!forward_propagation.memory_planned || forward_propagation.memory_mode != MemoryPlanner::Mode::Training)
+        forward_propagation.plan_memory(MemoryPlanner::Mode::Training);
+
+    // The parameters of the trainable layers are consecutive, in the order of the layers
+
+    const Index layers_number = layers_pointers.size();
+
+    Tensor<Tensor<type, 1>, 1>& layers_parameters = forward_propagation.layers_parameters;
+
+    if(layers_parameters.size() != layers_number) layers_parameters.resize(layers_number);
+
+    Index index = 0;
+
+    for(Index i = 0; i < layers_number; i++)
+    {
+        const Layer::Type layer_type = layers_pointers(i)->get_type();
+
+        if(layer_type == Layer::Type::Scaling || layer_type == Layer::Type::Unscaling || layer_type == Layer::Type::Bounding)
+            continue;
 
-    forward_propagate(batch, forward_propagation, is_training);
+        const Index layer_parameters_number = layers_pointers(i)->get_parameters_number();
 
-    set_parameters(original_parameters);
+        if(layers_parameters(i).size() != layer_parameters_number) layers_parameters(i).resize(layer_parameters_number);
+
+        copy(new_parameters.data() + index,
+             new_parameters.data() + index + layer_parameters_number,
+             layers_parameters(i).data());
+
+        index += layer_parameters_number;
+    }
+
+    forward_propagation.has_layers_parameters = true;
+
+    forward_propagate_layers(batch.inputs,
+                             forward_propagation,
+                             get_first_trainable_layer_index(),
+                             get_last_trainable_layer_index(),
+                             is_training);
+
+    forward_propagation.has_layers_parameters = false;
+}
+
+
+/// Returns true if all the trainable layers with parameters can be forward propagated with given parameters,
+/// without modifying the neural network.
+/// This is the case for the perceptron, probabilistic and long short-term memory layers.
+
+bool NeuralNetwork::has_parameters_forward_propagation() const
+{
+    const Index first_trainable_layer_index = get_first_trainable_layer_index();
+    const Index last_trainable_layer_index = get_last_trainable_layer_index();
+
+    for(Index i = first_trainable_layer_index; i <= last_trainable_layer_index; i++)
+    {
+        const Layer::Type layer_type = layers_pointers(i)->get_type();
+
+        if(layer_type == Layer::Type::Scaling || layer_type == Layer::Type::Unscaling || layer_type == Layer::Type::Bounding)
+            continue;
+
+        if(layers_pointers(i)->get_parameters_number() == 0) continue;
+
+        if(layer_type != Layer::Type::Perceptron
+        && layer_type != Layer::Type::Probabilistic
+        && layer_type != Layer::Type::LongShortTermMemory)
+            return false;
+    }
+
+    return true;
 }
 
 
@@ -1988,11 +2533,7 @@ Tensor<type, 2> NeuralNetwork::calculate_outputs(type* inputs_data, Tensor<Index
         DataSetBatch data_set_batch;
 
         data_set_batch.inputs.resize(1);
-        data_set_batch.inputs(0).set_dimensions(inputs_dimensions);
-
-        const Tensor<Index, 0> size = inputs_dimensions.prod();
-
-        memcpy(data_set_batch.inputs(0).get_data(), inputs_data, static_cast<size_t>(size(0)*sizeof(type)) );
+        data_set_batch.inputs(0).set_view(inputs_data, inputs_dimensions);
 
         const Index batch_samples_number = inputs_dimensions(0);
 
@@ -2175,82 +2716,37 @@ Tensor<type, 2> NeuralNetwork::calculate_scaled_outputs(type* scaled_inputs_data
 
     if(inputs_dimensions_number == 2)
     {
-        Tensor<type, 2> scaled_outputs;
-        Tensor<type, 2> last_layer_outputs;
-
-        Tensor<Index, 1> outputs_dimensions;
-        Tensor<Index, 1> last_layer_outputs_dimensions;
-
         const Index layers_number = get_layers_number();
 
         if(layers_number == 0)
         {
-            const Tensor<Index, 0> inputs_size = inputs_dimensions.prod();
-            scaled_outputs = TensorMap<Tensor<type,2>>(scaled_inputs_data, inputs_dimensions(0), inputs_dimensions(1));
-            return scaled_outputs;
+            return TensorMap<Tensor<type,2>>(scaled_inputs_data, inputs_dimensions(0), inputs_dimensions(1));
         }
 
-        scaled_outputs.resize(inputs_dimensions(0),layers_pointers(0)->get_neurons_number());
-
-        outputs_dimensions = get_dimensions(scaled_outputs);
-
         NeuralNetworkForwardPropagation forward_propagation(inputs_dimensions(0), this);
 
         bool is_training = false;
 
-        if(layers_pointers(0)->get_type_string() != "Scaling")
-        {
-            Tensor<DynamicTensor<type>, 1> scaled_inputs_tensor(1);
-
-            scaled_inputs_tensor(0).set_dimensions(inputs_dimensions);
-            const Tensor<Index, 0> size = inputs_dimensions.prod();
-            memcpy(scaled_inputs_tensor(0).get_data(), scaled_inputs_data, static_cast<size_t>(size(0)*sizeof(type)) );
+        // The scaled inputs are viewed, not copied, and every layer reads the outputs of the last evaluated layer in place.
 
-            // const Tensor<Index, 0> size = inputs_dimensions.prod();
-            // memcpy(data_set_batch.inputs(0).get_data(), inputs_data, static_cast<size_t>(size(0)*sizeof(type)) );
+        Tensor<DynamicTensor<type>, 1> scaled_inputs(1);
 
-            // DynamicTensor<type>(scaled_inputs_data, inputs_dimensions)
+        scaled_inputs(0).set_view(scaled_inputs_data, inputs_dimensions);
 
-            layers_pointers(0)->forward_propagate(scaled_inputs_tensor, forward_propagation.layers(0), is_training);
+        const Tensor<DynamicTensor<type>, 1>* last_layer_outputs = &scaled_inputs;
 
-            scaled_outputs = forward_propagation.layers(0)->outputs(0).to_tensor_map<2>();
-        }
-        else
-        {
-            scaled_outputs = TensorMap<Tensor<type,2>>(scaled_inputs_data, inputs_dimensions(0), inputs_dimensions(1));
-        }
-
-        last_layer_outputs = scaled_outputs;
-
-        last_layer_outputs_dimensions = get_dimensions(last_layer_outputs);
-
-        for(Index i = 1; i < layers_number; i++)
+        for(Index i = 0; i < layers_number; i++)
         {
-            if(layers_pointers(i)->get_type_string() != "Unscaling" && layers_pointers(i)->get_type_string() != "Scaling")
-            {
-                scaled_outputs.resize(inputs_dimensions(0),layers_pointers(i)->get_neurons_number());
-                outputs_dimensions = get_dimensions(scaled_outputs);
+            if(layers_pointers(i)->get_type_string() == "Unscaling" || layers_pointers(i)->get_type_string() == "Scaling") continue;
 
-                Tensor<DynamicTensor<type>, 1> inputs_tensor(1);
-                //inputs_tensor(0) = DynamicTensor<type>(last_layer_outputs.data(), last_layer_outputs_dimensions);
+            layers_pointers(i)->forward_propagate(*last_layer_outputs,
+                                                  forward_propagation.layers(i),
+                                                  is_training);
 
-                inputs_tensor(0).set_dimensions( last_layer_outputs_dimensions);
-                const Tensor<Index, 0> sizeT = last_layer_outputs_dimensions.prod();
-                memcpy(inputs_tensor(0).get_data(),last_layer_outputs.data() , static_cast<size_t>(sizeT(0)*sizeof(type)) );
-
-
-                layers_pointers(i)->forward_propagate(inputs_tensor,
-                                                      forward_propagation.layers(i),
-                                                      is_training);
-
-                scaled_outputs = forward_propagation.layers(i)->outputs(0).to_tensor_map<2>();
-
-                last_layer_outputs = scaled_outputs;
-                last_layer_outputs_dimensions = get_dimensions(last_layer_outputs);
-            }
+            last_layer_outputs = &forward_propagation.layers(i)->outputs;
         }
 
-        return scaled_outputs;
+        return (*last_layer_outputs)(0).to_tensor_map<2>();
     }
     else if(inputs_dimensions_number == 4)
     {
@@ -6565,6 +7061,117 @@ Layer* NeuralNetwork::get_last_trainable_layer_pointer() const
     return trainable_layers_pointers(trainable_layers_number-1);
 }
 
+
+/// Places the outputs of all the layers in a single arena, so that the forward propagation does not allocate memory.
+/// The outputs of a layer live from its level until the level of the last layer which reads them.
+/// The outputs which no other layer reads live until the end.
+/// Each mode has its own arena, which is planned the first time that mode is used,
+/// so that switching between training and inference only changes the views of the outputs.
+/// @param mode In inference mode, the outputs whose lifetimes do not overlap share memory,
+/// and the quantities which only back-propagation needs are freed, unless the training mode has been planned.
+/// In training mode, all the outputs are kept for back-propagation.
+
+void NeuralNetworkForwardPropagation::plan_memory(const MemoryPlanner::Mode& mode)
+{
+    // Only a forward propagation first used for inference and then for training allocates its layers again
+
+    if(mode == MemoryPlanner::Mode::Training && is_training_memory_freed) set(batch_samples_number, neural_network_pointer);
+
+    const Index layers_number = layers.size();
+
+    if(layers_buffers.size() != layers_number)
+    {
+        const Index levels_number = layers_execution_levels.size();
+
+        // Lifetimes
+
+        Tensor<Index, 1> layers_levels(layers_number);
+        layers_levels.setZero();
+
+        for(Index i = 0; i < levels_number; i++)
+        {
+            for(Index j = 0; j < layers_execution_levels(i).size(); j++)
+            {
+                layers_levels(layers_execution_levels(i)(j)) = i;
+            }
+        }
+
+        Tensor<Index, 1> last_levels(layers_number);
+
+        for(Index i = 0; i < layers_number; i++)
+        {
+            if(layers_outputs_indices(i).size() == 0)
+            {
+                last_levels(i) = levels_number;
+
+                continue;
+            }
+
+            last_levels(i) = layers_levels(i);
+
+            for(Index j = 0; j < layers_outputs_indices(i).size(); j++)
+            {
+                last_levels(i) = max(last_levels(i), layers_levels(layers_outputs_indices(i)(j)));
+            }
+        }
+
+        // Buffers
+
+        memory_planner.set();
+
+        layers_buffers.resize(layers_number);
+        layers_buffers.setConstant(-1);
+
+        for(Index i = 0; i < layers_number; i++)
+        {
+            if(layers(i) == nullptr
+            || layers(i)->outputs.size() != 1
+            || layers(i)->outputs(0).get_data() == nullptr)
+                continue;
+
+            layers_buffers(i) = memory_planner.add_buffer(layers(i)->outputs(0).size(), layers_levels(i), last_levels(i));
+        }
+    }
+
+    // Offsets
+
+    const bool is_training = mode == MemoryPlanner::Mode::Training;
+
+    Tensor<type, 1>& outputs_arena = is_training ? training_outputs_arena : inference_outputs_arena;
+    Tensor<Index, 1>& offsets = is_training ? training_offsets : inference_offsets;
+
+    if(offsets.size() != memory_planner.get_buffers_number() || outputs_arena.size() == 0)
+    {
+        memory_planner.plan(mode);
+
+        outputs_arena.resize(memory_planner.get_arena_size());
+
+        offsets = memory_planner.get_offsets();
+    }
+
+    // Views
+
+    const bool free_training_memory = !is_training && training_offsets.size() == 0;
+
+    for(Index i = 0; i < layers_number; i++)
+    {
+        if(layers(i) == nullptr) continue;
+
+        if(free_training_memory) layers(i)->free_training_memory();
+
+        if(layers_buffers(i) == -1) continue;
+
+        const Tensor<Index, 1> outputs_dimensions = layers(i)->outputs(0).get_dimensions();
+
+        layers(i)->outputs(0).set_view(outputs_arena.data() + offsets(layers_buffers(i)), outputs_dimensions);
+    }
+
+    if(free_training_memory) is_training_memory_freed = true;
+
+    memory_mode = mode;
+    memory_planned = true;
+}
+
 }
 
 // OpenNN: Open Neural Networks Library.
@@ -15,6 +15,7 @@
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <sstream>
 #include <errno.h>
@@ -24,6 +25,7 @@
 #include "config.h"
 #include "data_set.h"
 #include "layer.h"
+#include "memory_planner.h"
 #include "addition_layer.h"
 #include "perceptron_layer.h"
 #include "scaling_layer.h"
@@ -38,6 +40,8 @@
 #include "pooling_layer.h"
 #include "long_short_term_memory_layer.h"
 #include "recurrent_layer.h"
+#include "embedding_layer.h"
+#include "multihead_attention_layer.h"
 #include "text_analytics.h"
 
 namespace opennn
@@ -101,6 +105,7 @@ public:
    bool has_probabilistic_layer() const;
    bool has_convolutional_layer() const;
    bool has_flatten_layer() const;
+   bool has_embedding_layer() const;
    bool is_empty() const;
 
    const Tensor<string, 1>& get_inputs_names() const;
@@ -122,6 +127,8 @@ public:
    Index get_layer_index(const string&) const;
 
    Tensor<Tensor<Index, 1>, 1> get_layers_inputs_indices() const;
+   Tensor<Tensor<Index, 1>, 1> get_layers_outputs_indices() const;
+   Tensor<Tensor<Index, 1>, 1> get_layers_execution_levels() const;
 
    ScalingLayer* get_scaling_layer_pointer() const;
    UnscalingLayer* get_unscaling_layer_pointer() const;
@@ -221,6 +228,8 @@ public:
    Index get_parameters_number() const;
    Tensor<type, 1> get_parameters() const;
 
+   type* get_parameters_data() const;
+
    Tensor<Index, 1> get_trainable_layers_parameters_numbers() const;
 
    // AANN histogram
@@ -242,6 +251,21 @@ public:
    Tensor<type, 1> get_multivariate_distances_box_plot_maximums() const;
 
    void set_parameters(Tensor<type, 1>&) const;
+   void set_parameters(const TensorMap<Tensor<type, 1>>&) const;
+
+   void allocate_parameters_arena();
+
+   // Reduced precision methods
+
+   const StoragePrecision& get_parameters_precision() const;
+
+   void freeze_parameters(const StoragePrecision&);
+
+   void unfreeze_parameters();
+
+   // Inputs codes methods
+
+   void set_inputs_categories_numbers(const Tensor<Index, 1>&);
 
    // Parameters initialization methods
 
@@ -332,6 +356,19 @@ public:
 
    void forward_propagate(const DataSetBatch&, Tensor<type, 1>&, NeuralNetworkForwardPropagation&) const;
 
+   bool has_parameters_forward_propagation() const;
+
+   void forward_propagate_layers(const Tensor<DynamicTensor<type>, 1>&,
+                                 NeuralNetworkForwardPropagation&,
+                                 const Index&,
+                                 const Index&,
+                                 const bool&) const;
+
+   void forward_propagate_layer(const Index&,
+                                const Tensor<DynamicTensor<type>, 1>&,
+                                NeuralNetworkForwardPropagation&,
+                                const Index&,
+                                const bool&) const;
 
 
 protected:
@@ -354,6 +391,14 @@ protected:
 
    Tensor<Tensor<Index, 1>, 1> layers_inputs_indices;
 
+   /// Contiguous storage of the parameters of all the trainable layers, which hold views of it.
+
+   Tensor<type, 1> parameters_arena;
+
+   /// Precision of the frozen copies of the parameters used for the inference, or single if there are none.
+
+   StoragePrecision parameters_precision = StoragePrecision::Single;
+
    /// AANN distances box plot
 
    BoxPlot auto_associative_distances_box_plot = BoxPlot();
@@ -406,10 +451,34 @@ struct NeuralNetworkForwardPropagation
 
         const Index layers_number = layers_pointers.size();
 
+        for(Index i = 0; i < layers.size(); i++)
+        {
+            delete layers(i);
+        }
+
         layers.resize(layers_number);
 
+        // Layers graph
+
+        layers_inputs_indices = neural_network_pointer->get_layers_inputs_indices();
+        layers_outputs_indices = neural_network_pointer->get_layers_outputs_indices();
+        layers_execution_levels = neural_network_pointer->get_layers_execution_levels();
+
+        layers_inputs.resize(layers_number);
+
+        memory_planner.set();
+        layers_buffers.resize(0);
+        training_outputs_arena.resize(0);
+        inference_outputs_arena.resize(0);
+        training_offsets.resize(0);
+        inference_offsets.resize(0);
+        is_training_memory_freed = false;
+        memory_planned = false;
+
         for(Index i = 0; i < layers_number; i++)
         {
+            layers(i) = nullptr;
+
             switch (layers_pointers(i)->get_type())
             {
             case Layer::Type::Perceptron:
@@ -485,6 +554,34 @@ struct NeuralNetworkForwardPropagation
             }
             break;
 
+            case Layer::Type::Addition:
+            {
+                layers(i) = new AdditionLayerForwardPropagation(batch_samples_number, layers_pointers(i));
+            }
+            break;
+
+            case Layer::Type::Embedding:
+            {
+                layers(i) = new EmbeddingLayerForwardPropagation(batch_samples_number, layers_pointers(i));
+            }
+            break;
+
+            case Layer::Type::MultiheadAttention:
+            {
+                MultiheadAttentionLayerForwardPropagation* multihead_attention_layer_forward_propagation
+                        = new MultiheadAttentionLayerForwardPropagation(batch_samples_number, layers_pointers(i));
+
+                // The layers which give the query, key and value, to back-propagate to each of them its own derivatives
+
+                for(Index j = 0; j < layers_inputs_indices(i).size() && j < 3; j++)
+                {
+                    multihead_attention_layer_forward_propagation->inputs_layers_pointers(j) = layers_pointers(layers_inputs_indices(i)(j));
+                }
+
+                layers(i) = multihead_attention_layer_forward_propagation;
+            }
+            break;
+
             default: break;
             }
         }
@@ -507,11 +604,73 @@ struct NeuralNetworkForwardPropagation
         }
     }
 
+    void plan_memory(const MemoryPlanner::Mode&);
+
     Index batch_samples_number = 0;
 
     NeuralNetwork* neural_network_pointer = nullptr;
 
     Tensor<LayerForwardPropagation*, 1> layers;
+
+    /// Indices of the layers whose outputs are the inputs of each layer. No indices stand for the inputs of the batch.
+
+    Tensor<Tensor<Index, 1>, 1> layers_inputs_indices;
+
+    /// Indices of the layers which read the outputs of each layer.
+
+    Tensor<Tensor<Index, 1>, 1> layers_outputs_indices;
+
+    /// Layers grouped in levels, so that each layer only depends on the layers of previous levels.
+
+    Tensor<Tensor<Index, 1>, 1> layers_execution_levels;
+
+    /// Views of the inputs of the layers which read the outputs of several layers.
+
+    Tensor<Tensor<DynamicTensor<type>, 1>, 1> layers_inputs;
+
+    /// Places the outputs of the layers in the arenas.
+
+    MemoryPlanner memory_planner;
+
+    /// Buffer of the memory planner which holds the outputs of each layer, -1 for the layers without one.
+
+    Tensor<Index, 1> layers_buffers;
+
+    /// Single block of memory which holds the outputs of all the layers in training mode, once that mode has been planned.
+
+    Tensor<type, 1> training_outputs_arena;
+
+    /// Single block of memory which holds the outputs of all the layers in inference mode, once that mode has been planned.
+
+    Tensor<type, 1> inference_outputs_arena;
+
+    /// Offsets of the buffers in the training arena. Empty until the training mode has been planned.
+
+    Tensor<Index, 1> training_offsets;
+
+    /// Offsets of the buffers in the inference arena. Empty until the inference mode has been planned.
+
+    Tensor<Index, 1> inference_offsets;
+
+    /// True if an inference plan has freed the quantities which only back-propagation needs.
+
+    bool is_training_memory_freed = false;
+
+    /// True if the outputs of the layers are views of an arena.
+
+    bool memory_planned = false;
+
+    /// Mode of the last memory plan.
+
+    MemoryPlanner::Mode memory_mode = MemoryPlanner::Mode::Training;
+
+    /// Parameters of each layer for the forward propagation with given parameters. Empty for the layers without parameters.
+
+    Tensor<Tensor<type, 1>, 1> layers_parameters;
+
+    /// True while the layers with parameters are forward propagated with layers_parameters instead of their own parameters.
+
+    bool has_layers_parameters = false;
 };
 
 
@@ -544,10 +703,17 @@ struct NeuralNetworkBackPropagation
 
         const Index trainable_layers_number = trainable_layers_pointers.size();
 
+        for(Index i = 0; i < layers.size(); i++)
+        {
+            delete layers(i);
+        }
+
         layers.resize(trainable_layers_number);
 
         for(Index i = 0; i < trainable_layers_number; i++)
         {
+            layers(i) = nullptr;
+
             switch (trainable_layers_pointers(i)->get_type())
             {
             case Layer::Type::Perceptron:
@@ -592,9 +758,94 @@ struct NeuralNetworkBackPropagation
             }
             break;
 
+            case Layer::Type::Addition:
+            {
+                layers(i) = new AdditionLayerBackPropagation(batch_samples_number, trainable_layers_pointers(i));
+            }
+            break;
+
+            case Layer::Type::Embedding:
+            {
+                layers(i) = new EmbeddingLayerBackPropagation(batch_samples_number, trainable_layers_pointers(i));
+            }
+            break;
+
+            case Layer::Type::MultiheadAttention:
+            {
+                layers(i) = new MultiheadAttentionLayerBackPropagation(batch_samples_number, trainable_layers_pointers(i));
+            }
+            break;
+
             default: break;
             }
         }
+
+        // Position of each layer of the network among the trainable layers
+
+        const Tensor<Index, 1> trainable_layers_indices = neural_network_pointer->get_trainable_layers_indices();
+
+        layers_trainable_indices.resize(neural_network_pointer->get_layers_number());
+        layers_trainable_indices.setConstant(-1);
+
+        for(Index i = 0; i < trainable_layers_number; i++)
+        {
+            layers_trainable_indices(trainable_layers_indices(i)) = i;
+        }
+
+        // Only the embedding and multihead attention layers take their deltas from a multihead attention layer
+
+        const Tensor<Tensor<Index, 1>, 1> layers_inputs_indices = neural_network_pointer->get_layers_inputs_indices();
+
+        for(Index i = 0; i < trainable_layers_number; i++)
+        {
+            if(trainable_layers_pointers(i)->get_type() != Layer::Type::MultiheadAttention) continue;
+
+            const Tensor<Index, 1>& inputs_indices = layers_inputs_indices(trainable_layers_indices(i));
+
+            for(Index j = 0; j < inputs_indices.size(); j++)
+            {
+                if(layers_trainable_indices(inputs_indices(j)) == -1) continue;
+
+                const Layer* input_layer_pointer = neural_network_pointer->get_layer_pointer(inputs_indices(j));
+
+                if(input_layer_pointer->get_type() != Layer::Type::Embedding
+                && input_layer_pointer->get_type() != Layer::Type::MultiheadAttention)
+                {
+                    ostringstream buffer;
+
+                    buffer << "OpenNN Exception: NeuralNetworkBackPropagation structure.\n"
+                           << "void set(const Index&, NeuralNetwork*) method.\n"
+                           << "Layer type (" << input_layer_pointer->get_type_string() << ") cannot feed a multihead attention layer.\n";
+
+                    throw invalid_argument(buffer.str());
+                }
+            }
+        }
+
+        // The deltas of the layers read by several layers are the sum of the contributions of each one
+
+        const Tensor<Tensor<Index, 1>, 1> layers_outputs_indices = neural_network_pointer->get_layers_outputs_indices();
+
+        layers_deltas_sums.resize(trainable_layers_number);
+
+        for(Index i = 0; i < trainable_layers_number; i++)
+        {
+            if(layers(i) == nullptr || layers_outputs_indices(trainable_layers_indices(i)).size() < 2) continue;
+
+            const Tensor<Index, 0> deltas_size = layers(i)->deltas_dimensions.prod();
+
+            layers_deltas_sums(i).resize(deltas_size(0));
+        }
+    }
+
+    /// Returns the back-propagation of a layer of the network, or nullptr if the layer is not trainable.
+    /// @param layer_index Index of the layer in the neural network.
+
+    LayerBackPropagation* get_layer(const Index& layer_index) const
+    {
+        const Index trainable_layer_index = layers_trainable_indices(layer_index);
+
+        return trainable_layer_index == -1 ? nullptr : layers(trainable_layer_index);
     }
 
     void print() const
@@ -618,6 +869,14 @@ struct NeuralNetworkBackPropagation
     NeuralNetwork* neural_network_pointer = nullptr;
 
     Tensor<LayerBackPropagation*, 1> layers;
+
+    /// Index of each layer of the network among the trainable layers, or -1 for the scaling, unscaling and bounding layers.
+
+    Tensor<Index, 1> layers_trainable_indices;
+
+    /// Sums of the deltas of the layers whose outputs are read by several layers.
+
+    Tensor<Tensor<type, 1>, 1> layers_deltas_sums;
 };
 
 
@@ -369,9 +369,7 @@ void NormalizedSquaredError::calculate_output_delta(const DataSetBatch& batch,
 
     deltas.device(*thread_pool_device) = coefficient*back_propagation.errors;
 
-    Tensor<type, 2> output_deltas(deltas);
-
-    if(has_NAN(output_deltas))
+    if(has_NAN(deltas.data(), deltas.size()))
     {
         ostringstream buffer;
 
@@ -452,6 +450,18 @@ void NormalizedSquaredError::calculate_error_hessian_lm(const DataSetBatch& batc
 }
 
 
+/// Returns the coefficient of the sum of the squared error terms in the normalized squared error of a batch.
+/// It is the inverse of the normalization coefficient, scaled by the fraction of the samples in the batch.
+/// @param batch_samples_number Number of samples of the batch.
+
+type NormalizedSquaredError::get_squared_errors_coefficient_lm(const Index& batch_samples_number) const
+{
+    const Index total_samples_number = data_set_pointer->get_samples_number();
+
+    return type(1)/((static_cast<type>(batch_samples_number)/static_cast<type>(total_samples_number))*normalization_coefficient);
+}
+
+
 /// Returns a string with the name of the normalized squared error loss type, "NORMALIZED_SQUARED_ERROR".
 
 string NormalizedSquaredError::get_error_type() const
@@ -96,6 +96,8 @@ public:
    void calculate_error_hessian_lm(const DataSetBatch&,
                                         LossIndexBackPropagationLM&) const final;
 
+   type get_squared_errors_coefficient_lm(const Index&) const final;
+
    // Serialization methods
 
    string get_error_type() const final;
@@ -12,16 +12,30 @@
 #include "config.h"
 #include "half.hpp"
 
+// Execution context
+
+#include "execution_context.h"
+
 // Data set
 
+#include "mapped_file.h"
+#include "csv_reader.h"
+#include "binary_data_file.h"
+#include "data_shards.h"
+#include "storage_precision.h"
+#include "training_cache.h"
+#include "image_augmentation.h"
 #include "data_set.h"
+#include "batch_loader.h"
 
 // Neural network
 
 #include "config.h"
 #include "layer.h"
+#include "memory_planner.h"
 #include "addition_layer.h"
 #include "pooling_layer.h"
+#include "convolution_engine.h"
 #include "convolutional_layer.h"
 #include "bounding_layer.h"
 #include "perceptron_layer.h"
@@ -30,8 +44,8 @@
 #include "probabilistic_layer.h"
 #include "scaling_layer.h"
 // #include "region_proposal_layer.h"
-//#include "embedding_layer.h"
-//#include "multihead_attention_layer.h"
+#include "embedding_layer.h"
+#include "multihead_attention_layer.h"
 #include "kmeans.h"
 #include "non_max_suppression_layer.h"
 #include "unscaling_layer.h"
@@ -42,6 +56,8 @@
 // Training strategy
 
 #include "loss_index.h"
+#include "optimizer_kernels.h"
+#include "data_parallel.h"
 
 #include "cross_entropy_error.h"
 #include "mean_squared_error.h"
@@ -78,6 +94,7 @@
 #include "opennn_images.h"
 #include "tensor_utilities.h"
 #include "statistics.h"
+#include "statistics_accumulator.h"
 #include "scaling.h"
 #include "region_based_object_detector.h"
 #include "json_to_xml.h"
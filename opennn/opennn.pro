@@ -61,14 +61,24 @@ HEADERS += \
     kmeans.h \
     numerical_differentiation.h \
     config.h \
+    execution_context.h \
     opennn_strings.h \
     opennn_images.h \
     statistics.h \
+    statistics_accumulator.h \
     scaling.h \
     correlations.h \
     codification.h \
     tinyxml2.h \
     filesystem.h \
+    mapped_file.h \
+    csv_reader.h \
+    binary_data_file.h \
+    data_shards.h \
+    storage_precision.h \
+    training_cache.h \
+    image_augmentation.h \
+    batch_loader.h \
     data_set.h \
     layer.h \
     scaling_layer.h \
@@ -76,14 +86,18 @@ HEADERS += \
     perceptron_layer.h \
     probabilistic_layer.h \
     pooling_layer.h \
+    convolution_engine.h \
     convolutional_layer.h \
     bounding_layer.h \
     long_short_term_memory_layer.h \
     recurrent_layer.h \
+    memory_planner.h \
     neural_network.h \
     loss_index.h \
     mean_squared_error.h \
     optimization_algorithm.h \
+    optimizer_kernels.h \
+    data_parallel.h \
     stochastic_gradient_descent.h\
     training_strategy.h \
     neural_network.h \
@@ -124,6 +138,7 @@ HEADERS += \
     opennn.h
 
 SOURCES += \
+    execution_context.cpp \
     embedding_layer.cpp \
     multihead_attention_layer.cpp \
     addition_layer.cpp \
@@ -134,10 +149,19 @@ SOURCES += \
     opennn_images.cpp \
     tensor_utilities.cpp \
     statistics.cpp \
+    statistics_accumulator.cpp \
     scaling.cpp \
     correlations.cpp \
     codification.cpp \
     tinyxml2.cpp \
+    mapped_file.cpp \
+    csv_reader.cpp \
+    binary_data_file.cpp \
+    data_shards.cpp \
+    storage_precision.cpp \
+    training_cache.cpp \
+    image_augmentation.cpp \
+    batch_loader.cpp \
     data_set.cpp \
     layer.cpp \
     scaling_layer.cpp \
@@ -146,15 +170,19 @@ SOURCES += \
     probabilistic_layer.cpp \
     pooling_layer.cpp \
     bounding_layer.cpp \
+    convolution_engine.cpp \
     convolutional_layer.cpp \
     long_short_term_memory_layer.cpp \
     recurrent_layer.cpp \
+    memory_planner.cpp \
     neural_network.cpp \
     loss_index.cpp \
     mean_squared_error.cpp \
     stochastic_gradient_descent.cpp \
     training_strategy.cpp \
     optimization_algorithm.cpp \
+    optimizer_kernels.cpp \
+    data_parallel.cpp \
     data_set.cpp \
     sum_squared_error.cpp \
     normalized_squared_error.cpp \
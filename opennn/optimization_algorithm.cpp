@@ -16,9 +16,7 @@ namespace opennn
 
 OptimizationAlgorithm::OptimizationAlgorithm()
 {
-    const int n = omp_get_max_threads();
-    thread_pool = new ThreadPool(n);
-    thread_pool_device = new ThreadPoolDevice(thread_pool, n);
+    thread_pool_device = ExecutionContext::get_thread_pool_device();
 
     set_default();
 }
@@ -30,9 +28,7 @@ OptimizationAlgorithm::OptimizationAlgorithm()
 OptimizationAlgorithm::OptimizationAlgorithm(LossIndex* new_loss_index_pointer)
     : loss_index_pointer(new_loss_index_pointer)
 {
-    const int n = omp_get_max_threads();
-    thread_pool = new ThreadPool(n);
-    thread_pool_device = new ThreadPoolDevice(thread_pool, n);
+    thread_pool_device = ExecutionContext::get_thread_pool_device();
 
     set_default();
 }
@@ -42,8 +38,6 @@ OptimizationAlgorithm::OptimizationAlgorithm(LossIndex* new_loss_index_pointer)
 
 OptimizationAlgorithm::~OptimizationAlgorithm()
 {
-    delete thread_pool;
-    delete thread_pool_device;
 }
 
 
@@ -71,6 +65,15 @@ LossIndex* OptimizationAlgorithm::get_loss_index_pointer() const
 }
 
 
+/// Returns a pointer to the communicator with the other processes of a data parallel training,
+/// or nullptr if the training runs in a single process.
+
+Communicator* OptimizationAlgorithm::get_communicator_pointer() const
+{
+    return communicator_pointer;
+}
+
+
 /// Returns the hardware used. Default: Multi-core
 
 string OptimizationAlgorithm::get_hardware_use() const
@@ -147,13 +150,12 @@ void OptimizationAlgorithm::set()
 }
 
 
+/// Sets the number of threads of the thread pool shared by all the objects.
+/// @param new_threads_number Number of threads.
+
 void OptimizationAlgorithm::set_threads_number(const int& new_threads_number)
 {
-    if(thread_pool != nullptr) delete thread_pool;
-    if(thread_pool_device != nullptr) delete thread_pool_device;
-
-    thread_pool = new ThreadPool(new_threads_number);
-    thread_pool_device = new ThreadPoolDevice(thread_pool, new_threads_number);
+    ExecutionContext::set_threads_number(new_threads_number);
 }
 
 
@@ -166,6 +168,18 @@ void OptimizationAlgorithm::set_loss_index_pointer(LossIndex* new_loss_index_poi
 }
 
 
+/// Sets a communicator with the other processes of a data parallel training.
+/// Each process trains on its own shard of the samples and the gradients are averaged across the processes in every iteration,
+/// so that the parameters remain the same on all of them.
+/// The communicator is not owned by the optimization algorithm.
+/// @param new_communicator_pointer Pointer to a communicator, or nullptr to train in a single process.
+
+void OptimizationAlgorithm::set_communicator_pointer(Communicator* new_communicator_pointer)
+{
+    communicator_pointer = new_communicator_pointer;
+}
+
+
 /// Sets a new display value.
 /// If it is set to true messages from this class are displayed on the screen;
 /// if it is set to false messages from this class are not displayed on the screen.
@@ -25,6 +25,7 @@
 #include "config.h"
 #include "tensor_utilities.h"
 #include "loss_index.h"
+#include "data_parallel.h"
 
 namespace opennn
 {
@@ -54,6 +55,8 @@ public:
 
    LossIndex* get_loss_index_pointer() const;
 
+   Communicator* get_communicator_pointer() const;
+
    /// Hardware use.
    string get_hardware_use() const;
    void set_hardware_use(const string&);
@@ -84,6 +87,8 @@ public:
 
    virtual void set_loss_index_pointer(LossIndex*);
 
+   void set_communicator_pointer(Communicator*);
+
    virtual void set_display(const bool&);
 
    void set_display_period(const Index&);
@@ -120,13 +125,19 @@ public:
 
 protected:
 
-   ThreadPool* thread_pool = nullptr;
-   ThreadPoolDevice* thread_pool_device;
+   /// Thread pool device shared by all the objects, owned by the execution context.
+
+   ThreadPoolDevice* thread_pool_device = nullptr;
 
    /// Pointer to a loss index for a neural network object.
 
    LossIndex* loss_index_pointer = nullptr;
 
+   /// Pointer to a communicator with the other processes of a data parallel training, or nullptr to train in a single process.
+   /// It is used by the adaptive moment estimation and the stochastic gradient descent.
+
+   Communicator* communicator_pointer = nullptr;
+
    /// Number of training epochs in the neural network.
 
    Index epochs_number = 10000;
@@ -176,6 +187,22 @@ struct OptimizationAlgorithmData
 
     virtual ~OptimizationAlgorithmData()
     {
+        delete_candidates();
+    }
+
+    /// Deletes the propagation structures of the line search candidates.
+
+    void delete_candidates()
+    {
+        for(Index i = 0; i < candidates_forward_propagations.size(); i++)
+        {
+            delete candidates_forward_propagations(i);
+            delete candidates_back_propagations(i);
+        }
+
+        candidates_forward_propagations.resize(0);
+        candidates_back_propagations.resize(0);
+        candidates_parameters.resize(0);
     }
 
     void print() const
@@ -194,6 +221,11 @@ struct OptimizationAlgorithmData
     Tensor<type, 1> training_direction;
     type initial_learning_rate = type(0);
 
+    // Line search candidates, each with its own forward propagation of the neural network and its own errors
+
+    Tensor<NeuralNetworkForwardPropagation*, 1> candidates_forward_propagations;
+    Tensor<LossIndexBackPropagation*, 1> candidates_back_propagations;
+    Tensor<Tensor<type, 1>, 1> candidates_parameters;
 };
 
 
@@ -276,6 +308,9 @@ struct TrainingResults
             cout << "Selection error: " << selection_error_history(epochs_number-1) << endl;
 
         cout << "Stopping condition: " << write_stopping_condition() << endl;
+
+        if(data_waiting_time > type(0))
+            cout << "Data waiting time: " << data_waiting_time << " s" << endl;
     }
 
     /// Stopping condition of the algorithm.
@@ -308,6 +343,10 @@ struct TrainingResults
 
     string elapsed_time;
 
+    /// Time, in seconds, during which the training has waited for batches to be filled.
+
+    type data_waiting_time = type(0);
+
     type loss;
 
     Index selection_failures;
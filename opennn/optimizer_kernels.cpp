@@ -0,0 +1,271 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   O P T I M I Z E R   K E R N E L S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "optimizer_kernels.h"
+#include "storage_precision.h"
+
+namespace opennn
+{
+
+/// Number of values of the blocks of the fused updates.
+/// The blocks of the gradient, the parameters and the moments fit together in the first level cache,
+/// so that the expressions over a block read and write the memory only once.
+
+const Index optimizer_block_size = 1024;
+
+
+/// Updates the moments and the parameters of an adaptive moment estimation iteration in a range of values.
+/// The moments of each block are converted to single precision before the update and back after it when they are stored in bfloat16.
+/// @param step Hyperparameters of the iteration.
+/// @param first_index First value of the range.
+/// @param last_index Last value of the range, not included.
+/// @param gradient_data Pointer to the gradient.
+/// @param parameters_data Pointer to the parameters.
+/// @param first_moments_data Pointer to the exponential decay of the gradient.
+/// @param second_moments_data Pointer to the exponential decay of the square gradient.
+
+template<typename T>
+void update_parameters_adam_range(const AdamStep& step,
+                                  const Index& first_index,
+                                  const Index& last_index,
+                                  const type* gradient_data,
+                                  type* parameters_data,
+                                  T* first_moments_data,
+                                  T* second_moments_data)
+{
+    type first_moments_block[optimizer_block_size];
+    type second_moments_block[optimizer_block_size];
+
+    for(Index begin = first_index; begin < last_index; begin += optimizer_block_size)
+    {
+        const Index size = min(optimizer_block_size, last_index - begin);
+
+        type* first_moments_pointer = first_moments_block;
+        type* second_moments_pointer = second_moments_block;
+
+        if constexpr(is_same<T, type>::value)
+        {
+            first_moments_pointer = first_moments_data + begin;
+            second_moments_pointer = second_moments_data + begin;
+        }
+        else
+        {
+            convert_to_single(first_moments_data + begin, size, first_moments_block);
+            convert_to_single(second_moments_data + begin, size, second_moments_block);
+        }
+
+        const TensorMap<const Tensor<type, 1>> gradient(gradient_data + begin, size);
+
+        TensorMap<Tensor<type, 1>> parameters(parameters_data + begin, size);
+        TensorMap<Tensor<type, 1>> first_moments(first_moments_pointer, size);
+        TensorMap<Tensor<type, 1>> second_moments(second_moments_pointer, size);
+
+        first_moments = gradient*(type(1) - step.beta_1) + first_moments*step.beta_1;
+
+        second_moments = gradient.square()*(type(1) - step.beta_2) + second_moments*step.beta_2;
+
+        parameters = parameters*(type(1) - step.weight_decay_rate)
+                   - first_moments*step.learning_rate/(second_moments.sqrt() + step.epsilon);
+
+        if constexpr(!is_same<T, type>::value)
+        {
+            convert_from_single(first_moments_block, size, first_moments_data + begin);
+            convert_from_single(second_moments_block, size, second_moments_data + begin);
+        }
+    }
+}
+
+
+/// Updates the velocities and the parameters of a stochastic gradient descent iteration in a range of values.
+/// Without momentum, the velocities are neither read nor written.
+/// @param step Hyperparameters of the iteration.
+/// @param first_index First value of the range.
+/// @param last_index Last value of the range, not included.
+/// @param gradient_data Pointer to the gradient.
+/// @param parameters_data Pointer to the parameters.
+/// @param velocities_data Pointer to the last parameters increments.
+
+template<typename T>
+void update_parameters_momentum_range(const MomentumStep& step,
+                                      const Index& first_index,
+                                      const Index& last_index,
+                                      const type* gradient_data,
+                                      type* parameters_data,
+                                      T* velocities_data)
+{
+    type velocities_block[optimizer_block_size];
+
+    for(Index begin = first_index; begin < last_index; begin += optimizer_block_size)
+    {
+        const Index size = min(optimizer_block_size, last_index - begin);
+
+        const TensorMap<const Tensor<type, 1>> gradient(gradient_data + begin, size);
+
+        TensorMap<Tensor<type, 1>> parameters(parameters_data + begin, size);
+
+        if(step.momentum <= type(0))
+        {
+            parameters -= gradient*step.learning_rate;
+
+            continue;
+        }
+
+        type* velocities_pointer = velocities_block;
+
+        if constexpr(is_same<T, type>::value)
+        {
+            velocities_pointer = velocities_data + begin;
+        }
+        else
+        {
+            convert_to_single(velocities_data + begin, size, velocities_block);
+        }
+
+        TensorMap<Tensor<type, 1>> velocities(velocities_pointer, size);
+
+        velocities = velocities*step.momentum - gradient*step.learning_rate;
+
+        if(step.nesterov)
+        {
+            parameters += velocities*step.momentum - gradient*step.learning_rate;
+        }
+        else
+        {
+            parameters += velocities;
+        }
+
+        if constexpr(!is_same<T, type>::value)
+        {
+            convert_from_single(velocities_block, size, velocities_data + begin);
+        }
+    }
+}
+
+
+/// Updates the moments and the parameters of an adaptive moment estimation iteration in a single pass over the memory.
+/// @param thread_pool_device Device whose threads update the ranges of values.
+/// @param step Hyperparameters of the iteration.
+/// @param parameters_number Number of parameters.
+/// @param gradient_data Pointer to the gradient.
+/// @param parameters_data Pointer to the parameters.
+/// @param first_moments_data Pointer to the exponential decay of the gradient.
+/// @param second_moments_data Pointer to the exponential decay of the square gradient.
+
+void update_parameters_adam(const ThreadPoolDevice* thread_pool_device,
+                            const AdamStep& step,
+                            const Index& parameters_number,
+                            const type* gradient_data,
+                            type* parameters_data,
+                            type* first_moments_data,
+                            type* second_moments_data)
+{
+    const TensorOpCost cost(4*sizeof(type), 3*sizeof(type), 16);
+
+    thread_pool_device->parallelFor(parameters_number, cost, [&](Index first_index, Index last_index)
+    {
+        update_parameters_adam_range(step, first_index, last_index,
+                                     gradient_data, parameters_data, first_moments_data, second_moments_data);
+    });
+}
+
+
+/// Updates the moments and the parameters of an adaptive moment estimation iteration in a single pass over the memory,
+/// with the moments stored in bfloat16 precision.
+/// @param thread_pool_device Device whose threads update the ranges of values.
+/// @param step Hyperparameters of the iteration.
+/// @param parameters_number Number of parameters.
+/// @param gradient_data Pointer to the gradient.
+/// @param parameters_data Pointer to the parameters.
+/// @param first_moments_data Pointer to the exponential decay of the gradient.
+/// @param second_moments_data Pointer to the exponential decay of the square gradient.
+
+void update_parameters_adam(const ThreadPoolDevice* thread_pool_device,
+                            const AdamStep& step,
+                            const Index& parameters_number,
+                            const type* gradient_data,
+                            type* parameters_data,
+                            Eigen::bfloat16* first_moments_data,
+                            Eigen::bfloat16* second_moments_data)
+{
+    const TensorOpCost cost(2*sizeof(type) + 2*sizeof(Eigen::bfloat16), sizeof(type) + 2*sizeof(Eigen::bfloat16), 24);
+
+    thread_pool_device->parallelFor(parameters_number, cost, [&](Index first_index, Index last_index)
+    {
+        update_parameters_adam_range(step, first_index, last_index,
+                                     gradient_data, parameters_data, first_moments_data, second_moments_data);
+    });
+}
+
+
+/// Updates the velocities and the parameters of a stochastic gradient descent iteration in a single pass over the memory.
+/// @param thread_pool_device Device whose threads update the ranges of values.
+/// @param step Hyperparameters of the iteration.
+/// @param parameters_number Number of parameters.
+/// @param gradient_data Pointer to the gradient.
+/// @param parameters_data Pointer to the parameters.
+/// @param velocities_data Pointer to the last parameters increments, which can be nullptr without momentum.
+
+void update_parameters_momentum(const ThreadPoolDevice* thread_pool_device,
+                                const MomentumStep& step,
+                                const Index& parameters_number,
+                                const type* gradient_data,
+                                type* parameters_data,
+                                type* velocities_data)
+{
+    const TensorOpCost cost(3*sizeof(type), 2*sizeof(type), 4);
+
+    thread_pool_device->parallelFor(parameters_number, cost, [&](Index first_index, Index last_index)
+    {
+        update_parameters_momentum_range(step, first_index, last_index, gradient_data, parameters_data, velocities_data);
+    });
+}
+
+
+/// Updates the velocities and the parameters of a stochastic gradient descent iteration in a single pass over the memory,
+/// with the velocities stored in bfloat16 precision.
+/// @param thread_pool_device Device whose threads update the ranges of values.
+/// @param step Hyperparameters of the iteration.
+/// @param parameters_number Number of parameters.
+/// @param gradient_data Pointer to the gradient.
+/// @param parameters_data Pointer to the parameters.
+/// @param velocities_data Pointer to the last parameters increments, which can be nullptr without momentum.
+
+void update_parameters_momentum(const ThreadPoolDevice* thread_pool_device,
+                                const MomentumStep& step,
+                                const Index& parameters_number,
+                                const type* gradient_data,
+                                type* parameters_data,
+                                Eigen::bfloat16* velocities_data)
+{
+    const TensorOpCost cost(2*sizeof(type) + sizeof(Eigen::bfloat16), sizeof(type) + sizeof(Eigen::bfloat16), 8);
+
+    thread_pool_device->parallelFor(parameters_number, cost, [&](Index first_index, Index last_index)
+    {
+        update_parameters_momentum_range(step, first_index, last_index, gradient_data, parameters_data, velocities_data);
+    });
+}
+
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
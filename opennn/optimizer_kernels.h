@@ -0,0 +1,104 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   O P T I M I Z E R   K E R N E L S   H E A D E R
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#ifndef OPTIMIZERKERNELS_H
+#define OPTIMIZERKERNELS_H
+
+// System includes
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// OpenNN includes
+
+#include "config.h"
+#include "execution_context.h"
+
+namespace opennn
+{
+
+/// Hyperparameters of an iteration of the adaptive moment estimation.
+/// The learning rate includes the bias corrections of the moments.
+/// The weight decay rate is the fraction by which the parameters shrink in the iteration, decoupled from the moments as in AdamW.
+
+struct AdamStep
+{
+    type learning_rate = type(0);
+
+    type beta_1 = type(0.9);
+
+    type beta_2 = type(0.999);
+
+    type epsilon = type(1.0e-7);
+
+    type weight_decay_rate = type(0);
+
+    /// Updates the moments and the parameter of a single value.
+
+    inline void update(const type& gradient, type& parameter, type& first_moment, type& second_moment) const
+    {
+        first_moment = gradient*(type(1) - beta_1) + first_moment*beta_1;
+
+        second_moment = gradient*gradient*(type(1) - beta_2) + second_moment*beta_2;
+
+        parameter = parameter*(type(1) - weight_decay_rate) - learning_rate*first_moment/(sqrt(second_moment) + epsilon);
+    }
+};
+
+
+/// Hyperparameters of an iteration of the stochastic gradient descent, with momentum and Nesterov momentum.
+/// Without momentum the velocities are not used.
+
+struct MomentumStep
+{
+    type learning_rate = type(0);
+
+    type momentum = type(0);
+
+    bool nesterov = false;
+};
+
+
+// Fused update methods
+// Each method reads the gradient once and updates the moments and the parameters in place, block by block,
+// with the blocks split across the threads of the device.
+
+void update_parameters_adam(const ThreadPoolDevice*, const AdamStep&, const Index&,
+                            const type*, type*, type*, type*);
+
+void update_parameters_adam(const ThreadPoolDevice*, const AdamStep&, const Index&,
+                            const type*, type*, Eigen::bfloat16*, Eigen::bfloat16*);
+
+void update_parameters_momentum(const ThreadPoolDevice*, const MomentumStep&, const Index&,
+                                const type*, type*, type*);
+
+void update_parameters_momentum(const ThreadPoolDevice*, const MomentumStep&, const Index&,
+                                const type*, type*, Eigen::bfloat16*);
+
+}
+
+#endif
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -113,7 +113,7 @@ type PerceptronLayer::get_dropout_rate() const
 /// The format is a vector of real values.
 /// The size of this vector is the number of neurons in the layer.
 
-const Tensor<type, 2>& PerceptronLayer::get_biases() const
+const TensorMap<Tensor<type, 2>>& PerceptronLayer::get_biases() const
 {
     return biases;
 }
@@ -125,7 +125,7 @@ const Tensor<type, 2>& PerceptronLayer::get_biases() const
 /// The number of rows is the number of neurons in the layer.
 /// The number of columns is the number of inputs to the layer.
 
-const Tensor<type, 2>& PerceptronLayer::get_synaptic_weights() const
+const TensorMap<Tensor<type, 2>>& PerceptronLayer::get_synaptic_weights() const
 {
     return synaptic_weights;
 }
@@ -173,15 +173,21 @@ Tensor<type, 1> PerceptronLayer::get_parameters() const
     Tensor<type, 1> parameters(synaptic_weights.size() + biases.size());
 
     memcpy(parameters.data(),
-           synaptic_weights.data(), static_cast<size_t>(synaptic_weights.size())*sizeof(type));
-
-    memcpy(parameters.data() + synaptic_weights.size(),
-           biases.data(), static_cast<size_t>(biases.size())*sizeof(type));
+           synaptic_weights.data(), static_cast<size_t>(synaptic_weights.size() + biases.size())*sizeof(type));
 
     return parameters;
 }
 
 
+/// Returns a pointer to the parameters of the layer.
+/// The synaptic weights are stored first, and the biases right after them.
+
+type* PerceptronLayer::get_parameters_data() const
+{
+    return synaptic_weights.data();
+}
+
+
 Tensor< TensorMap< Tensor<type, 1> >*, 1> PerceptronLayer::get_layer_parameters()
 {
     Tensor< TensorMap< Tensor<type, 1> >*, 1> layer_parameters(2);
@@ -250,6 +256,33 @@ string PerceptronLayer::write_activation_function() const
 }
 
 
+/// Returns the precision of the frozen copy of the synaptic weights used for the inference,
+/// or single if the inference uses the synaptic weights.
+
+const StoragePrecision& PerceptronLayer::get_parameters_precision() const
+{
+    return parameters_precision;
+}
+
+
+/// Returns the number of categories of each column of the inputs codes, or zero for the columns which hold values.
+/// It is empty if the layer does not read codes.
+
+const Tensor<Index, 1>& PerceptronLayer::get_inputs_categories_numbers() const
+{
+    return inputs_categories_numbers;
+}
+
+
+/// Returns true if inputs with a given number of columns are codes, and false if they are the inputs of the layer.
+/// @param inputs_columns_number Number of columns of the inputs.
+
+bool PerceptronLayer::has_inputs_codes(const Index& inputs_columns_number) const
+{
+    return inputs_categories_numbers.size() != 0 && inputs_columns_number == inputs_categories_numbers.size();
+}
+
+
 /// Returns true if messages from this class are displayed on the screen,
 /// or false if messages from this class are not displayed on the screen.
 
@@ -259,14 +292,21 @@ const bool& PerceptronLayer::get_display() const
 }
 
 
+/// Returns true if the forward propagation computes the combinations and the activations in a single pass,
+/// and false if it uses the separate combinations and activations methods.
+
+const bool& PerceptronLayer::get_fused_forward() const
+{
+    return fused_forward;
+}
+
+
 /// Sets an empty layer, wihtout any perceptron.
 /// It also sets the rest of the members to their default values.
 
 void PerceptronLayer::set()
 {
-    biases.resize(0, 0);
-
-    synaptic_weights.resize(0, 0);
+    allocate_parameters(0, 0, 0, 0);
 
     set_default();
 }
@@ -280,9 +320,9 @@ void PerceptronLayer::set()
 void PerceptronLayer::set(const Index& new_inputs_number, const Index& new_neurons_number,
                           const PerceptronLayer::ActivationFunction& new_activation_function)
 {
-    biases.resize(1, new_neurons_number);
+    allocate_parameters(new_inputs_number, new_neurons_number, 1, new_neurons_number);
 
-    synaptic_weights.resize(new_inputs_number, new_neurons_number);
+    set_inputs_categories_numbers(Tensor<Index, 1>());
 
     set_parameters_random();
 
@@ -322,9 +362,9 @@ void PerceptronLayer::set_inputs_number(const Index& new_inputs_number)
 {
     const Index neurons_number = get_neurons_number();
 
-    biases.resize(1, neurons_number);
+    allocate_parameters(new_inputs_number, neurons_number, 1, neurons_number);
 
-    synaptic_weights.resize(new_inputs_number, neurons_number);
+    set_inputs_categories_numbers(Tensor<Index, 1>());
 }
 
 
@@ -336,9 +376,95 @@ void PerceptronLayer::set_neurons_number(const Index& new_neurons_number)
 {
     const Index inputs_number = get_inputs_number();
 
-    biases.resize(1, new_neurons_number);
+    allocate_parameters(inputs_number, new_neurons_number, 1, new_neurons_number);
+}
+
+
+/// Sets the layer to also read its inputs as codes, with a column per code instead of one hot input per category.
+/// A code of k categories stands for k consecutive inputs, and holds the position of the hot one, or minus one
+/// if none is. The combinations then add the row of the synaptic weights of that input, which costs a single row
+/// per sample instead of the product of the k inputs. The other columns hold the values of the inputs.
+/// The inputs with as many columns as inputs of the layer are still read as such, for instance for the deployment.
+/// @param new_inputs_categories_numbers Number of categories of each column of the codes, or zero for the columns
+/// which hold values. It is empty to read only the inputs of the layer.
+
+void PerceptronLayer::set_inputs_categories_numbers(const Tensor<Index, 1>& new_inputs_categories_numbers)
+{
+    const Index inputs_codes_number = new_inputs_categories_numbers.size();
+
+    Index inputs_number = 0;
+    Index code_inputs_number = 0;
+
+    for(Index j = 0; j < inputs_codes_number; j++)
+    {
+        if(new_inputs_categories_numbers(j) < 0)
+        {
+            ostringstream buffer;
+
+            buffer << "OpenNN Exception: PerceptronLayer class.\n"
+                   << "void set_inputs_categories_numbers(const Tensor<Index, 1>&) method.\n"
+                   << "Number of categories (" << new_inputs_categories_numbers(j) << ") must be positive or zero.\n";
+
+            throw invalid_argument(buffer.str());
+        }
+
+        if(new_inputs_categories_numbers(j) > 1) code_inputs_number++;
+
+        inputs_number += max(new_inputs_categories_numbers(j), Index(1));
+    }
+
+    if(inputs_codes_number != 0 && inputs_number != get_inputs_number())
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: PerceptronLayer class.\n"
+               << "void set_inputs_categories_numbers(const Tensor<Index, 1>&) method.\n"
+               << "Number of coded inputs (" << inputs_number << ") must be equal to "
+               << "number of inputs (" << get_inputs_number() << ").\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    if(code_inputs_number == 0)
+    {
+        inputs_categories_numbers.resize(0);
+
+        value_inputs_indices.resize(0);
+        value_inputs_synaptic_weights_rows.resize(0);
+        code_inputs_indices.resize(0);
+        code_inputs_synaptic_weights_rows.resize(0);
+
+        return;
+    }
+
+    inputs_categories_numbers = new_inputs_categories_numbers;
+
+    value_inputs_indices.resize(inputs_codes_number - code_inputs_number);
+    value_inputs_synaptic_weights_rows.resize(inputs_codes_number - code_inputs_number);
+    code_inputs_indices.resize(code_inputs_number);
+    code_inputs_synaptic_weights_rows.resize(code_inputs_number);
+
+    Index value_index = 0;
+    Index code_index = 0;
+    Index synaptic_weights_row = 0;
+
+    for(Index j = 0; j < inputs_codes_number; j++)
+    {
+        if(inputs_categories_numbers(j) > 1)
+        {
+            code_inputs_indices(code_index) = j;
+            code_inputs_synaptic_weights_rows(code_index) = synaptic_weights_row;
+            code_index++;
+        }
+        else
+        {
+            value_inputs_indices(value_index) = j;
+            value_inputs_synaptic_weights_rows(value_index) = synaptic_weights_row;
+            value_index++;
+        }
 
-    synaptic_weights.resize(inputs_number, new_neurons_number);
+        synaptic_weights_row += max(inputs_categories_numbers(j), Index(1));
+    }
 }
 
 
@@ -347,6 +473,16 @@ void PerceptronLayer::set_neurons_number(const Index& new_neurons_number)
 
 void PerceptronLayer::set_biases(const Tensor<type, 2>& new_biases)
 {
+    if(new_biases.dimension(0) != biases.dimension(0) || new_biases.dimension(1) != biases.dimension(1))
+    {
+        const Tensor<type, 2> old_synaptic_weights = synaptic_weights;
+
+        allocate_parameters(old_synaptic_weights.dimension(0), old_synaptic_weights.dimension(1),
+                            new_biases.dimension(0), new_biases.dimension(1));
+
+        synaptic_weights = old_synaptic_weights;
+    }
+
     biases = new_biases;
 }
 
@@ -359,6 +495,17 @@ void PerceptronLayer::set_biases(const Tensor<type, 2>& new_biases)
 
 void PerceptronLayer::set_synaptic_weights(const Tensor<type, 2>& new_synaptic_weights)
 {
+    if(new_synaptic_weights.dimension(0) != synaptic_weights.dimension(0)
+    || new_synaptic_weights.dimension(1) != synaptic_weights.dimension(1))
+    {
+        const Tensor<type, 2> old_biases = biases;
+
+        allocate_parameters(new_synaptic_weights.dimension(0), new_synaptic_weights.dimension(1),
+                            old_biases.dimension(0), old_biases.dimension(1));
+
+        biases = old_biases;
+    }
+
     synaptic_weights = new_synaptic_weights;
 }
 
@@ -372,11 +519,56 @@ void PerceptronLayer::set_parameters(const Tensor<type, 1>& new_parameters, cons
 
     memcpy(synaptic_weights.data(),
            new_parameters.data() + index,
-           static_cast<size_t>(synaptic_weights.size())*sizeof(type));
+           static_cast<size_t>(synaptic_weights.size() + biases.size())*sizeof(type));
+}
+
+
+/// Moves the parameters of the layer to a block of memory, with the synaptic weights first and then the biases.
+/// The current values are copied there, and from then on the synaptic weights and the biases are views of that block.
+/// The memory is owned by the caller, usually the parameters arena of a neural network.
+/// @param new_parameters_data Pointer to a block with room for all the parameters of the layer.
 
-    memcpy(biases.data(),
-           new_parameters.data() + index + synaptic_weights.size(),
-           static_cast<size_t>(biases.size())*sizeof(type));
+void PerceptronLayer::set_parameters_data(type* new_parameters_data)
+{
+    const Index synaptic_weights_rows = synaptic_weights.dimension(0);
+    const Index synaptic_weights_columns = synaptic_weights.dimension(1);
+    const Index biases_rows = biases.dimension(0);
+    const Index biases_columns = biases.dimension(1);
+
+    if(new_parameters_data != synaptic_weights.data())
+    {
+        copy(synaptic_weights.data(), synaptic_weights.data() + synaptic_weights.size() + biases.size(), new_parameters_data);
+    }
+
+    new (&synaptic_weights) TensorMap<Tensor<type, 2>>(new_parameters_data, synaptic_weights_rows, synaptic_weights_columns);
+
+    new (&biases) TensorMap<Tensor<type, 2>>(new_parameters_data + synaptic_weights.size(), biases_rows, biases_columns);
+
+    if(new_parameters_data != parameters.data()) parameters.resize(0);
+}
+
+
+/// Allocates storage owned by the layer for the synaptic weights and the biases, and makes them views of it.
+/// This detaches the layer from any parameters arena. The values of the parameters are not initialized.
+/// @param synaptic_weights_rows Number of rows of the synaptic weights.
+/// @param synaptic_weights_columns Number of columns of the synaptic weights.
+/// @param biases_rows Number of rows of the biases.
+/// @param biases_columns Number of columns of the biases.
+
+void PerceptronLayer::allocate_parameters(const Index& synaptic_weights_rows,
+                                          const Index& synaptic_weights_columns,
+                                          const Index& biases_rows,
+                                          const Index& biases_columns)
+{
+    const Index synaptic_weights_number = synaptic_weights_rows*synaptic_weights_columns;
+
+    parameters.resize(synaptic_weights_number + biases_rows*biases_columns);
+
+    new (&synaptic_weights) TensorMap<Tensor<type, 2>>(parameters.data(), synaptic_weights_rows, synaptic_weights_columns);
+
+    new (&biases) TensorMap<Tensor<type, 2>>(parameters.data() + synaptic_weights_number, biases_rows, biases_columns);
+
+    freeze_parameters(StoragePrecision::Single);
 }
 /// This class sets a new activation(or transfer) function in a single layer.
 /// @param new_activation_function Activation function for the layer.
@@ -460,6 +652,16 @@ void PerceptronLayer::set_display(const bool& new_display)
 }
 
 
+/// Sets whether the forward propagation computes the combinations and the activations in a single pass.
+/// Both ways give the same outputs, the separate methods are kept as a reference.
+/// @param new_fused_forward True to use the fused kernel, false to use the separate methods.
+
+void PerceptronLayer::set_fused_forward(const bool& new_fused_forward)
+{
+    fused_forward = new_fused_forward;
+}
+
+
 /// Initializes the biases of all the perceptrons in the layer of perceptrons with a given value.
 /// @param value Biases initialization value.
 
@@ -513,9 +715,49 @@ void PerceptronLayer::set_parameters_random()
 }
 
 
+/// Stores a copy of the synaptic weights rounded to a reduced precision, which halves their memory.
+/// The forward propagation for the inference then reads the copy, whose values are converted to single precision
+/// while the contraction packs them into its blocks, so the combinations are accumulated in single precision.
+/// The biases are kept in single precision. The training reads the synaptic weights, and does not update the copy,
+/// so the parameters must be frozen again after they change.
+/// @param new_parameters_precision Precision of the copy, or single to release it.
+
+void PerceptronLayer::freeze_parameters(const StoragePrecision& new_parameters_precision)
+{
+    parameters_precision = new_parameters_precision;
+
+    half_synaptic_weights.resize(0, 0);
+    bfloat16_synaptic_weights.resize(0, 0);
+
+    const Index inputs_number = synaptic_weights.dimension(0);
+    const Index neurons_number = synaptic_weights.dimension(1);
+
+    switch(parameters_precision)
+    {
+    case StoragePrecision::Single: return;
+
+    case StoragePrecision::Half:
+
+        half_synaptic_weights.resize(inputs_number, neurons_number);
+
+        convert_from_single(synaptic_weights.data(), synaptic_weights.size(), half_synaptic_weights.data());
+
+        return;
+
+    case StoragePrecision::BFloat16:
+
+        bfloat16_synaptic_weights.resize(inputs_number, neurons_number);
+
+        convert_from_single(synaptic_weights.data(), synaptic_weights.size(), bfloat16_synaptic_weights.data());
+
+        return;
+    }
+}
+
+
 void PerceptronLayer::calculate_combinations(const DynamicTensor<type>& inputs,
-                                             const Tensor<type, 2>& biases,
-                                             const Tensor<type, 2>& synaptic_weights,
+                                             const TensorMap<Tensor<type, 2>>& biases,
+                                             const TensorMap<Tensor<type, 2>>& synaptic_weights,
                                              LayerForwardPropagation* layer_forward_propagation) const
 {
 #ifdef OPENNN_DEBUG
@@ -598,6 +840,252 @@ void PerceptronLayer::calculate_combinations(const DynamicTensor<type>& inputs,
 */
 
 
+/// Calculates the outputs of the layer, and optionally the activations derivatives, with a single contraction.
+/// The biases and the activation function are applied by an output kernel on each block of the contraction,
+/// so the outputs are traversed once and there is no separate dispatch per neuron.
+/// @param inputs Inputs to the layer.
+/// @param biases Biases of the neurons.
+/// @param synaptic_weights Synaptic weights of the neurons.
+/// @param layer_forward_propagation Forward propagation where the outputs and the derivatives are written.
+/// @param calculate_derivatives True to also calculate the activations derivatives.
+
+void PerceptronLayer::calculate_combinations_activations(const DynamicTensor<type>& inputs,
+                                                         const TensorMap<Tensor<type, 2>>& biases,
+                                                         const TensorMap<Tensor<type, 2>>& synaptic_weights,
+                                                         LayerForwardPropagation* layer_forward_propagation,
+                                                         const bool& calculate_derivatives) const
+{
+#ifdef OPENNN_DEBUG
+    check_columns_number(inputs, get_inputs_number(), LOG);
+
+    check_dimensions(biases, 1, get_neurons_number(), LOG);
+
+    check_dimensions(synaptic_weights, get_inputs_number(), get_neurons_number(), LOG);
+#endif
+
+    PerceptronLayerForwardPropagation* perceptron_layer_forward_propagation
+            = static_cast<PerceptronLayerForwardPropagation*>(layer_forward_propagation);
+
+    const TensorMap<Tensor<type, 2>> inputs_map = inputs.to_tensor_map<2>();
+
+    type* outputs_data = layer_forward_propagation->outputs(0).get_data();
+
+    const Eigen::array<ptrdiff_t, 2> outputs_dimensions_array = perceptron_layer_forward_propagation->get_outputs_dimensions_array();
+
+    TensorMap<Tensor<type, 2>> outputs(outputs_data, outputs_dimensions_array);
+
+    PerceptronLayerOutputKernel output_kernel;
+
+    output_kernel.biases_data = biases.data();
+    output_kernel.batch_samples_number = inputs.get_dimension(0);
+    output_kernel.activation_function = activation_function;
+
+    if(calculate_derivatives)
+    {
+        output_kernel.activations_derivatives_data = perceptron_layer_forward_propagation->activations_derivatives.data();
+    }
+
+    outputs.device(*thread_pool_device) = inputs_map.contract(synaptic_weights, A_B, output_kernel);
+}
+
+
+/// Calculates the outputs of the layer for the inference, with the frozen copy of the synaptic weights.
+/// The contraction reads the reduced precision weights through a conversion, which is evaluated while the blocks
+/// of the right hand side are packed, so the weights are never expanded to a single precision matrix.
+/// @param inputs Inputs to the layer.
+/// @param layer_forward_propagation Forward propagation where the outputs are written.
+
+void PerceptronLayer::calculate_frozen_activations(const DynamicTensor<type>& inputs,
+                                                   LayerForwardPropagation* layer_forward_propagation) const
+{
+    PerceptronLayerForwardPropagation* perceptron_layer_forward_propagation
+            = static_cast<PerceptronLayerForwardPropagation*>(layer_forward_propagation);
+
+    const TensorMap<Tensor<type, 2>> inputs_map = inputs.to_tensor_map<2>();
+
+    type* outputs_data = layer_forward_propagation->outputs(0).get_data();
+
+    const Eigen::array<ptrdiff_t, 2> outputs_dimensions_array = perceptron_layer_forward_propagation->get_outputs_dimensions_array();
+
+    TensorMap<Tensor<type, 2>> outputs(outputs_data, outputs_dimensions_array);
+
+    PerceptronLayerOutputKernel output_kernel;
+
+    output_kernel.biases_data = biases.data();
+    output_kernel.batch_samples_number = inputs.get_dimension(0);
+    output_kernel.activation_function = activation_function;
+
+    if(parameters_precision == StoragePrecision::Half)
+    {
+        outputs.device(*thread_pool_device) = inputs_map.contract(half_synaptic_weights.cast<type>(), A_B, output_kernel);
+    }
+    else
+    {
+        outputs.device(*thread_pool_device) = inputs_map.contract(bfloat16_synaptic_weights.cast<type>(), A_B, output_kernel);
+    }
+}
+
+
+/// Calculates the combinations of the layer for inputs codes.
+/// The columns which hold values are gathered, with their rows of the synaptic weights, for a contraction.
+/// Each code then adds a single row of its synaptic weights to the combinations of each sample,
+/// as an embedding bag, so that the cost grows with the number of codes instead of the number of categories.
+/// @param inputs Inputs codes, with a column per code.
+/// @param biases Biases of the neurons.
+/// @param synaptic_weights Synaptic weights of the neurons, with a row per input of the layer.
+/// @param layer_forward_propagation Forward propagation where the combinations are written as outputs.
+
+void PerceptronLayer::calculate_codes_combinations(const DynamicTensor<type>& inputs,
+                                                   const TensorMap<Tensor<type, 2>>& biases,
+                                                   const TensorMap<Tensor<type, 2>>& synaptic_weights,
+                                                   LayerForwardPropagation* layer_forward_propagation) const
+{
+    PerceptronLayerForwardPropagation* perceptron_layer_forward_propagation
+            = static_cast<PerceptronLayerForwardPropagation*>(layer_forward_propagation);
+
+    const TensorMap<Tensor<type, 2>> inputs_map = inputs.to_tensor_map<2>();
+
+    check_inputs_codes(inputs_map);
+
+    const Index batch_samples_number = inputs.get_dimension(0);
+    const Index inputs_number = get_inputs_number();
+    const Index neurons_number = get_neurons_number();
+
+    const Index value_inputs_number = value_inputs_indices.size();
+    const Index code_inputs_number = code_inputs_indices.size();
+
+    type* outputs_data = layer_forward_propagation->outputs(0).get_data();
+
+    const Eigen::array<ptrdiff_t, 2> outputs_dimensions_array = perceptron_layer_forward_propagation->get_outputs_dimensions_array();
+
+    TensorMap<Tensor<type, 2>> combinations(outputs_data, outputs_dimensions_array);
+
+    Tensor<type, 2>& value_inputs = perceptron_layer_forward_propagation->value_inputs;
+    Tensor<type, 2>& value_inputs_synaptic_weights = perceptron_layer_forward_propagation->value_inputs_synaptic_weights;
+
+    perceptron_layer_forward_propagation->inputs_codes = true;
+
+    if(value_inputs_number == 0)
+    {
+        combinations.setZero();
+    }
+    else
+    {
+        value_inputs.resize(batch_samples_number, value_inputs_number);
+        value_inputs_synaptic_weights.resize(value_inputs_number, neurons_number);
+
+        for(Index j = 0; j < value_inputs_number; j++)
+        {
+            copy(inputs_map.data() + value_inputs_indices(j)*batch_samples_number,
+                 inputs_map.data() + (value_inputs_indices(j) + 1)*batch_samples_number,
+                 value_inputs.data() + j*batch_samples_number);
+        }
+
+        for(Index i = 0; i < neurons_number; i++)
+        {
+            for(Index j = 0; j < value_inputs_number; j++)
+            {
+                value_inputs_synaptic_weights(j, i) = synaptic_weights(value_inputs_synaptic_weights_rows(j), i);
+            }
+        }
+
+        combinations.device(*thread_pool_device) = value_inputs.contract(value_inputs_synaptic_weights, A_B);
+    }
+
+    #pragma omp parallel for
+
+    for(Index i = 0; i < neurons_number; i++)
+    {
+        type* combinations_column = outputs_data + i*batch_samples_number;
+
+        const type* synaptic_weights_column = synaptic_weights.data() + i*inputs_number;
+
+        for(Index k = 0; k < batch_samples_number; k++)
+        {
+            combinations_column[k] += biases(i);
+        }
+
+        for(Index j = 0; j < code_inputs_number; j++)
+        {
+            const type* codes = inputs_map.data() + code_inputs_indices(j)*batch_samples_number;
+
+            const type* code_synaptic_weights = synaptic_weights_column + code_inputs_synaptic_weights_rows(j);
+
+            for(Index k = 0; k < batch_samples_number; k++)
+            {
+                const Index code = Index(codes[k]);
+
+                if(code >= 0) combinations_column[k] += code_synaptic_weights[code];
+            }
+        }
+    }
+}
+
+
+/// Returns the inputs of the layer for some inputs codes, with the one hot inputs of each code.
+/// @param inputs_codes Inputs codes, with a column per code.
+
+Tensor<type, 2> PerceptronLayer::expand_inputs_codes(const Tensor<type, 2>& inputs_codes) const
+{
+    const TensorMap<Tensor<type, 2>> inputs_codes_map((type*)inputs_codes.data(), inputs_codes.dimension(0), inputs_codes.dimension(1));
+
+    check_inputs_codes(inputs_codes_map);
+
+    const Index samples_number = inputs_codes.dimension(0);
+
+    Tensor<type, 2> inputs(samples_number, get_inputs_number());
+    inputs.setZero();
+
+    for(Index j = 0; j < value_inputs_indices.size(); j++)
+    {
+        inputs.chip(value_inputs_synaptic_weights_rows(j), 1) = inputs_codes.chip(value_inputs_indices(j), 1);
+    }
+
+    for(Index j = 0; j < code_inputs_indices.size(); j++)
+    {
+        for(Index k = 0; k < samples_number; k++)
+        {
+            const Index code = Index(inputs_codes(k, code_inputs_indices(j)));
+
+            if(code >= 0) inputs(k, code_inputs_synaptic_weights_rows(j) + code) = type(1);
+        }
+    }
+
+    return inputs;
+}
+
+
+/// Checks that the codes of some inputs codes are whole numbers between minus one and their number of categories.
+/// @param inputs_codes Inputs codes, with a column per code.
+
+void PerceptronLayer::check_inputs_codes(const TensorMap<Tensor<type, 2>>& inputs_codes) const
+{
+    const Index samples_number = inputs_codes.dimension(0);
+
+    for(Index j = 0; j < code_inputs_indices.size(); j++)
+    {
+        const Index categories_number = inputs_categories_numbers(code_inputs_indices(j));
+
+        for(Index k = 0; k < samples_number; k++)
+        {
+            const type code = inputs_codes(k, code_inputs_indices(j));
+
+            if(code != floor(code) || code < type(-1) || code >= type(categories_number))
+            {
+                ostringstream buffer;
+
+                buffer << "OpenNN Exception: PerceptronLayer class.\n"
+                       << "void check_inputs_codes(const TensorMap<Tensor<type, 2>>&) const method.\n"
+                       << "Code (" << code << ") must be a whole number between -1 and "
+                       << categories_number - 1 << ".\n";
+
+                throw invalid_argument(buffer.str());
+            }
+        }
+    }
+}
+
+
 void PerceptronLayer::calculate_activations(LayerForwardPropagation* layer_forward_propagation) const
 {
 
@@ -735,10 +1223,42 @@ void PerceptronLayer::forward_propagate(const Tensor<DynamicTensor<type>, 1>& in
 
 #endif
 
-    calculate_combinations(inputs(0),
-                           biases,
-                           synaptic_weights,
-                           layer_forward_propagation);
+    const bool inputs_codes = has_inputs_codes(inputs(0).get_dimension(1));
+
+    static_cast<PerceptronLayerForwardPropagation*>(layer_forward_propagation)->inputs_codes = false;
+
+    if(!is_training && parameters_precision != StoragePrecision::Single && !inputs_codes)
+    {
+        calculate_frozen_activations(inputs(0), layer_forward_propagation);
+
+        return;
+    }
+
+    if(fused_forward && !(is_training && dropout_rate > type(0)) && !inputs_codes)
+    {
+        calculate_combinations_activations(inputs(0),
+                                           biases,
+                                           synaptic_weights,
+                                           layer_forward_propagation,
+                                           is_training);
+
+        return;
+    }
+
+    if(inputs_codes)
+    {
+        calculate_codes_combinations(inputs(0),
+                                     biases,
+                                     synaptic_weights,
+                                     layer_forward_propagation);
+    }
+    else
+    {
+        calculate_combinations(inputs(0),
+                               biases,
+                               synaptic_weights,
+                               layer_forward_propagation);
+    }
 
     if(is_training && dropout_rate > type(0))
     {
@@ -800,16 +1320,45 @@ void PerceptronLayer::forward_propagate(const Tensor<DynamicTensor<type>, 1>& in
 
     const Index inputs_number = get_inputs_number();
 
-    const TensorMap<Tensor<type, 2>> potential_biases(potential_parameters.data(), 1, neurons_number);
+    // The synaptic weights come first and the biases right after them, as in get_parameters()
 
-    const TensorMap<Tensor<type, 2>> potential_synaptic_weights(potential_parameters.data() + neurons_number,
+    const TensorMap<Tensor<type, 2>> potential_synaptic_weights(potential_parameters.data(),
                                                                 inputs_number,
                                                                 neurons_number);
 
-    calculate_combinations(inputs(0),
-                           potential_biases,
-                           potential_synaptic_weights,
-                           layer_forward_propagation);
+    const TensorMap<Tensor<type, 2>> potential_biases(potential_parameters.data() + inputs_number*neurons_number,
+                                                      1,
+                                                      neurons_number);
+
+    const bool inputs_codes = has_inputs_codes(inputs(0).get_dimension(1));
+
+    static_cast<PerceptronLayerForwardPropagation*>(layer_forward_propagation)->inputs_codes = false;
+
+    if(fused_forward && dropout_rate == type(0) && !inputs_codes)
+    {
+        calculate_combinations_activations(inputs(0),
+                                           potential_biases,
+                                           potential_synaptic_weights,
+                                           layer_forward_propagation,
+                                           true);
+
+        return;
+    }
+
+    if(inputs_codes)
+    {
+        calculate_codes_combinations(inputs(0),
+                                     potential_biases,
+                                     potential_synaptic_weights,
+                                     layer_forward_propagation);
+    }
+    else
+    {
+        calculate_combinations(inputs(0),
+                               potential_biases,
+                               potential_synaptic_weights,
+                               layer_forward_propagation);
+    }
 
     if(dropout_rate > type(0))
     {
@@ -877,6 +1426,21 @@ void PerceptronLayer::calculate_hidden_delta(LayerForwardPropagation* next_layer
     }
         break;
 
+    case Type::Addition:
+    {
+        // An addition passes its deltas unchanged to each of its inputs
+
+        const Index deltas_size = perceptron_layer_back_propagation->deltas_dimensions(0)
+                                * perceptron_layer_back_propagation->deltas_dimensions(1);
+
+        const TensorMap<Tensor<type, 1>> next_deltas(next_layer_back_propagation->deltas_data, deltas_size);
+
+        TensorMap<Tensor<type, 1>> deltas(perceptron_layer_back_propagation->deltas_data, deltas_size);
+
+        deltas.device(*thread_pool_device) = next_deltas;
+    }
+        break;
+
     default: return;
     }
 }
@@ -886,7 +1450,7 @@ void PerceptronLayer::calculate_hidden_delta(PerceptronLayerForwardPropagation*
                                              PerceptronLayerBackPropagation* next_back_propagation,
                                              PerceptronLayerBackPropagation* back_propagation) const
 {
-    const Tensor<type, 2>& next_synaptic_weights = static_cast<PerceptronLayer*>(next_back_propagation->layer_pointer)->get_synaptic_weights();
+    const TensorMap<Tensor<type, 2>>& next_synaptic_weights = static_cast<PerceptronLayer*>(next_back_propagation->layer_pointer)->get_synaptic_weights();
 
     const TensorMap<Tensor<type, 2>> next_deltas(next_back_propagation->deltas_data,
                                                  next_back_propagation->deltas_dimensions(0),
@@ -962,7 +1526,7 @@ void PerceptronLayer::calculate_hidden_delta(ProbabilisticLayerForwardPropagatio
 
     const ProbabilisticLayer* probabilistic_layer_pointer = static_cast<ProbabilisticLayer*>(next_back_propagation->layer_pointer);
 
-    const Tensor<type, 2>& next_synaptic_weights = probabilistic_layer_pointer->get_synaptic_weights();
+    const TensorMap<Tensor<type, 2>>& next_synaptic_weights = probabilistic_layer_pointer->get_synaptic_weights();
 
     const Index next_neurons_number = probabilistic_layer_pointer->get_biases_number();
 
@@ -1095,7 +1659,7 @@ void PerceptronLayer::calculate_hidden_delta_lm(PerceptronLayerForwardPropagatio
                                                            PerceptronLayerBackPropagationLM* back_propagation) const
 {
 
-    const Tensor<type, 2>& next_synaptic_weights = static_cast<PerceptronLayer*>(next_back_propagation->layer_pointer)->get_synaptic_weights();
+    const TensorMap<Tensor<type, 2>>& next_synaptic_weights = static_cast<PerceptronLayer*>(next_back_propagation->layer_pointer)->get_synaptic_weights();
 
     back_propagation->deltas.device(*thread_pool_device) =
             (next_back_propagation->deltas*next_forward_propagation->activations_derivatives.reshape(Eigen::array<Index,2> {{next_forward_propagation->activations_derivatives.dimension(0),next_forward_propagation->activations_derivatives.dimension(1)}}))
@@ -1110,7 +1674,7 @@ void PerceptronLayer::calculate_hidden_delta_lm(ProbabilisticLayerForwardPropaga
 
     const ProbabilisticLayer* probabilistic_layer_pointer = static_cast<ProbabilisticLayer*>(next_back_propagation->layer_pointer);
 
-    const Tensor<type, 2>& next_synaptic_weights = probabilistic_layer_pointer->get_synaptic_weights();
+    const TensorMap<Tensor<type, 2>>& next_synaptic_weights = probabilistic_layer_pointer->get_synaptic_weights();
 
     if(probabilistic_layer_pointer->get_activation_function() == ProbabilisticLayer::ActivationFunction::Softmax)
     {
@@ -1179,6 +1743,15 @@ void PerceptronLayer::calculate_squared_errors_Jacobian_lm(const Tensor<type, 2>
                                                            LayerForwardPropagation* forward_propagation,
                                                            LayerBackPropagationLM* back_propagation)
 {
+    // The Jacobian has a value per sample and parameter anyway, so the codes are expanded into their one hot inputs
+
+    if(has_inputs_codes(inputs.dimension(1)))
+    {
+        calculate_squared_errors_Jacobian_lm(expand_inputs_codes(inputs), forward_propagation, back_propagation);
+
+        return;
+    }
+
     PerceptronLayerForwardPropagation* perceptron_layer_forward_propagation = static_cast<PerceptronLayerForwardPropagation*>(forward_propagation);
     PerceptronLayerBackPropagationLM* perceptron_layer_back_propagation_lm = static_cast<PerceptronLayerBackPropagationLM*>(back_propagation);
     const Tensor<type, 2>& activations_derivatives = perceptron_layer_forward_propagation->activations_derivatives;
@@ -1287,6 +1860,13 @@ void PerceptronLayer::calculate_error_gradient(type* inputs_data,
     PerceptronLayerBackPropagation* perceptron_layer_back_propagation =
             static_cast<PerceptronLayerBackPropagation*>(back_propagation);
 
+    if(perceptron_layer_forward_propagation->inputs_codes)
+    {
+        calculate_codes_error_gradient(inputs_data, forward_propagation, back_propagation);
+
+        return;
+    }
+
     const Eigen::array<ptrdiff_t, 2> inputs_dimensions_array = perceptron_layer_forward_propagation->get_inputs_dimensions_array();
     const Eigen::array<ptrdiff_t, 2> outputs_dimensions_array = perceptron_layer_forward_propagation->get_outputs_dimensions_array();
 
@@ -1342,6 +1922,86 @@ void PerceptronLayer::calculate_error_gradient(type* inputs_data,
 }
 
 
+/// Calculates the error gradient of the layer for inputs codes.
+/// The derivatives of the rows of the inputs which hold values are a contraction with the gathered values.
+/// The derivatives of the other rows are zero, except for those of the codes of the samples,
+/// to which the derivatives of the errors with respect to the combinations are scattered.
+/// @param inputs_data Pointer to the inputs codes, with a column per code.
+/// @param forward_propagation Forward propagation of the layer for the inputs codes.
+/// @param back_propagation Back-propagation where the gradient is written.
+
+void PerceptronLayer::calculate_codes_error_gradient(type* inputs_data,
+                                                     LayerForwardPropagation* forward_propagation,
+                                                     LayerBackPropagation* back_propagation) const
+{
+    const PerceptronLayerForwardPropagation* perceptron_layer_forward_propagation =
+            static_cast<PerceptronLayerForwardPropagation*>(forward_propagation);
+
+    PerceptronLayerBackPropagation* perceptron_layer_back_propagation =
+            static_cast<PerceptronLayerBackPropagation*>(back_propagation);
+
+    const Index batch_samples_number = perceptron_layer_forward_propagation->batch_samples_number;
+    const Index inputs_number = get_inputs_number();
+    const Index neurons_number = get_neurons_number();
+
+    const Index value_inputs_number = value_inputs_indices.size();
+    const Index code_inputs_number = code_inputs_indices.size();
+
+    const Eigen::array<ptrdiff_t, 2> outputs_dimensions_array = perceptron_layer_forward_propagation->get_outputs_dimensions_array();
+
+    const TensorMap<Tensor<type, 2>> deltas(back_propagation->deltas_data, outputs_dimensions_array);
+
+    Tensor<type, 2>& error_combinations_derivatives = perceptron_layer_back_propagation->deltas_times_activations_derivatives;
+
+    error_combinations_derivatives.device(*thread_pool_device) = deltas * perceptron_layer_forward_propagation->activations_derivatives;
+
+    perceptron_layer_back_propagation->biases_derivatives.device(*thread_pool_device) =
+            error_combinations_derivatives.sum(Eigen::array<Index, 1>({0}));
+
+    Tensor<type, 2>& value_inputs_synaptic_weights_derivatives = perceptron_layer_back_propagation->value_inputs_synaptic_weights_derivatives;
+
+    if(value_inputs_number != 0)
+    {
+        value_inputs_synaptic_weights_derivatives.resize(value_inputs_number, neurons_number);
+
+        value_inputs_synaptic_weights_derivatives.device(*thread_pool_device) =
+                perceptron_layer_forward_propagation->value_inputs.contract(error_combinations_derivatives, AT_B);
+    }
+
+    TensorMap<Tensor<type, 2>>& synaptic_weights_derivatives = perceptron_layer_back_propagation->synaptic_weights_derivatives;
+
+    #pragma omp parallel for
+
+    for(Index i = 0; i < neurons_number; i++)
+    {
+        type* synaptic_weights_derivatives_column = synaptic_weights_derivatives.data() + i*inputs_number;
+
+        fill(synaptic_weights_derivatives_column, synaptic_weights_derivatives_column + inputs_number, type(0));
+
+        for(Index j = 0; j < value_inputs_number; j++)
+        {
+            synaptic_weights_derivatives_column[value_inputs_synaptic_weights_rows(j)] = value_inputs_synaptic_weights_derivatives(j, i);
+        }
+
+        const type* error_combinations_derivatives_column = error_combinations_derivatives.data() + i*batch_samples_number;
+
+        for(Index j = 0; j < code_inputs_number; j++)
+        {
+            const type* codes = inputs_data + code_inputs_indices(j)*batch_samples_number;
+
+            type* code_synaptic_weights_derivatives = synaptic_weights_derivatives_column + code_inputs_synaptic_weights_rows(j);
+
+            for(Index k = 0; k < batch_samples_number; k++)
+            {
+                const Index code = Index(codes[k]);
+
+                if(code >= 0) code_synaptic_weights_derivatives[code] += error_combinations_derivatives_column[k];
+            }
+        }
+    }
+}
+
+
 void PerceptronLayer::insert_gradient(LayerBackPropagation* back_propagation,
                                       const Index& index,
                                       Tensor<type, 1>& gradient) const
@@ -1352,6 +2012,10 @@ void PerceptronLayer::insert_gradient(LayerBackPropagation* back_propagation,
     const Index biases_number = get_biases_number();
     const Index synaptic_weights_number = get_synaptic_weights_number();
 
+    // The derivatives are already in place when the back-propagation writes directly into the gradient
+
+    if(perceptron_layer_back_propagation->synaptic_weights_derivatives.data() == gradient.data() + index) return;
+
     copy(perceptron_layer_back_propagation->synaptic_weights_derivatives.data(),
          perceptron_layer_back_propagation->synaptic_weights_derivatives.data() + synaptic_weights_number,
          gradient.data() + index);
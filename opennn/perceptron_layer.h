@@ -80,6 +80,12 @@ public:
 
    explicit PerceptronLayer(const Index&, const Index&, const ActivationFunction& = PerceptronLayer::ActivationFunction::HyperbolicTangent);
 
+   /// The synaptic weights and the biases are views of storage which a copy would share, so copies are not allowed.
+
+   PerceptronLayer(const PerceptronLayer&) = delete;
+
+   PerceptronLayer& operator=(const PerceptronLayer&) = delete;
+
    // Get methods
 
    bool is_empty() const;
@@ -92,8 +98,8 @@ public:
 
    // Parameters
 
-   const Tensor<type, 2>& get_biases() const;
-   const Tensor<type, 2>& get_synaptic_weights() const;
+   const TensorMap<Tensor<type, 2>>& get_biases() const;
+   const TensorMap<Tensor<type, 2>>& get_synaptic_weights() const;
 
    Tensor<type, 2> get_biases(const Tensor<type, 1>&) const;
    Tensor<type, 2> get_synaptic_weights(const Tensor<type, 1>&) const;
@@ -104,8 +110,18 @@ public:
    type get_dropout_rate() const;
    Tensor<type, 1> get_parameters() const final;
 
+   type* get_parameters_data() const final;
+
    Tensor< TensorMap< Tensor<type, 1>>*, 1> get_layer_parameters() final;
 
+   const StoragePrecision& get_parameters_precision() const;
+
+   // Inputs codes
+
+   const Tensor<Index, 1>& get_inputs_categories_numbers() const;
+
+   bool has_inputs_codes(const Index&) const;
+
    // Activation functions
 
    const PerceptronLayer::ActivationFunction& get_activation_function() const;
@@ -116,6 +132,8 @@ public:
 
    const bool& get_display() const;
 
+   const bool& get_fused_forward() const;
+
    // Set methods
 
    void set();
@@ -129,6 +147,8 @@ public:
    void set_inputs_number(const Index&) final;
    void set_neurons_number(const Index&) final;
 
+   void set_inputs_categories_numbers(const Tensor<Index, 1>&);
+
    // Parameters
 
    void set_biases(const Tensor<type, 2>&);
@@ -136,6 +156,8 @@ public:
 
    void set_parameters(const Tensor<type, 1>&, const Index& index=0) final;
 
+   void set_parameters_data(type*) final;
+
    // Activation functions
 
    void set_activation_function(const ActivationFunction&);
@@ -146,6 +168,8 @@ public:
 
    void set_display(const bool&);
 
+   void set_fused_forward(const bool&);
+
    // Parameters initialization methods
    void set_biases_constant(const type&);
    void set_synaptic_weights_constant(const type&);
@@ -154,11 +178,15 @@ public:
 
    void set_parameters_random() final;
 
+   // Reduced precision methods
+
+   void freeze_parameters(const StoragePrecision&) final;
+
    // Perceptron layer combinations
 
    void calculate_combinations(const DynamicTensor<type>&,
-                               const Tensor<type, 2>&,
-                               const Tensor<type, 2>&,
+                               const TensorMap<Tensor<type, 2>>&,
+                               const TensorMap<Tensor<type, 2>>&,
                                LayerForwardPropagation*) const;
 
    // Perceptron layer activations
@@ -167,6 +195,25 @@ public:
 
    void calculate_activations_derivatives(LayerForwardPropagation*) const;
 
+   // Perceptron layer fused combinations and activations
+
+   void calculate_combinations_activations(const DynamicTensor<type>&,
+                                           const TensorMap<Tensor<type, 2>>&,
+                                           const TensorMap<Tensor<type, 2>>&,
+                                           LayerForwardPropagation*,
+                                           const bool&) const;
+
+   void calculate_frozen_activations(const DynamicTensor<type>&, LayerForwardPropagation*) const;
+
+   // Perceptron layer combinations of inputs codes
+
+   void calculate_codes_combinations(const DynamicTensor<type>&,
+                                     const TensorMap<Tensor<type, 2>>&,
+                                     const TensorMap<Tensor<type, 2>>&,
+                                     LayerForwardPropagation*) const;
+
+   Tensor<type, 2> expand_inputs_codes(const Tensor<type, 2>&) const;
+
    // Perceptron layer outputs
 
    void forward_propagate(const Tensor<DynamicTensor<type>, 1>&,
@@ -222,6 +269,10 @@ public:
                                  LayerForwardPropagation*,
                                  LayerBackPropagation*) const final;
 
+   void calculate_codes_error_gradient(type*,
+                                       LayerForwardPropagation*,
+                                       LayerBackPropagation*) const;
+
    void insert_gradient(LayerBackPropagation*,
                         const Index&,
                         Tensor<type, 1>&) const final;
@@ -239,17 +290,26 @@ public:
 
 protected:
 
+   void allocate_parameters(const Index&, const Index&, const Index&, const Index&);
+
+   void check_inputs_codes(const TensorMap<Tensor<type, 2>>&) const;
+
    // MEMBERS
 
+   /// Storage of the synaptic weights followed by the biases, used while the layer is not part of a parameters arena.
+
+   Tensor<type, 1> parameters;
 
    /// Bias is a neuron parameter that is summed with the neuron's weighted inputs
    /// and passed through the neuron's transfer function to generate the neuron's output.
+   /// It is a view of the layer parameters.
 
-   Tensor<type, 2> biases;
+   TensorMap<Tensor<type, 2>> biases = TensorMap<Tensor<type, 2>>(nullptr, 0, 0);
 
    /// This matrix contains conection strengths from a layer's inputs to its neurons.
+   /// It is a view of the layer parameters.
 
-   Tensor<type, 2> synaptic_weights;
+   TensorMap<Tensor<type, 2>> synaptic_weights = TensorMap<Tensor<type, 2>>(nullptr, 0, 0);
 
    /// Activation function variable.
 
@@ -261,6 +321,45 @@ protected:
 
    bool display = true;
 
+   /// Compute the combinations, the activations and their derivatives in a single pass over the outputs.
+   /// The separate combinations and activations methods are used otherwise, and always when dropout is active.
+
+   bool fused_forward = true;
+
+   /// Precision of the frozen copy of the synaptic weights used for the inference, or single if there is no copy.
+
+   StoragePrecision parameters_precision = StoragePrecision::Single;
+
+   /// Synaptic weights frozen in half precision.
+
+   Tensor<Eigen::half, 2> half_synaptic_weights;
+
+   /// Synaptic weights frozen in bfloat16 precision.
+
+   Tensor<Eigen::bfloat16, 2> bfloat16_synaptic_weights;
+
+   /// Number of categories of each column of the inputs codes, or zero for the columns which hold the value of an input.
+   /// A code selects one of as many consecutive rows of the synaptic weights as categories, so the layer computes
+   /// the same combinations as for the one hot inputs. It is empty if the layer does not read codes.
+
+   Tensor<Index, 1> inputs_categories_numbers;
+
+   /// Columns of the inputs codes which hold the values of inputs.
+
+   Tensor<Index, 1> value_inputs_indices;
+
+   /// Rows of the synaptic weights of the columns which hold the values of inputs.
+
+   Tensor<Index, 1> value_inputs_synaptic_weights_rows;
+
+   /// Columns of the inputs codes which hold codes.
+
+   Tensor<Index, 1> code_inputs_indices;
+
+   /// First row of the synaptic weights of the columns which hold codes.
+
+   Tensor<Index, 1> code_inputs_synaptic_weights_rows;
+
 #ifdef OPENNN_CUDA
     #include "../../opennn-cuda/opennn-cuda/perceptron_layer_cuda.h"
 #else
@@ -268,6 +367,157 @@ protected:
 #endif
 
 
+/// Output kernel of the contraction between the inputs and the synaptic weights of a perceptron layer.
+/// Eigen calls it on each block of the combinations right after the block is computed, while it is still in cache.
+/// It adds the biases and applies the activation function and, if requested, its derivatives, column by column.
+
+struct PerceptronLayerOutputKernel
+{
+    const type* biases_data = nullptr;
+
+    type* activations_derivatives_data = nullptr;
+
+    Index batch_samples_number = 0;
+
+    PerceptronLayer::ActivationFunction activation_function = PerceptronLayer::ActivationFunction::Linear;
+
+    template <typename OutputIndex, typename Scalar>
+    EIGEN_ALWAYS_INLINE void operator()(const Eigen::internal::blas_data_mapper<Scalar, OutputIndex, ColMajor>& output_mapper,
+                                        const TensorContractionParams&,
+                                        OutputIndex row_index,
+                                        OutputIndex column_index,
+                                        OutputIndex rows_number,
+                                        OutputIndex columns_number) const
+    {
+        for(OutputIndex j = 0; j < columns_number; j++)
+        {
+            Map<Array<type, Dynamic, 1>> combinations(&output_mapper(0, j), rows_number);
+
+            combinations += biases_data[column_index + j];
+
+            if(activations_derivatives_data == nullptr)
+            {
+                calculate_activations(combinations);
+            }
+            else
+            {
+                Map<Array<type, Dynamic, 1>> activations_derivatives(activations_derivatives_data
+                                                                      + (column_index + j)*batch_samples_number
+                                                                      + row_index,
+                                                                      rows_number);
+
+                calculate_activations_derivatives(combinations, activations_derivatives);
+            }
+        }
+    }
+
+    /// Overwrites the combinations with the activations.
+
+    template <typename ArrayMap>
+    void calculate_activations(ArrayMap& x) const
+    {
+        const type lambda = static_cast<type>(1.0507);
+        const type alpha = static_cast<type>(1.67326);
+
+        switch(activation_function)
+        {
+        case PerceptronLayer::ActivationFunction::Linear: return;
+
+        case PerceptronLayer::ActivationFunction::Logistic: x = (type(1) + x.exp().inverse()).inverse(); return;
+
+        case PerceptronLayer::ActivationFunction::HyperbolicTangent: x = x.tanh(); return;
+
+        case PerceptronLayer::ActivationFunction::Threshold: x = (x >= type(0)).template cast<type>(); return;
+
+        case PerceptronLayer::ActivationFunction::SymmetricThreshold: x = type(2)*(x > type(0)).template cast<type>() - type(1); return;
+
+        case PerceptronLayer::ActivationFunction::RectifiedLinear: x = (x < type(0)).select(type(0), x); return;
+
+        case PerceptronLayer::ActivationFunction::ScaledExponentialLinear:
+            x = (x < type(0)).select(lambda*alpha*(x.exp() - type(1)), lambda*x); return;
+
+        case PerceptronLayer::ActivationFunction::SoftPlus: x = (type(1) + x.exp()).log(); return;
+
+        case PerceptronLayer::ActivationFunction::SoftSign: x = (x < type(0)).select(x/(type(1) - x), x/(type(1) + x)); return;
+
+        case PerceptronLayer::ActivationFunction::HardSigmoid:
+            x = (x < type(-2.5)).select(type(0), (x > type(2.5)).select(type(1), type(0.2)*x + type(0.5))); return;
+
+        case PerceptronLayer::ActivationFunction::ExponentialLinear: x = (x < type(0)).select(x.exp() - type(1), x); return;
+
+        default: return;
+        }
+    }
+
+    /// Overwrites the combinations with the activations and writes the activations derivatives.
+    /// The derivatives that depend on the combinations are calculated before they are overwritten.
+
+    template <typename ArrayMap>
+    void calculate_activations_derivatives(ArrayMap& x, ArrayMap& dy_dx) const
+    {
+        const type lambda = static_cast<type>(1.0507);
+        const type alpha = static_cast<type>(1.67326);
+
+        switch(activation_function)
+        {
+        case PerceptronLayer::ActivationFunction::Linear: dy_dx.setConstant(type(1)); return;
+
+        case PerceptronLayer::ActivationFunction::Logistic:
+            x = (type(1) + x.exp().inverse()).inverse();
+            dy_dx = x*(type(1) - x);
+            return;
+
+        case PerceptronLayer::ActivationFunction::HyperbolicTangent:
+            x = x.tanh();
+            dy_dx = type(1) - x.square();
+            return;
+
+        case PerceptronLayer::ActivationFunction::Threshold:
+            x = (x >= type(0)).template cast<type>();
+            dy_dx.setZero();
+            return;
+
+        case PerceptronLayer::ActivationFunction::SymmetricThreshold:
+            x = type(2)*(x > type(0)).template cast<type>() - type(1);
+            dy_dx.setZero();
+            return;
+
+        case PerceptronLayer::ActivationFunction::RectifiedLinear:
+            dy_dx = (x >= type(0)).template cast<type>();
+            x = (x < type(0)).select(type(0), x);
+            return;
+
+        case PerceptronLayer::ActivationFunction::ScaledExponentialLinear:
+            dy_dx = (x < type(0)).select(lambda*alpha*x.exp(), lambda);
+            x = (x < type(0)).select(lambda*alpha*(x.exp() - type(1)), lambda*x);
+            return;
+
+        case PerceptronLayer::ActivationFunction::SoftPlus:
+            dy_dx = (type(1) + x.exp().inverse()).inverse();
+            x = (type(1) + x.exp()).log();
+            return;
+
+        case PerceptronLayer::ActivationFunction::SoftSign:
+            dy_dx = (x < type(0)).select((type(1) - x).square().inverse(), (type(1) + x).square().inverse());
+            x = (x < type(0)).select(x/(type(1) - x), x/(type(1) + x));
+            return;
+
+        case PerceptronLayer::ActivationFunction::HardSigmoid:
+            dy_dx = type(0.2)*(x >= type(-2.5) && x <= type(2.5)).template cast<type>();
+            x = (x < type(-2.5)).select(type(0), (x > type(2.5)).select(type(1), type(0.2)*x + type(0.5)));
+            return;
+
+        case PerceptronLayer::ActivationFunction::ExponentialLinear:
+            dy_dx = (x < type(0)).select(x.exp(), type(1));
+            x = (x < type(0)).select(x.exp() - type(1), x);
+            return;
+
+        default: return;
+        }
+    }
+};
+
+
 struct PerceptronLayerForwardPropagation : LayerForwardPropagation
 {
     // Default constructor
@@ -324,6 +574,15 @@ struct PerceptronLayerForwardPropagation : LayerForwardPropagation
          activations_derivatives.resize(batch_samples_number, neurons_number);
      }
 
+
+     void free_training_memory() final
+     {
+         activations_derivatives.resize(0, 0);
+
+         value_inputs.resize(0, 0);
+         value_inputs_synaptic_weights.resize(0, 0);
+     }
+
      void print() const
      {
          cout << "Activations derivatives:" << endl;
@@ -340,6 +599,18 @@ struct PerceptronLayerForwardPropagation : LayerForwardPropagation
      }
 
      Tensor<type, 2> activations_derivatives;
+
+     /// True if the last inputs were codes.
+
+     bool inputs_codes = false;
+
+     /// Columns of the last inputs codes which hold values, gathered for the contraction and the gradient.
+
+     Tensor<type, 2> value_inputs;
+
+     /// Rows of the synaptic weights of the columns which hold values.
+
+     Tensor<type, 2> value_inputs_synaptic_weights;
 };
 
 
@@ -415,6 +686,12 @@ struct PerceptronLayerBackPropagation : LayerBackPropagation
         set(new_batch_samples_number, new_layer_pointer);
     }
 
+    /// The derivatives are views of a gradient which a copy would share, so copies are not allowed.
+
+    PerceptronLayerBackPropagation(const PerceptronLayerBackPropagation&) = delete;
+
+    PerceptronLayerBackPropagation& operator=(const PerceptronLayerBackPropagation&) = delete;
+
 
     void set(const Index& new_batch_samples_number, Layer* new_layer_pointer)
     {
@@ -430,13 +707,29 @@ struct PerceptronLayerBackPropagation : LayerBackPropagation
 
         deltas_data = (type*)malloc( static_cast<size_t>(batch_samples_number*neurons_number*sizeof(type)));
 
-        biases_derivatives.resize(neurons_number);
+        gradient.resize(inputs_number*neurons_number + neurons_number);
 
-        synaptic_weights_derivatives.resize(inputs_number, neurons_number);
+        set_gradient_data(gradient.data());
 
         deltas_times_activations_derivatives.resize(batch_samples_number, neurons_number);
     }
 
+
+    /// Makes the derivatives views of a block of a gradient vector, with the synaptic weights first and then the biases.
+    /// The layer then writes its gradient directly there.
+
+    void set_gradient_data(type* new_gradient_data) final
+    {
+        const Index neurons_number = layer_pointer->get_neurons_number();
+        const Index inputs_number = layer_pointer->get_inputs_number();
+
+        new (&synaptic_weights_derivatives) TensorMap<Tensor<type, 2>>(new_gradient_data, inputs_number, neurons_number);
+
+        new (&biases_derivatives) TensorMap<Tensor<type, 1>>(new_gradient_data + inputs_number*neurons_number, neurons_number);
+
+        if(new_gradient_data != gradient.data()) gradient.resize(0);
+    }
+
     Tensor< TensorMap< Tensor<type, 1> >*, 1> get_layer_gradient()
     {
         Tensor< TensorMap< Tensor<type, 1> >*, 1> layer_gradient(2);
@@ -463,11 +756,15 @@ struct PerceptronLayerBackPropagation : LayerBackPropagation
         cout << synaptic_weights_derivatives << endl;
     }
 
-    Tensor<type, 1> biases_derivatives;
-    Tensor<type, 2> synaptic_weights_derivatives;
+    TensorMap<Tensor<type, 1>> biases_derivatives = TensorMap<Tensor<type, 1>>(nullptr, 0);
+    TensorMap<Tensor<type, 2>> synaptic_weights_derivatives = TensorMap<Tensor<type, 2>>(nullptr, 0, 0);
 
     Tensor<type, 2> deltas_times_activations_derivatives;
 
+    /// Derivatives of the rows of the synaptic weights of the inputs which hold values, when the inputs are codes.
+
+    Tensor<type, 2> value_inputs_synaptic_weights_derivatives;
+
 };
 
 }
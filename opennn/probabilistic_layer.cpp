@@ -158,7 +158,7 @@ const bool& ProbabilisticLayer::get_display() const
 
 /// Returns the biases of the layer.
 
-const Tensor<type, 2>& ProbabilisticLayer::get_biases() const
+const TensorMap<Tensor<type, 2>>& ProbabilisticLayer::get_biases() const
 {
     return biases;
 }
@@ -166,7 +166,7 @@ const Tensor<type, 2>& ProbabilisticLayer::get_biases() const
 
 /// Returns the synaptic weights of the layer.
 
-const Tensor<type, 2>& ProbabilisticLayer::get_synaptic_weights() const
+const TensorMap<Tensor<type, 2>>& ProbabilisticLayer::get_synaptic_weights() const
 {
     return synaptic_weights;
 }
@@ -217,15 +217,21 @@ Tensor<type, 1> ProbabilisticLayer::get_parameters() const
     Tensor<type, 1> parameters(synaptic_weights.size() + biases.size());
 
     memcpy(parameters.data(),
-           synaptic_weights.data(), static_cast<size_t>(synaptic_weights.size())*sizeof(type));
-
-    memcpy(parameters.data() + synaptic_weights.size(),
-           biases.data(), static_cast<size_t>(biases.size())*sizeof(type));
+           synaptic_weights.data(), static_cast<size_t>(synaptic_weights.size() + biases.size())*sizeof(type));
 
     return parameters;
 }
 
 
+/// Returns a pointer to the parameters of the layer.
+/// The synaptic weights are stored first, and the biases right after them.
+
+type* ProbabilisticLayer::get_parameters_data() const
+{
+    return synaptic_weights.data();
+}
+
+
 Tensor< TensorMap< Tensor<type, 1>>*, 1> ProbabilisticLayer::get_layer_parameters()
 {
     Tensor< TensorMap< Tensor<type, 1> >*, 1> layer_parameters(2);
@@ -245,9 +251,7 @@ Tensor< TensorMap< Tensor<type, 1>>*, 1> ProbabilisticLayer::get_layer_parameter
 
 void ProbabilisticLayer::set()
 {
-    biases.resize(0, 0);
-
-    synaptic_weights.resize(0,0);
+    allocate_parameters(0, 0, 0, 0);
 
     set_default();
 }
@@ -259,9 +263,7 @@ void ProbabilisticLayer::set()
 
 void ProbabilisticLayer::set(const Index& new_inputs_number, const Index& new_neurons_number)
 {
-    biases.resize(1, new_neurons_number);
-
-    synaptic_weights.resize(new_inputs_number, new_neurons_number);
+    allocate_parameters(new_inputs_number, new_neurons_number, 1, new_neurons_number);
 
     set_parameters_random();
 
@@ -288,9 +290,7 @@ void ProbabilisticLayer::set_inputs_number(const Index& new_inputs_number)
 {
     const Index neurons_number = get_neurons_number();
 
-    biases.resize(1, neurons_number);
-
-    synaptic_weights.resize(new_inputs_number, neurons_number);
+    allocate_parameters(new_inputs_number, neurons_number, 1, neurons_number);
 }
 
 
@@ -298,36 +298,90 @@ void ProbabilisticLayer::set_neurons_number(const Index& new_neurons_number)
 {
     const Index inputs_number = get_inputs_number();
 
-    biases.resize(1, new_neurons_number);
-
-    synaptic_weights.resize(inputs_number, new_neurons_number);
+    allocate_parameters(inputs_number, new_neurons_number, 1, new_neurons_number);
 }
 
 
 void ProbabilisticLayer::set_biases(const Tensor<type, 2>& new_biases)
 {
+    if(new_biases.dimension(0) != biases.dimension(0) || new_biases.dimension(1) != biases.dimension(1))
+    {
+        const Tensor<type, 2> old_synaptic_weights = synaptic_weights;
+
+        allocate_parameters(old_synaptic_weights.dimension(0), old_synaptic_weights.dimension(1),
+                            new_biases.dimension(0), new_biases.dimension(1));
+
+        synaptic_weights = old_synaptic_weights;
+    }
+
     biases = new_biases;
 }
 
 
 void ProbabilisticLayer::set_synaptic_weights(const Tensor<type, 2>& new_synaptic_weights)
 {
+    if(new_synaptic_weights.dimension(0) != synaptic_weights.dimension(0)
+    || new_synaptic_weights.dimension(1) != synaptic_weights.dimension(1))
+    {
+        const Tensor<type, 2> old_biases = biases;
+
+        allocate_parameters(new_synaptic_weights.dimension(0), new_synaptic_weights.dimension(1),
+                            old_biases.dimension(0), old_biases.dimension(1));
+
+        biases = old_biases;
+    }
+
     synaptic_weights = new_synaptic_weights;
 }
 
 
 void ProbabilisticLayer::set_parameters(const Tensor<type, 1>& new_parameters, const Index& index)
 {
-    const Index biases_number = biases.size();
-    const Index synaptic_weights_number = synaptic_weights.size();
-
     memcpy(synaptic_weights.data(),
            new_parameters.data() + index,
-           static_cast<size_t>(synaptic_weights_number)*sizeof(type));
+           static_cast<size_t>(synaptic_weights.size() + biases.size())*sizeof(type));
+}
+
+
+/// Moves the parameters of the layer to a block of memory, with the synaptic weights first and then the biases.
+/// The current values are copied there, and from then on the synaptic weights and the biases are views of that block.
+/// @param new_parameters_data Pointer to a block with room for all the parameters of the layer.
 
-    memcpy(biases.data(),
-           new_parameters.data() + index + synaptic_weights_number,
-           static_cast<size_t>(biases_number)*sizeof(type));
+void ProbabilisticLayer::set_parameters_data(type* new_parameters_data)
+{
+    const Index synaptic_weights_rows = synaptic_weights.dimension(0);
+    const Index synaptic_weights_columns = synaptic_weights.dimension(1);
+    const Index biases_rows = biases.dimension(0);
+    const Index biases_columns = biases.dimension(1);
+
+    if(new_parameters_data != synaptic_weights.data())
+    {
+        copy(synaptic_weights.data(), synaptic_weights.data() + synaptic_weights.size() + biases.size(), new_parameters_data);
+    }
+
+    new (&synaptic_weights) TensorMap<Tensor<type, 2>>(new_parameters_data, synaptic_weights_rows, synaptic_weights_columns);
+
+    new (&biases) TensorMap<Tensor<type, 2>>(new_parameters_data + synaptic_weights.size(), biases_rows, biases_columns);
+
+    if(new_parameters_data != parameters.data()) parameters.resize(0);
+}
+
+
+/// Allocates storage owned by the layer for the synaptic weights and the biases, and makes them views of it.
+/// This detaches the layer from any parameters arena. The values of the parameters are not initialized.
+
+void ProbabilisticLayer::allocate_parameters(const Index& synaptic_weights_rows,
+                                             const Index& synaptic_weights_columns,
+                                             const Index& biases_rows,
+                                             const Index& biases_columns)
+{
+    const Index synaptic_weights_number = synaptic_weights_rows*synaptic_weights_columns;
+
+    parameters.resize(synaptic_weights_number + biases_rows*biases_columns);
+
+    new (&synaptic_weights) TensorMap<Tensor<type, 2>>(parameters.data(), synaptic_weights_rows, synaptic_weights_columns);
+
+    new (&biases) TensorMap<Tensor<type, 2>>(parameters.data() + synaptic_weights_number, biases_rows, biases_columns);
 }
 
 
@@ -575,8 +629,8 @@ void ProbabilisticLayer::insert_parameters(const Tensor<type, 1>& parameters, co
 
 
 void ProbabilisticLayer::calculate_combinations(const DynamicTensor<type>& inputs,
-                                            const Tensor<type, 2>& biases,
-                                            const Tensor<type, 2>& synaptic_weights,
+                                            const TensorMap<Tensor<type, 2>>& biases,
+                                            const TensorMap<Tensor<type, 2>>& synaptic_weights,
                                             type* outputs_data, const Tensor<Index, 1> &outputs_dimensions) const
 {
     const Index batch_samples_number = inputs.get_dimension(0);
@@ -779,11 +833,14 @@ void ProbabilisticLayer::forward_propagate(const Tensor<DynamicTensor<type>, 1>&
     ProbabilisticLayerForwardPropagation* probabilistic_layer_forward_propagation
             = static_cast<ProbabilisticLayerForwardPropagation*>(forward_propagation);
 
-    const TensorMap<Tensor<type, 2>> potential_biases(potential_parameters.data(), neurons_number, 1);
+    // The synaptic weights come first and the biases right after them, as in get_parameters()
 
-    const TensorMap<Tensor<type, 2>> potential_synaptic_weights(potential_parameters.data()+neurons_number,
+    const TensorMap<Tensor<type, 2>> potential_synaptic_weights(potential_parameters.data(),
                                                                 inputs_number, neurons_number);
 
+    const TensorMap<Tensor<type, 2>> potential_biases(potential_parameters.data() + inputs_number*neurons_number,
+                                                      1, neurons_number);
+
     type* outputs_data = probabilistic_layer_forward_propagation->outputs(0).get_data();
 
     const Tensor<Index, 1> outputs_dimensions = probabilistic_layer_forward_propagation->outputs[0].get_dimensions();
@@ -877,6 +934,10 @@ void ProbabilisticLayer::insert_gradient(LayerBackPropagation* back_propagation,
     const ProbabilisticLayerBackPropagation* probabilistic_layer_back_propagation =
             static_cast<ProbabilisticLayerBackPropagation*>(back_propagation);
 
+    // The derivatives are already in place when the back-propagation writes directly into the gradient
+
+    if(probabilistic_layer_back_propagation->synaptic_weights_derivatives.data() == gradient.data() + index) return;
+
     copy(probabilistic_layer_back_propagation->synaptic_weights_derivatives.data(),
          probabilistic_layer_back_propagation->synaptic_weights_derivatives.data() + synaptic_weights_number,
          gradient.data() + index);
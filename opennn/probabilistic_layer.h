@@ -57,6 +57,12 @@ public:
 
    explicit ProbabilisticLayer(const Index&, const Index&);
 
+   /// The synaptic weights and the biases are views of storage which a copy would share, so copies are not allowed.
+
+   ProbabilisticLayer(const ProbabilisticLayer&) = delete;
+
+   ProbabilisticLayer& operator=(const ProbabilisticLayer&) = delete;
+
    // Enumerations
 
    /// Enumeration of the available methods for interpreting variables as probabilities.
@@ -92,6 +98,9 @@ public:
    void set_synaptic_weights(const Tensor<type, 2>&);
 
    void set_parameters(const Tensor<type, 1>&, const Index& index=0) final;
+
+   void set_parameters_data(type*) final;
+
    void set_decision_threshold(const type&);
 
    void set_activation_function(const ActivationFunction&);
@@ -101,8 +110,8 @@ public:
 
    // Parameters
 
-   const Tensor<type, 2>& get_biases() const;
-   const Tensor<type, 2>& get_synaptic_weights() const;
+   const TensorMap<Tensor<type, 2>>& get_biases() const;
+   const TensorMap<Tensor<type, 2>>& get_synaptic_weights() const;
 
    Tensor<type, 2> get_biases(Tensor<type, 1>&) const;
    Tensor<type, 2> get_synaptic_weights(Tensor<type, 1>&) const;   
@@ -110,6 +119,8 @@ public:
    Index get_parameters_number() const final;
    Tensor<type, 1> get_parameters() const final;
 
+   type* get_parameters_data() const final;
+
    Tensor< TensorMap< Tensor<type, 1>>*, 1> get_layer_parameters() final;
 
    // Display messages
@@ -131,8 +142,8 @@ public:
    // Combinations
 
    void calculate_combinations(const DynamicTensor<type>&,
-                               const Tensor<type, 2>&,
-                               const Tensor<type, 2>&,
+                               const TensorMap<Tensor<type, 2>>&,
+                               const TensorMap<Tensor<type, 2>>&,
                                type*, const Tensor<Index,1>&) const;
 
    // Activations
@@ -191,14 +202,22 @@ public:
 
 protected:
 
+   void allocate_parameters(const Index&, const Index&, const Index&, const Index&);
+
+   /// Storage of the synaptic weights followed by the biases, used while the layer is not part of a parameters arena.
+
+   Tensor<type, 1> parameters;
+
    /// Bias is a neuron parameter that is summed with the neuron's weighted inputs
    /// and passed through the neuron's trabsfer function to generate the neuron's output.
+   /// It is a view of the layer parameters.
 
-   Tensor<type, 2> biases;
+   TensorMap<Tensor<type, 2>> biases = TensorMap<Tensor<type, 2>>(nullptr, 0, 0);
 
    /// This matrix contains conection strengths from a layer's inputs to its neurons.
+   /// It is a view of the layer parameters.
 
-   Tensor<type, 2> synaptic_weights;
+   TensorMap<Tensor<type, 2>> synaptic_weights = TensorMap<Tensor<type, 2>>(nullptr, 0, 0);
 
    /// Activation function variable.
 
@@ -257,6 +276,12 @@ struct ProbabilisticLayerForwardPropagation : LayerForwardPropagation
     }
 
 
+    void free_training_memory() final
+    {
+        activations_derivatives.resize(0, 0, 0);
+    }
+
+
     void print() const
     {
         cout << "Outputs:" << endl;
@@ -346,6 +371,12 @@ struct ProbabilisticLayerBackPropagation : LayerBackPropagation
         set(new_batch_samples_number, new_layer_pointer);
     }
 
+    /// The derivatives are views of a gradient which a copy would share, so copies are not allowed.
+
+    ProbabilisticLayerBackPropagation(const ProbabilisticLayerBackPropagation&) = delete;
+
+    ProbabilisticLayerBackPropagation& operator=(const ProbabilisticLayerBackPropagation&) = delete;
+
 
     void set(const Index& new_batch_samples_number, Layer* new_layer_pointer)
     {
@@ -361,15 +392,30 @@ struct ProbabilisticLayerBackPropagation : LayerBackPropagation
 
         deltas_data = (type*)malloc( static_cast<size_t>(batch_samples_number*neurons_number*sizeof(type)));
 
-        biases_derivatives.resize(neurons_number);
+        gradient.resize(inputs_number*neurons_number + neurons_number);
 
-        synaptic_weights_derivatives.resize(inputs_number, neurons_number);
+        set_gradient_data(gradient.data());
 
         delta_row.resize(neurons_number);
 
         error_combinations_derivatives.resize(batch_samples_number, neurons_number);
     }
 
+
+    /// Makes the derivatives views of a block of a gradient vector, with the synaptic weights first and then the biases.
+
+    void set_gradient_data(type* new_gradient_data) final
+    {
+        const Index neurons_number = layer_pointer->get_neurons_number();
+        const Index inputs_number = layer_pointer->get_inputs_number();
+
+        new (&synaptic_weights_derivatives) TensorMap<Tensor<type, 2>>(new_gradient_data, inputs_number, neurons_number);
+
+        new (&biases_derivatives) TensorMap<Tensor<type, 1>>(new_gradient_data + inputs_number*neurons_number, neurons_number);
+
+        if(new_gradient_data != gradient.data()) gradient.resize(0);
+    }
+
     Tensor< TensorMap< Tensor<type, 1> >*, 1> get_layer_gradient()
     {
         Tensor< TensorMap< Tensor<type, 1> >*, 1> layer_gradient(2);
@@ -399,8 +445,8 @@ struct ProbabilisticLayerBackPropagation : LayerBackPropagation
 
     Tensor<type, 2> error_combinations_derivatives;
 
-    Tensor<type, 2> synaptic_weights_derivatives;
-    Tensor<type, 1> biases_derivatives;
+    TensorMap<Tensor<type, 2>> synaptic_weights_derivatives = TensorMap<Tensor<type, 2>>(nullptr, 0, 0);
+    TensorMap<Tensor<type, 1>> biases_derivatives = TensorMap<Tensor<type, 1>>(nullptr, 0);
 };
 
 }
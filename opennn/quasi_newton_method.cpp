@@ -72,6 +72,9 @@ string QuasiNewtonMethod::write_inverse_hessian_approximation_method() const
     case InverseHessianApproximationMethod::BFGS:
         return "BFGS";
 
+    case InverseHessianApproximationMethod::LBFGS:
+        return "L-BFGS";
+
     default:
         ostringstream buffer;
 
@@ -84,6 +87,14 @@ string QuasiNewtonMethod::write_inverse_hessian_approximation_method() const
 }
 
 
+/// Returns the number of parameters and gradient differences kept by the limited memory BFGS method.
+
+const Index& QuasiNewtonMethod::get_history_size() const
+{
+    return history_size;
+}
+
+
 const Index& QuasiNewtonMethod::get_epochs_number() const
 {
     return epochs_number;
@@ -158,6 +169,7 @@ void QuasiNewtonMethod::set_inverse_hessian_approximation_method(
 /// <ul>
 /// <li> "DFP"
 /// <li> "BFGS"
+/// <li> "L-BFGS"
 /// </ul>
 /// @param new_inverse_hessian_approximation_method_name Name of inverse hessian approximation method.
 
@@ -171,6 +183,10 @@ void QuasiNewtonMethod::set_inverse_hessian_approximation_method(const string& n
     {
         inverse_hessian_approximation_method = InverseHessianApproximationMethod::BFGS;
     }
+    else if(new_inverse_hessian_approximation_method_name == "L-BFGS")
+    {
+        inverse_hessian_approximation_method = InverseHessianApproximationMethod::LBFGS;
+    }
     else
     {
         ostringstream buffer;
@@ -184,6 +200,27 @@ void QuasiNewtonMethod::set_inverse_hessian_approximation_method(const string& n
 }
 
 
+/// Sets the number of parameters and gradient differences kept by the limited memory BFGS method.
+/// The training direction then takes time and memory proportional to that number times the number of parameters.
+/// @param new_history_size Number of differences, greater than zero.
+
+void QuasiNewtonMethod::set_history_size(const Index& new_history_size)
+{
+    if(new_history_size < 1)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: QuasiNewtonMethod class.\n"
+               << "void set_history_size(const Index&) method.\n"
+               << "History size must be greater than 0.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    history_size = new_history_size;
+}
+
+
 /// Sets a new display value.
 /// If it is set to true messages from this class are displayed on the screen;
 /// if it is set to false messages from this class are not displayed on the screen.
@@ -199,6 +236,8 @@ void QuasiNewtonMethod::set_default()
 {
     inverse_hessian_approximation_method = InverseHessianApproximationMethod::BFGS;
 
+    history_size = 10;
+
     learning_rate_algorithm.set_default();
 
     // Stopping criteria
@@ -309,6 +348,10 @@ void QuasiNewtonMethod::calculate_inverse_hessian_approximation(QuasiNewtonMehto
         calculate_BFGS_inverse_hessian(optimization_data);
         return;
 
+    case InverseHessianApproximationMethod::LBFGS:
+        update_LBFGS_history(optimization_data);
+        return;
+
     default:
         ostringstream buffer;
 
@@ -436,6 +479,119 @@ void QuasiNewtonMethod::calculate_BFGS_inverse_hessian(QuasiNewtonMehtodData& op
 }
 
 
+/// Stores the last parameters and gradient differences in the history of the limited memory BFGS method,
+/// replacing the oldest ones if the history is full.
+/// The differences are not stored if their dot product is not positive,
+/// since the inverse hessian approximation would not be positive definite.
+
+void QuasiNewtonMethod::update_LBFGS_history(QuasiNewtonMehtodData& optimization_data) const
+{
+    Tensor<type, 0> parameters_difference_dot_gradient_difference;
+
+    parameters_difference_dot_gradient_difference.device(*thread_pool_device)
+            = optimization_data.parameters_difference.contract(optimization_data.gradient_difference, AT_B);
+
+    Tensor<type, 0> gradient_difference_dot_gradient_difference;
+
+    gradient_difference_dot_gradient_difference.device(*thread_pool_device)
+            = optimization_data.gradient_difference.contract(optimization_data.gradient_difference, AT_B);
+
+    if(parameters_difference_dot_gradient_difference(0)
+    <= numeric_limits<type>::epsilon()*gradient_difference_dot_gradient_difference(0))
+    {
+        return;
+    }
+
+    const Index parameters_number = optimization_data.parameters_difference.size();
+    const Index history_capacity = optimization_data.differences_inverse_dots.size();
+
+    const Index position = optimization_data.history_position;
+
+    copy(optimization_data.parameters_difference.data(),
+         optimization_data.parameters_difference.data() + parameters_number,
+         optimization_data.parameters_differences.data() + position*parameters_number);
+
+    copy(optimization_data.gradient_difference.data(),
+         optimization_data.gradient_difference.data() + parameters_number,
+         optimization_data.gradient_differences.data() + position*parameters_number);
+
+    optimization_data.differences_inverse_dots(position) = type(1)/parameters_difference_dot_gradient_difference(0);
+
+    optimization_data.initial_inverse_hessian_scale
+            = parameters_difference_dot_gradient_difference(0)/gradient_difference_dot_gradient_difference(0);
+
+    optimization_data.history_position = (position + 1)%history_capacity;
+    optimization_data.history_count = min(optimization_data.history_count + 1, history_capacity);
+}
+
+
+/// Calculates the training direction of the limited memory BFGS method with the two-loop recursion,
+/// which multiplies the gradient by the inverse hessian approximation built from the stored differences
+/// without forming it. It takes time and memory proportional to the history size times the number of parameters.
+/// @param gradient Gradient at the current point.
+
+void QuasiNewtonMethod::calculate_LBFGS_training_direction(const Tensor<type, 1>& gradient,
+                                                           QuasiNewtonMehtodData& optimization_data) const
+{
+    const Index parameters_number = gradient.size();
+    const Index history_capacity = optimization_data.differences_inverse_dots.size();
+
+    Tensor<type, 1>& training_direction = optimization_data.training_direction;
+
+    training_direction.device(*thread_pool_device) = gradient;
+
+    Tensor<type, 0> dot;
+
+    // From the newest to the oldest differences
+
+    for(Index i = 0; i < optimization_data.history_count; i++)
+    {
+        const Index position = (optimization_data.history_position - 1 - i + history_capacity)%history_capacity;
+
+        const TensorMap<Tensor<type, 1>> parameters_difference(optimization_data.parameters_differences.data()
+                                                               + position*parameters_number, parameters_number);
+
+        const TensorMap<Tensor<type, 1>> gradient_difference(optimization_data.gradient_differences.data()
+                                                             + position*parameters_number, parameters_number);
+
+        dot.device(*thread_pool_device) = parameters_difference.contract(training_direction, AT_B);
+
+        const type coefficient = optimization_data.differences_inverse_dots(position)*dot(0);
+
+        optimization_data.directional_coefficients(position) = coefficient;
+
+        training_direction.device(*thread_pool_device) -= gradient_difference*coefficient;
+    }
+
+    if(optimization_data.history_count > 0)
+    {
+        training_direction.device(*thread_pool_device) = training_direction*optimization_data.initial_inverse_hessian_scale;
+    }
+
+    // From the oldest to the newest differences
+
+    for(Index i = optimization_data.history_count - 1; i >= 0; i--)
+    {
+        const Index position = (optimization_data.history_position - 1 - i + history_capacity)%history_capacity;
+
+        const TensorMap<Tensor<type, 1>> parameters_difference(optimization_data.parameters_differences.data()
+                                                               + position*parameters_number, parameters_number);
+
+        const TensorMap<Tensor<type, 1>> gradient_difference(optimization_data.gradient_differences.data()
+                                                             + position*parameters_number, parameters_number);
+
+        dot.device(*thread_pool_device) = gradient_difference.contract(training_direction, AT_B);
+
+        const type coefficient = optimization_data.directional_coefficients(position)
+                               - optimization_data.differences_inverse_dots(position)*dot(0);
+
+        training_direction.device(*thread_pool_device) += parameters_difference*coefficient;
+    }
+
+    training_direction.device(*thread_pool_device) = -training_direction;
+}
+
+
 /// \brief QuasiNewtonMethod::update_parameters
 /// \param batch
 /// \param forward_propagation
@@ -464,19 +620,38 @@ void QuasiNewtonMethod::update_parameters(
 
     // Get training direction
 
-    if(optimization_data.epoch == 0
-    || is_zero(optimization_data.parameters_difference)
-    || is_zero(optimization_data.gradient_difference))
+    const bool restart = optimization_data.epoch == 0
+                      || is_zero(optimization_data.parameters_difference)
+                      || is_zero(optimization_data.gradient_difference);
+
+    if(inverse_hessian_approximation_method == InverseHessianApproximationMethod::LBFGS)
     {
-        initialize_inverse_hessian_approximation(optimization_data);
+        if(restart)
+        {
+            optimization_data.history_count = 0;
+            optimization_data.history_position = 0;
+        }
+        else
+        {
+            update_LBFGS_history(optimization_data);
+        }
+
+        calculate_LBFGS_training_direction(back_propagation.gradient, optimization_data);
     }
     else
     {
-        calculate_inverse_hessian_approximation(optimization_data);
-    }
+        if(restart)
+        {
+            initialize_inverse_hessian_approximation(optimization_data);
+        }
+        else
+        {
+            calculate_inverse_hessian_approximation(optimization_data);
+        }
 
-    optimization_data.training_direction.device(*thread_pool_device)
-            = -optimization_data.inverse_hessian.contract(back_propagation.gradient, A_B);
+        optimization_data.training_direction.device(*thread_pool_device)
+                = -optimization_data.inverse_hessian.contract(back_propagation.gradient, A_B);
+    }
 
     optimization_data.training_slope.device(*thread_pool_device)
             = back_propagation.gradient.contract(optimization_data.training_direction, AT_B);
@@ -539,7 +714,10 @@ void QuasiNewtonMethod::update_parameters(
 
     optimization_data.old_gradient = back_propagation.gradient;
 
-    optimization_data.old_inverse_hessian = optimization_data.inverse_hessian;
+    if(inverse_hessian_approximation_method != InverseHessianApproximationMethod::LBFGS)
+    {
+        optimization_data.old_inverse_hessian = optimization_data.inverse_hessian;
+    }
 
     optimization_data.old_learning_rate = optimization_data.learning_rate;
 
@@ -605,6 +783,8 @@ TrainingResults QuasiNewtonMethod::perform_training()
     neural_network_pointer->set_inputs_names(inputs_names);
     neural_network_pointer->set_outputs_names(targets_names);
 
+    neural_network_pointer->set_inputs_categories_numbers(data_set_pointer->get_input_categories_numbers());
+
     if(neural_network_pointer->has_scaling_layer())
     {
         input_variables_descriptives = data_set_pointer->scale_input_variables();
@@ -836,6 +1016,17 @@ void QuasiNewtonMethod::write_XML(tinyxml2::XMLPrinter& file_stream) const
 
     file_stream.CloseElement();
 
+    // History size
+
+    file_stream.OpenElement("HistorySize");
+
+    buffer.str("");
+    buffer << history_size;
+
+    file_stream.PushText(buffer.str().c_str());
+
+    file_stream.CloseElement();
+
     // Learning rate algorithm
 
     learning_rate_algorithm.write_XML(file_stream);
@@ -994,6 +1185,25 @@ void QuasiNewtonMethod::from_XML(const tinyxml2::XMLDocument& document)
         }
     }
 
+    // History size
+    {
+        const tinyxml2::XMLElement* element = root_element->FirstChildElement("HistorySize");
+
+        if(element)
+        {
+            const Index new_history_size = static_cast<Index>(atoi(element->GetText()));
+
+            try
+            {
+                set_history_size(new_history_size);
+            }
+            catch(const invalid_argument& e)
+            {
+                cerr << e.what() << endl;
+            }
+        }
+    }
+
     // Learning rate algorithm
     {
         const tinyxml2::XMLElement* element = root_element->FirstChildElement("LearningRateAlgorithm");
@@ -56,8 +56,9 @@ public:
    // Enumerations
 
    /// Enumeration of the available training operators for obtaining the approximation to the inverse hessian.
+   /// LBFGS does not store the inverse hessian, but the last parameters and gradient differences.
 
-   enum class InverseHessianApproximationMethod{DFP, BFGS};
+   enum class InverseHessianApproximationMethod{DFP, BFGS, LBFGS};
 
    // Constructors
 
@@ -73,6 +74,8 @@ public:
    const InverseHessianApproximationMethod& get_inverse_hessian_approximation_method() const;
    string write_inverse_hessian_approximation_method() const;
 
+   const Index& get_history_size() const;
+
    const Index& get_epochs_number() const;
 
    // Stopping criteria
@@ -92,6 +95,8 @@ public:
    void set_inverse_hessian_approximation_method(const InverseHessianApproximationMethod&);
    void set_inverse_hessian_approximation_method(const string&);
 
+   void set_history_size(const Index&);
+
    void set_display(const bool&) final;
 
    void set_default() final;
@@ -112,6 +117,9 @@ public:
 
    void calculate_BFGS_inverse_hessian(QuasiNewtonMehtodData&) const;
 
+   void update_LBFGS_history(QuasiNewtonMehtodData&) const;
+   void calculate_LBFGS_training_direction(const Tensor<type, 1>&, QuasiNewtonMehtodData&) const;
+
    void initialize_inverse_hessian_approximation(QuasiNewtonMehtodData&) const;
    void calculate_inverse_hessian_approximation(QuasiNewtonMehtodData&) const;
 
@@ -142,6 +150,10 @@ private:
 
    InverseHessianApproximationMethod inverse_hessian_approximation_method;
 
+   /// Number of parameters and gradient differences kept by the limited memory BFGS method.
+
+   Index history_size;
+
    type first_learning_rate = static_cast<type>(0.01);
 
    // Stopping criteria
@@ -210,17 +222,44 @@ struct QuasiNewtonMehtodData : public OptimizationAlgorithmData
 
         gradient_difference.resize(parameters_number);
 
-        inverse_hessian.resize(parameters_number, parameters_number);
-        inverse_hessian.setZero();
-
-        old_inverse_hessian.resize(parameters_number, parameters_number);
-        old_inverse_hessian.setZero();
-
         // Optimization algorithm data
 
         training_direction.resize(parameters_number);
 
-        old_inverse_hessian_dot_gradient_difference.resize(parameters_number);
+        if(quasi_newton_method_pointer->get_inverse_hessian_approximation_method()
+        == QuasiNewtonMethod::InverseHessianApproximationMethod::LBFGS)
+        {
+            const Index history_size = quasi_newton_method_pointer->get_history_size();
+
+            inverse_hessian.resize(0, 0);
+            old_inverse_hessian.resize(0, 0);
+            old_inverse_hessian_dot_gradient_difference.resize(0);
+
+            parameters_differences.resize(parameters_number, history_size);
+            gradient_differences.resize(parameters_number, history_size);
+
+            differences_inverse_dots.resize(history_size);
+            directional_coefficients.resize(history_size);
+
+            history_count = 0;
+            history_position = 0;
+        }
+        else
+        {
+            inverse_hessian.resize(parameters_number, parameters_number);
+            inverse_hessian.setZero();
+
+            old_inverse_hessian.resize(parameters_number, parameters_number);
+            old_inverse_hessian.setZero();
+
+            old_inverse_hessian_dot_gradient_difference.resize(parameters_number);
+
+            parameters_differences.resize(0, 0);
+            gradient_differences.resize(0, 0);
+
+            differences_inverse_dots.resize(0);
+            directional_coefficients.resize(0);
+        }
     }
 
     virtual void print() const
@@ -255,6 +294,27 @@ struct QuasiNewtonMehtodData : public OptimizationAlgorithmData
 
     Tensor<type, 1> old_inverse_hessian_dot_gradient_difference;
 
+    // Limited memory BFGS data
+
+    /// Last parameters and gradient differences, one per column, stored circularly.
+
+    Tensor<type, 2> parameters_differences;
+    Tensor<type, 2> gradient_differences;
+
+    /// Inverse of the dot product of each parameters difference with its gradient difference.
+
+    Tensor<type, 1> differences_inverse_dots;
+
+    Tensor<type, 1> directional_coefficients;
+
+    /// Dot product of the last parameters and gradient differences over the squared norm of the gradient difference.
+    /// It scales the initial inverse hessian approximation.
+
+    type initial_inverse_hessian_scale = type(1);
+
+    Index history_count = 0;
+    Index history_position = 0;
+
     // Optimization algorithm data
 
     Index epoch = 0;
@@ -938,7 +938,7 @@ void RecurrentLayer::calculate_hidden_delta(PerceptronLayerForwardPropagation* n
                                             PerceptronLayerBackPropagation* next_back_propagation,
                                             RecurrentLayerBackPropagation* back_propagation) const
 {
-    const Tensor<type, 2>& next_synaptic_weights
+    const TensorMap<Tensor<type, 2>>& next_synaptic_weights
             = static_cast<PerceptronLayer*>(next_back_propagation->layer_pointer)->get_synaptic_weights();
 
     const TensorMap<Tensor<type, 2>> next_deltas(next_back_propagation->deltas_data,
@@ -960,7 +960,7 @@ void RecurrentLayer::calculate_hidden_delta(ProbabilisticLayerForwardPropagation
 {
     const ProbabilisticLayer* probabilistic_layer_pointer = static_cast<ProbabilisticLayer*>(next_back_propagation->layer_pointer);
 
-    const Tensor<type, 2>& next_synaptic_weights = probabilistic_layer_pointer->get_synaptic_weights();
+    const TensorMap<Tensor<type, 2>>& next_synaptic_weights = probabilistic_layer_pointer->get_synaptic_weights();
 
     const TensorMap<Tensor<type, 2>> next_deltas(next_back_propagation->deltas_data, next_back_propagation->deltas_dimensions(0), next_back_propagation->deltas_dimensions(1));;
     TensorMap<Tensor<type, 2>> deltas(back_propagation->deltas_data, back_propagation->deltas_dimensions(0), back_propagation->deltas_dimensions(1));
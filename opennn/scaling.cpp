@@ -274,6 +274,75 @@ void unscale_logarithmic(Tensor<type, 2>& matrix, const Index& column_index)
         matrix(i, column_index) = exp(matrix(i, column_index));
     }
 }
+
+
+/// Scales an array of values of a variable with the given method and descriptives.
+/// The values are scaled as the column of a matrix by the methods above,
+/// but the minimum of the logarithmic scaling is that of the descriptives.
+/// The array is mapped as a tensor, so that the transform is vectorized.
+/// @param values Pointer to the values of the variable.
+/// @param values_number Number of values.
+/// @param scaler Scaling method.
+/// @param descriptives Descriptives of the variable.
+
+void scale_values(type* values,
+                  const Index& values_number,
+                  const Scaler& scaler,
+                  const Descriptives& descriptives,
+                  const type& min_range, const type& max_range)
+{
+    TensorMap<Tensor<type, 1>> values_map(values, values_number);
+
+    type slope = type(1);
+    type intercept = type(0);
+
+    switch(scaler)
+    {
+    case Scaler::NoScaling:
+        return;
+
+    case Scaler::MinimumMaximum:
+        if(abs(descriptives.maximum - descriptives.minimum) < static_cast<type>(1e-3))
+        {
+            slope = type(0);
+        }
+        else
+        {
+            slope = (max_range-min_range)/(descriptives.maximum-descriptives.minimum);
+            intercept = (min_range*descriptives.maximum-max_range*descriptives.minimum)/(descriptives.maximum-descriptives.minimum);
+        }
+        break;
+
+    case Scaler::MeanStandardDeviation:
+        if(descriptives.standard_deviation >= static_cast<type>(NUMERIC_LIMITS_MIN))
+        {
+            slope = type(1)/descriptives.standard_deviation;
+            intercept = -descriptives.mean/descriptives.standard_deviation;
+        }
+        break;
+
+    case Scaler::StandardDeviation:
+        if(descriptives.standard_deviation >= static_cast<type>(NUMERIC_LIMITS_MIN))
+        {
+            slope = type(1)/descriptives.standard_deviation;
+        }
+        break;
+
+    case Scaler::Logarithm:
+    {
+        const type offset = descriptives.minimum <= type(0)
+                ? abs(descriptives.minimum) + type(1) + NUMERIC_LIMITS_MIN
+                : type(0);
+
+        values_map = (values_map + offset).log();
+
+        return;
+    }
+    }
+
+    values_map = values_map*slope + intercept;
+}
+
 }
 
 
@@ -44,6 +44,8 @@ namespace opennn
     void unscale_standard_deviation(Tensor<type, 2>&, const Index&, const Descriptives&);
     void unscale_logarithmic(Tensor<type, 2>&, const Index&);
 
+    void scale_values(type*, const Index&, const Scaler&, const Descriptives&, const type& = type(-1), const type& = type(1));
+
 }
 
 #endif // STATISTICS_H
@@ -7,6 +7,7 @@
 //   artelnics@artelnics.com
 
 #include "statistics.h"
+#include "statistics_accumulator.h"
 #include "tensor_utilities.h"
 
 namespace opennn
@@ -1238,22 +1239,23 @@ type median(const Tensor<type, 1>& vector)
         }
     }
 
-    // Calculate median
+    // Calculate median, selecting the middle elements instead of sorting
 
-    sort(sorted_vector.data(), sorted_vector.data() + sorted_vector.size(), less<type>());
+    const Index median_index = static_cast<Index>(new_size / 2);
+
+    type* begin = sorted_vector.data();
+    type* end = sorted_vector.data() + new_size;
 
-    Index median_index;
+    nth_element(begin, begin + median_index, end);
 
     if(new_size % 2 == 0)
     {
-        median_index = static_cast<Index>(new_size / 2);
+        const type lower_median = *max_element(begin, begin + median_index);
 
-        return (sorted_vector(median_index-1) + sorted_vector(median_index)) / static_cast<type>(2.0);
+        return (lower_median + sorted_vector(median_index)) / static_cast<type>(2.0);
     }
     else
     {
-        median_index = static_cast<Index>(new_size / 2);
-
         return sorted_vector(median_index);
     }
 }
@@ -1384,6 +1386,17 @@ Tensor<type, 1> quartiles(const Tensor<type, 1>& vector, const Tensor<Index, 1>&
 
     sort(sorted_vector.data(), sorted_vector.data() + sorted_vector.size(), less<type>());
 
+    return sorted_quartiles(sorted_vector);
+}
+
+
+/// Returns the quartiles of a vector sorted in ascending order, without missing values.
+/// @param sorted_vector Sorted vector to be evaluated.
+
+Tensor<type, 1> sorted_quartiles(const Tensor<type, 1>& sorted_vector)
+{
+    const Index new_size = sorted_vector.size();
+
     // Calculate quartiles
 
     Tensor<type, 1> first_sorted_vector(new_size/2);
@@ -1856,26 +1869,22 @@ Tensor<Descriptives, 1> descriptives(const Tensor<type, 2>& matrix)
 
 #endif
 
-    Tensor<Descriptives, 1> descriptives(columns_number);
-
-    Tensor<type, 1> column(rows_number);
+    Tensor<Index, 1> rows_indices(rows_number);
 
-    //    #pragma omp parallel for private(column)
+    for(Index i = 0; i < rows_number; i++) rows_indices(i) = i;
 
-    for(Index i = 0; i < columns_number; i++)
-    {
-        column = matrix.chip(i,1);
+    Tensor<Index, 1> columns_indices(columns_number);
 
-        descriptives(i) = opennn::descriptives(column);
-    }
+    for(Index i = 0; i < columns_number; i++) columns_indices(i) = i;
 
-    return descriptives;
+    return descriptives(matrix, rows_indices, columns_indices);
 }
 
 
 /// Returns the basic descriptives of given columns for given rows.
 /// The format is a vector of descriptives structures.
 /// The size of that vector is equal to the number of given columns.
+/// The columns are accumulated in a single parallel pass, and the missing values are skipped.
 /// @param row_indices Indices of the rows for which the descriptives are to be computed.
 /// @param columns_indices Indices of the columns for which the descriptives are to be computed.
 
@@ -1883,86 +1892,17 @@ Tensor<Descriptives, 1> descriptives(const Tensor<type, 2>& matrix,
                                      const Tensor<Index, 1>& row_indices,
                                      const Tensor<Index, 1>& columns_indices)
 {
-    const Index row_indices_size = row_indices.size();
     const Index columns_indices_size = columns_indices.size();
 
-    Tensor<Descriptives, 1> descriptives(columns_indices_size);
-
-    Index row_index;
-    Index column_index;
-
-    Tensor<type, 1> minimums(columns_indices_size);
-    minimums.setConstant(numeric_limits<type>::max());
-
-    Tensor<type, 1> maximums(columns_indices_size);
-    maximums.setConstant(type(NUMERIC_LIMITS_MIN));
-
-    Tensor<double, 1> sums(columns_indices_size);
-    Tensor<double, 1> squared_sums(columns_indices_size);
-    Tensor<Index, 1> count(columns_indices_size);
-
-    sums.setZero();
-    squared_sums.setZero();
-    count.setZero();
-
-    for(Index i = 0; i < row_indices_size; i++)
-    {
-        row_index = row_indices(i);
-
-        //        #pragma omp parallel for private(column_index)
-
-        for(Index j = 0; j < columns_indices_size; j++)
-        {
-            column_index = columns_indices(j);
-
-            const type value = matrix(row_index,column_index);
-
-            if(isnan(value)) continue;
-
-            if(value < minimums(j)) minimums(j) = value;
-
-            if(value > maximums(j)) maximums(j) = value;
-
-            sums(j) += double(value);
-            squared_sums(j) += double(value)*double(value);
-            count(j)++;
-        }
-    }
-
-    const Tensor<double, 1> mean = sums/count.cast<double>();
+    const Tensor<StatisticsAccumulator, 1> accumulators = accumulate_statistics(matrix, row_indices, columns_indices);
 
-    Tensor<double, 1> standard_deviation(columns_indices_size);
-
-    if(row_indices_size > 1)
-    {
-        //        #pragma omp parallel for
-
-        for(Index i = 0; i < columns_indices_size; i++)
-        {
-            const double variance = squared_sums(i)/static_cast<double>(count(i)-1)
-                    - (sums(i)/static_cast<double>(count(i)))*(sums(i)/static_cast<double>(count(i)))*static_cast<double>(count(i))/static_cast<double>(count(i)-1);
-
-            standard_deviation(i) = sqrt(variance);
-        }
-    }
-    else
-    {
-        for(Index i = 0; i < columns_indices_size; i++)
-        {
-            standard_deviation(i) = 0;
-        }
-    }
+    Tensor<Descriptives, 1> descriptives(columns_indices_size);
 
     for(Index i = 0; i < columns_indices_size; i++)
     {
-        descriptives(i).minimum = type(minimums(i));
-        descriptives(i).maximum = type(maximums(i));
-        descriptives(i).mean = type(mean(i));
-        descriptives(i).standard_deviation = type(standard_deviation(i));
+        descriptives(i) = accumulators(i).to_descriptives();
     }
 
-
-
     return descriptives;
 }
 
@@ -3279,12 +3219,27 @@ Tensor<type, 1> percentiles(const Tensor<type, 1>& vector)
         }
     }
 
+    // Select the elements of the percentiles in ascending order, instead of sorting the whole vector
+
     Tensor<type, 1> sorted_vector(new_vector);
 
-    sort(sorted_vector.data(), sorted_vector.data() + new_size, less<type>());
+    Index sorted_begin = 0;
 
-    /// Aempirical
-    ///
+    for(Index i = 0; i < 9; i++)
+    {
+        const Index rank = new_size * (i + 1) / 10;
+
+        for(Index selected_rank : {rank - 1, rank})
+        {
+            if(selected_rank < sorted_begin || selected_rank >= new_size) continue;
+
+            nth_element(sorted_vector.data() + sorted_begin,
+                        sorted_vector.data() + selected_rank,
+                        sorted_vector.data() + new_size);
+
+            sorted_begin = selected_rank + 1;
+        }
+    }
 
     Tensor<type, 1> percentiles(10);
 
@@ -253,6 +253,7 @@ struct Histogram
      // Quartiles
      Tensor<type, 1> quartiles(const Tensor<type, 1>&);
      Tensor<type, 1> quartiles(const Tensor<type, 1>&, const Tensor<Index, 1>&);
+     Tensor<type, 1> sorted_quartiles(const Tensor<type, 1>&);
 
      // Box plot
      BoxPlot box_plot(const Tensor<type, 1>&);
@@ -0,0 +1,784 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   S T A T I S T I C S   A C C U M U L A T O R   C L A S S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "statistics_accumulator.h"
+
+namespace opennn
+{
+
+/// Capacity constructor.
+/// It creates an empty sketch.
+/// @param new_capacity Maximum number of values of each compactor, and number of values summarized exactly.
+
+QuantileSketch::QuantileSketch(const Index& new_capacity)
+{
+    set(new_capacity);
+}
+
+
+/// Destructor.
+
+QuantileSketch::~QuantileSketch()
+{
+}
+
+
+/// Returns the maximum number of values of each compactor.
+
+const Index& QuantileSketch::get_capacity() const
+{
+    return capacity;
+}
+
+
+/// Returns the number of values added to the sketch.
+
+const Index& QuantileSketch::get_values_number() const
+{
+    return values_number;
+}
+
+
+/// Returns true if the sketch holds all the values added to it, so that its quantiles are exact.
+
+bool QuantileSketch::is_exact() const
+{
+    return compactors.size() == 1;
+}
+
+
+/// Empties the sketch and sets the capacity of its compactors.
+/// @param new_capacity Maximum number of values of each compactor. It must be greater than one.
+
+void QuantileSketch::set(const Index& new_capacity)
+{
+    if(new_capacity < 2)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: QuantileSketch class.\n"
+               << "void set(const Index&) method.\n"
+               << "Capacity (" << new_capacity << ") must be greater than 1.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    capacity = new_capacity;
+
+    values_number = 0;
+
+    compactors.assign(1, vector<type>());
+    compactors_parities.assign(1, false);
+}
+
+
+/// Adds a value to the sketch.
+/// @param value Value, which must not be missing.
+
+void QuantileSketch::add(const type& value)
+{
+    compactors[0].push_back(value);
+
+    values_number++;
+
+    if(Index(compactors[0].size()) >= capacity) compact(0);
+}
+
+
+/// Adds the values summarized by another sketch.
+/// @param other_quantile_sketch Sketch to be merged.
+
+void QuantileSketch::merge(const QuantileSketch& other_quantile_sketch)
+{
+    const size_t other_compactors_number = other_quantile_sketch.compactors.size();
+
+    while(compactors.size() < other_compactors_number)
+    {
+        compactors.emplace_back();
+        compactors_parities.push_back(false);
+    }
+
+    for(size_t h = 0; h < other_compactors_number; h++)
+    {
+        const vector<type>& other_compactor = other_quantile_sketch.compactors[h];
+
+        compactors[h].insert(compactors[h].end(), other_compactor.begin(), other_compactor.end());
+    }
+
+    values_number += other_quantile_sketch.values_number;
+
+    for(size_t h = 0; h < compactors.size(); h++)
+    {
+        if(Index(compactors[h].size()) >= capacity) compact(h);
+    }
+}
+
+
+/// Returns the sorted values held by the sketch.
+/// If the sketch is exact, they are all the values added to it.
+
+Tensor<type, 1> QuantileSketch::get_sorted_values() const
+{
+    Index size = 0;
+
+    for(const vector<type>& compactor : compactors) size += Index(compactor.size());
+
+    Tensor<type, 1> sorted_values(size);
+
+    Index index = 0;
+
+    for(const vector<type>& compactor : compactors)
+    {
+        copy(compactor.begin(), compactor.end(), sorted_values.data() + index);
+
+        index += Index(compactor.size());
+    }
+
+    sort(sorted_values.data(), sorted_values.data() + size);
+
+    return sorted_values;
+}
+
+
+/// Returns the smallest value whose rank is at least a fraction of the number of values.
+/// The rank error is a small fraction of the number of values, which decreases with the capacity.
+/// @param fraction Fraction of the values, between 0 and 1.
+
+type QuantileSketch::calculate_quantile(const type& fraction) const
+{
+    if(values_number == 0) return type(NAN);
+
+    vector<pair<type, Index>> weighted_values;
+
+    for(size_t h = 0; h < compactors.size(); h++)
+    {
+        const Index weight = Index(1) << h;
+
+        for(const type& value : compactors[h]) weighted_values.emplace_back(value, weight);
+    }
+
+    sort(weighted_values.begin(), weighted_values.end());
+
+    Index total_weight = 0;
+
+    for(const pair<type, Index>& weighted_value : weighted_values) total_weight += weighted_value.second;
+
+    const double rank = max(1.0, ceil(double(fraction)*double(total_weight)));
+
+    Index cumulative_weight = 0;
+
+    for(const pair<type, Index>& weighted_value : weighted_values)
+    {
+        cumulative_weight += weighted_value.second;
+
+        if(double(cumulative_weight) >= rank) return weighted_value.first;
+    }
+
+    return weighted_values.back().first;
+}
+
+
+/// Sorts a full compactor and promotes every other value to the next one.
+/// If the number of values is odd, the largest one stays in the compactor.
+/// @param h Index of the compactor.
+
+void QuantileSketch::compact(const size_t& h)
+{
+    if(h + 1 == compactors.size())
+    {
+        compactors.emplace_back();
+        compactors_parities.push_back(false);
+    }
+
+    vector<type>& compactor = compactors[h];
+    vector<type>& next_compactor = compactors[h + 1];
+
+    sort(compactor.begin(), compactor.end());
+
+    const size_t size = compactor.size();
+    const size_t pairs_size = size - size%2;
+
+    const size_t offset = compactors_parities[h] ? 1 : 0;
+
+    compactors_parities[h] = !compactors_parities[h];
+
+    for(size_t i = offset; i < pairs_size; i += 2)
+    {
+        next_compactor.push_back(compactor[i]);
+    }
+
+    if(size%2 == 1)
+    {
+        compactor[0] = compactor[size - 1];
+        compactor.resize(1);
+    }
+    else
+    {
+        compactor.clear();
+    }
+
+    if(Index(next_compactor.size()) >= capacity) compact(h + 1);
+}
+
+
+/// Default constructor.
+/// It creates an empty accumulator.
+/// @param new_has_quantiles True if the accumulator keeps a quantile sketch.
+/// @param new_maximum_distinct_values_number Maximum number of distinct values kept, or 0 if they are not kept.
+
+StatisticsAccumulator::StatisticsAccumulator(const bool& new_has_quantiles, const Index& new_maximum_distinct_values_number)
+{
+    has_quantiles = new_has_quantiles;
+
+    maximum_distinct_values_number = new_maximum_distinct_values_number;
+}
+
+
+/// Destructor.
+
+StatisticsAccumulator::~StatisticsAccumulator()
+{
+}
+
+
+/// Returns the number of values which are not missing.
+
+const Index& StatisticsAccumulator::get_count() const
+{
+    return count;
+}
+
+
+/// Returns the number of missing values.
+
+const Index& StatisticsAccumulator::get_missing_values_number() const
+{
+    return missing_values_number;
+}
+
+
+/// Returns the minimum of the values, or NAN if there are none.
+
+type StatisticsAccumulator::get_minimum() const
+{
+    return count == 0 ? type(NAN) : minimum;
+}
+
+
+/// Returns the maximum of the values, or NAN if there are none.
+
+type StatisticsAccumulator::get_maximum() const
+{
+    return count == 0 ? type(NAN) : maximum;
+}
+
+
+/// Returns the mean of the values, or NAN if there are none.
+
+type StatisticsAccumulator::get_mean() const
+{
+    return count == 0 ? type(NAN) : type(mean);
+}
+
+
+/// Returns the sample standard deviation of the values, or 0 if there are less than two.
+
+type StatisticsAccumulator::get_standard_deviation() const
+{
+    return count <= 1 ? type(0) : type(sqrt(squared_deviations_sum/double(count - 1)));
+}
+
+
+/// Returns true if the accumulator keeps the distinct values and there are no more than the maximum.
+
+bool StatisticsAccumulator::has_distinct_values() const
+{
+    return maximum_distinct_values_number > 0 && !has_too_many_distinct_values;
+}
+
+
+/// Returns the number of distinct values kept.
+
+Index StatisticsAccumulator::get_distinct_values_number() const
+{
+    return Index(distinct_values.size());
+}
+
+
+/// Returns the quantile sketch of the values.
+
+const QuantileSketch& StatisticsAccumulator::get_quantile_sketch() const
+{
+    return quantile_sketch;
+}
+
+
+/// Adds a value to the accumulator.
+/// @param value Value, which is counted as missing if it is NAN.
+
+void StatisticsAccumulator::add(const type& value)
+{
+    if(isnan(value))
+    {
+        missing_values_number++;
+
+        return;
+    }
+
+    count++;
+
+    if(value < minimum) minimum = value;
+    if(value > maximum) maximum = value;
+
+    const double delta = double(value) - mean;
+
+    mean += delta/double(count);
+
+    squared_deviations_sum += delta*(double(value) - mean);
+
+    if(has_quantiles) quantile_sketch.add(value);
+
+    if(maximum_distinct_values_number > 0 && !has_too_many_distinct_values)
+    {
+        for(pair<type, Index>& distinct_value : distinct_values)
+        {
+            if(distinct_value.first == value)
+            {
+                distinct_value.second++;
+
+                return;
+            }
+        }
+
+        if(Index(distinct_values.size()) < maximum_distinct_values_number)
+        {
+            distinct_values.emplace_back(value, 1);
+        }
+        else
+        {
+            has_too_many_distinct_values = true;
+
+            distinct_values.clear();
+        }
+    }
+}
+
+
+/// Adds the values accumulated by another accumulator of the same kind.
+/// @param other_accumulator Accumulator to be merged.
+
+void StatisticsAccumulator::merge(const StatisticsAccumulator& other_accumulator)
+{
+    missing_values_number += other_accumulator.missing_values_number;
+
+    if(other_accumulator.count == 0) return;
+
+    const double new_count = double(count + other_accumulator.count);
+
+    const double delta = other_accumulator.mean - mean;
+
+    squared_deviations_sum += other_accumulator.squared_deviations_sum
+                            + delta*delta*double(count)*double(other_accumulator.count)/new_count;
+
+    mean += delta*double(other_accumulator.count)/new_count;
+
+    count += other_accumulator.count;
+
+    minimum = min(minimum, other_accumulator.minimum);
+    maximum = max(maximum, other_accumulator.maximum);
+
+    if(has_quantiles) quantile_sketch.merge(other_accumulator.quantile_sketch);
+
+    if(maximum_distinct_values_number == 0 || has_too_many_distinct_values) return;
+
+    if(other_accumulator.has_too_many_distinct_values)
+    {
+        has_too_many_distinct_values = true;
+
+        distinct_values.clear();
+
+        return;
+    }
+
+    for(const pair<type, Index>& other_distinct_value : other_accumulator.distinct_values)
+    {
+        auto iterator = find_if(distinct_values.begin(), distinct_values.end(),
+                                [&](const pair<type, Index>& distinct_value){ return distinct_value.first == other_distinct_value.first; });
+
+        if(iterator != distinct_values.end())
+        {
+            iterator->second += other_distinct_value.second;
+        }
+        else if(Index(distinct_values.size()) < maximum_distinct_values_number)
+        {
+            distinct_values.push_back(other_distinct_value);
+        }
+        else
+        {
+            has_too_many_distinct_values = true;
+
+            distinct_values.clear();
+
+            return;
+        }
+    }
+}
+
+
+/// Returns the minimum, maximum, mean and standard deviation of the values.
+
+Descriptives StatisticsAccumulator::to_descriptives() const
+{
+    return Descriptives(get_minimum(), get_maximum(), get_mean(), get_standard_deviation());
+}
+
+
+/// Returns the first quartile, the median and the third quartile of the values.
+/// They are the same as those of the quartiles() method while the quantile sketch is exact,
+/// and they are estimated from the sketch afterwards.
+
+Tensor<type, 1> StatisticsAccumulator::calculate_quartiles() const
+{
+    if(!has_quantiles)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: StatisticsAccumulator class.\n"
+               << "Tensor<type, 1> calculate_quartiles() const method.\n"
+               << "The accumulator does not keep the quantiles.\n";
+
+        throw logic_error(buffer.str());
+    }
+
+    if(count == 0)
+    {
+        Tensor<type, 1> quartiles(3);
+        quartiles.setConstant(type(NAN));
+
+        return quartiles;
+    }
+
+    if(quantile_sketch.is_exact()) return sorted_quartiles(quantile_sketch.get_sorted_values());
+
+    Tensor<type, 1> quartiles(3);
+
+    quartiles(0) = quantile_sketch.calculate_quantile(type(0.25));
+    quartiles(1) = quantile_sketch.calculate_quantile(type(0.5));
+    quartiles(2) = quantile_sketch.calculate_quantile(type(0.75));
+
+    return quartiles;
+}
+
+
+/// Returns the minimum, the quartiles and the maximum of the values.
+
+BoxPlot StatisticsAccumulator::to_box_plot() const
+{
+    const Tensor<type, 1> quartiles = calculate_quartiles();
+
+    return BoxPlot(get_minimum(), quartiles(0), quartiles(1), quartiles(2), get_maximum());
+}
+
+
+/// Returns the histogram with a bin for each distinct value, sorted in ascending order.
+
+Histogram StatisticsAccumulator::to_distinct_values_histogram() const
+{
+    if(!has_distinct_values())
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: StatisticsAccumulator class.\n"
+               << "Histogram to_distinct_values_histogram() const method.\n"
+               << "The accumulator does not keep the distinct values.\n";
+
+        throw logic_error(buffer.str());
+    }
+
+    vector<pair<type, Index>> sorted_distinct_values(distinct_values);
+
+    sort(sorted_distinct_values.begin(), sorted_distinct_values.end());
+
+    const Index bins_number = Index(sorted_distinct_values.size());
+
+    Tensor<type, 1> centers(bins_number);
+    Tensor<Index, 1> frequencies(bins_number);
+
+    for(Index i = 0; i < bins_number; i++)
+    {
+        centers(i) = sorted_distinct_values[size_t(i)].first;
+        frequencies(i) = sorted_distinct_values[size_t(i)].second;
+    }
+
+    return Histogram(frequencies, centers, centers, centers);
+}
+
+
+/// Accumulates the statistics of some columns of a matrix over some of its rows, in a single parallel pass.
+/// The rows of each column are split into chunks, so that there are about as many tasks as threads,
+/// and the accumulators of the chunks of a column are merged in order.
+/// @param matrix Column major matrix.
+/// @param rows_indices Indices of the rows. They are read faster in ascending order.
+/// @param columns_indices Indices of the columns.
+/// @param accumulator Empty accumulator, which sets the kind of accumulators.
+
+Tensor<StatisticsAccumulator, 1> accumulate_statistics(const Tensor<type, 2>& matrix,
+                                                       const Tensor<Index, 1>& rows_indices,
+                                                       const Tensor<Index, 1>& columns_indices,
+                                                       const StatisticsAccumulator& accumulator)
+{
+    const Index rows_number = rows_indices.size();
+    const Index columns_number = columns_indices.size();
+
+    const Index minimum_chunk_rows_number = 16384;
+
+    const Index threads_number = max(Index(1), Index(ExecutionContext::get_threads_number()));
+
+    const Index chunks_number = max(Index(1), min((threads_number + columns_number - 1)/max(columns_number, Index(1)),
+                                                  rows_number/minimum_chunk_rows_number));
+
+    const Index tasks_number = columns_number*chunks_number;
+
+    Tensor<StatisticsAccumulator, 1> tasks_accumulators(tasks_number);
+
+    for(Index task = 0; task < tasks_number; task++) tasks_accumulators(task) = accumulator;
+
+    #pragma omp parallel for schedule(dynamic)
+
+    for(Index task = 0; task < tasks_number; task++)
+    {
+        const Index column = task/chunks_number;
+        const Index chunk = task%chunks_number;
+
+        const Index begin = rows_number*chunk/chunks_number;
+        const Index end = rows_number*(chunk + 1)/chunks_number;
+
+        const type* column_data = matrix.data() + columns_indices(column)*matrix.dimension(0);
+
+        StatisticsAccumulator& task_accumulator = tasks_accumulators(task);
+
+        for(Index i = begin; i < end; i++)
+        {
+            task_accumulator.add(column_data[rows_indices(i)]);
+        }
+    }
+
+    Tensor<StatisticsAccumulator, 1> columns_accumulators(columns_number);
+
+    #pragma omp parallel for schedule(dynamic)
+
+    for(Index column = 0; column < columns_number; column++)
+    {
+        columns_accumulators(column) = tasks_accumulators(column*chunks_number);
+
+        for(Index chunk = 1; chunk < chunks_number; chunk++)
+        {
+            columns_accumulators(column).merge(tasks_accumulators(column*chunks_number + chunk));
+        }
+    }
+
+    return columns_accumulators;
+}
+
+
+/// Returns the box plots of some columns of a matrix over some of its rows, in a single parallel pass.
+/// The quartiles are exact for up to a thousand rows, and estimated from a quantile sketch otherwise.
+/// @param matrix Column major matrix.
+/// @param rows_indices Indices of the rows.
+/// @param columns_indices Indices of the columns.
+
+Tensor<BoxPlot, 1> columns_box_plots(const Tensor<type, 2>& matrix,
+                                     const Tensor<Index, 1>& rows_indices,
+                                     const Tensor<Index, 1>& columns_indices)
+{
+    const Index columns_number = columns_indices.size();
+
+    Tensor<BoxPlot, 1> box_plots(columns_number);
+
+    if(rows_indices.size() == 0) return box_plots;
+
+    const Tensor<StatisticsAccumulator, 1> accumulators
+            = accumulate_statistics(matrix, rows_indices, columns_indices, StatisticsAccumulator(true));
+
+    for(Index i = 0; i < columns_number; i++)
+    {
+        box_plots(i) = accumulators(i).to_box_plot();
+    }
+
+    return box_plots;
+}
+
+
+/// Returns the histograms of some columns of a matrix over some of its rows.
+/// As with the histogram() method, a column with no more distinct values than bins has a bin for each value,
+/// and otherwise the range of the column is split into bins of the same length.
+/// The first parallel pass finds the distinct values and the ranges, and the second one counts the values of the bins.
+/// @param matrix Column major matrix.
+/// @param rows_indices Indices of the rows.
+/// @param columns_indices Indices of the columns.
+/// @param bins_number Number of bins.
+
+Tensor<Histogram, 1> columns_histograms(const Tensor<type, 2>& matrix,
+                                        const Tensor<Index, 1>& rows_indices,
+                                        const Tensor<Index, 1>& columns_indices,
+                                        const Index& bins_number)
+{
+    if(bins_number < 1)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: Statistics Class.\n"
+               << "Tensor<Histogram, 1> columns_histograms(const Tensor<type, 2>&, const Tensor<Index, 1>&, const Tensor<Index, 1>&, const Index&) method.\n"
+               << "Number of bins (" << bins_number << ") is less than one.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    const Index rows_number = rows_indices.size();
+    const Index columns_number = columns_indices.size();
+
+    const Tensor<StatisticsAccumulator, 1> accumulators
+            = accumulate_statistics(matrix, rows_indices, columns_indices, StatisticsAccumulator(false, bins_number));
+
+    Tensor<Histogram, 1> histograms(columns_number);
+
+    vector<Index> binned_columns;
+
+    for(Index i = 0; i < columns_number; i++)
+    {
+        if(accumulators(i).has_distinct_values())
+        {
+            histograms(i) = accumulators(i).to_distinct_values_histogram();
+
+            continue;
+        }
+
+        // Bins of the same length, as in the histogram() method
+
+        const type minimum = accumulators(i).get_minimum();
+        const type length = (accumulators(i).get_maximum() - minimum)/type(bins_number);
+
+        Tensor<type, 1> minimums(bins_number);
+        Tensor<type, 1> maximums(bins_number);
+        Tensor<type, 1> centers(bins_number);
+
+        minimums(0) = minimum;
+        maximums(0) = minimum + length;
+        centers(0) = (maximums(0) + minimums(0))/type(2);
+
+        for(Index j = 1; j < bins_number; j++)
+        {
+            minimums(j) = minimums(j - 1) + length;
+            maximums(j) = maximums(j - 1) + length;
+
+            centers(j) = (maximums(j) + minimums(j))/type(2);
+        }
+
+        Tensor<Index, 1> frequencies(bins_number);
+        frequencies.setZero();
+
+        histograms(i) = Histogram(frequencies, centers, minimums, maximums);
+
+        binned_columns.push_back(i);
+    }
+
+    const Index binned_columns_number = Index(binned_columns.size());
+
+    if(binned_columns_number == 0) return histograms;
+
+    const Index minimum_chunk_rows_number = 16384;
+
+    const Index threads_number = max(Index(1), Index(ExecutionContext::get_threads_number()));
+
+    const Index chunks_number = max(Index(1), min((threads_number + binned_columns_number - 1)/binned_columns_number,
+                                                  rows_number/minimum_chunk_rows_number));
+
+    const Index tasks_number = binned_columns_number*chunks_number;
+
+    Tensor<Index, 2> tasks_frequencies(bins_number, tasks_number);
+    tasks_frequencies.setZero();
+
+    #pragma omp parallel for schedule(dynamic)
+
+    for(Index task = 0; task < tasks_number; task++)
+    {
+        const Index column = binned_columns[size_t(task/chunks_number)];
+        const Index chunk = task%chunks_number;
+
+        const Index begin = rows_number*chunk/chunks_number;
+        const Index end = rows_number*(chunk + 1)/chunks_number;
+
+        const type* column_data = matrix.data() + columns_indices(column)*matrix.dimension(0);
+
+        const Tensor<type, 1>& minimums = histograms(column).minimums;
+        const Tensor<type, 1>& maximums = histograms(column).maximums;
+
+        const type minimum = minimums(0);
+        const type length = maximums(0) - minimums(0);
+
+        Index* task_frequencies = tasks_frequencies.data() + task*bins_number;
+
+        for(Index i = begin; i < end; i++)
+        {
+            const type value = column_data[rows_indices(i)];
+
+            if(isnan(value)) continue;
+
+            if(value >= minimums(bins_number - 1))
+            {
+                task_frequencies[bins_number - 1]++;
+
+                continue;
+            }
+
+            Index bin = length > type(0) ? Index((value - minimum)/length) : 0;
+
+            bin = min(max(bin, Index(0)), bins_number - 1);
+
+            while(bin > 0 && value < minimums(bin)) bin--;
+            while(bin < bins_number - 1 && value >= maximums(bin)) bin++;
+
+            task_frequencies[bin]++;
+        }
+    }
+
+    for(Index i = 0; i < binned_columns_number; i++)
+    {
+        Tensor<Index, 1>& frequencies = histograms(binned_columns[size_t(i)]).frequencies;
+
+        for(Index chunk = 0; chunk < chunks_number; chunk++)
+        {
+            for(Index j = 0; j < bins_number; j++)
+            {
+                frequencies(j) += tasks_frequencies(j, i*chunks_number + chunk);
+            }
+        }
+    }
+
+    return histograms;
+}
+
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
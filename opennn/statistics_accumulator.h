@@ -0,0 +1,230 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   S T A T I S T I C S   A C C U M U L A T O R   C L A S S   H E A D E R
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#ifndef STATISTICSACCUMULATOR_H
+#define STATISTICSACCUMULATOR_H
+
+// System includes
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// OpenNN includes
+
+#include "config.h"
+#include "execution_context.h"
+#include "statistics.h"
+
+namespace opennn
+{
+
+/// This class summarizes a stream of values to answer quantile queries with a bounded memory.
+
+/// The sketch is a stack of compactors, in the manner of the KLL sketch.
+/// The values are added to the first compactor, whose values weigh one.
+/// When a compactor is full, its values are sorted and every other one is promoted to the next compactor,
+/// where it weighs twice as much, so the memory grows with the logarithm of the number of values.
+/// The promoted half alternates between the even and odd positions, so the sketch is deterministic.
+/// Two sketches are merged by joining their compactors, so the values can be summarized in parallel.
+///
+/// Until the first compactor fills up, the sketch holds all the values and its quantiles are exact.
+
+class QuantileSketch
+{
+
+public:
+
+    // Constructors
+
+    explicit QuantileSketch(const Index& = 1024);
+
+    // Destructor
+
+    virtual ~QuantileSketch();
+
+    // Get methods
+
+    const Index& get_capacity() const;
+
+    const Index& get_values_number() const;
+
+    bool is_exact() const;
+
+    // Set methods
+
+    void set(const Index&);
+
+    // Summary methods
+
+    void add(const type&);
+
+    void merge(const QuantileSketch&);
+
+    Tensor<type, 1> get_sorted_values() const;
+
+    type calculate_quantile(const type&) const;
+
+private:
+
+    void compact(const size_t&);
+
+    /// Maximum number of values of each compactor.
+
+    Index capacity = 1024;
+
+    /// Number of values added to the sketch.
+
+    Index values_number = 0;
+
+    /// Values of each compactor. The values of compactor h weigh 2^h.
+
+    vector<vector<type>> compactors;
+
+    /// Half promoted by the next compaction of each compactor.
+
+    vector<bool> compactors_parities;
+};
+
+
+/// This class accumulates the statistics of a stream of values in a single pass.
+
+/// It counts the missing values, keeps the minimum and the maximum,
+/// and updates the mean and the sum of squared deviations with Welford's algorithm.
+/// Optionally, it keeps the distinct values up to a maximum number, with their frequencies,
+/// and a quantile sketch for the quartiles.
+/// Two accumulators of the same kind are merged with Chan's formulas,
+/// so that the rows of a column can be accumulated by several threads.
+
+class StatisticsAccumulator
+{
+
+public:
+
+    // Constructors
+
+    explicit StatisticsAccumulator(const bool& = false, const Index& = 0);
+
+    // Destructor
+
+    virtual ~StatisticsAccumulator();
+
+    // Get methods
+
+    const Index& get_count() const;
+
+    const Index& get_missing_values_number() const;
+
+    type get_minimum() const;
+
+    type get_maximum() const;
+
+    type get_mean() const;
+
+    type get_standard_deviation() const;
+
+    bool has_distinct_values() const;
+
+    Index get_distinct_values_number() const;
+
+    const QuantileSketch& get_quantile_sketch() const;
+
+    // Accumulation methods
+
+    void add(const type&);
+
+    void merge(const StatisticsAccumulator&);
+
+    // Results methods
+
+    Descriptives to_descriptives() const;
+
+    Tensor<type, 1> calculate_quartiles() const;
+
+    BoxPlot to_box_plot() const;
+
+    Histogram to_distinct_values_histogram() const;
+
+private:
+
+    /// Number of values which are not missing.
+
+    Index count = 0;
+
+    /// Number of missing values.
+
+    Index missing_values_number = 0;
+
+    type minimum = numeric_limits<type>::max();
+
+    type maximum = numeric_limits<type>::lowest();
+
+    double mean = 0;
+
+    /// Sum of the squared deviations from the mean.
+
+    double squared_deviations_sum = 0;
+
+    /// True if the quantile sketch is updated.
+
+    bool has_quantiles = false;
+
+    QuantileSketch quantile_sketch;
+
+    /// Maximum number of distinct values kept, or 0 if they are not kept.
+
+    Index maximum_distinct_values_number = 0;
+
+    /// True if there are more distinct values than the maximum, which are not kept anymore.
+
+    bool has_too_many_distinct_values = false;
+
+    /// Distinct values and their frequencies.
+
+    vector<pair<type, Index>> distinct_values;
+};
+
+
+// Accumulation methods
+
+Tensor<StatisticsAccumulator, 1> accumulate_statistics(const Tensor<type, 2>&,
+                                                       const Tensor<Index, 1>&,
+                                                       const Tensor<Index, 1>&,
+                                                       const StatisticsAccumulator& = StatisticsAccumulator());
+
+Tensor<BoxPlot, 1> columns_box_plots(const Tensor<type, 2>&, const Tensor<Index, 1>&, const Tensor<Index, 1>&);
+
+Tensor<Histogram, 1> columns_histograms(const Tensor<type, 2>&, const Tensor<Index, 1>&, const Tensor<Index, 1>&, const Index& = 10);
+
+}
+
+#endif
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -66,6 +66,14 @@ const bool& StochasticGradientDescent::get_nesterov() const
 }
 
 
+/// Returns the precision in which the momentum increments are stored.
+
+const StoragePrecision& StochasticGradientDescent::get_moments_precision() const
+{
+    return moments_precision;
+}
+
+
 /// Returns the goal value for the loss.
 /// This is used as a stopping criterion when training a neural network
 
@@ -101,6 +109,7 @@ void StochasticGradientDescent::set_default()
     initial_decay = type(0);
     momentum = type(0);
     nesterov = false;
+    moments_precision = StoragePrecision::Single;
 
     // Stopping criteria
 
@@ -120,6 +129,35 @@ Index StochasticGradientDescent::get_batch_samples_number() const
 }
 
 
+/// Returns the number of batches filled in the background while the current batch is trained.
+
+const Index& StochasticGradientDescent::get_prefetched_batches_number() const
+{
+    return prefetched_batches_number;
+}
+
+
+/// Sets the number of batches filled in the background while the current batch is trained. Default 2.
+/// With 0, each batch is filled after the previous one has been trained.
+/// @param new_prefetched_batches_number Number of prefetched batches.
+
+void StochasticGradientDescent::set_prefetched_batches_number(const Index& new_prefetched_batches_number)
+{
+    if(new_prefetched_batches_number < 0)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: StochasticGradientDescent class.\n"
+               << "void set_prefetched_batches_number(const Index&) method.\n"
+               << "Prefetched batches number (" << new_prefetched_batches_number << ") must be equal or greater than 0.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    prefetched_batches_number = new_prefetched_batches_number;
+}
+
+
 /// Set the initial value for the learning rate. If dacay is not active learning rate will be constant
 /// otherwise learning rate will decay over each update.
 /// @param new_initial_learning_rate initial learning rate value.
@@ -209,6 +247,27 @@ void StochasticGradientDescent::set_nesterov(const bool& new_nesterov_momentum)
 }
 
 
+/// Sets the precision in which the momentum increments are stored.
+/// BFloat16 halves the memory and the bandwidth of the increments, which are updated in single precision.
+/// @param new_moments_precision Single or BFloat16.
+
+void StochasticGradientDescent::set_moments_precision(const StoragePrecision& new_moments_precision)
+{
+    if(new_moments_precision == StoragePrecision::Half)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: StochasticGradientDescent class.\n"
+               << "void set_moments_precision(const StoragePrecision&) method.\n"
+               << "Moments cannot be stored in half precision.\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    moments_precision = new_moments_precision;
+}
+
+
 /// Set the a new maximum for the epochs number.
 /// @param new_maximum_epochs number New maximum epochs number.
 
@@ -274,33 +333,37 @@ void StochasticGradientDescent::set_maximum_time(const type& new_maximum_time)
 void StochasticGradientDescent::update_parameters(LossIndexBackPropagation& back_propagation,
                       StochasticGradientDescentData& optimization_data) const
 {
-    const type learning_rate = initial_learning_rate/(type(1) + type(optimization_data.iteration)*initial_decay);
+    MomentumStep step;
 
-    optimization_data.parameters_increment.device(*thread_pool_device) = back_propagation.gradient*(-learning_rate);
+    step.learning_rate = initial_learning_rate/(type(1) + type(optimization_data.iteration)*initial_decay);
+    step.momentum = momentum;
+    step.nesterov = nesterov;
 
-    if(momentum > type(0))
-    {
-        optimization_data.parameters_increment.device(*thread_pool_device) += momentum*optimization_data.last_parameters_increment;
+    const Index parameters_number = back_propagation.parameters.size();
 
-        if(!nesterov)
-        {
-            back_propagation.parameters.device(*thread_pool_device) += optimization_data.parameters_increment;
-        }
-        else
-        {
-            back_propagation.parameters.device(*thread_pool_device) += optimization_data.parameters_increment*momentum - back_propagation.gradient*learning_rate;;
-        }
+    if(moments_precision == StoragePrecision::BFloat16)
+    {
+        update_parameters_momentum(thread_pool_device,
+                                   step,
+                                   parameters_number,
+                                   back_propagation.gradient.data(),
+                                   back_propagation.parameters.data(),
+                                   optimization_data.bfloat16_last_parameters_increment.data());
     }
     else
     {
-        back_propagation.parameters.device(*thread_pool_device) += optimization_data.parameters_increment;
+        update_parameters_momentum(thread_pool_device,
+                                   step,
+                                   parameters_number,
+                                   back_propagation.gradient.data(),
+                                   back_propagation.parameters.data(),
+                                   optimization_data.last_parameters_increment.data());
     }
 
-    optimization_data.last_parameters_increment = optimization_data.parameters_increment;
-
     optimization_data.iteration++;
 
     // Update parameters
+    // The parameters were updated in place in the parameters arena, so this only copies if the neural network has none
 
     back_propagation.loss_index_pointer->get_neural_network_pointer()->set_parameters(back_propagation.parameters);
 }
@@ -330,22 +393,35 @@ TrainingResults StochasticGradientDescent::perform_training()
     const Tensor<Index, 1> input_variables_indices = data_set_pointer->get_input_variables_indices();
     const Tensor<Index, 1> target_variables_indices = data_set_pointer->get_target_variables_indices();
 
-    const Tensor<Index, 1> training_samples_indices = data_set_pointer->get_training_samples_indices();
-    const Tensor<Index, 1> selection_samples_indices = data_set_pointer->get_selection_samples_indices();
+    // In data parallel training each process trains on its own shard of the samples
+
+    const Tensor<Index, 1> training_samples_indices = communicator_pointer
+            ? communicator_pointer->get_shard(data_set_pointer->get_training_samples_indices())
+            : data_set_pointer->get_training_samples_indices();
+
+    const Tensor<Index, 1> selection_samples_indices = communicator_pointer
+            ? communicator_pointer->get_shard(data_set_pointer->get_selection_samples_indices())
+            : data_set_pointer->get_selection_samples_indices();
 
     Index batch_samples_number_training = 0;
     Index batch_samples_number_selection = 0;
 
-    const Index training_samples_number = data_set_pointer->get_training_samples_number();
-    const Index selection_samples_number = data_set_pointer->get_selection_samples_number();
+    const Index training_samples_number = training_samples_indices.size();
+    const Index selection_samples_number = selection_samples_indices.size();
 
-    training_samples_number < batch_samples_number
+    // The batches of all the processes together have the batch samples number
+
+    const Index ranks_number = communicator_pointer ? communicator_pointer->get_ranks_number() : 1;
+
+    const Index rank_batch_samples_number = max(Index(1), batch_samples_number/ranks_number);
+
+    training_samples_number < rank_batch_samples_number
             ? batch_samples_number_training = training_samples_number
-            : batch_samples_number_training = batch_samples_number;
+            : batch_samples_number_training = rank_batch_samples_number;
 
-    selection_samples_number < batch_samples_number && selection_samples_number != 0
+    selection_samples_number < rank_batch_samples_number && selection_samples_number != 0
             ? batch_samples_number_selection = selection_samples_number
-            : batch_samples_number_selection = batch_samples_number;
+            : batch_samples_number_selection = rank_batch_samples_number;
 
     const Tensor<string, 1> inputs_names = data_set_pointer->get_input_variables_names();
     const Tensor<string, 1> targets_names = data_set_pointer->get_target_variables_names();
@@ -356,14 +432,8 @@ TrainingResults StochasticGradientDescent::perform_training()
     const Tensor<Descriptives, 1> input_variables_descriptives = data_set_pointer->scale_input_variables();
     Tensor<Descriptives, 1> target_variables_descriptives;
 
-    DataSetBatch batch_training(batch_samples_number_training, data_set_pointer);
-    DataSetBatch batch_selection(batch_samples_number_selection, data_set_pointer);
-
-    const Index training_batches_number = training_samples_number/batch_samples_number_training;
-    const Index selection_batches_number = selection_samples_number/batch_samples_number_selection;
-
-    Tensor<Index, 2> training_batches(training_batches_number, batch_samples_number_training);
-    Tensor<Index, 2> selection_batches(selection_batches_number, batch_samples_number_selection);
+    BatchLoader training_batch_loader(data_set_pointer, batch_samples_number_training, prefetched_batches_number + 1);
+    BatchLoader selection_batch_loader(data_set_pointer, batch_samples_number_selection, prefetched_batches_number + 1);
 
     // Neural network
 
@@ -372,6 +442,8 @@ TrainingResults StochasticGradientDescent::perform_training()
     neural_network_pointer->set_inputs_names(inputs_names);
     neural_network_pointer->set_outputs_names(targets_names);
 
+    neural_network_pointer->set_inputs_categories_numbers(data_set_pointer->get_input_categories_numbers());
+
     if(neural_network_pointer->has_scaling_layer())
     {
         ScalingLayer* scaling_layer_pointer = neural_network_pointer->get_scaling_layer_pointer();
@@ -386,6 +458,8 @@ TrainingResults StochasticGradientDescent::perform_training()
         unscaling_layer_pointer->set(target_variables_descriptives, target_variables_scalers);
     }
 
+    data_set_pointer->update_training_cache();
+
     NeuralNetworkForwardPropagation training_forward_propagation(batch_samples_number_training, neural_network_pointer);
     NeuralNetworkForwardPropagation selection_forward_propagation(batch_samples_number_selection, neural_network_pointer);
 
@@ -393,6 +467,17 @@ TrainingResults StochasticGradientDescent::perform_training()
 
     loss_index_pointer->set_normalization_coefficient();
 
+    // All the processes start from the parameters of the first one
+
+    if(communicator_pointer)
+    {
+        Tensor<type, 1> parameters = neural_network_pointer->get_parameters();
+
+        communicator_pointer->broadcast(parameters);
+
+        neural_network_pointer->set_parameters(parameters);
+    }
+
     LossIndexBackPropagation training_back_propagation(batch_samples_number_training, loss_index_pointer);
     LossIndexBackPropagation selection_back_propagation(batch_samples_number_selection, loss_index_pointer);
 
@@ -427,9 +512,14 @@ TrainingResults StochasticGradientDescent::perform_training()
     {
         if(display && epoch%display_period == 0) cout << "Epoch: " << epoch << endl;
 
-        training_batches = data_set_pointer->get_batches(training_samples_indices, batch_samples_number_training, shuffle);
+        training_batch_loader.start(training_samples_indices, input_variables_indices, target_variables_indices, shuffle);
+
+        const Index batches_number = training_batch_loader.get_batches_number();
+
+        // Selection batches are filled while the training batches are trained
 
-        const Index batches_number = training_batches.dimension(0);
+        if(has_selection)
+            selection_batch_loader.start(selection_samples_indices, input_variables_indices, target_variables_indices, shuffle);
 
         training_loss = type(0);
         training_error = type(0);
@@ -442,7 +532,7 @@ TrainingResults StochasticGradientDescent::perform_training()
 
             // Data set
 
-            batch_training.fill(training_batches.chip(iteration, 0), input_variables_indices, target_variables_indices);
+            const DataSetBatch& batch_training = training_batch_loader.next_batch();
 
             // Neural network
 
@@ -453,6 +543,13 @@ TrainingResults StochasticGradientDescent::perform_training()
             loss_index_pointer->back_propagate(batch_training, training_forward_propagation, training_back_propagation);
             results.training_error_history(epoch) = training_back_propagation.error;
 
+            if(communicator_pointer)
+            {
+                communicator_pointer->all_reduce_mean(training_back_propagation.gradient);
+
+                training_back_propagation.set_gradient_modified();
+            }
+
             training_error += training_back_propagation.error;
             training_loss += training_back_propagation.loss;
 
@@ -470,7 +567,7 @@ TrainingResults StochasticGradientDescent::perform_training()
 
         if(has_selection)
         {
-            selection_batches = data_set_pointer->get_batches(selection_samples_indices, batch_samples_number_selection, shuffle);
+            const Index selection_batches_number = selection_batch_loader.get_batches_number();
 
             selection_error = type(0);
 
@@ -478,7 +575,7 @@ TrainingResults StochasticGradientDescent::perform_training()
             {
                 // Data set
 
-                batch_selection.fill(selection_batches.chip(iteration,0), input_variables_indices, target_variables_indices);
+                const DataSetBatch& batch_selection = selection_batch_loader.next_batch();
 
                 // Neural network
 
@@ -497,7 +594,7 @@ TrainingResults StochasticGradientDescent::perform_training()
 
             results.selection_error_history(epoch) = selection_error;
 
-            if(epoch != 0 && results.selection_error_history(epoch) > results.selection_error_history(epoch-1)) selection_failures++;
+            if(!communicator_pointer && epoch != 0 && results.selection_error_history(epoch) > results.selection_error_history(epoch-1)) selection_failures++;
         }
 
         // Elapsed time
@@ -505,6 +602,31 @@ TrainingResults StochasticGradientDescent::perform_training()
         time(&current_time);
         elapsed_time = static_cast<type>(difftime(current_time, beginning_time));
 
+        // The processes take the same stopping decisions from the means of their errors and times
+
+        if(communicator_pointer)
+        {
+            Tensor<type, 1> epoch_values(4);
+
+            epoch_values.setValues({training_error, training_loss, selection_error, elapsed_time});
+
+            communicator_pointer->all_reduce_mean(epoch_values);
+
+            training_error = epoch_values(0);
+            training_loss = epoch_values(1);
+            selection_error = epoch_values(2);
+            elapsed_time = epoch_values(3);
+
+            results.training_error_history(epoch) = training_error;
+
+            if(has_selection)
+            {
+                results.selection_error_history(epoch) = selection_error;
+
+                if(epoch != 0 && selection_error > results.selection_error_history(epoch-1)) selection_failures++;
+            }
+        }
+
         if(display && epoch%display_period == 0)
         {
             cout << "Training error: " << training_error << endl;
@@ -563,12 +685,16 @@ TrainingResults StochasticGradientDescent::perform_training()
 
             results.elapsed_time = write_time(elapsed_time);
 
+            results.data_waiting_time = training_batch_loader.get_waiting_time() + selection_batch_loader.get_waiting_time();
+
             break;
         }
 
         // Update stuff
 
-        if(epoch != 0 && epoch%save_period == 0) neural_network_pointer->save(neural_network_file_name);
+        const bool is_first_rank = !communicator_pointer || communicator_pointer->get_rank() == 0;
+
+        if(is_first_rank && epoch != 0 && epoch%save_period == 0) neural_network_pointer->save(neural_network_file_name);
     }
 
     if(neural_network_pointer->get_project_type() == NeuralNetwork::ProjectType::AutoAssociation)
@@ -680,6 +806,17 @@ void StochasticGradientDescent::write_XML(tinyxml2::XMLPrinter& file_stream) con
 
     file_stream.CloseElement();
 
+    // Prefetched batches number
+
+    file_stream.OpenElement("PrefetchedBatchesNumber");
+
+    buffer.str("");
+    buffer << prefetched_batches_number;
+
+    file_stream.PushText(buffer.str().c_str());
+
+    file_stream.CloseElement();
+
     // Apply momentum
 
     file_stream.OpenElement("ApplyMomentum");
@@ -724,6 +861,14 @@ void StochasticGradientDescent::write_XML(tinyxml2::XMLPrinter& file_stream) con
 
     file_stream.CloseElement();
 
+    // Moments precision
+
+    file_stream.OpenElement("MomentsPrecision");
+
+    file_stream.PushText(write_storage_precision(moments_precision).c_str());
+
+    file_stream.CloseElement();
+
     // Hardware use
 
     file_stream.OpenElement("HardwareUse");
@@ -774,6 +919,24 @@ void StochasticGradientDescent::from_XML(const tinyxml2::XMLDocument& document)
         }
     }
 
+    // Prefetched batches number
+
+    const tinyxml2::XMLElement* prefetched_batches_number_element = root_element->FirstChildElement("PrefetchedBatchesNumber");
+
+    if(prefetched_batches_number_element)
+    {
+        const Index new_prefetched_batches_number = static_cast<Index>(atoi(prefetched_batches_number_element->GetText()));
+
+        try
+        {
+            set_prefetched_batches_number(new_prefetched_batches_number);
+        }
+        catch(const invalid_argument& e)
+        {
+            cerr << e.what() << endl;
+        }
+    }
+
     // Momentum
 
     const tinyxml2::XMLElement* apply_momentum_element = root_element->FirstChildElement("ApplyMomentum");
@@ -856,6 +1019,23 @@ void StochasticGradientDescent::from_XML(const tinyxml2::XMLDocument& document)
         }
     }
 
+    // Moments precision
+    {
+        const tinyxml2::XMLElement* element = root_element->FirstChildElement("MomentsPrecision");
+
+        if(element)
+        {
+            try
+            {
+                set_moments_precision(read_storage_precision(element->GetText()));
+            }
+            catch(const invalid_argument& e)
+            {
+                cerr << e.what() << endl;
+            }
+        }
+    }
+
     // Hardware use
     {
         const tinyxml2::XMLElement* element = root_element->FirstChildElement("HardwareUse");
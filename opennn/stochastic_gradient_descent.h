@@ -27,6 +27,9 @@
 
 #include "loss_index.h"
 #include "optimization_algorithm.h"
+#include "batch_loader.h"
+#include "storage_precision.h"
+#include "optimizer_kernels.h"
 
 namespace opennn
 {
@@ -57,6 +60,7 @@ public:
    const type& get_initial_decay() const;
    const type& get_momentum() const;
    const bool& get_nesterov() const;
+   const StoragePrecision& get_moments_precision() const;
 
    // Stopping criteria
 
@@ -74,16 +78,21 @@ public:
        batch_samples_number = new_batch_samples_number;
    }
 
+   void set_prefetched_batches_number(const Index&);
+
    // Get methods
 
    Index get_batch_samples_number() const;
 
+   const Index& get_prefetched_batches_number() const;
+
    //Training operators
 
    void set_initial_learning_rate(const type&);
    void set_initial_decay(const type&);
    void set_momentum(const type&);
    void set_nesterov(const bool&);
+   void set_moments_precision(const StoragePrecision&);
 
    void set_maximum_epochs_number(const Index&);
 
@@ -128,10 +137,18 @@ private:
 
    bool nesterov;
 
+   /// Precision in which the momentum increments are stored.
+
+   StoragePrecision moments_precision = StoragePrecision::Single;
+
    /// Number of samples per training batch.
 
    Index batch_samples_number = 1000;
 
+   /// Number of batches filled in the background while the current batch is trained.
+
+   Index prefetched_batches_number = 2;
+
    // Stopping criteria
 
    /// Goal value for the loss. It is a stopping criterion.
@@ -182,19 +199,25 @@ struct StochasticGradientDescentData : public OptimizationAlgorithmData
 
         const Index parameters_number = neural_network_pointer->get_parameters_number();
 
-        parameters_increment.resize(parameters_number);
-        last_parameters_increment.resize(parameters_number);
+        // The increments are only allocated in the precision in which they are stored
+
+        const Index single_parameters_number
+                = stochastic_gradient_descent_pointer->get_moments_precision() == StoragePrecision::BFloat16 ? 0 : parameters_number;
 
-        parameters_increment.setZero();
+        last_parameters_increment.resize(single_parameters_number);
         last_parameters_increment.setZero();
+
+        bfloat16_last_parameters_increment.resize(parameters_number - single_parameters_number);
+        bfloat16_last_parameters_increment.setZero();
     }
 
     StochasticGradientDescent* stochastic_gradient_descent_pointer = nullptr;
 
     Index iteration = 0;
 
-    Tensor<type, 1> parameters_increment;
     Tensor<type, 1> last_parameters_increment;
+
+    Tensor<Eigen::bfloat16, 1> bfloat16_last_parameters_increment;
 };
 
 }
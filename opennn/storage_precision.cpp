@@ -0,0 +1,160 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   S T O R A G E   P R E C I S I O N
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "storage_precision.h"
+
+namespace opennn
+{
+
+/// Returns the name of a storage precision: "Single", "Half" or "BFloat16".
+/// @param storage_precision Storage precision.
+
+string write_storage_precision(const StoragePrecision& storage_precision)
+{
+    switch(storage_precision)
+    {
+    case StoragePrecision::Single: return "Single";
+
+    case StoragePrecision::Half: return "Half";
+
+    case StoragePrecision::BFloat16: return "BFloat16";
+    }
+
+    return string();
+}
+
+
+/// Returns the storage precision with a given name.
+/// @param storage_precision_name Name of the storage precision: "Single", "Half" or "BFloat16".
+
+StoragePrecision read_storage_precision(const string& storage_precision_name)
+{
+    if(storage_precision_name == "Single")
+    {
+        return StoragePrecision::Single;
+    }
+    else if(storage_precision_name == "Half")
+    {
+        return StoragePrecision::Half;
+    }
+    else if(storage_precision_name == "BFloat16")
+    {
+        return StoragePrecision::BFloat16;
+    }
+    else
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: StoragePrecision.\n"
+               << "StoragePrecision read_storage_precision(const string&) method.\n"
+               << "Unknown storage precision: " << storage_precision_name << ".\n";
+
+        throw invalid_argument(buffer.str());
+    }
+}
+
+
+/// Returns the number of bytes of a value stored with a given precision.
+/// @param storage_precision Storage precision.
+
+Index get_storage_precision_size(const StoragePrecision& storage_precision)
+{
+    switch(storage_precision)
+    {
+    case StoragePrecision::Single: return Index(sizeof(type));
+
+    case StoragePrecision::Half: return Index(sizeof(Eigen::half));
+
+    case StoragePrecision::BFloat16: return Index(sizeof(Eigen::bfloat16));
+    }
+
+    return Index(sizeof(type));
+}
+
+
+/// Converts half precision values to single precision.
+/// The conversion is an Eigen expression, which is vectorized where the instruction set converts packets of half values.
+/// @param values Pointer to the half precision values.
+/// @param values_number Number of values.
+/// @param single_values Pointer to the single precision values.
+
+void convert_to_single(const Eigen::half* values, const Index& values_number, type* single_values)
+{
+    const TensorMap<const Tensor<Eigen::half, 1>> values_map(values, values_number);
+
+    TensorMap<Tensor<type, 1>> single_values_map(single_values, values_number);
+
+    single_values_map = values_map.cast<type>();
+}
+
+
+/// Converts bfloat16 precision values to single precision.
+/// The bfloat16 values are the upper halves of the single precision values, so the conversion is a shift.
+/// @param values Pointer to the bfloat16 precision values.
+/// @param values_number Number of values.
+/// @param single_values Pointer to the single precision values.
+
+void convert_to_single(const Eigen::bfloat16* values, const Index& values_number, type* single_values)
+{
+    const TensorMap<const Tensor<Eigen::bfloat16, 1>> values_map(values, values_number);
+
+    TensorMap<Tensor<type, 1>> single_values_map(single_values, values_number);
+
+    single_values_map = values_map.cast<type>();
+}
+
+
+/// Rounds single precision values to the nearest half precision values.
+/// The values out of the range of half precision become infinite.
+/// @param single_values Pointer to the single precision values.
+/// @param values_number Number of values.
+/// @param values Pointer to the half precision values.
+
+void convert_from_single(const type* single_values, const Index& values_number, Eigen::half* values)
+{
+    const TensorMap<const Tensor<type, 1>> single_values_map(single_values, values_number);
+
+    TensorMap<Tensor<Eigen::half, 1>> values_map(values, values_number);
+
+    values_map = single_values_map.cast<Eigen::half>();
+}
+
+
+/// Rounds single precision values to the nearest bfloat16 precision values.
+/// @param single_values Pointer to the single precision values.
+/// @param values_number Number of values.
+/// @param values Pointer to the bfloat16 precision values.
+
+void convert_from_single(const type* single_values, const Index& values_number, Eigen::bfloat16* values)
+{
+    const TensorMap<const Tensor<type, 1>> single_values_map(single_values, values_number);
+
+    TensorMap<Tensor<Eigen::bfloat16, 1>> values_map(values, values_number);
+
+    values_map = single_values_map.cast<Eigen::bfloat16>();
+}
+
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -0,0 +1,72 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   S T O R A G E   P R E C I S I O N   H E A D E R
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#ifndef STORAGEPRECISION_H
+#define STORAGEPRECISION_H
+
+// System includes
+
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <stdexcept>
+
+// OpenNN includes
+
+#include "config.h"
+
+namespace opennn
+{
+
+/// Enumeration of the precisions in which large tensors can be stored.
+
+/// Single precision stores the values as type.
+/// Half precision stores them in 16 bits, with 10 bits of mantissa and a range up to 65504.
+/// BFloat16 precision stores them in 16 bits, with 7 bits of mantissa and the range of single precision.
+/// The reduced precisions halve the memory of the values, which are converted to type before any arithmetic,
+/// so that the sums are always accumulated in single precision.
+
+enum class StoragePrecision{Single, Half, BFloat16};
+
+string write_storage_precision(const StoragePrecision&);
+
+StoragePrecision read_storage_precision(const string&);
+
+Index get_storage_precision_size(const StoragePrecision&);
+
+// Conversion methods
+
+void convert_to_single(const Eigen::half*, const Index&, type*);
+
+void convert_to_single(const Eigen::bfloat16*, const Index&, type*);
+
+void convert_from_single(const type*, const Index&, Eigen::half*);
+
+void convert_from_single(const type*, const Index&, Eigen::bfloat16*);
+
+}
+
+#endif
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -87,9 +87,7 @@ void SumSquaredError::calculate_output_delta(const DataSetBatch&,
 
      deltas.device(*thread_pool_device) = coefficient*back_propagation.errors;
 
-     Tensor<type, 2> output_deltas(deltas);
-
-     if(has_NAN(output_deltas))
+     if(has_NAN(deltas.data(), deltas.size()))
      {
          ostringstream buffer;
 
@@ -68,7 +68,7 @@ void divide_columns(ThreadPoolDevice* thread_pool_device, Tensor<type, 2>& matri
     {
         TensorMap<Tensor<type,1>> column(matrix.data() + j*rows_number, rows_number);
 
-        column.device(*thread_pool_device) = column/vector(j);
+        column.device(*thread_pool_device) = column/vector;
     }
 }
 
@@ -834,6 +834,24 @@ void l1_norm_hessian(const ThreadPoolDevice*, const Tensor<type, 1>&, Tensor<typ
 }
 
 
+/// Returns the l1 norm of a view of a vector.
+
+type l1_norm(const ThreadPoolDevice* thread_pool_device, const TensorMap<Tensor<type, 1>>& vector)
+{
+    Tensor<type, 0> norm;
+
+    norm.device(*thread_pool_device) = vector.abs().sum();
+
+    return norm(0);
+}
+
+
+void l1_norm_gradient(const ThreadPoolDevice* thread_pool_device, const TensorMap<Tensor<type, 1>>& vector, Tensor<type, 1>& gradient)
+{
+    gradient.device(*thread_pool_device) = vector.sign();
+}
+
+
 /// Returns the l2 norm of a vector.
 
 type l2_norm(const ThreadPoolDevice* thread_pool_device, const Tensor<type, 1>& vector)
@@ -871,6 +889,43 @@ void l2_norm_gradient(const ThreadPoolDevice* thread_pool_device, const Tensor<t
 }
 
 
+/// Returns the l2 norm of a view of a vector.
+
+type l2_norm(const ThreadPoolDevice* thread_pool_device, const TensorMap<Tensor<type, 1>>& vector)
+{
+    Tensor<type, 0> norm;
+
+    norm.device(*thread_pool_device) = vector.square().sum().sqrt();
+
+    if(isnan(norm(0)))
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: l2 norm of vector is not a number."
+               << endl;
+
+        throw invalid_argument(buffer.str());
+    }
+
+    return norm(0);
+}
+
+
+void l2_norm_gradient(const ThreadPoolDevice* thread_pool_device, const TensorMap<Tensor<type, 1>>& vector, Tensor<type, 1>& gradient)
+{
+    const type norm = l2_norm(thread_pool_device, vector);
+
+    if(norm < type(NUMERIC_LIMITS_MIN))
+    {
+        gradient.setZero();
+
+        return;
+    }
+
+    gradient.device(*thread_pool_device) = vector/norm;
+}
+
+
 void l2_norm_hessian(const ThreadPoolDevice* thread_pool_device, Tensor<type, 1>& vector, Tensor<type, 2>& hessian)
 {
     const type norm = l2_norm(thread_pool_device, vector);
@@ -1065,6 +1120,20 @@ bool has_NAN(Tensor<type, 2>& x)
     return false;
 }
 
+
+/// Returns true if any of the size values starting at data is NAN.
+/// It allows checking tensor maps without copying them into a tensor.
+
+bool has_NAN(const type* data, const Index& size)
+{
+    for(Index i = 0; i < size; i++)
+    {
+        if(isnan(data[i])) return true;
+    }
+
+    return false;
+}
+
 Index count_empty_values(const Tensor<string, 1>& vector)
 {
     const Index words_number = vector.size();
@@ -103,10 +103,16 @@ type l1_norm(const ThreadPoolDevice*, const Tensor<type, 1>&);
 void l1_norm_gradient(const ThreadPoolDevice*, const Tensor<type, 1>&, Tensor<type, 1>&);
 void l1_norm_hessian(const ThreadPoolDevice*, const Tensor<type, 1>&, Tensor<type, 2>&);
 
+type l1_norm(const ThreadPoolDevice*, const TensorMap<Tensor<type, 1>>&);
+void l1_norm_gradient(const ThreadPoolDevice*, const TensorMap<Tensor<type, 1>>&, Tensor<type, 1>&);
+
 type l2_norm(const ThreadPoolDevice*, const Tensor<type, 1>&);
 void l2_norm_gradient(const ThreadPoolDevice*, const Tensor<type, 1>&, Tensor<type, 1>&);
 void l2_norm_hessian(const ThreadPoolDevice*, Tensor<type, 1>&, Tensor<type, 2>&);
 
+type l2_norm(const ThreadPoolDevice*, const TensorMap<Tensor<type, 1>>&);
+void l2_norm_gradient(const ThreadPoolDevice*, const TensorMap<Tensor<type, 1>>&, Tensor<type, 1>&);
+
 type l2_distance(const type&, const TensorMap<Tensor<type, 0> > &);
 type l2_distance(const Tensor<type, 1>&, const Tensor<type, 1>&);
 type l2_distance(const type&, const type&);
@@ -125,6 +131,7 @@ Index count_NAN(const Tensor<type, 2>&);
 
 bool has_NAN(const Tensor<type, 1>&);
 bool has_NAN(Tensor<type, 2>&);
+bool has_NAN(const type*, const Index&);
 
 Index count_empty_values(const Tensor<string, 1>&);
 
@@ -336,7 +336,8 @@ public:
 
 private: 
 
-   ThreadPool* thread_pool = nullptr;
+   /// Thread pool device shared by all the objects, owned by the execution context.
+
    ThreadPoolDevice* thread_pool_device = nullptr;
 
    /// Pointer to the neural network object to be tested. 
@@ -0,0 +1,538 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   T R A I N I N G   C A C H E   C L A S S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "training_cache.h"
+
+namespace opennn
+{
+
+/// Default constructor.
+/// It creates an empty cache.
+
+TrainingCache::TrainingCache()
+{
+}
+
+
+/// Data constructor.
+/// It packs the input and target variables of a data matrix.
+/// @param data Data matrix.
+/// @param new_input_variables_indices Indices of the input variables.
+/// @param new_target_variables_indices Indices of the target variables.
+/// @param new_storage_precision Precision of the stored values.
+/// @param new_input_categories_numbers Number of categories of each input code, or zero for the other inputs.
+
+TrainingCache::TrainingCache(const Tensor<type, 2>& data,
+                             const Tensor<Index, 1>& new_input_variables_indices,
+                             const Tensor<Index, 1>& new_target_variables_indices,
+                             const StoragePrecision& new_storage_precision,
+                             const Tensor<Index, 1>& new_input_categories_numbers)
+{
+    set(data, new_input_variables_indices, new_target_variables_indices, new_storage_precision, new_input_categories_numbers);
+}
+
+
+/// Destructor.
+
+TrainingCache::~TrainingCache()
+{
+}
+
+
+/// Returns true if the cache does not hold any sample, and false otherwise.
+
+bool TrainingCache::is_empty() const
+{
+    return samples_number == 0;
+}
+
+
+/// Returns the number of samples of the cache, which is that of the data matrix.
+
+Index TrainingCache::get_samples_number() const
+{
+    return samples_number;
+}
+
+
+/// Returns the number of values of each row, including the padding.
+
+const Index& TrainingCache::get_row_size() const
+{
+    return row_size;
+}
+
+
+/// Returns the precision of the stored values.
+
+const StoragePrecision& TrainingCache::get_storage_precision() const
+{
+    return storage_precision;
+}
+
+
+/// Returns the number of bytes of the rows, including the padding.
+
+Index TrainingCache::get_bytes_number() const
+{
+    return samples_number*row_size*get_storage_precision_size(storage_precision);
+}
+
+
+/// Returns the indices in the data matrix of the input variables of the cache.
+
+const Tensor<Index, 1>& TrainingCache::get_input_variables_indices() const
+{
+    return input_variables_indices;
+}
+
+
+/// Returns the indices in the data matrix of the target variables of the cache.
+
+const Tensor<Index, 1>& TrainingCache::get_target_variables_indices() const
+{
+    return target_variables_indices;
+}
+
+
+/// Returns the number of categories of each input code, or zero for the inputs stored as their values.
+/// It is empty if the inputs are not stored as codes.
+
+const Tensor<Index, 1>& TrainingCache::get_input_categories_numbers() const
+{
+    return input_categories_numbers;
+}
+
+
+/// Returns the number of input values of each row, which are the columns filled by fill_inputs().
+/// It is the number of input variables, unless some of them are stored as codes.
+
+Index TrainingCache::get_input_codes_number() const
+{
+    return input_categories_numbers.size() == 0
+            ? input_variables_indices.size()
+            : input_categories_numbers.size();
+}
+
+
+/// Returns true if the cache holds the given input and target variables, in the same order,
+/// with the same input codes, and false otherwise.
+/// @param other_input_variables_indices Indices of the input variables.
+/// @param other_target_variables_indices Indices of the target variables.
+/// @param other_input_categories_numbers Number of categories of each input code, or empty if there are no codes.
+
+bool TrainingCache::has_variables(const Tensor<Index, 1>& other_input_variables_indices,
+                                  const Tensor<Index, 1>& other_target_variables_indices,
+                                  const Tensor<Index, 1>& other_input_categories_numbers) const
+{
+    if(is_empty()) return false;
+
+    if(other_input_variables_indices.size() != input_variables_indices.size()
+    || other_target_variables_indices.size() != target_variables_indices.size()
+    || other_input_categories_numbers.size() != input_categories_numbers.size())
+    {
+        return false;
+    }
+
+    return equal(input_variables_indices.data(),
+                 input_variables_indices.data() + input_variables_indices.size(),
+                 other_input_variables_indices.data())
+        && equal(target_variables_indices.data(),
+                 target_variables_indices.data() + target_variables_indices.size(),
+                 other_target_variables_indices.data())
+        && equal(input_categories_numbers.data(),
+                 input_categories_numbers.data() + input_categories_numbers.size(),
+                 other_input_categories_numbers.data());
+}
+
+
+/// Frees the cache.
+
+void TrainingCache::set()
+{
+    rows.resize(0);
+    half_rows.resize(0);
+    bfloat16_rows.resize(0);
+
+    storage_precision = StoragePrecision::Single;
+
+    samples_number = 0;
+    row_size = 0;
+
+    input_variables_indices.resize(0);
+    target_variables_indices.resize(0);
+
+    input_categories_numbers.resize(0);
+}
+
+
+/// Packs the input and target variables of a data matrix into padded rows, one per sample.
+/// The matrix is read in blocks of samples, so that the columns are read contiguously.
+/// The one hot input variables of each code are stored as the position of the first of them greater than one half,
+/// or minus one if none is.
+/// @param data Data matrix.
+/// @param new_input_variables_indices Indices of the input variables.
+/// @param new_target_variables_indices Indices of the target variables.
+/// @param new_storage_precision Precision of the stored values, to which the values of the data matrix are rounded.
+/// @param new_input_categories_numbers Number of categories of each input code, or zero for the inputs stored as
+/// their values. The codes take the input variables in order. If it is empty, all the inputs are stored as their values.
+
+void TrainingCache::set(const Tensor<type, 2>& data,
+                        const Tensor<Index, 1>& new_input_variables_indices,
+                        const Tensor<Index, 1>& new_target_variables_indices,
+                        const StoragePrecision& new_storage_precision,
+                        const Tensor<Index, 1>& new_input_categories_numbers)
+{
+    const Index data_variables_number = data.dimension(1);
+
+    const Index input_variables_number = new_input_variables_indices.size();
+    const Index target_variables_number = new_target_variables_indices.size();
+    const Index variables_number = input_variables_number + target_variables_number;
+
+    Tensor<Index, 1> variables_indices(variables_number);
+
+    for(Index j = 0; j < variables_number; j++)
+    {
+        variables_indices(j) = j < input_variables_number
+                ? new_input_variables_indices(j)
+                : new_target_variables_indices(j - input_variables_number);
+
+        if(variables_indices(j) < 0 || variables_indices(j) >= data_variables_number)
+        {
+            ostringstream buffer;
+
+            buffer << "OpenNN Exception: TrainingCache class.\n"
+                   << "void set(const Tensor<type, 2>&, const Tensor<Index, 1>&, const Tensor<Index, 1>&, const StoragePrecision&, const Tensor<Index, 1>&) method.\n"
+                   << "Variable index (" << variables_indices(j) << ") must be less than "
+                   << "number of variables (" << data_variables_number << ").\n";
+
+            throw invalid_argument(buffer.str());
+        }
+    }
+
+    // Codes must be exact integers in the storage precision
+
+    const Index maximum_categories_number = new_storage_precision == StoragePrecision::Single
+            ? Index(1) << 24
+            : new_storage_precision == StoragePrecision::Half ? 2048 : 256;
+
+    Index coded_input_variables_number = 0;
+
+    for(Index j = 0; j < new_input_categories_numbers.size(); j++)
+    {
+        if(new_input_categories_numbers(j) < 0 || new_input_categories_numbers(j) > maximum_categories_number)
+        {
+            ostringstream buffer;
+
+            buffer << "OpenNN Exception: TrainingCache class.\n"
+                   << "void set(const Tensor<type, 2>&, const Tensor<Index, 1>&, const Tensor<Index, 1>&, const StoragePrecision&, const Tensor<Index, 1>&) method.\n"
+                   << "Number of categories (" << new_input_categories_numbers(j) << ") must be between 0 and "
+                   << maximum_categories_number << " in " << write_storage_precision(new_storage_precision) << " precision.\n";
+
+            throw invalid_argument(buffer.str());
+        }
+
+        coded_input_variables_number += max(new_input_categories_numbers(j), Index(1));
+    }
+
+    if(new_input_categories_numbers.size() != 0 && coded_input_variables_number != input_variables_number)
+    {
+        ostringstream buffer;
+
+        buffer << "OpenNN Exception: TrainingCache class.\n"
+               << "void set(const Tensor<type, 2>&, const Tensor<Index, 1>&, const Tensor<Index, 1>&, const StoragePrecision&, const Tensor<Index, 1>&) method.\n"
+               << "Number of coded input variables (" << coded_input_variables_number << ") must be equal to "
+               << "number of input variables (" << input_variables_number << ").\n";
+
+        throw invalid_argument(buffer.str());
+    }
+
+    const Index cache_line_values_number = 64/get_storage_precision_size(new_storage_precision);
+
+    set();
+
+    storage_precision = new_storage_precision;
+
+    samples_number = data.dimension(0);
+
+    input_variables_indices = new_input_variables_indices;
+    target_variables_indices = new_target_variables_indices;
+
+    input_categories_numbers = new_input_categories_numbers;
+
+    const Index values_number = get_input_codes_number() + target_variables_number;
+
+    row_size = ((values_number + cache_line_values_number - 1)/cache_line_values_number)*cache_line_values_number;
+
+    // Number of categories of each value of the rows
+
+    Tensor<Index, 1> values_categories_numbers(values_number);
+    values_categories_numbers.setZero();
+
+    for(Index j = 0; j < input_categories_numbers.size(); j++)
+    {
+        values_categories_numbers(j) = input_categories_numbers(j);
+    }
+
+    switch(storage_precision)
+    {
+    case StoragePrecision::Single:
+
+        rows.resize(samples_number*row_size);
+        rows.setZero();
+
+        pack_rows(data, variables_indices, values_categories_numbers, rows.data());
+
+        return;
+
+    case StoragePrecision::Half:
+
+        half_rows.resize(samples_number*row_size);
+        half_rows.setZero();
+
+        pack_rows(data, variables_indices, values_categories_numbers, half_rows.data());
+
+        return;
+
+    case StoragePrecision::BFloat16:
+
+        bfloat16_rows.resize(samples_number*row_size);
+        bfloat16_rows.setZero();
+
+        pack_rows(data, variables_indices, values_categories_numbers, bfloat16_rows.data());
+
+        return;
+    }
+}
+
+
+/// Copies the input variables of some samples into a column major submatrix.
+/// @param samples_indices Indices of the samples, which are the rows of the submatrix.
+/// @param submatrix_pointer Pointer to the first value of the submatrix.
+
+void TrainingCache::fill_inputs(const Tensor<Index, 1>& samples_indices, type* submatrix_pointer) const
+{
+    fill_submatrix(samples_indices, 0, get_input_codes_number(), submatrix_pointer);
+}
+
+
+/// Copies the target variables of some samples into a column major submatrix.
+/// @param samples_indices Indices of the samples, which are the rows of the submatrix.
+/// @param submatrix_pointer Pointer to the first value of the submatrix.
+
+void TrainingCache::fill_targets(const Tensor<Index, 1>& samples_indices, type* submatrix_pointer) const
+{
+    fill_submatrix(samples_indices, get_input_codes_number(), target_variables_indices.size(), submatrix_pointer);
+}
+
+
+/// Copies some consecutive values of the rows of some samples into a column major submatrix.
+/// The samples are taken in tiles, whose rows stay in cache while they are transposed into the submatrix.
+/// @param samples_indices Indices of the samples, which are the rows of the submatrix.
+/// @param values_begin Position in the rows of the first value.
+/// @param values_number Number of values of each row, which are the columns of the submatrix.
+/// @param submatrix_pointer Pointer to the first value of the submatrix.
+
+void TrainingCache::fill_submatrix(const Tensor<Index, 1>& samples_indices,
+                                   const Index& values_begin,
+                                   const Index& values_number,
+                                   type* submatrix_pointer) const
+{
+    if(storage_precision == StoragePrecision::Half)
+    {
+        fill_reduced_submatrix(half_rows.data(), samples_indices, values_begin, values_number, submatrix_pointer);
+
+        return;
+    }
+    else if(storage_precision == StoragePrecision::BFloat16)
+    {
+        fill_reduced_submatrix(bfloat16_rows.data(), samples_indices, values_begin, values_number, submatrix_pointer);
+
+        return;
+    }
+
+    const Index rows_number = samples_indices.size();
+
+    const Index tiles_number = (rows_number + tile_samples_number - 1)/tile_samples_number;
+
+    const type* rows_pointer = rows.data() + values_begin;
+
+    #pragma omp parallel for
+
+    for(Index tile = 0; tile < tiles_number; tile++)
+    {
+        const Index tile_begin = tile*tile_samples_number;
+        const Index tile_size = min(tile_samples_number, rows_number - tile_begin);
+
+        const type* tile_rows[tile_samples_number];
+
+        for(Index i = 0; i < tile_size; i++)
+        {
+            tile_rows[i] = rows_pointer + samples_indices(tile_begin + i)*row_size;
+        }
+
+        for(Index j = 0; j < values_number; j++)
+        {
+            type* submatrix_column_pointer = submatrix_pointer + rows_number*j + tile_begin;
+
+            for(Index i = 0; i < tile_size; i++)
+            {
+                submatrix_column_pointer[i] = tile_rows[i][j];
+            }
+        }
+    }
+}
+
+
+/// Copies into padded rows the values of some variables of a data matrix, rounded to the type of the rows.
+/// @param data Data matrix.
+/// @param variables_indices Indices of the variables, in the order of the rows.
+/// @param values_categories_numbers Number of categories of each value of the rows, which is the code of as many
+/// one hot variables, or zero for the values of a single variable.
+/// @param rows_pointer Pointer to the first value of the rows.
+
+template<typename T>
+void TrainingCache::pack_rows(const Tensor<type, 2>& data,
+                              const Tensor<Index, 1>& variables_indices,
+                              const Tensor<Index, 1>& values_categories_numbers,
+                              T* rows_pointer)
+{
+    const Index values_number = values_categories_numbers.size();
+
+    Tensor<Index, 1> values_variables_begins(values_number);
+
+    Index variables_begin = 0;
+
+    for(Index j = 0; j < values_number; j++)
+    {
+        values_variables_begins(j) = variables_begin;
+
+        variables_begin += max(values_categories_numbers(j), Index(1));
+    }
+
+    const Index blocks_number = (samples_number + tile_samples_number - 1)/tile_samples_number;
+
+    #pragma omp parallel for
+
+    for(Index block = 0; block < blocks_number; block++)
+    {
+        const Index samples_begin = block*tile_samples_number;
+        const Index samples_end = min(samples_begin + tile_samples_number, samples_number);
+
+        for(Index j = 0; j < values_number; j++)
+        {
+            const Index* value_variables_indices = variables_indices.data() + values_variables_begins(j);
+
+            if(values_categories_numbers(j) == 0)
+            {
+                const type* data_column_pointer = data.data() + samples_number*value_variables_indices[0];
+
+                for(Index i = samples_begin; i < samples_end; i++)
+                {
+                    rows_pointer[i*row_size + j] = T(data_column_pointer[i]);
+                }
+
+                continue;
+            }
+
+            Index codes[tile_samples_number];
+
+            fill(codes, codes + tile_samples_number, Index(-1));
+
+            for(Index k = values_categories_numbers(j) - 1; k >= 0; k--)
+            {
+                const type* data_column_pointer = data.data() + samples_number*value_variables_indices[k];
+
+                for(Index i = samples_begin; i < samples_end; i++)
+                {
+                    if(data_column_pointer[i] > type(0.5)) codes[i - samples_begin] = k;
+                }
+            }
+
+            for(Index i = samples_begin; i < samples_end; i++)
+            {
+                rows_pointer[i*row_size + j] = T(type(codes[i - samples_begin]));
+            }
+        }
+    }
+}
+
+
+/// Copies some consecutive values of the reduced precision rows of some samples into a column major submatrix.
+/// The values of the rows of each tile are converted to single precision into a scratch tile, with vector instructions,
+/// and the scratch tile is transposed into the submatrix.
+/// @param reduced_rows_pointer Pointer to the first value of the reduced precision rows.
+/// @param samples_indices Indices of the samples, which are the rows of the submatrix.
+/// @param values_begin Position in the rows of the first value.
+/// @param values_number Number of values of each row, which are the columns of the submatrix.
+/// @param submatrix_pointer Pointer to the first value of the submatrix.
+
+template<typename T>
+void TrainingCache::fill_reduced_submatrix(const T* reduced_rows_pointer,
+                                           const Tensor<Index, 1>& samples_indices,
+                                           const Index& values_begin,
+                                           const Index& values_number,
+                                           type* submatrix_pointer) const
+{
+    const Index rows_number = samples_indices.size();
+
+    const Index tiles_number = (rows_number + tile_samples_number - 1)/tile_samples_number;
+
+    const T* rows_pointer = reduced_rows_pointer + values_begin;
+
+    #pragma omp parallel
+    {
+        Tensor<type, 1> tile_values(tile_samples_number*values_number);
+
+        #pragma omp for
+
+        for(Index tile = 0; tile < tiles_number; tile++)
+        {
+            const Index tile_begin = tile*tile_samples_number;
+            const Index tile_size = min(tile_samples_number, rows_number - tile_begin);
+
+            for(Index i = 0; i < tile_size; i++)
+            {
+                convert_to_single(rows_pointer + samples_indices(tile_begin + i)*row_size,
+                                  values_number,
+                                  tile_values.data() + i*values_number);
+            }
+
+            for(Index j = 0; j < values_number; j++)
+            {
+                type* submatrix_column_pointer = submatrix_pointer + rows_number*j + tile_begin;
+
+                for(Index i = 0; i < tile_size; i++)
+                {
+                    submatrix_column_pointer[i] = tile_values(i*values_number + j);
+                }
+            }
+        }
+    }
+}
+
+}
+
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -0,0 +1,171 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   T R A I N I N G   C A C H E   C L A S S   H E A D E R
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#ifndef TRAININGCACHE_H
+#define TRAININGCACHE_H
+
+// System includes
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <stdexcept>
+
+// OpenNN includes
+
+#include "config.h"
+#include "storage_precision.h"
+
+namespace opennn
+{
+
+/// This class holds a copy of the input and target variables of a data set with the samples in rows.
+
+/// The data matrix is column major, so a batch reads one value per variable at a random position.
+/// The cache packs the used variables of each sample into a row, the inputs followed by the targets,
+/// and pads the rows to a whole number of cache lines, so that a batch reads each sample contiguously.
+/// The rows are gathered in tiles of a few samples, which are transposed into the column major batch.
+/// The values can be stored in half or bfloat16 precision, which halves the memory and the bandwidth of the batches.
+/// The rows of a tile are then converted to single precision before they are transposed.
+/// The one hot variables of a categorical input can be stored as a single code, the position of its hot category,
+/// so that the rows grow with the number of columns instead of the number of categories.
+
+class TrainingCache
+{
+
+public:
+
+    // Constructors
+
+    explicit TrainingCache();
+
+    explicit TrainingCache(const Tensor<type, 2>&,
+                           const Tensor<Index, 1>&,
+                           const Tensor<Index, 1>&,
+                           const StoragePrecision& = StoragePrecision::Single,
+                           const Tensor<Index, 1>& = Tensor<Index, 1>());
+
+    // Destructor
+
+    virtual ~TrainingCache();
+
+    // Get methods
+
+    bool is_empty() const;
+
+    Index get_samples_number() const;
+
+    const Index& get_row_size() const;
+
+    const StoragePrecision& get_storage_precision() const;
+
+    Index get_bytes_number() const;
+
+    const Tensor<Index, 1>& get_input_variables_indices() const;
+
+    const Tensor<Index, 1>& get_target_variables_indices() const;
+
+    const Tensor<Index, 1>& get_input_categories_numbers() const;
+
+    Index get_input_codes_number() const;
+
+    bool has_variables(const Tensor<Index, 1>&,
+                       const Tensor<Index, 1>&,
+                       const Tensor<Index, 1>& = Tensor<Index, 1>()) const;
+
+    // Set methods
+
+    void set();
+
+    void set(const Tensor<type, 2>&,
+             const Tensor<Index, 1>&,
+             const Tensor<Index, 1>&,
+             const StoragePrecision& = StoragePrecision::Single,
+             const Tensor<Index, 1>& = Tensor<Index, 1>());
+
+    // Reading methods
+
+    void fill_inputs(const Tensor<Index, 1>&, type*) const;
+
+    void fill_targets(const Tensor<Index, 1>&, type*) const;
+
+private:
+
+    template<typename T>
+    void pack_rows(const Tensor<type, 2>&, const Tensor<Index, 1>&, const Tensor<Index, 1>&, T*);
+
+    void fill_submatrix(const Tensor<Index, 1>&, const Index&, const Index&, type*) const;
+
+    template<typename T>
+    void fill_reduced_submatrix(const T*, const Tensor<Index, 1>&, const Index&, const Index&, type*) const;
+
+    /// Number of samples of the tiles which are transposed into the batches.
+
+    static constexpr Index tile_samples_number = 16;
+
+    /// Precision of the stored values.
+
+    StoragePrecision storage_precision = StoragePrecision::Single;
+
+    /// Number of samples of the cache.
+
+    Index samples_number = 0;
+
+    /// Values of the samples in single precision, one padded row per sample.
+
+    Tensor<type, 1> rows;
+
+    /// Values of the samples in half precision, one padded row per sample.
+
+    Tensor<Eigen::half, 1> half_rows;
+
+    /// Values of the samples in bfloat16 precision, one padded row per sample.
+
+    Tensor<Eigen::bfloat16, 1> bfloat16_rows;
+
+    /// Number of values of each row, which is a multiple of the values of a cache line.
+
+    Index row_size = 0;
+
+    /// Indices in the data matrix of the input variables, which are the first values of the rows.
+
+    Tensor<Index, 1> input_variables_indices;
+
+    /// Indices in the data matrix of the target variables, which follow the input variables in the rows.
+
+    Tensor<Index, 1> target_variables_indices;
+
+    /// Number of categories of each input code, or zero for the inputs stored as their values.
+    /// A code takes as many consecutive input variables as categories. It is empty if there are no codes.
+
+    Tensor<Index, 1> input_categories_numbers;
+};
+
+}
+
+#endif
+
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright(C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -536,11 +536,12 @@ void TrainingStrategy::set_optimization_method(const string& new_optimization_me
 }
 
 
+/// Sets the number of threads of the thread pool shared by all the objects.
+/// @param new_threads_number Number of threads.
+
 void TrainingStrategy::set_threads_number(const int& new_threads_number)
 {
-    set_loss_index_threads_number(new_threads_number);
-
-    set_optimization_algorithm_threads_number(new_threads_number);
+    ExecutionContext::set_threads_number(new_threads_number);
 }
 
 
@@ -92,9 +92,9 @@ protected:
 
    bool display = true;
 
-   const int n = omp_get_max_threads();
-   ThreadPool* thread_pool = new ThreadPool(n);
-   ThreadPoolDevice* thread_pool_device = new ThreadPoolDevice(thread_pool, n);
+   /// Thread pool device shared by all the objects, owned by the execution context.
+
+   ThreadPoolDevice* thread_pool_device = ExecutionContext::get_thread_pool_device();
 
 };
 
@@ -296,9 +296,7 @@ void WeightedSquaredError::calculate_output_delta(const DataSetBatch& batch,
 
     deltas.device(*thread_pool_device) = if_sentence.select(f_1, else_sentence.select(f_2, f_3));
 
-    Tensor<type, 2> output_deltas(deltas);
-
-    if(has_NAN(output_deltas))
+    if(has_NAN(deltas.data(), deltas.size()))
     {
         ostringstream buffer;
 
@@ -355,6 +353,18 @@ void WeightedSquaredError::calculate_error_hessian_lm(const DataSetBatch& batch,
 }
 
 
+/// Returns the coefficient of the sum of the weighted squared error terms in the error of a batch.
+/// It is the inverse of the normalization coefficient, scaled by the fraction of the samples in the batch.
+/// @param batch_samples_number Number of samples of the batch.
+
+type WeightedSquaredError::get_squared_errors_coefficient_lm(const Index& batch_samples_number) const
+{
+    const Index total_samples_number = data_set_pointer->get_samples_number();
+
+    return type(1)/((static_cast<type>(batch_samples_number)/static_cast<type>(total_samples_number))*normalization_coefficient);
+}
+
+
 /// Returns a string with the name of the weighted squared error loss type, "WEIGHTED_SQUARED_ERROR".
 
 string WeightedSquaredError::get_error_type() const
@@ -99,6 +99,8 @@ public:
    void calculate_error_hessian_lm(const DataSetBatch&,
                                            LossIndexBackPropagationLM&) const final;
 
+   type get_squared_errors_coefficient_lm(const Index&) const final;
+
    // Serialization methods
 
    void from_XML(const tinyxml2::XMLDocument&);
@@ -47,6 +47,216 @@ void AdaptiveMomentEstimationTest::test_destructor()
 }
 
 
+void AdaptiveMomentEstimationTest::test_update_parameters()
+{
+    cout << "test_update_parameters\n";
+
+    samples_number = 3;
+    inputs_number = 4;
+    outputs_number = 2;
+    neurons_number = 500;
+
+    data_set.set(samples_number, inputs_number, outputs_number);
+
+    neural_network.set(NeuralNetwork::ProjectType::Approximation, {inputs_number, neurons_number, outputs_number});
+    neural_network.set_parameters_random();
+
+    const Index parameters_number = neural_network.get_parameters_number();
+
+    const type initial_learning_rate = adaptive_moment_estimation.get_initial_learning_rate();
+    const type beta_1 = adaptive_moment_estimation.get_beta_1();
+    const type beta_2 = adaptive_moment_estimation.get_beta_2();
+    const type epsilon = adaptive_moment_estimation.get_epsilon();
+
+    LossIndexBackPropagation back_propagation(samples_number, &sum_squared_error);
+
+    Tensor<type, 1> first_moments(parameters_number);
+    Tensor<type, 1> second_moments(parameters_number);
+    Tensor<type, 1> parameters(parameters_number);
+
+    // Test
+
+    for(const type& weight_decay : {type(0), type(0.01)})
+    {
+        adaptive_moment_estimation.set_weight_decay(weight_decay);
+
+        AdaptiveMomentEstimationData optimization_data(&adaptive_moment_estimation);
+
+        first_moments.setZero();
+        second_moments.setZero();
+
+        back_propagation.parameters = neural_network.get_parameters();
+
+        parameters = back_propagation.parameters;
+
+        for(Index iteration = 1; iteration <= 3; iteration++)
+        {
+            back_propagation.gradient.setRandom();
+
+            optimization_data.iteration = iteration;
+
+            adaptive_moment_estimation.update_parameters(back_propagation, optimization_data);
+
+            const type learning_rate = initial_learning_rate*sqrt(type(1) - pow(beta_2, type(iteration)))/(type(1) - pow(beta_1, type(iteration)));
+
+            first_moments = back_propagation.gradient*(type(1) - beta_1) + first_moments*beta_1;
+            second_moments = back_propagation.gradient.square()*(type(1) - beta_2) + second_moments*beta_2;
+
+            parameters = parameters*(type(1) - initial_learning_rate*weight_decay)
+                       - first_moments*learning_rate/(second_moments.sqrt() + epsilon);
+        }
+
+        assert_true(are_equal(optimization_data.gradient_exponential_decay, first_moments, type(1.0e-6)), LOG);
+        assert_true(are_equal(optimization_data.square_gradient_exponential_decay, second_moments, type(1.0e-6)), LOG);
+        assert_true(are_equal(back_propagation.parameters, parameters, type(1.0e-5)), LOG);
+    }
+
+    adaptive_moment_estimation.set_weight_decay(type(0));
+
+    // Test
+
+    adaptive_moment_estimation.set_moments_precision(StoragePrecision::BFloat16);
+
+    {
+        AdaptiveMomentEstimationData optimization_data(&adaptive_moment_estimation);
+
+        assert_true(optimization_data.gradient_exponential_decay.size() == 0, LOG);
+        assert_true(optimization_data.bfloat16_gradient_exponential_decay.size() == parameters_number, LOG);
+
+        first_moments.setZero();
+        second_moments.setZero();
+
+        back_propagation.parameters = neural_network.get_parameters();
+
+        parameters = back_propagation.parameters;
+
+        for(Index iteration = 1; iteration <= 3; iteration++)
+        {
+            back_propagation.gradient.setRandom();
+
+            optimization_data.iteration = iteration;
+
+            adaptive_moment_estimation.update_parameters(back_propagation, optimization_data);
+
+            const type learning_rate = initial_learning_rate*sqrt(type(1) - pow(beta_2, type(iteration)))/(type(1) - pow(beta_1, type(iteration)));
+
+            first_moments = back_propagation.gradient*(type(1) - beta_1) + first_moments*beta_1;
+            second_moments = back_propagation.gradient.square()*(type(1) - beta_2) + second_moments*beta_2;
+
+            parameters = parameters - first_moments*learning_rate/(second_moments.sqrt() + epsilon);
+        }
+
+        // The moments keep 8 bits of mantissa, so the steps are accurate to about one percent
+
+        const Tensor<type, 1> bfloat16_first_moments = optimization_data.bfloat16_gradient_exponential_decay.cast<type>();
+
+        assert_true(are_equal(bfloat16_first_moments, first_moments, type(1.0e-2)), LOG);
+        assert_true(are_equal(back_propagation.parameters, parameters, type(1.0e-1)*initial_learning_rate), LOG);
+    }
+
+    adaptive_moment_estimation.set_moments_precision(StoragePrecision::Single);
+
+    // Test
+
+    try
+    {
+        adaptive_moment_estimation.set_moments_precision(StoragePrecision::Half);
+
+        assert_true(false, LOG);
+    }
+    catch(const invalid_argument&)
+    {
+        assert_true(adaptive_moment_estimation.get_moments_precision() == StoragePrecision::Single, LOG);
+    }
+}
+
+
+void AdaptiveMomentEstimationTest::test_update_parameters_lazily()
+{
+    cout << "test_update_parameters_lazily\n";
+
+    samples_number = 2;
+
+    const Index input_dim = 10;
+    const Index input_length = 3;
+    const Index depth = 4;
+
+    data_set.set(samples_number, input_length, depth);
+
+    neural_network.set();
+
+    neural_network.add_layer(new EmbeddingLayer(input_dim, input_length, depth));
+
+    neural_network.set_parameters_random();
+
+    const type initial_learning_rate = adaptive_moment_estimation.get_initial_learning_rate();
+
+    const type weight_decay = type(0.01);
+
+    LossIndexBackPropagation back_propagation(samples_number, &sum_squared_error);
+
+    EmbeddingLayerBackPropagation* embedding_layer_back_propagation
+            = static_cast<EmbeddingLayerBackPropagation*>(back_propagation.neural_network.layers(0));
+
+    // Test
+
+    // A batch without rows leaves the lookup table as it is, unless weight decay shrinks all its rows
+
+    for(const type& new_weight_decay : {type(0), weight_decay})
+    {
+        adaptive_moment_estimation.set_weight_decay(new_weight_decay);
+
+        AdaptiveMomentEstimationData optimization_data(&adaptive_moment_estimation);
+
+        back_propagation.parameters = neural_network.get_parameters();
+
+        const Tensor<type, 1> parameters = back_propagation.parameters;
+
+        back_propagation.gradient.setZero();
+
+        embedding_layer_back_propagation->rows_number = 0;
+        embedding_layer_back_propagation->has_sparse_derivatives = true;
+
+        optimization_data.iteration = 1;
+
+        adaptive_moment_estimation.update_parameters(back_propagation, optimization_data);
+
+        const Tensor<type, 1> expected_parameters = parameters*(type(1) - initial_learning_rate*new_weight_decay);
+
+        assert_true(are_equal(Tensor<type, 1>(back_propagation.parameters), expected_parameters, type(1.0e-6)), LOG);
+    }
+
+    adaptive_moment_estimation.set_weight_decay(type(0));
+
+    // Test
+
+    // A gradient written outside the layer, as by the regularization, updates all the rows
+
+    {
+        AdaptiveMomentEstimationData optimization_data(&adaptive_moment_estimation);
+
+        back_propagation.parameters = neural_network.get_parameters();
+
+        const Tensor<type, 1> parameters = back_propagation.parameters;
+
+        back_propagation.gradient.setConstant(type(1));
+
+        embedding_layer_back_propagation->rows_number = 0;
+        embedding_layer_back_propagation->has_sparse_derivatives = true;
+
+        back_propagation.set_gradient_modified();
+
+        optimization_data.iteration = 1;
+
+        adaptive_moment_estimation.update_parameters(back_propagation, optimization_data);
+
+        const Tensor<type, 1> expected_parameters = parameters - parameters.constant(initial_learning_rate);
+
+        assert_true(are_equal(Tensor<type, 1>(back_propagation.parameters), expected_parameters, type(1.0e-5)), LOG);
+    }
+}
+
+
 void AdaptiveMomentEstimationTest::test_perform_training()
 {
     cout << "test_perform_training\n";
@@ -126,6 +336,10 @@ void AdaptiveMomentEstimationTest::run_test_case()
 
     // Training methods
 
+    test_update_parameters();
+
+    test_update_parameters_lazily();
+
     test_perform_training();
 
     cout << "End of gradient descent test case.\n\n";
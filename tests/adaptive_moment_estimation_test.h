@@ -35,6 +35,10 @@ public:
 
     // Training methods
 
+    void test_update_parameters();
+
+    void test_update_parameters_lazily();
+
     void test_perform_training();
 
     // Unit testing methods
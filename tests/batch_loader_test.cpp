@@ -0,0 +1,210 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   B A T C H   L O A D E R   T E S T   C L A S S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "batch_loader_test.h"
+
+
+BatchLoaderTest::BatchLoaderTest() : UnitTesting()
+{
+    Tensor<type, 2> data(10, 3);
+
+    for(Index i = 0; i < data.dimension(0); i++)
+    {
+        for(Index j = 0; j < data.dimension(1); j++)
+        {
+            data(i, j) = type(10*i + j);
+        }
+    }
+
+    data_set.set_data(data);
+
+    data_set.set_training();
+}
+
+
+BatchLoaderTest::~BatchLoaderTest()
+{
+}
+
+
+void BatchLoaderTest::test_constructor()
+{
+    cout << "test_constructor\n";
+
+    // Default constructor
+
+    BatchLoader batch_loader_1;
+
+    assert_true(batch_loader_1.get_data_set_pointer() == nullptr, LOG);
+    assert_true(batch_loader_1.get_buffers_number() == 0, LOG);
+
+    // Data set constructor
+
+    BatchLoader batch_loader_2(&data_set, 4, 3, 5);
+
+    assert_true(batch_loader_2.get_data_set_pointer() == &data_set, LOG);
+    assert_true(batch_loader_2.get_batch_samples_number() == 4, LOG);
+    assert_true(batch_loader_2.get_buffers_number() == 3, LOG);
+    assert_true(batch_loader_2.get_workers_number() == 3, LOG);
+    assert_true(batch_loader_2.get_waits_number() == 0, LOG);
+}
+
+
+void BatchLoaderTest::test_next_batch()
+{
+    cout << "test_next_batch\n";
+
+    const Tensor<Index, 1> samples_indices = data_set.get_training_samples_indices();
+
+    const Tensor<Index, 1> input_variables_indices = data_set.get_input_variables_indices();
+    const Tensor<Index, 1> target_variables_indices = data_set.get_target_variables_indices();
+
+    // Test
+
+    for(Index buffers_number = 1; buffers_number <= 3; buffers_number++)
+    {
+        BatchLoader batch_loader(&data_set, 3, buffers_number, 2);
+
+        for(Index epoch = 0; epoch < 2; epoch++)
+        {
+            batch_loader.start(samples_indices, input_variables_indices, target_variables_indices);
+
+            assert_true(batch_loader.get_batches_number() == 3, LOG);
+
+            for(Index i = 0; i < batch_loader.get_batches_number(); i++)
+            {
+                const DataSetBatch& batch = batch_loader.next_batch();
+
+                const TensorMap<Tensor<type, 2>> inputs = batch.inputs(0).to_tensor_map<2>();
+                const TensorMap<Tensor<type, 2>> targets = batch.targets.to_tensor_map<2>();
+
+                for(Index j = 0; j < 3; j++)
+                {
+                    const Index sample_index = 3*i + j;
+
+                    assert_true(inputs(j, 0) == type(10*sample_index), LOG);
+                    assert_true(inputs(j, 1) == type(10*sample_index + 1), LOG);
+                    assert_true(targets(j, 0) == type(10*sample_index + 2), LOG);
+                }
+            }
+
+            bool has_thrown = false;
+
+            try
+            {
+                batch_loader.next_batch();
+            }
+            catch(const logic_error&)
+            {
+                has_thrown = true;
+            }
+
+            assert_true(has_thrown, LOG);
+        }
+    }
+
+    // Test
+
+    BatchLoader batch_loader(&data_set, 20);
+
+    bool has_thrown = false;
+
+    try
+    {
+        batch_loader.start(samples_indices, input_variables_indices, target_variables_indices);
+    }
+    catch(const invalid_argument&)
+    {
+        has_thrown = true;
+    }
+
+    assert_true(has_thrown, LOG);
+}
+
+
+void BatchLoaderTest::test_shuffle()
+{
+    cout << "test_shuffle\n";
+
+    const Tensor<Index, 1> samples_indices = data_set.get_training_samples_indices();
+
+    const Tensor<Index, 1> input_variables_indices = data_set.get_input_variables_indices();
+    const Tensor<Index, 1> target_variables_indices = data_set.get_target_variables_indices();
+
+    BatchLoader batch_loader_1(&data_set, 2, 2, 1);
+    BatchLoader batch_loader_2(&data_set, 2, 4, 3);
+
+    batch_loader_1.set_seed(7);
+    batch_loader_2.set_seed(7);
+
+    // Test
+
+    for(Index epoch = 0; epoch < 3; epoch++)
+    {
+        batch_loader_1.start(samples_indices, input_variables_indices, target_variables_indices, true);
+        batch_loader_2.start(samples_indices, input_variables_indices, target_variables_indices, true);
+
+        Tensor<bool, 1> is_loaded(10);
+        is_loaded.setConstant(false);
+
+        for(Index i = 0; i < 5; i++)
+        {
+            const TensorMap<Tensor<type, 2>> targets_1 = batch_loader_1.next_batch().targets.to_tensor_map<2>();
+            const TensorMap<Tensor<type, 2>> targets_2 = batch_loader_2.next_batch().targets.to_tensor_map<2>();
+
+            for(Index j = 0; j < 2; j++)
+            {
+                assert_true(targets_1(j, 0) == targets_2(j, 0), LOG);
+
+                is_loaded(Index(targets_1(j, 0))/10) = true;
+            }
+        }
+
+        for(Index i = 0; i < 10; i++)
+        {
+            assert_true(is_loaded(i), LOG);
+        }
+    }
+}
+
+
+void BatchLoaderTest::run_test_case()
+{
+    cout << "Running batch loader test case...\n";
+
+    // Constructor and destructor methods
+
+    test_constructor();
+
+    // Loading methods
+
+    test_next_batch();
+
+    test_shuffle();
+
+    cout << "End of batch loader test case.\n\n";
+}
+
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -0,0 +1,211 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   B I N A R Y   D A T A   F I L E   T E S T   C L A S S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "binary_data_file_test.h"
+
+
+BinaryDataFileTest::BinaryDataFileTest() : UnitTesting()
+{
+    file_name = (filesystem::temp_directory_path()/"opennn_binary_data_file_test.bin").string();
+}
+
+
+BinaryDataFileTest::~BinaryDataFileTest()
+{
+    filesystem::remove(file_name);
+}
+
+
+void BinaryDataFileTest::test_constructor()
+{
+    cout << "test_constructor\n";
+
+    // Default constructor
+
+    BinaryDataFile binary_data_file_1;
+
+    assert_true(binary_data_file_1.get_samples_number() == 0, LOG);
+    assert_true(binary_data_file_1.get_variables_number() == 0, LOG);
+
+    // File constructor
+
+    Tensor<type, 2> data(2, 3);
+    data.setRandom();
+
+    BinaryDataFile::write(file_name, "metadata", data);
+
+    BinaryDataFile binary_data_file_2(file_name);
+
+    assert_true(binary_data_file_2.get_file_name() == file_name, LOG);
+    assert_true(binary_data_file_2.get_version() == 1, LOG);
+    assert_true(binary_data_file_2.get_samples_number() == 2, LOG);
+    assert_true(binary_data_file_2.get_variables_number() == 3, LOG);
+
+    // Missing file
+
+    bool has_thrown = false;
+
+    try
+    {
+        BinaryDataFile binary_data_file_3(file_name + ".missing");
+    }
+    catch(const invalid_argument&)
+    {
+        has_thrown = true;
+    }
+
+    assert_true(has_thrown, LOG);
+}
+
+
+void BinaryDataFileTest::test_write()
+{
+    cout << "test_write\n";
+
+    Tensor<type, 2> data;
+
+    // Test
+
+    data.resize(37, 5);
+    data.setRandom();
+
+    const string metadata = "<Columns>5</Columns>";
+
+    BinaryDataFile::write(file_name, metadata, data);
+
+    BinaryDataFile binary_data_file(file_name);
+
+    assert_true(binary_data_file.get_metadata() == metadata, LOG);
+    assert_true(binary_data_file.get_samples_number() == 37, LOG);
+    assert_true(binary_data_file.get_variables_number() == 5, LOG);
+    assert_true(binary_data_file.get_block_size() >= 37, LOG);
+    assert_true((binary_data_file.get_block_size()*Index(sizeof(type))) % 64 == 0, LOG);
+
+    for(Index j = 0; j < data.dimension(1); j++)
+    {
+        const TensorMap<const Tensor<type, 1>> variable = binary_data_file.get_variable(j);
+
+        assert_true(reinterpret_cast<uintptr_t>(variable.data()) % 64 == 0, LOG);
+
+        for(Index i = 0; i < data.dimension(0); i++)
+        {
+            assert_true(variable(i) == data(i, j), LOG);
+            assert_true(binary_data_file.get_blocks()(i, j) == data(i, j), LOG);
+        }
+    }
+
+    // Test
+
+    data.resize(0, 3);
+
+    BinaryDataFile::write(file_name, string(), data);
+
+    binary_data_file.set(file_name);
+
+    assert_true(binary_data_file.get_metadata().empty(), LOG);
+    assert_true(binary_data_file.get_samples_number() == 0, LOG);
+    assert_true(binary_data_file.get_variables_number() == 3, LOG);
+}
+
+
+void BinaryDataFileTest::test_is_binary_data_file()
+{
+    cout << "test_is_binary_data_file\n";
+
+    Tensor<type, 2> data(3, 2);
+    data.setRandom();
+
+    // Test
+
+    BinaryDataFile::write(file_name, string(), data);
+
+    assert_true(BinaryDataFile::is_binary_data_file(file_name), LOG);
+
+    // Previous format
+
+    ofstream file(file_name, ios::binary);
+
+    const Index columns_number = 2;
+    const Index rows_number = 3;
+
+    file.write(reinterpret_cast<const char*>(&columns_number), sizeof(Index));
+    file.write(reinterpret_cast<const char*>(&rows_number), sizeof(Index));
+    file.write(reinterpret_cast<const char*>(data.data()), streamsize(data.size()*Index(sizeof(type))));
+    file.close();
+
+    assert_true(!BinaryDataFile::is_binary_data_file(file_name), LOG);
+
+    bool has_thrown = false;
+
+    try
+    {
+        BinaryDataFile binary_data_file(file_name);
+    }
+    catch(const invalid_argument&)
+    {
+        has_thrown = true;
+    }
+
+    assert_true(has_thrown, LOG);
+
+    // Truncated file
+
+    BinaryDataFile::write(file_name, string(), data);
+
+    filesystem::resize_file(file_name, filesystem::file_size(file_name) - 4);
+
+    has_thrown = false;
+
+    try
+    {
+        BinaryDataFile binary_data_file(file_name);
+    }
+    catch(const invalid_argument&)
+    {
+        has_thrown = true;
+    }
+
+    assert_true(has_thrown, LOG);
+}
+
+
+void BinaryDataFileTest::run_test_case()
+{
+    cout << "Running binary data file test case...\n";
+
+    // Constructor and destructor methods
+
+    test_constructor();
+
+    // Serialization methods
+
+    test_write();
+
+    test_is_binary_data_file();
+
+    cout << "End of binary data file test case.\n\n";
+}
+
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -0,0 +1,63 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   B I N A R Y   D A T A   F I L E   T E S T   C L A S S   H E A D E R
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#ifndef BINARYDATAFILETEST_H
+#define BINARYDATAFILETEST_H
+
+// Unit testing includes
+
+#include "../opennn/unit_testing.h"
+
+class BinaryDataFileTest : public UnitTesting
+{
+
+public:
+
+   explicit BinaryDataFileTest();
+
+   virtual ~BinaryDataFileTest();
+
+   // Constructor and destructor methods
+
+   void test_constructor();
+
+   // Serialization methods
+
+   void test_write();
+
+   void test_is_binary_data_file();
+
+   // Unit testing methods
+
+   void run_test_case();
+
+private:
+
+   string file_name;
+
+};
+
+#endif
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -1141,6 +1141,219 @@ void ConvolutionalLayerTest::test_memcpy_approach()
     }
 }
 
+void ConvolutionalLayerTest::test_convolution_backends()
+{
+    cout << "test_convolution_backends\n";
+
+    const Index batch_samples_number = 3;
+
+    Tensor<Index, 1> inputs_dimensions(3);
+    inputs_dimensions.setValues({6, 5, 2});
+
+    Tensor<Index, 1> kernels_dimensions(4);
+    kernels_dimensions.setValues({3, 3, 2, 4});
+
+    ConvolutionalLayer convolutional_layer_1(inputs_dimensions, kernels_dimensions);
+    convolutional_layer_1.set_convolution_type(ConvolutionalLayer::ConvolutionType::Same);
+    convolutional_layer_1.set_activation_function(ConvolutionalLayer::ActivationFunction::HyperbolicTangent);
+    convolutional_layer_1.set_parameters_random();
+
+    kernels_dimensions.setValues({3, 3, 4, 2});
+
+    ConvolutionalLayer convolutional_layer_2(convolutional_layer_1.get_outputs_dimensions(), kernels_dimensions);
+    convolutional_layer_2.set_activation_function(ConvolutionalLayer::ActivationFunction::Logistic);
+    convolutional_layer_2.set_parameters_random();
+
+    Tensor<type, 4> inputs(batch_samples_number, 6, 5, 2);
+    inputs.setRandom();
+
+    Tensor<Index, 1> inputs_tensor_dimensions(4);
+    inputs_tensor_dimensions.setValues({batch_samples_number, 6, 5, 2});
+
+    Tensor<DynamicTensor<type>, 1> inputs_pair(1);
+    inputs_pair(0) = DynamicTensor<type>(inputs.data(), inputs_tensor_dimensions);
+
+    // Reference convolutions
+
+    const Tensor<type, 4> padded_inputs = inputs.pad(convolutional_layer_1.get_paddings());
+
+    const Eigen::array<ptrdiff_t, 3> convolution_dimensions = {1, 2, 3};
+
+    Tensor<type, 4> reference_outputs(batch_samples_number, 6, 5, 4);
+
+    for(Index kernel_index = 0; kernel_index < 4; kernel_index++)
+    {
+        const Tensor<type, 3> kernel = convolutional_layer_1.get_synaptic_weights().chip(kernel_index, 3);
+
+        const Tensor<type, 4> convolution = padded_inputs.convolve(kernel, convolution_dimensions);
+
+        reference_outputs.chip(kernel_index, 3)
+                = (convolution.chip(0, 3) + convolutional_layer_1.get_biases()(kernel_index)).tanh();
+    }
+
+    Tensor<type, 4> next_deltas(batch_samples_number, 4, 3, 2);
+    next_deltas.setRandom();
+
+    Tensor<type, 4> first_outputs;
+    Tensor<type, 4> first_deltas;
+    Tensor<type, 4> first_synaptic_weights_derivatives;
+    Tensor<type, 1> first_biases_derivatives;
+
+    const vector<ConvolutionEngine::Backend> backends = {ConvolutionEngine::Backend::Im2col,
+                                                         ConvolutionEngine::Backend::Winograd,
+                                                         ConvolutionEngine::Backend::Direct,
+                                                         ConvolutionEngine::Backend::Automatic};
+
+    for(const ConvolutionEngine::Backend& backend : backends)
+    {
+        convolutional_layer_1.set_convolution_backend(backend);
+        convolutional_layer_2.set_convolution_backend(backend);
+
+        ConvolutionalLayerForwardPropagation forward_propagation_1(batch_samples_number, &convolutional_layer_1);
+        ConvolutionalLayerForwardPropagation forward_propagation_2(batch_samples_number, &convolutional_layer_2);
+
+        ConvolutionalLayerBackPropagation back_propagation_1(batch_samples_number, &convolutional_layer_1);
+        ConvolutionalLayerBackPropagation back_propagation_2(batch_samples_number, &convolutional_layer_2);
+
+        convolutional_layer_1.forward_propagate(inputs_pair, &forward_propagation_1, true);
+
+        Tensor<DynamicTensor<type>, 1> hidden_inputs_pair(1);
+        hidden_inputs_pair(0) = forward_propagation_1.outputs(0);
+
+        convolutional_layer_2.forward_propagate(hidden_inputs_pair, &forward_propagation_2, true);
+
+        copy(next_deltas.data(), next_deltas.data() + next_deltas.size(), back_propagation_2.deltas_data);
+
+        convolutional_layer_1.calculate_hidden_delta(&forward_propagation_2, &back_propagation_2, &back_propagation_1);
+
+        convolutional_layer_1.calculate_error_gradient(inputs.data(), &forward_propagation_1, &back_propagation_1);
+
+        const Tensor<type, 4> outputs = forward_propagation_1.get_outputs();
+
+        const Tensor<type, 4> deltas = TensorMap<Tensor<type, 4>>(back_propagation_1.deltas_data,
+                                                                  back_propagation_1.get_deltas_dimensions_array());
+
+        Tensor<type, 0> maximum_difference = (outputs - reference_outputs).abs().maximum();
+
+        assert_true(maximum_difference() < type(1.0e-5), LOG);
+
+        if(backend == ConvolutionEngine::Backend::Im2col)
+        {
+            first_outputs = outputs;
+            first_deltas = deltas;
+            first_synaptic_weights_derivatives = back_propagation_1.synaptic_weights_derivatives;
+            first_biases_derivatives = back_propagation_1.biases_derivatives;
+
+            continue;
+        }
+
+        maximum_difference = (outputs - first_outputs).abs().maximum();
+        assert_true(maximum_difference() < type(1.0e-5), LOG);
+
+        maximum_difference = (deltas - first_deltas).abs().maximum();
+        assert_true(maximum_difference() < type(1.0e-5), LOG);
+
+        maximum_difference = (back_propagation_1.synaptic_weights_derivatives - first_synaptic_weights_derivatives).abs().maximum();
+        assert_true(maximum_difference() < type(1.0e-4), LOG);
+
+        maximum_difference = (back_propagation_1.biases_derivatives - first_biases_derivatives).abs().maximum();
+        assert_true(maximum_difference() < type(1.0e-4), LOG);
+    }
+
+    // Gradient of both layers against numerical differentiation, with a second layer of unit strides and of stride 2.
+    // The error is the sum of the outputs of the second layer weighted by their deltas.
+
+    for(const Index& stride : {1, 2})
+    {
+        convolutional_layer_2.set_row_stride(stride);
+        convolutional_layer_2.set_column_stride(stride);
+
+        const Tensor<Index, 1> outputs_dimensions = convolutional_layer_2.get_outputs_dimensions();
+
+        Tensor<type, 4> outputs_deltas(batch_samples_number, outputs_dimensions(0), outputs_dimensions(1), outputs_dimensions(2));
+        outputs_deltas.setRandom();
+
+        for(const ConvolutionEngine::Backend& backend : backends)
+        {
+            // Winograd only computes 3x3 convolutions with unit strides
+
+            if(stride != 1 && backend == ConvolutionEngine::Backend::Winograd) continue;
+
+            convolutional_layer_1.set_convolution_backend(backend);
+            convolutional_layer_2.set_convolution_backend(backend);
+
+            ConvolutionalLayerForwardPropagation forward_propagation_1(batch_samples_number, &convolutional_layer_1);
+            ConvolutionalLayerForwardPropagation forward_propagation_2(batch_samples_number, &convolutional_layer_2);
+
+            ConvolutionalLayerBackPropagation back_propagation_1(batch_samples_number, &convolutional_layer_1);
+            ConvolutionalLayerBackPropagation back_propagation_2(batch_samples_number, &convolutional_layer_2);
+
+            const auto calculate_error = [&]() -> type
+            {
+                convolutional_layer_1.forward_propagate(inputs_pair, &forward_propagation_1, true);
+
+                Tensor<DynamicTensor<type>, 1> hidden_inputs_pair(1);
+                hidden_inputs_pair(0) = forward_propagation_1.outputs(0);
+
+                convolutional_layer_2.forward_propagate(hidden_inputs_pair, &forward_propagation_2, true);
+
+                const Tensor<type, 0> error = (forward_propagation_2.get_outputs()*outputs_deltas).sum();
+
+                return error(0);
+            };
+
+            const auto calculate_numerical_gradient = [&](ConvolutionalLayer& convolutional_layer) -> Tensor<type, 1>
+            {
+                const type h = type(1.0e-2);
+
+                Tensor<type, 1> parameters = convolutional_layer.get_parameters();
+
+                Tensor<type, 1> numerical_gradient(parameters.size());
+
+                for(Index i = 0; i < parameters.size(); i++)
+                {
+                    const type parameter = parameters(i);
+
+                    parameters(i) = parameter + h;
+                    convolutional_layer.set_parameters(parameters, 0);
+                    const type error_forward = calculate_error();
+
+                    parameters(i) = parameter - h;
+                    convolutional_layer.set_parameters(parameters, 0);
+                    const type error_backward = calculate_error();
+
+                    parameters(i) = parameter;
+
+                    numerical_gradient(i) = (error_forward - error_backward)/(type(2)*h);
+                }
+
+                convolutional_layer.set_parameters(parameters, 0);
+
+                return numerical_gradient;
+            };
+
+            calculate_error();
+
+            copy(outputs_deltas.data(), outputs_deltas.data() + outputs_deltas.size(), back_propagation_2.deltas_data);
+
+            convolutional_layer_1.calculate_hidden_delta(&forward_propagation_2, &back_propagation_2, &back_propagation_1);
+
+            convolutional_layer_2.calculate_error_gradient(forward_propagation_1.outputs(0).get_data(), &forward_propagation_2, &back_propagation_2);
+            convolutional_layer_1.calculate_error_gradient(inputs.data(), &forward_propagation_1, &back_propagation_1);
+
+            Tensor<type, 1> gradient_1(convolutional_layer_1.get_parameters_number());
+            Tensor<type, 1> gradient_2(convolutional_layer_2.get_parameters_number());
+
+            convolutional_layer_1.insert_gradient(&back_propagation_1, 0, gradient_1);
+            convolutional_layer_2.insert_gradient(&back_propagation_2, 0, gradient_2);
+
+            assert_true(are_equal(gradient_2, calculate_numerical_gradient(convolutional_layer_2), type(1.0e-2)), LOG);
+            assert_true(are_equal(gradient_1, calculate_numerical_gradient(convolutional_layer_1), type(1.0e-2)), LOG);
+        }
+    }
+}
+
+
 void ConvolutionalLayerTest::run_test_case()
 {
    cout << "Running convolutional layer test case...\n";
@@ -1184,6 +1397,10 @@ void ConvolutionalLayerTest::run_test_case()
 
    test_calculate_hidden_delta_perceptron_test();
 
+   // Convolution backends
+
+   test_convolution_backends();
+
    //Utils
    test_memcpy_approach();
 
@@ -65,6 +65,10 @@ public:
 
   void test_calculate_hidden_delta_perceptron_test();
 
+  // Convolution backends
+
+  void test_convolution_backends();
+
   // Utils
 
   void test_memcpy_approach();
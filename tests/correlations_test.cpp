@@ -178,10 +178,6 @@ void CorrelationsTest::test_logistic_correlation()
         y[i] = exp(static_cast<type>(2.5)*x[i] + static_cast<type>(1.4));
     }
 
-    const int n = omp_get_max_threads();
-    ThreadPool* thread_pool = new ThreadPool(n);
-    ThreadPoolDevice* thread_pool_device = new ThreadPoolDevice(thread_pool, n);
-
     // Test
 
     for(Index i = 0; i < size/2; i++) y[i] = 1.0;
@@ -0,0 +1,234 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   C S V   R E A D E R   T E S T   C L A S S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "csv_reader_test.h"
+
+
+CsvReaderTest::CsvReaderTest() : UnitTesting()
+{
+    file_name = (filesystem::temp_directory_path()/"opennn_csv_reader_test.csv").string();
+}
+
+
+CsvReaderTest::~CsvReaderTest()
+{
+    filesystem::remove(file_name);
+}
+
+
+/// Returns a token over the characters of a string.
+
+CsvReader::Token get_token(const string& text)
+{
+    return {text.data(), text.data() + text.size()};
+}
+
+
+void CsvReaderTest::test_constructor()
+{
+    cout << "test_constructor\n";
+
+    ofstream file(file_name);
+    file << "x,y\n\n1,2\n3,4";
+    file.close();
+
+    CsvReader csv_reader_1(file_name, ',', true);
+
+    assert_true(csv_reader_1.get_file_size() == 12, LOG);
+    assert_true(csv_reader_1.get_chunks_number() == 1, LOG);
+
+    // Missing file
+
+    bool has_thrown = false;
+
+    try
+    {
+        CsvReader csv_reader_2(file_name + ".missing", ',', false);
+    }
+    catch(const invalid_argument&)
+    {
+        has_thrown = true;
+    }
+
+    assert_true(has_thrown, LOG);
+}
+
+
+void CsvReaderTest::test_split_tokens()
+{
+    cout << "test_split_tokens\n";
+
+    vector<CsvReader::Token> tokens;
+
+    // Test
+
+    string line = "1, 2 ,\tred";
+
+    assert_true(CsvReader::split_tokens(get_token(line), ',', tokens), LOG);
+    assert_true(tokens.size() == 3, LOG);
+    assert_true(tokens[0] == "1", LOG);
+    assert_true(tokens[1] == "2", LOG);
+    assert_true(tokens[2] == "red", LOG);
+
+    // Test
+
+    line = "1;2;3";
+
+    assert_true(CsvReader::split_tokens(get_token(line), ';', tokens), LOG);
+    assert_true(tokens.size() == 3, LOG);
+
+    // Lines for the general tokenizer
+
+    line = "1,,3";
+    assert_true(!CsvReader::split_tokens(get_token(line), ',', tokens), LOG);
+
+    line = ",2,3";
+    assert_true(!CsvReader::split_tokens(get_token(line), ',', tokens), LOG);
+
+    line = "1,2,";
+    assert_true(!CsvReader::split_tokens(get_token(line), ',', tokens), LOG);
+
+    line = "1,\"a,b\",3";
+    assert_true(!CsvReader::split_tokens(get_token(line), ',', tokens), LOG);
+}
+
+
+void CsvReaderTest::test_parse_number()
+{
+    cout << "test_parse_number\n";
+
+    type value = type(0);
+
+    const vector<string> numbers = {"0", "-0", "7", "+7", "-12.5", ".25", "5.", "0.000123", "1e3", "-2.5E-4", "3.14159265",
+                                    "123456789012345678901234", "1e-30", "0.1234567890123456789"};
+
+    for(const string& number : numbers)
+    {
+        assert_true(CsvReader::parse_number(get_token(number), value), LOG);
+        assert_true(abs(value - type(strtod(number.c_str(), nullptr))) <= type(1.0e-6)*max(type(1), abs(value)), LOG);
+    }
+
+    const vector<string> not_numbers = {"", "-", ".", "e5", "1e", "1e+", "12%", "1.2.3", "abc", "NA", "1 2"};
+
+    for(const string& not_number : not_numbers)
+    {
+        assert_true(!CsvReader::parse_number(get_token(not_number), value), LOG);
+    }
+}
+
+
+void CsvReaderTest::test_read_lines()
+{
+    cout << "test_read_lines\n";
+
+    const Index samples_number = 1000;
+
+    ofstream file(file_name);
+
+    file << "index,value\r\n";
+
+    for(Index i = 0; i < samples_number; i++)
+    {
+        file << i << "," << 2*i << "\r\n";
+
+        if(i%7 == 0) file << "  \r\n";
+    }
+
+    file.close();
+
+    csv_reader.set(file_name, ',', true);
+
+    for(const Index chunks_number : {Index(1), Index(3), Index(16)})
+    {
+        csv_reader.set_chunks_number(chunks_number);
+
+        csv_reader.count_samples();
+
+        assert_true(csv_reader.get_chunks_number() == chunks_number, LOG);
+        assert_true(csv_reader.get_samples_number() == samples_number, LOG);
+
+        Tensor<Index, 1> line_numbers(samples_number);
+        line_numbers.setConstant(-1);
+
+        Tensor<bool, 1> are_valid(samples_number);
+        are_valid.setConstant(false);
+
+        vector<Index> chunks_samples_indices(static_cast<size_t>(chunks_number));
+
+        for(Index i = 0; i < chunks_number; i++)
+            chunks_samples_indices[size_t(i)] = csv_reader.get_chunk_samples_begin(i);
+
+        csv_reader.read_lines([&](const Index& chunk_index, const Index& line_number, const CsvReader::Token& line)
+        {
+            vector<CsvReader::Token> tokens;
+
+            type index = type(-1);
+            type value = type(-1);
+
+            const Index sample_index = chunks_samples_indices[size_t(chunk_index)]++;
+
+            are_valid(sample_index) = CsvReader::split_tokens(line, ',', tokens)
+                    && CsvReader::parse_number(tokens[0], index)
+                    && CsvReader::parse_number(tokens[1], value)
+                    && Index(index) == sample_index
+                    && Index(value) == 2*sample_index;
+
+            line_numbers(sample_index) = line_number;
+        });
+
+        assert_true(count(are_valid.data(), are_valid.data() + samples_number, true) == samples_number, LOG);
+
+        // The header is line one, and an empty line follows every seventh sample
+
+        assert_true(line_numbers(0) == 2, LOG);
+        assert_true(line_numbers(1) == 4, LOG);
+        assert_true(line_numbers(samples_number - 1) == 1 + samples_number + (samples_number + 6)/7, LOG);
+
+        assert_true(csv_reader.get_last_line() == "999,1998", LOG);
+    }
+}
+
+
+void CsvReaderTest::run_test_case()
+{
+    cout << "Running csv reader test case...\n";
+
+    // Constructor and destructor methods
+
+    test_constructor();
+
+    // Tokens methods
+
+    test_split_tokens();
+
+    test_parse_number();
+
+    // Reading methods
+
+    test_read_lines();
+
+    cout << "End of csv reader test case.\n\n";
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
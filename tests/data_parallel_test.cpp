@@ -0,0 +1,317 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   D A T A   P A R A L L E L   T E S T   C L A S S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "data_parallel_test.h"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+
+
+DataParallelTest::DataParallelTest() : UnitTesting()
+{
+    const string suffix = to_string(chrono::steady_clock::now().time_since_epoch().count()%1000000);
+
+    address = (filesystem::temp_directory_path()/("opennn_data_parallel_test_" + suffix)).string();
+}
+
+
+DataParallelTest::~DataParallelTest()
+{
+}
+
+
+/// Runs a function in a thread for each rank of a ring connected with Unix sockets,
+/// and returns the vectors written by the ranks.
+/// The vectors of the ranks which throw an exception are left empty.
+
+Tensor<Tensor<type, 1>, 1> DataParallelTest::run_ranks(const Index& ranks_number,
+                                                       const function<void(Communicator&, Tensor<type, 1>&)>& rank_function)
+{
+    Tensor<Tensor<type, 1>, 1> ranks_vectors(ranks_number);
+
+    vector<thread> ranks_threads;
+
+    for(Index rank = 0; rank < ranks_number; rank++)
+    {
+        ranks_threads.emplace_back([&, rank]()
+        {
+            try
+            {
+                SocketTransport transport(rank, ranks_number, SocketTransport::Family::Unix, address, type(10));
+
+                Communicator communicator(&transport);
+
+                rank_function(communicator, ranks_vectors(rank));
+            }
+            catch(const exception& e)
+            {
+                cerr << e.what() << endl;
+
+                ranks_vectors(rank).resize(0);
+            }
+        });
+    }
+
+    for(thread& rank_thread : ranks_threads) rank_thread.join();
+
+    return ranks_vectors;
+}
+
+
+void DataParallelTest::test_constructor()
+{
+    cout << "test_constructor\n";
+
+    // Single rank
+
+    SocketTransport transport(0, 1, SocketTransport::Family::Unix, address);
+
+    assert_true(transport.get_rank() == 0, LOG);
+    assert_true(transport.get_ranks_number() == 1, LOG);
+    assert_true(transport.get_next_rank() == 0, LOG);
+    assert_true(transport.get_previous_rank() == 0, LOG);
+
+    Communicator communicator(&transport);
+
+    assert_true(communicator.get_transport_pointer() == &transport, LOG);
+    assert_true(communicator.get_ranks_number() == 1, LOG);
+
+    // Wrong rank
+
+    bool has_thrown = false;
+
+    try
+    {
+        SocketTransport wrong_transport(2, 2, SocketTransport::Family::Unix, address);
+    }
+    catch(const exception&)
+    {
+        has_thrown = true;
+    }
+
+    assert_true(has_thrown, LOG);
+}
+
+
+void DataParallelTest::test_get_shard()
+{
+    cout << "test_get_shard\n";
+
+    Tensor<Index, 1> samples_indices(10);
+    samples_indices.setValues({9, 8, 7, 6, 5, 4, 3, 2, 1, 0});
+
+    // Single rank
+
+    SocketTransport transport(0, 1, SocketTransport::Family::Unix, address);
+
+    Communicator communicator(&transport);
+
+    Tensor<Index, 1> shard = communicator.get_shard(samples_indices);
+
+    assert_true(shard.size() == 10, LOG);
+    assert_true(shard(0) == 9, LOG);
+
+    // Three ranks
+
+    const Tensor<Tensor<type, 1>, 1> ranks_shards = run_ranks(3, [&](Communicator& rank_communicator, Tensor<type, 1>& rank_shard)
+    {
+        const Tensor<Index, 1> rank_indices = rank_communicator.get_shard(samples_indices);
+
+        rank_shard = rank_indices.cast<type>();
+    });
+
+    assert_true(ranks_shards(0).size() == 3, LOG);
+    assert_true(ranks_shards(1).size() == 3, LOG);
+    assert_true(ranks_shards(2).size() == 3, LOG);
+
+    assert_true(ranks_shards(0)(0) == type(9), LOG);
+    assert_true(ranks_shards(1)(0) == type(6), LOG);
+    assert_true(ranks_shards(2)(2) == type(1), LOG);
+}
+
+
+void DataParallelTest::test_all_reduce_sum()
+{
+    cout << "test_all_reduce_sum\n";
+
+    for(const Index& ranks_number : {2, 3, 4})
+    {
+        // The size is not a multiple of the number of ranks, and one vector is smaller than the ring
+
+        for(const Index& size : {Index(3), Index(1001)})
+        {
+            const Tensor<Tensor<type, 1>, 1> ranks_sums = run_ranks(ranks_number, [&](Communicator& communicator, Tensor<type, 1>& sum)
+            {
+                sum.resize(size);
+
+                for(Index i = 0; i < size; i++)
+                    sum(i) = type(0.1)*type(communicator.get_rank() + 1) + type(i)/type(size);
+
+                communicator.all_reduce_sum(sum);
+            });
+
+            bool is_sum = true;
+            bool is_identical = true;
+
+            for(Index rank = 0; rank < ranks_number; rank++)
+            {
+                if(ranks_sums(rank).size() != size)
+                {
+                    is_sum = false;
+
+                    continue;
+                }
+
+                for(Index i = 0; i < size; i++)
+                {
+                    const type expected_sum = type(0.05)*type(ranks_number*(ranks_number + 1)) + type(ranks_number*i)/type(size);
+
+                    if(abs(ranks_sums(rank)(i) - expected_sum) > type(1.0e-4)) is_sum = false;
+                }
+
+                if(memcmp(ranks_sums(rank).data(), ranks_sums(0).data(), size_t(size)*sizeof(type)) != 0) is_identical = false;
+            }
+
+            assert_true(is_sum, LOG);
+            assert_true(is_identical, LOG);
+        }
+    }
+}
+
+
+void DataParallelTest::test_broadcast()
+{
+    cout << "test_broadcast\n";
+
+    const Tensor<Tensor<type, 1>, 1> ranks_vectors = run_ranks(3, [&](Communicator& communicator, Tensor<type, 1>& vector)
+    {
+        vector.resize(5);
+        vector.setConstant(type(communicator.get_rank() + 1));
+
+        communicator.broadcast(vector);
+    });
+
+    for(Index rank = 0; rank < 3; rank++)
+    {
+        assert_true(ranks_vectors(rank).size() == 5, LOG);
+        assert_true(ranks_vectors(rank)(4) == type(1), LOG);
+    }
+}
+
+
+void DataParallelTest::test_perform_training()
+{
+    cout << "test_perform_training\n";
+
+    const Index samples_number = 40;
+    const Index inputs_number = 3;
+    const Index neurons_number = 4;
+    const Index outputs_number = 2;
+
+    Tensor<type, 2> data(samples_number, inputs_number + outputs_number);
+    data.setRandom();
+
+    for(const string& optimization_method : {"ADAPTIVE_MOMENT_ESTIMATION", "STOCHASTIC_GRADIENT_DESCENT"})
+    {
+        // Each rank starts from different parameters, which are replaced by the ones of the first rank
+
+        const Tensor<Tensor<type, 1>, 1> ranks_parameters = run_ranks(2, [&](Communicator& communicator, Tensor<type, 1>& parameters)
+        {
+            DataSet data_set;
+            data_set.set(samples_number, inputs_number, outputs_number);
+            *data_set.get_data_pointer() = data;
+            data_set.set_training();
+
+            NeuralNetwork neural_network(NeuralNetwork::ProjectType::Approximation, {inputs_number, neurons_number, outputs_number});
+            neural_network.set_parameters_constant(type(0.1)*type(communicator.get_rank() + 1));
+
+            MeanSquaredError mean_squared_error(&neural_network, &data_set);
+
+            if(optimization_method == "ADAPTIVE_MOMENT_ESTIMATION")
+            {
+                AdaptiveMomentEstimation adaptive_moment_estimation(&mean_squared_error);
+
+                adaptive_moment_estimation.set_communicator_pointer(&communicator);
+                adaptive_moment_estimation.set_batch_samples_number(10);
+                adaptive_moment_estimation.set_maximum_epochs_number(5);
+                adaptive_moment_estimation.set_display(false);
+
+                adaptive_moment_estimation.perform_training();
+            }
+            else
+            {
+                StochasticGradientDescent stochastic_gradient_descent(&mean_squared_error);
+
+                stochastic_gradient_descent.set_communicator_pointer(&communicator);
+                stochastic_gradient_descent.set_batch_samples_number(10);
+                stochastic_gradient_descent.set_momentum(type(0.9));
+                stochastic_gradient_descent.set_maximum_epochs_number(5);
+                stochastic_gradient_descent.set_display(false);
+
+                stochastic_gradient_descent.perform_training();
+            }
+
+            parameters = neural_network.get_parameters();
+        });
+
+        assert_true(ranks_parameters(0).size() == ranks_parameters(1).size(), LOG);
+        assert_true(ranks_parameters(0).size() != 0, LOG);
+
+        // The parameters are bit-identical and have been trained
+
+        assert_true(memcmp(ranks_parameters(0).data(), ranks_parameters(1).data(), size_t(ranks_parameters(0).size())*sizeof(type)) == 0, LOG);
+
+        assert_true(ranks_parameters(0)(0) != type(0.1), LOG);
+    }
+}
+
+
+void DataParallelTest::run_test_case()
+{
+    cout << "Running data parallel test case...\n";
+
+    // Constructor and destructor methods
+
+    test_constructor();
+
+    // Get methods
+
+    test_get_shard();
+
+    // Collective methods
+
+    test_all_reduce_sum();
+
+    test_broadcast();
+
+    // Training methods
+
+    test_perform_training();
+
+    cout << "End of data parallel test case.\n\n";
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -1271,6 +1271,257 @@ void DataSetTest::test_has_time_columns()
 }
 
 
+void DataSetTest::test_save_data_binary()
+{
+    cout << "test_save_data_binary\n";
+
+    const string data_file_name = "../data/test";
+
+    // Test
+
+    data.resize(5, 4);
+    data.setValues({{type(0), type(1), type(0), type(10)},
+                    {type(1), type(0), type(1), type(20)},
+                    {type(2), type(0), type(0), type(30)},
+                    {type(3), type(1), type(0), type(40)},
+                    {type(4), type(0), type(1), type(50)}});
+
+    data_set.set_data(data);
+
+    Tensor<DataSet::Column, 1> columns(3);
+
+    columns(0) = DataSet::Column("x", DataSet::VariableUse::Input, DataSet::ColumnType::Numeric, Scaler::MinimumMaximum);
+
+    Tensor<string, 1> categories(2);
+    categories.setValues({"a", "b"});
+
+    Tensor<DataSet::VariableUse, 1> categories_uses(2);
+    categories_uses.setConstant(DataSet::VariableUse::Input);
+
+    columns(1) = DataSet::Column("category", DataSet::VariableUse::Input, DataSet::ColumnType::Categorical,
+                                 Scaler::NoScaling, categories, categories_uses);
+
+    columns(2) = DataSet::Column("y", DataSet::VariableUse::Target, DataSet::ColumnType::Numeric, Scaler::Logarithm);
+
+    data_set.set_columns(columns);
+
+    data_set.save_data_binary(data_file_name);
+
+    DataSet loaded_data_set;
+
+    loaded_data_set.set_data_file_name(data_file_name);
+    loaded_data_set.load_data_binary();
+
+    const Tensor<type, 2>& loaded_data = loaded_data_set.get_data();
+
+    assert_true(loaded_data.dimension(0) == 5, LOG);
+    assert_true(loaded_data.dimension(1) == 4, LOG);
+    const Tensor<type, 0> maximum_difference = (loaded_data - data).abs().maximum();
+
+    assert_true(maximum_difference(0) < type(NUMERIC_LIMITS_MIN), LOG);
+
+    assert_true(loaded_data_set.get_columns_number() == 3, LOG);
+    assert_true(loaded_data_set.get_columns()(0).name == "x", LOG);
+    assert_true(loaded_data_set.get_columns()(0).scaler == Scaler::MinimumMaximum, LOG);
+    assert_true(loaded_data_set.get_columns()(1).type == DataSet::ColumnType::Categorical, LOG);
+    assert_true(loaded_data_set.get_columns()(1).categories(1) == "b", LOG);
+    assert_true(loaded_data_set.get_columns()(2).column_use == DataSet::VariableUse::Target, LOG);
+    assert_true(loaded_data_set.get_columns()(2).scaler == Scaler::Logarithm, LOG);
+    assert_true(loaded_data_set.get_samples_number() == 5, LOG);
+
+    // Test
+
+    DataSet mapped_data_set;
+
+    mapped_data_set.set_data_file_name(data_file_name);
+    mapped_data_set.set_map_binary_data(true);
+    mapped_data_set.load_data_binary();
+
+    assert_true(mapped_data_set.has_data_shards(), LOG);
+    assert_true(mapped_data_set.get_data().size() == 0, LOG);
+    assert_true(mapped_data_set.get_samples_number() == 5, LOG);
+    assert_true(mapped_data_set.get_columns_number() == 3, LOG);
+
+    for(Index i = 0; i < data.dimension(0); i++)
+        for(Index j = 0; j < data.dimension(1); j++)
+            assert_true(mapped_data_set.get_data_shards().get_value(i, j) == data(i, j), LOG);
+}
+
+
+void DataSetTest::test_save_data_shards()
+{
+    cout << "test_save_data_shards\n";
+
+    // Test
+
+    data.resize(20, 3);
+    data.setRandom();
+
+    data_set.set_data(data);
+    data_set.set_training();
+
+    Tensor<Scaler, 1> columns_scalers(3);
+    columns_scalers.setValues({Scaler::MeanStandardDeviation, Scaler::MinimumMaximum, Scaler::StandardDeviation});
+
+    data_set.set_columns_scalers(columns_scalers);
+
+    const Tensor<string, 1> file_names = data_set.save_data_shards("../data/test_shards", 6);
+
+    assert_true(file_names.size() == 4, LOG);
+
+    DataSet shards_data_set;
+
+    shards_data_set.set_data_shards(file_names);
+    shards_data_set.set_training();
+
+    assert_true(shards_data_set.has_data_shards(), LOG);
+    assert_true(shards_data_set.get_samples_number() == 20, LOG);
+    assert_true(shards_data_set.get_variables_number() == 3, LOG);
+    assert_true(shards_data_set.get_input_variables_number() == 2, LOG);
+    assert_true(shards_data_set.get_columns()(1).scaler == Scaler::MinimumMaximum, LOG);
+
+    const Tensor<Index, 1> samples_indices = data_set.get_training_samples_indices();
+    const Tensor<Index, 1> input_variables_indices = data_set.get_input_variables_indices();
+    const Tensor<Index, 1> target_variables_indices = data_set.get_target_variables_indices();
+
+    // Scaled batches
+
+    const Tensor<Descriptives, 1> input_variables_descriptives = data_set.scale_input_variables();
+    const Tensor<Descriptives, 1> target_variables_descriptives = data_set.scale_target_variables();
+
+    const Tensor<Descriptives, 1> shards_input_variables_descriptives = shards_data_set.scale_input_variables();
+    const Tensor<Descriptives, 1> shards_target_variables_descriptives = shards_data_set.scale_target_variables();
+
+    assert_true(abs(shards_input_variables_descriptives(0).mean - input_variables_descriptives(0).mean) < type(1.0e-5), LOG);
+
+    DataSetBatch batch(20, &data_set);
+    DataSetBatch shards_batch(20, &shards_data_set);
+
+    batch.fill(samples_indices, input_variables_indices, target_variables_indices);
+    shards_batch.fill(samples_indices, input_variables_indices, target_variables_indices);
+
+    Tensor<type, 0> maximum_difference
+        = (batch.inputs(0).to_tensor_map<2>() - shards_batch.inputs(0).to_tensor_map<2>()).abs().maximum();
+
+    assert_true(maximum_difference(0) < type(1.0e-5), LOG);
+
+    maximum_difference = (batch.targets.to_tensor_map<2>() - shards_batch.targets.to_tensor_map<2>()).abs().maximum();
+
+    assert_true(maximum_difference(0) < type(1.0e-5), LOG);
+
+    // Unscaled batches
+
+    shards_data_set.unscale_input_variables(shards_input_variables_descriptives);
+    shards_data_set.unscale_target_variables(shards_target_variables_descriptives);
+
+    shards_batch.fill(samples_indices, input_variables_indices, target_variables_indices);
+
+    const TensorMap<Tensor<type, 2>> inputs = shards_batch.inputs(0).to_tensor_map<2>();
+
+    assert_true(inputs(7, 1) == data(samples_indices(7), 1), LOG);
+
+    // Shuffle
+
+    mt19937 random_engine(3);
+
+    Tensor<Index, 1> shuffled_samples_indices = shards_data_set.shuffle_samples_indices(samples_indices, random_engine);
+
+    sort(shuffled_samples_indices.data(), shuffled_samples_indices.data() + shuffled_samples_indices.size());
+
+    assert_true(shuffled_samples_indices(19) == 19, LOG);
+
+    for(Index i = 0; i < file_names.size(); i++)
+    {
+        filesystem::remove(file_names(i));
+    }
+}
+
+
+void DataSetTest::test_batch_scaling()
+{
+    cout << "test_batch_scaling\n";
+
+    data.resize(15, 4);
+    data.setRandom();
+
+    Tensor<Scaler, 1> columns_scalers(4);
+    columns_scalers.setValues({Scaler::MeanStandardDeviation, Scaler::MinimumMaximum, Scaler::Logarithm, Scaler::StandardDeviation});
+
+    DataSet scaled_data_set;
+
+    scaled_data_set.set_data(data);
+    scaled_data_set.set_training();
+    scaled_data_set.set_columns_scalers(columns_scalers);
+
+    data_set.set_data(data);
+    data_set.set_training();
+    data_set.set_columns_scalers(columns_scalers);
+    data_set.set_batch_scaling(true);
+
+    assert_true(data_set.get_batch_scaling(), LOG);
+    assert_true(data_set.is_batch_scaling(), LOG);
+
+    const Tensor<Index, 1> samples_indices = data_set.get_training_samples_indices();
+    const Tensor<Index, 1> input_variables_indices = data_set.get_input_variables_indices();
+    const Tensor<Index, 1> target_variables_indices = data_set.get_target_variables_indices();
+
+    DataSetBatch scaled_batch(15, &scaled_data_set);
+    DataSetBatch batch(15, &data_set);
+
+    // Test
+
+    scaled_data_set.scale_input_variables();
+    scaled_data_set.scale_target_variables();
+
+    const Tensor<Descriptives, 1> input_variables_descriptives = data_set.scale_input_variables();
+    const Tensor<Descriptives, 1> target_variables_descriptives = data_set.scale_target_variables();
+
+    Tensor<type, 0> maximum_difference = (data_set.get_data() - data).abs().maximum();
+
+    assert_true(maximum_difference(0) == type(0), LOG);
+
+    scaled_batch.fill(samples_indices, input_variables_indices, target_variables_indices);
+    batch.fill(samples_indices, input_variables_indices, target_variables_indices);
+
+    maximum_difference = (batch.inputs(0).to_tensor_map<2>() - scaled_batch.inputs(0).to_tensor_map<2>()).abs().maximum();
+
+    assert_true(maximum_difference(0) < type(1.0e-5), LOG);
+
+    maximum_difference = (batch.targets.to_tensor_map<2>() - scaled_batch.targets.to_tensor_map<2>()).abs().maximum();
+
+    assert_true(maximum_difference(0) < type(1.0e-5), LOG);
+
+    // Test
+
+    data_set.set_use_training_cache(true);
+    data_set.update_training_cache();
+
+    batch.fill(samples_indices, input_variables_indices, target_variables_indices);
+
+    maximum_difference = (batch.inputs(0).to_tensor_map<2>() - scaled_batch.inputs(0).to_tensor_map<2>()).abs().maximum();
+
+    assert_true(maximum_difference(0) < type(1.0e-5), LOG);
+
+    // Test
+
+    data_set.unscale_input_variables(input_variables_descriptives);
+    data_set.unscale_target_variables(target_variables_descriptives);
+
+    assert_true(!data_set.get_training_cache().is_empty(), LOG);
+
+    batch.fill(samples_indices, input_variables_indices, target_variables_indices);
+
+    const TensorMap<Tensor<type, 2>> inputs = batch.inputs(0).to_tensor_map<2>();
+    const TensorMap<Tensor<type, 2>> targets = batch.targets.to_tensor_map<2>();
+
+    assert_true(inputs(4, 2) == data(samples_indices(4), 2), LOG);
+    assert_true(targets(9, 0) == data(samples_indices(9), 3), LOG);
+
+    data_set.set_batch_scaling(false);
+    data_set.set_use_training_cache(false);
+}
+
+
 void DataSetTest::test_save_time_series_data_binary()
 {
     cout << "test_save_time_series_data_binary\n";
@@ -2442,6 +2693,11 @@ void DataSetTest::run_test_case()
     test_set_lags_number();
     test_set_steps_ahead_number();
     test_set_time_series_data();
+    test_save_data_binary();
+
+    test_save_data_shards();
+
+    test_batch_scaling();
     test_save_time_series_data_binary();
     test_has_time_columns();
 
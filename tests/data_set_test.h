@@ -38,6 +38,11 @@ public:
    void test_set_lags_number();
    void test_set_steps_ahead_number();
    void test_set_time_series_data();
+   void test_save_data_binary();
+
+   void test_save_data_shards();
+
+   void test_batch_scaling();
    void test_save_time_series_data_binary();
 
    // Data methods
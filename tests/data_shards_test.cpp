@@ -0,0 +1,209 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   D A T A   S H A R D S   T E S T   C L A S S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "data_shards_test.h"
+
+
+DataShardsTest::DataShardsTest() : UnitTesting()
+{
+    data.resize(10, 3);
+    data.setRandom();
+
+    const string file_name_prefix = (filesystem::temp_directory_path()/"opennn_data_shards_test").string();
+
+    file_names = DataShards::write(file_name_prefix, "metadata", data, 4);
+}
+
+
+DataShardsTest::~DataShardsTest()
+{
+    for(Index i = 0; i < file_names.size(); i++)
+    {
+        filesystem::remove(file_names(i));
+    }
+}
+
+
+void DataShardsTest::test_constructor()
+{
+    cout << "test_constructor\n";
+
+    // Default constructor
+
+    DataShards data_shards_1;
+
+    assert_true(data_shards_1.get_shards_number() == 0, LOG);
+    assert_true(data_shards_1.get_samples_number() == 0, LOG);
+
+    // File names constructor
+
+    assert_true(file_names.size() == 3, LOG);
+
+    DataShards data_shards_2(file_names);
+
+    assert_true(data_shards_2.get_shards_number() == 3, LOG);
+    assert_true(data_shards_2.get_samples_number() == 10, LOG);
+    assert_true(data_shards_2.get_variables_number() == 3, LOG);
+    assert_true(data_shards_2.get_metadata() == "metadata", LOG);
+
+    assert_true(data_shards_2.get_shard_index(0) == 0, LOG);
+    assert_true(data_shards_2.get_shard_index(3) == 0, LOG);
+    assert_true(data_shards_2.get_shard_index(4) == 1, LOG);
+    assert_true(data_shards_2.get_shard_index(9) == 2, LOG);
+
+    assert_true(data_shards_2.get_value(5, 2) == data(5, 2), LOG);
+    assert_true(data_shards_2.get_value(9, 0) == data(9, 0), LOG);
+
+    // Test
+
+    Tensor<string, 1> missing_file_names(1);
+    missing_file_names(0) = file_names(0) + ".missing";
+
+    bool has_thrown = false;
+
+    try
+    {
+        DataShards data_shards_3(missing_file_names);
+    }
+    catch(const exception&)
+    {
+        has_thrown = true;
+    }
+
+    assert_true(has_thrown, LOG);
+}
+
+
+void DataShardsTest::test_fill_submatrix()
+{
+    cout << "test_fill_submatrix\n";
+
+    DataShards data_shards(file_names);
+
+    Tensor<Index, 1> rows_indices(5);
+    rows_indices.setValues({9, 0, 4, 3, 7});
+
+    Tensor<Index, 1> columns_indices(2);
+    columns_indices.setValues({2, 0});
+
+    Tensor<type, 2> submatrix(5, 2);
+
+    data_shards.fill_submatrix(rows_indices, columns_indices, submatrix.data());
+
+    for(Index i = 0; i < rows_indices.size(); i++)
+    {
+        for(Index j = 0; j < columns_indices.size(); j++)
+        {
+            assert_true(submatrix(i, j) == data(rows_indices(i), columns_indices(j)), LOG);
+        }
+    }
+}
+
+
+void DataShardsTest::test_calculate_descriptives()
+{
+    cout << "test_calculate_descriptives\n";
+
+    DataShards data_shards(file_names);
+
+    Tensor<Index, 1> samples_indices(7);
+    samples_indices.setValues({8, 1, 2, 5, 3, 9, 6});
+
+    Tensor<Index, 1> variables_indices(3);
+    variables_indices.setValues({0, 1, 2});
+
+    const Tensor<Descriptives, 1> shards_descriptives = data_shards.calculate_descriptives(samples_indices, variables_indices);
+
+    const Tensor<Descriptives, 1> data_descriptives = descriptives(data, samples_indices, variables_indices);
+
+    assert_true(shards_descriptives.size() == 3, LOG);
+
+    for(Index j = 0; j < variables_indices.size(); j++)
+    {
+        assert_true(abs(shards_descriptives(j).minimum - data_descriptives(j).minimum) < type(NUMERIC_LIMITS_MIN), LOG);
+        assert_true(abs(shards_descriptives(j).maximum - data_descriptives(j).maximum) < type(NUMERIC_LIMITS_MIN), LOG);
+        assert_true(abs(shards_descriptives(j).mean - data_descriptives(j).mean) < type(1.0e-5), LOG);
+        assert_true(abs(shards_descriptives(j).standard_deviation - data_descriptives(j).standard_deviation) < type(1.0e-5), LOG);
+    }
+}
+
+
+void DataShardsTest::test_shuffle_samples_indices()
+{
+    cout << "test_shuffle_samples_indices\n";
+
+    DataShards data_shards(file_names);
+
+    Tensor<Index, 1> samples_indices(8);
+    samples_indices.setValues({0, 1, 2, 4, 5, 7, 8, 9});
+
+    mt19937 random_engine_1(5);
+    mt19937 random_engine_2(5);
+
+    // Test
+
+    const Tensor<Index, 1> shuffled_samples_indices = data_shards.shuffle_samples_indices(samples_indices, 3, random_engine_1);
+
+    assert_true(shuffled_samples_indices.size() == samples_indices.size(), LOG);
+
+    Tensor<Index, 1> sorted_samples_indices = shuffled_samples_indices;
+
+    sort(sorted_samples_indices.data(), sorted_samples_indices.data() + sorted_samples_indices.size());
+
+    for(Index i = 0; i < samples_indices.size(); i++)
+    {
+        assert_true(sorted_samples_indices(i) == samples_indices(i), LOG);
+    }
+
+    // Test
+
+    const Tensor<Index, 1> shuffled_samples_indices_2 = data_shards.shuffle_samples_indices(samples_indices, 3, random_engine_2);
+
+    for(Index i = 0; i < samples_indices.size(); i++)
+    {
+        assert_true(shuffled_samples_indices_2(i) == shuffled_samples_indices(i), LOG);
+    }
+}
+
+
+void DataShardsTest::run_test_case()
+{
+    cout << "Running data shards test case...\n";
+
+    // Constructor and destructor methods
+
+    test_constructor();
+
+    // Reading methods
+
+    test_fill_submatrix();
+
+    test_calculate_descriptives();
+
+    test_shuffle_samples_indices();
+
+    cout << "End of data shards test case.\n\n";
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -0,0 +1,405 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   E M B E D D I N G   L A Y E R   T E S T   C L A S S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "embedding_layer_test.h"
+
+
+EmbeddingLayerTest::EmbeddingLayerTest() : UnitTesting()
+{
+}
+
+
+EmbeddingLayerTest::~EmbeddingLayerTest()
+{
+}
+
+
+void EmbeddingLayerTest::test_constructor()
+{
+    cout << "test_constructor\n";
+
+    // Default constructor
+
+    EmbeddingLayer embedding_layer_1;
+
+    assert_true(embedding_layer_1.get_parameters_number() == 0, LOG);
+
+    // Architecture constructor
+
+    EmbeddingLayer embedding_layer_2(10, 4, 3);
+
+    assert_true(embedding_layer_2.get_input_dim() == 10, LOG);
+    assert_true(embedding_layer_2.get_input_length() == 4, LOG);
+    assert_true(embedding_layer_2.get_depth() == 3, LOG);
+    assert_true(embedding_layer_2.get_parameters_number() == 30, LOG);
+    assert_true(embedding_layer_2.get_positional_encoding_matrix().size() == 0, LOG);
+
+    EmbeddingLayer embedding_layer_3(10, 4, 6, true);
+
+    assert_true(embedding_layer_3.get_positional_encoding_matrix().dimension(0) == 4, LOG);
+    assert_true(embedding_layer_3.get_positional_encoding_matrix().dimension(1) == 6, LOG);
+}
+
+
+void EmbeddingLayerTest::test_destructor()
+{
+    cout << "test_destructor\n";
+
+    EmbeddingLayer* embedding_layer_1 = new EmbeddingLayer;
+
+    delete embedding_layer_1;
+}
+
+
+void EmbeddingLayerTest::test_forward_propagate()
+{
+    cout << "test_forward_propagate\n";
+
+    const Index input_dim = 7;
+    const Index input_length = 4;
+    const Index depth = 6;
+    const Index samples_number = 3;
+
+    Tensor<type, 2> inputs(samples_number, input_length);
+    inputs.setValues({{1, 6, 0, 6},
+                      {3, 3, 5, 2},
+                      {0, 4, 1, 6}});
+
+    Tensor<DynamicTensor<type>, 1> inputs_pair(1);
+    inputs_pair(0) = DynamicTensor<type>(inputs.data(), get_dimensions(inputs));
+
+    // Test without positional encoding
+
+    embedding_layer.set(input_dim, input_length, depth);
+    embedding_layer.set_parameters_random();
+
+    EmbeddingLayerForwardPropagation embedding_layer_forward_propagation(samples_number, &embedding_layer);
+
+    embedding_layer.forward_propagate(inputs_pair, &embedding_layer_forward_propagation, true);
+
+    TensorMap<Tensor<type, 3>> outputs = embedding_layer_forward_propagation.outputs(0).to_tensor_map<3>();
+
+    const TensorMap<Tensor<type, 2>>& embedding_weights = embedding_layer.get_embedding_weights();
+
+    bool is_lookup = true;
+
+    for(Index i = 0; i < samples_number; i++)
+        for(Index j = 0; j < input_length; j++)
+            for(Index k = 0; k < depth; k++)
+                if(abs(outputs(i, j, k) - embedding_weights(k, Index(inputs(i, j)))) > type(NUMERIC_LIMITS_MIN))
+                    is_lookup = false;
+
+    assert_true(is_lookup, LOG);
+
+    // Test with positional encoding
+
+    embedding_layer.set(input_dim, input_length, depth, true);
+    embedding_layer.set_parameters_random();
+
+    embedding_layer_forward_propagation.set(samples_number, &embedding_layer);
+
+    embedding_layer.forward_propagate(inputs_pair, &embedding_layer_forward_propagation, true);
+
+    new (&outputs) TensorMap<Tensor<type, 3>>(embedding_layer_forward_propagation.outputs(0).to_tensor_map<3>());
+
+    const Tensor<type, 2>& positional_encoding_matrix = embedding_layer.get_positional_encoding_matrix();
+
+    is_lookup = true;
+
+    for(Index i = 0; i < samples_number; i++)
+        for(Index j = 0; j < input_length; j++)
+            for(Index k = 0; k < depth; k++)
+                if(abs(outputs(i, j, k) - embedding_weights(k, Index(inputs(i, j))) - positional_encoding_matrix(j, k)) > type(1.0e-6))
+                    is_lookup = false;
+
+    assert_true(is_lookup, LOG);
+
+    // Test with a batch of several blocks of inputs
+
+    const Index large_samples_number = 50;
+
+    Tensor<type, 2> large_inputs(large_samples_number, input_length);
+
+    for(Index i = 0; i < large_inputs.size(); i++)
+        large_inputs(i) = type(rand()%input_dim);
+
+    inputs_pair(0) = DynamicTensor<type>(large_inputs.data(), get_dimensions(large_inputs));
+
+    embedding_layer.set(input_dim, input_length, depth);
+    embedding_layer.set_parameters_random();
+
+    embedding_layer_forward_propagation.set(large_samples_number, &embedding_layer);
+
+    embedding_layer.forward_propagate(inputs_pair, &embedding_layer_forward_propagation, true);
+
+    new (&outputs) TensorMap<Tensor<type, 3>>(embedding_layer_forward_propagation.outputs(0).to_tensor_map<3>());
+
+    is_lookup = true;
+
+    for(Index i = 0; i < large_samples_number; i++)
+        for(Index j = 0; j < input_length; j++)
+            for(Index k = 0; k < depth; k++)
+                if(abs(outputs(i, j, k) - embedding_weights(k, Index(large_inputs(i, j)))) > type(NUMERIC_LIMITS_MIN))
+                    is_lookup = false;
+
+    assert_true(is_lookup, LOG);
+}
+
+
+void EmbeddingLayerTest::test_calculate_error_gradient()
+{
+    cout << "test_calculate_error_gradient\n";
+
+    const Index input_dim = 50;
+    const Index input_length = 3;
+    const Index depth = 4;
+    const Index samples_number = 2;
+
+    Tensor<type, 2> inputs(samples_number, input_length);
+    inputs.setValues({{7, 2, 7},
+                      {40, 2, 11}});
+
+    Tensor<DynamicTensor<type>, 1> inputs_pair(1);
+    inputs_pair(0) = DynamicTensor<type>(inputs.data(), get_dimensions(inputs));
+
+    embedding_layer.set(input_dim, input_length, depth);
+
+    EmbeddingLayerForwardPropagation embedding_layer_forward_propagation(samples_number, &embedding_layer);
+    EmbeddingLayerBackPropagation embedding_layer_back_propagation(samples_number, &embedding_layer);
+
+    embedding_layer.forward_propagate(inputs_pair, &embedding_layer_forward_propagation, true);
+
+    TensorMap<Tensor<type, 3>> deltas(embedding_layer_back_propagation.deltas_data, samples_number, input_length, depth);
+    deltas.setRandom();
+
+    embedding_layer.calculate_error_gradient(inputs.data(), &embedding_layer_forward_propagation, &embedding_layer_back_propagation);
+
+    // Dense gradient, by multiplying the deltas by the one-hot encoding of the inputs
+
+    Tensor<type, 2> embedding_weights_derivatives(depth, input_dim);
+    embedding_weights_derivatives.setZero();
+
+    for(Index i = 0; i < samples_number; i++)
+        for(Index j = 0; j < input_length; j++)
+            for(Index k = 0; k < depth; k++)
+                embedding_weights_derivatives(k, Index(inputs(i, j))) += deltas(i, j, k);
+
+    Tensor<type, 2> sparse_embedding_weights_derivatives = embedding_layer_back_propagation.embedding_weights_derivatives;
+
+    assert_true(are_equal(sparse_embedding_weights_derivatives, embedding_weights_derivatives, type(1.0e-6)), LOG);
+
+    // Rows with derivatives
+
+    assert_true(embedding_layer_back_propagation.rows_number == 4, LOG);
+    assert_true(embedding_layer_back_propagation.rows_indices(0) == 2, LOG);
+    assert_true(embedding_layer_back_propagation.rows_indices(1) == 7, LOG);
+    assert_true(embedding_layer_back_propagation.rows_indices(2) == 11, LOG);
+    assert_true(embedding_layer_back_propagation.rows_indices(3) == 40, LOG);
+
+    // Second batch, which only clears the rows of the first one
+
+    inputs.setValues({{3, 2, 3},
+                      {3, 49, 0}});
+
+    embedding_layer.forward_propagate(inputs_pair, &embedding_layer_forward_propagation, true);
+
+    deltas.setRandom();
+
+    embedding_layer.calculate_error_gradient(inputs.data(), &embedding_layer_forward_propagation, &embedding_layer_back_propagation);
+
+    embedding_weights_derivatives.setZero();
+
+    for(Index i = 0; i < samples_number; i++)
+        for(Index j = 0; j < input_length; j++)
+            for(Index k = 0; k < depth; k++)
+                embedding_weights_derivatives(k, Index(inputs(i, j))) += deltas(i, j, k);
+
+    sparse_embedding_weights_derivatives = embedding_layer_back_propagation.embedding_weights_derivatives;
+
+    assert_true(are_equal(sparse_embedding_weights_derivatives, embedding_weights_derivatives, type(1.0e-6)), LOG);
+
+    assert_true(embedding_layer_back_propagation.rows_number == 4, LOG);
+    assert_true(embedding_layer_back_propagation.rows_indices(0) == 0, LOG);
+    assert_true(embedding_layer_back_propagation.rows_indices(3) == 49, LOG);
+
+    // Derivatives written outside the layer are cleared whole
+
+    embedding_layer_back_propagation.embedding_weights_derivatives.setConstant(type(1));
+
+    embedding_layer_back_propagation.set_gradient_modified();
+
+    embedding_layer.calculate_error_gradient(inputs.data(), &embedding_layer_forward_propagation, &embedding_layer_back_propagation);
+
+    sparse_embedding_weights_derivatives = embedding_layer_back_propagation.embedding_weights_derivatives;
+
+    assert_true(are_equal(sparse_embedding_weights_derivatives, embedding_weights_derivatives, type(1.0e-6)), LOG);
+}
+
+
+void EmbeddingLayerTest::test_calculate_hidden_delta()
+{
+    cout << "test_calculate_hidden_delta\n";
+
+    const Index input_dim = 6;
+    const Index input_length = 4;
+    const Index depth = 3;
+    const Index number_of_heads = 2;
+    const Index samples_number = 2;
+
+    Tensor<type, 2> inputs(samples_number, input_length);
+    inputs.setValues({{1, 5, 0, 5},
+                      {2, 2, 4, 3}});
+
+    Tensor<DynamicTensor<type>, 1> inputs_pair(1);
+    inputs_pair(0) = DynamicTensor<type>(inputs.data(), get_dimensions(inputs));
+
+    embedding_layer.set(input_dim, input_length, depth);
+
+    MultiheadAttentionLayer multihead_attention_layer(input_length, input_length, depth, number_of_heads);
+
+    EmbeddingLayerForwardPropagation embedding_layer_forward_propagation(samples_number, &embedding_layer);
+    EmbeddingLayerBackPropagation embedding_layer_back_propagation(samples_number, &embedding_layer);
+
+    MultiheadAttentionLayerForwardPropagation multihead_attention_layer_forward_propagation(samples_number, &multihead_attention_layer);
+    MultiheadAttentionLayerBackPropagation multihead_attention_layer_back_propagation(samples_number, &multihead_attention_layer);
+
+    TensorMap<Tensor<type, 3>> attention_deltas(multihead_attention_layer_back_propagation.deltas_data, samples_number, input_length, depth);
+
+    // Key and value of the cross-attention, which do not come from the embedding
+
+    Tensor<type, 3> context(samples_number, input_length, depth);
+    context.setRandom();
+
+    const DynamicTensor<type>& embedding_outputs = embedding_layer_forward_propagation.outputs(0);
+
+    Tensor<DynamicTensor<type>, 1> attention_inputs(3);
+
+    const Index parameters_number = embedding_layer.get_parameters_number();
+
+    Tensor<type, 1> gradient(parameters_number);
+
+    // The error is the sum of the attention outputs weighted by their deltas
+
+    const auto calculate_error = [&]() -> type
+    {
+        embedding_layer.forward_propagate(inputs_pair, &embedding_layer_forward_propagation, true);
+
+        multihead_attention_layer.forward_propagate(attention_inputs, &multihead_attention_layer_forward_propagation, true);
+
+        const Tensor<type, 0> error
+            = (multihead_attention_layer_forward_propagation.outputs(0).to_tensor_map<3>()*attention_deltas).sum();
+
+        return error(0);
+    };
+
+    for(const bool is_self_attention : {true, false})
+    {
+        // The embedding gives the query, and also the key and value of a self-attention
+
+        attention_inputs(0).set_view(embedding_outputs.get_data(), embedding_outputs.get_dimensions());
+
+        multihead_attention_layer_forward_propagation.inputs_layers_pointers(0) = &embedding_layer;
+
+        for(Index i = 1; i < 3; i++)
+        {
+            if(is_self_attention)
+                attention_inputs(i).set_view(embedding_outputs.get_data(), embedding_outputs.get_dimensions());
+            else
+                attention_inputs(i).set_view(context.data(), get_dimensions(context));
+
+            multihead_attention_layer_forward_propagation.inputs_layers_pointers(i) = is_self_attention ? &embedding_layer : nullptr;
+        }
+
+        embedding_layer.set_parameters_random();
+
+        attention_deltas.setRandom();
+
+        Tensor<type, 1> parameters = embedding_layer.get_parameters();
+
+        calculate_error();
+
+        multihead_attention_layer.calculate_inputs_derivatives(&multihead_attention_layer_forward_propagation,
+                                                               &multihead_attention_layer_back_propagation);
+
+        embedding_layer.calculate_hidden_delta(&multihead_attention_layer_forward_propagation,
+                                               &multihead_attention_layer_back_propagation,
+                                               &embedding_layer_back_propagation);
+
+        embedding_layer.calculate_error_gradient(inputs.data(), &embedding_layer_forward_propagation, &embedding_layer_back_propagation);
+
+        embedding_layer.insert_gradient(&embedding_layer_back_propagation, 0, gradient);
+
+        // Numerical differentiation of the error with respect to the lookup table
+
+        const type h = type(1.0e-2);
+
+        Tensor<type, 1> numerical_gradient(parameters_number);
+
+        for(Index i = 0; i < parameters_number; i++)
+        {
+            const type parameter = parameters(i);
+
+            parameters(i) = parameter + h;
+            embedding_layer.set_parameters(parameters, 0);
+            const type error_forward = calculate_error();
+
+            parameters(i) = parameter - h;
+            embedding_layer.set_parameters(parameters, 0);
+            const type error_backward = calculate_error();
+
+            parameters(i) = parameter;
+
+            numerical_gradient(i) = (error_forward - error_backward)/(type(2)*h);
+        }
+
+        embedding_layer.set_parameters(parameters, 0);
+
+        assert_true(are_equal(gradient, numerical_gradient, type(1.0e-2)), LOG);
+    }
+}
+
+
+void EmbeddingLayerTest::run_test_case()
+{
+    cout << "Running embedding layer test case...\n";
+
+    // Constructor and destructor
+
+    test_constructor();
+    test_destructor();
+
+    // Forward propagate
+
+    test_forward_propagate();
+
+    // Back-propagation
+
+    test_calculate_error_gradient();
+
+    test_calculate_hidden_delta();
+
+    cout << "End of embedding layer test case.\n\n";
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -0,0 +1,290 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   I M A G E   A U G M E N T A T I O N   T E S T   C L A S S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "image_augmentation_test.h"
+
+
+ImageAugmentationTest::ImageAugmentationTest() : UnitTesting()
+{
+    images_number = 16;
+    rows_number = 6;
+    columns_number = 5;
+    channels_number = 3;
+
+    images.resize(images_number, rows_number, columns_number, channels_number);
+    images.setRandom();
+
+    samples_indices.resize(images_number);
+
+    for(Index i = 0; i < images_number; i++)
+    {
+        samples_indices(i) = 3*i + 1;
+    }
+}
+
+
+ImageAugmentationTest::~ImageAugmentationTest()
+{
+}
+
+
+void ImageAugmentationTest::test_constructor()
+{
+    cout << "test_constructor\n";
+
+    // Default constructor
+
+    ImageAugmentation image_augmentation_1;
+
+    assert_true(image_augmentation_1.get_rows_number() == 0, LOG);
+    assert_true(image_augmentation_1.get_columns_number() == 0, LOG);
+    assert_true(image_augmentation_1.get_channels_number() == 0, LOG);
+    assert_true(image_augmentation_1.is_identity(), LOG);
+
+    // Images dimensions constructor
+
+    ImageAugmentation image_augmentation_2(rows_number, columns_number, channels_number);
+
+    assert_true(image_augmentation_2.get_rows_number() == rows_number, LOG);
+    assert_true(image_augmentation_2.get_columns_number() == columns_number, LOG);
+    assert_true(image_augmentation_2.get_channels_number() == channels_number, LOG);
+    assert_true(image_augmentation_2.is_identity(), LOG);
+
+    image_augmentation_2.set_random_reflection_axis_x(true);
+
+    assert_true(!image_augmentation_2.is_identity(), LOG);
+}
+
+
+void ImageAugmentationTest::test_calculate_sample_seed()
+{
+    cout << "test_calculate_sample_seed\n";
+
+    // Test
+
+    assert_true(ImageAugmentation::calculate_sample_seed(5, 7) == ImageAugmentation::calculate_sample_seed(5, 7), LOG);
+    assert_true(ImageAugmentation::calculate_sample_seed(5, 7) != ImageAugmentation::calculate_sample_seed(5, 8), LOG);
+    assert_true(ImageAugmentation::calculate_sample_seed(5, 7) != ImageAugmentation::calculate_sample_seed(6, 7), LOG);
+}
+
+
+void ImageAugmentationTest::test_augment_identity()
+{
+    cout << "test_augment_identity\n";
+
+    ImageAugmentation image_augmentation(rows_number, columns_number, channels_number);
+
+    Tensor<type, 4> augmented_images = images;
+
+    // Test
+
+    image_augmentation.augment(augmented_images.data(), images_number, samples_indices, 1);
+
+    const Tensor<bool, 0> is_equal = (augmented_images == images).all();
+
+    assert_true(is_equal(), LOG);
+}
+
+
+void ImageAugmentationTest::test_augment_translation()
+{
+    cout << "test_augment_translation\n";
+
+    ImageAugmentation image_augmentation(rows_number, columns_number, channels_number);
+
+    image_augmentation.set_random_horizontal_translation_minimum(type(2));
+    image_augmentation.set_random_horizontal_translation_maximum(type(2));
+    image_augmentation.set_random_vertical_translation_minimum(type(-1));
+    image_augmentation.set_random_vertical_translation_maximum(type(-1));
+
+    Tensor<type, 4> augmented_images = images;
+
+    // Test
+
+    image_augmentation.augment(augmented_images.data(), images_number, samples_indices, 1);
+
+    bool is_translated = true;
+
+    for(Index image = 0; image < images_number; image++)
+        for(Index row = 0; row < rows_number; row++)
+            for(Index column = 0; column < columns_number; column++)
+                for(Index channel = 0; channel < channels_number; channel++)
+                {
+                    const Index source_row = row + 1;
+                    const Index source_column = column - 2;
+
+                    const type expected = (source_row >= rows_number || source_column < 0)
+                            ? type(0)
+                            : images(image, source_row, source_column, channel);
+
+                    if(augmented_images(image, row, column, channel) != expected) is_translated = false;
+                }
+
+    assert_true(is_translated, LOG);
+}
+
+
+void ImageAugmentationTest::test_augment_reflection()
+{
+    cout << "test_augment_reflection\n";
+
+    ImageAugmentation image_augmentation(rows_number, columns_number, channels_number);
+
+    image_augmentation.set_random_reflection_axis_x(true);
+
+    Tensor<type, 4> augmented_images = images;
+
+    const Eigen::array<bool, 4> reflect_columns = {false, false, true, false};
+
+    const Tensor<type, 4> reflected_images = images.reverse(reflect_columns);
+
+    // Test
+
+    image_augmentation.augment(augmented_images.data(), images_number, samples_indices, 1);
+
+    Index reflected_images_number = 0;
+    Index unchanged_images_number = 0;
+
+    for(Index image = 0; image < images_number; image++)
+    {
+        const Tensor<type, 3> augmented_image = augmented_images.chip(image, 0);
+        const Tensor<type, 3> original_image = images.chip(image, 0);
+        const Tensor<type, 3> reflected_image = reflected_images.chip(image, 0);
+
+        const Tensor<bool, 0> is_reflected = (augmented_image == reflected_image).all();
+        const Tensor<bool, 0> is_unchanged = (augmented_image == original_image).all();
+
+        if(is_reflected()) reflected_images_number++;
+        if(is_unchanged()) unchanged_images_number++;
+    }
+
+    assert_true(reflected_images_number + unchanged_images_number == images_number, LOG);
+    assert_true(reflected_images_number > 0, LOG);
+    assert_true(unchanged_images_number > 0, LOG);
+}
+
+
+void ImageAugmentationTest::test_augment_rotation()
+{
+    cout << "test_augment_rotation\n";
+
+    ImageAugmentation image_augmentation(rows_number, columns_number, channels_number);
+
+    image_augmentation.set_random_rotation_minimum(type(180));
+    image_augmentation.set_random_rotation_maximum(type(180));
+
+    Tensor<type, 4> augmented_images = images;
+
+    const Eigen::array<bool, 4> reflect_rows_and_columns = {false, true, true, false};
+
+    const Tensor<type, 4> rotated_images = images.reverse(reflect_rows_and_columns);
+
+    // Test
+
+    image_augmentation.augment(augmented_images.data(), images_number, samples_indices, 1);
+
+    const Tensor<bool, 0> is_rotated = (augmented_images == rotated_images).all();
+
+    assert_true(is_rotated(), LOG);
+}
+
+
+void ImageAugmentationTest::test_augment_determinism()
+{
+    cout << "test_augment_determinism\n";
+
+    ImageAugmentation image_augmentation(rows_number, columns_number, channels_number);
+
+    image_augmentation.set_random_reflection_axis_x(true);
+    image_augmentation.set_random_reflection_axis_y(true);
+    image_augmentation.set_random_rotation_minimum(type(-30));
+    image_augmentation.set_random_rotation_maximum(type(30));
+    image_augmentation.set_random_horizontal_translation_minimum(type(-1));
+    image_augmentation.set_random_horizontal_translation_maximum(type(1));
+
+    Tensor<type, 4> augmented_images_1 = images;
+    Tensor<type, 4> augmented_images_2 = images;
+    Tensor<type, 4> augmented_images_3 = images;
+
+    // Test
+
+    image_augmentation.augment(augmented_images_1.data(), images_number, samples_indices, 11);
+    image_augmentation.augment(augmented_images_2.data(), images_number, samples_indices, 11);
+    image_augmentation.augment(augmented_images_3.data(), images_number, samples_indices, 12);
+
+    const Tensor<bool, 0> is_equal = (augmented_images_1 == augmented_images_2).all();
+    const Tensor<bool, 0> is_different = (augmented_images_1 != augmented_images_3).any();
+
+    assert_true(is_equal(), LOG);
+    assert_true(is_different(), LOG);
+
+    // Test
+
+    const Tensor<type, 4> first_image = images.slice(Eigen::array<Index, 4>{0, 0, 0, 0},
+                                                     Eigen::array<Index, 4>{1, rows_number, columns_number, channels_number});
+
+    Tensor<type, 4> augmented_first_image = first_image;
+
+    Tensor<Index, 1> first_sample_index(1);
+    first_sample_index.setConstant(samples_indices(0));
+
+    image_augmentation.augment(augmented_first_image.data(), 1, first_sample_index, 11);
+
+    const Tensor<type, 4> augmented_batch_first_image
+            = augmented_images_1.slice(Eigen::array<Index, 4>{0, 0, 0, 0},
+                                       Eigen::array<Index, 4>{1, rows_number, columns_number, channels_number});
+
+    const Tensor<bool, 0> is_batch_independent = (augmented_first_image == augmented_batch_first_image).all();
+
+    assert_true(is_batch_independent(), LOG);
+}
+
+
+void ImageAugmentationTest::run_test_case()
+{
+    cout << "Running image augmentation test case...\n";
+
+    // Constructor and destructor methods
+
+    test_constructor();
+
+    // Augmentation methods
+
+    test_calculate_sample_seed();
+
+    test_augment_identity();
+
+    test_augment_translation();
+
+    test_augment_reflection();
+
+    test_augment_rotation();
+
+    test_augment_determinism();
+
+    cout << "End of image augmentation test case.\n\n";
+}
+
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -0,0 +1,82 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   I M A G E   A U G M E N T A T I O N   T E S T   C L A S S   H E A D E R
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#ifndef IMAGEAUGMENTATIONTEST_H
+#define IMAGEAUGMENTATIONTEST_H
+
+// Unit testing includes
+
+#include "../opennn/unit_testing.h"
+
+class ImageAugmentationTest : public UnitTesting
+{
+
+public:
+
+   explicit ImageAugmentationTest();
+
+   virtual ~ImageAugmentationTest();
+
+   // Constructor and destructor methods
+
+   void test_constructor();
+
+   // Augmentation methods
+
+   void test_calculate_sample_seed();
+
+   void test_augment_identity();
+
+   void test_augment_translation();
+
+   void test_augment_reflection();
+
+   void test_augment_rotation();
+
+   void test_augment_determinism();
+
+   // Unit testing methods
+
+   void run_test_case();
+
+private:
+
+   Index images_number = 0;
+
+   Index rows_number = 0;
+
+   Index columns_number = 0;
+
+   Index channels_number = 0;
+
+   Tensor<type, 4> images;
+
+   Tensor<Index, 1> samples_indices;
+
+};
+
+#endif
+
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -54,6 +54,49 @@ void LearningRateAlgorithmTest::test_destructor()
 }
 
 
+void LearningRateAlgorithmTest::test_set_candidates_number()
+{
+    cout << "test_set_candidates_number\n";
+
+    LearningRateAlgorithm tra1(&sum_squared_error);
+
+    assert_true(tra1.get_candidates_number() == 1, LOG);
+
+    tra1.set_candidates_number(4);
+
+    assert_true(tra1.get_candidates_number() == 4, LOG);
+
+    // Test
+
+    try
+    {
+        tra1.set_candidates_number(0);
+
+        assert_true(false, LOG);
+    }
+    catch(const invalid_argument&)
+    {
+        assert_true(tra1.get_candidates_number() == 4, LOG);
+    }
+
+    // Test
+
+    tinyxml2::XMLPrinter printer;
+
+    tra1.write_XML(printer);
+
+    tinyxml2::XMLDocument document;
+
+    document.Parse(printer.CStr());
+
+    LearningRateAlgorithm tra2(&sum_squared_error);
+
+    tra2.from_XML(document);
+
+    assert_true(tra2.get_candidates_number() == 4, LOG);
+}
+
+
 void LearningRateAlgorithmTest::test_calculate_bracketing_triplet()
 {
     cout << "test_calculate_bracketing_triplet\n";
@@ -259,6 +302,213 @@ void LearningRateAlgorithmTest::test_calculate_Brent_method_directional_point()
 }
 
 
+void LearningRateAlgorithmTest::test_calculate_concurrent_directional_point()
+{
+    cout << "test_calculate_concurrent_directional_point\n";
+
+    const Index samples_number = 10;
+    const Index inputs_number = 3;
+    const Index targets_number = 2;
+    const Index neurons_number = 4;
+
+    bool is_training = true;
+
+    DataSetBatch batch;
+
+    NeuralNetworkForwardPropagation forward_propagation;
+
+    LossIndexBackPropagation back_propagation;
+
+    OptimizationAlgorithmData optimization_data;
+
+    pair<type, type> directional_point;
+    pair<type, type> concurrent_directional_point;
+
+    // Data set
+
+    data_set.set(samples_number, inputs_number, targets_number);
+    data_set.set_data_random();
+    data_set.set_training();
+
+    const Tensor<Index, 1> training_samples_indices = data_set.get_training_samples_indices();
+    const Tensor<Index, 1> input_variables_indices = data_set.get_input_variables_indices();
+    const Tensor<Index, 1> target_variables_indices = data_set.get_target_variables_indices();
+
+    batch.set(samples_number, &data_set);
+    batch.fill(training_samples_indices, input_variables_indices, target_variables_indices);
+
+    // Neural network
+
+    neural_network.set(NeuralNetwork::ProjectType::Approximation, {inputs_number, neurons_number, targets_number});
+    neural_network.set_parameters_random();
+
+    const Index parameters_number = neural_network.get_parameters_number();
+
+    forward_propagation.set(samples_number, &neural_network);
+    neural_network.forward_propagate(batch, forward_propagation, is_training);
+
+    // Loss index
+
+    back_propagation.set(samples_number, &sum_squared_error);
+    sum_squared_error.back_propagate(batch, forward_propagation, back_propagation);
+
+    const type loss = back_propagation.loss;
+
+    optimization_data.potential_parameters.resize(parameters_number);
+    optimization_data.training_direction = -back_propagation.gradient;
+    optimization_data.initial_learning_rate = type(0.01);
+
+    Tensor<type, 1> parameters = neural_network.get_parameters();
+
+    // Test
+
+    assert_true(neural_network.has_parameters_forward_propagation(), LOG);
+
+    learning_rate_algorithm.set_candidates_number(1);
+
+    directional_point = learning_rate_algorithm.calculate_directional_point(batch, forward_propagation, back_propagation, optimization_data);
+
+    for(const Index& candidates_number : {2, 4})
+    {
+        learning_rate_algorithm.set_candidates_number(candidates_number);
+
+        concurrent_directional_point
+                = learning_rate_algorithm.calculate_directional_point(batch, forward_propagation, back_propagation, optimization_data);
+
+        assert_true(optimization_data.candidates_forward_propagations.size() == candidates_number, LOG);
+        assert_true(optimization_data.candidates_back_propagations(0)->gradient.size() == 0, LOG);
+        assert_true(concurrent_directional_point.first > type(0), LOG);
+        assert_true(concurrent_directional_point.second < loss, LOG);
+        assert_true(abs(concurrent_directional_point.second - directional_point.second) < type(1.0e-2)*loss, LOG);
+
+        // The candidates do not modify the neural network
+
+        const Tensor<type, 1> candidates_parameters = neural_network.get_parameters();
+
+        assert_true(are_equal(candidates_parameters, parameters, type(0)), LOG);
+
+        // The loss of the learning rate is the loss of the parameters along the training direction
+
+        optimization_data.potential_parameters
+                = back_propagation.parameters + optimization_data.training_direction*concurrent_directional_point.first;
+
+        neural_network.set_parameters(optimization_data.potential_parameters);
+
+        neural_network.forward_propagate(batch, forward_propagation, is_training);
+
+        sum_squared_error.calculate_errors(batch, forward_propagation, back_propagation);
+        sum_squared_error.calculate_error(batch, forward_propagation, back_propagation);
+
+        assert_true(abs(back_propagation.error - concurrent_directional_point.second) < type(1.0e-3)*(type(1) + loss), LOG);
+
+        neural_network.set_parameters(parameters);
+    }
+
+    learning_rate_algorithm.set_candidates_number(1);
+}
+
+
+void LearningRateAlgorithmTest::test_calculate_candidates_losses()
+{
+    cout << "test_calculate_candidates_losses\n";
+
+    // Seven samples make two sequences of three timesteps and a last sequence of one
+
+    const Index samples_number = 7;
+    const Index inputs_number = 2;
+    const Index neurons_number = 3;
+    const Index targets_number = 2;
+    const Index candidates_number = 3;
+
+    bool is_training = true;
+
+    DataSetBatch batch;
+
+    NeuralNetworkForwardPropagation forward_propagation;
+
+    LossIndexBackPropagation back_propagation;
+
+    OptimizationAlgorithmData optimization_data;
+
+    Tensor<type, 1> learning_rates(candidates_number);
+    Tensor<type, 1> losses(candidates_number);
+
+    // Data set
+
+    data_set.set(samples_number, inputs_number, targets_number);
+    data_set.set_data_random();
+    data_set.set_training();
+
+    batch.set(samples_number, &data_set);
+    batch.fill(data_set.get_training_samples_indices(), data_set.get_input_variables_indices(), data_set.get_target_variables_indices());
+
+    // Neural network
+
+    LongShortTermMemoryLayer* long_short_term_memory_layer = new LongShortTermMemoryLayer(inputs_number, neurons_number);
+
+    long_short_term_memory_layer->set_timesteps(3);
+
+    neural_network.set();
+
+    neural_network.add_layer(long_short_term_memory_layer);
+    neural_network.add_layer(new ProbabilisticLayer(neurons_number, targets_number));
+
+    neural_network.set_parameters_random();
+
+    const Index parameters_number = neural_network.get_parameters_number();
+
+    forward_propagation.set(samples_number, &neural_network);
+    neural_network.forward_propagate(batch, forward_propagation, is_training);
+
+    // Loss index
+
+    back_propagation.set(samples_number, &sum_squared_error);
+    sum_squared_error.back_propagate(batch, forward_propagation, back_propagation);
+
+    optimization_data.potential_parameters.resize(parameters_number);
+    optimization_data.training_direction = -back_propagation.gradient;
+
+    Tensor<type, 1> parameters = neural_network.get_parameters();
+
+    // Test
+
+    assert_true(neural_network.has_parameters_forward_propagation(), LOG);
+
+    learning_rate_algorithm.set_candidates_number(candidates_number);
+
+    learning_rates.setValues({type(0.01), type(0.1), type(1)});
+
+    learning_rate_algorithm.calculate_candidates_losses(batch, back_propagation, optimization_data, learning_rates, losses);
+
+    const Tensor<type, 1> candidates_parameters = neural_network.get_parameters();
+
+    assert_true(are_equal(candidates_parameters, parameters, type(0)), LOG);
+
+    // Each loss is that of the neural network with the parameters of the candidate
+
+    for(Index i = 0; i < candidates_number; i++)
+    {
+        optimization_data.potential_parameters = parameters + optimization_data.training_direction*learning_rates(i);
+
+        neural_network.set_parameters(optimization_data.potential_parameters);
+
+        neural_network.forward_propagate(batch, forward_propagation, is_training);
+
+        sum_squared_error.calculate_errors(batch, forward_propagation, back_propagation);
+        sum_squared_error.calculate_error(batch, forward_propagation, back_propagation);
+
+        const type potential_loss = back_propagation.error
+                + sum_squared_error.get_regularization_weight()*sum_squared_error.calculate_regularization(optimization_data.potential_parameters);
+
+        assert_true(abs(potential_loss - losses(i)) < type(1.0e-3)*(type(1) + potential_loss), LOG);
+    }
+
+    neural_network.set_parameters(parameters);
+
+    learning_rate_algorithm.set_candidates_number(1);
+}
+
+
 void LearningRateAlgorithmTest::run_test_case()
 {
     cout << "Running learning rate algorithm test case...\n";
@@ -268,6 +518,10 @@ void LearningRateAlgorithmTest::run_test_case()
     test_constructor();
     test_destructor();
 
+    // Set methods
+
+    test_set_candidates_number();
+
     // Training methods
 
     test_calculate_bracketing_triplet();
@@ -276,6 +530,10 @@ void LearningRateAlgorithmTest::run_test_case()
 
     test_calculate_Brent_method_directional_point();
 
+    test_calculate_concurrent_directional_point();
+
+    test_calculate_candidates_losses();
+
     cout << "End of learning rate algorithm test case.\n\n";
 }
 
@@ -28,6 +28,10 @@ public:
 
     void test_destructor();
 
+    // Set methods
+
+    void test_set_candidates_number();
+
     // Training methods
 
     void test_calculate_bracketing_triplet();
@@ -36,6 +40,10 @@ public:
 
     void test_calculate_Brent_method_directional_point();
 
+    void test_calculate_concurrent_directional_point();
+
+    void test_calculate_candidates_losses();
+
     // Unit testing methods
 
     void run_test_case();
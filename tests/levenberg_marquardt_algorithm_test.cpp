@@ -60,6 +60,195 @@ void LevenbergMarquardtAlgorithmTest::test_destructor()
 }
 
 
+void LevenbergMarquardtAlgorithmTest::test_set_block_samples_number()
+{
+    cout << "test_set_block_samples_number\n";
+
+    LevenbergMarquardtAlgorithm levenberg_marquardt_algorithm_1;
+
+    assert_true(levenberg_marquardt_algorithm_1.get_block_samples_number() == 1000, LOG);
+
+    levenberg_marquardt_algorithm_1.set_block_samples_number(7);
+
+    assert_true(levenberg_marquardt_algorithm_1.get_block_samples_number() == 7, LOG);
+
+    // Test
+
+    try
+    {
+        levenberg_marquardt_algorithm_1.set_block_samples_number(0);
+
+        assert_true(false, LOG);
+    }
+    catch(const invalid_argument&)
+    {
+        assert_true(levenberg_marquardt_algorithm_1.get_block_samples_number() == 7, LOG);
+    }
+}
+
+
+void LevenbergMarquardtAlgorithmTest::test_set_damped_system_solver()
+{
+    cout << "test_set_damped_system_solver\n";
+
+    LevenbergMarquardtAlgorithm levenberg_marquardt_algorithm_1;
+
+    assert_true(levenberg_marquardt_algorithm_1.get_damped_system_solver()
+                == LevenbergMarquardtAlgorithm::DampedSystemSolver::Cholesky, LOG);
+
+    levenberg_marquardt_algorithm_1.set_damped_system_solver("EigenDecomposition");
+
+    assert_true(levenberg_marquardt_algorithm_1.write_damped_system_solver() == "EigenDecomposition", LOG);
+
+    // XML
+
+    levenberg_marquardt_algorithm_1.set_block_samples_number(5);
+
+    tinyxml2::XMLPrinter printer;
+
+    levenberg_marquardt_algorithm_1.write_XML(printer);
+
+    tinyxml2::XMLDocument document;
+
+    document.Parse(printer.CStr());
+
+    LevenbergMarquardtAlgorithm levenberg_marquardt_algorithm_2;
+
+    levenberg_marquardt_algorithm_2.from_XML(document);
+
+    assert_true(levenberg_marquardt_algorithm_2.get_damped_system_solver()
+                == LevenbergMarquardtAlgorithm::DampedSystemSolver::EigenDecomposition, LOG);
+    assert_true(levenberg_marquardt_algorithm_2.get_block_samples_number() == 5, LOG);
+
+    // Test
+
+    try
+    {
+        levenberg_marquardt_algorithm_1.set_damped_system_solver("QR");
+
+        assert_true(false, LOG);
+    }
+    catch(const invalid_argument&)
+    {
+        assert_true(levenberg_marquardt_algorithm_1.write_damped_system_solver() == "EigenDecomposition", LOG);
+    }
+}
+
+
+void LevenbergMarquardtAlgorithmTest::test_back_propagate_blocks()
+{
+    cout << "test_back_propagate_blocks\n";
+
+    const Index samples_number = 10;
+    const Index inputs_number = 3;
+    const Index neurons_number = 4;
+    const Index outputs_number = 2;
+
+    data_set.set(samples_number, inputs_number, outputs_number);
+    data_set.set_data_random();
+    data_set.set_training();
+
+    const Tensor<Index, 1> samples_indices = data_set.get_training_samples_indices();
+    const Tensor<Index, 1> input_variables_indices = data_set.get_input_variables_indices();
+    const Tensor<Index, 1> target_variables_indices = data_set.get_target_variables_indices();
+
+    neural_network.set(NeuralNetwork::ProjectType::Approximation, {inputs_number, neurons_number, outputs_number});
+    neural_network.set_parameters_random();
+
+    const Index parameters_number = neural_network.get_parameters_number();
+
+    DataSetBatch batch(samples_number, &data_set);
+    batch.fill(samples_indices, input_variables_indices, target_variables_indices);
+
+    NeuralNetworkForwardPropagation forward_propagation(samples_number, &neural_network);
+
+    bool is_training = true;
+
+    // Full Jacobian
+
+    LossIndexBackPropagationLM back_propagation_lm(samples_number, &sum_squared_error);
+
+    neural_network.forward_propagate(batch, forward_propagation, is_training);
+
+    sum_squared_error.back_propagate_lm(batch, forward_propagation, back_propagation_lm);
+
+    // Blocks of 4 samples, the last of which overlaps the previous one
+
+    levenberg_marquardt_algorithm.set_block_samples_number(4);
+
+    LevenbergMarquardtAlgorithmData optimization_data(&levenberg_marquardt_algorithm);
+
+    assert_true(optimization_data.has_blocks(), LOG);
+
+    LossIndexBackPropagationLM blocks_back_propagation_lm;
+    blocks_back_propagation_lm.set_accumulated(samples_number, &sum_squared_error);
+
+    assert_true(blocks_back_propagation_lm.squared_errors_jacobian.size() == 0, LOG);
+
+    levenberg_marquardt_algorithm.back_propagate_blocks(blocks_back_propagation_lm, optimization_data);
+
+    assert_true(abs(blocks_back_propagation_lm.error - back_propagation_lm.error) < type(1.0e-3), LOG);
+    assert_true(abs(blocks_back_propagation_lm.loss - back_propagation_lm.loss) < type(1.0e-3), LOG);
+
+    Tensor<type, 1> parameters = neural_network.get_parameters();
+
+    assert_true(abs(levenberg_marquardt_algorithm.calculate_blocks_error(parameters, optimization_data)
+                    - back_propagation_lm.error) < type(1.0e-3), LOG);
+
+    for(Index i = 0; i < parameters_number; i++)
+    {
+        assert_true(abs(blocks_back_propagation_lm.gradient(i) - back_propagation_lm.gradient(i)) < type(1.0e-3), LOG);
+    }
+
+    for(Index i = 0; i < parameters_number*parameters_number; i++)
+    {
+        assert_true(abs(blocks_back_propagation_lm.hessian(i) - back_propagation_lm.hessian(i)) < type(1.0e-3), LOG);
+    }
+
+    // Mean squared error, whose coefficient depends on the number of samples
+
+    MeanSquaredError mean_squared_error(&neural_network, &data_set);
+
+    LevenbergMarquardtAlgorithm mean_squared_error_levenberg_marquardt_algorithm(&mean_squared_error);
+
+    mean_squared_error_levenberg_marquardt_algorithm.set_block_samples_number(4);
+
+    LevenbergMarquardtAlgorithmData mean_squared_error_optimization_data(&mean_squared_error_levenberg_marquardt_algorithm);
+
+    back_propagation_lm.set(samples_number, &mean_squared_error);
+
+    neural_network.forward_propagate(batch, forward_propagation, is_training);
+
+    mean_squared_error.back_propagate_lm(batch, forward_propagation, back_propagation_lm);
+
+    blocks_back_propagation_lm.set_accumulated(samples_number, &mean_squared_error);
+
+    mean_squared_error_levenberg_marquardt_algorithm.back_propagate_blocks(blocks_back_propagation_lm, mean_squared_error_optimization_data);
+
+    assert_true(abs(blocks_back_propagation_lm.error - back_propagation_lm.error) < type(1.0e-3), LOG);
+
+    for(Index i = 0; i < parameters_number; i++)
+    {
+        assert_true(abs(blocks_back_propagation_lm.gradient(i) - back_propagation_lm.gradient(i)) < type(1.0e-3), LOG);
+    }
+
+    for(Index i = 0; i < parameters_number*parameters_number; i++)
+    {
+        assert_true(abs(blocks_back_propagation_lm.hessian(i) - back_propagation_lm.hessian(i)) < type(1.0e-3), LOG);
+    }
+
+    // Blocks as large as the data set
+
+    levenberg_marquardt_algorithm.set_block_samples_number(samples_number);
+
+    optimization_data.set(&levenberg_marquardt_algorithm);
+
+    assert_true(!optimization_data.has_blocks(), LOG);
+
+    levenberg_marquardt_algorithm.set_block_samples_number(1000);
+}
+
+
 void LevenbergMarquardtAlgorithmTest::test_perform_training()
 {
     cout << "test_perform_training\n";
@@ -148,6 +337,53 @@ void LevenbergMarquardtAlgorithmTest::test_perform_training()
     training_results = levenberg_marquardt_algorithm.perform_training();
 
     assert_true(training_results.get_loss_decrease() <= minimum_loss_decrease, LOG);
+
+    // Blocks and eigendecomposition
+
+    samples_number = 10;
+    inputs_number = 2;
+    outputs_number = 1;
+
+    data_set.set(samples_number, inputs_number, outputs_number);
+    data_set.set_data_random();
+    data_set.set_training();
+
+    neural_network.set(NeuralNetwork::ProjectType::Approximation, {inputs_number, 3, outputs_number});
+    neural_network.set_parameters_random();
+
+    Tensor<type, 1> parameters = neural_network.get_parameters();
+
+    levenberg_marquardt_algorithm.set_loss_goal(type(0));
+    levenberg_marquardt_algorithm.set_minimum_loss_decrease(type(0));
+    levenberg_marquardt_algorithm.set_maximum_epochs_number(1);
+
+    for(const string& damped_system_solver : {"Cholesky", "EigenDecomposition"})
+    {
+        levenberg_marquardt_algorithm.set_damped_system_solver(damped_system_solver);
+        levenberg_marquardt_algorithm.set_block_samples_number(3);
+        levenberg_marquardt_algorithm.set_damping_parameter(type(1.0e-3));
+
+        neural_network.set_parameters(parameters);
+
+        training_results = levenberg_marquardt_algorithm.perform_training();
+
+        const type blocks_error = training_results.get_training_error();
+
+        assert_true(blocks_error <= training_results.training_error_history(0), LOG);
+
+        levenberg_marquardt_algorithm.set_block_samples_number(1000);
+        levenberg_marquardt_algorithm.set_damping_parameter(type(1.0e-3));
+
+        neural_network.set_parameters(parameters);
+
+        training_results = levenberg_marquardt_algorithm.perform_training();
+
+        error = training_results.get_training_error();
+
+        assert_true(abs(blocks_error - error) < type(1.0e-3)*(type(1) + error), LOG);
+    }
+
+    levenberg_marquardt_algorithm.set_damped_system_solver(LevenbergMarquardtAlgorithm::DampedSystemSolver::Cholesky);
 }
 
 
@@ -160,6 +396,15 @@ void LevenbergMarquardtAlgorithmTest::run_test_case()
     test_constructor();
     test_destructor();
 
+    // Set methods
+
+    test_set_block_samples_number();
+    test_set_damped_system_solver();
+
+    // Back-propagation methods
+
+    test_back_propagate_blocks();
+
     // Training methods
 
     test_perform_training();
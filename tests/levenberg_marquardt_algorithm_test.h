@@ -28,6 +28,16 @@ public:
 
     void test_destructor();
 
+    // Set methods
+
+    void test_set_block_samples_number();
+
+    void test_set_damped_system_solver();
+
+    // Back-propagation methods
+
+    void test_back_propagate_blocks();
+
     // Training methods
 
     void test_perform_training();
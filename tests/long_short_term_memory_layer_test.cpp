@@ -107,18 +107,17 @@ void LongShortTermMemoryLayerTest::test_set_weights()
     // Test
 
     neurons_number = 2;
-    inputs_number = 1;
+    inputs_number = 2;
 
     long_short_term_memory_layer.set(inputs_number, neurons_number);
 
-    weights.resize(neurons_number, neurons_number, 4);
+    weights.resize(inputs_number, neurons_number, 4);
     weights.setConstant(type(4));
 
-    long_short_term_memory_layer.set_forget_weights(weights.slice(Eigen::array<Eigen::Index, 3>({0,0,0}), Eigen::array<Index, 3>({neurons_number,neurons_number,1})).reshape(Eigen::array<Index, 2>({neurons_number, neurons_number})));
-    long_short_term_memory_layer.set_input_weights(weights.slice(Eigen::array<Eigen::Index, 3>({0,0,1}), Eigen::array<Index, 3>({neurons_number,neurons_number,1})).reshape(Eigen::array<Index, 2>({neurons_number, neurons_number})));
-    long_short_term_memory_layer.set_state_weights(weights.slice(Eigen::array<Eigen::Index, 3>({0,0,2}), Eigen::array<Index, 3>({neurons_number,neurons_number,1})).reshape(Eigen::array<Index, 2>({neurons_number, neurons_number})));
-    long_short_term_memory_layer.set_output_weights(weights.slice(Eigen::array<Eigen::Index, 3>({0,0,3}), Eigen::array<Index, 3>({neurons_number,neurons_number,1})).reshape(Eigen::array<Index, 2>({neurons_number, neurons_number})));
-    
+    long_short_term_memory_layer.set_forget_weights(weights.slice(Eigen::array<Eigen::Index, 3>({0,0,0}), Eigen::array<Index, 3>({inputs_number,neurons_number,1})).reshape(Eigen::array<Index, 2>({inputs_number, neurons_number})));
+    long_short_term_memory_layer.set_input_weights(weights.slice(Eigen::array<Eigen::Index, 3>({0,0,1}), Eigen::array<Index, 3>({inputs_number,neurons_number,1})).reshape(Eigen::array<Index, 2>({inputs_number, neurons_number})));
+    long_short_term_memory_layer.set_state_weights(weights.slice(Eigen::array<Eigen::Index, 3>({0,0,2}), Eigen::array<Index, 3>({inputs_number,neurons_number,1})).reshape(Eigen::array<Index, 2>({inputs_number, neurons_number})));
+    long_short_term_memory_layer.set_output_weights(weights.slice(Eigen::array<Eigen::Index, 3>({0,0,3}), Eigen::array<Index, 3>({inputs_number,neurons_number,1})).reshape(Eigen::array<Index, 2>({inputs_number, neurons_number})));
 
     assert_true(long_short_term_memory_layer.get_input_weights()(0) - weights(0) < type(NUMERIC_LIMITS_MIN), LOG);
     assert_true(long_short_term_memory_layer.get_input_weights()(1) - weights(1) < type(NUMERIC_LIMITS_MIN), LOG);
@@ -356,31 +355,150 @@ void LongShortTermMemoryLayerTest::test_forward_propagate()
 {
     cout << "test_forward_propagate\n";
 
-    LongShortTermMemoryLayer long_short_term_layer;
+    // Seven samples make two sequences of three timesteps and a last sequence of one
+
+    const Index samples_number = 7;
+    const Index inputs_number = 2;
+    const Index neurons_number = 3;
+    const Index timesteps = 3;
+
+    LongShortTermMemoryLayer long_short_term_layer(inputs_number, neurons_number);
 
+    long_short_term_layer.set_timesteps(timesteps);
     long_short_term_layer.set_activation_function(LongShortTermMemoryLayer::ActivationFunction::HyperbolicTangent);
+    long_short_term_layer.set_recurrent_activation_function(LongShortTermMemoryLayer::ActivationFunction::Logistic);
+    long_short_term_layer.set_parameters_random();
 
-    Tensor<type, 1> parameters;
-    Tensor<type, 2> inputs;
-    Tensor<Index, 1> inputs_dimensions;
-    bool is_training = false;
+    Tensor<type, 2> inputs(samples_number, inputs_number);
+    inputs.setRandom();
+
+    Tensor<DynamicTensor<type>, 1> inputs_pair(1);
+    inputs_pair(0) = DynamicTensor<type>(inputs.data(), get_dimensions(inputs));
+
+    LongShortTermMemoryLayerForwardPropagation long_short_term_layer_forward_propagation(samples_number, &long_short_term_layer);
+
+    long_short_term_layer.forward_propagate(inputs_pair, &long_short_term_layer_forward_propagation, true);
+
+    const Tensor<type, 2> outputs = long_short_term_layer_forward_propagation.outputs(0).to_tensor_map<2>();
+
+    assert_true(outputs.dimension(0) == samples_number, LOG);
+    assert_true(outputs.dimension(1) == neurons_number, LOG);
+
+    // Sample by sample
+
+    const Eigen::array<IndexPair<Index>, 1> product_dimensions = {IndexPair<Index>(0, 0)};
+
+    Tensor<type, 1> hidden_states(neurons_number);
+    Tensor<type, 1> cell_states(neurons_number);
+
+    for(Index i = 0; i < samples_number; i++)
+    {
+        if(i%timesteps == 0)
+        {
+            hidden_states.setZero();
+            cell_states.setZero();
+        }
+
+        const Tensor<type, 1> sample = inputs.chip(i, 0);
+
+        const Tensor<type, 1> forget_combinations = long_short_term_layer.get_forget_biases()
+                + sample.contract(long_short_term_layer.get_forget_weights(), product_dimensions)
+                + hidden_states.contract(long_short_term_layer.get_forget_recurrent_weights(), product_dimensions);
+
+        const Tensor<type, 1> input_combinations = long_short_term_layer.get_input_biases()
+                + sample.contract(long_short_term_layer.get_input_weights(), product_dimensions)
+                + hidden_states.contract(long_short_term_layer.get_input_recurrent_weights(), product_dimensions);
+
+        const Tensor<type, 1> state_combinations = long_short_term_layer.get_state_biases()
+                + sample.contract(long_short_term_layer.get_state_weights(), product_dimensions)
+                + hidden_states.contract(long_short_term_layer.get_state_recurrent_weights(), product_dimensions);
+
+        const Tensor<type, 1> output_combinations = long_short_term_layer.get_output_biases()
+                + sample.contract(long_short_term_layer.get_output_weights(), product_dimensions)
+                + hidden_states.contract(long_short_term_layer.get_output_recurrent_weights(), product_dimensions);
+
+        const Tensor<type, 1> forget_activations = (-forget_combinations).exp().unaryExpr([](type x){return type(1)/(type(1) + x);});
+        const Tensor<type, 1> input_activations = (-input_combinations).exp().unaryExpr([](type x){return type(1)/(type(1) + x);});
+        const Tensor<type, 1> output_activations = (-output_combinations).exp().unaryExpr([](type x){return type(1)/(type(1) + x);});
+
+        cell_states = forget_activations*cell_states + input_activations*state_combinations.tanh();
+
+        hidden_states = output_activations*cell_states.tanh();
+
+        const Tensor<type, 1> sample_outputs = outputs.chip(i, 0);
+
+        assert_true(are_equal(sample_outputs, hidden_states, type(1.0e-5)), LOG);
+    }
+
+    // Deployment gives the same outputs
 
-    long_short_term_layer.set_parameters_constant(type(1));
-    inputs.setConstant(type(1));
+    long_short_term_layer.forward_propagate(inputs_pair, &long_short_term_layer_forward_propagation, false);
 
-    LongShortTermMemoryLayerForwardPropagation long_short_term_layer_forward_propagation(1, &long_short_term_layer);
+    const Tensor<type, 2> deployment_outputs = long_short_term_layer_forward_propagation.outputs(0).to_tensor_map<2>();
 
-    inputs_dimensions = get_dimensions(inputs);
+    assert_true(are_equal(deployment_outputs, outputs, type(1.0e-6)), LOG);
+}
+
+
+void LongShortTermMemoryLayerTest::test_back_propagate()
+{
+    cout << "test_back_propagate\n";
+
+    // Seven samples make two sequences of three timesteps and a last sequence of one
+
+    const Index samples_number = 7;
+    const Index inputs_number = 2;
+    const Index neurons_number = 3;
+    const Index outputs_number = 2;
+    bool is_training = true;
+
+    // Data set
+
+    DataSet data_set;
+
+    data_set.set(samples_number, inputs_number, outputs_number);
+    data_set.set_data_random();
+
+    data_set.set_training();
+
+    const Tensor<Index, 1> training_samples_indices = data_set.get_training_samples_indices();
+    const Tensor<Index, 1> input_variables_indices = data_set.get_input_variables_indices();
+    const Tensor<Index, 1> target_variables_indices = data_set.get_target_variables_indices();
+
+    DataSetBatch batch(samples_number, &data_set);
+    batch.fill(training_samples_indices, input_variables_indices, target_variables_indices);
+
+    // Neural network
 
-    Tensor<type*, 1> inputs_data(1);
-    inputs_data(0) = inputs.data();
-/*
-    long_short_term_layer.forward_propagate(inputs_data, inputs_dimensions, &long_short_term_layer_forward_propagation, is_training);
+    LongShortTermMemoryLayer* long_short_term_memory_layer = new LongShortTermMemoryLayer(inputs_number, neurons_number);
 
-    assert_true(long_short_term_layer_forward_propagation.combinations.rank() == 2, LOG);
-    assert_true(long_short_term_layer_forward_propagation.combinations.dimension(0) == 1, LOG);
-    assert_true(long_short_term_layer_forward_propagation.combinations.dimension(1) == inputs.dimension(1), LOG);
-*/
+    long_short_term_memory_layer->set_timesteps(3);
+    long_short_term_memory_layer->set_activation_function(LongShortTermMemoryLayer::ActivationFunction::HyperbolicTangent);
+    long_short_term_memory_layer->set_recurrent_activation_function(LongShortTermMemoryLayer::ActivationFunction::Logistic);
+
+    NeuralNetwork neural_network;
+
+    neural_network.add_layer(long_short_term_memory_layer);
+    neural_network.add_layer(new PerceptronLayer(neurons_number, outputs_number, PerceptronLayer::ActivationFunction::Linear));
+
+    neural_network.set_parameters_random();
+
+    NeuralNetworkForwardPropagation forward_propagation(samples_number, &neural_network);
+    neural_network.forward_propagate(batch, forward_propagation, is_training);
+
+    // Loss index
+
+    SumSquaredError sum_squared_error(&neural_network, &data_set);
+
+    sum_squared_error.set_regularization_method(LossIndex::RegularizationMethod::NoRegularization);
+
+    LossIndexBackPropagation back_propagation(samples_number, &sum_squared_error);
+    sum_squared_error.back_propagate(batch, forward_propagation, back_propagation);
+
+    const Tensor<type, 1> numerical_differentiation_gradient = sum_squared_error.calculate_numerical_differentiation_gradient();
+
+    assert_true(back_propagation.gradient.size() == neural_network.get_parameters_number(), LOG);
+    assert_true(are_equal(back_propagation.gradient, numerical_differentiation_gradient, type(1.0e-2)), LOG);
 }
 
 
@@ -423,6 +541,10 @@ void LongShortTermMemoryLayerTest::run_test_case()
 
     test_forward_propagate();
 
+    // Back propagate
+
+    test_back_propagate();
+
     cout << "End of long short-term memory layer test case.\n\n";
 }
 
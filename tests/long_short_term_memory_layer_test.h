@@ -54,6 +54,10 @@ public:
 
     void test_forward_propagate();
 
+    // Back propagate
+
+    void test_back_propagate();
+
     // Unit testing methods
 
     void run_test_case();
@@ -28,25 +28,34 @@ int main()
    "Individual Tests:\n\n"
 
    "adaptive_moment_estimation | adam\n"
+   "batch_loader | bld\n"
+   "binary_data_file | bdf\n"
    "bounding_layer | bl\n"
    "conjugate_gradient | cg\n"
    "correlations | cr\n"
    "cross_entropy_error | cee\n"
+   "csv_reader | csv\n"
    "convulational_layer | cl\n"
    "descriptives | dsc\n"
    "data_set | ds\n"
+   "data_shards | dsh\n"
+   "data_parallel | dp\n"
+   "embedding_layer | el\n"
    "flatten_layer | fl\n"
    "genetic_algorithm | ga\n"
    "gradient_descent | gd\n"
    "growing_inputs | gi\n"
    "growing_neurons | gn\n"
+   "image_augmentation | ia\n"
    "inputs_selection | is\n"
    "learning_rate_algorithm | lra\n"
    "levenberg_marquardt_algorithm | lma\n"
    "long_short_term_memory_layer | lstm\n"
    "mean_squared_error | mse\n"
+   "memory_planner | mp\n"
    "minkowski_error | me\n"
    "model_selection | ms\n"
+   "multihead_attention_layer | mal\n"
    "neural_network | nn\n"
    "neurons_selection | ns\n"
    "normalized_squared_error | nse\n"
@@ -60,10 +69,13 @@ int main()
    "scaling_layer | sl\n"
    "scaling | sc\n"
    "statistics | st\n"
+   "statistics_accumulator | sa\n"
    "stochastic_gradient_descent | sgd\n"
+   "storage_precision | spr\n"
    "sum_squared_error | sse\n"
    "tensor_utilities | tu\n"
    "testing_analysis | ta\n"
+   "training_cache | tc\n"
    "training_strategy | ts\n"
    "unscaling_layer | ul\n"
    "weighted_squared_error | wse\n"
@@ -120,6 +132,96 @@ int main()
          tests_failed_count += statistics_test.get_tests_failed_count();
       }
 
+      else if(test == "statistics_accumulator" || test == "sa")
+      {
+         StatisticsAccumulatorTest statistics_accumulator_test;
+         statistics_accumulator_test.run_test_case();
+         tests_count += statistics_accumulator_test.get_tests_count();
+         tests_passed_count += statistics_accumulator_test.get_tests_passed_count();
+         tests_failed_count += statistics_accumulator_test.get_tests_failed_count();
+      }
+
+      else if(test == "binary_data_file" || test == "bdf")
+      {
+          BinaryDataFileTest binary_data_file_test;
+          binary_data_file_test.run_test_case();
+          tests_count += binary_data_file_test.get_tests_count();
+          tests_passed_count += binary_data_file_test.get_tests_passed_count();
+          tests_failed_count += binary_data_file_test.get_tests_failed_count();
+      }
+
+      else if(test == "data_shards" || test == "dsh")
+      {
+          DataShardsTest data_shards_test;
+          data_shards_test.run_test_case();
+          tests_count += data_shards_test.get_tests_count();
+          tests_passed_count += data_shards_test.get_tests_passed_count();
+          tests_failed_count += data_shards_test.get_tests_failed_count();
+      }
+
+      else if(test == "data_parallel" || test == "dp")
+      {
+          DataParallelTest data_parallel_test;
+          data_parallel_test.run_test_case();
+          tests_count += data_parallel_test.get_tests_count();
+          tests_passed_count += data_parallel_test.get_tests_passed_count();
+          tests_failed_count += data_parallel_test.get_tests_failed_count();
+      }
+
+      else if(test == "storage_precision" || test == "spr")
+      {
+          StoragePrecisionTest storage_precision_test;
+          storage_precision_test.run_test_case();
+          tests_count += storage_precision_test.get_tests_count();
+          tests_passed_count += storage_precision_test.get_tests_passed_count();
+          tests_failed_count += storage_precision_test.get_tests_failed_count();
+      }
+
+      else if(test == "memory_planner" || test == "mp")
+      {
+          MemoryPlannerTest memory_planner_test;
+          memory_planner_test.run_test_case();
+          tests_count += memory_planner_test.get_tests_count();
+          tests_passed_count += memory_planner_test.get_tests_passed_count();
+          tests_failed_count += memory_planner_test.get_tests_failed_count();
+      }
+
+      else if(test == "training_cache" || test == "tc")
+      {
+          TrainingCacheTest training_cache_test;
+          training_cache_test.run_test_case();
+          tests_count += training_cache_test.get_tests_count();
+          tests_passed_count += training_cache_test.get_tests_passed_count();
+          tests_failed_count += training_cache_test.get_tests_failed_count();
+      }
+
+      else if(test == "image_augmentation" || test == "ia")
+      {
+          ImageAugmentationTest image_augmentation_test;
+          image_augmentation_test.run_test_case();
+          tests_count += image_augmentation_test.get_tests_count();
+          tests_passed_count += image_augmentation_test.get_tests_passed_count();
+          tests_failed_count += image_augmentation_test.get_tests_failed_count();
+      }
+
+      else if(test == "batch_loader" || test == "bld")
+      {
+          BatchLoaderTest batch_loader_test;
+          batch_loader_test.run_test_case();
+          tests_count += batch_loader_test.get_tests_count();
+          tests_passed_count += batch_loader_test.get_tests_passed_count();
+          tests_failed_count += batch_loader_test.get_tests_failed_count();
+      }
+
+      else if(test == "csv_reader" || test == "csv")
+      {
+          CsvReaderTest csv_reader_test;
+          csv_reader_test.run_test_case();
+          tests_count += csv_reader_test.get_tests_count();
+          tests_passed_count += csv_reader_test.get_tests_passed_count();
+          tests_failed_count += csv_reader_test.get_tests_failed_count();
+      }
+
       else if(test == "data_set" || test == "ds")
       {
           DataSetTest data_set_test;
@@ -229,6 +331,24 @@ int main()
          tests_failed_count += layer_test.get_tests_failed_count();
       }
 
+      else if(test == "embedding_layer" || test == "el")
+      {
+         EmbeddingLayerTest layer_test;
+         layer_test.run_test_case();
+         tests_count += layer_test.get_tests_count();
+         tests_passed_count += layer_test.get_tests_passed_count();
+         tests_failed_count += layer_test.get_tests_failed_count();
+      }
+
+      else if(test == "multihead_attention_layer" || test == "mal")
+      {
+         MultiheadAttentionLayerTest layer_test;
+         layer_test.run_test_case();
+         tests_count += layer_test.get_tests_count();
+         tests_passed_count += layer_test.get_tests_passed_count();
+         tests_failed_count += layer_test.get_tests_failed_count();
+      }
+
       else if(test == "flatten_layer" || test == "fl")
       {
          FlattenLayerTest layer_test;
@@ -481,6 +601,14 @@ int main()
           tests_passed_count += statistics_test.get_tests_passed_count();
           tests_failed_count += statistics_test.get_tests_failed_count();
 
+          // statistics accumulator
+
+          StatisticsAccumulatorTest statistics_accumulator_test;
+          statistics_accumulator_test.run_test_case();
+          tests_count += statistics_accumulator_test.get_tests_count();
+          tests_passed_count += statistics_accumulator_test.get_tests_passed_count();
+          tests_failed_count += statistics_accumulator_test.get_tests_failed_count();
+
           // scaling
 
           ScalingTest scaling_test;
@@ -489,6 +617,22 @@ int main()
           tests_passed_count += scaling_test.get_tests_passed_count();
           tests_failed_count += scaling_test.get_tests_failed_count();
 
+          // csv reader
+
+          CsvReaderTest csv_reader_test;
+          csv_reader_test.run_test_case();
+          tests_count += csv_reader_test.get_tests_count();
+          tests_passed_count += csv_reader_test.get_tests_passed_count();
+          tests_failed_count += csv_reader_test.get_tests_failed_count();
+
+          // binary data file
+
+          BinaryDataFileTest binary_data_file_test;
+          binary_data_file_test.run_test_case();
+          tests_count += binary_data_file_test.get_tests_count();
+          tests_passed_count += binary_data_file_test.get_tests_passed_count();
+          tests_failed_count += binary_data_file_test.get_tests_failed_count();
+
           // data set
 
           DataSetTest data_set_test;
@@ -497,6 +641,62 @@ int main()
           tests_passed_count += data_set_test.get_tests_passed_count();
           tests_failed_count += data_set_test.get_tests_failed_count();
 
+          // data shards
+
+          DataShardsTest data_shards_test;
+          data_shards_test.run_test_case();
+          tests_count += data_shards_test.get_tests_count();
+          tests_passed_count += data_shards_test.get_tests_passed_count();
+          tests_failed_count += data_shards_test.get_tests_failed_count();
+
+          // data parallel
+
+          DataParallelTest data_parallel_test;
+          data_parallel_test.run_test_case();
+          tests_count += data_parallel_test.get_tests_count();
+          tests_passed_count += data_parallel_test.get_tests_passed_count();
+          tests_failed_count += data_parallel_test.get_tests_failed_count();
+
+          // storage precision
+
+          StoragePrecisionTest storage_precision_test;
+          storage_precision_test.run_test_case();
+          tests_count += storage_precision_test.get_tests_count();
+          tests_passed_count += storage_precision_test.get_tests_passed_count();
+          tests_failed_count += storage_precision_test.get_tests_failed_count();
+
+          // memory planner
+
+          MemoryPlannerTest memory_planner_test;
+          memory_planner_test.run_test_case();
+          tests_count += memory_planner_test.get_tests_count();
+          tests_passed_count += memory_planner_test.get_tests_passed_count();
+          tests_failed_count += memory_planner_test.get_tests_failed_count();
+
+          // training cache
+
+          TrainingCacheTest training_cache_test;
+          training_cache_test.run_test_case();
+          tests_count += training_cache_test.get_tests_count();
+          tests_passed_count += training_cache_test.get_tests_passed_count();
+          tests_failed_count += training_cache_test.get_tests_failed_count();
+
+          // image augmentation
+
+          ImageAugmentationTest image_augmentation_test;
+          image_augmentation_test.run_test_case();
+          tests_count += image_augmentation_test.get_tests_count();
+          tests_passed_count += image_augmentation_test.get_tests_passed_count();
+          tests_failed_count += image_augmentation_test.get_tests_failed_count();
+
+          // batch loader
+
+          BatchLoaderTest batch_loader_test;
+          batch_loader_test.run_test_case();
+          tests_count += batch_loader_test.get_tests_count();
+          tests_passed_count += batch_loader_test.get_tests_passed_count();
+          tests_failed_count += batch_loader_test.get_tests_failed_count();
+
           // N E U R A L   N E T W O R K   T E S T S
 
           // perceptron layer
@@ -579,6 +779,22 @@ int main()
           tests_passed_count += flatten_layer_test.get_tests_passed_count();
           tests_failed_count += flatten_layer_test.get_tests_failed_count();
 
+          // Embedding layer
+
+          EmbeddingLayerTest embedding_layer_test;
+          embedding_layer_test.run_test_case();
+          tests_count += embedding_layer_test.get_tests_count();
+          tests_passed_count += embedding_layer_test.get_tests_passed_count();
+          tests_failed_count += embedding_layer_test.get_tests_failed_count();
+
+          // Multihead attention layer
+
+          MultiheadAttentionLayerTest multihead_attention_layer_test;
+          multihead_attention_layer_test.run_test_case();
+          tests_count += multihead_attention_layer_test.get_tests_count();
+          tests_passed_count += multihead_attention_layer_test.get_tests_passed_count();
+          tests_failed_count += multihead_attention_layer_test.get_tests_failed_count();
+
           // neural network
 
           NeuralNetworkTest neural_network_test;
@@ -0,0 +1,211 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   M E M O R Y   P L A N N E R   T E S T   C L A S S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "memory_planner_test.h"
+
+
+MemoryPlannerTest::MemoryPlannerTest() : UnitTesting()
+{
+}
+
+
+MemoryPlannerTest::~MemoryPlannerTest()
+{
+}
+
+
+void MemoryPlannerTest::test_add_buffer()
+{
+    cout << "test_add_buffer\n";
+
+    const Index size = MemoryPlanner::get_aligned_size(10);
+
+    // Test
+
+    memory_planner.set();
+
+    assert_true(memory_planner.get_buffers_number() == 0, LOG);
+    assert_true(memory_planner.get_buffers_size() == 0, LOG);
+
+    assert_true(memory_planner.add_buffer(10, 0, 1) == 0, LOG);
+    assert_true(memory_planner.add_buffer(size, 1, 1) == 1, LOG);
+
+    assert_true(memory_planner.get_buffers_number() == 2, LOG);
+    assert_true(size >= 10, LOG);
+    assert_true(memory_planner.get_buffers_size() == 2*size, LOG);
+
+    // Test
+
+    bool has_thrown = false;
+
+    try
+    {
+        memory_planner.add_buffer(-1, 0, 1);
+    }
+    catch(const invalid_argument&)
+    {
+        has_thrown = true;
+    }
+
+    assert_true(has_thrown, LOG);
+
+    // Test
+
+    has_thrown = false;
+
+    try
+    {
+        memory_planner.add_buffer(size, 2, 1);
+    }
+    catch(const invalid_argument&)
+    {
+        has_thrown = true;
+    }
+
+    assert_true(has_thrown, LOG);
+    assert_true(memory_planner.get_buffers_number() == 2, LOG);
+
+    // Test
+
+    memory_planner.set();
+
+    assert_true(memory_planner.get_buffers_number() == 0, LOG);
+    assert_true(memory_planner.get_arena_size() == 0, LOG);
+}
+
+
+void MemoryPlannerTest::test_plan_inference()
+{
+    cout << "test_plan_inference\n";
+
+    const Index size = MemoryPlanner::get_aligned_size(10);
+
+    // Test
+
+    memory_planner.set();
+
+    memory_planner.plan(MemoryPlanner::Mode::Inference);
+
+    assert_true(memory_planner.get_offsets().size() == 0, LOG);
+    assert_true(memory_planner.get_arena_size() == 0, LOG);
+
+    // Test
+
+    memory_planner.set();
+
+    const Index first_buffer = memory_planner.add_buffer(size, 0, 1);
+    const Index second_buffer = memory_planner.add_buffer(size, 1, 2);
+    const Index third_buffer = memory_planner.add_buffer(size, 2, 3);
+
+    memory_planner.plan(MemoryPlanner::Mode::Inference);
+
+    const Index first_offset = memory_planner.get_offset(first_buffer);
+    const Index second_offset = memory_planner.get_offset(second_buffer);
+    const Index third_offset = memory_planner.get_offset(third_buffer);
+
+    // The first and third buffers are never alive at the same time
+
+    assert_true(first_offset == third_offset, LOG);
+
+    // The second buffer overlaps both of them
+
+    assert_true(second_offset + size <= first_offset || first_offset + size <= second_offset, LOG);
+
+    assert_true(memory_planner.get_arena_size() == 2*size, LOG);
+    assert_true(memory_planner.get_arena_size() < memory_planner.get_buffers_size(), LOG);
+
+    // Test
+
+    memory_planner.set();
+
+    const Index large_buffer = memory_planner.add_buffer(2*size, 0, 2);
+    const Index small_buffer = memory_planner.add_buffer(size, 1, 1);
+
+    memory_planner.plan(MemoryPlanner::Mode::Inference);
+
+    assert_true(memory_planner.get_offset(large_buffer) == 0, LOG);
+    assert_true(memory_planner.get_offset(small_buffer) == 2*size, LOG);
+    assert_true(memory_planner.get_arena_size() == 3*size, LOG);
+}
+
+
+void MemoryPlannerTest::test_plan_training()
+{
+    cout << "test_plan_training\n";
+
+    const Index size = MemoryPlanner::get_aligned_size(10);
+
+    // Test
+
+    memory_planner.set();
+
+    memory_planner.add_buffer(size, 0, 1);
+    memory_planner.add_buffer(size, 1, 2);
+    memory_planner.add_buffer(size, 2, 3);
+    memory_planner.add_buffer(2*size, 3, 3);
+
+    memory_planner.plan(MemoryPlanner::Mode::Training);
+
+    const Index buffers_number = memory_planner.get_buffers_number();
+
+    assert_true(memory_planner.get_arena_size() == memory_planner.get_buffers_size(), LOG);
+
+    for(Index i = 0; i < buffers_number; i++)
+    {
+        for(Index j = i+1; j < buffers_number; j++)
+        {
+            assert_true(memory_planner.get_offset(i) != memory_planner.get_offset(j), LOG);
+        }
+    }
+
+    // Test
+
+    memory_planner.plan(MemoryPlanner::Mode::Inference);
+
+    assert_true(memory_planner.get_arena_size() < memory_planner.get_buffers_size(), LOG);
+
+    memory_planner.plan(MemoryPlanner::Mode::Training);
+
+    assert_true(memory_planner.get_arena_size() == memory_planner.get_buffers_size(), LOG);
+}
+
+
+void MemoryPlannerTest::run_test_case()
+{
+    cout << "Running memory planner test case...\n";
+
+    // Set methods
+
+    test_add_buffer();
+
+    // Planning methods
+
+    test_plan_inference();
+
+    test_plan_training();
+
+    cout << "End of memory planner test case.\n\n";
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -0,0 +1,62 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   M E M O R Y   P L A N N E R   T E S T   C L A S S   H E A D E R
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#ifndef MEMORYPLANNERTEST_H
+#define MEMORYPLANNERTEST_H
+
+// Unit testing includes
+
+#include "../opennn/unit_testing.h"
+
+class MemoryPlannerTest : public UnitTesting
+{
+
+public:
+
+   explicit MemoryPlannerTest();
+
+   virtual ~MemoryPlannerTest();
+
+   // Set methods
+
+   void test_add_buffer();
+
+   // Planning methods
+
+   void test_plan_inference();
+
+   void test_plan_training();
+
+   // Unit testing methods
+
+   void run_test_case();
+
+private:
+
+   MemoryPlanner memory_planner;
+};
+
+#endif
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -0,0 +1,560 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   M U L T I H E A D   A T T E N T I O N   L A Y E R   T E S T   C L A S S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "multihead_attention_layer_test.h"
+
+
+MultiheadAttentionLayerTest::MultiheadAttentionLayerTest() : UnitTesting()
+{
+}
+
+
+MultiheadAttentionLayerTest::~MultiheadAttentionLayerTest()
+{
+}
+
+
+/// Computes the attention outputs materializing the scores of each query, as a reference for the tiled computation.
+
+Tensor<type, 4> calculate_attention_outputs(const Tensor<type, 4>& query,
+                                            const Tensor<type, 4>& key,
+                                            const Tensor<type, 4>& value,
+                                            const bool& causal_mask)
+{
+    const Index batch_size = query.dimension(0);
+    const Index input_size = query.dimension(1);
+    const Index depth = query.dimension(2);
+    const Index number_of_heads = query.dimension(3);
+    const Index context_size = key.dimension(1);
+
+    Tensor<type, 4> attention_outputs(batch_size, input_size, depth, number_of_heads);
+    attention_outputs.setZero();
+
+    Tensor<type, 1> scores(context_size);
+
+    for(Index b = 0; b < batch_size; b++)
+    {
+        for(Index h = 0; h < number_of_heads; h++)
+        {
+            for(Index i = 0; i < input_size; i++)
+            {
+                const Index keys_number = causal_mask ? min(i + 1, context_size) : context_size;
+
+                type maximum = -numeric_limits<type>::infinity();
+
+                for(Index j = 0; j < keys_number; j++)
+                {
+                    scores(j) = type(0);
+
+                    for(Index d = 0; d < depth; d++)
+                        scores(j) += query(b, i, d, h)*key(b, j, d, h)/sqrt(type(depth));
+
+                    maximum = max(maximum, scores(j));
+                }
+
+                type sum = type(0);
+
+                for(Index j = 0; j < keys_number; j++)
+                {
+                    scores(j) = exp(scores(j) - maximum);
+                    sum += scores(j);
+                }
+
+                for(Index j = 0; j < keys_number; j++)
+                    for(Index d = 0; d < depth; d++)
+                        attention_outputs(b, i, d, h) += scores(j)/sum*value(b, j, d, h);
+            }
+        }
+    }
+
+    return attention_outputs;
+}
+
+
+/// Returns the largest absolute difference between the elements of two tensors.
+
+type get_maximum_difference(const Tensor<type, 4>& tensor_1, const Tensor<type, 4>& tensor_2)
+{
+    const Tensor<type, 0> maximum_difference = (tensor_1 - tensor_2).abs().maximum();
+
+    return maximum_difference(0);
+}
+
+
+type get_maximum_difference(const Tensor<type, 3>& tensor_1, const Tensor<type, 3>& tensor_2)
+{
+    const Tensor<type, 0> maximum_difference = (tensor_1 - tensor_2).abs().maximum();
+
+    return maximum_difference(0);
+}
+
+
+void MultiheadAttentionLayerTest::test_constructor()
+{
+    cout << "test_constructor\n";
+
+    // Default constructor
+
+    MultiheadAttentionLayer multihead_attention_layer_1;
+
+    assert_true(multihead_attention_layer_1.get_parameters_number() == 0, LOG);
+    assert_true(!multihead_attention_layer_1.get_causal_mask(), LOG);
+
+    // Architecture constructor
+
+    MultiheadAttentionLayer multihead_attention_layer_2(5, 7, 4, 2);
+
+    assert_true(multihead_attention_layer_2.get_input_size() == 5, LOG);
+    assert_true(multihead_attention_layer_2.get_context_size() == 7, LOG);
+    assert_true(multihead_attention_layer_2.get_parameters_number() == 4*4*4*2, LOG);
+}
+
+
+void MultiheadAttentionLayerTest::test_destructor()
+{
+    cout << "test_destructor\n";
+
+    MultiheadAttentionLayer* multihead_attention_layer_1 = new MultiheadAttentionLayer;
+
+    delete multihead_attention_layer_1;
+}
+
+
+void MultiheadAttentionLayerTest::test_forward_propagate()
+{
+    cout << "test_forward_propagate\n";
+
+    const Index batch_samples_number = 3;
+    const Index input_size = 5;
+    const Index context_size = 7;
+    const Index depth = 4;
+    const Index number_of_heads = 2;
+
+    Tensor<type, 3> query(batch_samples_number, input_size, depth);
+    Tensor<type, 3> key(batch_samples_number, context_size, depth);
+    Tensor<type, 3> value(batch_samples_number, context_size, depth);
+
+    query.setRandom();
+    key.setRandom();
+    value.setRandom();
+
+    Tensor<DynamicTensor<type>, 1> inputs(3);
+    inputs(0) = DynamicTensor<type>(query.data(), get_dimensions(query));
+    inputs(1) = DynamicTensor<type>(key.data(), get_dimensions(key));
+    inputs(2) = DynamicTensor<type>(value.data(), get_dimensions(value));
+
+    multihead_attention_layer.set(input_size, context_size, depth, number_of_heads);
+
+    // Tiles which do not divide the sequences
+
+    multihead_attention_layer.set_tile_sizes(2, 3);
+
+    MultiheadAttentionLayerForwardPropagation multihead_attention_layer_forward_propagation(batch_samples_number,
+                                                                                            &multihead_attention_layer);
+
+    // Test without causal mask
+
+    multihead_attention_layer.forward_propagate(inputs, &multihead_attention_layer_forward_propagation, true);
+
+    Tensor<type, 4> attention_outputs = calculate_attention_outputs(multihead_attention_layer_forward_propagation.transformed_query,
+                                                                    multihead_attention_layer_forward_propagation.transformed_key,
+                                                                    multihead_attention_layer_forward_propagation.transformed_value,
+                                                                    false);
+
+    assert_true(get_maximum_difference(multihead_attention_layer_forward_propagation.attention_outputs, attention_outputs) < type(1.0e-5), LOG);
+
+    // Test with causal mask
+
+    multihead_attention_layer.set_causal_mask(true);
+
+    multihead_attention_layer.forward_propagate(inputs, &multihead_attention_layer_forward_propagation, true);
+
+    attention_outputs = calculate_attention_outputs(multihead_attention_layer_forward_propagation.transformed_query,
+                                                    multihead_attention_layer_forward_propagation.transformed_key,
+                                                    multihead_attention_layer_forward_propagation.transformed_value,
+                                                    true);
+
+    assert_true(get_maximum_difference(multihead_attention_layer_forward_propagation.attention_outputs, attention_outputs) < type(1.0e-5), LOG);
+
+    // Test untiled
+
+    multihead_attention_layer.set_tile_sizes(input_size, context_size);
+
+    Tensor<type, 4> tiled_attention_outputs = multihead_attention_layer_forward_propagation.attention_outputs;
+
+    multihead_attention_layer.forward_propagate(inputs, &multihead_attention_layer_forward_propagation, true);
+
+    assert_true(get_maximum_difference(multihead_attention_layer_forward_propagation.attention_outputs, tiled_attention_outputs) < type(1.0e-5), LOG);
+}
+
+
+void MultiheadAttentionLayerTest::test_calculate_attention_derivatives()
+{
+    cout << "test_calculate_attention_derivatives\n";
+
+    const Index batch_samples_number = 2;
+    const Index input_size = 5;
+    const Index context_size = 5;
+    const Index depth = 3;
+    const Index number_of_heads = 2;
+
+    Tensor<type, 4> query(batch_samples_number, input_size, depth, number_of_heads);
+    Tensor<type, 4> key(batch_samples_number, context_size, depth, number_of_heads);
+    Tensor<type, 4> value(batch_samples_number, context_size, depth, number_of_heads);
+
+    Tensor<type, 4> attention_outputs(batch_samples_number, input_size, depth, number_of_heads);
+    Tensor<type, 3> softmax_logsumexp(batch_samples_number, input_size, number_of_heads);
+
+    Tensor<type, 4> attention_outputs_derivatives(batch_samples_number, input_size, depth, number_of_heads);
+
+    Tensor<type, 4> query_derivatives(batch_samples_number, input_size, depth, number_of_heads);
+    Tensor<type, 4> key_derivatives(batch_samples_number, context_size, depth, number_of_heads);
+    Tensor<type, 4> value_derivatives(batch_samples_number, context_size, depth, number_of_heads);
+
+    multihead_attention_layer.set(input_size, context_size, depth, number_of_heads);
+    multihead_attention_layer.set_tile_sizes(2, 3);
+
+    // The error is the sum of the outputs weighted by their derivatives
+
+    const auto calculate_error = [&]() -> type
+    {
+        multihead_attention_layer.compute_attention_outputs(query.data(), key.data(), value.data(), batch_samples_number,
+                                                            attention_outputs.data(), softmax_logsumexp.data());
+
+        const Tensor<type, 0> error = (attention_outputs*attention_outputs_derivatives).sum();
+
+        return error(0);
+    };
+
+    const auto calculate_numerical_derivatives = [&](Tensor<type, 4>& variables) -> Tensor<type, 4>
+    {
+        const type h = type(1.0e-2);
+
+        Tensor<type, 4> numerical_derivatives(variables.dimensions());
+
+        for(Index i = 0; i < variables.size(); i++)
+        {
+            const type variable = variables(i);
+
+            variables(i) = variable + h;
+            const type error_forward = calculate_error();
+
+            variables(i) = variable - h;
+            const type error_backward = calculate_error();
+
+            variables(i) = variable;
+
+            numerical_derivatives(i) = (error_forward - error_backward)/(type(2)*h);
+        }
+
+        return numerical_derivatives;
+    };
+
+    for(const bool causal_mask : {false, true})
+    {
+        multihead_attention_layer.set_causal_mask(causal_mask);
+
+        query.setRandom();
+        key.setRandom();
+        value.setRandom();
+        attention_outputs_derivatives.setRandom();
+
+        calculate_error();
+
+        multihead_attention_layer.compute_attention_outputs_derivatives(query.data(), key.data(), value.data(),
+                                                                        attention_outputs.data(), softmax_logsumexp.data(),
+                                                                        attention_outputs_derivatives.data(),
+                                                                        batch_samples_number,
+                                                                        query_derivatives.data(),
+                                                                        key_derivatives.data(),
+                                                                        value_derivatives.data());
+
+        assert_true(get_maximum_difference(query_derivatives, calculate_numerical_derivatives(query)) < type(1.0e-2), LOG);
+        assert_true(get_maximum_difference(key_derivatives, calculate_numerical_derivatives(key)) < type(1.0e-2), LOG);
+        assert_true(get_maximum_difference(value_derivatives, calculate_numerical_derivatives(value)) < type(1.0e-2), LOG);
+    }
+}
+
+
+void MultiheadAttentionLayerTest::test_calculate_error_gradient()
+{
+    cout << "test_calculate_error_gradient\n";
+
+    const Index batch_samples_number = 2;
+    const Index input_size = 4;
+    const Index context_size = 5;
+    const Index depth = 3;
+    const Index number_of_heads = 2;
+
+    Tensor<type, 3> query(batch_samples_number, input_size, depth);
+    Tensor<type, 3> key(batch_samples_number, context_size, depth);
+    Tensor<type, 3> value(batch_samples_number, context_size, depth);
+
+    query.setRandom();
+    key.setRandom();
+    value.setRandom();
+
+    Tensor<DynamicTensor<type>, 1> inputs(3);
+    inputs(0) = DynamicTensor<type>(query.data(), get_dimensions(query));
+    inputs(1) = DynamicTensor<type>(key.data(), get_dimensions(key));
+    inputs(2) = DynamicTensor<type>(value.data(), get_dimensions(value));
+
+    multihead_attention_layer.set(input_size, context_size, depth, number_of_heads);
+    multihead_attention_layer.set_tile_sizes(3, 2);
+
+    MultiheadAttentionLayerForwardPropagation multihead_attention_layer_forward_propagation(batch_samples_number,
+                                                                                            &multihead_attention_layer);
+
+    MultiheadAttentionLayerBackPropagation multihead_attention_layer_back_propagation(batch_samples_number,
+                                                                                      &multihead_attention_layer);
+
+    TensorMap<Tensor<type, 3>> deltas(multihead_attention_layer_back_propagation.deltas_data, batch_samples_number, input_size, depth);
+
+    const Index parameters_number = multihead_attention_layer.get_parameters_number();
+
+    Tensor<type, 1> gradient(parameters_number);
+
+    // The error is the sum of the outputs weighted by their deltas
+
+    const auto calculate_error = [&]() -> type
+    {
+        multihead_attention_layer.forward_propagate(inputs, &multihead_attention_layer_forward_propagation, true);
+
+        const Tensor<type, 0> error
+            = (multihead_attention_layer_forward_propagation.outputs(0).to_tensor_map<3>()*deltas).sum();
+
+        return error(0);
+    };
+
+    for(const bool causal_mask : {false, true})
+    {
+        multihead_attention_layer.set_causal_mask(causal_mask);
+
+        multihead_attention_layer.set_parameters_random();
+
+        deltas.setRandom();
+
+        Tensor<type, 1> parameters = multihead_attention_layer.get_parameters();
+
+        assert_true(parameters.size() == parameters_number, LOG);
+
+        calculate_error();
+
+        multihead_attention_layer.calculate_inputs_derivatives(&multihead_attention_layer_forward_propagation,
+                                                               &multihead_attention_layer_back_propagation);
+
+        multihead_attention_layer.calculate_error_gradient(query.data(),
+                                                           &multihead_attention_layer_forward_propagation,
+                                                           &multihead_attention_layer_back_propagation);
+
+        multihead_attention_layer.insert_gradient(&multihead_attention_layer_back_propagation, 0, gradient);
+
+        // Numerical differentiation of the error with respect to the parameters
+
+        const type h = type(1.0e-2);
+
+        Tensor<type, 1> numerical_gradient(parameters_number);
+
+        for(Index i = 0; i < parameters_number; i++)
+        {
+            const type parameter = parameters(i);
+
+            parameters(i) = parameter + h;
+            multihead_attention_layer.set_parameters(parameters, 0);
+            const type error_forward = calculate_error();
+
+            parameters(i) = parameter - h;
+            multihead_attention_layer.set_parameters(parameters, 0);
+            const type error_backward = calculate_error();
+
+            parameters(i) = parameter;
+
+            numerical_gradient(i) = (error_forward - error_backward)/(type(2)*h);
+        }
+
+        multihead_attention_layer.set_parameters(parameters, 0);
+
+        assert_true(are_equal(multihead_attention_layer.get_parameters(), parameters, type(0)), LOG);
+        assert_true(are_equal(gradient, numerical_gradient, type(1.0e-2)), LOG);
+    }
+}
+
+
+void MultiheadAttentionLayerTest::test_calculate_inputs_derivatives()
+{
+    cout << "test_calculate_inputs_derivatives\n";
+
+    const Index batch_samples_number = 2;
+    const Index input_size = 4;
+    const Index context_size = 3;
+    const Index depth = 3;
+    const Index number_of_heads = 2;
+
+    Tensor<type, 3> query(batch_samples_number, input_size, depth);
+    Tensor<type, 3> key(batch_samples_number, context_size, depth);
+    Tensor<type, 3> value(batch_samples_number, context_size, depth);
+
+    query.setRandom();
+    key.setRandom();
+    value.setRandom();
+
+    Tensor<DynamicTensor<type>, 1> inputs(3);
+    inputs(0) = DynamicTensor<type>(query.data(), get_dimensions(query));
+    inputs(1) = DynamicTensor<type>(key.data(), get_dimensions(key));
+    inputs(2) = DynamicTensor<type>(value.data(), get_dimensions(value));
+
+    multihead_attention_layer.set(input_size, context_size, depth, number_of_heads);
+    multihead_attention_layer.set_tile_sizes(3, 2);
+    multihead_attention_layer.set_causal_mask(false);
+
+    MultiheadAttentionLayerForwardPropagation multihead_attention_layer_forward_propagation(batch_samples_number,
+                                                                                            &multihead_attention_layer);
+
+    MultiheadAttentionLayerBackPropagation multihead_attention_layer_back_propagation(batch_samples_number,
+                                                                                      &multihead_attention_layer);
+
+    TensorMap<Tensor<type, 3>> deltas(multihead_attention_layer_back_propagation.deltas_data, batch_samples_number, input_size, depth);
+
+    deltas.setRandom();
+
+    // The error is the sum of the outputs weighted by their deltas
+
+    const auto calculate_error = [&]() -> type
+    {
+        multihead_attention_layer.forward_propagate(inputs, &multihead_attention_layer_forward_propagation, true);
+
+        const Tensor<type, 0> error
+            = (multihead_attention_layer_forward_propagation.outputs(0).to_tensor_map<3>()*deltas).sum();
+
+        return error(0);
+    };
+
+    const auto calculate_numerical_derivatives = [&](Tensor<type, 3>& variables) -> Tensor<type, 3>
+    {
+        const type h = type(1.0e-2);
+
+        Tensor<type, 3> numerical_derivatives(variables.dimensions());
+
+        for(Index i = 0; i < variables.size(); i++)
+        {
+            const type variable = variables(i);
+
+            variables(i) = variable + h;
+            const type error_forward = calculate_error();
+
+            variables(i) = variable - h;
+            const type error_backward = calculate_error();
+
+            variables(i) = variable;
+
+            numerical_derivatives(i) = (error_forward - error_backward)/(type(2)*h);
+        }
+
+        return numerical_derivatives;
+    };
+
+    calculate_error();
+
+    multihead_attention_layer.calculate_inputs_derivatives(&multihead_attention_layer_forward_propagation,
+                                                           &multihead_attention_layer_back_propagation);
+
+    Tensor<type, 3> query_derivatives = multihead_attention_layer_back_propagation.query_derivatives;
+    Tensor<type, 3> key_derivatives = multihead_attention_layer_back_propagation.key_derivatives;
+    Tensor<type, 3> value_derivatives = multihead_attention_layer_back_propagation.value_derivatives;
+
+    assert_true(get_maximum_difference(query_derivatives, calculate_numerical_derivatives(query)) < type(1.0e-2), LOG);
+    assert_true(get_maximum_difference(key_derivatives, calculate_numerical_derivatives(key)) < type(1.0e-2), LOG);
+    assert_true(get_maximum_difference(value_derivatives, calculate_numerical_derivatives(value)) < type(1.0e-2), LOG);
+
+    // An inference forward propagation does not keep the inputs
+
+    multihead_attention_layer.forward_propagate(inputs, &multihead_attention_layer_forward_propagation, false);
+
+    assert_true(multihead_attention_layer_forward_propagation.query_data == nullptr, LOG);
+
+    try
+    {
+        multihead_attention_layer.calculate_error_gradient(query.data(),
+                                                           &multihead_attention_layer_forward_propagation,
+                                                           &multihead_attention_layer_back_propagation);
+
+        assert_true(false, LOG);
+    }
+    catch(const invalid_argument&)
+    {
+        assert_true(true, LOG);
+    }
+
+    // Only embedding and multihead attention layers can feed a multihead attention layer
+
+    NeuralNetwork neural_network;
+
+    neural_network.add_layer(new PerceptronLayer(depth, depth));
+    neural_network.add_layer(new MultiheadAttentionLayer(input_size, input_size, depth, number_of_heads));
+
+    Tensor<Index, 1> attention_inputs_indices(3);
+    attention_inputs_indices.setValues({0, 0, 0});
+
+    neural_network.set_layer_inputs_indices(1, attention_inputs_indices);
+
+    NeuralNetworkBackPropagation neural_network_back_propagation;
+
+    try
+    {
+        neural_network_back_propagation.set(batch_samples_number, &neural_network);
+
+        assert_true(false, LOG);
+    }
+    catch(const invalid_argument&)
+    {
+        assert_true(true, LOG);
+    }
+}
+
+
+void MultiheadAttentionLayerTest::run_test_case()
+{
+    cout << "Running multihead attention layer test case...\n";
+
+    // Constructor and destructor
+
+    test_constructor();
+    test_destructor();
+
+    // Forward propagate
+
+    test_forward_propagate();
+
+    // Back-propagation
+
+    test_calculate_attention_derivatives();
+
+    test_calculate_error_gradient();
+
+    test_calculate_inputs_derivatives();
+
+    cout << "End of multihead attention layer test case.\n\n";
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
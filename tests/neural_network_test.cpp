@@ -162,43 +162,13 @@ void NeuralNetworkTest::test_add_layer()
 {
     cout << "test_add_layer\n";
 
-//    ScalingLayer* scaling_layer_pointer = new ScalingLayer;
-
-//    LongShortTermMemoryLayer* long_short_term_memory_layer_pointer = new LongShortTermMemoryLayer;
-
-//    RecurrentLayer* recurrent_layer_pointer = new RecurrentLayer;
-
-//    PerceptronLayer* perceptron_layer_pointer = new PerceptronLayer;
-
-//    ProbabilisticLayer* probabilistic_layer_pointer = new ProbabilisticLayer;
-
-//    UnscalingLayer* unscaling_layer_pointer = new UnscalingLayer;
-
-//    BoundingLayer* bounding_layer_pointer = new BoundingLayer;
-
-    ScalingLayer scaling_layer = ScalingLayer();
-
-    LongShortTermMemoryLayer lstm_layer = LongShortTermMemoryLayer();
-
-    RecurrentLayer recurrent_layer = RecurrentLayer();
-
-    PerceptronLayer perceptron_layer = PerceptronLayer();
-
-    ProbabilisticLayer probabilistic_layer = ProbabilisticLayer();
-
-    UnscalingLayer unscaling_layer = UnscalingLayer();
-
-    BoundingLayer bounding_layer = BoundingLayer();
-
-    //   ConvolutionalLayer* convolutional_layer_pointer = new ConvolutionalLayer;
-
-    //   PoolingLayer* pooling_layer_pointer = new PoolingLayer;
+    // The neural network owns its layers and deletes them when it is set again
 
     // Scaling Layer
 
     neural_network.set();
 
-    neural_network.add_layer(&scaling_layer);
+    neural_network.add_layer(new ScalingLayer);
     assert_true(neural_network.get_layers_number() == 1, LOG);
     assert_true(neural_network.get_layer_pointer(0)->get_type() == Layer::Type::Scaling, LOG);
 
@@ -206,7 +176,7 @@ void NeuralNetworkTest::test_add_layer()
 
     neural_network.set();
 
-    neural_network.add_layer(&lstm_layer);
+    neural_network.add_layer(new LongShortTermMemoryLayer);
     assert_true(neural_network.get_layers_number() == 1, LOG);
     assert_true(neural_network.get_layer_pointer(0)->get_type() == Layer::Type::LongShortTermMemory, LOG);
 
@@ -214,7 +184,7 @@ void NeuralNetworkTest::test_add_layer()
 
     neural_network.set();
 
-    neural_network.add_layer(&recurrent_layer);
+    neural_network.add_layer(new RecurrentLayer);
     assert_true(neural_network.get_layers_number() == 1, LOG);
     assert_true(neural_network.get_layer_pointer(0)->get_type() == Layer::Type::Recurrent, LOG);
 
@@ -222,7 +192,7 @@ void NeuralNetworkTest::test_add_layer()
 
     neural_network.set();
 
-    neural_network.add_layer(&perceptron_layer);
+    neural_network.add_layer(new PerceptronLayer);
     assert_true(neural_network.get_layers_number() == 1, LOG);
     assert_true(neural_network.get_layer_pointer(0)->get_type() == Layer::Type::Perceptron, LOG);
 
@@ -230,7 +200,7 @@ void NeuralNetworkTest::test_add_layer()
 
     neural_network.set();
 
-    neural_network.add_layer(&probabilistic_layer);
+    neural_network.add_layer(new ProbabilisticLayer);
     assert_true(neural_network.get_layers_number() == 1, LOG);
     assert_true(neural_network.get_layer_pointer(0)->get_type() == Layer::Type::Probabilistic, LOG);
 
@@ -238,7 +208,7 @@ void NeuralNetworkTest::test_add_layer()
 
     neural_network.set();
 
-    neural_network.add_layer(&unscaling_layer);
+    neural_network.add_layer(new UnscalingLayer);
     assert_true(neural_network.get_layers_number() == 1, LOG);
     assert_true(neural_network.get_layer_pointer(0)->get_type() == Layer::Type::Unscaling, LOG);
 
@@ -246,7 +216,7 @@ void NeuralNetworkTest::test_add_layer()
 
     neural_network.set();
 
-    neural_network.add_layer(&bounding_layer);
+    neural_network.add_layer(new BoundingLayer);
     assert_true(neural_network.get_layers_number() == 1, LOG);
     assert_true(neural_network.get_layer_pointer(0)->get_type() == Layer::Type::Bounding, LOG);
 
@@ -1209,6 +1179,372 @@ void NeuralNetworkTest::test_forward_propagate()
 }
 
 
+void NeuralNetworkTest::test_freeze_parameters()
+{
+    cout << "test_freeze_parameters\n";
+
+    const Index batch_samples_number = 11;
+    const Index inputs_number = 6;
+    const Index neurons_number = 20;
+    const Index outputs_number = 3;
+
+    Tensor<type, 2> inputs(batch_samples_number, inputs_number);
+    inputs.setRandom();
+
+    Tensor<Index, 1> inputs_dimensions = get_dimensions(inputs);
+
+    neural_network.set(NeuralNetwork::ProjectType::Approximation, {inputs_number, neurons_number, outputs_number});
+    neural_network.set_parameters_random();
+
+    assert_true(neural_network.get_parameters_precision() == StoragePrecision::Single, LOG);
+
+    const Tensor<type, 2> outputs = neural_network.calculate_outputs(inputs.data(), inputs_dimensions);
+
+    // Test
+
+    neural_network.freeze_parameters(StoragePrecision::Half);
+
+    assert_true(neural_network.get_parameters_precision() == StoragePrecision::Half, LOG);
+
+    Tensor<type, 2> frozen_outputs = neural_network.calculate_outputs(inputs.data(), inputs_dimensions);
+
+    assert_true(frozen_outputs.dimension(0) == batch_samples_number, LOG);
+    assert_true(frozen_outputs.dimension(1) == outputs_number, LOG);
+    assert_true(are_equal(outputs, frozen_outputs, type(1.0e-2)), LOG);
+
+    // Test
+
+    neural_network.freeze_parameters(StoragePrecision::BFloat16);
+
+    frozen_outputs = neural_network.calculate_outputs(inputs.data(), inputs_dimensions);
+
+    assert_true(are_equal(outputs, frozen_outputs, type(5.0e-2)), LOG);
+
+    // Test
+
+    neural_network.unfreeze_parameters();
+
+    assert_true(neural_network.get_parameters_precision() == StoragePrecision::Single, LOG);
+
+    frozen_outputs = neural_network.calculate_outputs(inputs.data(), inputs_dimensions);
+
+    assert_true(are_equal(outputs, frozen_outputs, type(1.0e-6)), LOG);
+}
+
+
+void NeuralNetworkTest::test_get_layers_inputs_indices()
+{
+    cout << "test_get_layers_inputs_indices\n";
+
+    Tensor<Tensor<Index, 1>, 1> layers_inputs_indices;
+
+    // Test
+
+    neural_network.set(NeuralNetwork::ProjectType::Approximation, {2, 3, 1});
+
+    layers_inputs_indices = neural_network.get_layers_inputs_indices();
+
+    assert_true(layers_inputs_indices.size() == neural_network.get_layers_number(), LOG);
+    assert_true(layers_inputs_indices(0).size() == 0, LOG);
+
+    for(Index i = 1; i < layers_inputs_indices.size(); i++)
+    {
+        assert_true(layers_inputs_indices(i).size() == 1, LOG);
+        assert_true(layers_inputs_indices(i)(0) == i-1, LOG);
+    }
+
+    // Test
+
+    Tensor<Index, 1> addition_dimensions(1);
+    addition_dimensions.setValues({3});
+
+    neural_network.set();
+
+    neural_network.add_layer(new PerceptronLayer(2, 3));
+    neural_network.add_layer(new PerceptronLayer(3, 3));
+    neural_network.add_layer(new AdditionLayer(addition_dimensions));
+
+    Tensor<Index, 1> addition_inputs_indices(2);
+    addition_inputs_indices.setValues({0, 1});
+
+    neural_network.set_layer_inputs_indices(2, addition_inputs_indices);
+
+    layers_inputs_indices = neural_network.get_layers_inputs_indices();
+
+    assert_true(layers_inputs_indices(0).size() == 0, LOG);
+    assert_true(layers_inputs_indices(1).size() == 1, LOG);
+    assert_true(layers_inputs_indices(1)(0) == 0, LOG);
+    assert_true(layers_inputs_indices(2).size() == 2, LOG);
+    assert_true(layers_inputs_indices(2)(0) == 0, LOG);
+    assert_true(layers_inputs_indices(2)(1) == 1, LOG);
+}
+
+
+void NeuralNetworkTest::test_get_layers_execution_levels()
+{
+    cout << "test_get_layers_execution_levels\n";
+
+    Tensor<Tensor<Index, 1>, 1> layers_execution_levels;
+
+    // Test
+
+    neural_network.set(NeuralNetwork::ProjectType::Approximation, {2, 3, 1});
+
+    layers_execution_levels = neural_network.get_layers_execution_levels();
+
+    assert_true(layers_execution_levels.size() == neural_network.get_layers_number(), LOG);
+
+    for(Index i = 0; i < layers_execution_levels.size(); i++)
+    {
+        assert_true(layers_execution_levels(i).size() == 1, LOG);
+        assert_true(layers_execution_levels(i)(0) == i, LOG);
+    }
+
+    // Test
+
+    Tensor<Index, 1> addition_dimensions(1);
+    addition_dimensions.setValues({3});
+
+    neural_network.set();
+
+    neural_network.add_layer(new PerceptronLayer(2, 3));
+    neural_network.add_layer(new PerceptronLayer(3, 3));
+    neural_network.add_layer(new PerceptronLayer(3, 3));
+    neural_network.add_layer(new AdditionLayer(addition_dimensions));
+
+    Tensor<Index, 1> branch_inputs_indices(1);
+    branch_inputs_indices.setValues({0});
+
+    Tensor<Index, 1> addition_inputs_indices(2);
+    addition_inputs_indices.setValues({2, 1});
+
+    neural_network.set_layer_inputs_indices(2, branch_inputs_indices);
+    neural_network.set_layer_inputs_indices(3, addition_inputs_indices);
+
+    layers_execution_levels = neural_network.get_layers_execution_levels();
+
+    assert_true(layers_execution_levels.size() == 3, LOG);
+    assert_true(layers_execution_levels(0).size() == 1, LOG);
+    assert_true(layers_execution_levels(0)(0) == 0, LOG);
+    assert_true(layers_execution_levels(1).size() == 2, LOG);
+    assert_true(layers_execution_levels(1)(0) == 1, LOG);
+    assert_true(layers_execution_levels(1)(1) == 2, LOG);
+    assert_true(layers_execution_levels(2).size() == 1, LOG);
+    assert_true(layers_execution_levels(2)(0) == 3, LOG);
+
+    // Test
+
+    Tensor<Index, 1> cycle_inputs_indices(1);
+    cycle_inputs_indices.setValues({3});
+
+    neural_network.set_layer_inputs_indices(1, cycle_inputs_indices);
+
+    bool has_thrown = false;
+
+    try
+    {
+        neural_network.get_layers_execution_levels();
+    }
+    catch(const invalid_argument&)
+    {
+        has_thrown = true;
+    }
+
+    assert_true(has_thrown, LOG);
+}
+
+
+void NeuralNetworkTest::test_back_propagate_residual()
+{
+    cout << "test_back_propagate_residual\n";
+
+    // Two branches read the first layer, and an addition layer merges them with a shortcut from it
+
+    batch_samples_number = 4;
+    inputs_number = 2;
+    const Index neurons_number = 3;
+    outputs_number = 1;
+    bool is_training = true;
+
+    const int threads_number = ExecutionContext::get_threads_number();
+
+    ExecutionContext::set_threads_number(4);
+
+    // Data set
+
+    data_set.set(batch_samples_number, inputs_number, outputs_number);
+    data_set.set_data_random();
+
+    data_set.set_training();
+
+    training_samples_indices = data_set.get_training_samples_indices();
+    input_variables_indices = data_set.get_input_variables_indices();
+    target_variables_indices = data_set.get_target_variables_indices();
+
+    batch.set(batch_samples_number, &data_set);
+    batch.fill(training_samples_indices, input_variables_indices, target_variables_indices);
+
+    // Neural network
+
+    Tensor<Index, 1> addition_dimensions(1);
+    addition_dimensions.setValues({neurons_number});
+
+    neural_network.set();
+
+    neural_network.add_layer(new PerceptronLayer(inputs_number, neurons_number));
+    neural_network.add_layer(new PerceptronLayer(neurons_number, neurons_number));
+    neural_network.add_layer(new PerceptronLayer(neurons_number, neurons_number));
+    neural_network.add_layer(new AdditionLayer(addition_dimensions));
+    neural_network.add_layer(new PerceptronLayer(neurons_number, outputs_number, PerceptronLayer::ActivationFunction::Linear));
+
+    Tensor<Index, 1> branch_inputs_indices(1);
+    branch_inputs_indices.setValues({0});
+
+    Tensor<Index, 1> addition_inputs_indices(3);
+    addition_inputs_indices.setValues({0, 1, 2});
+
+    neural_network.set_layer_inputs_indices(2, branch_inputs_indices);
+    neural_network.set_layer_inputs_indices(3, addition_inputs_indices);
+
+    neural_network.set_parameters_random();
+
+    const Tensor<Tensor<Index, 1>, 1> layers_execution_levels = neural_network.get_layers_execution_levels();
+
+    assert_true(layers_execution_levels.size() == 4, LOG);
+    assert_true(layers_execution_levels(1).size() == 2, LOG);
+
+    NeuralNetworkForwardPropagation forward_propagation(batch_samples_number, &neural_network);
+    neural_network.forward_propagate(batch, forward_propagation, is_training);
+
+    const Tensor<type, 2> addition_outputs = forward_propagation.layers(3)->outputs(0).to_tensor_map<2>();
+
+    const Tensor<type, 2> branches_outputs = forward_propagation.layers(0)->outputs(0).to_tensor_map<2>()
+                                           + forward_propagation.layers(1)->outputs(0).to_tensor_map<2>()
+                                           + forward_propagation.layers(2)->outputs(0).to_tensor_map<2>();
+
+    assert_true(are_equal(addition_outputs, branches_outputs, type(1.0e-6)), LOG);
+
+    // Loss index
+
+    SumSquaredError sum_squared_error(&neural_network, &data_set);
+
+    sum_squared_error.set_regularization_method(LossIndex::RegularizationMethod::NoRegularization);
+
+    LossIndexBackPropagation back_propagation;
+
+    back_propagation.set(batch_samples_number, &sum_squared_error);
+    sum_squared_error.back_propagate(batch, forward_propagation, back_propagation);
+
+    const Tensor<type, 1> numerical_differentiation_gradient = sum_squared_error.calculate_numerical_differentiation_gradient();
+
+    assert_true(back_propagation.gradient.size() == neural_network.get_parameters_number(), LOG);
+    assert_true(are_equal(back_propagation.gradient, numerical_differentiation_gradient, type(1.0e-2)), LOG);
+
+    // Training keeps all the outputs, while deployment reuses their memory and gives the same outputs
+
+    assert_true(forward_propagation.memory_planner.get_arena_size() == forward_propagation.memory_planner.get_buffers_size(), LOG);
+
+    const Tensor<type, 2> outputs = forward_propagation.layers(4)->outputs(0).to_tensor_map<2>();
+
+    NeuralNetworkForwardPropagation deployment_forward_propagation(batch_samples_number, &neural_network);
+
+    neural_network.forward_propagate_deploy(batch, deployment_forward_propagation);
+
+    const MemoryPlanner& memory_planner = deployment_forward_propagation.memory_planner;
+
+    assert_true(memory_planner.get_buffers_number() == 5, LOG);
+    assert_true(memory_planner.get_arena_size() < memory_planner.get_buffers_size(), LOG);
+    assert_true(static_cast<PerceptronLayerForwardPropagation*>(deployment_forward_propagation.layers(0))->activations_derivatives.size() == 0, LOG);
+
+    const Tensor<type, 2> deployment_outputs = deployment_forward_propagation.layers(4)->outputs(0).to_tensor_map<2>();
+
+    assert_true(are_equal(deployment_outputs, outputs, type(1.0e-6)), LOG);
+
+    // Switching between training and deployment keeps both plans, and only changes the views of the outputs
+
+    const type* training_outputs_data = forward_propagation.layers(0)->outputs(0).get_data();
+
+    neural_network.forward_propagate_deploy(batch, forward_propagation);
+
+    assert_true(static_cast<PerceptronLayerForwardPropagation*>(forward_propagation.layers(0))->activations_derivatives.size() != 0, LOG);
+    assert_true(are_equal(Tensor<type, 2>(forward_propagation.layers(4)->outputs(0).to_tensor_map<2>()), outputs, type(1.0e-6)), LOG);
+
+    neural_network.forward_propagate(batch, forward_propagation, is_training);
+
+    assert_true(forward_propagation.layers(0)->outputs(0).get_data() == training_outputs_data, LOG);
+    assert_true(are_equal(Tensor<type, 2>(forward_propagation.layers(4)->outputs(0).to_tensor_map<2>()), outputs, type(1.0e-6)), LOG);
+
+    ExecutionContext::set_threads_number(threads_number);
+}
+
+
+void NeuralNetworkTest::test_back_propagate_unscaling_branch()
+{
+    cout << "test_back_propagate_unscaling_branch\n";
+
+    // An unscaling layer between the trainable layers reads the first perceptron layer, as the last one does
+
+    batch_samples_number = 4;
+    inputs_number = 2;
+    const Index neurons_number = 3;
+    outputs_number = 1;
+    bool is_training = true;
+
+    // Data set
+
+    data_set.set(batch_samples_number, inputs_number, outputs_number);
+    data_set.set_data_random();
+
+    data_set.set_training();
+
+    training_samples_indices = data_set.get_training_samples_indices();
+    input_variables_indices = data_set.get_input_variables_indices();
+    target_variables_indices = data_set.get_target_variables_indices();
+
+    batch.set(batch_samples_number, &data_set);
+    batch.fill(training_samples_indices, input_variables_indices, target_variables_indices);
+
+    // Neural network
+
+    neural_network.set();
+
+    neural_network.add_layer(new ScalingLayer(inputs_number));
+    neural_network.add_layer(new PerceptronLayer(inputs_number, neurons_number));
+    neural_network.add_layer(new UnscalingLayer(neurons_number));
+    neural_network.add_layer(new PerceptronLayer(neurons_number, outputs_number, PerceptronLayer::ActivationFunction::Linear));
+
+    Tensor<Index, 1> perceptron_inputs_indices(1);
+    perceptron_inputs_indices.setValues({1});
+
+    neural_network.set_layer_inputs_indices(3, perceptron_inputs_indices);
+
+    neural_network.set_parameters_random();
+
+    NeuralNetworkForwardPropagation forward_propagation(batch_samples_number, &neural_network);
+    neural_network.forward_propagate(batch, forward_propagation, is_training);
+
+    // Loss index
+
+    SumSquaredError sum_squared_error(&neural_network, &data_set);
+
+    sum_squared_error.set_regularization_method(LossIndex::RegularizationMethod::NoRegularization);
+
+    LossIndexBackPropagation back_propagation;
+
+    back_propagation.set(batch_samples_number, &sum_squared_error);
+
+    assert_true(back_propagation.neural_network.get_layer(2) == nullptr, LOG);
+    assert_true(back_propagation.neural_network.get_layer(3) == back_propagation.neural_network.layers(1), LOG);
+
+    sum_squared_error.back_propagate(batch, forward_propagation, back_propagation);
+
+    const Tensor<type, 1> numerical_differentiation_gradient = sum_squared_error.calculate_numerical_differentiation_gradient();
+
+    assert_true(back_propagation.gradient.size() == neural_network.get_parameters_number(), LOG);
+    assert_true(are_equal(back_propagation.gradient, numerical_differentiation_gradient, type(1.0e-2)), LOG);
+}
+
+
 void NeuralNetworkTest::run_test_case()
 {
     cout << "Running neural network test case...\n";
@@ -1255,10 +1591,22 @@ void NeuralNetworkTest::run_test_case()
 
     test_calculate_directional_inputs();
 
+    test_freeze_parameters();
+
+    // Graph methods
+
+    test_get_layers_inputs_indices();
+    test_get_layers_execution_levels();
+
     //Forward propagate
 
     test_forward_propagate();
 
+    // Back propagate
+
+    test_back_propagate_residual();
+    test_back_propagate_unscaling_branch();
+
     // Serialization methods
 
     test_save();
@@ -75,10 +75,22 @@ public:
     void test_calculate_directional_inputs();
     void test_calculate_outputs_histograms();
 
+    void test_freeze_parameters();
+
+    // Graph methods
+
+    void test_get_layers_inputs_indices();
+    void test_get_layers_execution_levels();
+
     // Forward propagation
 
     void test_forward_propagate();
 
+    // Back propagation
+
+    void test_back_propagate_residual();
+    void test_back_propagate_unscaling_branch();
+
     // Expression methods
 
     void test_save_expression();
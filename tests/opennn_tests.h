@@ -16,16 +16,28 @@
 #include "../opennn/unit_testing.h"
 
 #include "statistics_test.h"
+#include "statistics_accumulator_test.h"
 #include "numerical_differentiation_test.h"
 #include "scaling_test.h"
 
+#include "csv_reader_test.h"
+#include "binary_data_file_test.h"
+#include "data_shards_test.h"
+#include "data_parallel_test.h"
+#include "storage_precision_test.h"
+#include "memory_planner_test.h"
+#include "training_cache_test.h"
+#include "image_augmentation_test.h"
 #include "data_set_test.h"
+#include "batch_loader_test.h"
 
 #include "perceptron_layer_test.h"
 #include "convolutional_layer_test.h"
 #include "pooling_layer_test.h"
 
 #include "flatten_layer_test.h"
+#include "embedding_layer_test.h"
+#include "multihead_attention_layer_test.h"
 
 #include "scaling_layer_test.h"
 #include "unscaling_layer_test.h"
@@ -1432,6 +1432,269 @@ void PerceptronLayerTest::test_forward_propagate()
 }
 
 
+void PerceptronLayerTest::test_calculate_combinations_activations()
+{
+    cout << "test_calculate_combinations_activations\n";
+
+    const vector<PerceptronLayer::ActivationFunction> activation_functions
+            = {PerceptronLayer::ActivationFunction::Threshold,
+               PerceptronLayer::ActivationFunction::SymmetricThreshold,
+               PerceptronLayer::ActivationFunction::Logistic,
+               PerceptronLayer::ActivationFunction::HyperbolicTangent,
+               PerceptronLayer::ActivationFunction::Linear,
+               PerceptronLayer::ActivationFunction::RectifiedLinear,
+               PerceptronLayer::ActivationFunction::ExponentialLinear,
+               PerceptronLayer::ActivationFunction::ScaledExponentialLinear,
+               PerceptronLayer::ActivationFunction::SoftPlus,
+               PerceptronLayer::ActivationFunction::SoftSign,
+               PerceptronLayer::ActivationFunction::HardSigmoid};
+
+    PerceptronLayerForwardPropagation fused_forward_propagation;
+
+    bool is_training;
+
+    const int threads_number = ExecutionContext::get_threads_number();
+
+    // Test small shape, and a large one which several threads contract in blocks and shards,
+    // so that the output kernel is applied to partial blocks of the outputs
+
+    Tensor<Index, 2> shapes(2, 3);
+    shapes.setValues({{5, 3, 4}, {300, 257, 150}});
+
+    for(Index k = 0; k < shapes.dimension(0); k++)
+    {
+        samples_number = shapes(k, 0);
+        inputs_number = shapes(k, 1);
+        neurons_number = shapes(k, 2);
+
+        ExecutionContext::set_threads_number(samples_number > 100 ? 4 : threads_number);
+
+        Tensor<type, 2> inputs_tensor(samples_number, inputs_number);
+        inputs_tensor.setRandom();
+        inputs_tensor = type(4)*inputs_tensor - type(2);
+
+        Tensor<DynamicTensor<type>, 1> inputs(1);
+        inputs(0) = DynamicTensor<type>(inputs_tensor.data(), get_dimensions(inputs_tensor));
+
+        for(size_t i = 0; i < activation_functions.size(); i++)
+        {
+            perceptron_layer.set(inputs_number, neurons_number, activation_functions[i]);
+            perceptron_layer.set_parameters_random();
+
+            perceptron_layer_forward_propagation.set(samples_number, &perceptron_layer);
+            fused_forward_propagation.set(samples_number, &perceptron_layer);
+
+            for(Index j = 0; j < 2; j++)
+            {
+                is_training = (j == 1);
+
+                perceptron_layer.set_fused_forward(false);
+                perceptron_layer.forward_propagate(inputs, &perceptron_layer_forward_propagation, is_training);
+
+                perceptron_layer.set_fused_forward(true);
+                perceptron_layer.forward_propagate(inputs, &fused_forward_propagation, is_training);
+
+                const Tensor<type, 2> outputs = perceptron_layer_forward_propagation.outputs(0).to_tensor_map<2>();
+                const Tensor<type, 2> fused_outputs = fused_forward_propagation.outputs(0).to_tensor_map<2>();
+
+                assert_true(are_equal(outputs, fused_outputs, type(1.0e-5)), LOG);
+
+                if(is_training)
+                {
+                    assert_true(are_equal(perceptron_layer_forward_propagation.activations_derivatives,
+                                          fused_forward_propagation.activations_derivatives,
+                                          type(1.0e-5)), LOG);
+                }
+            }
+        }
+    }
+
+    ExecutionContext::set_threads_number(threads_number);
+}
+
+
+void PerceptronLayerTest::test_freeze_parameters()
+{
+    cout << "test_freeze_parameters\n";
+
+    PerceptronLayerForwardPropagation frozen_forward_propagation;
+
+    bool is_training = false;
+
+    // Test
+
+    samples_number = 7;
+    inputs_number = 33;
+    neurons_number = 9;
+
+    Tensor<type, 2> inputs_tensor(samples_number, inputs_number);
+    inputs_tensor.setRandom();
+
+    Tensor<DynamicTensor<type>, 1> inputs(1);
+    inputs(0) = DynamicTensor<type>(inputs_tensor.data(), get_dimensions(inputs_tensor));
+
+    perceptron_layer.set(inputs_number, neurons_number, PerceptronLayer::ActivationFunction::HyperbolicTangent);
+    perceptron_layer.set_parameters_random();
+
+    assert_true(perceptron_layer.get_parameters_precision() == StoragePrecision::Single, LOG);
+
+    perceptron_layer_forward_propagation.set(samples_number, &perceptron_layer);
+    frozen_forward_propagation.set(samples_number, &perceptron_layer);
+
+    perceptron_layer.forward_propagate(inputs, &perceptron_layer_forward_propagation, is_training);
+
+    const Tensor<type, 2> outputs = perceptron_layer_forward_propagation.outputs(0).to_tensor_map<2>();
+
+    perceptron_layer.freeze_parameters(StoragePrecision::Half);
+
+    assert_true(perceptron_layer.get_parameters_precision() == StoragePrecision::Half, LOG);
+
+    perceptron_layer.forward_propagate(inputs, &frozen_forward_propagation, is_training);
+
+    assert_true(are_equal(outputs, frozen_forward_propagation.outputs(0).to_tensor_map<2>(), type(1.0e-2)), LOG);
+
+    perceptron_layer.freeze_parameters(StoragePrecision::BFloat16);
+
+    perceptron_layer.forward_propagate(inputs, &frozen_forward_propagation, is_training);
+
+    assert_true(are_equal(outputs, frozen_forward_propagation.outputs(0).to_tensor_map<2>(), type(5.0e-2)), LOG);
+
+    // Test
+
+    is_training = true;
+
+    perceptron_layer.forward_propagate(inputs, &frozen_forward_propagation, is_training);
+
+    assert_true(are_equal(outputs, frozen_forward_propagation.outputs(0).to_tensor_map<2>(), type(1.0e-5)), LOG);
+
+    // Test
+
+    perceptron_layer.freeze_parameters(StoragePrecision::Single);
+
+    assert_true(perceptron_layer.get_parameters_precision() == StoragePrecision::Single, LOG);
+
+    is_training = false;
+
+    perceptron_layer.forward_propagate(inputs, &frozen_forward_propagation, is_training);
+
+    assert_true(are_equal(outputs, frozen_forward_propagation.outputs(0).to_tensor_map<2>(), type(1.0e-5)), LOG);
+}
+
+
+void PerceptronLayerTest::test_inputs_codes()
+{
+    cout << "test_inputs_codes\n";
+
+    PerceptronLayerForwardPropagation codes_forward_propagation;
+    PerceptronLayerBackPropagation codes_back_propagation;
+
+    bool is_training = true;
+
+    // Test
+
+    samples_number = 6;
+    inputs_number = 7;
+    neurons_number = 5;
+
+    Tensor<Index, 1> inputs_categories_numbers(4);
+    inputs_categories_numbers.setValues({0, 3, 0, 2});
+
+    Tensor<type, 2> inputs_codes(samples_number, 4);
+    inputs_codes.setRandom();
+
+    const type first_codes[] = {type(0), type(2), type(-1), type(1), type(2), type(0)};
+    const type second_codes[] = {type(1), type(0), type(0), type(1), type(-1), type(1)};
+
+    for(Index i = 0; i < samples_number; i++)
+    {
+        inputs_codes(i, 1) = first_codes[i];
+        inputs_codes(i, 3) = second_codes[i];
+    }
+
+    perceptron_layer.set(inputs_number, neurons_number, PerceptronLayer::ActivationFunction::HyperbolicTangent);
+    perceptron_layer.set_parameters_random();
+
+    perceptron_layer.set_inputs_categories_numbers(inputs_categories_numbers);
+
+    assert_true(perceptron_layer.get_inputs_number() == inputs_number, LOG);
+    assert_true(perceptron_layer.get_inputs_categories_numbers().size() == 4, LOG);
+    assert_true(perceptron_layer.has_inputs_codes(4), LOG);
+    assert_true(!perceptron_layer.has_inputs_codes(inputs_number), LOG);
+
+    const Tensor<type, 2> inputs_tensor = perceptron_layer.expand_inputs_codes(inputs_codes);
+
+    assert_true(inputs_tensor.dimension(0) == samples_number, LOG);
+    assert_true(inputs_tensor.dimension(1) == inputs_number, LOG);
+    assert_true(abs(inputs_tensor(0, 0) - inputs_codes(0, 0)) < type(NUMERIC_LIMITS_MIN), LOG);
+    assert_true(abs(inputs_tensor(1, 3) - type(1)) < type(NUMERIC_LIMITS_MIN), LOG);
+    assert_true(abs(inputs_tensor(2, 1) + inputs_tensor(2, 2) + inputs_tensor(2, 3)) < type(NUMERIC_LIMITS_MIN), LOG);
+    assert_true(abs(inputs_tensor(1, 4) - inputs_codes(1, 2)) < type(NUMERIC_LIMITS_MIN), LOG);
+    assert_true(abs(inputs_tensor(0, 6) - type(1)) < type(NUMERIC_LIMITS_MIN), LOG);
+
+    Tensor<DynamicTensor<type>, 1> inputs(1);
+    inputs(0) = DynamicTensor<type>((type*)inputs_tensor.data(), get_dimensions(inputs_tensor));
+
+    Tensor<DynamicTensor<type>, 1> codes(1);
+    codes(0) = DynamicTensor<type>(inputs_codes.data(), get_dimensions(inputs_codes));
+
+    perceptron_layer_forward_propagation.set(samples_number, &perceptron_layer);
+    codes_forward_propagation.set(samples_number, &perceptron_layer);
+
+    perceptron_layer.forward_propagate(inputs, &perceptron_layer_forward_propagation, is_training);
+    perceptron_layer.forward_propagate(codes, &codes_forward_propagation, is_training);
+
+    assert_true(!perceptron_layer_forward_propagation.inputs_codes, LOG);
+    assert_true(codes_forward_propagation.inputs_codes, LOG);
+
+    assert_true(are_equal(Tensor<type, 2>(perceptron_layer_forward_propagation.outputs(0).to_tensor_map<2>()),
+                          codes_forward_propagation.outputs(0).to_tensor_map<2>(),
+                          type(1.0e-5)), LOG);
+
+    assert_true(are_equal(perceptron_layer_forward_propagation.activations_derivatives,
+                          codes_forward_propagation.activations_derivatives,
+                          type(1.0e-5)), LOG);
+
+    // Test
+
+    back_propagation.set(samples_number, &perceptron_layer);
+    codes_back_propagation.set(samples_number, &perceptron_layer);
+
+    TensorMap<Tensor<type, 2>> deltas(back_propagation.deltas_data, samples_number, neurons_number);
+    deltas.setRandom();
+
+    copy(back_propagation.deltas_data,
+         back_propagation.deltas_data + samples_number*neurons_number,
+         codes_back_propagation.deltas_data);
+
+    perceptron_layer.calculate_error_gradient((type*)inputs_tensor.data(), &perceptron_layer_forward_propagation, &back_propagation);
+    perceptron_layer.calculate_error_gradient(inputs_codes.data(), &codes_forward_propagation, &codes_back_propagation);
+
+    assert_true(are_equal(Tensor<type, 2>(back_propagation.synaptic_weights_derivatives),
+                          codes_back_propagation.synaptic_weights_derivatives,
+                          type(1.0e-5)), LOG);
+
+    assert_true(are_equal(Tensor<type, 1>(back_propagation.biases_derivatives),
+                          codes_back_propagation.biases_derivatives,
+                          type(1.0e-5)), LOG);
+
+    // Test
+
+    is_training = false;
+
+    perceptron_layer.forward_propagate(codes, &codes_forward_propagation, is_training);
+
+    assert_true(are_equal(Tensor<type, 2>(perceptron_layer_forward_propagation.outputs(0).to_tensor_map<2>()),
+                          codes_forward_propagation.outputs(0).to_tensor_map<2>(),
+                          type(1.0e-5)), LOG);
+
+    // Test
+
+    perceptron_layer.set_inputs_number(inputs_number);
+
+    assert_true(perceptron_layer.get_inputs_categories_numbers().size() == 0, LOG);
+}
+
+
 void PerceptronLayerTest::run_test_case()
 {
     cout << "Running perceptron layer test case...\n";
@@ -1481,6 +1744,12 @@ void PerceptronLayerTest::run_test_case()
     // Forward propagate
 
     test_forward_propagate();
+    test_calculate_combinations_activations();
+    test_freeze_parameters();
+
+    // Inputs codes
+
+    test_inputs_codes();
 
     cout << "End of perceptron layer test case.\n\n";
 }
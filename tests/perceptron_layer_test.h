@@ -72,6 +72,13 @@ public:
     // Forward propagate
 
     void test_forward_propagate();
+    void test_calculate_combinations_activations();
+
+    void test_freeze_parameters();
+
+    // Inputs codes
+
+    void test_inputs_codes();
 
     // Unit testing methods
 
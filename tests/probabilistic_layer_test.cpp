@@ -209,7 +209,7 @@ void ProbabilisticLayerTest::test_calculate_combinations()
 
     Tensor<type, 2> inputs_tensor(1,1);
     inputs_tensor.setConstant(type(3));
-    DynamicTensor<type> inputs(inputs_tensor);
+    DynamicTensor<type> inputs(inputs_tensor.data(), get_dimensions(inputs_tensor));
 
     Tensor<type, 2> combinations(1,1);
     Tensor<Index, 1> combinations_dimensions = get_dimensions(combinations);
@@ -256,7 +256,7 @@ void ProbabilisticLayerTest::test_calculate_activations()
 
     inputs_tensor.resize(samples_number, inputs_number);
     inputs_tensor.setConstant(type(-1));
-    DynamicTensor<type> inputs(inputs_tensor);
+    DynamicTensor<type> inputs(inputs_tensor.data(), get_dimensions(inputs_tensor));
 
     combinations.resize(samples_number, neurons_number);
     combinations_dimensions = get_dimensions(combinations);
@@ -299,7 +299,7 @@ void ProbabilisticLayerTest::test_calculate_activations()
 
     inputs_tensor.resize(1,2);
     inputs_tensor.setConstant(2);
-    DynamicTensor<type> resized_inputs(inputs_tensor);
+    DynamicTensor<type> resized_inputs(inputs_tensor.data(), get_dimensions(inputs_tensor));
 
     combinations.resize(1,2);
     combinations_dimensions = get_dimensions(combinations);
@@ -332,7 +332,7 @@ void ProbabilisticLayerTest::test_calculate_activations()
 
     inputs_tensor.resize(1,3);
     inputs_tensor.setZero();
-    DynamicTensor<type> zeroes_inputs(inputs_tensor);
+    DynamicTensor<type> zeroes_inputs(inputs_tensor.data(), get_dimensions(inputs_tensor));
 
     combinations.resize(1,3);
     combinations.setValues({{1,0,-1}});
@@ -511,7 +511,7 @@ void ProbabilisticLayerTest::test_forward_propagate()
     probabilistic_layer_forward_propagation.set(samples_number, &probabilistic_layer);
 
     Tensor<DynamicTensor<type>, 1> inputs(1);
-    inputs(0) = DynamicTensor<type>(inputs_tensor);
+    inputs(0) = DynamicTensor<type>(inputs_tensor.data(), get_dimensions(inputs_tensor));
 
     probabilistic_layer.forward_propagate(inputs,
                                           &probabilistic_layer_forward_propagation,
@@ -547,7 +547,7 @@ void ProbabilisticLayerTest::test_forward_propagate()
     inputs_test_1_tensor.setConstant(type(1));
 
     Tensor<DynamicTensor<type>, 1> inputs_test_1(1);
-    inputs_test_1(0) = DynamicTensor<type>(inputs_test_1_tensor);
+    inputs_test_1(0) = DynamicTensor<type>(inputs_test_1_tensor.data(), get_dimensions(inputs_test_1_tensor));
 
     synaptic_weights.resize(3, 4);
     biases.resize(1, 4);
@@ -596,7 +596,7 @@ void ProbabilisticLayerTest::test_forward_propagate()
     inputs_test_2_tensor.setConstant(type(1));
 
     Tensor<DynamicTensor<type>, 1> inputs_test_2(1);
-    inputs_test_2(0) = DynamicTensor<type>(inputs_test_2_tensor);
+    inputs_test_2(0) = DynamicTensor<type>(inputs_test_2_tensor.data(), get_dimensions(inputs_test_2_tensor));
 
     probabilistic_layer.forward_propagate(inputs_test_2,
                                           &probabilistic_layer_forward_propagation,
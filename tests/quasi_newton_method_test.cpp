@@ -59,6 +59,61 @@ void QuasiNewtonMethodTest::test_set_inverse_hessian_approximation_method()
     assert_true(
                 quasi_newton_method.get_inverse_hessian_approximation_method()
                 == QuasiNewtonMethod::InverseHessianApproximationMethod::BFGS, LOG);
+
+    quasi_newton_method.set_inverse_hessian_approximation_method("L-BFGS");
+
+    assert_true(
+                quasi_newton_method.get_inverse_hessian_approximation_method()
+                == QuasiNewtonMethod::InverseHessianApproximationMethod::LBFGS, LOG);
+
+    assert_true(quasi_newton_method.write_inverse_hessian_approximation_method() == "L-BFGS", LOG);
+
+    quasi_newton_method.set_inverse_hessian_approximation_method(
+                QuasiNewtonMethod::InverseHessianApproximationMethod::BFGS);
+}
+
+
+void QuasiNewtonMethodTest::test_set_history_size()
+{
+    cout << "test_set_history_size\n";
+
+    QuasiNewtonMethod quasi_newton_method_1;
+
+    assert_true(quasi_newton_method_1.get_history_size() == 10, LOG);
+
+    quasi_newton_method_1.set_inverse_hessian_approximation_method(
+                QuasiNewtonMethod::InverseHessianApproximationMethod::LBFGS);
+    quasi_newton_method_1.set_history_size(4);
+
+    assert_true(quasi_newton_method_1.get_history_size() == 4, LOG);
+
+    // Test
+
+    tinyxml2::XMLPrinter printer;
+    quasi_newton_method_1.write_XML(printer);
+
+    tinyxml2::XMLDocument document;
+    document.Parse(printer.CStr());
+
+    QuasiNewtonMethod quasi_newton_method_2;
+    quasi_newton_method_2.from_XML(document);
+
+    assert_true(quasi_newton_method_2.get_inverse_hessian_approximation_method()
+                == QuasiNewtonMethod::InverseHessianApproximationMethod::LBFGS, LOG);
+    assert_true(quasi_newton_method_2.get_history_size() == 4, LOG);
+
+    // Test
+
+    try
+    {
+        quasi_newton_method_1.set_history_size(0);
+
+        assert_true(false, LOG);
+    }
+    catch(const invalid_argument&)
+    {
+        assert_true(quasi_newton_method_1.get_history_size() == 4, LOG);
+    }
 }
 
 
@@ -161,13 +216,86 @@ void QuasiNewtonMethodTest::test_calculate_inverse_hessian_approximation()
 }
 
 
+void QuasiNewtonMethodTest::test_calculate_LBFGS_training_direction()
+{
+    cout << "test_calculate_LBFGS_training_direction\n";
+
+    Index parameters_number;
+
+    Tensor<type, 1> hessian_diagonal;
+
+    Tensor<type, 1> gradient;
+
+    // Test
+
+    inputs_number = 2;
+    neurons_number = 3;
+    outputs_number = 1;
+
+    neural_network.set(NeuralNetwork::ProjectType::Approximation, {inputs_number, neurons_number, outputs_number});
+
+    parameters_number = neural_network.get_parameters_number();
+
+    quasi_newton_method.set_inverse_hessian_approximation_method(QuasiNewtonMethod::InverseHessianApproximationMethod::LBFGS);
+    quasi_newton_method.set_history_size(2);
+
+    quasi_newton_method_data.set(&quasi_newton_method);
+
+    assert_true(quasi_newton_method_data.inverse_hessian.size() == 0, LOG);
+    assert_true(quasi_newton_method_data.parameters_differences.dimension(0) == parameters_number, LOG);
+    assert_true(quasi_newton_method_data.parameters_differences.dimension(1) == 2, LOG);
+
+    // Without differences the training direction is the negative gradient
+
+    gradient.resize(parameters_number);
+    gradient.setRandom();
+
+    quasi_newton_method.calculate_LBFGS_training_direction(gradient, quasi_newton_method_data);
+
+    assert_true(are_equal(quasi_newton_method_data.training_direction, Tensor<type, 1>(-gradient), type(1.0e-6)), LOG);
+
+    // Differences of a quadratic function, the last ones satisfy the secant condition
+
+    hessian_diagonal.resize(parameters_number);
+    hessian_diagonal.setRandom();
+    hessian_diagonal = hessian_diagonal.abs() + type(1);
+
+    for(Index i = 0; i < 3; i++)
+    {
+        quasi_newton_method_data.parameters_difference.setRandom();
+        quasi_newton_method_data.gradient_difference = hessian_diagonal*quasi_newton_method_data.parameters_difference;
+
+        quasi_newton_method.update_LBFGS_history(quasi_newton_method_data);
+    }
+
+    assert_true(quasi_newton_method_data.history_count == 2, LOG);
+    assert_true(quasi_newton_method_data.history_position == 1, LOG);
+
+    quasi_newton_method.calculate_LBFGS_training_direction(quasi_newton_method_data.gradient_difference, quasi_newton_method_data);
+
+    assert_true(are_equal(quasi_newton_method_data.training_direction,
+                          Tensor<type, 1>(-quasi_newton_method_data.parameters_difference), type(1.0e-3)), LOG);
+
+    // Differences with negative curvature are not stored
+
+    quasi_newton_method_data.gradient_difference = -quasi_newton_method_data.parameters_difference;
+
+    quasi_newton_method.update_LBFGS_history(quasi_newton_method_data);
+
+    assert_true(quasi_newton_method_data.history_count == 2, LOG);
+    assert_true(quasi_newton_method_data.history_position == 1, LOG);
+
+    quasi_newton_method.set_inverse_hessian_approximation_method(QuasiNewtonMethod::InverseHessianApproximationMethod::BFGS);
+}
+
+
 void QuasiNewtonMethodTest::test_perform_training()
 {   
     cout << "test_perform_training\n";
 
-    type old_error = numeric_limits<float>::max();
+    type old_loss = numeric_limits<float>::max();
 
-    type error;
+    type loss;
 
     // Test
 
@@ -198,21 +326,21 @@ void QuasiNewtonMethodTest::test_perform_training()
     quasi_newton_method.set_maximum_epochs_number(1);
 
     training_results = quasi_newton_method.perform_training();
-    error = training_results.get_training_error();
+    loss = training_results.get_loss();
 
-    assert_true(error < old_error, LOG);
+    assert_true(loss < old_loss, LOG);
 
     // Test
 
-    old_error = error;
+    old_loss = loss;
 
     quasi_newton_method.set_maximum_epochs_number(2);
     neural_network.set_parameters_constant(-1);
 
     training_results = quasi_newton_method.perform_training();
-    error = training_results.get_training_error();
+    loss = training_results.get_loss();
 
-    assert_true(error <= old_error, LOG);
+    assert_true(loss <= old_loss, LOG);
 
     // Loss goal
 
@@ -244,6 +372,26 @@ void QuasiNewtonMethodTest::test_perform_training()
 
     assert_true(training_results.get_loss_decrease() <= minimum_loss_decrease, LOG);
 
+    // Limited memory BFGS
+
+    data_set.set(10, 2, 1);
+    data_set.set_data_random();
+
+    neural_network.set(NeuralNetwork::ProjectType::Approximation, {2, 3, 1});
+    neural_network.set_parameters_constant(type(-1));
+
+    quasi_newton_method.set_inverse_hessian_approximation_method(QuasiNewtonMethod::InverseHessianApproximationMethod::LBFGS);
+    quasi_newton_method.set_history_size(3);
+    quasi_newton_method.set_loss_goal(type(0));
+    quasi_newton_method.set_minimum_loss_decrease(type(0));
+    quasi_newton_method.set_maximum_epochs_number(20);
+
+    training_results = quasi_newton_method.perform_training();
+
+    assert_true(training_results.get_training_error() <= training_results.training_error_history(0), LOG);
+
+    quasi_newton_method.set_inverse_hessian_approximation_method(QuasiNewtonMethod::InverseHessianApproximationMethod::BFGS);
+
 }
 
 
@@ -259,6 +407,7 @@ void QuasiNewtonMethodTest::run_test_case()
     // Set methods
 
     test_set_inverse_hessian_approximation_method();
+    test_set_history_size();
 
     // Training methods
 
@@ -268,6 +417,8 @@ void QuasiNewtonMethodTest::run_test_case()
 
     test_calculate_inverse_hessian_approximation();
 
+    test_calculate_LBFGS_training_direction();
+
     test_perform_training();
 
     cout << "End of quasi-Newton method test case.\n\n";
@@ -31,6 +31,7 @@ public:
     // Set methods
 
     void test_set_inverse_hessian_approximation_method();
+    void test_set_history_size();
 
     // Training methods
 
@@ -39,6 +40,8 @@ public:
 
     void test_calculate_inverse_hessian_approximation();
 
+    void test_calculate_LBFGS_training_direction();
+
     void test_perform_training();
 
     // Unit testing methods
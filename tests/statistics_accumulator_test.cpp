@@ -0,0 +1,381 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   S T A T I S T I C S   A C C U M U L A T O R   T E S T   C L A S S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "statistics_accumulator_test.h"
+
+
+StatisticsAccumulatorTest::StatisticsAccumulatorTest() : UnitTesting()
+{
+}
+
+
+StatisticsAccumulatorTest::~StatisticsAccumulatorTest()
+{
+}
+
+
+void StatisticsAccumulatorTest::test_constructor()
+{
+    cout << "test_constructor\n";
+
+    // Default constructor
+
+    StatisticsAccumulator statistics_accumulator_1;
+
+    assert_true(statistics_accumulator_1.get_count() == 0, LOG);
+    assert_true(statistics_accumulator_1.get_missing_values_number() == 0, LOG);
+    assert_true(isnan(statistics_accumulator_1.get_mean()), LOG);
+    assert_true(!statistics_accumulator_1.has_distinct_values(), LOG);
+
+    // Distinct values constructor
+
+    StatisticsAccumulator statistics_accumulator_2(true, 10);
+
+    assert_true(statistics_accumulator_2.has_distinct_values(), LOG);
+    assert_true(statistics_accumulator_2.get_distinct_values_number() == 0, LOG);
+    assert_true(statistics_accumulator_2.get_quantile_sketch().is_exact(), LOG);
+}
+
+
+void StatisticsAccumulatorTest::test_add()
+{
+    cout << "test_add\n";
+
+    Tensor<type, 1> vector(101);
+    vector.setRandom();
+
+    vector(7) = type(NAN);
+    vector(50) = type(NAN);
+
+    Tensor<type, 1> values(99);
+
+    Index index = 0;
+
+    for(Index i = 0; i < vector.size(); i++)
+    {
+        if(!isnan(vector(i))) values(index++) = vector(i);
+    }
+
+    const Descriptives descriptives = opennn::descriptives(values);
+
+    StatisticsAccumulator statistics_accumulator;
+
+    // Test
+
+    for(Index i = 0; i < vector.size(); i++) statistics_accumulator.add(vector(i));
+
+    assert_true(statistics_accumulator.get_count() == 99, LOG);
+    assert_true(statistics_accumulator.get_missing_values_number() == 2, LOG);
+    assert_true(abs(statistics_accumulator.get_minimum() - descriptives.minimum) < type(NUMERIC_LIMITS_MIN), LOG);
+    assert_true(abs(statistics_accumulator.get_maximum() - descriptives.maximum) < type(NUMERIC_LIMITS_MIN), LOG);
+    assert_true(abs(statistics_accumulator.get_mean() - descriptives.mean) < type(1.0e-5), LOG);
+    assert_true(abs(statistics_accumulator.get_standard_deviation() - descriptives.standard_deviation) < type(1.0e-5), LOG);
+
+    // Test
+
+    StatisticsAccumulator distinct_values_accumulator(false, 3);
+
+    distinct_values_accumulator.add(type(2));
+    distinct_values_accumulator.add(type(1));
+    distinct_values_accumulator.add(type(2));
+    distinct_values_accumulator.add(type(NAN));
+
+    assert_true(distinct_values_accumulator.has_distinct_values(), LOG);
+
+    const Histogram histogram = distinct_values_accumulator.to_distinct_values_histogram();
+
+    assert_true(histogram.get_bins_number() == 2, LOG);
+    assert_true(abs(histogram.centers(0) - type(1)) < type(NUMERIC_LIMITS_MIN), LOG);
+    assert_true(histogram.frequencies(0) == 1, LOG);
+    assert_true(histogram.frequencies(1) == 2, LOG);
+
+    distinct_values_accumulator.add(type(3));
+    distinct_values_accumulator.add(type(4));
+
+    assert_true(!distinct_values_accumulator.has_distinct_values(), LOG);
+}
+
+
+void StatisticsAccumulatorTest::test_merge()
+{
+    cout << "test_merge\n";
+
+    Tensor<type, 1> vector(1000);
+    vector.setRandom();
+
+    vector = vector*type(100) + type(1.0e4);
+
+    StatisticsAccumulator whole_accumulator(true, 5);
+
+    for(Index i = 0; i < vector.size(); i++) whole_accumulator.add(vector(i));
+
+    // Test
+
+    StatisticsAccumulator first_accumulator(true, 5);
+    StatisticsAccumulator second_accumulator(true, 5);
+    StatisticsAccumulator third_accumulator(true, 5);
+
+    for(Index i = 0; i < 100; i++) first_accumulator.add(vector(i));
+    for(Index i = 100; i < 700; i++) second_accumulator.add(vector(i));
+    for(Index i = 700; i < 1000; i++) third_accumulator.add(vector(i));
+
+    first_accumulator.merge(second_accumulator);
+    first_accumulator.merge(StatisticsAccumulator(true, 5));
+    first_accumulator.merge(third_accumulator);
+
+    assert_true(first_accumulator.get_count() == whole_accumulator.get_count(), LOG);
+    assert_true(abs(first_accumulator.get_minimum() - whole_accumulator.get_minimum()) < type(NUMERIC_LIMITS_MIN), LOG);
+    assert_true(abs(first_accumulator.get_maximum() - whole_accumulator.get_maximum()) < type(NUMERIC_LIMITS_MIN), LOG);
+    assert_true(abs(first_accumulator.get_mean() - whole_accumulator.get_mean()) < type(1.0e-3), LOG);
+    assert_true(abs(first_accumulator.get_standard_deviation() - whole_accumulator.get_standard_deviation()) < type(1.0e-3), LOG);
+    assert_true(!first_accumulator.has_distinct_values(), LOG);
+
+    const Tensor<type, 1> merged_quartiles = first_accumulator.calculate_quartiles();
+    const Tensor<type, 1> whole_quartiles = whole_accumulator.calculate_quartiles();
+
+    for(Index i = 0; i < 3; i++)
+    {
+        assert_true(abs(merged_quartiles(i) - whole_quartiles(i)) < type(NUMERIC_LIMITS_MIN), LOG);
+    }
+}
+
+
+void StatisticsAccumulatorTest::test_quantile_sketch()
+{
+    cout << "test_quantile_sketch\n";
+
+    // Test
+
+    Tensor<type, 1> vector(501);
+    vector.setRandom();
+
+    Tensor<Index, 1> indices(vector.size());
+
+    for(Index i = 0; i < indices.size(); i++) indices(i) = i;
+
+    StatisticsAccumulator statistics_accumulator(true);
+
+    for(Index i = 0; i < vector.size(); i++) statistics_accumulator.add(vector(i));
+
+    assert_true(statistics_accumulator.get_quantile_sketch().is_exact(), LOG);
+
+    Tensor<type, 1> exact_quartiles = quartiles(vector, indices);
+    Tensor<type, 1> sketch_quartiles = statistics_accumulator.calculate_quartiles();
+
+    for(Index i = 0; i < 3; i++)
+    {
+        assert_true(abs(sketch_quartiles(i) - exact_quartiles(i)) < type(NUMERIC_LIMITS_MIN), LOG);
+    }
+
+    // Test
+
+    const Index values_number = 200000;
+
+    vector.resize(values_number);
+    vector.setRandom();
+
+    indices.resize(values_number);
+
+    for(Index i = 0; i < values_number; i++) indices(i) = i;
+
+    QuantileSketch quantile_sketch_1;
+    QuantileSketch quantile_sketch_2;
+
+    for(Index i = 0; i < values_number/2; i++) quantile_sketch_1.add(vector(i));
+    for(Index i = values_number/2; i < values_number; i++) quantile_sketch_2.add(vector(i));
+
+    quantile_sketch_1.merge(quantile_sketch_2);
+
+    assert_true(!quantile_sketch_1.is_exact(), LOG);
+    assert_true(quantile_sketch_1.get_values_number() == values_number, LOG);
+
+    exact_quartiles = quartiles(vector, indices);
+
+    // Values are uniform in [-1, 1], so a rank error of 1% is an error of 0.02
+
+    assert_true(abs(quantile_sketch_1.calculate_quantile(type(0.25)) - exact_quartiles(0)) < type(0.02), LOG);
+    assert_true(abs(quantile_sketch_1.calculate_quantile(type(0.5)) - exact_quartiles(1)) < type(0.02), LOG);
+    assert_true(abs(quantile_sketch_1.calculate_quantile(type(0.75)) - exact_quartiles(2)) < type(0.02), LOG);
+}
+
+
+void StatisticsAccumulatorTest::test_accumulate_statistics()
+{
+    cout << "test_accumulate_statistics\n";
+
+    const Index rows_number = 70000;
+
+    Tensor<type, 2> matrix(rows_number, 4);
+    matrix.setRandom();
+
+    matrix(3, 1) = type(NAN);
+    matrix(60000, 1) = type(NAN);
+
+    Tensor<Index, 1> rows_indices(rows_number/2);
+
+    for(Index i = 0; i < rows_indices.size(); i++) rows_indices(i) = 2*i + 1;
+
+    Tensor<Index, 1> columns_indices(2);
+    columns_indices.setValues({3, 1});
+
+    // Test
+
+    const Tensor<StatisticsAccumulator, 1> accumulators = accumulate_statistics(matrix, rows_indices, columns_indices);
+
+    assert_true(accumulators.size() == 2, LOG);
+    assert_true(accumulators(0).get_count() == rows_number/2, LOG);
+    assert_true(accumulators(1).get_count() + accumulators(1).get_missing_values_number() == rows_number/2, LOG);
+    assert_true(accumulators(1).get_missing_values_number() == 1, LOG);
+
+    for(Index j = 0; j < columns_indices.size(); j++)
+    {
+        Tensor<type, 1> values(accumulators(j).get_count());
+
+        Index index = 0;
+
+        for(Index i = 0; i < rows_indices.size(); i++)
+        {
+            const type value = matrix(rows_indices(i), columns_indices(j));
+
+            if(!isnan(value)) values(index++) = value;
+        }
+
+        const Descriptives descriptives = opennn::descriptives(values);
+
+        assert_true(abs(accumulators(j).get_minimum() - descriptives.minimum) < type(NUMERIC_LIMITS_MIN), LOG);
+        assert_true(abs(accumulators(j).get_maximum() - descriptives.maximum) < type(NUMERIC_LIMITS_MIN), LOG);
+        assert_true(abs(accumulators(j).get_mean() - descriptives.mean) < type(1.0e-4), LOG);
+        assert_true(abs(accumulators(j).get_standard_deviation() - descriptives.standard_deviation) < type(1.0e-4), LOG);
+    }
+}
+
+
+void StatisticsAccumulatorTest::test_columns_box_plots()
+{
+    cout << "test_columns_box_plots\n";
+
+    Tensor<type, 2> matrix(40, 3);
+    matrix.setRandom();
+
+    Tensor<Index, 1> rows_indices(30);
+
+    for(Index i = 0; i < rows_indices.size(); i++) rows_indices(i) = i + 5;
+
+    Tensor<Index, 1> columns_indices(3);
+    columns_indices.setValues({2, 0, 1});
+
+    // Test
+
+    const Tensor<BoxPlot, 1> box_plots = columns_box_plots(matrix, rows_indices, columns_indices);
+
+    assert_true(box_plots.size() == 3, LOG);
+
+    for(Index j = 0; j < columns_indices.size(); j++)
+    {
+        const BoxPlot solution = box_plot(matrix.chip(columns_indices(j), 1), rows_indices);
+
+        assert_true(abs(box_plots(j).minimum - solution.minimum) < type(NUMERIC_LIMITS_MIN), LOG);
+        assert_true(abs(box_plots(j).first_quartile - solution.first_quartile) < type(NUMERIC_LIMITS_MIN), LOG);
+        assert_true(abs(box_plots(j).median - solution.median) < type(NUMERIC_LIMITS_MIN), LOG);
+        assert_true(abs(box_plots(j).third_quartile - solution.third_quartile) < type(NUMERIC_LIMITS_MIN), LOG);
+        assert_true(abs(box_plots(j).maximum - solution.maximum) < type(NUMERIC_LIMITS_MIN), LOG);
+    }
+}
+
+
+void StatisticsAccumulatorTest::test_columns_histograms()
+{
+    cout << "test_columns_histograms\n";
+
+    const Index rows_number = 1000;
+    const Index bins_number = 10;
+
+    Tensor<type, 2> matrix(rows_number, 2);
+    matrix.setRandom();
+
+    for(Index i = 0; i < rows_number; i++) matrix(i, 1) = type(i%4);
+
+    Tensor<Index, 1> rows_indices(rows_number);
+
+    for(Index i = 0; i < rows_number; i++) rows_indices(i) = i;
+
+    Tensor<Index, 1> columns_indices(2);
+    columns_indices.setValues({0, 1});
+
+    // Test
+
+    const Tensor<Histogram, 1> histograms = columns_histograms(matrix, rows_indices, columns_indices, bins_number);
+
+    assert_true(histograms.size() == 2, LOG);
+
+    for(Index j = 0; j < 2; j++)
+    {
+        const Tensor<type, 1> column = matrix.chip(j, 1);
+
+        const Histogram solution = histogram(column, bins_number);
+
+        assert_true(histograms(j).get_bins_number() == solution.get_bins_number(), LOG);
+
+        for(Index k = 0; k < solution.get_bins_number(); k++)
+        {
+            assert_true(abs(histograms(j).centers(k) - solution.centers(k)) < type(NUMERIC_LIMITS_MIN), LOG);
+            assert_true(histograms(j).frequencies(k) == solution.frequencies(k), LOG);
+        }
+    }
+
+    assert_true(histograms(1).get_bins_number() == 4, LOG);
+}
+
+
+void StatisticsAccumulatorTest::run_test_case()
+{
+    cout << "Running statistics accumulator test case...\n";
+
+    // Constructor and destructor methods
+
+    test_constructor();
+
+    // Accumulation methods
+
+    test_add();
+
+    test_merge();
+
+    // Quantile methods
+
+    test_quantile_sketch();
+
+    // Matrix methods
+
+    test_accumulate_statistics();
+
+    test_columns_box_plots();
+
+    test_columns_histograms();
+
+    cout << "End of statistics accumulator test case.\n\n";
+}
+
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
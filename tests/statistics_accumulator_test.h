@@ -0,0 +1,72 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   S T A T I S T I C S   A C C U M U L A T O R   T E S T   C L A S S   H E A D E R
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#ifndef STATISTICSACCUMULATORTEST_H
+#define STATISTICSACCUMULATORTEST_H
+
+// Unit testing includes
+
+#include "../opennn/unit_testing.h"
+
+class StatisticsAccumulatorTest : public UnitTesting
+{
+
+public:
+
+   explicit StatisticsAccumulatorTest();
+
+   virtual ~StatisticsAccumulatorTest();
+
+   // Constructor and destructor methods
+
+   void test_constructor();
+
+   // Accumulation methods
+
+   void test_add();
+
+   void test_merge();
+
+   // Quantile methods
+
+   void test_quantile_sketch();
+
+   // Matrix methods
+
+   void test_accumulate_statistics();
+
+   void test_columns_box_plots();
+
+   void test_columns_histograms();
+
+   // Unit testing methods
+
+   void run_test_case();
+
+};
+
+#endif
+
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -48,6 +48,104 @@ void StochasticGradientDescentTest::test_destructor()
 }
 
 
+void StochasticGradientDescentTest::test_update_parameters()
+{
+    cout << "test_update_parameters\n";
+
+    samples_number = 3;
+    inputs_number = 4;
+    outputs_number = 2;
+
+    const Index neurons_number = 500;
+
+    data_set.set(samples_number, inputs_number, outputs_number);
+
+    neural_network.set(NeuralNetwork::ProjectType::Approximation, {inputs_number, neurons_number, outputs_number});
+    neural_network.set_parameters_random();
+
+    const Index parameters_number = neural_network.get_parameters_number();
+
+    const type initial_learning_rate = stochastic_gradient_descent.get_initial_learning_rate();
+    const type momentum = type(0.9);
+
+    LossIndexBackPropagation back_propagation(samples_number, &sum_squared_error);
+
+    Tensor<type, 1> parameters_increment(parameters_number);
+    Tensor<type, 1> parameters(parameters_number);
+
+    // Test
+
+    for(const type& new_momentum : {type(0), momentum})
+    {
+        for(const bool& nesterov : {false, true})
+        {
+            stochastic_gradient_descent.set_momentum(new_momentum);
+            stochastic_gradient_descent.set_nesterov(nesterov);
+
+            StochasticGradientDescentData optimization_data(&stochastic_gradient_descent);
+
+            parameters_increment.setZero();
+
+            back_propagation.parameters = neural_network.get_parameters();
+
+            parameters = back_propagation.parameters;
+
+            for(Index iteration = 0; iteration < 3; iteration++)
+            {
+                back_propagation.gradient.setRandom();
+
+                stochastic_gradient_descent.update_parameters(back_propagation, optimization_data);
+
+                parameters_increment = parameters_increment*new_momentum - back_propagation.gradient*initial_learning_rate;
+
+                nesterov && new_momentum > type(0)
+                        ? parameters += parameters_increment*new_momentum - back_propagation.gradient*initial_learning_rate
+                        : parameters += parameters_increment;
+            }
+
+            assert_true(are_equal(back_propagation.parameters, parameters, type(1.0e-5)), LOG);
+        }
+    }
+
+    // Test
+
+    stochastic_gradient_descent.set_momentum(momentum);
+    stochastic_gradient_descent.set_nesterov(false);
+    stochastic_gradient_descent.set_moments_precision(StoragePrecision::BFloat16);
+
+    {
+        StochasticGradientDescentData optimization_data(&stochastic_gradient_descent);
+
+        assert_true(optimization_data.last_parameters_increment.size() == 0, LOG);
+        assert_true(optimization_data.bfloat16_last_parameters_increment.size() == parameters_number, LOG);
+
+        parameters_increment.setZero();
+
+        back_propagation.parameters = neural_network.get_parameters();
+
+        parameters = back_propagation.parameters;
+
+        for(Index iteration = 0; iteration < 3; iteration++)
+        {
+            back_propagation.gradient.setRandom();
+
+            stochastic_gradient_descent.update_parameters(back_propagation, optimization_data);
+
+            parameters_increment = parameters_increment*momentum - back_propagation.gradient*initial_learning_rate;
+
+            parameters += parameters_increment;
+        }
+
+        // The increments keep 8 bits of mantissa, so the steps are accurate to about one percent
+
+        assert_true(are_equal(back_propagation.parameters, parameters, type(1.0e-1)*initial_learning_rate), LOG);
+    }
+
+    stochastic_gradient_descent.set_moments_precision(StoragePrecision::Single);
+    stochastic_gradient_descent.set_momentum(type(0));
+}
+
+
 void StochasticGradientDescentTest::test_perform_training()
 {   
     cout << "test_perform_training\n";
@@ -140,6 +238,8 @@ void StochasticGradientDescentTest::run_test_case()
 
     // Training methods
 
+    test_update_parameters();
+
     test_perform_training();
 
     // Serialization methods
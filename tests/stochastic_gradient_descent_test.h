@@ -33,6 +33,8 @@ public:
 
     // Training methods
 
+    void test_update_parameters();
+
     void test_perform_training();
 
     // Serialization methods
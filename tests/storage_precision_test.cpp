@@ -0,0 +1,174 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   S T O R A G E   P R E C I S I O N   T E S T   C L A S S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "storage_precision_test.h"
+
+
+StoragePrecisionTest::StoragePrecisionTest() : UnitTesting()
+{
+}
+
+
+StoragePrecisionTest::~StoragePrecisionTest()
+{
+}
+
+
+void StoragePrecisionTest::test_write_read_storage_precision()
+{
+    cout << "test_write_read_storage_precision\n";
+
+    // Test
+
+    assert_true(write_storage_precision(StoragePrecision::Single) == "Single", LOG);
+    assert_true(write_storage_precision(StoragePrecision::Half) == "Half", LOG);
+    assert_true(write_storage_precision(StoragePrecision::BFloat16) == "BFloat16", LOG);
+
+    // Test
+
+    assert_true(read_storage_precision("Single") == StoragePrecision::Single, LOG);
+    assert_true(read_storage_precision("Half") == StoragePrecision::Half, LOG);
+    assert_true(read_storage_precision("BFloat16") == StoragePrecision::BFloat16, LOG);
+
+    // Test
+
+    bool has_thrown = false;
+
+    try
+    {
+        read_storage_precision("Double");
+    }
+    catch(const invalid_argument&)
+    {
+        has_thrown = true;
+    }
+
+    assert_true(has_thrown, LOG);
+}
+
+
+void StoragePrecisionTest::test_get_storage_precision_size()
+{
+    cout << "test_get_storage_precision_size\n";
+
+    assert_true(get_storage_precision_size(StoragePrecision::Single) == Index(sizeof(type)), LOG);
+    assert_true(get_storage_precision_size(StoragePrecision::Half) == 2, LOG);
+    assert_true(get_storage_precision_size(StoragePrecision::BFloat16) == 2, LOG);
+}
+
+
+void StoragePrecisionTest::test_convert_half()
+{
+    cout << "test_convert_half\n";
+
+    const Index values_number = 37;
+
+    Tensor<type, 1> values(values_number);
+    values.setRandom();
+    values = type(200)*values - type(100);
+
+    values(0) = type(0);
+    values(1) = type(1);
+    values(2) = type(-2.5);
+
+    Tensor<Eigen::half, 1> half_values(values_number);
+    Tensor<type, 1> converted_values(values_number);
+
+    // Test
+
+    convert_from_single(values.data(), values_number, half_values.data());
+    convert_to_single(half_values.data(), values_number, converted_values.data());
+
+    assert_true(converted_values(0) == type(0), LOG);
+    assert_true(converted_values(1) == type(1), LOG);
+    assert_true(converted_values(2) == type(-2.5), LOG);
+
+    for(Index i = 0; i < values_number; i++)
+    {
+        assert_true(abs(converted_values(i) - values(i)) <= abs(values(i))*type(1.0e-3), LOG);
+    }
+
+    // Test
+
+    values(0) = type(1.0e5);
+
+    convert_from_single(values.data(), 1, half_values.data());
+    convert_to_single(half_values.data(), 1, converted_values.data());
+
+    assert_true(isinf(converted_values(0)), LOG);
+}
+
+
+void StoragePrecisionTest::test_convert_bfloat16()
+{
+    cout << "test_convert_bfloat16\n";
+
+    const Index values_number = 37;
+
+    Tensor<type, 1> values(values_number);
+    values.setRandom();
+    values = type(200)*values - type(100);
+
+    values(0) = type(0);
+    values(1) = type(1.0e30);
+    values(2) = type(-2.5);
+
+    Tensor<Eigen::bfloat16, 1> bfloat16_values(values_number);
+    Tensor<type, 1> converted_values(values_number);
+
+    // Test
+
+    convert_from_single(values.data(), values_number, bfloat16_values.data());
+    convert_to_single(bfloat16_values.data(), values_number, converted_values.data());
+
+    assert_true(converted_values(0) == type(0), LOG);
+    assert_true(converted_values(2) == type(-2.5), LOG);
+
+    for(Index i = 0; i < values_number; i++)
+    {
+        assert_true(abs(converted_values(i) - values(i)) <= abs(values(i))*type(1.0e-2), LOG);
+    }
+}
+
+
+void StoragePrecisionTest::run_test_case()
+{
+    cout << "Running storage precision test case...\n";
+
+    // Names methods
+
+    test_write_read_storage_precision();
+
+    test_get_storage_precision_size();
+
+    // Conversion methods
+
+    test_convert_half();
+
+    test_convert_bfloat16();
+
+    cout << "End of storage precision test case.\n\n";
+}
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
@@ -0,0 +1,61 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   S T O R A G E   P R E C I S I O N   T E S T   C L A S S   H E A D E R
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#ifndef STORAGEPRECISIONTEST_H
+#define STORAGEPRECISIONTEST_H
+
+// Unit testing includes
+
+#include "../opennn/unit_testing.h"
+
+class StoragePrecisionTest : public UnitTesting
+{
+
+public:
+
+   explicit StoragePrecisionTest();
+
+   virtual ~StoragePrecisionTest();
+
+   // Names methods
+
+   void test_write_read_storage_precision();
+
+   void test_get_storage_precision_size();
+
+   // Conversion methods
+
+   void test_convert_half();
+
+   void test_convert_bfloat16();
+
+   // Unit testing methods
+
+   void run_test_case();
+
+};
+
+#endif
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
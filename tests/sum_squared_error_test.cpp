@@ -144,6 +144,19 @@ void SumSquaredErrorTest::test_back_propagate()
 
         assert_true(are_equal(back_propagation.gradient, numerical_differentiation_gradient, type(1.0e-2)), LOG);
 
+        // The regularization gradient is added to the error gradient of the layers
+
+        sum_squared_error.set_regularization_method(LossIndex::RegularizationMethod::L2);
+        sum_squared_error.set_regularization_weight(type(0.5));
+
+        sum_squared_error.back_propagate(batch, forward_propagation, back_propagation);
+
+        const Tensor<type, 1> regularized_gradient = numerical_differentiation_gradient + type(0.5)*back_propagation.regularization_gradient;
+
+        assert_true(are_equal(back_propagation.gradient, regularized_gradient, type(1.0e-2)), LOG);
+        assert_true(!is_zero(back_propagation.regularization_gradient), LOG);
+
+        sum_squared_error.set_regularization_method(LossIndex::RegularizationMethod::NoRegularization);
     }
 
     // Test binary classification trivial
@@ -19,6 +19,15 @@ DESTDIR = "$$PWD/bin"
 SOURCES += \
     adaptive_moment_estimation_test.cpp \
     tensor_utilities_test.cpp \
+    csv_reader_test.cpp \
+    binary_data_file_test.cpp \
+    data_shards_test.cpp \
+    data_parallel_test.cpp \
+    storage_precision_test.cpp \
+    memory_planner_test.cpp \
+    training_cache_test.cpp \
+    image_augmentation_test.cpp \
+    batch_loader_test.cpp \
     data_set_test.cpp \
     growing_neurons_test.cpp \
     unscaling_layer_test.cpp \
@@ -51,11 +60,14 @@ SOURCES += \
     correlations_test.cpp \
     stochastic_gradient_descent_test.cpp \
     statistics_test.cpp \
+    statistics_accumulator_test.cpp \
     scaling_test.cpp \
     convolutional_layer_test.cpp \
     pooling_layer_test.cpp \
     response_optimization_test.cpp \
     flatten_layer_test.cpp \
+    embedding_layer_test.cpp \
+    multihead_attention_layer_test.cpp \
     main.cpp
 
 HEADERS += \
@@ -64,6 +76,15 @@ HEADERS += \
     growing_neurons_test.h \
     growing_neurons_test.h \
     unit_testing.h \
+    csv_reader_test.h \
+    binary_data_file_test.h \
+    data_shards_test.h \
+    data_parallel_test.h \
+    storage_precision_test.h \
+    memory_planner_test.h \
+    training_cache_test.h \
+    image_augmentation_test.h \
+    batch_loader_test.h \
     data_set_test.h \
     unscaling_layer_test.h \
     scaling_layer_test.h \
@@ -96,10 +117,13 @@ HEADERS += \
     stochastic_gradient_descent_test.h \
     correlations_test.h \
     statistics_test.h \
+    statistics_accumulator_test.h \
     scaling_test.h \
     convolutional_layer_test.h \
     pooling_layer_test.h \
     flatten_layer_test.h \
+    embedding_layer_test.h \
+    multihead_attention_layer_test.h \
     response_optimization_test.h
 
 # OpenMP library
@@ -0,0 +1,459 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   T R A I N I N G   C A C H E   T E S T   C L A S S
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#include "training_cache_test.h"
+
+
+TrainingCacheTest::TrainingCacheTest() : UnitTesting()
+{
+    data.resize(37, 21);
+    data.setRandom();
+
+    input_variables_indices.resize(18);
+
+    for(Index i = 0; i < input_variables_indices.size(); i++)
+    {
+        input_variables_indices(i) = 20 - i;
+    }
+
+    target_variables_indices.resize(2);
+    target_variables_indices.setValues({0, 2});
+}
+
+
+TrainingCacheTest::~TrainingCacheTest()
+{
+}
+
+
+void TrainingCacheTest::test_constructor()
+{
+    cout << "test_constructor\n";
+
+    // Default constructor
+
+    TrainingCache training_cache_1;
+
+    assert_true(training_cache_1.is_empty(), LOG);
+    assert_true(training_cache_1.get_samples_number() == 0, LOG);
+    assert_true(!training_cache_1.has_variables(Tensor<Index, 1>(), Tensor<Index, 1>()), LOG);
+
+    // Data constructor
+
+    TrainingCache training_cache_2(data, input_variables_indices, target_variables_indices);
+
+    assert_true(!training_cache_2.is_empty(), LOG);
+    assert_true(training_cache_2.get_samples_number() == 37, LOG);
+    assert_true(training_cache_2.get_row_size() >= 20, LOG);
+    assert_true((training_cache_2.get_row_size()*Index(sizeof(type)))%64 == 0, LOG);
+    assert_true(training_cache_2.has_variables(input_variables_indices, target_variables_indices), LOG);
+    assert_true(!training_cache_2.has_variables(target_variables_indices, input_variables_indices), LOG);
+
+    // Test
+
+    Tensor<Index, 1> wrong_variables_indices(1);
+    wrong_variables_indices.setConstant(21);
+
+    bool has_thrown = false;
+
+    try
+    {
+        training_cache_2.set(data, wrong_variables_indices, target_variables_indices);
+    }
+    catch(const invalid_argument&)
+    {
+        has_thrown = true;
+    }
+
+    assert_true(has_thrown, LOG);
+}
+
+
+void TrainingCacheTest::test_fill()
+{
+    cout << "test_fill\n";
+
+    TrainingCache training_cache(data, input_variables_indices, target_variables_indices);
+
+    Tensor<Index, 1> samples_indices(20);
+
+    for(Index i = 0; i < samples_indices.size(); i++)
+    {
+        samples_indices(i) = (7*i + 3)%37;
+    }
+
+    Tensor<type, 2> inputs(20, 18);
+    Tensor<type, 2> targets(20, 2);
+
+    training_cache.fill_inputs(samples_indices, inputs.data());
+    training_cache.fill_targets(samples_indices, targets.data());
+
+    Tensor<type, 2> data_inputs(20, 18);
+    Tensor<type, 2> data_targets(20, 2);
+
+    fill_submatrix(data, samples_indices, input_variables_indices, data_inputs.data());
+    fill_submatrix(data, samples_indices, target_variables_indices, data_targets.data());
+
+    Tensor<type, 0> maximum_difference = (inputs - data_inputs).abs().maximum();
+
+    assert_true(maximum_difference(0) == type(0), LOG);
+
+    maximum_difference = (targets - data_targets).abs().maximum();
+
+    assert_true(maximum_difference(0) == type(0), LOG);
+}
+
+
+void TrainingCacheTest::test_fill_reduced_precision()
+{
+    cout << "test_fill_reduced_precision\n";
+
+    Tensor<Index, 1> samples_indices(20);
+
+    for(Index i = 0; i < samples_indices.size(); i++)
+    {
+        samples_indices(i) = (7*i + 3)%37;
+    }
+
+    Tensor<type, 2> inputs(20, 18);
+    Tensor<type, 2> targets(20, 2);
+
+    Tensor<type, 2> data_inputs(20, 18);
+    Tensor<type, 2> data_targets(20, 2);
+
+    fill_submatrix(data, samples_indices, input_variables_indices, data_inputs.data());
+    fill_submatrix(data, samples_indices, target_variables_indices, data_targets.data());
+
+    Tensor<type, 0> maximum_difference;
+
+    // Half precision
+
+    TrainingCache training_cache(data, input_variables_indices, target_variables_indices, StoragePrecision::Half);
+
+    assert_true(training_cache.get_storage_precision() == StoragePrecision::Half, LOG);
+    assert_true(training_cache.get_samples_number() == 37, LOG);
+    assert_true((training_cache.get_row_size()*2)%64 == 0, LOG);
+    assert_true(training_cache.get_bytes_number() == 37*training_cache.get_row_size()*2, LOG);
+
+    training_cache.fill_inputs(samples_indices, inputs.data());
+    training_cache.fill_targets(samples_indices, targets.data());
+
+    maximum_difference = (inputs - data_inputs).abs().maximum();
+
+    assert_true(maximum_difference(0) <= type(1.0e-3), LOG);
+
+    maximum_difference = (targets - data_targets).abs().maximum();
+
+    assert_true(maximum_difference(0) <= type(1.0e-3), LOG);
+
+    // BFloat16 precision
+
+    training_cache.set(data, input_variables_indices, target_variables_indices, StoragePrecision::BFloat16);
+
+    assert_true(training_cache.get_storage_precision() == StoragePrecision::BFloat16, LOG);
+    assert_true(training_cache.has_variables(input_variables_indices, target_variables_indices), LOG);
+
+    training_cache.fill_inputs(samples_indices, inputs.data());
+    training_cache.fill_targets(samples_indices, targets.data());
+
+    maximum_difference = (inputs - data_inputs).abs().maximum();
+
+    assert_true(maximum_difference(0) <= type(1.0e-2), LOG);
+
+    maximum_difference = (targets - data_targets).abs().maximum();
+
+    assert_true(maximum_difference(0) <= type(1.0e-2), LOG);
+}
+
+
+void TrainingCacheTest::test_fill_codes()
+{
+    cout << "test_fill_codes\n";
+
+    Tensor<type, 2> codes_data(6, 6);
+
+    codes_data.setValues({{type(0.5), type(1), type(0), type(0), type(-2), type(10)},
+                          {type(1.5), type(0), type(0), type(1), type(-3), type(11)},
+                          {type(2.5), type(0), type(1), type(0), type(-4), type(12)},
+                          {type(3.5), type(0), type(0), type(0), type(-5), type(13)},
+                          {type(4.5), type(0), type(0), type(1), type(-6), type(14)},
+                          {type(5.5), type(1), type(0), type(0), type(-7), type(15)}});
+
+    Tensor<Index, 1> codes_input_variables_indices(5);
+    codes_input_variables_indices.setValues({0, 1, 2, 3, 4});
+
+    Tensor<Index, 1> codes_target_variables_indices(1);
+    codes_target_variables_indices.setValues({5});
+
+    Tensor<Index, 1> input_categories_numbers(3);
+    input_categories_numbers.setValues({0, 3, 0});
+
+    Tensor<Index, 1> samples_indices(4);
+    samples_indices.setValues({3, 1, 0, 2});
+
+    Tensor<type, 2> inputs(4, 3);
+    Tensor<type, 2> targets(4, 1);
+
+    // Test
+
+    TrainingCache training_cache(codes_data,
+                                 codes_input_variables_indices,
+                                 codes_target_variables_indices,
+                                 StoragePrecision::Single,
+                                 input_categories_numbers);
+
+    assert_true(training_cache.get_input_codes_number() == 3, LOG);
+    assert_true(training_cache.has_variables(codes_input_variables_indices, codes_target_variables_indices, input_categories_numbers), LOG);
+    assert_true(!training_cache.has_variables(codes_input_variables_indices, codes_target_variables_indices), LOG);
+
+    training_cache.fill_inputs(samples_indices, inputs.data());
+    training_cache.fill_targets(samples_indices, targets.data());
+
+    Tensor<type, 2> expected_inputs(4, 3);
+
+    expected_inputs.setValues({{type(3.5), type(-1), type(-5)},
+                               {type(1.5), type(2), type(-3)},
+                               {type(0.5), type(0), type(-2)},
+                               {type(2.5), type(1), type(-4)}});
+
+    Tensor<type, 0> maximum_difference = (inputs - expected_inputs).abs().maximum();
+
+    assert_true(maximum_difference(0) == type(0), LOG);
+
+    assert_true(targets(0) == type(13) && targets(3) == type(12), LOG);
+
+    // Test
+
+    training_cache.set(codes_data,
+                       codes_input_variables_indices,
+                       codes_target_variables_indices,
+                       StoragePrecision::BFloat16,
+                       input_categories_numbers);
+
+    training_cache.fill_inputs(samples_indices, inputs.data());
+
+    maximum_difference = (inputs - expected_inputs).abs().maximum();
+
+    assert_true(maximum_difference(0) == type(0), LOG);
+
+    // Test
+
+    input_categories_numbers.setValues({0, 2, 0});
+
+    bool has_thrown = false;
+
+    try
+    {
+        training_cache.set(codes_data,
+                           codes_input_variables_indices,
+                           codes_target_variables_indices,
+                           StoragePrecision::Single,
+                           input_categories_numbers);
+    }
+    catch(const invalid_argument&)
+    {
+        has_thrown = true;
+    }
+
+    assert_true(has_thrown, LOG);
+}
+
+
+void TrainingCacheTest::test_data_set_fill()
+{
+    cout << "test_data_set_fill\n";
+
+    DataSet data_set;
+
+    data_set.set_data(data);
+    data_set.set_training();
+
+    const Tensor<Index, 1> samples_indices = data_set.get_training_samples_indices();
+    const Tensor<Index, 1> data_set_input_variables_indices = data_set.get_input_variables_indices();
+    const Tensor<Index, 1> data_set_target_variables_indices = data_set.get_target_variables_indices();
+
+    DataSetBatch batch(samples_indices.size(), &data_set);
+
+    batch.fill(samples_indices, data_set_input_variables_indices, data_set_target_variables_indices);
+
+    const Tensor<type, 2> inputs = batch.inputs(0).to_tensor_map<2>();
+
+    // Test
+
+    data_set.update_training_cache();
+
+    assert_true(data_set.get_training_cache().is_empty(), LOG);
+
+    data_set.set_use_training_cache(true);
+    data_set.update_training_cache();
+
+    assert_true(!data_set.get_training_cache().is_empty(), LOG);
+
+    batch.fill(samples_indices, data_set_input_variables_indices, data_set_target_variables_indices);
+
+    const Tensor<type, 0> maximum_difference = (batch.inputs(0).to_tensor_map<2>() - inputs).abs().maximum();
+
+    assert_true(maximum_difference(0) == type(0), LOG);
+
+    // Test
+
+    data_set.set_training_cache_precision(StoragePrecision::Half);
+
+    assert_true(data_set.get_training_cache().is_empty(), LOG);
+
+    data_set.update_training_cache();
+
+    assert_true(data_set.get_training_cache().get_storage_precision() == StoragePrecision::Half, LOG);
+
+    batch.fill(samples_indices, data_set_input_variables_indices, data_set_target_variables_indices);
+
+    const Tensor<type, 0> half_maximum_difference = (batch.inputs(0).to_tensor_map<2>() - inputs).abs().maximum();
+
+    assert_true(half_maximum_difference(0) <= type(1.0e-3), LOG);
+
+    // Test
+
+    data_set.set_column_use(0, DataSet::VariableUse::Unused);
+
+    assert_true(data_set.get_training_cache().is_empty(), LOG);
+}
+
+
+void TrainingCacheTest::test_data_set_fill_codes()
+{
+    cout << "test_data_set_fill_codes\n";
+
+    Tensor<type, 2> codes_data(5, 5);
+
+    codes_data.setValues({{type(0), type(1), type(0), type(0), type(10)},
+                          {type(1), type(0), type(1), type(0), type(20)},
+                          {type(2), type(0), type(0), type(1), type(30)},
+                          {type(3), type(0), type(1), type(0), type(40)},
+                          {type(4), type(1), type(0), type(0), type(50)}});
+
+    DataSet data_set;
+
+    data_set.set_data(codes_data);
+
+    Tensor<DataSet::Column, 1> columns(3);
+
+    columns(0) = DataSet::Column("x", DataSet::VariableUse::Input, DataSet::ColumnType::Numeric, Scaler::NoScaling);
+
+    Tensor<string, 1> categories(3);
+    categories.setValues({"a", "b", "c"});
+
+    Tensor<DataSet::VariableUse, 1> categories_uses(3);
+    categories_uses.setConstant(DataSet::VariableUse::Input);
+
+    columns(1) = DataSet::Column("category", DataSet::VariableUse::Input, DataSet::ColumnType::Categorical,
+                                 Scaler::MinimumMaximum, categories, categories_uses);
+
+    columns(2) = DataSet::Column("y", DataSet::VariableUse::Target, DataSet::ColumnType::Numeric, Scaler::NoScaling);
+
+    data_set.set_columns(columns);
+    data_set.set_training();
+
+    const Tensor<Index, 1> samples_indices = data_set.get_training_samples_indices();
+    const Tensor<Index, 1> data_set_input_variables_indices = data_set.get_input_variables_indices();
+    const Tensor<Index, 1> data_set_target_variables_indices = data_set.get_target_variables_indices();
+
+    assert_true(data_set.get_input_categories_numbers().size() == 0, LOG);
+    assert_true(data_set.get_input_codes_number() == 4, LOG);
+
+    // Test
+
+    data_set.set_use_categorical_inputs_codes(true);
+
+    const Tensor<Index, 1> input_categories_numbers = data_set.get_input_categories_numbers();
+
+    assert_true(input_categories_numbers.size() == 2, LOG);
+    assert_true(input_categories_numbers(0) == 0 && input_categories_numbers(1) == 3, LOG);
+    assert_true(data_set.get_input_codes_number() == 2, LOG);
+    assert_true(data_set.get_input_codes_variables_indices()(1) == 1, LOG);
+    assert_true(data_set.get_input_variables_scalers()(1) == Scaler::NoScaling, LOG);
+
+    DataSetBatch batch(samples_indices.size(), &data_set);
+
+    assert_true(batch.inputs(0).get_dimension(1) == 2, LOG);
+
+    batch.fill(samples_indices, data_set_input_variables_indices, data_set_target_variables_indices);
+
+    const Tensor<type, 2> inputs = batch.inputs(0).to_tensor_map<2>();
+
+    for(Index i = 0; i < samples_indices.size(); i++)
+    {
+        const Index sample_index = samples_indices(i);
+
+        assert_true(inputs(i, 0) == codes_data(sample_index, 0), LOG);
+        assert_true(inputs(i, 1) == type(sample_index == 0 || sample_index == 4 ? 0 : sample_index == 2 ? 2 : 1), LOG);
+    }
+
+    // Test
+
+    data_set.set_use_training_cache(true);
+    data_set.update_training_cache();
+
+    assert_true(data_set.get_training_cache().get_input_codes_number() == 2, LOG);
+
+    batch.fill(samples_indices, data_set_input_variables_indices, data_set_target_variables_indices);
+
+    const Tensor<type, 0> maximum_difference = (batch.inputs(0).to_tensor_map<2>() - inputs).abs().maximum();
+
+    assert_true(maximum_difference(0) == type(0), LOG);
+
+    // Test
+
+    data_set.set_use_categorical_inputs_codes(false);
+
+    assert_true(data_set.get_training_cache().is_empty(), LOG);
+}
+
+
+void TrainingCacheTest::run_test_case()
+{
+    cout << "Running training cache test case...\n";
+
+    // Constructor and destructor methods
+
+    test_constructor();
+
+    // Reading methods
+
+    test_fill();
+
+    test_fill_reduced_precision();
+
+    test_fill_codes();
+
+    // Data set methods
+
+    test_data_set_fill();
+
+    test_data_set_fill_codes();
+
+    cout << "End of training cache test case.\n\n";
+}
+
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
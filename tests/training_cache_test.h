@@ -0,0 +1,76 @@
+//   OpenNN: Open Neural Networks Library
+//   www.opennn.net
+//
+//   T R A I N I N G   C A C H E   T E S T   C L A S S   H E A D E R
+//
+//   Artificial Intelligence Techniques SL
+//   artelnics@artelnics.com
+
+#ifndef TRAININGCACHETEST_H
+#define TRAININGCACHETEST_H
+
+// Unit testing includes
+
+#include "../opennn/unit_testing.h"
+
+class TrainingCacheTest : public UnitTesting
+{
+
+public:
+
+   explicit TrainingCacheTest();
+
+   virtual ~TrainingCacheTest();
+
+   // Constructor and destructor methods
+
+   void test_constructor();
+
+   // Reading methods
+
+   void test_fill();
+
+   void test_fill_reduced_precision();
+
+   void test_fill_codes();
+
+   // Data set methods
+
+   void test_data_set_fill();
+
+   void test_data_set_fill_codes();
+
+   // Unit testing methods
+
+   void run_test_case();
+
+private:
+
+   Tensor<type, 2> data;
+
+   Tensor<Index, 1> input_variables_indices;
+
+   Tensor<Index, 1> target_variables_indices;
+
+};
+
+#endif
+
+
+
+// OpenNN: Open Neural Networks Library.
+// Copyright (C) 2005-2023 Artificial Intelligence Techniques, SL.
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA